@@ -73,6 +73,7 @@ let objectServerTestSources = [
     "SwiftCollectionSyncTests.swift",
     "SwiftObjectServerPartitionTests.swift",
     "SwiftObjectServerTests.swift",
+    "SwiftSyncBenchmarks.swift",
     "SwiftSyncTestCase.swift",
     "TimeoutProxyServer.swift",
     "WatchTestUtility.swift",
@@ -164,8 +165,10 @@ let package = Package(
                 "Realm/RLMAccessor.mm",
                 "Realm/RLMAnalytics.mm",
                 "Realm/RLMArray.mm",
+                "Realm/RLMBlobStore.mm",
                 "Realm/RLMClassInfo.mm",
                 "Realm/RLMCollection.mm",
+                "Realm/RLMCompression.mm",
                 "Realm/RLMConstants.m",
                 "Realm/RLMDecimal128.mm",
                 "Realm/RLMDictionary.mm",
@@ -223,7 +226,8 @@ let package = Package(
                 "Realm/RLMUserAPIKey.mm"
             ],
             publicHeadersPath: "include",
-            cxxSettings: cxxSettings
+            cxxSettings: cxxSettings,
+            linkerSettings: [.linkedLibrary("compression")]
         ),
         .target(
             name: "RealmSwift",
@@ -307,7 +311,8 @@ let package = Package(
                 "SwiftCollectionSyncTests.swift",
                 "SwiftObjectServerPartitionTests.swift",
                 "SwiftUIServerTests.swift",
-                "SwiftMongoClientTests.swift"
+                "SwiftMongoClientTests.swift",
+                "SwiftSyncBenchmarks.swift"
             ]
         ),
         objectServerTestTarget(
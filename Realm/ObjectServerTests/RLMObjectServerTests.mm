@@ -70,6 +70,50 @@
 
 @end
 
+@interface TransportMetricsRecorder : NSObject <RLMNetworkTransportMetricsDelegate>
+@property (atomic) NSMutableArray<NSString *> *urls;
+@end
+@implementation TransportMetricsRecorder
+- (instancetype)init {
+    if ((self = [super init])) {
+        _urls = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (void)networkTransport:(RLMNetworkTransport *)transport
+                 request:(RLMRequest *)request
+didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics {
+    XCTAssertNotNil(transport);
+    XCTAssertGreaterThan(metrics.transactionMetrics.count, 0U);
+    @synchronized (self) {
+        [_urls addObject:request.url];
+    }
+}
+@end
+
+// Holds on to every request until the test completes it
+@interface HeldRequestTransport : RLMNetworkTransport
+@property (atomic) NSMutableArray<RLMRequest *> *requests;
+@property (atomic) NSMutableArray<RLMNetworkTransportCompletionBlock> *completions;
+@end
+@implementation HeldRequestTransport
+- (instancetype)init {
+    if ((self = [super init])) {
+        _requests = [NSMutableArray new];
+        _completions = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (void)sendRequestToServer:(RLMRequest *)request completion:(RLMNetworkTransportCompletionBlock)completionBlock {
+    @synchronized (self) {
+        [_requests addObject:request];
+        [_completions addObject:completionBlock];
+    }
+}
+@end
+
 @interface RLMObjectServerTests : RLMSyncTestCase
 @end
 @implementation RLMObjectServerTests
@@ -141,6 +185,154 @@ static NSString *generateRandomString(int num) {
 
 #pragma mark - Authentication and Tokens
 
+- (void)testBufferedSyncLogger {
+    RLMSyncManager *manager = [RLMApp appWithId:@"buffered-logger"].syncManager;
+    NSMutableArray<NSString *> *messages = [NSMutableArray new];
+    dispatch_semaphore_t logged = dispatch_semaphore_create(0);
+    dispatch_semaphore_t resume = dispatch_semaphore_create(0);
+    manager.logBufferSize = 2;
+    manager.logger = ^(RLMSyncLogLevel, NSString *message) {
+        // Block the log queue on the first message so that the following
+        // ones have to wait in the buffer
+        bool first = false;
+        @synchronized (messages) {
+            first = messages.count == 0;
+            [messages addObject:message];
+        }
+        if (first) {
+            dispatch_semaphore_signal(logged);
+            dispatch_semaphore_wait(resume, DISPATCH_TIME_FOREVER);
+        }
+    };
+
+    auto logger = manager.syncManager->make_logger();
+    logger->log(realm::util::Logger::Level::error, "a");
+    dispatch_semaphore_wait(logged, DISPATCH_TIME_FOREVER);
+
+    // The buffer holds two messages, so the rest are dropped until it's flushed
+    logger->log(realm::util::Logger::Level::error, "b");
+    logger->log(realm::util::Logger::Level::error, "c");
+    logger->log(realm::util::Logger::Level::error, "d");
+    logger->log(realm::util::Logger::Level::error, "e");
+    XCTAssertEqual(manager.droppedLogMessageCount, 2U);
+
+    // Replacing the logger delivers everything which was buffered before
+    // returning, followed by the warning about the dropped messages
+    dispatch_semaphore_signal(resume);
+    manager.logger = nil;
+    @synchronized (messages) {
+        XCTAssertEqualObjects(messages, (@[@"a", @"b", @"c",
+                                           @"Dropped 2 sync log messages because the log buffer was full."]));
+    }
+    XCTAssertEqual(manager.droppedLogMessageCount, 0U);
+
+    // Resetting the manager also delivers anything which is still buffered
+    NSMutableArray<NSString *> *lateMessages = [NSMutableArray new];
+    manager.logBufferSize = 4;
+    manager.logger = ^(RLMSyncLogLevel, NSString *message) {
+        @synchronized (lateMessages) {
+            [lateMessages addObject:message];
+        }
+    };
+    logger = manager.syncManager->make_logger();
+    logger->log(realm::util::Logger::Level::error, "f");
+    [manager resetForTesting];
+    @synchronized (lateMessages) {
+        XCTAssertEqualObjects(lateMessages, @[@"f"]);
+    }
+}
+
+- (void)testRequestAndResponseBodiesAreNotTranscoded {
+    HeldRequestTransport *transport = [HeldRequestTransport new];
+    RLMAppConfiguration *config = [[RLMAppConfiguration alloc] initWithBaseURL:@"http://localhost:9090"
+                                                                     transport:transport
+                                                                  localAppName:nil
+                                                               localAppVersion:nil
+                                                       defaultRequestTimeoutMS:60000];
+    // Embedded nuls would be lost by a round-trip through a C string
+    std::string requestBody("{\"a\":\"\0b\"}", 10);
+    realm::app::Request request;
+    request.method = realm::app::HttpMethod::post;
+    request.url = "http://localhost:9090/api/client/v2.0/app/id/functions/call";
+    request.body = requestBody;
+    std::string responseBody;
+    config.config.transport_generator()->send_request_to_server(request, [&](realm::app::Response const& response) {
+        responseBody = response.body;
+    });
+
+    XCTAssertEqual(transport.requests.count, 1U);
+    NSData *sent = transport.requests[0].bodyData;
+    XCTAssertEqualObjects(sent, [NSData dataWithBytes:requestBody.data() length:requestBody.size()]);
+
+    char bytes[] = {'"', 'x', '\0', 'y', '"'};
+    RLMResponse *response = [RLMResponse new];
+    response.httpStatusCode = 200;
+    response.bodyData = [NSData dataWithBytes:bytes length:sizeof(bytes)];
+    transport.completions[0](response);
+    XCTAssertTrue((responseBody == std::string(bytes, sizeof(bytes))));
+
+    // Either representation can be read regardless of which one was set
+    RLMRequest *rlmRequest = [RLMRequest new];
+    rlmRequest.body = @"text";
+    XCTAssertEqualObjects(rlmRequest.bodyData, [@"text" dataUsingEncoding:NSUTF8StringEncoding]);
+    rlmRequest.bodyData = [@"data" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertEqualObjects(rlmRequest.body, @"data");
+}
+
+- (void)testConcurrentAccessTokenRefreshesAreCoalesced {
+    HeldRequestTransport *transport = [HeldRequestTransport new];
+    RLMAppConfiguration *config = [[RLMAppConfiguration alloc] initWithBaseURL:@"http://localhost:9090"
+                                                                     transport:transport
+                                                                  localAppName:nil
+                                                               localAppVersion:nil
+                                                       defaultRequestTimeoutMS:60000];
+    auto refreshRequest = [](std::string token) {
+        realm::app::Request request;
+        request.method = realm::app::HttpMethod::post;
+        request.url = "http://localhost:9090/api/client/v2.0/auth/session";
+        request.headers = {{"Authorization", "Bearer " + token}};
+        return request;
+    };
+    std::vector<int> statusCodes;
+    auto send = [&](realm::app::Request const& request) {
+        // Each request made by core uses a new transport
+        config.config.transport_generator()->send_request_to_server(request, [&](realm::app::Response const& response) {
+            statusCodes.push_back(response.http_status_code);
+        });
+    };
+
+    // Refreshes with the same refresh token wait for the first one
+    send(refreshRequest("a"));
+    send(refreshRequest("a"));
+    send(refreshRequest("a"));
+    XCTAssertEqual(transport.requests.count, 1U);
+
+    // Refreshes with a different token and other requests are sent separately
+    send(refreshRequest("b"));
+    realm::app::Request other = refreshRequest("a");
+    other.url = "http://localhost:9090/api/client/v2.0/app/id/location";
+    other.method = realm::app::HttpMethod::get;
+    send(other);
+    XCTAssertEqual(transport.requests.count, 3U);
+    XCTAssertTrue(statusCodes.empty());
+
+    // Every waiter gets the response to the shared request
+    RLMResponse *response = [RLMResponse new];
+    response.httpStatusCode = 200;
+    response.body = @"{\"access_token\":\"token\"}";
+    transport.completions[0](response);
+    XCTAssertTrue((statusCodes == std::vector<int>{200, 200, 200}));
+
+    response = [RLMResponse new];
+    response.httpStatusCode = 401;
+    transport.completions[1](response);
+    XCTAssertTrue((statusCodes == std::vector<int>{200, 200, 200, 401}));
+
+    // Once the shared request has completed the next refresh is sent again
+    send(refreshRequest("a"));
+    XCTAssertEqual(transport.requests.count, 4U);
+}
+
 - (void)testAnonymousAuthentication {
     RLMUser *syncUser = self.anonymousUser;
     RLMUser *currentUser = [self.app currentUser];
@@ -161,6 +353,41 @@ static NSString *generateRandomString(int num) {
     [self waitForExpectationsWithTimeout:30.0 handler:nil];
 }
 
+- (void)testCallFunctionWithCachedResults {
+    RLMUser *user = self.anonymousUser;
+    [self.app cacheResultsOfFunctionNamed:@"sum" timeToLive:60];
+
+    // The second call is made while the first is in flight, and the third
+    // after it has completed
+    XCTestExpectation *expectation = [self expectationWithDescription:@"should get sum of arguments"];
+    expectation.expectedFulfillmentCount = 2;
+    for (int i = 0; i < 2; ++i) {
+        [user callFunctionNamed:@"sum" arguments:@[@1, @2, @3] completionBlock:^(id<RLMBSON> bson, NSError *error) {
+            XCTAssertNil(error);
+            XCTAssertEqual([(NSNumber *)bson intValue], 6);
+            [expectation fulfill];
+        }];
+    }
+    [self waitForExpectationsWithTimeout:30.0 handler:nil];
+
+    expectation = [self expectationWithDescription:@"should get cached sum of arguments"];
+    [user callFunctionNamed:@"sum" arguments:@[@1, @2, @3] completionBlock:^(id<RLMBSON> bson, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqual([(NSNumber *)bson intValue], 6);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30.0 handler:nil];
+
+    RLMFunctionCacheStatistics *statistics = self.app.functionCacheStatistics;
+    XCTAssertEqual(statistics.missCount, 1U);
+    XCTAssertEqual(statistics.coalescedCount, 1U);
+    XCTAssertEqual(statistics.hitCount, 1U);
+    XCTAssertEqual(statistics.cachedResultCount, 1U);
+
+    [self.app stopCachingResultsOfFunctionNamed:@"sum"];
+    XCTAssertEqual(self.app.functionCacheStatistics.cachedResultCount, 0U);
+}
+
 - (void)testLogoutCurrentUser {
     RLMUser *user = self.anonymousUser;
     XCTestExpectation *expectation = [self expectationWithDescription:@"should log out current user"];
@@ -1407,6 +1634,33 @@ static NSString *randomEmail() {
     }
 }
 
+- (void)testConnectionStateChangeNotifications {
+    RLMRealm *realm = [self realmForTest:_cmd];
+    [self waitForDownloadsForRealm:realm];
+    RLMSyncSession *session = realm.syncSession;
+
+    NSMutableArray<NSArray<NSNumber *> *> *changes = [NSMutableArray new];
+    XCTestExpectation *ex = [self expectationWithDescription:@"reconnected"];
+    RLMNotificationToken *token = [session addConnectionStateChangeNotificationBlock:^(RLMSyncConnectionState oldState,
+                                                                                       RLMSyncConnectionState newState,
+                                                                                       NSTimeInterval timeInPreviousState) {
+        XCTAssertGreaterThanOrEqual(timeInPreviousState, 0);
+        [changes addObject:@[@(oldState), @(newState)]];
+        if (newState == RLMSyncConnectionStateConnected) {
+            [ex fulfill];
+        }
+    }];
+    XCTAssertNotNil(token);
+    [session suspend];
+    [session resume];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+    [token invalidate];
+
+    XCTAssertEqualObjects(changes, (@[@[@(RLMSyncConnectionStateConnected), @(RLMSyncConnectionStateDisconnected)],
+                                      @[@(RLMSyncConnectionStateDisconnected), @(RLMSyncConnectionStateConnecting)],
+                                      @[@(RLMSyncConnectionStateConnecting), @(RLMSyncConnectionStateConnected)]]));
+}
+
 #pragma mark - Client reset
 
 /// Ensure that a client reset error is propagated up to the binding successfully.
@@ -1558,6 +1812,93 @@ static const NSInteger NUMBER_OF_BIG_OBJECTS = 2;
     XCTAssertGreaterThanOrEqual(transferred.load(), transferrable.load());
 }
 
+- (void)testUploadStatistics {
+    RLMUser *user = [self userForTest:_cmd];
+    RLMRealm *realm = [self openRealmForPartitionValue:NSStringFromSelector(_cmd) user:user];
+    RLMSyncSession *session = realm.syncSession;
+    XCTAssertNotNil(session);
+    XCTAssertEqual(session.statistics.uploadedBytes, 0U);
+
+    [realm beginWriteTransaction];
+    for (NSInteger i=0; i<NUMBER_OF_BIG_OBJECTS; i++) {
+        [realm addObject:[HugeSyncObject hugeSyncObject]];
+    }
+    [realm commitWriteTransaction];
+    [self waitForUploadsForRealm:realm];
+
+    RLMSyncSessionStatistics *statistics = session.statistics;
+    XCTAssertGreaterThan(statistics.uploadedBytes, 1000000U * NUMBER_OF_BIG_OBJECTS);
+    XCTAssertGreaterThan(statistics.uploadCount, 0U);
+    XCTAssertGreaterThan(statistics.uploadBytesPerSecond, 0);
+    XCTAssertEqualWithAccuracy(statistics.averageUploadSize,
+                               (double)statistics.uploadedBytes / statistics.uploadCount, 0.001);
+
+    // A new session object for the same session reports the same statistics
+    XCTAssertEqual(realm.syncSession.statistics.uploadedBytes, statistics.uploadedBytes);
+    XCTAssertGreaterThanOrEqual(self.app.syncManager.sessionStatistics.uploadedBytes, statistics.uploadedBytes);
+}
+
+- (void)testAggregatedUploadProgress {
+    RLMUser *user = [self userForTest:_cmd];
+    NSString *partition = NSStringFromSelector(_cmd);
+    RLMRealm *realm1 = [self openRealmForPartitionValue:partition user:user];
+    RLMRealm *realm2 = [self openRealmForPartitionValue:[partition stringByAppendingString:@"2"] user:user];
+
+    std::atomic<NSUInteger> transferred{0};
+    std::atomic<NSUInteger> transferrable{0};
+    std::atomic<NSInteger> callCount{0};
+    RLMNotificationToken *token = [user addProgressNotificationForDirection:RLMSyncProgressDirectionUpload
+                                                                   interval:0.05
+                                                                      block:[&](NSUInteger xfr, NSUInteger xfb) {
+        transferred = xfr;
+        transferrable = xfb;
+        ++callCount;
+    }];
+
+    for (RLMRealm *realm in @[realm1, realm2]) {
+        [realm beginWriteTransaction];
+        [realm addObject:[HugeSyncObject hugeSyncObject]];
+        [realm commitWriteTransaction];
+    }
+    [self waitForUploadsForRealm:realm1];
+    [self waitForUploadsForRealm:realm2];
+
+    // Wait for the final progress to be reported by a timer tick
+    [self expectationForPredicate:[NSPredicate predicateWithBlock:[&](id, NSDictionary *) -> BOOL {
+        return transferred.load() > 2000000U && transferred.load() >= transferrable.load();
+    }] evaluatedWithObject:self handler:nil];
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+    [token invalidate];
+
+    XCTAssertGreaterThan(callCount.load(), 0);
+}
+
+- (void)testSessionPrioritySuspendsLowerPrioritySessions {
+    RLMUser *user = [self userForTest:_cmd];
+    NSString *partition = NSStringFromSelector(_cmd);
+    RLMRealm *high = [self openRealmForPartitionValue:partition user:user];
+    RLMRealm *low = [self openRealmForPartitionValue:[partition stringByAppendingString:@"-low"] user:user];
+    RLMSyncSession *highSession = high.syncSession;
+    RLMSyncSession *lowSession = low.syncSession;
+    XCTAssertEqual(lowSession.priority, 0);
+
+    // Block the high priority session from catching up until it's resumed
+    [highSession suspend];
+    highSession.priority = 1;
+    XCTAssertEqual(high.syncSession.priority, 1);
+    XCTAssertEqual(lowSession.state, RLMSyncSessionStateActive);
+
+    [highSession resume];
+    XCTAssertEqual(lowSession.state, RLMSyncSessionStateInactive);
+    [self waitForDownloadsForRealm:high];
+
+    // The lower priority session is resumed once the higher one has caught up
+    [self expectationForPredicate:[NSPredicate predicateWithBlock:^BOOL(id, NSDictionary *) {
+        return lowSession.state == RLMSyncSessionStateActive;
+    }] evaluatedWithObject:lowSession handler:nil];
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+}
+
 #pragma mark - Download Realm
 
 - (void)testDownloadRealm {
@@ -1719,6 +2060,25 @@ static const NSInteger NUMBER_OF_BIG_OBJECTS = 2;
     [self waitForExpectationsWithTimeout:2.0 handler:nil];
 }
 
+- (void)testTransportMetricsDelegate {
+    TransportMetricsRecorder *recorder = [TransportMetricsRecorder new];
+    RLMAppConfiguration *config = [[RLMAppConfiguration alloc] initWithBaseURL:@"http://localhost:9090"
+                                                                     transport:nil
+                                                                  localAppName:nil
+                                                               localAppVersion:nil
+                                                       defaultRequestTimeoutMS:60000];
+    config.transportMetricsDelegate = recorder;
+    NSString *appId = [RealmServer.shared createAppAndReturnError:nil];
+    RLMApp *app = [RLMApp appWithId:appId configuration:config];
+    [self logInUserForCredentials:[RLMCredentials anonymousCredentials] app:app];
+
+    @synchronized (recorder) {
+        XCTAssertGreaterThan(recorder.urls.count, 0U);
+        NSPredicate *login = [NSPredicate predicateWithFormat:@"SELF ENDSWITH '/login'"];
+        XCTAssertEqual([recorder.urls filteredArrayUsingPredicate:login].count, 1U);
+    }
+}
+
 - (void)testAsyncOpenConnectionTimeout {
     TimeoutProxyServer *proxy = [[TimeoutProxyServer alloc] initWithPort:5678 targetPort:9090];
     NSError *error;
@@ -2063,6 +2423,74 @@ static const NSInteger NUMBER_OF_BIG_OBJECTS = 2;
     [self waitForExpectationsWithTimeout:60.0 handler:nil];
 }
 
+- (void)testMongoInsertManyInBatches {
+    RLMMongoClient *client = [self.anonymousUser mongoClientWithServiceName:@"mongodb1"];
+    RLMMongoDatabase *database = [client databaseWithName:@"test_data"];
+    RLMMongoCollection *collection = [database collectionWithName:@"Dog"];
+
+    NSMutableArray *documents = [NSMutableArray new];
+    for (int i = 0; i < 50; ++i) {
+        [documents addObject:@{@"_id": @(i), @"name": @"fido", @"breed": @"cane corso"}];
+    }
+
+    // Each batch only fits a few documents, so this is sent as many requests
+    XCTestExpectation *insertManyExpectation = [self expectationWithDescription:@"should insert documents"];
+    [collection insertManyDocuments:documents
+                   maximumBatchSize:200
+           maximumConcurrentBatches:4
+                         completion:^(NSArray<id<RLMBSON>> *objectIds, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects(objectIds, [documents valueForKey:@"_id"]);
+        [insertManyExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:60.0 handler:nil];
+
+    XCTestExpectation *countExpectation = [self expectationWithDescription:@"should count documents"];
+    [collection countWhere:@{@"name": @"fido"} completion:^(NSInteger count, NSError *error) {
+        XCTAssertEqual(count, 50);
+        XCTAssertNil(error);
+        [countExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:60.0 handler:nil];
+}
+
+- (void)testMongoWriteQueue {
+    RLMMongoClient *client = [self.anonymousUser mongoClientWithServiceName:@"mongodb1"];
+    RLMMongoDatabase *database = [client databaseWithName:@"test_data"];
+    RLMMongoCollection *collection = [database collectionWithName:@"Dog"];
+
+    NSError *error;
+    RLMMongoWriteQueue *queue = [client writeQueueWithError:&error];
+    XCTAssertNil(error);
+    XCTAssertEqual(queue, [client writeQueueWithError:nil]);
+    queue.errorHandler = ^(NSError *error) {
+        XCTFail(@"Unexpected error: %@", error);
+    };
+
+    for (int i = 0; i < 10; ++i) {
+        [queue insertOneDocument:@{@"name": @"fido", @"breed": @"cane corso"} inCollection:collection];
+    }
+    [queue updateOneDocumentWhere:@{@"name": @"fido"}
+                   updateDocument:@{@"name": @"rex"}
+                           upsert:NO
+                     inCollection:collection];
+    [queue deleteOneDocumentWhere:@{@"name": @"fido"} inCollection:collection];
+    [queue flush];
+
+    [self expectationForPredicate:[NSPredicate predicateWithFormat:@"pendingOperationCount == 0"]
+              evaluatedWithObject:queue handler:nil];
+    [self waitForExpectationsWithTimeout:60.0 handler:nil];
+    XCTAssertGreaterThan(queue.lastFlushDuration, 0);
+
+    XCTestExpectation *countExpectation = [self expectationWithDescription:@"should count documents"];
+    [collection countWhere:@{@"name": @"fido"} completion:^(NSInteger count, NSError *error) {
+        XCTAssertEqual(count, 8);
+        XCTAssertNil(error);
+        [countExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:60.0 handler:nil];
+}
+
 - (void)testMongoFind {
     RLMMongoClient *client = [self.anonymousUser mongoClientWithServiceName:@"mongodb1"];
     RLMMongoDatabase *database = [client databaseWithName:@"test_data"];
@@ -2198,6 +2626,76 @@ static const NSInteger NUMBER_OF_BIG_OBJECTS = 2;
     [self waitForExpectationsWithTimeout:60.0 handler:nil];
 }
 
+- (void)testMongoFindCursor {
+    RLMMongoClient *client = [self.anonymousUser mongoClientWithServiceName:@"mongodb1"];
+    RLMMongoDatabase *database = [client databaseWithName:@"test_data"];
+    RLMMongoCollection *collection = [database collectionWithName:@"Dog"];
+
+    XCTestExpectation *insertManyExpectation = [self expectationWithDescription:@"should insert documents"];
+    [collection insertManyDocuments:@[
+        @{@"name": @"fido", @"breed": @"cane corso"},
+        @{@"name": @"fido", @"breed": @"cane corso"},
+        @{@"name": @"fido", @"breed": @"cane corso"},
+        @{@"name": @"rex", @"breed": @"tibetan mastiff"}]
+                         completion:^(NSArray<id<RLMBSON>> *objectIds, NSError *error) {
+        XCTAssertEqual(objectIds.count, 4U);
+        XCTAssertNil(error);
+        [insertManyExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:60.0 handler:nil];
+
+    RLMMongoCursor *cursor = [collection findCursorWhere:@{@"name": @"fido"}
+                                                 options:[[RLMFindOptions alloc] init]
+                                               batchSize:2];
+    NSMutableSet *ids = [NSMutableSet new];
+    for (NSUInteger expected : {2U, 1U, 0U}) {
+        XCTestExpectation *ex = [self expectationWithDescription:@"should fetch batch"];
+        // An exhausted cursor completes immediately without fetching anything
+        bool fetching = !cursor.exhausted;
+        [cursor nextBatch:^(NSArray<NSDictionary *> *documents, NSError *error) {
+            XCTAssertNil(error);
+            XCTAssertEqual(documents.count, expected);
+            for (NSDictionary *document in documents) {
+                [ids addObject:document[@"_id"]];
+            }
+            [ex fulfill];
+        }];
+        if (fetching) {
+            XCTAssertThrows([cursor nextBatch:^(NSArray *, NSError *) {}]);
+        }
+        [self waitForExpectationsWithTimeout:60.0 handler:nil];
+    }
+    XCTAssertTrue(cursor.exhausted);
+    XCTAssertEqual(ids.count, 3U);
+
+    RLMFindOptions *options = [[RLMFindOptions alloc] initWithLimit:3 projection:@{@"name": @1} sort:@{@"name": @1}];
+    cursor = [collection findCursorWhere:@{} options:options batchSize:2];
+    for (NSUInteger expected : {2U, 1U}) {
+        XCTestExpectation *ex = [self expectationWithDescription:@"should fetch batch"];
+        [cursor nextBatch:^(NSArray<NSDictionary *> *documents, NSError *error) {
+            XCTAssertNil(error);
+            XCTAssertEqual(documents.count, expected);
+            XCTAssertNil(documents.firstObject[@"breed"]);
+            [ex fulfill];
+        }];
+        [self waitForExpectationsWithTimeout:60.0 handler:nil];
+    }
+    XCTAssertTrue(cursor.exhausted);
+
+    cursor = [collection aggregateCursorWithPipeline:@[@{@"$sort": @{@"name": @1}}] batchSize:3];
+    XCTestExpectation *aggregateExpectation = [self expectationWithDescription:@"should aggregate documents"];
+    [cursor nextBatch:^(NSArray<NSDictionary *> *documents, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqual(documents.count, 3U);
+        XCTAssertFalse(cursor.exhausted);
+        [aggregateExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:60.0 handler:nil];
+
+    RLMAssertThrowsWithReason([collection findCursorWhere:@{} options:[[RLMFindOptions alloc] init] batchSize:0],
+                              @"Invalid batch size 0");
+}
+
 - (void)testMongoUpdate {
     RLMMongoClient *client = [self.anonymousUser mongoClientWithServiceName:@"mongodb1"];
     RLMMongoDatabase *database = [client databaseWithName:@"test_data"];
@@ -2624,6 +3122,39 @@ static const NSInteger NUMBER_OF_BIG_OBJECTS = 2;
     [self waitForExpectations:@[expectation] timeout:60.0];
 }
 
+- (void)testWatchersOfSameCollectionShareStream {
+    RLMMongoClient *client = [self.anonymousUser mongoClientWithServiceName:@"mongodb1"];
+    RLMMongoDatabase *database = [client databaseWithName:@"test_data"];
+    __block RLMMongoCollection *collection = [database collectionWithName:@"Dog"];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"both watchers receive change events"];
+    expectation.expectedFulfillmentCount = 2;
+    __block RLMWatchTestUtility *testUtility1 = [[RLMWatchTestUtility alloc] initWithChangeEventCount:2
+                                                                                         expectation:expectation];
+    __block RLMWatchTestUtility *testUtility2 = [[RLMWatchTestUtility alloc] initWithChangeEventCount:2
+                                                                                         expectation:expectation];
+    __block RLMChangeStream *changeStream1 = [collection watchWithDelegate:testUtility1 delegateQueue:nil];
+    __block RLMChangeStream *changeStream2 = [collection watchWithDelegate:testUtility2 delegateQueue:nil];
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        // The second watcher joins the already-open stream, and is told it's open
+        dispatch_semaphore_wait(testUtility1.isOpenSemaphore, DISPATCH_TIME_FOREVER);
+        dispatch_semaphore_wait(testUtility2.isOpenSemaphore, DISPATCH_TIME_FOREVER);
+        for (int i = 0; i < 2; i++) {
+            [collection insertOneDocument:@{@"name": @"fido"} completion:^(id<RLMBSON> objectId, NSError *error) {
+                XCTAssertNil(error);
+                XCTAssertNotNil(objectId);
+            }];
+            dispatch_semaphore_wait(testUtility1.semaphore, DISPATCH_TIME_FOREVER);
+            dispatch_semaphore_wait(testUtility2.semaphore, DISPATCH_TIME_FOREVER);
+        }
+        [changeStream1 close];
+        [changeStream2 close];
+    });
+
+    [self waitForExpectations:@[expectation] timeout:60.0];
+}
+
 #pragma mark - File paths
 
 static NSString *newPathForPartitionValue(RLMUser *user, id<RLMBSON> partitionValue) {
@@ -2656,6 +3187,34 @@ static NSString *newPathForPartitionValue(RLMUser *user, id<RLMBSON> partitionVa
                           newPathForPartitionValue(user, nil));
 }
 
+- (void)testSyncFileInCustomDirectory {
+    RLMUser *user = self.anonymousUser;
+    NSURL *directory = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:@"custom-sync-dir"];
+    [NSFileManager.defaultManager removeItemAtURL:directory error:nil];
+
+    RLMRealmConfiguration *configuration = [user configurationWithPartitionValue:self.name];
+    RLMSyncConfiguration *syncConfig = configuration.syncConfiguration;
+    XCTAssertNil(syncConfig.directoryURL);
+    syncConfig.directoryURL = directory;
+    configuration.syncConfiguration = syncConfig;
+    configuration.objectClasses = @[Person.class];
+
+    XCTAssertEqualObjects(configuration.fileURL.URLByDeletingLastPathComponent.path, directory.path);
+    XCTAssertEqualObjects(configuration.fileURL.lastPathComponent,
+                          newPathForPartitionValue(user, self.name).lastPathComponent);
+    XCTAssertEqualObjects(configuration.syncConfiguration.directoryURL.path, directory.path);
+
+    // Setting the returned sync configuration again keeps the custom directory
+    NSURL *fileURL = configuration.fileURL;
+    configuration.syncConfiguration = configuration.syncConfiguration;
+    XCTAssertEqualObjects(configuration.fileURL, fileURL);
+
+    RLMRealm *realm = [self openRealmWithConfiguration:configuration];
+    XCTAssertEqualObjects(realm.configuration.fileURL, fileURL);
+    XCTAssertTrue([NSFileManager.defaultManager fileExistsAtPath:fileURL.path]);
+    XCTAssertNotNil([user sessionForPartitionValue:self.name]);
+}
+
 static NSString *oldPathForPartitionValue(RLMUser *user, id<RLMBSON> partitionValue) {
     std::stringstream s;
     s << RLMConvertRLMBSONToBson(partitionValue);
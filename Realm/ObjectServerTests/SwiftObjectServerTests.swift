@@ -314,6 +314,35 @@ class SwiftObjectServerTests: SwiftSyncTestCase {
         }
     }
 
+    func testObserveConnectionState() {
+        do {
+            let user = try logInUser(for: basicCredentials())
+            let realm = try immediatelyOpenRealm(partitionValue: #function, user: user)
+            let session = realm.syncSession!
+            waitForDownloads(for: realm)
+
+            var changes = [SyncSession.ConnectionStateChange]()
+            let ex = expectation(description: "reconnected")
+            let token = session.observeConnectionState { change in
+                changes.append(change)
+                if change.newState == .connected {
+                    ex.fulfill()
+                }
+            }
+            XCTAssertNotNil(token)
+            session.suspend()
+            session.resume()
+            waitForExpectations(timeout: 5.0)
+            token?.invalidate()
+
+            XCTAssertEqual(changes.map(\.oldState), [.connected, .disconnected, .connecting])
+            XCTAssertEqual(changes.map(\.newState), [.disconnected, .connecting, .connected])
+            XCTAssertTrue(changes.allSatisfy { $0.timeInPreviousState >= 0 })
+        } catch {
+            XCTFail("Got an error: \(error) (process: \(isParent ? "parent" : "child"))")
+        }
+    }
+
     // MARK: - Client reset
 
     func testClientReset() {
@@ -1308,6 +1337,10 @@ class SwiftObjectServerTests: SwiftSyncTestCase {
 
         XCTAssertEqual(app.currentUser?.customData["favourite_colour"], .string("green"))
         XCTAssertEqual(app.currentUser?.customData["apples"], .int64(10))
+
+        // The decoded custom data is shared until the access token changes
+        let customData = app.currentUser!.__customData as NSDictionary
+        XCTAssertTrue(customData === app.currentUser!.__customData as NSDictionary)
     }
 }
 
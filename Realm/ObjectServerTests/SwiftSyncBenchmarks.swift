@@ -0,0 +1,259 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2021 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#if os(macOS)
+
+import Foundation
+import RealmSwift
+import XCTest
+
+#if canImport(RealmTestSupport)
+import RealmSwiftSyncTestSupport
+import RealmSyncTestSupport
+import RealmTestSupport
+#endif
+
+/// Benchmarks for sync against the local test server.
+///
+/// These take a while to run and are only meaningful on an otherwise idle
+/// machine, so they're skipped unless `REALM_SYNC_BENCHMARKS` is set. All
+/// traffic goes through a `TimeoutProxyServer` which applies the network
+/// conditions from the environment:
+///
+/// - `REALM_SYNC_BENCHMARK_LATENCY`: added latency per chunk in seconds
+/// - `REALM_SYNC_BENCHMARK_BANDWIDTH`: bandwidth limit in bytes per second
+/// - `REALM_SYNC_BENCHMARK_SIZE_MB`: the amount of data to transfer (default 10)
+///
+/// Each result is printed on a line starting with `SYNC_BENCHMARK` followed by
+/// a JSON object, and is also appended to the file at
+/// `REALM_SYNC_BENCHMARK_OUTPUT` if that's set.
+@available(OSX 10.14, *)
+@objc(SwiftSyncBenchmarks)
+class SwiftSyncBenchmarks: SwiftSyncTestCase {
+    private static let environment = ProcessInfo.processInfo.environment
+    private static let latency = Double(environment["REALM_SYNC_BENCHMARK_LATENCY"] ?? "") ?? 0
+    private static let bandwidth = Double(environment["REALM_SYNC_BENCHMARK_BANDWIDTH"] ?? "") ?? 0
+    private static let megabytes = Int(environment["REALM_SYNC_BENCHMARK_SIZE_MB"] ?? "") ?? 10
+    private static let iterations = 20
+
+    // The app's base URL points at the proxy, and apps are cached by id, so
+    // the benchmarks use their own app rather than the shared test app
+    private static var proxy: TimeoutProxyServer?
+    private static var proxiedApp: App?
+
+    override class var defaultTestSuite: XCTestSuite {
+        if environment["REALM_SYNC_BENCHMARKS"] != nil {
+            return super.defaultTestSuite
+        }
+        return XCTestSuite(name: "SwiftSyncBenchmarks")
+    }
+
+    override class func tearDown() {
+        proxy?.stop()
+        proxy = nil
+        proxiedApp = nil
+        super.tearDown()
+    }
+
+    private var benchmarkApp: App {
+        if let app = Self.proxiedApp {
+            return app
+        }
+        let proxy = TimeoutProxyServer(port: 5680, targetPort: 9090)
+        proxy.latency = Self.latency
+        proxy.bytesPerSecond = Self.bandwidth
+        try! proxy.start()
+        Self.proxy = proxy
+
+        let appConfig = AppConfiguration(baseURL: "http://localhost:5680", transport: nil,
+                                         localAppName: nil, localAppVersion: nil)
+        let app = App(id: try! RealmServer.shared.createApp(), configuration: appConfig)
+        Self.proxiedApp = app
+        return app
+    }
+
+    private func logInBenchmarkUser() throws -> User {
+        return try logInUser(for: basicCredentials(app: benchmarkApp), app: benchmarkApp)
+    }
+
+    private func seconds(since start: DispatchTime) -> Double {
+        return Double(DispatchTime.now().uptimeNanoseconds - start.uptimeNanoseconds) / 1e9
+    }
+
+    private func report(_ metric: String, _ value: Double, unit: String, benchmark: String = #function) {
+        let result: [String: Any] = [
+            "benchmark": benchmark.replacingOccurrences(of: "()", with: ""),
+            "metric": metric,
+            "value": value,
+            "unit": unit,
+            "latency": Self.latency,
+            "bandwidth": Self.bandwidth,
+            "megabytes": Self.megabytes,
+            "timestamp": Date().timeIntervalSince1970
+        ]
+        let json = try! JSONSerialization.data(withJSONObject: result, options: [.sortedKeys])
+        let line = String(data: json, encoding: .utf8)!
+        print("SYNC_BENCHMARK \(line)")
+
+        guard let path = Self.environment["REALM_SYNC_BENCHMARK_OUTPUT"] else {
+            return
+        }
+        if !FileManager.default.fileExists(atPath: path) {
+            FileManager.default.createFile(atPath: path, contents: nil)
+        }
+        let handle = FileHandle(forWritingAtPath: path)!
+        handle.seekToEndOfFile()
+        handle.write(Data((line + "\n").utf8))
+        handle.closeFile()
+    }
+
+    private func reportLatencies(_ samples: [Double], benchmark: String = #function) {
+        let sorted = samples.sorted()
+        report("p50", sorted[sorted.count / 2] * 1000, unit: "ms", benchmark: benchmark)
+        report("p90", sorted[sorted.count * 9 / 10] * 1000, unit: "ms", benchmark: benchmark)
+        report("max", sorted.last! * 1000, unit: "ms", benchmark: benchmark)
+    }
+
+    private func writeHugeObjects(to realm: Realm) throws {
+        try realm.write {
+            for _ in 0..<Self.megabytes {
+                realm.add(SwiftHugeSyncObject.create())
+            }
+        }
+    }
+
+    private func wait(for session: SyncSession, state: SyncSession.ConnectionState) {
+        let ex = expectation(description: "Wait for connection state: \(state)")
+        ex.assertForOverFulfill = false
+        let token = session.observe(\SyncSession.connectionState, options: .initial) { s, _ in
+            if s.connectionState == state {
+                ex.fulfill()
+            }
+        }
+        waitForExpectations(timeout: 60.0)
+        token.invalidate()
+    }
+
+    func testUploadThroughput() throws {
+        let user = try logInBenchmarkUser()
+        let realm = try openRealm(configuration: user.configuration(testName: #function))
+
+        let start = DispatchTime.now()
+        try writeHugeObjects(to: realm)
+        waitForUploads(for: realm)
+        let elapsed = seconds(since: start)
+
+        report("throughput", Double(Self.megabytes) / elapsed, unit: "MB/s")
+        report("time", elapsed, unit: "s")
+    }
+
+    func testDownloadThroughput() throws {
+        let reader = try openRealm(configuration: logInBenchmarkUser().configuration(testName: #function))
+        reader.syncSession!.suspend()
+
+        let writer = try openRealm(configuration: logInBenchmarkUser().configuration(testName: #function))
+        try writeHugeObjects(to: writer)
+        waitForUploads(for: writer)
+
+        let start = DispatchTime.now()
+        reader.syncSession!.resume()
+        waitForDownloads(for: reader)
+        let elapsed = seconds(since: start)
+        checkCount(expected: Self.megabytes, reader, SwiftHugeSyncObject.self)
+
+        report("throughput", Double(Self.megabytes) / elapsed, unit: "MB/s")
+        report("time", elapsed, unit: "s")
+    }
+
+    func testBootstrapTime() throws {
+        let writer = try openRealm(configuration: logInBenchmarkUser().configuration(testName: #function))
+        try writeHugeObjects(to: writer)
+        waitForUploads(for: writer)
+
+        let config = try logInBenchmarkUser().configuration(testName: #function)
+        let ex = expectation(description: "async open")
+        let start = DispatchTime.now()
+        var elapsed: Double = 0
+        Realm.asyncOpen(configuration: config) { result in
+            elapsed = self.seconds(since: start)
+            switch result {
+            case .success(let realm):
+                XCTAssertEqual(realm.objects(SwiftHugeSyncObject.self).count, Self.megabytes)
+            case .failure(let error):
+                XCTFail("Got an error: \(error)")
+            }
+            ex.fulfill()
+        }
+        waitForExpectations(timeout: 600.0)
+
+        report("time", elapsed, unit: "s")
+        report("throughput", Double(Self.megabytes) / elapsed, unit: "MB/s")
+    }
+
+    func testCommitToRemoteVisibilityLatency() throws {
+        let reader = try openRealm(configuration: logInBenchmarkUser().configuration(testName: #function))
+        let writer = try openRealm(configuration: logInBenchmarkUser().configuration(testName: #function))
+
+        let results = reader.objects(SwiftPerson.self)
+        var expectedCount = 0
+        var ex: XCTestExpectation?
+        let token = results.observe { _ in
+            if results.count >= expectedCount {
+                ex?.fulfill()
+                ex = nil
+            }
+        }
+
+        var samples = [Double]()
+        for i in 1...Self.iterations {
+            expectedCount = i
+            ex = expectation(description: "change \(i) visible")
+            let start = DispatchTime.now()
+            try writer.write {
+                writer.add(SwiftPerson(firstName: "\(i)", lastName: ""))
+            }
+            waitForExpectations(timeout: 60.0)
+            samples.append(seconds(since: start))
+        }
+        token.invalidate()
+
+        reportLatencies(samples)
+    }
+
+    func testReconnectTime() throws {
+        let user = try logInBenchmarkUser()
+        let realm = try openRealm(configuration: user.configuration(testName: #function))
+        let session = realm.syncSession!
+        wait(for: session, state: .connected)
+
+        var samples = [Double]()
+        for _ in 0..<Self.iterations {
+            session.suspend()
+            wait(for: session, state: .disconnected)
+
+            let start = DispatchTime.now()
+            session.resume()
+            wait(for: session, state: .connected)
+            samples.append(seconds(since: start))
+        }
+
+        reportLatencies(samples)
+    }
+}
+
+#endif // os(macOS)
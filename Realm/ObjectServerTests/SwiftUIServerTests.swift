@@ -136,7 +136,7 @@ class SwiftUIServerTests: SwiftSyncTestCase {
         let ex = expectation(description: "progress-async-open")
         asyncOpen(user: user, appId: appId, partitionValue: #function) { asyncOpenState in
             if case let .progress(progress) = asyncOpenState {
-                XCTAssertTrue(progress.fractionCompleted > 0)
+                XCTAssertTrue(progress.fractionCompleted >= 0 && progress.fractionCompleted <= 1)
                 if progress.isFinished {
                     ex.fulfill()
                 }
@@ -375,7 +375,7 @@ class SwiftUIServerTests: SwiftSyncTestCase {
         let ex = expectation(description: "progress-auto-open")
         autoOpen(user: user, appId: appId, partitionValue: #function) { autoOpenState in
             if case let .progress(progress) = autoOpenState {
-                XCTAssertTrue(progress.fractionCompleted > 0)
+                XCTAssertTrue(progress.fractionCompleted >= 0 && progress.fractionCompleted <= 1)
                 if progress.isFinished {
                     ex.fulfill()
                 }
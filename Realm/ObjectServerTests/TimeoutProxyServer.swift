@@ -45,6 +45,34 @@ public class TimeoutProxyServer: NSObject {
         }
     }
 
+    // Additional delay in seconds applied to every chunk of data forwarded in
+    // either direction
+    private var _latency: Double = 0
+    @objc public var latency: Double {
+        get {
+            _latency
+        }
+        set {
+            queue.sync {
+                _latency = newValue
+            }
+        }
+    }
+
+    // Maximum rate in bytes per second at which data is forwarded in each
+    // direction, or zero for no limit
+    private var _bytesPerSecond: Double = 0
+    @objc public var bytesPerSecond: Double {
+        get {
+            _bytesPerSecond
+        }
+        set {
+            queue.sync {
+                _bytesPerSecond = newValue
+            }
+        }
+    }
+
     @objc public init(port: UInt16, targetPort: UInt16) {
         self.port = NWEndpoint.Port(rawValue: port)!
         self.targetPort = NWEndpoint.Port(rawValue: targetPort)!
@@ -85,12 +113,29 @@ public class TimeoutProxyServer: NSObject {
                 }
                 return
             }
-            to.send(content: data, contentContext: context ?? .defaultMessage,
-                    isComplete: isComplete, completion: .contentProcessed({ [weak self] _ in
-                        if !isComplete {
-                            self?.copy(from: from, to: to)
-                        }
-                    }))
+            let send = {
+                to.send(content: data, contentContext: context ?? .defaultMessage,
+                        isComplete: isComplete, completion: .contentProcessed({ [weak self] _ in
+                            if !isComplete {
+                                self?.copy(from: from, to: to)
+                            }
+                        }))
+            }
+            // The next chunk isn't read until this one has been sent, so
+            // delaying each send both shapes the bandwidth and keeps the data
+            // in order
+            guard let self = self else {
+                return send()
+            }
+            var delay = self._latency
+            if self._bytesPerSecond > 0 {
+                delay += Double(data.count) / self._bytesPerSecond
+            }
+            if delay > 0 {
+                self.queue.asyncAfter(deadline: .now() + delay, execute: send)
+            } else {
+                send()
+            }
         }
     }
 }
@@ -40,6 +40,23 @@ FOUNDATION_EXTERN id __nullable RLMDynamicGetByName(RLMObjectBase *obj, NSString
 // by property/column
 void RLMDynamicSet(RLMObjectBase *obj, RLMProperty *prop, id val);
 
+// A property of an object schema which has been resolved ahead of time, for
+// reading and writing a property of many objects without looking it up by
+// name each time. Obtained from `-[RLMObjectSchema handleForProperty:]`.
+@interface RLMPropertyHandle : NSObject
+@property (nonatomic, readonly) RLMObjectSchema *objectSchema;
+@property (nonatomic, readonly) RLMProperty *property;
+
+- (instancetype)initWithObjectSchema:(RLMObjectSchema *)objectSchema property:(RLMProperty *)property;
+@end
+
+// by handle
+// Objects from the Realm which the handle's object schema came from skip the
+// property lookup, and reads of non-link, non-collection properties are read
+// directly from the row. Other objects fall back to looking up the property by name.
+FOUNDATION_EXTERN id __nullable RLMDynamicGetWithHandle(RLMObjectBase *obj, RLMPropertyHandle *handle);
+FOUNDATION_EXTERN void RLMDynamicValidatedSetWithHandle(RLMObjectBase *obj, RLMPropertyHandle *handle, id __nullable val);
+
 //
 // Class modification
 //
@@ -20,6 +20,7 @@
 
 #import "RLMClassInfo.hpp"
 #import "RLMDecimal128_Private.hpp"
+#import "RLMObjectStore.h"
 #import "RLMObjectId_Private.hpp"
 #import "RLMUUID_Private.hpp"
 #import "RLMUtil.hpp"
@@ -155,6 +156,37 @@ private:
 
     std::unique_ptr<RLMObservationTracker> _observationHelper;
 
+    // How property values are read from the input value passed to
+    // value_for_property(). This is the same for every property of a single
+    // input, so it is determined only when the input changes.
+    enum class ValueKind {
+        NSArray,
+        NSDictionary,
+        ArrayLike,
+        DictionaryLike,
+        ManagedSameSchema,
+        SameClass,
+        KVC
+    };
+    __unsafe_unretained id _currentValue = nil;
+    ValueKind _currentValueKind;
+    NSUInteger _currentValueCount;
+
+    // The class info of the most recent managed input object found to have a
+    // schema identical to ours, so that the schemas are compared only once
+    // when copying many objects from another Realm
+    RLMClassInfo* _sameSchemaInfo = nullptr;
+
+    bool hasSameSchema(RLMObjectBase *obj);
+
     id defaultValue(NSString *key);
     id propertyValue(id obj, size_t propIndex, __unsafe_unretained RLMProperty *const prop);
+    id storageValue(realm::ColKey column, id value);
 };
+
+// Defined inline so that the +1 accessor from RLMCreateObjectAccessor() can be
+// handed directly to the caller rather than being autoreleased on the way out
+// of a separate translation unit, which matters in tight loops over collections
+inline id RLMAccessorContext::box(realm::Obj&& r) {
+    return RLMCreateObjectAccessor(_info, std::move(r));
+}
@@ -19,6 +19,8 @@
 #import "RLMAccessor.hpp"
 
 #import "RLMArray_Private.hpp"
+#import "RLMBlobStore.hpp"
+#import "RLMCompression.hpp"
 #import "RLMDictionary_Private.hpp"
 #import "RLMObjectId_Private.hpp"
 #import "RLMObjectSchema_Private.hpp"
@@ -97,15 +99,39 @@ T get(__unsafe_unretained RLMObjectBase *const obj, NSUInteger index) {
     return obj->_row.get<T>(getProperty(obj, index).column_key);
 }
 
+std::string const& blobRealmPath(__unsafe_unretained RLMRealm *const realm) {
+    return realm->_realm->config().path;
+}
+
 template<typename T>
-id getBoxed(__unsafe_unretained RLMObjectBase *const obj, NSUInteger index) {
-    RLMVerifyAttached(obj);
+id readBoxed(__unsafe_unretained RLMObjectBase *const obj, NSUInteger index) {
     auto& prop = getProperty(obj, index);
     RLMAccessorContext ctx(obj, &prop);
     auto value = obj->_row.get<T>(prop.column_key);
+    if constexpr (std::is_same_v<T, realm::BinaryData>) {
+        if (!isNull(value) && obj->_info->isExternalBlob(prop.column_key)) {
+            return RLMReadBlob(blobRealmPath(obj->_realm), value);
+        }
+    }
+    if constexpr (std::is_same_v<T, realm::BinaryData>) {
+        if (RLMIsCompressedValue(value.data(), value.size()) && obj->_info->compressionForColumn(prop.column_key)) {
+            return RLMDecompressValue(value.data(), value.size());
+        }
+    }
     return isNull(value) ? nil : ctx.box(std::move(value));
 }
 
+template<typename T>
+id getBoxed(__unsafe_unretained RLMObjectBase *const obj, NSUInteger index) {
+    RLMVerifyAttached(obj);
+    if (auto cache = obj->_sideTable ? obj->_sideTable->frozenValueCache.get() : nullptr) {
+        return cache->get(obj->_row.get_key(), index,
+                          obj->_info->objectSchema->persisted_properties.size(),
+                          [&] { return readBoxed<T>(obj, index); });
+    }
+    return readBoxed<T>(obj, index);
+}
+
 template<typename T>
 T getOptional(__unsafe_unretained RLMObjectBase *const obj, uint16_t key, bool *gotValue) {
     auto ret = get<realm::util::Optional<T>>(obj, key);
@@ -148,6 +174,18 @@ void setValue(__unsafe_unretained RLMObjectBase *const obj,
 
 void setValue(__unsafe_unretained RLMObjectBase *const obj, ColKey key,
               __unsafe_unretained NSData *const value) {
+    if ([value isKindOfClass:[NSData class]]) {
+        if (obj->_info->isExternalBlob(key)) {
+            setValueOrNull<realm::BinaryData>(obj, key, RLMStoreBlob(blobRealmPath(obj->_realm), value));
+            return;
+        }
+        if (auto algorithm = obj->_info->compressionForColumn(key)) {
+            if (NSData *compressed = RLMCompressValue(static_cast<const char *>(value.bytes), value.length, algorithm)) {
+                setValueOrNull<realm::BinaryData>(obj, key, compressed);
+                return;
+            }
+        }
+    }
     setValueOrNull<realm::BinaryData>(obj, key, value);
 }
 
@@ -389,7 +427,7 @@ static realm::ColKey willChange(RLMObservationTracker& tracker,
     if (prop.is_primary) {
         @throw RLMException(@"Primary key can't be changed after an object is inserted.");
     }
-    tracker.willChange(RLMGetObservationInfo(obj->_observationInfo, obj->_row.get_key(), *obj->_info),
+    tracker.willChange(RLMGetObservationInfo(RLMGetObjectObservationInfo(obj), obj->_row.get_key(), *obj->_info),
                        obj->_objectSchema.properties[index].name);
     return prop.column_key;
 }
@@ -575,6 +613,7 @@ Class createAccessorClass(Class objectClass,
                           id (*getterGetter)(RLMProperty *, const char *),
                           id (*setterGetter)(RLMProperty *, const char *)) {
     REALM_ASSERT_DEBUG(RLMIsObjectOrSubclass(objectClass));
+    RLM_SIGNPOST_INTERVAL("Create accessor class");
 
     // create and register proxy class which derives from object class
     Class accClass = objc_allocateClassPair(objectClass, accessorClassName, 0);
@@ -666,14 +705,10 @@ void RLMReplaceSharedSchemaMethod(Class accessorClass, RLMObjectSchema *schema)
     class_addMethod(metaClass, @selector(sharedSchema), imp, "@@:");
 }
 
-void RLMDynamicValidatedSet(RLMObjectBase *obj, NSString *propName, id val) {
-    RLMVerifyAttached(obj);
+static void validatedSet(__unsafe_unretained RLMObjectBase *const obj,
+                         __unsafe_unretained RLMProperty *const prop,
+                         __unsafe_unretained id const val) {
     RLMObjectSchema *schema = obj->_objectSchema;
-    RLMProperty *prop = schema[propName];
-    if (!prop) {
-        @throw RLMException(@"Invalid property name '%@' for class '%@'.",
-                            propName, obj->_objectSchema.className);
-    }
     if (prop.isPrimary) {
         @throw RLMException(@"Primary key can't be changed to '%@' after an object is inserted.", val);
     }
@@ -685,11 +720,27 @@ void RLMDynamicValidatedSet(RLMObjectBase *obj, NSString *propName, id val) {
     RLMDynamicSet(obj, prop, RLMCoerceToNil(val));
 }
 
+void RLMDynamicValidatedSet(RLMObjectBase *obj, NSString *propName, id val) {
+    RLMVerifyAttached(obj);
+    RLMProperty *prop = obj->_objectSchema[propName];
+    if (!prop) {
+        @throw RLMException(@"Invalid property name '%@' for class '%@'.",
+                            propName, obj->_objectSchema.className);
+    }
+    validatedSet(obj, prop, val);
+}
+
 // Precondition: the property is not a primary key
 void RLMDynamicSet(__unsafe_unretained RLMObjectBase *const obj,
                    __unsafe_unretained RLMProperty *const prop,
                    __unsafe_unretained id const val) {
     REALM_ASSERT_DEBUG(!prop.isPrimary);
+    if (prop.externalBlob || prop.compression) {
+        RLMObservationTracker tracker(obj->_realm);
+        willChange(tracker, obj, prop.index);
+        setValue(obj, getProperty(obj, prop).column_key, (NSData *)RLMCoerceToNil(val));
+        return;
+    }
     realm::Object o(obj->_info->realm->_realm, *obj->_info->objectSchema, obj->_row);
     RLMAccessorContext c(obj);
     RLMTranslateError([&] {
@@ -704,6 +755,9 @@ id RLMDynamicGet(__unsafe_unretained RLMObjectBase *const obj, __unsafe_unretain
     if (!obj->_realm) {
         return [obj valueForKey:prop.name];
     }
+    if (prop.externalBlob || prop.compression) {
+        return getBoxed<realm::BinaryData>(obj, prop.index);
+    }
 
     realm::Object o(obj->_realm->_realm, *obj->_info->objectSchema, obj->_row);
     RLMAccessorContext c(obj);
@@ -723,6 +777,63 @@ id RLMDynamicGetByName(__unsafe_unretained RLMObjectBase *const obj,
     return RLMDynamicGet(obj, prop);
 }
 
+@implementation RLMPropertyHandle {
+@public
+    RLMObjectSchema *_objectSchema;
+    RLMProperty *_property;
+    // Whether the property's value can be read directly from the row as a
+    // Mixed rather than requiring an accessor context to box it
+    bool _readsRow;
+}
+
+- (instancetype)initWithObjectSchema:(RLMObjectSchema *)objectSchema property:(RLMProperty *)property {
+    if ((self = [super init])) {
+        _objectSchema = objectSchema;
+        _property = property;
+        _readsRow = !property.collection && !property.linkOriginPropertyName
+            && property.type != RLMPropertyTypeObject && property.type != RLMPropertyTypeLinkingObjects
+            && property.type != RLMPropertyTypeAny && !property.externalBlob && !property.compression;
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"RLMPropertyHandle(%@.%@)", _objectSchema.className, _property.name];
+}
+@end
+
+static RLMProperty *propertyForHandle(__unsafe_unretained RLMObjectBase *const obj,
+                                      __unsafe_unretained RLMPropertyHandle *const handle) {
+    if (obj->_objectSchema == handle->_objectSchema) {
+        return handle->_property;
+    }
+    RLMProperty *prop = obj->_objectSchema[handle->_property.name];
+    if (!prop) {
+        @throw RLMException(@"Invalid property name '%@' for class '%@'.",
+                            handle->_property.name, obj->_objectSchema.className);
+    }
+    return prop;
+}
+
+id RLMDynamicGetWithHandle(__unsafe_unretained RLMObjectBase *const obj,
+                           __unsafe_unretained RLMPropertyHandle *const handle) {
+    if (!obj->_realm || !handle->_readsRow || obj->_objectSchema != handle->_objectSchema) {
+        return RLMDynamicGet(obj, propertyForHandle(obj, handle));
+    }
+
+    RLMVerifyAttached(obj);
+    return RLMTranslateError([&] {
+        return RLMCoerceToNil(RLMMixedToObjc(obj->_row.get_any(obj->_info->tableColumn(handle->_property))));
+    });
+}
+
+void RLMDynamicValidatedSetWithHandle(__unsafe_unretained RLMObjectBase *const obj,
+                                      __unsafe_unretained RLMPropertyHandle *const handle,
+                                      __unsafe_unretained id const val) {
+    RLMVerifyAttached(obj);
+    validatedSet(obj, propertyForHandle(obj, handle), val);
+}
+
 #pragma mark - Swift property getters and setter
 
 #define REALM_SWIFT_PROPERTY_ACCESSOR(objc, swift, rlmtype) \
@@ -751,6 +862,17 @@ NSString *RLMGetSwiftPropertyString(__unsafe_unretained RLMObjectBase *const obj
     return getBoxed<realm::StringData>(obj, key);
 }
 
+const char *RLMGetSwiftPropertyStringUTF8(__unsafe_unretained RLMObjectBase *const obj, uint16_t key,
+                                          size_t *length) {
+    auto value = get<realm::StringData>(obj, key);
+    if (value.is_null()) {
+        *length = 0;
+        return nullptr;
+    }
+    *length = value.size();
+    return value.data() ?: "";
+}
+
 NSData *RLMGetSwiftPropertyData(__unsafe_unretained RLMObjectBase *const obj, uint16_t key) {
     return getBoxed<realm::BinaryData>(obj, key);
 }
@@ -855,29 +977,91 @@ id RLMAccessorContext::defaultValue(__unsafe_unretained NSString *const key) {
     return _defaultValues[key];
 }
 
+bool RLMAccessorContext::hasSameSchema(__unsafe_unretained RLMObjectBase *const obj) {
+    if (!obj->_info || !obj->_row.is_valid()) {
+        return false;
+    }
+    // Reading the columns directly skips the thread check in the accessors
+    [obj->_realm verifyThread];
+    if (obj->_info == _sameSchemaInfo) {
+        return true;
+    }
+    if (*obj->_info->objectSchema == *_info.objectSchema) {
+        _sameSchemaInfo = obj->_info;
+        return true;
+    }
+    return false;
+}
+
 id RLMAccessorContext::propertyValue(__unsafe_unretained id const obj, size_t propIndex,
                                      __unsafe_unretained RLMProperty *const prop) {
-    // Property value from an NSArray
-    if ([obj respondsToSelector:@selector(objectAtIndex:)]) {
-        return propIndex < [obj count] ? [obj objectAtIndex:propIndex] : nil;
+    if (obj != _currentValue) {
+        _currentValue = obj;
+        if ([obj isKindOfClass:[NSArray class]]) {
+            _currentValueKind = ValueKind::NSArray;
+            _currentValueCount = CFArrayGetCount((__bridge CFArrayRef)obj);
+        }
+        else if ([obj isKindOfClass:[NSDictionary class]]) {
+            _currentValueKind = ValueKind::NSDictionary;
+        }
+        else if ([obj respondsToSelector:@selector(objectAtIndex:)]) {
+            _currentValueKind = ValueKind::ArrayLike;
+        }
+        else if ([obj respondsToSelector:@selector(objectForKey:)]) {
+            _currentValueKind = ValueKind::DictionaryLike;
+        }
+        else if ([obj isKindOfClass:_info.rlmObjectSchema.objectClass]) {
+            _currentValueKind = hasSameSchema(obj) ? ValueKind::ManagedSameSchema : ValueKind::SameClass;
+        }
+        else {
+            _currentValueKind = ValueKind::KVC;
+        }
     }
 
-    // Property value from an NSDictionary
-    if ([obj respondsToSelector:@selector(objectForKey:)]) {
-        return [obj objectForKey:prop.name];
-    }
+    switch (_currentValueKind) {
+        // Property value from an NSArray
+        case ValueKind::NSArray:
+            return propIndex < _currentValueCount
+                ? (__bridge id)CFArrayGetValueAtIndex((__bridge CFArrayRef)obj, propIndex)
+                : nil;
+        case ValueKind::ArrayLike:
+            return propIndex < [obj count] ? [obj objectAtIndex:propIndex] : nil;
+
+        // Property value from an NSDictionary
+        case ValueKind::NSDictionary:
+            return (__bridge id)CFDictionaryGetValue((__bridge CFDictionaryRef)obj,
+                                                     (__bridge const void *)prop.name);
+        case ValueKind::DictionaryLike:
+            return [obj objectForKey:prop.name];
+
+        // Property value from a managed object with an identical schema, which
+        // for non-link, non-collection properties can be read straight from
+        // the source column rather than through the accessors. External blob
+        // references are only meaningful for the source Realm's blob store, and
+        // compression isn't part of the schema so may differ between the two.
+        case ValueKind::ManagedSameSchema:
+            if (!prop.collection && prop.type != RLMPropertyTypeObject && prop.type != RLMPropertyTypeAny
+                && !prop.externalBlob && !prop.compression) {
+                __unsafe_unretained RLMObjectBase *const source = obj;
+                auto colKey = source->_info->objectSchema->persisted_properties[propIndex].column_key;
+                return RLMMixedToObjc(source->_row.get_any(colKey));
+            }
+            [[fallthrough]];
+
+        // Property value from an instance of this object type
+        case ValueKind::SameClass:
+            if (prop.swiftAccessor) {
+                return [prop.swiftAccessor get:prop on:obj];
+            }
+            [[fallthrough]];
 
-    // Property value from an instance of this object type
-    id value;
-    if ([obj isKindOfClass:_info.rlmObjectSchema.objectClass] && prop.swiftAccessor) {
-        return [prop.swiftAccessor get:prop on:obj];
-    }
-    else {
         // Property value from some object that's KVC-compatible
-        value = RLMValidatedValueForProperty(obj, [obj respondsToSelector:prop.getterSel] ? prop.getterName : prop.name,
-                                             _info.rlmObjectSchema.className);
+        case ValueKind::KVC: {
+            id value = RLMValidatedValueForProperty(obj, [obj respondsToSelector:prop.getterSel] ? prop.getterName : prop.name,
+                                                    _info.rlmObjectSchema.className);
+            return value ?: NSNull.null;
+        }
     }
-    return value ?: NSNull.null;
 }
 
 realm::Obj RLMAccessorContext::create_embedded_object() {
@@ -920,10 +1104,6 @@ id RLMAccessorContext::box(realm::Object&& o) {
     return RLMCreateObjectAccessor(_info.linkTargetType(currentProperty.index), o.obj());
 }
 
-id RLMAccessorContext::box(realm::Obj&& r) {
-    return RLMCreateObjectAccessor(_info, std::move(r));
-}
-
 id RLMAccessorContext::box(realm::Results&& r) {
     REALM_ASSERT(currentProperty);
     return [RLMResults resultsWithObjectInfo:_realm->_info[currentProperty.objectClassName]
@@ -1026,6 +1206,10 @@ RLMAccessorContext::createObject(id value, realm::CreatePolicy policy,
         @throw RLMException(@"Must provide a non-nil value.");
     }
 
+    // The previous input may have been deallocated and a new object allocated
+    // at the same address, so forget what kind of value it was
+    _currentValue = nil;
+
     if ([value isKindOfClass:[NSArray class]] && [value count] > _info.objectSchema->persisted_properties.size()) {
         @throw RLMException(@"Invalid array input: more values (%llu) than properties (%llu).",
                             (unsigned long long)[value count],
@@ -1067,7 +1251,7 @@ RLMAccessorContext::createObject(id value, realm::CreatePolicy policy,
             if (objBase->_realm) {
                 @throw RLMException(@"Object is already managed by another Realm. Use create instead to copy it into this Realm.");
             }
-            if (objBase->_observationInfo && objBase->_observationInfo->hasObservers()) {
+            if (auto info = RLMGetObjectObservationInfo(objBase); info && info->hasObservers()) {
                 requiresSwiftUIObservers = [RLMSwiftUIKVO removeObserversFromObject:objBase];
                 if (!requiresSwiftUIObservers) {
                     @throw RLMException(@"Cannot add an object with observers to a Realm");
@@ -1147,19 +1331,39 @@ void RLMAccessorContext::did_change() {
 }
 
 RLMOptionalId RLMAccessorContext::value_for_property(__unsafe_unretained id const obj,
-                                                     realm::Property const&, size_t propIndex) {
+                                                     realm::Property const& property, size_t propIndex) {
     auto prop = _info.rlmObjectSchema.properties[propIndex];
     id value = propertyValue(obj, propIndex, prop);
-    if (value) {
+    // Values read from an object with an identical schema are already known
+    // to be valid for the property
+    if (value && _currentValueKind != ValueKind::ManagedSameSchema) {
         RLMValidateValueForProperty(value, _info.rlmObjectSchema, prop);
     }
-    return RLMOptionalId{value};
+    return RLMOptionalId{storageValue(property.column_key, value)};
 }
 
 RLMOptionalId RLMAccessorContext::default_value_for_property(realm::ObjectSchema const&,
                                                              realm::Property const& prop)
 {
-    return RLMOptionalId{defaultValue(@(prop.name.c_str()))};
+    return RLMOptionalId{storageValue(prop.column_key, defaultValue(@(prop.name.c_str())))};
+}
+
+// The column for an external blob property stores a reference to the value in
+// the blob store rather than the value itself, and the column for a compressed
+// property stores the encoded value
+id RLMAccessorContext::storageValue(realm::ColKey column, __unsafe_unretained id const value) {
+    if (_info.isExternalBlob(column)) {
+        return [value isKindOfClass:[NSData class]] ? RLMStoreBlob(blobRealmPath(_realm), value) : value;
+    }
+    auto algorithm = _info.compressionForColumn(column);
+    if (!algorithm) {
+        return value;
+    }
+    if ([value isKindOfClass:[NSData class]]) {
+        NSData *data = value;
+        return RLMCompressValue(static_cast<const char *>(data.bytes), data.length, algorithm) ?: value;
+    }
+    return value;
 }
 
 bool RLMStatelessAccessorContext::is_same_list(realm::List const& list,
@@ -1184,5 +1388,8 @@ bool RLMStatelessAccessorContext::is_same_dictionary(realm::object_store::Dictio
 + (void)promote:(RLMProperty *)property on:(RLMObjectBase *)parent {
     [self initialize:property on:parent];
 }
++ (BOOL)initializationDependsOnRow {
+    return YES;
+}
 @end
 #pragma clang diagnostic pop
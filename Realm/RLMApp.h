@@ -21,7 +21,7 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
-@protocol RLMNetworkTransport, RLMBSON;
+@protocol RLMNetworkTransport, RLMNetworkTransportMetricsDelegate, RLMBSON;
 
 @class RLMUser, RLMCredentials, RLMSyncManager, RLMEmailPasswordAuth, RLMPushClient;
 
@@ -43,6 +43,16 @@ typedef void(^RLMOptionalErrorBlock)(NSError * _Nullable);
 /// The custom transport for network calls to the server.
 @property (nonatomic, strong, nullable) id<RLMNetworkTransport> transport;
 
+/**
+ A delegate which is told the `NSURLSessionTaskMetrics` for each request the
+ app sends, such as the time spent on DNS lookup, TLS setup and waiting for the
+ server.
+
+ Metrics are only collected by the default transport. Custom transports can
+ measure their requests however suits them.
+ */
+@property (nonatomic, weak, nullable) id<RLMNetworkTransportMetricsDelegate> transportMetricsDelegate;
+
 /// A custom app name.
 @property (nonatomic, strong, nullable) NSString *localAppName;
 
@@ -52,6 +62,19 @@ typedef void(^RLMOptionalErrorBlock)(NSError * _Nullable);
 /// The default timeout for network requests.
 @property (nonatomic, assign) NSUInteger defaultRequestTimeoutMS;
 
+/**
+ Whether all sync sessions for the same user and server should share a single
+ connection.
+
+ By default each synchronized Realm opens its own connection to the server.
+ When this is enabled, sessions are multiplexed over one connection, so opening
+ many Realms with different partition values requires only one handshake and
+ keepalive timer, including after a reconnect. Defaults to `NO`.
+
+ This must be set before the app is created with this configuration.
+ */
+@property (nonatomic, assign) BOOL enableSessionMultiplexing;
+
 /**
 Create a new Realm App configuration.
 
@@ -82,6 +105,38 @@ Create a new Realm App configuration.
 
 @end
 
+#pragma mark RLMFunctionCacheStatistics
+
+/**
+ A snapshot of how the function calls made through an `RLMApp` have used its
+ function result cache.
+
+ Only calls to functions which have been registered with
+ `-[RLMApp cacheResultsOfFunctionNamed:timeToLive:]` are counted.
+ */
+@interface RLMFunctionCacheStatistics : NSObject
+
+/// The number of calls which were answered with a cached result.
+@property (nonatomic, readonly) NSUInteger hitCount;
+
+/// The number of calls which were sent to the server.
+@property (nonatomic, readonly) NSUInteger missCount;
+
+/// The number of calls which were not sent to the server because an identical
+/// call was already in flight, and which received its result instead.
+@property (nonatomic, readonly) NSUInteger coalescedCount;
+
+/// The number of results currently cached.
+@property (nonatomic, readonly) NSUInteger cachedResultCount;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMFunctionCacheStatistics cannot be created directly")));
+
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMFunctionCacheStatistics cannot be created directly")));
+
+@end
+
 #pragma mark RLMApp
 
 /**
@@ -154,6 +209,47 @@ Create a new Realm App configuration.
 - (RLMPushClient *)pushClientWithServiceName:(NSString *)serviceName
     NS_SWIFT_NAME(pushClient(serviceName:));
 
+/**
+ Caches the results of calls to the function with the given name.
+
+ Functions are called every time by default, as the app cannot know which
+ functions have side effects. Once a function has been registered with this
+ method, a call made while an identical call (the same user, function name and
+ arguments) is in flight waits for that call and receives its result, and a
+ successful result is reused for identical calls made within `timeToLive`
+ seconds. Failed calls are never cached.
+
+ Only register functions which do not modify any data, as cached calls are
+ never sent to the server.
+
+ @param name The name of the MongoDB Realm function whose results should be cached.
+ @param timeToLive How long a result can be reused for, in seconds. A value of 0
+                   only shares the results of calls which are in flight.
+ */
+- (void)cacheResultsOfFunctionNamed:(NSString *)name timeToLive:(NSTimeInterval)timeToLive
+    NS_SWIFT_NAME(cacheResults(ofFunctionNamed:timeToLive:));
+
+/**
+ Stops caching the results of calls to the function with the given name, and
+ discards its cached results.
+
+ @param name The name of a function previously passed to `-cacheResultsOfFunctionNamed:timeToLive:`.
+ */
+- (void)stopCachingResultsOfFunctionNamed:(NSString *)name
+    NS_SWIFT_NAME(stopCachingResults(ofFunctionNamed:));
+
+/**
+ Discards all cached function results. Calls which are in flight are unaffected.
+ */
+- (void)removeAllCachedFunctionResults;
+
+/**
+ A snapshot of the function result cache's statistics since the app was created.
+
+ @see `RLMFunctionCacheStatistics`
+ */
+@property (nonatomic, readonly) RLMFunctionCacheStatistics *functionCacheStatistics;
+
 /**
  RLMApp instances are cached internally by Realm and cannot be created directly.
 
@@ -27,8 +27,15 @@
 #import "RLMUtil.hpp"
 
 #import <realm/object-store/sync/sync_manager.hpp>
+#import <realm/object-store/sync/sync_user.hpp>
 #import <realm/sync/config.hpp>
 
+#import <atomic>
+#import <chrono>
+#import <mutex>
+#import <sstream>
+#import <unordered_map>
+
 #if !defined(REALM_COCOA_VERSION)
 #import "RLMVersion.h"
 #endif
@@ -37,17 +44,82 @@ using namespace realm;
 
 #pragma mark CocoaNetworkTransport
 namespace {
+    /// Refreshing an access token is a POST to `/auth/session` authenticated with
+    /// the refresh token. Core sends one for every request which fails because
+    /// the access token has expired, so when many requests are in flight at once
+    /// they would all refresh simultaneously. Instead, a refresh request which is
+    /// identical to one already in flight waits for it and shares its response.
+    class RefreshRequestCoalescer {
+    public:
+        using Completion = std::function<void(const app::Response)>;
+
+        static util::Optional<std::string> key_for(const app::Request& request) {
+            static const std::string suffix = "/auth/session";
+            auto& url = request.url;
+            if (request.method != app::HttpMethod::post || url.size() < suffix.size()
+                || url.compare(url.size() - suffix.size(), suffix.size(), suffix) != 0) {
+                return util::none;
+            }
+            auto auth = request.headers.find("Authorization");
+            if (auth == request.headers.end()) {
+                return util::none;
+            }
+            return url + '\n' + auth->second;
+        }
+
+        // Returns true if the caller should send the request, or false if an
+        // identical request is already in flight and `completion` will be
+        // called with its response.
+        bool add(const std::string& key, Completion completion) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto& waiters = m_pending[key];
+            waiters.push_back(std::move(completion));
+            return waiters.size() == 1;
+        }
+
+        void complete(const std::string& key, const app::Response& response) {
+            std::vector<Completion> waiters;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_pending.find(key);
+                waiters = std::move(it->second);
+                m_pending.erase(it);
+            }
+            for (auto& waiter : waiters) {
+                waiter(response);
+            }
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::unordered_map<std::string, std::vector<Completion>> m_pending;
+    };
+
     /// Internal transport struct to bridge RLMNetworkingTransporting to the GenericNetworkTransport.
     class CocoaNetworkTransport : public realm::app::GenericNetworkTransport {
     public:
-        CocoaNetworkTransport(id<RLMNetworkTransport> transport) : m_transport(transport) {};
+        CocoaNetworkTransport(id<RLMNetworkTransport> transport,
+                              std::shared_ptr<RefreshRequestCoalescer> coalescer = nullptr)
+        : m_transport(transport), m_coalescer(std::move(coalescer)) {};
 
         void send_request_to_server(const app::Request request,
                                     std::function<void(const app::Response)> completion) override {
+            // A new transport is created for each request, so the coalescer is
+            // shared between all of the transports created for an app
+            auto key = m_coalescer ? RefreshRequestCoalescer::key_for(request) : util::Optional<std::string>();
+            if (key) {
+                if (!m_coalescer->add(*key, std::move(completion))) {
+                    return;
+                }
+                completion = [coalescer = m_coalescer, key = *key](const app::Response response) {
+                    coalescer->complete(key, response);
+                };
+            }
+
             // Convert the app::Request to an RLMRequest
             auto rlmRequest = [RLMRequest new];
             rlmRequest.url = @(request.url.data());
-            rlmRequest.body = @(request.body.data());
+            rlmRequest.bodyData = [NSData dataWithBytes:request.body.data() length:request.body.size()];
             NSMutableDictionary *headers = [NSMutableDictionary new];
             for (auto header : request.headers) {
                 headers[@(header.first.data())] = @(header.second.data());
@@ -65,11 +137,12 @@ namespace {
 
                 // Convert the RLMResponse to an app:Response and pass downstream to
                 // the object store
+                NSData *body = response.bodyData;
                 completion(app::Response{
                     .http_status_code = static_cast<int>(response.httpStatusCode),
                     .custom_status_code = static_cast<int>(response.customStatusCode),
                     .headers = bridgingHeaders,
-                    .body = response.body ? response.body.UTF8String : ""
+                    .body = body ? std::string(static_cast<const char *>(body.bytes), body.length) : ""
                 });
             }];
         }
@@ -79,9 +152,158 @@ namespace {
         }
     private:
         id<RLMNetworkTransport> m_transport;
+        std::shared_ptr<RefreshRequestCoalescer> m_coalescer;
+    };
+}
+
+#pragma mark FunctionCache
+namespace {
+    /// The results of function calls which are in flight or have completed
+    /// recently, for the functions which the user has registered as cacheable.
+    class FunctionCache : public std::enable_shared_from_this<FunctionCache> {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Completion = std::function<void(util::Optional<app::AppError>, util::Optional<bson::Bson>)>;
+
+        struct Statistics {
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t coalesced = 0;
+            size_t cached = 0;
+        };
+
+        void set_time_to_live(const std::string& name, util::Optional<Clock::duration> ttl) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (ttl) {
+                m_time_to_live[name] = *ttl;
+            }
+            else {
+                m_time_to_live.erase(name);
+                remove_completed([&](auto& entry) { return entry.name == name; });
+            }
+        }
+
+        void remove_all() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            remove_completed([](auto&) { return true; });
+        }
+
+        Statistics statistics() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Statistics stats = m_stats;
+            auto now = Clock::now();
+            for (auto& [key, entry] : m_entries) {
+                stats.cached += entry.value && entry.expires > now;
+            }
+            return stats;
+        }
+
+        void call(app::App& app, const std::shared_ptr<SyncUser>& user, const std::string& name,
+                  bson::BsonArray&& args, Completion&& completion) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto ttl = m_time_to_live.find(name);
+            if (ttl == m_time_to_live.end()) {
+                lock.unlock();
+                return app.call_function(user, name, args, std::move(completion));
+            }
+
+            // The arguments' extended JSON is an exact key for them, and is what
+            // would be sent to the server anyway
+            std::stringstream key;
+            key << user->identity() << '\0' << name << '\0' << bson::Bson(args);
+            auto& entry = m_entries[key.str()];
+            if (entry.value && entry.expires > Clock::now()) {
+                ++m_stats.hits;
+                bson::Bson value = *entry.value;
+                lock.unlock();
+                // Keep the completion asynchronous, as it would be for a network request
+                Completion callback = std::move(completion);
+                dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                    callback(util::none, value);
+                });
+                return;
+            }
+
+            entry.waiters.push_back(std::move(completion));
+            if (entry.waiters.size() > 1) {
+                ++m_stats.coalesced;
+                return;
+            }
+            ++m_stats.misses;
+            entry.name = name;
+            entry.value = util::none;
+            lock.unlock();
+
+            app.call_function(user, name, args,
+                              [self = shared_from_this(), key = key.str(), ttl = ttl->second]
+                              (util::Optional<app::AppError> error, util::Optional<bson::Bson> response) {
+                self->complete(key, ttl, std::move(error), std::move(response));
+            });
+        }
+
+    private:
+        struct Entry {
+            std::string name;
+            util::Optional<bson::Bson> value;
+            Clock::time_point expires;
+            std::vector<Completion> waiters;
+        };
+
+        std::mutex m_mutex;
+        std::unordered_map<std::string, Clock::duration> m_time_to_live;
+        std::unordered_map<std::string, Entry> m_entries;
+        Statistics m_stats;
+
+        // Entries with waiters must be kept so that the waiters are called
+        template<typename Predicate>
+        void remove_completed(Predicate&& predicate) {
+            for (auto it = m_entries.begin(); it != m_entries.end();) {
+                if (it->second.waiters.empty() && predicate(it->second)) {
+                    it = m_entries.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+
+        void complete(const std::string& key, Clock::duration ttl,
+                      util::Optional<app::AppError> error, util::Optional<bson::Bson> response) {
+            std::vector<Completion> waiters;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_entries.find(key);
+                waiters = std::move(it->second.waiters);
+                if (!error && response && ttl > Clock::duration::zero()
+                    && m_time_to_live.count(it->second.name)) {
+                    it->second.value = response;
+                    it->second.expires = Clock::now() + ttl;
+                }
+                else {
+                    m_entries.erase(it);
+                }
+            }
+            for (auto& waiter : waiters) {
+                waiter(error, response);
+            }
+        }
     };
 }
 
+@implementation RLMFunctionCacheStatistics
+
+- (instancetype)initWithStatistics:(FunctionCache::Statistics const&)statistics {
+    if (self = [super init]) {
+        _hitCount = statistics.hits;
+        _missCount = statistics.misses;
+        _coalescedCount = statistics.coalesced;
+        _cachedResultCount = statistics.cached;
+    }
+    return self;
+}
+
+@end
+
 #pragma mark RLMAppConfiguration
 @implementation RLMAppConfiguration {
     realm::app::App::Config _config;
@@ -156,17 +378,29 @@ namespace {
 }
 
 - (void)setTransport:(id<RLMNetworkTransport>)transport {
+    auto coalescer = std::make_shared<RefreshRequestCoalescer>();
     if (transport) {
-        _config.transport_generator = [transport]{
-            return std::make_unique<CocoaNetworkTransport>(transport);
+        _config.transport_generator = [transport, coalescer]{
+            return std::make_unique<CocoaNetworkTransport>(transport, coalescer);
         };
     } else {
-        _config.transport_generator = []{
-            return std::make_unique<CocoaNetworkTransport>([RLMNetworkTransport new]);
+        __weak id<RLMNetworkTransportMetricsDelegate> metricsDelegate = _transportMetricsDelegate;
+        _config.transport_generator = [coalescer, metricsDelegate]{
+            RLMNetworkTransport *transport = [RLMNetworkTransport new];
+            transport.metricsDelegate = metricsDelegate;
+            return std::make_unique<CocoaNetworkTransport>(transport, coalescer);
         };
     }
 }
 
+- (void)setTransportMetricsDelegate:(id<RLMNetworkTransportMetricsDelegate>)transportMetricsDelegate {
+    _transportMetricsDelegate = transportMetricsDelegate;
+    // The delegate is captured when the default transport is installed
+    if (!_config.transport_generator || [self.transport isMemberOfClass:RLMNetworkTransport.class]) {
+        self.transport = nil;
+    }
+}
+
 - (NSString *)localAppName {
     if (_config.local_app_name) {
         return @((_config.base_url)->c_str());
@@ -239,6 +473,13 @@ NSError *RLMAppErrorToNSError(realm::app::AppError const& appError) {
 #pragma mark RLMApp
 @interface RLMApp() <ASAuthorizationControllerDelegate> {
     std::shared_ptr<realm::app::App> _app;
+    std::shared_ptr<FunctionCache> _functionCache;
+
+    // The decoded custom data of each user, along with the access token it was
+    // decoded from. Custom data is only ever updated along with the access
+    // token, so the cached dictionary is valid for as long as the token is.
+    std::mutex _customDataMutex;
+    std::unordered_map<std::string, std::pair<std::string, NSDictionary *>> _customData;
     __weak id<RLMASLoginDelegate> _authorizationDelegate API_AVAILABLE(ios(13.0), macos(10.15), tvos(13.0), watchos(6.0));
 }
 
@@ -251,6 +492,7 @@ NSError *RLMAppErrorToNSError(realm::app::AppError const& appError) {
         _configuration = [[RLMAppConfiguration alloc] initWithConfig:app->config()];
         _app = app;
         _syncManager = [[RLMSyncManager alloc] initWithSyncManager:_app->sync_manager()];
+        _functionCache = std::make_shared<FunctionCache>();
         return self;
     }
 
@@ -274,12 +516,14 @@ NSError *RLMAppErrorToNSError(realm::app::AppError const& appError) {
         _configuration = configuration;
         [_configuration setAppId:appId];
 
+        auto syncClientConfig = [RLMSyncManager configurationWithRootDirectory:rootDirectory appId:appId];
+        syncClientConfig.multiplex_sessions = configuration.enableSessionMultiplexing;
         _app = RLMTranslateError([&] {
-            return app::App::get_shared_app(configuration.config,
-                                            [RLMSyncManager configurationWithRootDirectory:rootDirectory appId:appId]);
+            return app::App::get_shared_app(configuration.config, syncClientConfig);
         });
 
         _syncManager = [[RLMSyncManager alloc] initWithSyncManager:_app->sync_manager()];
+        _functionCache = std::make_shared<FunctionCache>();
         return self;
     }
     return nil;
@@ -287,6 +531,13 @@ NSError *RLMAppErrorToNSError(realm::app::AppError const& appError) {
 
 static NSMutableDictionary *s_apps = [NSMutableDictionary new];
 static std::mutex& s_appMutex = *new std::mutex();
+// Apps are looked up far more often than they are created, so lookups first
+// check an immutable snapshot of `s_apps` without taking the lock. Snapshots
+// which have been replaced are kept alive in `s_appSnapshots` as a concurrent
+// lookup may still be reading them; apps are only ever removed by
+// +resetAppCache, which is used only by tests.
+static std::atomic<void *> s_appSnapshot{nullptr};
+static NSMutableArray *s_appSnapshots = [NSMutableArray new];
 
 + (NSArray *)appIds {
     std::lock_guard<std::mutex> lock(s_appMutex);
@@ -295,13 +546,21 @@ static std::mutex& s_appMutex = *new std::mutex();
 
 + (void)resetAppCache {
     std::lock_guard<std::mutex> lock(s_appMutex);
+    s_appSnapshot.store(nullptr, std::memory_order_release);
     [s_apps removeAllObjects];
+    [s_appSnapshots removeAllObjects];
     app::App::clear_cached_apps();
 }
 
 + (instancetype)appWithId:(NSString *)appId
             configuration:(RLMAppConfiguration *)configuration
             rootDirectory:(NSURL *)rootDirectory {
+    if (auto snapshot = (__bridge NSDictionary *)s_appSnapshot.load(std::memory_order_acquire)) {
+        if (RLMApp *app = snapshot[appId]) {
+            return app;
+        }
+    }
+
     std::lock_guard<std::mutex> lock(s_appMutex);
     if (RLMApp *app = s_apps[appId]) {
         return app;
@@ -309,6 +568,10 @@ static std::mutex& s_appMutex = *new std::mutex();
 
     RLMApp *app = [[RLMApp alloc] initWithId:appId configuration:configuration rootDirectory:rootDirectory];
     s_apps[appId] = app;
+
+    NSDictionary *snapshot = [s_apps copy];
+    [s_appSnapshots addObject:snapshot];
+    s_appSnapshot.store((__bridge void *)snapshot, std::memory_order_release);
     return app;
 }
 
@@ -333,6 +596,19 @@ static std::mutex& s_appMutex = *new std::mutex();
     return buffer;
 }
 
+- (NSDictionary *)customDataForUser:(realm::SyncUser&)user {
+    std::string accessToken = user.access_token();
+    std::lock_guard<std::mutex> lock(_customDataMutex);
+    auto& [token, customData] = _customData[user.identity()];
+    if (!customData || token != accessToken) {
+        auto document = user.custom_data();
+        // The dictionary is shared by every caller, so it must not be mutable
+        customData = document ? [(NSDictionary *)RLMConvertBsonToRLMBSON(*document) copy] : @{};
+        token = std::move(accessToken);
+    }
+    return customData;
+}
+
 - (RLMUser *)currentUser {
     if (auto user = _app->sync_manager()->get_current_user()) {
         return [[RLMUser alloc] initWithUser:user app:self];
@@ -364,6 +640,35 @@ static std::mutex& s_appMutex = *new std::mutex();
     });
 }
 
+#pragma mark - Function Result Cache
+
+- (void)cacheResultsOfFunctionNamed:(NSString *)name timeToLive:(NSTimeInterval)timeToLive {
+    if (timeToLive < 0) {
+        @throw RLMException(@"Function result time to live must not be negative, but was %f", timeToLive);
+    }
+    auto ttl = std::chrono::duration_cast<FunctionCache::Clock::duration>(std::chrono::duration<double>(timeToLive));
+    _functionCache->set_time_to_live(name.UTF8String, ttl);
+}
+
+- (void)stopCachingResultsOfFunctionNamed:(NSString *)name {
+    _functionCache->set_time_to_live(name.UTF8String, util::none);
+}
+
+- (void)removeAllCachedFunctionResults {
+    _functionCache->remove_all();
+}
+
+- (RLMFunctionCacheStatistics *)functionCacheStatistics {
+    return [[RLMFunctionCacheStatistics alloc] initWithStatistics:_functionCache->statistics()];
+}
+
+- (void)callFunctionNamed:(std::string const&)name
+                arguments:(bson::BsonArray)arguments
+                     user:(std::shared_ptr<SyncUser> const&)user
+               completion:(std::function<void(util::Optional<app::AppError>, util::Optional<bson::Bson>)>)completion {
+    _functionCache->call(*_app, user, name, std::move(arguments), std::move(completion));
+}
+
 - (RLMPushClient *)pushClientWithServiceName:(NSString *)serviceName {
     return RLMTranslateError([&] {
         return [[RLMPushClient alloc] initWithPushClient:_app->push_notification_client(serviceName.UTF8String)];
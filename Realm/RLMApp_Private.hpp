@@ -44,6 +44,18 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (instancetype)initWithApp:(std::shared_ptr<realm::app::App>)app;
 
+// Calls the function through the function result cache if the function has been
+// registered with it, and directly otherwise.
+- (void)callFunctionNamed:(std::string const&)name
+                arguments:(realm::bson::BsonArray)arguments
+                     user:(std::shared_ptr<realm::SyncUser> const&)user
+               completion:(std::function<void(realm::util::Optional<realm::app::AppError>,
+                                              realm::util::Optional<realm::bson::Bson>)>)completion;
+
+// Returns the user's custom data, decoding it only if it has changed since the
+// last call for the user.
+- (NSDictionary *)customDataForUser:(realm::SyncUser&)user;
+
 + (void)resetAppCache;
 @end
 
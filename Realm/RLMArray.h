@@ -139,6 +139,42 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (nullable RLMObjectType)lastObject;
 
+/**
+ Copies the values in the given range of the array into `buffer` without
+ creating an `NSNumber` for each value.
+
+ @warning This method may only be called on arrays of non-optional `RLMInt`
+          values.
+
+ @param buffer A buffer with space for at least `range.length` values.
+ @param range  The range of indexes in the array to copy.
+ */
+- (void)getInt64Values:(int64_t *)buffer range:(NSRange)range;
+
+/**
+ Copies the values in the given range of the array into `buffer` without
+ creating an `NSNumber` for each value.
+
+ @warning This method may only be called on arrays of non-optional `RLMDouble`
+          values.
+
+ @param buffer A buffer with space for at least `range.length` values.
+ @param range  The range of indexes in the array to copy.
+ */
+- (void)getDoubleValues:(double *)buffer range:(NSRange)range;
+
+/**
+ Copies the values in the given range of the array into `buffer` as the
+ number of nanoseconds since 1970 without creating an `NSDate` for each value.
+
+ @warning This method may only be called on arrays of non-optional `NSDate`
+          values.
+
+ @param buffer A buffer with space for at least `range.length` values.
+ @param range  The range of indexes in the array to copy.
+ */
+- (void)getTimestampValues:(int64_t *)buffer range:(NSRange)range;
+
 
 
 #pragma mark - Adding, Removing, and Replacing Objects in an Array
@@ -237,6 +273,23 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)exchangeObjectAtIndex:(NSUInteger)index1 withObjectAtIndex:(NSUInteger)index2;
 
+/**
+ Reorders the objects in the array so that the object which was at index
+ `permutation[i]` is at index `i`.
+
+ This has the same result as a series of `moveObjectAtIndex:toIndex:` calls,
+ but is performed as a single change to the array, so observers are notified
+ once.
+
+ Throws an exception if `permutation` does not contain each index of the array
+ exactly once.
+
+ @warning This method may only be called during a write transaction.
+
+ @param permutation The indexes of the objects in their new order.
+ */
+- (void)applyPermutation:(NSArray<NSNumber *> *)permutation;
+
 #pragma mark - Querying an Array
 
 /**
@@ -466,6 +519,39 @@ __attribute__((warn_unused_result));
                                          queue:(nullable dispatch_queue_t)queue
 __attribute__((warn_unused_result));
 
+/**
+ Registers a block to be called each time the array changes, delivering changes
+ no more often than once per `minimumInterval`.
+
+ This behaves like `-addNotificationBlock:keyPaths:queue:`, except that changes
+ which occur less than `minimumInterval` seconds after the previous call to the
+ block are merged together and delivered as a single `RLMCollectionChange`
+ once the interval has elapsed. The initial notification and errors are
+ always delivered immediately. This is useful for reducing the amount of work
+ performed when the array is changing very rapidly, such as while a large
+ number of objects are being downloaded by sync.
+
+ If `queue` is `nil`, delayed notifications are delivered via the current
+ thread's run loop.
+
+ @warning This method cannot be called when the containing Realm is read-only or frozen.
+ @warning The queue must be a serial queue.
+
+ @param block The block to be called whenever a change occurs.
+ @param keyPaths The block will be called for changes occuring on these keypaths. If no
+ key paths are given, notifications are delivered for every property key path.
+ @param queue The serial queue to deliver notifications to.
+ @param minimumInterval The minimum time in seconds between calls to the block.
+ @return A token which must be held for as long as you want updates to be delivered.
+ */
+- (RLMNotificationToken *)addNotificationBlock:(void (^)(RLMArray<RLMObjectType> *_Nullable array,
+                                                         RLMCollectionChange *_Nullable changes,
+                                                         NSError *_Nullable error))block
+                                      keyPaths:(nullable NSArray<NSString *> *)keyPaths
+                                         queue:(nullable dispatch_queue_t)queue
+                               minimumInterval:(NSTimeInterval)minimumInterval
+__attribute__((warn_unused_result));
+
 /**
  Registers a block to be called each time the array changes.
 
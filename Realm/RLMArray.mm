@@ -18,6 +18,7 @@
 
 #import "RLMArray_Private.hpp"
 
+#import "RLMCollection_Private.hpp"
 #import "RLMObjectSchema.h"
 #import "RLMObjectStore.h"
 #import "RLMObject_Private.h"
@@ -84,8 +85,18 @@
 #pragma mark - Convenience wrappers used for all RLMArray types
 
 - (void)addObjects:(id<NSFastEnumeration>)objects {
-    for (id obj in objects) {
-        [self addObject:obj];
+    // Add the objects as a single change so that they're validated before any
+    // are added and observers are notified once
+    NSArray *array = RLMDynamicCast<NSArray>(objects);
+    if (!array) {
+        NSMutableArray *copy = [NSMutableArray new];
+        for (id obj in objects) {
+            [copy addObject:obj];
+        }
+        array = copy;
+    }
+    if (array.count) {
+        [self addObjectsFromArray:array];
     }
 }
 
@@ -151,6 +162,35 @@
     return [_backingCollection objectAtIndex:index];
 }
 
+- (void)getInt64Values:(int64_t *)buffer range:(NSRange)range {
+    RLMArrayValidateBulkRead(self, RLMPropertyTypeInt, range);
+    for (NSUInteger i = 0; i < range.length; ++i) {
+        buffer[i] = [_backingCollection[range.location + i] longLongValue];
+    }
+}
+
+- (void)getDoubleValues:(double *)buffer range:(NSRange)range {
+    RLMArrayValidateBulkRead(self, RLMPropertyTypeDouble, range);
+    for (NSUInteger i = 0; i < range.length; ++i) {
+        buffer[i] = [_backingCollection[range.location + i] doubleValue];
+    }
+}
+
+- (void)getTimestampValues:(int64_t *)buffer range:(NSRange)range {
+    RLMArrayValidateBulkRead(self, RLMPropertyTypeDate, range);
+    for (NSUInteger i = 0; i < range.length; ++i) {
+        buffer[i] = RLMTimestampToNanoseconds(RLMTimestampForNSDate(_backingCollection[range.location + i]));
+    }
+}
+
+- (void)getMixedValues:(RLMMixedValue *)buffer range:(NSRange)range {
+    RLMArrayValidateBulkRead(self, RLMPropertyTypeAny, range);
+    // Unmanaged values are already objects, so there's nothing to unbox
+    for (NSUInteger i = 0; i < range.length; ++i) {
+        buffer[i] = RLMBoxedMixedValue();
+    }
+}
+
 - (NSUInteger)count {
     return _backingCollection.count;
 }
@@ -254,6 +294,21 @@ void RLMArrayValidateMatchingObjectType(__unsafe_unretained RLMArray *const arra
     }
 }
 
+void RLMArrayValidateBulkRead(__unsafe_unretained RLMArray *const array,
+                              RLMPropertyType type, NSRange range) {
+    if (array.type != type || array.optional) {
+        @throw RLMException(@"Cannot read %@ values from an array of type '%@%s'.",
+                            RLMTypeToString(type), array.objectClassName ?: RLMTypeToString(array.type),
+                            array.optional ? "?" : "");
+    }
+    NSUInteger count = array.count;
+    if (range.location > count || range.length > count - range.location) {
+        @throw RLMException(@"Range {%llu, %llu} is out of bounds (must be within %llu).",
+                            (unsigned long long)range.location, (unsigned long long)range.length,
+                            (unsigned long long)count);
+    }
+}
+
 static void validateArrayBounds(__unsafe_unretained RLMArray *const ar,
                                    NSUInteger index, bool allowOnePastEnd=false) {
     NSUInteger max = ar->_backingCollection.count + allowOnePastEnd;
@@ -338,6 +393,51 @@ static void validateArrayBounds(__unsafe_unretained RLMArray *const ar,
     });
 }
 
+- (void)applyPermutation:(NSArray<NSNumber *> *)permutation {
+    auto order = RLMArrayValidatePermutation(self, permutation);
+    size_t first = 0, end = order.size();
+    while (first < end && order[first] == first) {
+        ++first;
+    }
+    while (end > first && order[end - 1] == end - 1) {
+        --end;
+    }
+    if (first == end) {
+        return;
+    }
+
+    changeArray(self, NSKeyValueChangeReplacement, NSMakeRange(first, end - first), ^{
+        NSArray *original = [_backingCollection copy];
+        for (size_t i = first; i < end; ++i) {
+            _backingCollection[i] = original[order[i]];
+        }
+    });
+}
+
+std::vector<size_t> RLMArrayValidatePermutation(__unsafe_unretained RLMArray *const array,
+                                                __unsafe_unretained NSArray<NSNumber *> *const permutation) {
+    NSUInteger count = array.count;
+    std::vector<size_t> order;
+    order.reserve(count);
+    std::vector<bool> seen(count);
+    for (id value in permutation) {
+        NSNumber *number = RLMDynamicCast<NSNumber>(value);
+        NSUInteger index = number.unsignedIntegerValue;
+        if (!number || number.longLongValue < 0 || index >= count || seen[index]) {
+            @throw RLMException(@"Invalid permutation: it must contain each index less than %llu exactly once, "
+                                "but contained '%@'.",
+                                (unsigned long long)count, value);
+        }
+        seen[index] = true;
+        order.push_back(index);
+    }
+    if (order.size() != count) {
+        @throw RLMException(@"Invalid permutation: it contains %llu indexes, but the array has %llu objects.",
+                            (unsigned long long)order.size(), (unsigned long long)count);
+    }
+    return order;
+}
+
 - (NSUInteger)indexOfObject:(id)object {
     RLMArrayValidateMatchingObjectType(self, object);
     if (!_backingCollection) {
@@ -599,6 +699,13 @@ static void validateArrayBounds(__unsafe_unretained RLMArray *const ar,
     @throw RLMException(@"This method may only be called on RLMArray instances retrieved from an RLMRealm");
 }
 
+- (RLMNotificationToken *)addNotificationBlock:(void (^)(RLMArray *, RLMCollectionChange *, NSError *))block
+                                      keyPaths:(nullable NSArray<NSString *> *)keyPaths
+                                         queue:(nullable dispatch_queue_t)queue
+                               minimumInterval:(NSTimeInterval)minimumInterval {
+    @throw RLMException(@"This method may only be called on RLMArray instances retrieved from an RLMRealm");
+}
+
 - (RLMNotificationToken *)addNotificationBlock:(void (^)(RLMArray *, RLMCollectionChange *, NSError *))block
                                       keyPaths:(NSArray<NSString *> *)keyPaths {
     @throw RLMException(@"This method may only be called on RLMArray instances retrieved from an RLMRealm");
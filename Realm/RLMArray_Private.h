@@ -18,6 +18,7 @@
 
 #import <Realm/RLMArray.h>
 #import <Realm/RLMConstants.h>
+#import <Realm/RLMCollection_Private.h>
 
 @class RLMObjectBase, RLMProperty;
 
@@ -33,6 +34,9 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly) BOOL isLegacyProperty;
 // The name of the property which this collection represents
 @property (nonatomic, readonly) NSString *propertyKey;
+// Read the values in the given range of an array of mixed values into
+// `buffer`. See RLMMixedValue for the lifetime of the values read.
+- (void)getMixedValues:(RLMMixedValue *)buffer range:(NSRange)range;
 @end
 
 @interface RLMManagedArray : RLMArray
@@ -40,5 +44,6 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 void RLMArrayValidateMatchingObjectType(RLMArray *array, id value);
+void RLMArrayValidateBulkRead(RLMArray *array, RLMPropertyType type, NSRange range);
 
 NS_ASSUME_NONNULL_END
@@ -24,6 +24,8 @@
 
 #import <realm/table_ref.hpp>
 
+#import <vector>
+
 namespace realm {
     class Results;
 }
@@ -60,6 +62,10 @@ class RLMObservationInfo;
 
 void RLMValidateArrayObservationKey(NSString *keyPath, RLMArray *array);
 
+// Convert a permutation passed to -applyPermutation: to indexes, throwing if it
+// doesn't contain each index of the array exactly once
+std::vector<size_t> RLMArrayValidatePermutation(RLMArray *array, NSArray<NSNumber *> *permutation);
+
 // Initialize the observation info for an array if needed
 void RLMEnsureArrayObservationInfo(std::unique_ptr<RLMObservationInfo>& info,
                                    NSString *keyPath, RLMArray *array, id observed);
@@ -122,6 +122,7 @@ using namespace bson;
 
 - (BsonArray)bsonArrayValue {
     BsonArray bsonArray;
+    bsonArray.reserve(self.count);
     for (id value in self) {
         bsonArray.push_back(RLMConvertRLMBSONToBson(value));
     }
@@ -136,6 +137,15 @@ using namespace bson;
 
 #pragma mark NSDictionary
 
+// Enumerating keys and values together avoids a hash lookup per key
+static BsonDocument RLMConvertDictionaryToBsonDocument(NSDictionary *dictionary) {
+    __block BsonDocument bsonDocument;
+    [dictionary enumerateKeysAndObjectsUsingBlock:^(NSString *key, id<RLMBSON> value, BOOL *) {
+        bsonDocument[key.UTF8String] = RLMConvertRLMBSONToBson(value);
+    }];
+    return bsonDocument;
+}
+
 @implementation NSMutableDictionary (RLMBSON)
 
 - (RLMBSONType)bsonType {
@@ -143,11 +153,7 @@ using namespace bson;
 }
 
 - (BsonDocument)bsonDocumentValue {
-    BsonDocument bsonDocument;
-    for (NSString *value in self) {
-        bsonDocument[value.UTF8String] = RLMConvertRLMBSONToBson(self[value]);
-    }
-    return bsonDocument;
+    return RLMConvertDictionaryToBsonDocument(self);
 }
 
 - (instancetype)initWithBsonDocument:(BsonDocument)bsonDocument {
@@ -172,11 +178,7 @@ using namespace bson;
 }
 
 - (BsonDocument)bsonDocumentValue {
-    BsonDocument bsonDocument;
-    for (NSString *value in self) {
-        bsonDocument[value.UTF8String] = RLMConvertRLMBSONToBson(self[value]);
-    }
-    return bsonDocument;
+    return RLMConvertDictionaryToBsonDocument(self);
 }
 
 @end
@@ -329,9 +331,10 @@ Bson RLMConvertRLMBSONToBson(id<RLMBSON> b) {
             return (bool)((NSNumber *)b).boolValue;
         case RLMBSONTypeDouble:
             return ((NSNumber *)b).doubleValue;
-        case RLMBSONTypeBinary:
-            return std::vector<char>((char*)((NSData *)b).bytes,
-                                     ((char*)((NSData *)b).bytes) + (int)((NSData *)b).length);
+        case RLMBSONTypeBinary: {
+            auto bytes = static_cast<const char *>(((NSData *)b).bytes);
+            return std::vector<char>(bytes, bytes + ((NSData *)b).length);
+        }
         case RLMBSONTypeTimestamp:
             // This represents a value of `Timestamp` in a MongoDB Collection.
             return MongoTimestamp(((NSDate *)b).timeIntervalSince1970, 0);
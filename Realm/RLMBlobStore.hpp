@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2021 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#import <Foundation/Foundation.h>
+
+#import <string>
+
+namespace realm {
+class BinaryData;
+}
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Data properties listed in +[RLMObject externalBlobProperties] store their
+// values in files next to the Realm file rather than in the Realm file itself,
+// and the column holds a small fixed-size reference to the file. The files are
+// named by the SHA-256 of their contents, so storing the same value multiple
+// times only writes it once, and are never modified after being written.
+
+// The directory in which the blobs for the Realm file at the given path are stored
+NSString *RLMBlobDirectory(std::string const& realmPath);
+
+// Write the data to the blob store for the Realm file at the given path if it
+// isn't already present, and return the reference to store in the column
+NSData *RLMStoreBlob(std::string const& realmPath, NSData *data);
+
+// Get the file name of the blob for a reference read from a column, throwing
+// if the value is not a blob reference
+NSString *RLMBlobName(realm::BinaryData reference);
+
+// Get the path to the blob for a reference read from a column
+NSString *RLMBlobPath(std::string const& realmPath, realm::BinaryData reference);
+
+// Read the blob for a reference read from a column. The data is memory-mapped
+// from the blob's file rather than read into memory up front.
+NSData *RLMReadBlob(std::string const& realmPath, realm::BinaryData reference);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2021 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#import "RLMBlobStore.hpp"
+
+#import "RLMUtil.hpp"
+
+#import <CommonCrypto/CommonDigest.h>
+
+#import <realm/binary_data.hpp>
+
+namespace {
+// References are a fixed prefix followed by the SHA-256 of the blob's contents
+constexpr char s_referencePrefix[] = {'R', 'L', 'M', 'B', 'L', 'O', 'B', '1'};
+constexpr size_t s_referenceSize = sizeof(s_referencePrefix) + CC_SHA256_DIGEST_LENGTH;
+
+NSString *hexString(const unsigned char *bytes, size_t size) {
+    static const char digits[] = "0123456789abcdef";
+    std::string str(size * 2, '\0');
+    for (size_t i = 0; i < size; ++i) {
+        str[i * 2] = digits[bytes[i] >> 4];
+        str[i * 2 + 1] = digits[bytes[i] & 0xf];
+    }
+    return @(str.c_str());
+}
+} // anonymous namespace
+
+NSString *RLMBlobDirectory(std::string const& realmPath) {
+    return [@(realmPath.c_str()) stringByAppendingString:@".blobs"];
+}
+
+NSString *RLMBlobName(realm::BinaryData reference) {
+    if (reference.size() != s_referenceSize
+        || memcmp(reference.data(), s_referencePrefix, sizeof(s_referencePrefix)) != 0) {
+        @throw RLMException(@"Invalid external blob reference. The value may have been written "
+                            @"while the property was not listed in `externalBlobProperties`.");
+    }
+    auto digest = reinterpret_cast<const unsigned char *>(reference.data()) + sizeof(s_referencePrefix);
+    return hexString(digest, CC_SHA256_DIGEST_LENGTH);
+}
+
+NSString *RLMBlobPath(std::string const& realmPath, realm::BinaryData reference) {
+    return [RLMBlobDirectory(realmPath) stringByAppendingPathComponent:RLMBlobName(reference)];
+}
+
+NSData *RLMStoreBlob(std::string const& realmPath, NSData *data) {
+    char reference[s_referenceSize];
+    memcpy(reference, s_referencePrefix, sizeof(s_referencePrefix));
+
+    // CC_SHA256() takes a 32-bit length, so hash the data a range at a time
+    __block CC_SHA256_CTX ctx;
+    CC_SHA256_Init(&ctx);
+    [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange range, BOOL *) {
+        for (NSUInteger offset = 0; offset < range.length; ) {
+            CC_LONG length = static_cast<CC_LONG>(std::min<NSUInteger>(range.length - offset, UINT32_MAX));
+            CC_SHA256_Update(&ctx, static_cast<const char *>(bytes) + offset, length);
+            offset += length;
+        }
+    }];
+    CC_SHA256_Final(reinterpret_cast<unsigned char *>(reference + sizeof(s_referencePrefix)), &ctx);
+
+    NSData *referenceData = [NSData dataWithBytes:reference length:sizeof(reference)];
+    NSString *directory = RLMBlobDirectory(realmPath);
+    NSString *path = [directory stringByAppendingPathComponent:RLMBlobName({reference, sizeof(reference)})];
+    NSFileManager *manager = NSFileManager.defaultManager;
+    if ([manager fileExistsAtPath:path]) {
+        return referenceData;
+    }
+
+    // Blobs are written atomically so that a blob file which exists is always
+    // complete, even if two threads store the same value at once
+    NSError *error;
+    if (![manager createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:&error]
+        || ![data writeToFile:path options:NSDataWritingAtomic error:&error]) {
+        @throw RLMException(@"Failed to write external blob to '%@': %@", path, error.localizedDescription);
+    }
+    return referenceData;
+}
+
+NSData *RLMReadBlob(std::string const& realmPath, realm::BinaryData reference) {
+    NSString *path = RLMBlobPath(realmPath, reference);
+    NSError *error;
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:&error];
+    if (!data) {
+        @throw RLMException(@"Failed to read external blob at '%@': %@", path, error.localizedDescription);
+    }
+    return data;
+}
@@ -16,11 +16,14 @@
 //
 ////////////////////////////////////////////////////////////////////////////
 
-#import <Foundation/Foundation.h>
+#import <Realm/RLMConstants.h>
 
+#import <realm/keys.hpp>
 #import <realm/table_ref.hpp>
 #import <realm/util/optional.hpp>
 
+#import <algorithm>
+#import <memory>
 #import <unordered_map>
 #import <vector>
 
@@ -29,10 +32,15 @@ namespace realm {
     class Schema;
     struct Property;
     struct ColKey;
+    struct ObjKey;
     struct TableKey;
 }
 
+class RLMKeyPathCache;
+class RLMChangedPropertyMap;
+class RLMDescriptorCache;
 class RLMObservationInfo;
+class RLMQueryCache;
 @class RLMRealm, RLMSchema, RLMObjectSchema, RLMProperty;
 
 NS_ASSUME_NONNULL_BEGIN
@@ -51,6 +59,43 @@ template<> struct equal_to<NSString *> {
 };
 }
 
+// The observation info for each observed row of a single table. Only the head
+// of each row's linked list of observation infos is stored here. The infos are
+// kept in a vector so that iterating over all of them is fast, along with an
+// index from row key to position so that looking up a single row does not
+// require a scan over every observed object.
+class RLMObservedObjects {
+    using impl = std::vector<RLMObservationInfo *>;
+
+public:
+    using const_iterator = impl::const_iterator;
+    using const_reverse_iterator = impl::const_reverse_iterator;
+
+    const_iterator begin() const noexcept { return m_objects.begin(); }
+    const_iterator end() const noexcept { return m_objects.end(); }
+    const_reverse_iterator rbegin() const noexcept { return m_objects.rbegin(); }
+    const_reverse_iterator rend() const noexcept { return m_objects.rend(); }
+    bool empty() const noexcept { return m_objects.empty(); }
+    size_t size() const noexcept { return m_objects.size(); }
+    RLMObservationInfo *front() const noexcept { return m_objects.front(); }
+
+    // Get the head observation info for the given row, or nullptr if the
+    // row is not observed
+    RLMObservationInfo *_Nullable find(realm::ObjKey row) const noexcept;
+
+    // Add the head observation info for a row which was not previously observed
+    void insert(realm::ObjKey row, RLMObservationInfo *info);
+    // Replace the head observation info for a row, or remove the row entirely
+    // if `info` is nullptr
+    void replace(realm::ObjKey row, RLMObservationInfo *_Nullable info);
+
+    void clear() noexcept;
+
+private:
+    impl m_objects;
+    std::unordered_map<int64_t, size_t> m_index;
+};
+
 // The per-RLMRealm object schema information which stores the cached table
 // reference, handles table column lookups, and tracks observed objects
 class RLMClassInfo {
@@ -66,7 +111,22 @@ public:
 
     // Storage for the functionality in RLMObservation for handling indirect
     // changes to KVO-observed things
-    std::vector<RLMObservationInfo *> observedObjects;
+    RLMObservedObjects observedObjects;
+
+    // Recently built queries, used by RLMPredicateToQuery(). Created lazily.
+    std::shared_ptr<RLMQueryCache> queryCache;
+
+    // Previously resolved notification key paths, used by
+    // RLMKeyPathArrayFromStringArray(). Created lazily.
+    std::shared_ptr<RLMKeyPathCache> keyPathCache;
+
+    // Previously resolved sort and distinct key paths, used by
+    // RLMSortResults() and RLMDistinctResults(). Created lazily.
+    std::shared_ptr<RLMDescriptorCache> descriptorCache;
+
+    // The properties for each table column, used to report which properties
+    // changed in object notifications. Created lazily.
+    std::shared_ptr<RLMChangedPropertyMap> changedPropertyMap;
 
     // Get the table for this object type. Will return nullptr only if it's a
     // read-only Realm that is missing the table entirely.
@@ -107,7 +167,32 @@ public:
     // Returns true if this was a dynamically added type
     bool isDynamic() const noexcept;
 
+    // Returns true if the column stores references to external blobs rather
+    // than the data itself
+    std::vector<realm::ColKey> const& externalBlobColumns() const noexcept {
+        return m_externalBlobColumns;
+    }
+    bool isExternalBlob(realm::ColKey column) const noexcept {
+        return !m_externalBlobColumns.empty()
+            && std::find(m_externalBlobColumns.begin(), m_externalBlobColumns.end(), column) != m_externalBlobColumns.end();
+    }
+
+    // Returns the algorithm used to compress values in the column, or 0 if
+    // the column is not compressed
+    RLMCompressionAlgorithm compressionForColumn(realm::ColKey column) const noexcept {
+        for (auto& [key, algorithm] : m_compressedColumns) {
+            if (key == column) {
+                return algorithm;
+            }
+        }
+        return RLMCompressionAlgorithm(0);
+    }
+
 private:
+    std::vector<realm::ColKey> m_externalBlobColumns;
+    std::vector<std::pair<realm::ColKey, RLMCompressionAlgorithm>> m_compressedColumns;
+    void initStorageColumns();
+
     // If the ObjectSchema is not owned by the realm instance
     // we need to manually manage the ownership of the object.
     std::unique_ptr<realm::ObjectSchema> dynamicObjectSchema;
@@ -143,6 +228,20 @@ public:
 
 private:
     std::unordered_map<NSString *, RLMClassInfo> m_objects;
+
+    // Class name strings which are owned by the schema (the object schemas'
+    // class names, the target names of link properties and the names returned
+    // by +[RLMObject className]) are interned when the schema info is built,
+    // so that looking one of them up compares pointers rather than hashing
+    // and comparing the string. Other strings fall back to m_objects. The
+    // strings are retained so that their addresses can't be reused.
+    std::unordered_map<const void *, std::pair<NSString *, RLMClassInfo *>> m_byName;
+    // Keyed on the table key's value. Verified on lookup, as table keys can
+    // change for additive schema changes made by other processes.
+    std::unordered_map<uint32_t, RLMClassInfo *> m_byTableKey;
+
+    void intern(RLMClassInfo& info);
+    void internLinkTargets();
 };
 
 NS_ASSUME_NONNULL_END
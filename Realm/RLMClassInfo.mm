@@ -36,7 +36,9 @@ using namespace realm;
 RLMClassInfo::RLMClassInfo(__unsafe_unretained RLMRealm *const realm,
                            __unsafe_unretained RLMObjectSchema *const rlmObjectSchema,
                            const realm::ObjectSchema *objectSchema)
-: realm(realm), rlmObjectSchema(rlmObjectSchema), objectSchema(objectSchema) { }
+: realm(realm), rlmObjectSchema(rlmObjectSchema), objectSchema(objectSchema) {
+    initStorageColumns();
+}
 
 RLMClassInfo::RLMClassInfo(RLMRealm *realm, RLMObjectSchema *rlmObjectSchema,
                            std::unique_ptr<realm::ObjectSchema> schema)
@@ -45,7 +47,25 @@ RLMClassInfo::RLMClassInfo(RLMRealm *realm, RLMObjectSchema *rlmObjectSchema,
 , objectSchema(&*schema)
 , dynamicObjectSchema(std::move(schema))
 , dynamicRLMObjectSchema(rlmObjectSchema)
-{ }
+{
+    initStorageColumns();
+}
+
+void RLMClassInfo::initStorageColumns() {
+    for (RLMProperty *prop in rlmObjectSchema.properties) {
+        if (!prop.externalBlob && !prop.compression) {
+            continue;
+        }
+        if (auto property = objectSchema->property_for_name(prop.columnName.UTF8String)) {
+            if (prop.externalBlob) {
+                m_externalBlobColumns.push_back(property->column_key);
+            }
+            if (prop.compression) {
+                m_compressedColumns.emplace_back(property->column_key, prop.compression);
+            }
+        }
+    }
+}
 
 realm::TableRef RLMClassInfo::table() const {
     if (auto key = objectSchema->table_key) {
@@ -117,6 +137,10 @@ RLMSchemaInfo::impl::const_iterator RLMSchemaInfo::begin() const noexcept { retu
 RLMSchemaInfo::impl::const_iterator RLMSchemaInfo::end() const noexcept { return m_objects.end(); }
 
 RLMClassInfo& RLMSchemaInfo::operator[](NSString *name) {
+    auto interned = m_byName.find((__bridge const void *)name);
+    if (interned != m_byName.end()) {
+        return *interned->second.second;
+    }
     auto it = m_objects.find(name);
     if (it == m_objects.end()) {
         @throw RLMException(@"Object type '%@' is not managed by the Realm. "
@@ -128,6 +152,10 @@ RLMClassInfo& RLMSchemaInfo::operator[](NSString *name) {
 }
 
 RLMClassInfo* RLMSchemaInfo::operator[](realm::TableKey const& key) {
+    auto it = m_byTableKey.find(key.value);
+    if (it != m_byTableKey.end() && it->second->objectSchema->table_key == key) {
+        return it->second;
+    }
     for (auto& pair : m_objects) {
         if (pair.second.objectSchema->table_key == key)
             return &pair.second;
@@ -135,6 +163,42 @@ RLMClassInfo* RLMSchemaInfo::operator[](realm::TableKey const& key) {
     return nullptr;
 }
 
+void RLMSchemaInfo::intern(RLMClassInfo& info) {
+    RLMObjectSchema *objectSchema = info.rlmObjectSchema;
+    m_byName[(__bridge const void *)objectSchema.className] = {objectSchema.className, &info};
+    // +className is overridden to return a single string per class, but it's
+    // not the same instance as the schema's class name
+    NSString *registeredName = [objectSchema.objectClass className];
+    if ([registeredName isEqualToString:objectSchema.className]) {
+        m_byName[(__bridge const void *)registeredName] = {registeredName, &info};
+    }
+    if (auto key = info.objectSchema->table_key) {
+        // Several classes can share a table; keep the first as the linear
+        // search did
+        m_byTableKey.emplace(key.value, &info);
+    }
+}
+
+void RLMSchemaInfo::internLinkTargets() {
+    auto internTarget = [&](RLMProperty *prop) {
+        if (!prop.objectClassName) {
+            return;
+        }
+        auto it = m_objects.find(prop.objectClassName);
+        if (it != m_objects.end()) {
+            m_byName[(__bridge const void *)prop.objectClassName] = {prop.objectClassName, &it->second};
+        }
+    };
+    for (auto& pair : m_objects) {
+        for (RLMProperty *prop in pair.second.rlmObjectSchema.properties) {
+            internTarget(prop);
+        }
+        for (RLMProperty *prop in pair.second.rlmObjectSchema.computedProperties) {
+            internTarget(prop);
+        }
+    }
+}
+
 RLMSchemaInfo::RLMSchemaInfo(RLMRealm *realm) {
     RLMSchema *rlmSchema = realm.schema;
     realm::Schema const& schema = realm->_realm->schema();
@@ -147,11 +211,15 @@ RLMSchemaInfo::RLMSchemaInfo(RLMRealm *realm) {
         if (it == schema.end()) {
             continue;
         }
-        m_objects.emplace(std::piecewise_construct,
-                          std::forward_as_tuple(rlmObjectSchema.className),
-                          std::forward_as_tuple(realm, rlmObjectSchema,
-                                                &*it));
+        auto [info, inserted] = m_objects.emplace(std::piecewise_construct,
+                                                  std::forward_as_tuple(rlmObjectSchema.className),
+                                                  std::forward_as_tuple(realm, rlmObjectSchema,
+                                                                        &*it));
+        if (inserted) {
+            intern(info->second);
+        }
     }
+    internLinkTargets();
 }
 
 RLMSchemaInfo RLMSchemaInfo::clone(realm::Schema const& source_schema,
@@ -166,20 +234,27 @@ RLMSchemaInfo RLMSchemaInfo::clone(realm::Schema const& source_schema,
             continue;
         }
         size_t idx = class_info.objectSchema - &*source_schema.begin();
-        info.m_objects.emplace(std::piecewise_construct,
-                               std::forward_as_tuple(name),
-                               std::forward_as_tuple(target_realm, class_info.rlmObjectSchema,
-                                                     &*schema.begin() + idx));
+        auto [it, inserted] = info.m_objects.emplace(std::piecewise_construct,
+                                                     std::forward_as_tuple(name),
+                                                     std::forward_as_tuple(target_realm, class_info.rlmObjectSchema,
+                                                                           &*schema.begin() + idx));
+        if (inserted) {
+            info.intern(it->second);
+        }
     }
+    info.internLinkTargets();
     return info;
 }
 
 void RLMSchemaInfo::appendDynamicObjectSchema(std::unique_ptr<realm::ObjectSchema> schema,
                                               RLMObjectSchema *objectSchema,
                                               __unsafe_unretained RLMRealm *const target_realm) {
-    m_objects.emplace(std::piecewise_construct,
-                      std::forward_as_tuple(objectSchema.className),
-                      std::forward_as_tuple(target_realm, objectSchema,
-                                            std::move(schema)));
+    auto [it, inserted] = m_objects.emplace(std::piecewise_construct,
+                                            std::forward_as_tuple(objectSchema.className),
+                                            std::forward_as_tuple(target_realm, objectSchema,
+                                                                  std::move(schema)));
+    if (inserted) {
+        intern(it->second);
+    }
 }
 
@@ -435,6 +435,37 @@ typedef RLM_CLOSED_ENUM(int32_t, RLMPropertyType);
 
 /// Returns the index paths of the modification indices in the given section.
 - (NSArray<NSIndexPath *> *)modificationsInSection:(NSUInteger)section;
+
+/**
+ The indices of objects in the previous version of the collection which have
+ been removed from this one, as an index set.
+
+ Unlike `deletions`, this does not create an `NSNumber` for each index, and so
+ is much cheaper for very large changesets.
+ */
+@property (nonatomic, readonly) NSIndexSet *deletionIndexes;
+
+/// The indices in the new version of the collection which were newly
+/// inserted, as an index set.
+@property (nonatomic, readonly) NSIndexSet *insertionIndexes;
+
+/// The indices in the new version of the collection which were modified, as
+/// an index set. See `modifications` for what is considered a modification.
+@property (nonatomic, readonly) NSIndexSet *modificationIndexes;
+
+/**
+ Enumerates the ranges of contiguous deleted indices, in ascending order.
+
+ This reads the ranges directly from the changeset without creating any
+ intermediate objects. Set `*stop` to `YES` to stop the enumeration.
+ */
+- (void)enumerateDeletionRangesUsingBlock:(void (NS_NOESCAPE ^)(NSRange range, BOOL *stop))block;
+
+/// Enumerates the ranges of contiguous inserted indices, in ascending order.
+- (void)enumerateInsertionRangesUsingBlock:(void (NS_NOESCAPE ^)(NSRange range, BOOL *stop))block;
+
+/// Enumerates the ranges of contiguous modified indices, in ascending order.
+- (void)enumerateModificationRangesUsingBlock:(void (NS_NOESCAPE ^)(NSRange range, BOOL *stop))block;
 @end
 
 NS_ASSUME_NONNULL_END
@@ -26,26 +26,51 @@
 #import "RLMObject_Private.hpp"
 #import "RLMObservation.hpp"
 #import "RLMProperty_Private.h"
+#import "RLMResults_Private.hpp"
 #import "RLMSet_Private.hpp"
 #import "RLMSwiftCollectionBase.h"
+#import "RLMUtil.hpp"
 
 #import <realm/object-store/dictionary.hpp>
+#import <realm/object-store/impl/collection_change_builder.hpp>
 #import <realm/object-store/list.hpp>
 #import <realm/object-store/results.hpp>
 #import <realm/object-store/set.hpp>
+#import <realm/sort_descriptor.hpp>
 
-static const int RLMEnumerationBufferSize = 16;
+#import <atomic>
+#import <optional>
+#import <unordered_map>
+
+// The default minimum number of objects created per call to
+// countByEnumeratingWithState:. The buffer is owned by the enumerator rather
+// than the caller, so this can be larger than the compiler-provided buffer size.
+static const NSUInteger RLMDefaultEnumerationBufferSize = 64;
+static std::atomic<NSUInteger> s_enumerationBufferSize{RLMDefaultEnumerationBufferSize};
+
+NSUInteger RLMGetEnumerationBufferSize() {
+    return s_enumerationBufferSize.load(std::memory_order_relaxed);
+}
+
+void RLMSetEnumerationBufferSize(NSUInteger size) {
+    s_enumerationBufferSize.store(size ?: RLMDefaultEnumerationBufferSize, std::memory_order_relaxed);
+}
 
 @implementation RLMFastEnumerator {
     // The buffer supplied by fast enumeration does not retain the objects given
     // to it, but because we create objects on-demand and don't want them
     // autoreleased (a table can have more rows than the device has memory for
     // accessor objects) we need a thing to retain them.
-    id _strongBuffer[RLMEnumerationBufferSize];
+    std::vector<id> _strongBuffer;
 
     RLMRealm *_realm;
     RLMClassInfo *_info;
 
+    // The accessor context is reused for every batch rather than recreated
+    // each time so that the cached default values and class info lookups are
+    // shared across the entire enumeration
+    std::optional<RLMAccessorContext> _context;
+
     // A pointer to either _snapshot or a Results from the source collection,
     // to avoid having to copy the Results when not in a write transaction
     realm::Results *_results;
@@ -130,50 +155,89 @@ static const int RLMEnumerationBufferSize = 16;
     _collection = nil;
 }
 
-- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state
-                                    count:(NSUInteger)len {
+- (RLMAccessorContext&)context {
+    if (!_context) {
+        _context.emplace(*_info);
+    }
+    return *_context;
+}
+
+- (void)verifyValid {
     [_realm verifyThread];
     if (!_results->is_valid()) {
         @throw RLMException(@"Collection is no longer valid");
     }
-    // The fast enumeration buffer size is currently a hardcoded number in the
-    // compiler so this can't actually happen, but just in case it changes in
-    // the future...
-    if (len > RLMEnumerationBufferSize) {
-        len = RLMEnumerationBufferSize;
+}
+
+- (void)releaseCollection {
+    // Release our data if we're done, as we're autoreleased and so may
+    // stick around for a while
+    if (_collection) {
+        _collection = nil;
+        [_realm unregisterEnumerator:self];
+    }
+
+    _snapshot = {};
+    _context.reset();
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state
+                                    count:(NSUInteger)len {
+    [self verifyValid];
+    // We hand back a pointer to our own buffer rather than the one supplied by
+    // the caller, so we aren't limited to the caller's buffer size
+    len = std::max<NSUInteger>(len, RLMGetEnumerationBufferSize());
+    if (_strongBuffer.size() < len) {
+        _strongBuffer.resize(len);
     }
 
     NSUInteger batchCount = 0, count = state->extra[1];
 
     @autoreleasepool {
-        RLMAccessorContext ctx(*_info);
+        RLMAccessorContext& ctx = [self context];
         for (NSUInteger index = state->state; index < count && batchCount < len; ++index) {
             _strongBuffer[batchCount] = _results->get(ctx, index);
             batchCount++;
         }
     }
 
-    for (NSUInteger i = batchCount; i < len; ++i) {
+    for (NSUInteger i = batchCount; i < _strongBuffer.size(); ++i) {
         _strongBuffer[i] = nil;
     }
 
     if (batchCount == 0) {
-        // Release our data if we're done, as we're autoreleased and so may
-        // stick around for a while
-        if (_collection) {
-            _collection = nil;
-            [_realm unregisterEnumerator:self];
-        }
-
-        _snapshot = {};
+        [self releaseCollection];
     }
 
-    state->itemsPtr = (__unsafe_unretained id *)(void *)_strongBuffer;
+    state->itemsPtr = (__unsafe_unretained id *)(void *)_strongBuffer.data();
     state->state += batchCount;
     state->mutationsPtr = state->extra+1;
 
     return batchCount;
 }
+
+- (void)enumerateInChunksOfSize:(NSUInteger)chunkSize usingBlock:(void (^)(NSArray *, BOOL *))block {
+    if (chunkSize == 0) {
+        @throw RLMException(@"Chunk size must be greater than zero.");
+    }
+    [self verifyValid];
+
+    size_t count = _results->size();
+    BOOL stop = NO;
+    for (size_t start = 0; start < count && !stop; start += chunkSize) {
+        @autoreleasepool {
+            [self verifyValid];
+            size_t end = std::min<size_t>(start + chunkSize, count);
+            NSMutableArray *chunk = [[NSMutableArray alloc] initWithCapacity:end - start];
+            RLMAccessorContext& ctx = [self context];
+            for (size_t i = start; i < end; ++i) {
+                [chunk addObject:_results->get(ctx, i)];
+            }
+            block(chunk, &stop);
+        }
+    }
+    [self releaseCollection];
+}
 @end
 
 NSUInteger RLMFastEnumerate(NSFastEnumerationState *state,
@@ -192,6 +256,57 @@ NSUInteger RLMFastEnumerate(NSFastEnumerationState *state,
     return [enumerator countByEnumeratingWithState:state count:len];
 }
 
+// An array of the values of a collection property of a Swift class for each
+// object in a collection. Creating a Swift collection wrapper requires two
+// obj-c objects per row, so rather than creating them all up front the rows
+// are captured and each wrapper is created the first time it's read.
+@interface RLMSwiftCollectionValuesArray : NSArray
+@end
+
+@implementation RLMSwiftCollectionValuesArray {
+    RLMRealm *_realm;
+    RLMClassInfo *_info;
+    RLMProperty *_property;
+    Class _collectionClass;
+    std::vector<realm::Obj> _parents;
+    std::vector<id> _values;
+}
+
+- (instancetype)initWithParents:(std::vector<realm::Obj>&&)parents
+                       property:(RLMProperty *)property
+                collectionClass:(Class)cls
+                           info:(RLMClassInfo&)info {
+    if ((self = [super init])) {
+        _realm = info.realm;
+        _info = &info;
+        _property = property;
+        _collectionClass = cls;
+        _parents = std::move(parents);
+        _values.resize(_parents.size());
+    }
+    return self;
+}
+
+- (NSUInteger)count {
+    return _parents.size();
+}
+
+- (id)objectAtIndex:(NSUInteger)index {
+    if (index >= _parents.size()) {
+        @throw RLMException(@"Index %llu is out of bounds (must be less than %llu).",
+                            (unsigned long long)index, (unsigned long long)_parents.size());
+    }
+    if (!_values[index]) {
+        [_realm verifyThread];
+        RLMSwiftCollectionBase *base = [[_collectionClass alloc] init];
+        base._rlmCollection = [[[_collectionClass _backingCollectionType] alloc]
+                               initWithParent:_parents[index] property:_property parentInfo:*_info];
+        _values[index] = base;
+    }
+    return _values[index];
+}
+@end
+
 template<typename Collection>
 NSArray *RLMCollectionValueForKey(Collection& collection, NSString *key, RLMClassInfo& info) {
     size_t count = collection.size();
@@ -227,13 +342,15 @@ NSArray *RLMCollectionValueForKey(Collection& collection, NSString *key, RLMClas
             // so that we can make instances of the collection without creating a new
             // object accessor each time
             Class cls = [[prop.swiftAccessor get:prop on:accessor] class];
+            std::vector<realm::Obj> parents;
+            parents.reserve(count);
             for (size_t i = 0; i < count; ++i) {
-                RLMSwiftCollectionBase *base = [[cls alloc] init];
-                base._rlmCollection = [[[cls _backingCollectionType] alloc]
-                                       initWithParent:collection.get(i) property:prop parentInfo:info];
-                [array addObject:base];
+                parents.push_back(collection.get(i));
             }
-            return array;
+            return [[RLMSwiftCollectionValuesArray alloc] initWithParents:std::move(parents)
+                                                                 property:prop
+                                                          collectionClass:cls
+                                                                     info:info];
         }
     }
 
@@ -248,6 +365,96 @@ NSArray *RLMCollectionValueForKey(Collection& collection, NSString *key, RLMClas
     return array;
 }
 
+template<typename T, typename Getter>
+static NSData *packValues(size_t count, Getter&& get) {
+    NSMutableData *data = [NSMutableData dataWithLength:count * sizeof(T)];
+    T *values = static_cast<T *>(data.mutableBytes);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = get(i);
+    }
+    return data;
+}
+
+template<typename T>
+static double doubleOrNaN(realm::util::Optional<T> const& value) {
+    return value ? *value : std::numeric_limits<double>::quiet_NaN();
+}
+
+template<typename Collection>
+NSData *RLMCollectionPackedValuesForKey(Collection& collection, NSString *key, RLMClassInfo& info) {
+    realm::PropertyType type;
+    realm::ColKey col;
+    bool isSelf = collection.get_type() != realm::PropertyType::Object;
+    if (isSelf) {
+        if (![key isEqualToString:@"self"]) {
+            @throw RLMException(@"Collections of '%@' can only read packed values of \"self\"",
+                                RLMTypeToString(static_cast<RLMPropertyType>(collection.get_type() & ~realm::PropertyType::Nullable)));
+        }
+        type = collection.get_type();
+    }
+    else {
+        RLMProperty *prop = info.rlmObjectSchema[key];
+        if (!prop) {
+            @throw RLMException(@"Invalid property name '%@' for class '%@'.",
+                                key, info.rlmObjectSchema.className);
+        }
+        if (prop.collection) {
+            @throw RLMException(@"Cannot read packed values of collection property '%@'.", key);
+        }
+        col = info.tableColumn(prop);
+        type = info.objectSchema->persisted_properties[prop.index].type;
+    }
+
+    using realm::PropertyType;
+    using realm::util::Optional;
+    size_t count = collection.size();
+    bool nullable = is_nullable(type);
+    switch (type & ~PropertyType::Nullable) {
+        case PropertyType::Int:
+            if (nullable) {
+                @throw RLMException(@"Cannot read packed values of optional int property '%@'.", key);
+            }
+            if (isSelf) {
+                return packValues<int64_t>(count, [&](size_t i) { return collection.template get<int64_t>(i); });
+            }
+            return packValues<int64_t>(count, [&](size_t i) { return collection.get(i).template get<int64_t>(col); });
+        case PropertyType::Double:
+            if (isSelf) {
+                if (nullable) {
+                    return packValues<double>(count, [&](size_t i) { return doubleOrNaN(collection.template get<Optional<double>>(i)); });
+                }
+                return packValues<double>(count, [&](size_t i) { return collection.template get<double>(i); });
+            }
+            if (nullable) {
+                return packValues<double>(count, [&](size_t i) { return doubleOrNaN(collection.get(i).template get<Optional<double>>(col)); });
+            }
+            return packValues<double>(count, [&](size_t i) { return collection.get(i).template get<double>(col); });
+        case PropertyType::Float:
+            if (isSelf) {
+                if (nullable) {
+                    return packValues<double>(count, [&](size_t i) { return doubleOrNaN(collection.template get<Optional<float>>(i)); });
+                }
+                return packValues<double>(count, [&](size_t i) { return collection.template get<float>(i); });
+            }
+            if (nullable) {
+                return packValues<double>(count, [&](size_t i) { return doubleOrNaN(collection.get(i).template get<Optional<float>>(col)); });
+            }
+            return packValues<double>(count, [&](size_t i) { return collection.get(i).template get<float>(col); });
+        case PropertyType::Date:
+            if (isSelf) {
+                return packValues<int64_t>(count, [&](size_t i) { return RLMTimestampToNanoseconds(collection.template get<realm::Timestamp>(i)); });
+            }
+            return packValues<int64_t>(count, [&](size_t i) { return RLMTimestampToNanoseconds(collection.get(i).template get<realm::Timestamp>(col)); });
+        default:
+            @throw RLMException(@"Cannot read packed values of %s property '%@': only int, float, double and date properties are supported.",
+                                string_for_property_type(type), key);
+    }
+}
+
+template NSData *RLMCollectionPackedValuesForKey(realm::Results&, NSString *, RLMClassInfo&);
+template NSData *RLMCollectionPackedValuesForKey(realm::List&, NSString *, RLMClassInfo&);
+template NSData *RLMCollectionPackedValuesForKey(realm::object_store::Set&, NSString *, RLMClassInfo&);
+
 realm::ColKey columnForProperty(NSString *propertyName,
                                 realm::object_store::Collection const& backingCollection,
                                 RLMClassInfo *objectInfo,
@@ -279,6 +486,64 @@ template NSArray *RLMCollectionValueForKey(realm::Results&, NSString *, RLMClass
 template NSArray *RLMCollectionValueForKey(realm::List&, NSString *, RLMClassInfo&);
 template NSArray *RLMCollectionValueForKey(realm::object_store::Set&, NSString *, RLMClassInfo&);
 
+RLMMixedValue RLMMixedValueFromMixed(realm::Mixed const& value) {
+    RLMMixedValue ret{};
+    if (value.is_null()) {
+        ret.type = RLMPropertyTypeAny;
+        ret.isNull = true;
+        return ret;
+    }
+    switch (value.get_type()) {
+        case realm::type_Int:
+            ret.type = RLMPropertyTypeInt;
+            ret.intValue = value.get_int();
+            break;
+        case realm::type_Bool:
+            ret.type = RLMPropertyTypeBool;
+            ret.intValue = value.get_bool();
+            break;
+        case realm::type_Float:
+            ret.type = RLMPropertyTypeFloat;
+            ret.doubleValue = value.get_float();
+            break;
+        case realm::type_Double:
+            ret.type = RLMPropertyTypeDouble;
+            ret.doubleValue = value.get_double();
+            break;
+        case realm::type_Timestamp: {
+            // Matches the conversion done by RLMTimestampToNSDate()
+            auto ts = value.get_timestamp();
+            ret.type = RLMPropertyTypeDate;
+            ret.doubleValue = ts.get_seconds() - NSTimeIntervalSince1970 + ts.get_nanoseconds() / 1'000'000'000.0;
+            break;
+        }
+        case realm::type_String: {
+            auto str = value.get_string();
+            ret.type = RLMPropertyTypeString;
+            ret.bytes = str.data();
+            ret.size = str.size();
+            break;
+        }
+        case realm::type_Binary: {
+            auto data = value.get_binary();
+            ret.type = RLMPropertyTypeData;
+            ret.bytes = data.data();
+            ret.size = data.size();
+            break;
+        }
+        default:
+            return RLMBoxedMixedValue();
+    }
+    return ret;
+}
+
+RLMMixedValue RLMBoxedMixedValue() {
+    RLMMixedValue ret{};
+    ret.type = RLMPropertyTypeAny;
+    ret.boxed = true;
+    return ret;
+}
+
 void RLMCollectionSetValueForKey(id<RLMFastEnumerable> collection, NSString *key, id value) {
     realm::TableView tv = [collection tableView];
     if (tv.size() == 0) {
@@ -298,46 +563,293 @@ void RLMAssignToCollection(id<RLMCollection> collection, id value) {
     [(id)collection replaceAllObjectsWithObjects:value];
 }
 
-NSString *RLMDescriptionWithMaxDepth(NSString *name,
-                                     id<RLMCollection> collection,
-                                     NSUInteger depth) {
-    if (depth == 0) {
-        return @"<Maximum depth exceeded>";
+namespace {
+// Writes the description of an object graph into a single buffer, indenting
+// nested values as they are written rather than re-indenting each child's
+// description afterwards. Once the configured output length or element count
+// is reached, the remaining elements of each collection are reported as
+// skipped rather than described.
+//
+// Objects which implement descriptionWithMaxDepth: themselves (such as the Swift
+// collection wrappers) call back into RLMDescriptionWithMaxDepth(), so the
+// writer which is active on the current thread lends its remaining budget to
+// any writer created while it is running.
+class DescriptionWriter {
+public:
+    DescriptionWriter(RLMDescriptionOptions const& options)
+    : _parent(s_activeWriter), _options(options), _buffer([NSMutableString new])
+    {
+        if (_parent) {
+            _options.summarizeCollections = _parent->_options.summarizeCollections;
+            _options.maxLength = _parent->remainingLength();
+            _options.maxElements = _parent->remainingElements();
+        }
+        s_activeWriter = this;
+    }
+
+    ~DescriptionWriter() {
+        if (_parent) {
+            _parent->_elements += _elements;
+        }
+        s_activeWriter = _parent;
+    }
+
+    NSString *result() const {
+        return _buffer;
     }
 
-    const NSUInteger maxObjects = 100;
-    auto str = [NSMutableString stringWithFormat:@"%@<%@> <%p> (\n", name,
-                [collection objectClassName] ?: RLMTypeToString([collection type]),
-                (void *)collection];
-    size_t index = 0, skipped = 0;
-    for (id obj in collection) {
-        NSString *sub;
-        if ([obj respondsToSelector:@selector(descriptionWithMaxDepth:)]) {
-            sub = [obj descriptionWithMaxDepth:depth - 1];
+    void write(__unsafe_unretained id const value, NSUInteger depth) {
+        ++_elements;
+        if (auto object = RLMDynamicCast<RLMObjectBase>(value)) {
+            writeObject(object, depth);
+        }
+        else if (auto dictionary = RLMDynamicCast<RLMDictionary>(value)) {
+            writeDictionary(@"RLMDictionary", dictionary, depth);
+        }
+        else if (auto array = RLMDynamicCast<RLMArray>(value)) {
+            writeCollection(@"RLMArray", array, depth);
+        }
+        else if (auto set = RLMDynamicCast<RLMSet>(value)) {
+            writeCollection(@"RLMSet", set, depth);
+        }
+        else if (auto linkingObjects = RLMDynamicCast<RLMLinkingObjects>(value)) {
+            writeCollection(@"RLMLinkingObjects", linkingObjects, depth);
+        }
+        else if (auto results = RLMDynamicCast<RLMResults>(value)) {
+            writeCollection(@"RLMResults", results, depth);
+        }
+        else if ([value respondsToSelector:@selector(descriptionWithMaxDepth:)]) {
+            append([value descriptionWithMaxDepth:depth]);
         }
         else {
-            sub = [obj description];
+            append([value description] ?: @"(null)");
         }
+    }
 
-        // Indent child objects
-        NSString *objDescription = [sub stringByReplacingOccurrencesOfString:@"\n"
-                                                                  withString:@"\n\t"];
-        [str appendFormat:@"\t[%zu] %@,\n", index++, objDescription];
-        if (index >= maxObjects) {
-            skipped = collection.count - maxObjects;
-            break;
+    void writeObject(RLMObjectBase *object, NSUInteger depth) {
+        if (depth == 0) {
+            [_buffer appendString:@"<Maximum depth exceeded>"];
+            return;
         }
+
+        RLMObjectSchema *objectSchema = object->_objectSchema;
+        [_buffer appendFormat:@"%@ {", objectSchema.className];
+        ++_indent;
+        NSArray<RLMProperty *> *properties = objectSchema.properties;
+        NSUInteger index = 0;
+        for (RLMProperty *property in properties) {
+            if (exhausted()) {
+                break;
+            }
+            newline();
+            [_buffer appendFormat:@"%@ = ", property.name];
+            id value = [(id)object objectForKeyedSubscript:property.name];
+            if (property.type == RLMPropertyTypeData && [value isKindOfClass:[NSData class]]) {
+                ++_elements;
+                writeData(value);
+            }
+            else {
+                write(value, depth - 1);
+            }
+            [_buffer appendString:@";"];
+            ++index;
+        }
+        if (index < properties.count) {
+            newline();
+            [_buffer appendFormat:@"... %lu properties skipped.", (unsigned long)(properties.count - index)];
+        }
+        --_indent;
+        newline();
+        [_buffer appendString:@"}"];
+    }
+
+    void writeCollection(NSString *name, id<RLMCollection> collection, NSUInteger depth) {
+        if (depth == 0) {
+            [_buffer appendString:@"<Maximum depth exceeded>"];
+            return;
+        }
+
+        [_buffer appendFormat:@"%@<%@> <%p> (", name,
+         [collection objectClassName] ?: RLMTypeToString([collection type]),
+         (void *)collection];
+        NSUInteger count = collection.count;
+        if (_options.summarizeCollections) {
+            [_buffer appendFormat:@"%lu objects)", (unsigned long)count];
+            return;
+        }
+
+        ++_indent;
+        NSUInteger index = 0;
+        for (id obj in collection) {
+            if (index >= maxObjectsPerCollection || exhausted()) {
+                break;
+            }
+            if (index) {
+                [_buffer appendString:@","];
+            }
+            newline();
+            [_buffer appendFormat:@"[%lu] ", (unsigned long)index++];
+            write(obj, depth - 1);
+        }
+        writeSkipped(count, index);
+        --_indent;
+        closeCollection(count);
+    }
+
+    void writeDictionary(NSString *name, RLMDictionary *dictionary, NSUInteger depth) {
+        if (depth == 0) {
+            [_buffer appendString:@"<Maximum depth exceeded>"];
+            return;
+        }
+
+        [_buffer appendFormat:@"%@<%@, %@> <%p> (", name,
+         RLMTypeToString([dictionary keyType]),
+         [dictionary objectClassName] ?: RLMTypeToString([dictionary type]),
+         (void *)dictionary];
+        NSUInteger count = dictionary.count;
+        if (_options.summarizeCollections) {
+            [_buffer appendFormat:@"%lu objects)", (unsigned long)count];
+            return;
+        }
+
+        NSUInteger index = 0;
+        for (id key in dictionary) {
+            if (index >= maxObjectsPerCollection || exhausted()) {
+                break;
+            }
+            if (index++) {
+                [_buffer appendString:@","];
+            }
+            // Entries are written at the dictionary's own indentation, with
+            // their contents indented one level further
+            newline();
+            ++_indent;
+            [_buffer appendString:@"["];
+            write(key, depth - 1);
+            [_buffer appendString:@"]: "];
+            write(dictionary[key], depth - 1);
+            --_indent;
+        }
+        ++_indent;
+        writeSkipped(count, index);
+        --_indent;
+        closeCollection(count);
     }
 
-    // Remove last comma and newline characters
-    if (collection.count > 0) {
-        [str deleteCharactersInRange:NSMakeRange(str.length-2, 2)];
+private:
+    static constexpr NSUInteger maxObjectsPerCollection = 100;
+    static constexpr NSUInteger maxPrintedDataLength = 24;
+    static thread_local DescriptionWriter *s_activeWriter;
+
+    DescriptionWriter *_parent;
+    RLMDescriptionOptions _options;
+    NSMutableString *_buffer;
+    NSUInteger _indent = 0;
+    NSUInteger _elements = 0;
+
+    NSUInteger remainingLength() const {
+        return _options.maxLength > _buffer.length ? _options.maxLength - _buffer.length : 0;
+    }
+
+    NSUInteger remainingElements() const {
+        return _options.maxElements > _elements ? _options.maxElements - _elements : 0;
     }
-    if (skipped) {
-        [str appendFormat:@"\n\t... %zu objects skipped.", skipped];
+
+    bool exhausted() const {
+        return remainingLength() == 0 || remainingElements() == 0;
     }
-    [str appendFormat:@"\n)"];
-    return str;
+
+    void newline() {
+        [_buffer appendString:@"\n"];
+        for (NSUInteger i = 0; i < _indent; ++i) {
+            [_buffer appendString:@"\t"];
+        }
+    }
+
+    // Append a leaf value's description, indenting any lines after the first
+    // to the current level and cutting it short if it would exceed the
+    // remaining length
+    void append(NSString *str) {
+        NSUInteger length = str.length;
+        bool truncated = false;
+        if (NSUInteger remaining = remainingLength(); length > remaining) {
+            length = [str rangeOfComposedCharacterSequenceAtIndex:remaining].location;
+            truncated = true;
+        }
+
+        NSUInteger start = 0;
+        while (start < length) {
+            NSRange nl = [str rangeOfString:@"\n" options:NSLiteralSearch
+                                      range:NSMakeRange(start, length - start)];
+            if (nl.location == NSNotFound) {
+                break;
+            }
+            [_buffer appendString:[str substringWithRange:NSMakeRange(start, nl.location - start)]];
+            newline();
+            start = NSMaxRange(nl);
+        }
+        if (start == 0 && length == str.length) {
+            [_buffer appendString:str];
+        }
+        else if (start < length) {
+            [_buffer appendString:[str substringWithRange:NSMakeRange(start, length - start)]];
+        }
+        if (truncated) {
+            [_buffer appendFormat:@"… — %lu total characters", (unsigned long)str.length];
+        }
+    }
+
+    void writeData(NSData *data) {
+        NSUInteger length = data.length;
+        if (length > maxPrintedDataLength) {
+            data = [NSData dataWithBytesNoCopy:(void *)data.bytes length:maxPrintedDataLength freeWhenDone:NO];
+        }
+        NSString *dataDescription = [data description];
+        [_buffer appendFormat:@"<%@ — %lu total bytes>",
+         [dataDescription substringWithRange:NSMakeRange(1, dataDescription.length - 2)],
+         (unsigned long)length];
+    }
+
+    void writeSkipped(NSUInteger count, NSUInteger written) {
+        if (written < count) {
+            newline();
+            [_buffer appendFormat:@"... %lu objects skipped.", (unsigned long)(count - written)];
+        }
+    }
+
+    void closeCollection(NSUInteger count) {
+        // Empty collections have historically been described with a blank line
+        if (count == 0) {
+            newline();
+        }
+        newline();
+        [_buffer appendString:@")"];
+    }
+};
+
+thread_local DescriptionWriter *DescriptionWriter::s_activeWriter = nullptr;
+} // anonymous namespace
+
+NSString *RLMDescriptionWithOptions(id value, RLMDescriptionOptions options) {
+    DescriptionWriter writer(options);
+    writer.write(value, options.maxDepth);
+    return writer.result();
+}
+
+NSString *RLMDescriptionWithMaxDepth(NSString *name,
+                                     id<RLMCollection> collection,
+                                     NSUInteger depth) {
+    DescriptionWriter writer(RLMDefaultDescriptionOptions);
+    writer.writeCollection(name, collection, depth);
+    return writer.result();
+}
+
+NSString *RLMDictionaryDescriptionWithMaxDepth(NSString *name,
+                                               RLMDictionary *dictionary,
+                                               NSUInteger depth) {
+    DescriptionWriter writer(RLMDefaultDescriptionOptions);
+    writer.writeDictionary(name, dictionary, depth);
+    return writer.result();
 }
 
 std::vector<std::pair<std::string, bool>> RLMSortDescriptorsToKeypathArray(NSArray<RLMSortDescriptor *> *properties) {
@@ -352,8 +864,119 @@ std::vector<std::pair<std::string, bool>> RLMSortDescriptorsToKeypathArray(NSArr
     return keypaths;
 }
 
+class RLMDescriptorCache {
+public:
+    static constexpr size_t maxSize = 64;
+    std::unordered_map<std::string, realm::SortDescriptor> sorts;
+    std::unordered_map<std::string, realm::DistinctDescriptor> distincts;
+};
+
+namespace {
+// Resolved descriptors can only be reused for results of objects of the
+// cached type; the key paths of primitive collections are resolved
+// differently and are cheap anyway
+bool canCacheDescriptors(realm::Results const& results, RLMClassInfo *info) {
+    return info && results.get_type() == realm::PropertyType::Object
+        && results.get_object_type() == info->objectSchema->name;
+}
+
+RLMDescriptorCache& descriptorCache(RLMClassInfo *info) {
+    if (!info->descriptorCache) {
+        info->descriptorCache = std::make_shared<RLMDescriptorCache>();
+    }
+    return *info->descriptorCache;
+}
+
+template<typename Descriptor>
+Descriptor const& lastDescriptor(realm::Results const& results) {
+    auto& ordering = results.get_descriptor_ordering();
+    return static_cast<Descriptor const&>(*ordering[ordering.size() - 1]);
+}
+
+template<typename Map, typename Descriptor>
+void cacheDescriptor(Map& cache, std::string&& key, Descriptor const& descriptor) {
+    if (cache.size() >= RLMDescriptorCache::maxSize) {
+        cache.clear();
+    }
+    cache.emplace(std::move(key), descriptor);
+}
+} // anonymous namespace
+
+realm::Results RLMSortResults(realm::Results const& results, RLMClassInfo *info,
+                              NSArray<RLMSortDescriptor *> *properties) {
+    auto keyPaths = RLMSortDescriptorsToKeypathArray(properties);
+    // Sorting on no key paths doesn't add a descriptor, so there'd be nothing
+    // to read back and cache
+    if (keyPaths.empty()) {
+        return results;
+    }
+    if (!canCacheDescriptors(results, info)) {
+        return results.sort(keyPaths);
+    }
+
+    std::string key;
+    for (auto& [keyPath, ascending] : keyPaths) {
+        key += ascending ? '+' : '-';
+        key += keyPath;
+        key += '\0';
+    }
+    auto& cache = descriptorCache(info).sorts;
+    if (auto it = cache.find(key); it != cache.end()) {
+        return results.sort(realm::SortDescriptor(it->second));
+    }
+
+    // A sort applied on top of an existing sort is merged into it, so the
+    // resolved descriptor can only be read back when there wasn't one
+    bool unordered = results.get_descriptor_ordering().is_empty();
+    auto sorted = results.sort(keyPaths);
+    if (unordered && sorted.get_descriptor_ordering().size() == 1) {
+        cacheDescriptor(cache, std::move(key), lastDescriptor<realm::SortDescriptor>(sorted));
+    }
+    return sorted;
+}
+
+realm::Results RLMDistinctResults(realm::Results const& results, RLMClassInfo *info,
+                                  NSArray<NSString *> *keyPaths) {
+    std::vector<std::string> keyPathsVector;
+    keyPathsVector.reserve(keyPaths.count);
+    for (NSString *keyPath in keyPaths) {
+        keyPathsVector.push_back(keyPath.UTF8String);
+    }
+    if (keyPathsVector.empty()) {
+        return results;
+    }
+    if (!canCacheDescriptors(results, info)) {
+        return results.distinct(keyPathsVector);
+    }
+
+    std::string key;
+    for (auto& keyPath : keyPathsVector) {
+        key += keyPath;
+        key += '\0';
+    }
+    auto& cache = descriptorCache(info).distincts;
+    if (auto it = cache.find(key); it != cache.end()) {
+        return results.distinct(realm::DistinctDescriptor(it->second));
+    }
+
+    size_t previousSize = results.get_descriptor_ordering().size();
+    auto distinct = results.distinct(keyPathsVector);
+    if (distinct.get_descriptor_ordering().size() > previousSize) {
+        cacheDescriptor(cache, std::move(key), lastDescriptor<realm::DistinctDescriptor>(distinct));
+    }
+    return distinct;
+}
+
 @implementation RLMCollectionChange {
     realm::CollectionChangeSet _indices;
+    // Converting large changesets is expensive, so each conversion is only
+    // performed once
+    NSArray *_deletions;
+    NSArray *_insertions;
+    NSArray *_modifications;
+    NSIndexSet *_deletionIndexes;
+    NSIndexSet *_insertionIndexes;
+    NSIndexSet *_modificationIndexes;
 }
 
 - (instancetype)initWithChanges:(realm::CollectionChangeSet)indices {
@@ -365,27 +988,69 @@ std::vector<std::pair<std::string, bool>> RLMSortDescriptorsToKeypathArray(NSArr
 }
 
 static NSArray *toArray(realm::IndexSet const& set) {
-    NSMutableArray *ret = [NSMutableArray new];
+    NSMutableArray *ret = [NSMutableArray arrayWithCapacity:set.count()];
     for (auto index : set.as_indexes()) {
         [ret addObject:@(index)];
     }
     return ret;
 }
 
+static NSIndexSet *toIndexSet(realm::IndexSet const& set) {
+    NSMutableIndexSet *ret = [NSMutableIndexSet new];
+    for (auto range : set) {
+        [ret addIndexesInRange:NSMakeRange(range.first, range.second - range.first)];
+    }
+    return ret;
+}
+
+static void enumerateRanges(realm::IndexSet const& set, void (NS_NOESCAPE ^block)(NSRange, BOOL *)) {
+    BOOL stop = NO;
+    for (auto range : set) {
+        block(NSMakeRange(range.first, range.second - range.first), &stop);
+        if (stop) {
+            break;
+        }
+    }
+}
+
 - (NSArray *)insertions {
-    return toArray(_indices.insertions);
+    return _insertions ?: (_insertions = toArray(_indices.insertions));
 }
 
 - (NSArray *)deletions {
-    return toArray(_indices.deletions);
+    return _deletions ?: (_deletions = toArray(_indices.deletions));
 }
 
 - (NSArray *)modifications {
-    return toArray(_indices.modifications);
+    return _modifications ?: (_modifications = toArray(_indices.modifications));
+}
+
+- (NSIndexSet *)insertionIndexes {
+    return _insertionIndexes ?: (_insertionIndexes = toIndexSet(_indices.insertions));
+}
+
+- (NSIndexSet *)deletionIndexes {
+    return _deletionIndexes ?: (_deletionIndexes = toIndexSet(_indices.deletions));
+}
+
+- (NSIndexSet *)modificationIndexes {
+    return _modificationIndexes ?: (_modificationIndexes = toIndexSet(_indices.modifications));
+}
+
+- (void)enumerateInsertionRangesUsingBlock:(void (NS_NOESCAPE ^)(NSRange, BOOL *))block {
+    enumerateRanges(_indices.insertions, block);
+}
+
+- (void)enumerateDeletionRangesUsingBlock:(void (NS_NOESCAPE ^)(NSRange, BOOL *))block {
+    enumerateRanges(_indices.deletions, block);
+}
+
+- (void)enumerateModificationRangesUsingBlock:(void (NS_NOESCAPE ^)(NSRange, BOOL *))block {
+    enumerateRanges(_indices.modifications, block);
 }
 
 static NSArray *toIndexPathArray(realm::IndexSet const& set, NSUInteger section) {
-    NSMutableArray *ret = [NSMutableArray new];
+    NSMutableArray *ret = [NSMutableArray arrayWithCapacity:set.count()];
     NSUInteger path[2] = {section, 0};
     for (auto index : set.as_indexes()) {
         path[1] = index;
@@ -420,6 +1085,7 @@ struct CollectionCallbackWrapper {
     bool ignoreChangesInInitialNotification;
 
     void operator()(realm::CollectionChangeSet const& changes, std::exception_ptr err) {
+        RLM_SIGNPOST_INTERVAL("Deliver collection notification");
         if (err) {
             try {
                 rethrow_exception(err);
@@ -432,6 +1098,11 @@ struct CollectionCallbackWrapper {
             }
         }
 
+        if ([collection isKindOfClass:[RLMResults class]]) {
+            [(RLMResults *)collection cacheCountForCurrentVersion];
+            [(RLMResults *)collection updateObjectIndexWithChanges:ignoreChangesInInitialNotification ? nullptr : &changes];
+        }
+
         if (ignoreChangesInInitialNotification) {
             ignoreChangesInInitialNotification = false;
             block(collection, nil, nil);
@@ -444,6 +1115,128 @@ struct CollectionCallbackWrapper {
         }
     }
 };
+
+// Wraps a CollectionCallbackWrapper so that changes arriving less than
+// `minimumInterval` after the previous delivery are merged together and
+// delivered as a single changeset once the interval has elapsed. The initial
+// notification and errors are always delivered immediately.
+//
+// Delayed deliveries are scheduled on the queue notifications are delivered
+// to, or the current thread's run loop if there isn't one, and only hold a
+// weak reference to the callback so that nothing is delivered once the
+// notification token has been invalidated.
+class CoalescingCollectionCallback : public std::enable_shared_from_this<CoalescingCollectionCallback> {
+public:
+    CoalescingCollectionCallback(CollectionCallbackWrapper wrapper, NSTimeInterval minimumInterval,
+                                 dispatch_queue_t queue)
+    : _wrapper(std::move(wrapper)), _minimumInterval(minimumInterval), _queue(queue) { }
+
+    void receive(realm::CollectionChangeSet const& changes, std::exception_ptr err) {
+        if (err || _first) {
+            _first = false;
+            _pending.reset();
+            deliver(changes, err);
+            return;
+        }
+
+        realm::_impl::CollectionChangeBuilder builder(changes.deletions, changes.insertions,
+                                                      changes.modifications, changes.moves);
+        // Merging shifts the per-column modifications along with the others
+        builder.columns = changes.columns;
+        if (_pending) {
+            _pending->merge(std::move(builder));
+        }
+        else {
+            _pending = std::move(builder);
+        }
+        _rootWasDeleted = changes.collection_root_was_deleted;
+
+        if (_deliveryScheduled) {
+            return;
+        }
+        NSTimeInterval remaining = _lastDelivery + _minimumInterval - CFAbsoluteTimeGetCurrent();
+        if (remaining <= 0) {
+            flush();
+        }
+        else {
+            schedule(remaining);
+        }
+    }
+
+private:
+    CollectionCallbackWrapper _wrapper;
+    NSTimeInterval _minimumInterval;
+    dispatch_queue_t _queue;
+    CFAbsoluteTime _lastDelivery = 0;
+    std::optional<realm::_impl::CollectionChangeBuilder> _pending;
+    bool _rootWasDeleted = false;
+    bool _deliveryScheduled = false;
+    bool _first = true;
+
+    void deliver(realm::CollectionChangeSet const& changes, std::exception_ptr err) {
+        _lastDelivery = CFAbsoluteTimeGetCurrent();
+        _wrapper(changes, err);
+    }
+
+    void flush() {
+        _deliveryScheduled = false;
+        if (!_pending) {
+            return;
+        }
+        auto changes = std::move(*_pending).finalize();
+        _pending.reset();
+        changes.collection_root_was_deleted = _rootWasDeleted;
+        // The merged changes cancelled each other out (e.g. an object was
+        // inserted and then deleted again), so there's nothing to report
+        if (changes.empty() && !changes.collection_root_was_deleted) {
+            return;
+        }
+        deliver(changes, nullptr);
+    }
+
+    void schedule(NSTimeInterval delay) {
+        _deliveryScheduled = true;
+        std::weak_ptr<CoalescingCollectionCallback> weakSelf = shared_from_this();
+        auto fire = ^{
+            if (auto self = weakSelf.lock()) {
+                @autoreleasepool {
+                    self->flush();
+                }
+            }
+        };
+        if (_queue) {
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), _queue, fire);
+            return;
+        }
+        CFRunLoopTimerRef timer = CFRunLoopTimerCreateWithHandler(kCFAllocatorDefault,
+                                                                  CFAbsoluteTimeGetCurrent() + delay,
+                                                                  0, 0, 0, ^(CFRunLoopTimerRef) { fire(); });
+        // Notifications themselves are delivered in the common modes, so the
+        // delayed delivery has to be too or it would stall while scrolling
+        CFRunLoopAddTimer(CFRunLoopGetCurrent(), timer, kCFRunLoopCommonModes);
+        CFRelease(timer);
+    }
+};
+
+struct CoalescingCollectionCallbackWrapper {
+    std::shared_ptr<CoalescingCollectionCallback> callback;
+
+    void operator()(realm::CollectionChangeSet const& changes, std::exception_ptr err) {
+        callback->receive(changes, err);
+    }
+};
+
+template<typename Collection>
+realm::NotificationToken addCallback(Collection& collection, CollectionCallbackWrapper wrapper,
+                                     realm::KeyPathArray keyPaths, NSTimeInterval minimumInterval,
+                                     dispatch_queue_t queue) {
+    if (minimumInterval <= 0) {
+        return collection.add_notification_callback(std::move(wrapper), std::move(keyPaths));
+    }
+    auto callback = std::make_shared<CoalescingCollectionCallback>(std::move(wrapper), minimumInterval, queue);
+    return collection.add_notification_callback(CoalescingCollectionCallbackWrapper{std::move(callback)},
+                                                std::move(keyPaths));
+}
 } // anonymous namespace
 
 @implementation RLMCancellationToken
@@ -464,13 +1257,47 @@ struct CollectionCallbackWrapper {
     std::lock_guard<std::mutex> lock(_mutex);
     _token = {};
     _realm = nil;
+    _register = nullptr;
+}
+
+- (void)pause {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_realm || _paused) {
+        return;
+    }
+    _paused = true;
+    _token = {};
+}
+
+- (void)resume {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_realm || !_paused) {
+        return;
+    }
+    _paused = false;
+    if (!_queue) {
+        [_realm verifyThread];
+        if (_register) {
+            _token = _register();
+        }
+        return;
+    }
+
+    // The callback has to be added on the queue which the Realm is confined to
+    dispatch_async(_queue, ^{
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_realm && !_paused && _register) {
+            _token = _register();
+        }
+    });
 }
 
 template<typename RLMCollection>
 RLMNotificationToken *RLMAddNotificationBlock(RLMCollection *collection,
                                               void (^block)(id, RLMCollectionChange *, NSError *),
                                               NSArray<NSString *> *keyPaths,
-                                              dispatch_queue_t queue) {
+                                              dispatch_queue_t queue,
+                                              NSTimeInterval minimumInterval) {
     RLMRealm *realm = collection.realm;
     if (!realm) {
         @throw RLMException(@"Linking objects notifications are only supported on managed objects.");
@@ -484,12 +1311,18 @@ RLMNotificationToken *RLMAddNotificationBlock(RLMCollection *collection,
     if (!queue) {
         [realm verifyNotificationsAreSupported:true];
         token->_realm = realm;
-        token->_token = RLMGetBackingCollection(collection).add_notification_callback(CollectionCallbackWrapper{block, collection, skipFirst}, std::move(keyPathArray));
+        token->_register = [=] {
+            return addCallback(RLMGetBackingCollection(collection),
+                               CollectionCallbackWrapper{block, collection, skipFirst},
+                               keyPathArray, minimumInterval, nil);
+        };
+        token->_token = token->_register();
         return token;
     }
 
     RLMThreadSafeReference *tsr = [RLMThreadSafeReference referenceWithThreadConfined:collection];
     token->_realm = realm;
+    token->_queue = queue;
     RLMRealmConfiguration *config = realm.configuration;
     dispatch_async(queue, ^{
         std::lock_guard<std::mutex> lock(token->_mutex);
@@ -503,7 +1336,14 @@ RLMNotificationToken *RLMAddNotificationBlock(RLMCollection *collection,
             return;
         }
         RLMCollection *collection = [realm resolveThreadSafeReference:tsr];
-        token->_token = RLMGetBackingCollection(collection).add_notification_callback(CollectionCallbackWrapper{block, collection, skipFirst}, std::move(keyPathArray));
+        token->_register = [=] {
+            return addCallback(RLMGetBackingCollection(collection),
+                               CollectionCallbackWrapper{block, collection, skipFirst},
+                               keyPathArray, minimumInterval, queue);
+        };
+        if (!token->_paused) {
+            token->_token = token->_register();
+        }
     });
     return token;
 }
@@ -511,6 +1351,6 @@ RLMNotificationToken *RLMAddNotificationBlock(RLMCollection *collection,
 @end
 
 // Explicitly instantiate the templated function for the two types we'll use it on
-template RLMNotificationToken *RLMAddNotificationBlock<>(RLMManagedArray *, void (^)(id, RLMCollectionChange *, NSError *),  NSArray<NSString *> *, dispatch_queue_t);
-template RLMNotificationToken *RLMAddNotificationBlock<>(RLMManagedSet *, void (^)(id, RLMCollectionChange *, NSError *), NSArray<NSString *> *, dispatch_queue_t);
-template RLMNotificationToken *RLMAddNotificationBlock<>(RLMResults *, void (^)(id, RLMCollectionChange *, NSError *),  NSArray<NSString *> *, dispatch_queue_t);
+template RLMNotificationToken *RLMAddNotificationBlock<>(RLMManagedArray *, void (^)(id, RLMCollectionChange *, NSError *),  NSArray<NSString *> *, dispatch_queue_t, NSTimeInterval);
+template RLMNotificationToken *RLMAddNotificationBlock<>(RLMManagedSet *, void (^)(id, RLMCollectionChange *, NSError *), NSArray<NSString *> *, dispatch_queue_t, NSTimeInterval);
+template RLMNotificationToken *RLMAddNotificationBlock<>(RLMResults *, void (^)(id, RLMCollectionChange *, NSError *),  NSArray<NSString *> *, dispatch_queue_t, NSTimeInterval);
@@ -26,10 +26,52 @@ NS_ASSUME_NONNULL_BEGIN
 
 void RLMCollectionSetValueForKey(id<RLMFastEnumerable> collection, NSString *key, id _Nullable value);
 FOUNDATION_EXTERN NSString *RLMDescriptionWithMaxDepth(NSString *name, id<RLMCollection> collection, NSUInteger depth);
+
+// Limits applied when describing an object graph. Descriptions of large graphs
+// are written into a single buffer and stop growing once either limit is
+// reached, with the remaining elements reported as skipped.
+typedef struct {
+    // Nesting depth past which objects and collections are not described
+    NSUInteger maxDepth;
+    // Approximate maximum length of the description, in UTF-16 code units
+    NSUInteger maxLength;
+    // Maximum number of values described across the entire graph
+    NSUInteger maxElements;
+    // If YES, collections are described only by their type and count
+    BOOL summarizeCollections;
+} RLMDescriptionOptions;
+
+// The limits used by -description on Realm objects and collections
+FOUNDATION_EXTERN const RLMDescriptionOptions RLMDefaultDescriptionOptions;
+// Describe an object, collection, or other value using the given limits
+FOUNDATION_EXTERN NSString *RLMDescriptionWithOptions(id _Nullable value, RLMDescriptionOptions options);
 FOUNDATION_EXTERN void RLMAssignToCollection(id<RLMCollection> collection, id value);
+
+// The minimum number of objects which fast enumeration of a Realm collection
+// creates at a time. Larger batches spread the per-batch overhead over more
+// objects, but keep more accessors alive at once. 0 restores the default of 64.
+FOUNDATION_EXTERN NSUInteger RLMGetEnumerationBufferSize(void);
+FOUNDATION_EXTERN void RLMSetEnumerationBufferSize(NSUInteger size);
 FOUNDATION_EXTERN id _Nullable (*_Nullable RLMSwiftAsFastEnumeration)(id);
 FOUNDATION_EXTERN id _Nullable (*_Nullable RLMSwiftBridgeValue)(id);
 
+// A value read from a collection of mixed values without creating an
+// Objective-C object for it. Ints and bools are stored in `intValue`, and
+// floats, doubles and dates (as a time interval since the reference date) in
+// `doubleValue`. Strings and data are stored in `bytes` and `size`, which
+// point into the Realm file and must be copied before the Realm is refreshed
+// or written to. Values of any other type have `boxed` set and must be read
+// as an object instead.
+typedef struct {
+    RLMPropertyType type;
+    bool isNull;
+    bool boxed;
+    int64_t intValue;
+    double doubleValue;
+    const char *_Nullable bytes;
+    size_t size;
+} RLMMixedValue;
+
 typedef RLM_CLOSED_ENUM(int32_t, RLMCollectionType) {
     RLMCollectionTypeArray = 0,
     RLMCollectionTypeSet = 1,
@@ -20,6 +20,7 @@
 
 #import <realm/object-store/collection_notifications.hpp>
 
+#import <functional>
 #import <vector>
 #import <mutex>
 
@@ -30,6 +31,7 @@ namespace realm {
     class TableView;
     struct CollectionChangeSet;
     struct ColKey;
+    class Mixed;
     namespace object_store {
         class Collection;
         class Dictionary;
@@ -71,6 +73,10 @@ class RLMClassInfo;
 
 - (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state
                                     count:(NSUInteger)len;
+
+// Call `block` with consecutive arrays of up to `chunkSize` objects, reusing
+// the same accessor context for every chunk.
+- (void)enumerateInChunksOfSize:(NSUInteger)chunkSize usingBlock:(void (^)(NSArray *chunk, BOOL *stop))block;
 @end
 NSUInteger RLMFastEnumerate(NSFastEnumerationState *state, NSUInteger len, id<RLMFastEnumerable> collection);
 
@@ -88,6 +94,12 @@ NSUInteger RLMFastEnumerate(NSFastEnumerationState *state, NSUInteger len, id<RL
     __unsafe_unretained RLMRealm *_realm;
     realm::NotificationToken _token;
     std::mutex _mutex;
+    // Re-adds the notification callback when a paused token is resumed. Set
+    // once the callback has first been added, on the thread or queue which
+    // notifications are delivered to.
+    std::function<realm::NotificationToken()> _register;
+    dispatch_queue_t _queue;
+    bool _paused;
 }
 @end
 
@@ -96,17 +108,41 @@ realm::object_store::Dictionary& RLMGetBackingCollection(RLMManagedDictionary *)
 realm::List& RLMGetBackingCollection(RLMManagedArray *);
 realm::Results& RLMGetBackingCollection(RLMResults *);
 
+// Read a mixed value for the bulk mixed value readers. The returned value may
+// point into the Realm file, so it's only valid as long as `value` is.
+RLMMixedValue RLMMixedValueFromMixed(realm::Mixed const& value);
+// A value which the bulk mixed value readers report as needing to be read as
+// an object
+RLMMixedValue RLMBoxedMixedValue();
+
 template<typename RLMCollection>
 RLMNotificationToken *RLMAddNotificationBlock(RLMCollection *collection,
                                               void (^block)(id, RLMCollectionChange *, NSError *),
                                               NSArray<NSString *> *keyPaths,
-                                              dispatch_queue_t queue);
+                                              dispatch_queue_t queue,
+                                              NSTimeInterval minimumInterval = 0);
 
 template<typename Collection>
 NSArray *RLMCollectionValueForKey(Collection& collection, NSString *key, RLMClassInfo& info);
 
+// Read the values of the given int, float, double or date property directly
+// from the backing columns into a packed buffer of int64_t (for int
+// properties), double (for float and double properties, with null stored as
+// NaN) or int64_t nanoseconds since 1970 (for date properties, with null
+// stored as INT64_MIN).
+template<typename Collection>
+NSData *RLMCollectionPackedValuesForKey(Collection& collection, NSString *key, RLMClassInfo& info);
+
 std::vector<std::pair<std::string, bool>> RLMSortDescriptorsToKeypathArray(NSArray<RLMSortDescriptor *> *properties);
 
+// Sort or distinct results of objects of the type described by `info`, reusing
+// the column keys resolved the last time the same key paths were used for
+// that type rather than parsing the key paths again
+realm::Results RLMSortResults(realm::Results const& results, RLMClassInfo *_Nullable info,
+                              NSArray<RLMSortDescriptor *> *properties);
+realm::Results RLMDistinctResults(realm::Results const& results, RLMClassInfo *_Nullable info,
+                                  NSArray<NSString *> *keyPaths);
+
 realm::ColKey columnForProperty(NSString *propertyName,
                                 realm::object_store::Collection const& backingCollection,
                                 RLMClassInfo *objectInfo,
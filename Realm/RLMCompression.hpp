@@ -0,0 +1,41 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2021 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#import <Realm/RLMConstants.h>
+
+#import <cstddef>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// String and data properties listed in +[RLMObject compressedProperties] store
+// their values compressed in the column. Compressed values begin with a header
+// holding the algorithm and the uncompressed size; values which are too small
+// to benefit from compression are stored as-is, and are read back as-is as
+// they do not have the header.
+
+// Encode a value for storage in a compressed column. Returns nil if the value
+// should be stored unmodified.
+NSData *_Nullable RLMCompressValue(const char *bytes, size_t size, RLMCompressionAlgorithm algorithm);
+
+// Check if a value read from a compressed column was encoded by RLMCompressValue()
+bool RLMIsCompressedValue(const char *_Nullable bytes, size_t size) noexcept;
+
+// Decode a value for which RLMIsCompressedValue() returned true
+NSData *RLMDecompressValue(const char *bytes, size_t size);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2021 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#import "RLMCompression.hpp"
+
+#import "RLMUtil.hpp"
+
+#import <compression.h>
+
+#import <cstring>
+
+namespace {
+// Values are only compressed if they're at least this large, as the header and
+// the compressor's own framing outweigh any savings for small values
+constexpr size_t s_minimumCompressedSize = 64;
+
+// Header: magic, algorithm, uncompressed size. The leading NUL keeps the magic
+// from matching the start of any plausible string value.
+constexpr char s_magic[] = {'\0', 'R', 'L', 'Z'};
+constexpr size_t s_headerSize = sizeof(s_magic) + 1 + sizeof(uint64_t);
+
+// Stored in the header for values which start with the magic but don't
+// compress, so that they still round-trip
+constexpr uint8_t s_uncompressed = 0;
+
+compression_algorithm toAlgorithm(uint8_t algorithm) {
+    switch (algorithm) {
+        case RLMCompressionAlgorithmLZ4:   return COMPRESSION_LZ4;
+        case RLMCompressionAlgorithmLZFSE: return COMPRESSION_LZFSE;
+        case RLMCompressionAlgorithmZlib:  return COMPRESSION_ZLIB;
+        case RLMCompressionAlgorithmLZMA:  return COMPRESSION_LZMA;
+    }
+    @throw RLMException(@"Invalid compression algorithm %d", (int)algorithm);
+}
+
+NSData *encode(const char *bytes, size_t size, uint8_t algorithm, size_t (^write)(uint8_t *, size_t)) {
+    NSMutableData *data = [NSMutableData dataWithLength:s_headerSize + size];
+    auto out = static_cast<uint8_t *>(data.mutableBytes);
+    memcpy(out, s_magic, sizeof(s_magic));
+    out[sizeof(s_magic)] = algorithm;
+    uint64_t originalSize = size;
+    memcpy(out + sizeof(s_magic) + 1, &originalSize, sizeof(originalSize));
+    size_t written = write(out + s_headerSize, size);
+    if (written == 0) {
+        return nil;
+    }
+    data.length = s_headerSize + written;
+    return data;
+}
+} // anonymous namespace
+
+NSData *RLMCompressValue(const char *bytes, size_t size, RLMCompressionAlgorithm algorithm) {
+    bool needsHeader = RLMIsCompressedValue(bytes, size);
+    if (size >= s_minimumCompressedSize) {
+        auto compressionAlgorithm = toAlgorithm(algorithm);
+        // Only keep the compressed value if it's smaller than the original, so
+        // the output buffer is the size of the input
+        NSData *compressed = encode(bytes, size, algorithm, ^(uint8_t *out, size_t capacity) {
+            return compression_encode_buffer(out, capacity, reinterpret_cast<const uint8_t *>(bytes), size,
+                                             nullptr, compressionAlgorithm);
+        });
+        if (compressed) {
+            return compressed;
+        }
+    }
+    if (!needsHeader) {
+        return nil;
+    }
+    return encode(bytes, size, s_uncompressed, ^(uint8_t *out, size_t) {
+        memcpy(out, bytes, size);
+        return size;
+    });
+}
+
+bool RLMIsCompressedValue(const char *bytes, size_t size) noexcept {
+    return bytes && size >= s_headerSize && memcmp(bytes, s_magic, sizeof(s_magic)) == 0;
+}
+
+NSData *RLMDecompressValue(const char *bytes, size_t size) {
+    auto header = reinterpret_cast<const uint8_t *>(bytes);
+    uint8_t algorithm = header[sizeof(s_magic)];
+    uint64_t originalSize;
+    memcpy(&originalSize, header + sizeof(s_magic) + 1, sizeof(originalSize));
+    auto payload = header + s_headerSize;
+    size_t payloadSize = size - s_headerSize;
+    if (algorithm == s_uncompressed) {
+        return [NSData dataWithBytes:payload length:payloadSize];
+    }
+
+    NSMutableData *data = [NSMutableData dataWithLength:originalSize];
+    size_t decoded = compression_decode_buffer(static_cast<uint8_t *>(data.mutableBytes), originalSize,
+                                               payload, payloadSize, nullptr, toAlgorithm(algorithm));
+    if (decoded != originalSize) {
+        @throw RLMException(@"Failed to decompress a value of %llu bytes: the stored data is corrupt.",
+                            (unsigned long long)originalSize);
+    }
+    return data;
+}
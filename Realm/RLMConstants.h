@@ -84,6 +84,22 @@ typedef RLM_CLOSED_ENUM(int32_t, RLMPropertyType) {
     RLMPropertyTypeDecimal128 = 11
 };
 
+/**
+ `RLMCompressionAlgorithm` is an enumeration of the algorithms which can be used
+ to compress the values of the properties listed in
+ `+[RLMObject compressedProperties]`.
+ */
+typedef RLM_CLOSED_ENUM(NSInteger, RLMCompressionAlgorithm) {
+    /** LZ4: the fastest to compress and decompress, with the lowest compression ratio. */
+    RLMCompressionAlgorithmLZ4   = 1,
+    /** LZFSE: a compression ratio similar to zlib while being considerably faster. */
+    RLMCompressionAlgorithmLZFSE = 2,
+    /** zlib: the DEFLATE format at compression level 5. */
+    RLMCompressionAlgorithmZlib  = 3,
+    /** LZMA: the highest compression ratio, but much slower to compress and decompress. */
+    RLMCompressionAlgorithmLZMA  = 4
+};
+
 /** An error domain identifying Realm-specific errors. */
 extern NSString * const RLMErrorDomain;
 
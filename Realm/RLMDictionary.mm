@@ -17,6 +17,8 @@
 ////////////////////////////////////////////////////////////////////////////
 
 #import "RLMDictionary_Private.hpp"
+
+#import "RLMCollection_Private.hpp"
 #import "RLMObject_Private.h"
 #import "RLMObjectSchema.h"
 #import "RLMProperty_Private.h"
@@ -102,6 +104,20 @@ id RLMDictionaryKey(__unsafe_unretained RLMDictionary *const dictionary,
     return validated;
 }
 
+void RLMDictionaryValidateBulkRead(__unsafe_unretained RLMDictionary *const dictionary,
+                                   NSUInteger count) {
+    if (dictionary.type != RLMPropertyTypeAny || dictionary.keyType != RLMPropertyTypeString) {
+        @throw RLMException(@"Cannot read mixed values from a dictionary of type '%@' with keys of type '%@'.",
+                            dictionary.objectClassName ?: RLMTypeToString(dictionary.type),
+                            RLMTypeToString(dictionary.keyType));
+    }
+    NSUInteger actualCount = dictionary.count;
+    if (count != actualCount) {
+        @throw RLMException(@"Cannot read %llu entries from a dictionary with %llu entries.",
+                            (unsigned long long)count, (unsigned long long)actualCount);
+    }
+}
+
 id RLMDictionaryValue(__unsafe_unretained RLMDictionary *const dictionary,
                       __unsafe_unretained id const value) {
     if (!value) {
@@ -238,6 +254,21 @@ static void changeDictionary(__unsafe_unretained RLMDictionary *const dictionary
     });
 }
 
+- (void)getMixedKeys:(RLMMixedValue *)keys values:(RLMMixedValue *)values count:(NSUInteger)count {
+    RLMDictionaryValidateBulkRead(self, count);
+    // Unmanaged values are already objects, so only the keys are unboxed.
+    // The key strings are owned by the keys or the autorelease pool.
+    NSUInteger i = 0;
+    for (NSString *key in _backingCollection) {
+        keys[i] = RLMMixedValue{};
+        keys[i].type = RLMPropertyTypeString;
+        keys[i].bytes = key.UTF8String;
+        keys[i].size = strlen(keys[i].bytes);
+        values[i] = RLMBoxedMixedValue();
+        ++i;
+    }
+}
+
 - (void)enumerateKeysAndObjectsUsingBlock:(void (^)(id key, id obj, BOOL *stop))block {
     [_backingCollection enumerateKeysAndObjectsUsingBlock:block];
 }
@@ -521,56 +552,4 @@ static void changeDictionary(__unsafe_unretained RLMDictionary *const dictionary
     return RLMDictionaryDescriptionWithMaxDepth(@"RLMDictionary", self, depth);
 }
 
-NSString *RLMDictionaryDescriptionWithMaxDepth(NSString *name,
-                                               RLMDictionary *dictionary,
-                                               NSUInteger depth) {
-    if (depth == 0) {
-        return @"<Maximum depth exceeded>";
-    }
-
-    const NSUInteger maxObjects = 100;
-    auto str = [NSMutableString stringWithFormat:@"%@<%@, %@> <%p> (\n", name,
-                RLMTypeToString([dictionary keyType]),
-                [dictionary objectClassName] ?: RLMTypeToString([dictionary type]),
-                (void *)dictionary];
-    size_t index = 0, skipped = 0;
-    for (id key in dictionary) {
-        id value = dictionary[key];
-        NSString *keyDesc;
-        if ([key respondsToSelector:@selector(descriptionWithMaxDepth:)]) {
-            keyDesc = [key descriptionWithMaxDepth:depth - 1];
-        }
-        else {
-            keyDesc = [key description];
-        }
-        NSString *valDesc;
-        if ([value respondsToSelector:@selector(descriptionWithMaxDepth:)]) {
-            valDesc = [value descriptionWithMaxDepth:depth - 1];
-        }
-        else {
-            valDesc = [value description];
-        }
-
-        // Indent child objects
-        NSString *sub = [NSString stringWithFormat:@"[%@]: %@", keyDesc, valDesc];
-        NSString *objDescription = [sub stringByReplacingOccurrencesOfString:@"\n"
-                                                                  withString:@"\n\t"];
-        [str appendFormat:@"%@,\n", objDescription];
-        if (index >= maxObjects) {
-            skipped = dictionary.count - maxObjects;
-            break;
-        }
-    }
-
-    // Remove last comma and newline characters
-    if (dictionary.count > 0) {
-        [str deleteCharactersInRange:NSMakeRange(str.length-2, 2)];
-    }
-    if (skipped) {
-        [str appendFormat:@"\n\t... %zu objects skipped.", skipped];
-    }
-    [str appendFormat:@"\n)"];
-    return str;
-}
-
 @end
@@ -16,6 +16,7 @@
 //
 ////////////////////////////////////////////////////////////////////////////
 
+#import <Realm/RLMCollection_Private.h>
 #import <Realm/RLMDictionary.h>
 
 @class RLMObjectBase, RLMProperty;
@@ -31,6 +32,11 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly) BOOL isLegacyProperty;
 // The name of the property which this collection represents
 @property (nonatomic, readonly) NSString *propertyKey;
+// Read the keys and values of a dictionary of mixed values with string keys
+// into `keys` and `values`, which must have space for `count` entries. `count`
+// must be the number of entries in the dictionary. See RLMMixedValue for the
+// lifetime of the values read.
+- (void)getMixedKeys:(RLMMixedValue *)keys values:(RLMMixedValue *)values count:(NSUInteger)count;
 @end
 
 @interface RLMManagedDictionary : RLMDictionary
@@ -42,5 +48,6 @@ FOUNDATION_EXTERN NSString *RLMDictionaryDescriptionWithMaxDepth(NSString *name,
                                                                  NSUInteger depth);
 id RLMDictionaryKey(RLMDictionary *dictionary, id key) REALM_HIDDEN;
 id RLMDictionaryValue(RLMDictionary *dictionary, id value) REALM_HIDDEN;
+void RLMDictionaryValidateBulkRead(RLMDictionary *dictionary, NSUInteger count) REALM_HIDDEN;
 
 NS_ASSUME_NONNULL_END
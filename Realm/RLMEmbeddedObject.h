@@ -316,6 +316,31 @@ typedef void (^RLMObjectChangeBlock)(BOOL deleted,
  */
 - (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block keyPaths:(NSArray<NSString *> *)keyPaths;
 
+/**
+ Registers a block to be called each time the object changes, optionally
+ without reading the values of the changed properties.
+
+ This behaves like `-addNotificationBlock:keyPaths:queue:`, except that if
+ `includeValues` is `NO` the `previousValue` and `value` of each
+ `RLMPropertyChange` passed to the block are `nil`. Reading the old and new
+ values requires reading each changed property both before and after each
+ write, which for large strings, data and collections can be expensive, so
+ observers which only need to know which properties changed should pass `NO`.
+
+ @param block The block to be called whenever a change occurs.
+ @param keyPaths The block will be called for changes occuring on these keypaths. If `nil`,
+ notifications are delivered for every property key path.
+ @param queue The serial queue to deliver notifications to, or `nil` to deliver them on the
+ current thread.
+ @param includeValues Whether the changes passed to the block include the old and new values
+ of the changed properties.
+ @return A token which must be held for as long as you want updates to be delivered.
+ */
+- (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block
+                                      keyPaths:(nullable NSArray<NSString *> *)keyPaths
+                                         queue:(nullable dispatch_queue_t)queue
+                                 includeValues:(BOOL)includeValues;
+
 #pragma mark - Other Instance Methods
 
 /**
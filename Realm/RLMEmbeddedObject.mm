@@ -66,21 +66,28 @@
 }
 
 - (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block {
-    return RLMObjectAddNotificationBlock(self, block, nil, nil);
+    return RLMObjectAddNotificationBlock(self, block, nil, nil, YES);
 }
 
 - (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block queue:(dispatch_queue_t)queue {
-    return RLMObjectAddNotificationBlock(self, block, nil, queue);
+    return RLMObjectAddNotificationBlock(self, block, nil, queue, YES);
 }
 
 - (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block keyPaths:(NSArray<NSString *> *)keyPaths {
-    return RLMObjectAddNotificationBlock(self, block, keyPaths, nil);
+    return RLMObjectAddNotificationBlock(self, block, keyPaths, nil, YES);
 }
 
 - (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block
                                       keyPaths:(NSArray<NSString *> *)keyPaths
                                          queue:(dispatch_queue_t)queue {
-    return RLMObjectAddNotificationBlock(self, block, keyPaths, queue);
+    return RLMObjectAddNotificationBlock(self, block, keyPaths, queue, YES);
+}
+
+- (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block
+                                      keyPaths:(NSArray<NSString *> *)keyPaths
+                                         queue:(dispatch_queue_t)queue
+                                 includeValues:(BOOL)includeValues {
+    return RLMObjectAddNotificationBlock(self, block, keyPaths, queue, includeValues);
 }
 
 + (NSString *)className {
@@ -37,6 +37,7 @@
 #import <realm/object-store/shared_realm.hpp>
 #import <realm/table_view.hpp>
 
+#import <numeric>
 #import <objc/runtime.h>
 
 @interface RLMManagedArrayHandoverMetadata : NSObject
@@ -306,10 +307,14 @@ static void RLMInsertObject(RLMManagedArray *ar, id object, NSUInteger index) {
 }
 
 - (void)addObjectsFromArray:(NSArray *)array {
+    // Validate everything up front so that an invalid object doesn't leave
+    // the list partially appended to
+    for (id obj in array) {
+        RLMArrayValidateMatchingObjectType(self, obj);
+    }
     changeArray(self, NSKeyValueChangeInsertion, NSMakeRange(self.count, array.count), ^{
         RLMAccessorContext context(*_objectInfo);
         for (id obj in array) {
-            RLMArrayValidateMatchingObjectType(self, obj);
             _backingList.add(context, obj);
         }
     });
@@ -322,18 +327,29 @@ static void RLMInsertObject(RLMManagedArray *ar, id object, NSUInteger index) {
 }
 
 - (void)replaceAllObjectsWithObjects:(NSArray *)objects {
-    if (auto count = self.count) {
-        changeArray(self, NSKeyValueChangeRemoval, NSMakeRange(0, count), ^{
-            _backingList.remove_all();
-        });
-    }
-    if (![objects respondsToSelector:@selector(count)] || !objects.count) {
+    NSUInteger newCount = [objects respondsToSelector:@selector(count)] ? objects.count : 0;
+    NSUInteger oldCount = self.count;
+    if (!newCount) {
+        if (oldCount) {
+            changeArray(self, NSKeyValueChangeRemoval, NSMakeRange(0, oldCount), ^{
+                _backingList.remove_all();
+            });
+        }
         return;
     }
-    changeArray(self, NSKeyValueChangeInsertion, NSMakeRange(0, objects.count), ^{
+
+    auto assign = ^{
         RLMAccessorContext context(*_objectInfo);
         _backingList.assign(context, objects);
-    });
+    };
+    if (!oldCount) {
+        changeArray(self, NSKeyValueChangeInsertion, NSMakeRange(0, newCount), assign);
+        return;
+    }
+    // Replacing the entire contents of a non-empty list is reported as a
+    // single change to the property rather than as a removal followed by
+    // an insertion, which is also what observers on other threads see
+    changeArray(self, NSKeyValueChangeSetting, assign, [] { return (NSIndexSet *)nil; });
 }
 
 - (void)replaceObjectAtIndex:(NSUInteger)index withObject:(id)object {
@@ -362,6 +378,38 @@ static void RLMInsertObject(RLMManagedArray *ar, id object, NSUInteger index) {
     });
 }
 
+// The list is reordered with moves rather than by setting each element, as
+// that keeps embedded objects and backlinks intact and is reported to
+// notifiers as moves.
+- (void)applyPermutation:(NSArray<NSNumber *> *)permutation {
+    translateErrors([&] { _backingList.verify_in_transaction(); });
+    auto order = RLMArrayValidatePermutation(self, permutation);
+    size_t first = 0, end = order.size();
+    while (first < end && order[first] == first) {
+        ++first;
+    }
+    while (end > first && order[end - 1] == end - 1) {
+        --end;
+    }
+    if (first == end) {
+        return;
+    }
+
+    changeArray(self, NSKeyValueChangeReplacement, NSMakeRange(first, end - first), ^{
+        // The original index of the object currently at each position
+        std::vector<size_t> current(order.size());
+        std::iota(current.begin(), current.end(), 0);
+        for (size_t i = first; i < end; ++i) {
+            auto it = std::find(current.begin() + i, current.begin() + end, order[i]);
+            size_t from = it - current.begin();
+            if (from != i) {
+                _backingList.move(from, i);
+                std::rotate(current.begin() + i, it, it + 1);
+            }
+        }
+    });
+}
+
 - (NSUInteger)indexOfObject:(id)object {
     RLMArrayValidateMatchingObjectType(self, object);
     return translateErrors([&] {
@@ -454,7 +502,7 @@ static void RLMInsertObject(RLMManagedArray *ar, id object, NSUInteger index) {
 - (RLMResults *)sortedResultsUsingDescriptors:(NSArray<RLMSortDescriptor *> *)properties {
     return translateErrors([&] {
         return [RLMResults resultsWithObjectInfo:*_objectInfo
-                                         results:_backingList.sort(RLMSortDescriptorsToKeypathArray(properties))];
+                                         results:RLMSortResults(_backingList.as_results(), _objectInfo, properties)];
     });
 }
 
@@ -469,7 +517,7 @@ static void RLMInsertObject(RLMManagedArray *ar, id object, NSUInteger index) {
     if (_type != RLMPropertyTypeObject) {
         @throw RLMException(@"Querying is currently only implemented for arrays of Realm Objects");
     }
-    auto query = RLMPredicateToQuery(predicate, _objectInfo->rlmObjectSchema, _realm.schema, _realm.group);
+    auto query = RLMPredicateToQuery(predicate, *_objectInfo);
     auto results = translateErrors([&] { return _backingList.filter(std::move(query)); });
     return [RLMResults resultsWithObjectInfo:*_objectInfo results:std::move(results)];
 }
@@ -478,14 +526,51 @@ static void RLMInsertObject(RLMManagedArray *ar, id object, NSUInteger index) {
     if (_type != RLMPropertyTypeObject) {
         @throw RLMException(@"Querying is currently only implemented for arrays of Realm Objects");
     }
-    realm::Query query = RLMPredicateToQuery(predicate, _objectInfo->rlmObjectSchema,
-                                             _realm.schema, _realm.group);
+    realm::Query query = RLMPredicateToQuery(predicate, *_objectInfo);
 
     return translateErrors([&] {
         return RLMConvertNotFound(_backingList.find(std::move(query)));
     });
 }
 
+template<typename T>
+static void getValues(__unsafe_unretained RLMManagedArray *const ar, RLMPropertyType type,
+                      T *buffer, NSRange range) {
+    RLMArrayValidateBulkRead(ar, type, range);
+    translateErrors([&] {
+        // Read directly from the list rather than boxing each value
+        for (NSUInteger i = 0; i < range.length; ++i) {
+            buffer[i] = ar->_backingList.get<T>(range.location + i);
+        }
+    });
+}
+
+- (void)getInt64Values:(int64_t *)buffer range:(NSRange)range {
+    getValues(self, RLMPropertyTypeInt, buffer, range);
+}
+
+- (void)getDoubleValues:(double *)buffer range:(NSRange)range {
+    getValues(self, RLMPropertyTypeDouble, buffer, range);
+}
+
+- (void)getTimestampValues:(int64_t *)buffer range:(NSRange)range {
+    RLMArrayValidateBulkRead(self, RLMPropertyTypeDate, range);
+    translateErrors([&] {
+        for (NSUInteger i = 0; i < range.length; ++i) {
+            buffer[i] = RLMTimestampToNanoseconds(_backingList.get<realm::Timestamp>(range.location + i));
+        }
+    });
+}
+
+- (void)getMixedValues:(RLMMixedValue *)buffer range:(NSRange)range {
+    RLMArrayValidateBulkRead(self, RLMPropertyTypeAny, range);
+    translateErrors([&] {
+        for (NSUInteger i = 0; i < range.length; ++i) {
+            buffer[i] = RLMMixedValueFromMixed(_backingList.get_any(range.location + i));
+        }
+    });
+}
+
 - (NSArray *)objectsAtIndexes:(NSIndexSet *)indexes {
     size_t c = self.count;
     NSMutableArray *result = [[NSMutableArray alloc] initWithCapacity:indexes.count];
@@ -575,6 +660,13 @@ static void RLMInsertObject(RLMManagedArray *ar, id object, NSUInteger index) {
                                          queue:(dispatch_queue_t)queue {
     return RLMAddNotificationBlock(self, block, keyPaths, queue);
 }
+
+- (RLMNotificationToken *)addNotificationBlock:(void (^)(RLMArray *, RLMCollectionChange *, NSError *))block
+                                      keyPaths:(NSArray<NSString *> *)keyPaths
+                                         queue:(dispatch_queue_t)queue
+                               minimumInterval:(NSTimeInterval)minimumInterval {
+    return RLMAddNotificationBlock(self, block, keyPaths, queue, minimumInterval);
+}
 #pragma clang diagnostic pop
 
 realm::List& RLMGetBackingCollection(RLMManagedArray *self) {
@@ -36,6 +36,10 @@
 #import <realm/object-store/shared_realm.hpp>
 #import <realm/table_view.hpp>
 
+#import <deque>
+#import <mutex>
+#import <unordered_set>
+
 @interface RLMManagedDictionary () <RLMThreadConfined_Private> {
     @public
     realm::object_store::Dictionary _backingCollection;
@@ -141,6 +145,71 @@ static NSArray *toArray(std::vector<realm::Mixed> const& v) {
 @implementation RLMManagedCollectionHandoverMetadata
 @end
 
+// The keys or values of a managed dictionary. The values are read from the
+// dictionary when the array is created, but other than links are only
+// converted to obj-c objects the first time each is accessed, as allKeys and
+// allValues are often only used to get the count or a few elements of a large
+// dictionary. Links are resolved up front so that the array holds accessors
+// which are invalidated rather than dangling keys if the objects are deleted.
+// Converting the other values doesn't touch the Realm, so the array can be
+// read from any thread, which frozen dictionaries rely on.
+@interface RLMDictionaryContentsArray : NSArray
+@end
+
+@implementation RLMDictionaryContentsArray {
+    std::vector<realm::Mixed> _values;
+    // Copies of the string and binary values, which would otherwise point into
+    // the Realm file. A deque doesn't move its elements when it grows, so the
+    // Mixed values can point at them.
+    std::deque<std::string> _buffers;
+    // Guards the lazy conversions in _objects
+    std::mutex _mutex;
+    std::vector<id> _objects;
+}
+
+- (instancetype)initWithResults:(realm::Results&&)results info:(RLMClassInfo&)info {
+    if ((self = [super init])) {
+        size_t size = results.size();
+        _values.reserve(size);
+        _objects.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            realm::Mixed value = results.get_any(i);
+            auto type = value.is_null() ? std::nullopt : std::optional(value.get_type());
+            if (type == realm::type_String) {
+                auto& buffer = _buffers.emplace_back(value.get_string());
+                value = realm::StringData(buffer);
+            }
+            else if (type == realm::type_Binary) {
+                auto binary = value.get_binary();
+                auto& buffer = _buffers.emplace_back(binary.data(), binary.size());
+                value = realm::BinaryData(buffer.data(), buffer.size());
+            }
+            else if (type == realm::type_Link || type == realm::type_TypedLink) {
+                _objects[i] = RLMMixedToObjc(value, info.realm, &info);
+            }
+            _values.push_back(value);
+        }
+    }
+    return self;
+}
+
+- (NSUInteger)count {
+    return _values.size();
+}
+
+- (id)objectAtIndex:(NSUInteger)index {
+    if (index >= _values.size()) {
+        @throw RLMException(@"Index %llu is out of bounds (must be less than %llu).",
+                            (unsigned long long)index, (unsigned long long)_values.size());
+    }
+    std::lock_guard lock(_mutex);
+    if (!_objects[index]) {
+        _objects[index] = RLMMixedToObjc(_values[index], nil, nullptr);
+    }
+    return _objects[index];
+}
+@end
+
 @implementation RLMManagedDictionary {
 @public
     RLMRealm *_realm;
@@ -293,24 +362,17 @@ static void changeDictionary(__unsafe_unretained RLMManagedDictionary *const dic
     });
 }
 
-static NSMutableArray *resultsToArray(RLMClassInfo& info, realm::Results r) {
-    RLMAccessorContext c(info);
-    NSMutableArray *array = [NSMutableArray arrayWithCapacity:r.size()];
-    for (size_t i = 0, size = r.size(); i < size; ++i) {
-        [array addObject:r.get(c, i)];
-    }
-    return array;
-}
-
 - (NSArray *)allKeys {
     return translateErrors([&] {
-        return resultsToArray(*_objectInfo, _backingCollection.get_keys());
+        return [[RLMDictionaryContentsArray alloc] initWithResults:_backingCollection.get_keys()
+                                                              info:*_objectInfo];
     });
 }
 
 - (NSArray *)allValues {
     return translateErrors([&] {
-        return resultsToArray(*_objectInfo, _backingCollection.get_values());
+        return [[RLMDictionaryContentsArray alloc] initWithResults:_backingCollection.get_values()
+                                                              info:*_objectInfo];
     });
 }
 
@@ -380,6 +442,18 @@ static NSMutableArray *resultsToArray(RLMClassInfo& info, realm::Results r) {
     });
 }
 
+- (void)getMixedKeys:(RLMMixedValue *)keys values:(RLMMixedValue *)values count:(NSUInteger)count {
+    RLMDictionaryValidateBulkRead(self, count);
+    translateErrors([&] {
+        NSUInteger i = 0;
+        for (auto&& [key, value] : _backingCollection) {
+            keys[i] = RLMMixedValueFromMixed(key);
+            values[i] = RLMMixedValueFromMixed(value);
+            ++i;
+        }
+    });
+}
+
 - (void)enumerateKeysAndObjectsUsingBlock:(void (^)(id key, id obj, BOOL *stop))block {
     RLMAccessorContext c(*_objectInfo);
     BOOL stop = false;
@@ -393,6 +467,64 @@ static NSMutableArray *resultsToArray(RLMClassInfo& info, realm::Results r) {
     }
 }
 
+// Check if the existing value for a key is exactly the given primitive value,
+// in which case writing it again can be skipped. Objects are always written as
+// assigning an object can have side effects such as updating embedded objects.
+static bool RLMDictionaryValueUnchanged(__unsafe_unretained RLMManagedDictionary *const dict,
+                                        std::string const& key, __unsafe_unretained id const value) {
+    if (dict.type == RLMPropertyTypeObject || [value isKindOfClass:[RLMObjectBase class]]) {
+        return false;
+    }
+    auto existing = dict->_backingCollection.try_get_any(key);
+    if (!existing) {
+        return false;
+    }
+    auto newValue = RLMObjcToMixed(value);
+    if (existing->is_null() || newValue.is_null()) {
+        return existing->is_null() && newValue.is_null();
+    }
+    return existing->get_type() == newValue.get_type() && *existing == newValue;
+}
+
+static void assignDictionary(__unsafe_unretained RLMManagedDictionary *const dict,
+                             RLMAccessorContext& c, __unsafe_unretained id const dictionary, bool clear) {
+    // Validate and convert all of the keys up front so that they can be
+    // compared against the existing keys without going back to NSString
+    std::vector<std::pair<std::string, id>> entries;
+    entries.reserve([dictionary count]);
+    [dictionary enumerateKeysAndObjectsUsingBlock:[&](id key, id value, BOOL *) {
+        realm::StringData k = c.unbox<realm::StringData>(RLMDictionaryKey(dict, key));
+        entries.emplace_back(std::string(k.data(), k.size()), RLMDictionaryValue(dict, value));
+    }];
+
+    if (clear) {
+        // Rather than clearing the dictionary and reinserting everything,
+        // only remove the keys which aren't in the new dictionary
+        std::unordered_set<realm::StringData> newKeys;
+        newKeys.reserve(entries.size());
+        for (auto& entry : entries) {
+            newKeys.insert(entry.first);
+        }
+        std::vector<std::string> removed;
+        for (auto&& [key, value] : dict->_backingCollection) {
+            auto str = key.get_string();
+            if (!newKeys.count(str)) {
+                removed.emplace_back(str);
+            }
+        }
+        for (auto& key : removed) {
+            dict->_backingCollection.erase(key);
+        }
+    }
+
+    for (auto& [key, value] : entries) {
+        if (RLMDictionaryValueUnchanged(dict, key, value)) {
+            continue;
+        }
+        dict->_backingCollection.insert(c, key, value);
+    }
+}
+
 - (void)mergeDictionary:(id)dictionary clear:(bool)clear {
     if (!clear && !dictionary) {
         return;
@@ -405,13 +537,25 @@ static NSMutableArray *resultsToArray(RLMClassInfo& info, realm::Results r) {
 
     changeDictionary(self, ^{
         RLMAccessorContext c(*_objectInfo);
-        if (clear) {
+        // Assigning a dictionary to itself clears it, as the old contents are
+        // removed before the new ones are read
+        if (!dictionary || (clear && dictionary == self)) {
             _backingCollection.remove_all();
+            return;
+        }
+        if (clear) {
+            // A failed assignment leaves the dictionary empty rather than
+            // partially updated
+            try {
+                assignDictionary(self, c, dictionary, clear);
+            }
+            catch (...) {
+                _backingCollection.remove_all();
+                throw;
+            }
+            return;
         }
-        [dictionary enumerateKeysAndObjectsUsingBlock:[&](id key, id value, BOOL *) {
-            _backingCollection.insert(c, c.unbox<realm::StringData>(RLMDictionaryKey(self, key)),
-                                      RLMDictionaryValue(self, value));
-        }];
+        assignDictionary(self, c, dictionary, clear);
     });
 }
 
@@ -497,7 +641,7 @@ static NSMutableArray *resultsToArray(RLMClassInfo& info, realm::Results r) {
 - (RLMResults *)sortedResultsUsingDescriptors:(NSArray<RLMSortDescriptor *> *)properties {
     return translateErrors([&] {
         return [RLMResults resultsWithObjectInfo:*_objectInfo
-                                         results:_backingCollection.as_results().sort(RLMSortDescriptorsToKeypathArray(properties))];
+                                         results:RLMSortResults(_backingCollection.as_results(), _objectInfo, properties)];
     });
 }
 
@@ -516,7 +660,7 @@ static NSMutableArray *resultsToArray(RLMClassInfo& info, realm::Results r) {
     if (_type != RLMPropertyTypeObject) {
         @throw RLMException(@"Querying is currently only implemented for dictionaries of Realm Objects");
     }
-    auto query = RLMPredicateToQuery(predicate, _objectInfo->rlmObjectSchema, _realm.schema, _realm.group);
+    auto query = RLMPredicateToQuery(predicate, *_objectInfo);
     auto results = translateErrors([&] {
         return _backingCollection.as_results().filter(std::move(query));
     });
@@ -640,12 +784,16 @@ static RLMNotificationToken *RLMAddNotificationBlock(RLMManagedDictionary *colle
     if (!queue) {
         [realm verifyNotificationsAreSupported:true];
         token->_realm = realm;
-        token->_token = RLMGetBackingCollection(collection).add_key_based_notification_callback(DictionaryCallbackWrapper{block, collection}, std::move(keyPathArray));
+        token->_register = [=] {
+            return RLMGetBackingCollection(collection).add_key_based_notification_callback(DictionaryCallbackWrapper{block, collection}, keyPathArray);
+        };
+        token->_token = token->_register();
         return token;
     }
 
     RLMThreadSafeReference *tsr = [RLMThreadSafeReference referenceWithThreadConfined:collection];
     token->_realm = realm;
+    token->_queue = queue;
     RLMRealmConfiguration *config = realm.configuration;
     dispatch_async(queue, ^{
         std::lock_guard<std::mutex> lock(token->_mutex);
@@ -659,7 +807,12 @@ static RLMNotificationToken *RLMAddNotificationBlock(RLMManagedDictionary *colle
             return;
         }
         RLMManagedDictionary *collection = [realm resolveThreadSafeReference:tsr];
-        token->_token = RLMGetBackingCollection(collection).add_key_based_notification_callback(DictionaryCallbackWrapper{block, collection}, std::move(keyPathArray));
+        token->_register = [=] {
+            return RLMGetBackingCollection(collection).add_key_based_notification_callback(DictionaryCallbackWrapper{block, collection}, keyPathArray);
+        };
+        if (!token->_paused) {
+            token->_token = token->_register();
+        }
     });
     return token;
 }
@@ -318,14 +318,74 @@ static void ensureInWriteTransaction(NSString *message, RLMManagedSet *set, RLMM
     return managedSet;
 }
 
+// Unmanaged operands for the set algebra functions are checked for being the
+// correct type up front, after which each value is looked up in the sorted
+// backing set directly rather than creating accessors for the managed values
+- (void)validateUnmanagedSet:(RLMSet *)set {
+    if (_type != set.type) {
+        @throw RLMException(@"Cannot intersect sets of type '%@' and '%@'.",
+                            RLMTypeToString(_type), RLMTypeToString(set.type));
+    }
+    if (_type == RLMPropertyTypeObject && ![_objectInfo->rlmObjectSchema.className isEqualToString:set.objectClassName]) {
+        @throw RLMException(@"Cannot intersect sets of type '%@' and '%@'.",
+                            _objectInfo->rlmObjectSchema.className, set.objectClassName);
+    }
+}
+
+// Objects which are unmanaged or belong to a different Realm can never be
+// members of this set and can't be looked up in it
+static bool RLMCanBeMember(__unsafe_unretained RLMManagedSet *const set, __unsafe_unretained id const value) {
+    auto obj = RLMDynamicCast<RLMObjectBase>(value);
+    return !obj || (obj->_realm == set->_realm && obj->_row.is_valid());
+}
+
+static size_t RLMFindInSet(__unsafe_unretained RLMManagedSet *const set, RLMAccessorContext& context,
+                           __unsafe_unretained id const value) {
+    if (!RLMCanBeMember(set, value)) {
+        return realm::npos;
+    }
+    return set->_backingSet.find(context, value);
+}
+
 - (BOOL)isSubsetOfSet:(RLMSet<id> *)set {
-    RLMManagedSet *rhs = [self managedObjectFrom:set];
-    return _backingSet.is_subset_of(rhs->_backingSet);
+    if ([set isKindOfClass:[RLMManagedSet class]]) {
+        RLMManagedSet *rhs = [self managedObjectFrom:set];
+        return _backingSet.is_subset_of(rhs->_backingSet);
+    }
+    [self validateUnmanagedSet:set];
+    return translateErrors([&] {
+        size_t count = _backingSet.size();
+        if (count > set.count) {
+            return false;
+        }
+        // The operand can't contain duplicates, so every member of this set
+        // was found if the number of matches is equal to our size
+        RLMAccessorContext context(*_objectInfo);
+        size_t found = 0;
+        for (id obj in set) {
+            if (RLMFindInSet(self, context, obj) != realm::npos) {
+                ++found;
+            }
+        }
+        return found == count;
+    });
 }
 
 - (BOOL)intersectsSet:(RLMSet<id> *)set {
-    RLMManagedSet *rhs = [self managedObjectFrom:set];
-    return _backingSet.intersects(rhs->_backingSet);
+    if ([set isKindOfClass:[RLMManagedSet class]]) {
+        RLMManagedSet *rhs = [self managedObjectFrom:set];
+        return _backingSet.intersects(rhs->_backingSet);
+    }
+    [self validateUnmanagedSet:set];
+    return translateErrors([&] {
+        RLMAccessorContext context(*_objectInfo);
+        for (id obj in set) {
+            if (RLMFindInSet(self, context, obj) != realm::npos) {
+                return true;
+            }
+        }
+        return false;
+    });
 }
 
 - (BOOL)containsObject:(id)obj {
@@ -350,26 +410,68 @@ static void ensureInWriteTransaction(NSString *message, RLMManagedSet *set, RLMM
 }
 
 - (void)intersectSet:(RLMSet<id> *)set {
-    RLMManagedSet *rhs = [self managedObjectFrom:set];
-    ensureInWriteTransaction(@"[RLMSet intersectSet:]", self, rhs);
+    if ([set isKindOfClass:[RLMManagedSet class]]) {
+        RLMManagedSet *rhs = [self managedObjectFrom:set];
+        ensureInWriteTransaction(@"[RLMSet intersectSet:]", self, rhs);
+        changeSet(self, ^{
+            _backingSet.assign_intersection(rhs->_backingSet);
+        });
+        return;
+    }
+    [self validateUnmanagedSet:set];
+    ensureInWriteTransaction(@"[RLMSet intersectSet:]", self, nil);
     changeSet(self, ^{
-        _backingSet.assign_intersection(rhs->_backingSet);
+        // Mark the members which are also in the operand, then remove the
+        // unmarked ones from the back so that the indexes of the remaining
+        // values are unaffected
+        RLMAccessorContext context(*_objectInfo);
+        std::vector<bool> keep(_backingSet.size());
+        for (id obj in set) {
+            size_t index = RLMFindInSet(self, context, obj);
+            if (index != realm::npos) {
+                keep[index] = true;
+            }
+        }
+        for (size_t i = keep.size(); i > 0; --i) {
+            if (!keep[i - 1]) {
+                _backingSet.remove_any(_backingSet.get_any(i - 1));
+            }
+        }
     });
 }
 
 - (void)unionSet:(RLMSet<id> *)set {
-    RLMManagedSet *rhs = [self managedObjectFrom:set];
-    ensureInWriteTransaction(@"[RLMSet unionSet:]", self, rhs);
-    changeSet(self, ^{
-        _backingSet.assign_union(rhs->_backingSet);
-    });
+    if ([set isKindOfClass:[RLMManagedSet class]]) {
+        RLMManagedSet *rhs = [self managedObjectFrom:set];
+        ensureInWriteTransaction(@"[RLMSet unionSet:]", self, rhs);
+        changeSet(self, ^{
+            _backingSet.assign_union(rhs->_backingSet);
+        });
+        return;
+    }
+    [self validateUnmanagedSet:set];
+    ensureInWriteTransaction(@"[RLMSet unionSet:]", self, nil);
+    [self addObjects:set];
 }
 
 - (void)minusSet:(RLMSet<id> *)set {
-    RLMManagedSet *rhs = [self managedObjectFrom:set];
-    ensureInWriteTransaction(@"[RLMSet minusSet:]", self, rhs);
+    if ([set isKindOfClass:[RLMManagedSet class]]) {
+        RLMManagedSet *rhs = [self managedObjectFrom:set];
+        ensureInWriteTransaction(@"[RLMSet minusSet:]", self, rhs);
+        changeSet(self, ^{
+            _backingSet.assign_difference(rhs->_backingSet);
+        });
+        return;
+    }
+    [self validateUnmanagedSet:set];
+    ensureInWriteTransaction(@"[RLMSet minusSet:]", self, nil);
     changeSet(self, ^{
-        _backingSet.assign_difference(rhs->_backingSet);
+        RLMAccessorContext context(*_objectInfo);
+        for (id obj in set) {
+            if (RLMCanBeMember(self, obj)) {
+                _backingSet.remove(context, obj);
+            }
+        }
     });
 }
 
@@ -463,7 +565,7 @@ static void ensureInWriteTransaction(NSString *message, RLMManagedSet *set, RLMM
 - (RLMResults *)sortedResultsUsingDescriptors:(NSArray<RLMSortDescriptor *> *)properties {
     return translateErrors([&] {
         return [RLMResults  resultsWithObjectInfo:*_objectInfo
-                                          results:_backingSet.sort(RLMSortDescriptorsToKeypathArray(properties))];
+                                          results:RLMSortResults(_backingSet.as_results(), _objectInfo, properties)];
     });
 }
 
@@ -478,7 +580,7 @@ static void ensureInWriteTransaction(NSString *message, RLMManagedSet *set, RLMM
     if (_type != RLMPropertyTypeObject) {
         @throw RLMException(@"Querying is currently only implemented for sets of Realm Objects");
     }
-    auto query = RLMPredicateToQuery(predicate, _objectInfo->rlmObjectSchema, _realm.schema, _realm.group);
+    auto query = RLMPredicateToQuery(predicate, *_objectInfo);
     auto results = translateErrors([&] { return _backingSet.filter(std::move(query)); });
     return [RLMResults resultsWithObjectInfo:*_objectInfo results:std::move(results)];
 }
@@ -548,6 +650,13 @@ static void ensureInWriteTransaction(NSString *message, RLMManagedSet *set, RLMM
     return RLMAddNotificationBlock(self, block, keyPaths, queue);
 }
 
+- (RLMNotificationToken *)addNotificationBlock:(void (^)(RLMSet *, RLMCollectionChange *, NSError *))block
+                                      keyPaths:(nullable NSArray<NSString *> *)keyPaths
+                                         queue:(nullable dispatch_queue_t)queue
+                               minimumInterval:(NSTimeInterval)minimumInterval {
+    return RLMAddNotificationBlock(self, block, keyPaths, queue, minimumInterval);
+}
+
 - (RLMNotificationToken *)addNotificationBlock:(void (^)(RLMSet *, RLMCollectionChange *, NSError *))block
                                       keyPaths:(nullable NSArray<NSString *> *)keyPaths {
     return RLMAddNotificationBlock(self, block, keyPaths, nil);
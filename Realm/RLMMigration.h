@@ -16,7 +16,7 @@
 //
 ////////////////////////////////////////////////////////////////////////////
 
-#import <Foundation/Foundation.h>
+#import <Realm/RLMConstants.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -35,6 +35,17 @@ NS_ASSUME_NONNULL_BEGIN
 */
 typedef void (^RLMObjectMigrationBlock)(RLMObject * __nullable oldObject, RLMObject * __nullable newObject);
 
+/**
+ A block type which converts a single property value from the original Realm into the value
+ to store in the migrated Realm.
+
+ @see `-[RLMMigration transformValuesOfClass:fromProperty:toProperty:block:]`
+
+ @param oldValue The value of the property in the original Realm, or `nil` if it was `nil`.
+ @return The value to store in the migrated Realm.
+ */
+typedef id __nullable (^RLMPropertyMigrationBlock)(id __nullable oldValue);
+
 /**
  `RLMMigration` instances encapsulate information intended to facilitate a schema migration.
 
@@ -73,6 +84,74 @@ typedef void (^RLMObjectMigrationBlock)(RLMObject * __nullable oldObject, RLMObj
  */
 - (void)enumerateObjects:(NSString *)className block:(__attribute__((noescape)) RLMObjectMigrationBlock)block;
 
+/**
+ Copies the value of a property for every object of a given type in the Realm, optionally
+ converting each value with the given block.
+
+ This operates on the underlying columns directly rather than creating an object for each
+ row, and so is much faster than using `-enumerateObjects:block:` to copy or convert the values
+ of a single property for a large number of objects. `oldPropertyName` and `newPropertyName`
+ may be the same to transform the values of a property whose type has not changed.
+
+ Link and collection properties are not supported.
+
+ @param className       The name of the `RLMObject` class whose property should be transformed.
+                        This class must be present in both the old and new Realm schemas.
+ @param oldPropertyName The name of the property in the old Realm schema to read values from.
+ @param newPropertyName The name of the property in the new Realm schema to write values to.
+ @param block           A block which converts each old value to the new value. If `nil`, values
+                        are copied as-is, which requires both properties to be of the same type.
+ */
+- (void)transformValuesOfClass:(NSString *)className
+                  fromProperty:(NSString *)oldPropertyName
+                    toProperty:(NSString *)newPropertyName
+                         block:(nullable __attribute__((noescape)) RLMPropertyMigrationBlock)block;
+
+/**
+ Copies the value of a property for every object of a given type in the Realm to another property.
+
+ This is equivalent to calling `-transformValuesOfClass:fromProperty:toProperty:block:` with a
+ `nil` block, and so requires both properties to be of the same type.
+
+ @param oldPropertyName The name of the property in the old Realm schema to read values from.
+ @param newPropertyName The name of the property in the new Realm schema to write values to.
+ @param className       The name of the `RLMObject` class whose property should be copied.
+                        This class must be present in both the old and new Realm schemas.
+ */
+- (void)copyProperty:(NSString *)oldPropertyName toProperty:(NSString *)newPropertyName ofClass:(NSString *)className
+NS_SWIFT_NAME(copyProperty(_:to:ofClass:));
+
+/**
+ Converts the values of a property whose type has changed between the old and new Realm schemas.
+
+ If `block` is `nil`, the values are converted in the underlying columns without creating any
+ objects. The following conversions are supported without a block:
+
+ - `int` to `decimal128` or `string`
+ - `bool` to `int` or `string`
+ - `float` to `double`
+ - `string` to `int`, `double`, `object id` or `uuid`, which throws if a value cannot be parsed
+ - `object id`, `uuid` and `decimal128` to `string`
+ - any type to `mixed`
+
+ `nil` values are preserved, and throw if the property is not optional in the new schema.
+ Other conversions require a block. This includes `int` to `float` or `double` and `double` to
+ `decimal128`, which can round values, so that any loss of precision is explicit.
+
+ @param propertyName The name of the property to convert, which must be present in both the
+                     old and new Realm schemas.
+ @param className    The name of the `RLMObject` class whose property should be converted.
+ @param type         The type of the property in the new Realm schema. An exception is thrown if
+                     this does not match the new schema.
+ @param block        A block which converts each old value to the new value, or `nil` to use
+                     the built-in conversion.
+ */
+- (void)convertProperty:(NSString *)propertyName
+                ofClass:(NSString *)className
+                 toType:(RLMPropertyType)type
+                  using:(nullable __attribute__((noescape)) RLMPropertyMigrationBlock)block
+NS_SWIFT_NAME(convertProperty(_:ofClass:to:using:));
+
 /**
  Creates and returns an `RLMObject` instance of type `className` in the Realm being migrated.
 
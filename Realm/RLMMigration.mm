@@ -19,6 +19,7 @@
 #import "RLMMigration_Private.h"
 
 #import "RLMAccessor.h"
+#import "RLMAccessor.hpp"
 #import "RLMObject_Private.h"
 #import "RLMObject_Private.hpp"
 #import "RLMObjectSchema_Private.hpp"
@@ -53,6 +54,119 @@ using namespace realm;
 }
 @end
 
+namespace {
+// Built-in conversions used by convertProperty:ofClass:toType:using: when no
+// conversion block is given. These are the lossless (or, for strings, strictly
+// parsed) conversions; anything else requires a block. Int to float or double
+// and double to decimal128 are deliberately excluded as they can round values.
+bool RLMCanConvertType(RLMPropertyType from, RLMPropertyType to) {
+    if (from == to || to == RLMPropertyTypeAny) {
+        return true;
+    }
+    switch (from) {
+        case RLMPropertyTypeInt:
+            return to == RLMPropertyTypeDecimal128 || to == RLMPropertyTypeString;
+        case RLMPropertyTypeBool:
+            return to == RLMPropertyTypeInt || to == RLMPropertyTypeString;
+        case RLMPropertyTypeFloat:
+            return to == RLMPropertyTypeDouble;
+        case RLMPropertyTypeString:
+            return to == RLMPropertyTypeInt || to == RLMPropertyTypeDouble
+                || to == RLMPropertyTypeObjectId || to == RLMPropertyTypeUUID;
+        case RLMPropertyTypeObjectId:
+        case RLMPropertyTypeUUID:
+        case RLMPropertyTypeDecimal128:
+            return to == RLMPropertyTypeString;
+        default:
+            return false;
+    }
+}
+
+// Converts a non-null value to the given type, storing converted strings in
+// `buffer`. Returns none if the value is a string which can't be parsed.
+util::Optional<Mixed> RLMConvertMixed(Mixed value, RLMPropertyType to, std::string& buffer) {
+    auto from = value.get_type();
+    switch (to) {
+        case RLMPropertyTypeInt:
+            if (from == type_Bool) {
+                return Mixed(int64_t(value.get_bool()));
+            }
+            if (from == type_String) {
+                buffer = value.get_string();
+                char *end;
+                errno = 0;
+                long long i = strtoll(buffer.c_str(), &end, 10);
+                if (buffer.empty() || *end || errno) {
+                    return util::none;
+                }
+                return Mixed(int64_t(i));
+            }
+            break;
+        case RLMPropertyTypeDouble:
+            if (from == type_Float) {
+                return Mixed(double(value.get_float()));
+            }
+            if (from == type_String) {
+                buffer = value.get_string();
+                char *end;
+                errno = 0;
+                double d = strtod(buffer.c_str(), &end);
+                if (buffer.empty() || *end || errno) {
+                    return util::none;
+                }
+                return Mixed(d);
+            }
+            break;
+        case RLMPropertyTypeDecimal128:
+            if (from == type_Int) {
+                return Mixed(Decimal128(value.get_int()));
+            }
+            break;
+        case RLMPropertyTypeString:
+            if (from == type_Int) {
+                buffer = std::to_string(value.get_int());
+            }
+            else if (from == type_Bool) {
+                buffer = value.get_bool() ? "true" : "false";
+            }
+            else if (from == type_ObjectId) {
+                buffer = value.get_object_id().to_string();
+            }
+            else if (from == type_UUID) {
+                buffer = value.get_uuid().to_string();
+            }
+            else if (from == type_Decimal) {
+                buffer = value.get_decimal().to_string();
+            }
+            else {
+                break;
+            }
+            return Mixed(StringData(buffer));
+        case RLMPropertyTypeObjectId:
+            if (from == type_String) {
+                if (!ObjectId::is_valid_str(value.get_string())) {
+                    return util::none;
+                }
+                buffer = value.get_string();
+                return Mixed(ObjectId(buffer.c_str()));
+            }
+            break;
+        case RLMPropertyTypeUUID:
+            if (from == type_String) {
+                if (!UUID::is_valid_string(value.get_string())) {
+                    return util::none;
+                }
+                return Mixed(UUID(value.get_string()));
+            }
+            break;
+        default:
+            break;
+    }
+    // Same type or a conversion to mixed
+    return value;
+}
+} // anonymous namespace
+
 @implementation RLMMigration {
     realm::Schema *_schema;
 }
@@ -80,15 +194,33 @@ using namespace realm;
     RLMResults *objects = [_realm.schema schemaForClassName:className] ? [_realm allObjects:className] : nil;
     RLMResults *oldObjects = [_oldRealm.schema schemaForClassName:className] ? [_oldRealm allObjects:className] : nil;
 
+    // Progress is reported roughly once per percent so that large tables
+    // don't flood the progress block's queue
+    RLMMigrationProgressBlock progress = _progressBlock;
+    NSUInteger total = 0, enumerated = 0, interval = 1;
+    auto startProgress = [&](RLMResults *enumerating) {
+        if (progress) {
+            total = enumerating.count;
+            interval = std::max<NSUInteger>(total / 100, 1);
+        }
+    };
+    auto reportProgress = [&] {
+        if (progress && (++enumerated % interval == 0 || enumerated == total)) {
+            progress(className, enumerated, total);
+        }
+    };
+
     // For whatever reason if this is a newly added table we enumerate the
     // objects in it, while in all other cases we enumerate only the existing
     // objects. It's unclear how this could be useful, but changing it would
     // also be a pointless breaking change and it's unlikely to be hurting anyone.
     if (objects && !oldObjects) {
+        startProgress(objects);
         for (RLMObject *object in objects) {
             @autoreleasepool {
                 block(nil, object);
             }
+            reportProgress();
         }
         return;
     }
@@ -96,10 +228,12 @@ using namespace realm;
     // If a table will be deleted it can still be enumerated during the migration
     // so that data can be saved or transfered to other tables if necessary.
     if (!objects && oldObjects) {
+        startProgress(oldObjects);
         for (RLMObject *oldObject in oldObjects) {
             @autoreleasepool {
                 block(oldObject, nil);
             }
+            reportProgress();
         }
         return;
     }
@@ -109,6 +243,7 @@ using namespace realm;
     }
 
     auto& info = _realm->_info[className];
+    startProgress(oldObjects);
     for (RLMObject *oldObject in oldObjects) {
         @autoreleasepool {
             Obj newObj;
@@ -116,11 +251,163 @@ using namespace realm;
                 newObj = info.table()->get_object(oldObject->_row.get_key());
             }
             catch (KeyNotFound const&) {
+                reportProgress();
                 continue;
             }
             block(oldObject, (id)RLMCreateObjectAccessor(info, std::move(newObj)));
         }
+        reportProgress();
+    }
+}
+
+// Looks up the old and new versions of a property which is to have its values
+// transformed, validating that both exist and are of a transformable type
+- (void)transformedPropertiesOfClass:(NSString *)className
+                        fromProperty:(NSString *)oldPropertyName
+                          toProperty:(NSString *)newPropertyName
+                             oldProp:(RLMProperty **)outOldProp
+                             newProp:(RLMProperty **)outNewProp {
+    RLMObjectSchema *oldObjectSchema = [_oldRealm.schema schemaForClassName:className];
+    RLMObjectSchema *newObjectSchema = [_realm.schema schemaForClassName:className];
+    if (!oldObjectSchema || !newObjectSchema) {
+        @throw RLMException(@"Class '%@' must be present in both the old and new schemas to transform its properties.", className);
+    }
+    RLMProperty *oldProp = oldObjectSchema[oldPropertyName];
+    if (!oldProp) {
+        @throw RLMException(@"Property '%@' not found in the old schema of class '%@'.", oldPropertyName, className);
+    }
+    RLMProperty *newProp = newObjectSchema[newPropertyName];
+    if (!newProp) {
+        @throw RLMException(@"Property '%@' not found in the new schema of class '%@'.", newPropertyName, className);
+    }
+    for (RLMProperty *prop in @[oldProp, newProp]) {
+        if (prop.collection || prop.type == RLMPropertyTypeObject || prop.type == RLMPropertyTypeLinkingObjects) {
+            @throw RLMException(@"Cannot transform the values of property '%@.%@': link and collection properties are not supported.",
+                                className, prop.name);
+        }
+    }
+    *outOldProp = oldProp;
+    *outNewProp = newProp;
+}
+
+- (void)transformValuesOfClass:(NSString *)className
+                  fromProperty:(NSString *)oldPropertyName
+                    toProperty:(NSString *)newPropertyName
+                         block:(__attribute__((noescape)) RLMPropertyMigrationBlock)block {
+    RLMProperty *oldProp, *newProp;
+    [self transformedPropertiesOfClass:className fromProperty:oldPropertyName toProperty:newPropertyName
+                               oldProp:&oldProp newProp:&newProp];
+    RLMObjectSchema *newObjectSchema = [_realm.schema schemaForClassName:className];
+    if (!block && (oldProp.type != newProp.type || (oldProp.optional && !newProp.optional))) {
+        @throw RLMException(@"Cannot copy values of property '%@.%@' of type '%@' to property '%@' of type '%@' without a conversion block.",
+                            className, oldPropertyName, RLMTypeToString(oldProp.type), newPropertyName, RLMTypeToString(newProp.type));
+    }
+
+    auto& oldInfo = _oldRealm->_info[className];
+    auto& newInfo = _realm->_info[className];
+    TableRef oldTable = oldInfo.table();
+    TableRef newTable = newInfo.table();
+    ColKey oldCol = oldInfo.tableColumn(oldProp);
+    ColKey newCol = newInfo.tableColumn(newProp);
+
+    if (!block) {
+        RLMTranslateError([&] {
+            for (auto oldObj : *oldTable) {
+                if (auto newObj = newTable->try_get_object(oldObj.get_key())) {
+                    newObj.set_any(newCol, oldObj.get_any(oldCol));
+                }
+            }
+        });
+        return;
+    }
+
+    RLMStatelessAccessorContext ctx;
+    auto toMixed = [&](__unsafe_unretained id const value) -> Mixed {
+        if (!value) {
+            return Mixed();
+        }
+        return switch_on_type(static_cast<realm::PropertyType>(newProp.type), realm::util::overload{
+            [&](realm::Obj*) -> Mixed { REALM_UNREACHABLE(); },
+            [&](realm::Mixed*) { return RLMObjcToMixed(value, _realm); },
+            [&](auto t) { return Mixed(ctx.unbox<std::decay_t<decltype(*t)>>(value)); }});
+    };
+
+    RLMTranslateError([&] {
+        for (auto oldObj : *oldTable) {
+            auto newObj = newTable->try_get_object(oldObj.get_key());
+            if (!newObj) {
+                continue;
+            }
+            @autoreleasepool {
+                id oldValue = RLMCoerceToNil(RLMMixedToObjc(oldObj.get_any(oldCol), _oldRealm, &oldInfo));
+                id newValue = RLMCoerceToNil(block(oldValue));
+                if (!RLMIsObjectValidForProperty(newValue, newProp)) {
+                    RLMThrowTypeError(newValue, newObjectSchema, newProp);
+                }
+                newObj.set_any(newCol, toMixed(newValue));
+            }
+        }
+    });
+}
+
+- (void)copyProperty:(NSString *)oldPropertyName toProperty:(NSString *)newPropertyName ofClass:(NSString *)className {
+    [self transformValuesOfClass:className fromProperty:oldPropertyName toProperty:newPropertyName block:nil];
+}
+
+- (void)convertProperty:(NSString *)propertyName
+                ofClass:(NSString *)className
+                 toType:(RLMPropertyType)type
+                  using:(__attribute__((noescape)) RLMPropertyMigrationBlock)block {
+    RLMProperty *oldProp, *newProp;
+    [self transformedPropertiesOfClass:className fromProperty:propertyName toProperty:propertyName
+                               oldProp:&oldProp newProp:&newProp];
+    if (newProp.type != type) {
+        @throw RLMException(@"Cannot convert property '%@.%@' to '%@': the property is of type '%@' in the new schema.",
+                            className, propertyName, RLMTypeToString(type), RLMTypeToString(newProp.type));
     }
+    if (block) {
+        [self transformValuesOfClass:className fromProperty:propertyName toProperty:propertyName block:block];
+        return;
+    }
+    if (!RLMCanConvertType(oldProp.type, newProp.type)) {
+        @throw RLMException(@"Cannot convert property '%@.%@' from '%@' to '%@' without a conversion block.",
+                            className, propertyName, RLMTypeToString(oldProp.type), RLMTypeToString(newProp.type));
+    }
+
+    auto& oldInfo = _oldRealm->_info[className];
+    auto& newInfo = _realm->_info[className];
+    TableRef oldTable = oldInfo.table();
+    TableRef newTable = newInfo.table();
+    ColKey oldCol = oldInfo.tableColumn(oldProp);
+    ColKey newCol = newInfo.tableColumn(newProp);
+    bool nullable = newProp.optional;
+
+    std::string buffer;
+    RLMTranslateError([&] {
+        for (auto oldObj : *oldTable) {
+            auto newObj = newTable->try_get_object(oldObj.get_key());
+            if (!newObj) {
+                continue;
+            }
+            Mixed oldValue = oldObj.get_any(oldCol);
+            if (oldValue.is_null()) {
+                if (!nullable) {
+                    @throw RLMException(@"Cannot convert nil value of property '%@.%@' to non-optional '%@'.",
+                                        className, propertyName, RLMTypeToString(type));
+                }
+                newObj.set_null(newCol);
+                continue;
+            }
+            auto newValue = RLMConvertMixed(oldValue, type, buffer);
+            if (!newValue) {
+                // Only parsing strings can fail
+                @throw RLMException(@"Cannot convert value '%@' of property '%@.%@' to '%@'.",
+                                    RLMStringDataToNSString(oldValue.get_string()), className, propertyName,
+                                    RLMTypeToString(type));
+            }
+            newObj.set_any(newCol, *newValue);
+        }
+    });
 }
 
 - (void)execute:(RLMMigrationBlock)block {
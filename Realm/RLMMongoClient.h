@@ -20,7 +20,12 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
-@class RLMApp;
+@class RLMApp, RLMMongoCollection, RLMMongoWriteQueue;
+@protocol RLMBSON;
+
+/// Block which is called with the error for a queued write which the server
+/// rejected, and which has been removed from the queue.
+typedef void(^RLMMongoWriteQueueErrorBlock)(NSError *);
 
 /// The `RLMMongoClient` enables reading and writing on a MongoDB database via the Realm Cloud service.
 ///
@@ -41,6 +46,78 @@ NS_ASSUME_NONNULL_BEGIN
 /// @param name the name of the database to retrieve
 - (RLMMongoDatabase *)databaseWithName:(NSString *)name NS_SWIFT_NAME(database(named:));
 
+/// Gets the persistent write queue for this client and the user it belongs to,
+/// creating it if needed.
+///
+/// The queued operations are stored in a local Realm file alongside the user's
+/// synchronized Realms, so writes made while offline are sent once the server
+/// can be reached again, including after the app is relaunched.
+/// @param error If an error occurs opening the queue's Realm file, upon return
+///              contains an `NSError` object that describes the problem.
+/// @return The write queue, or `nil` if it could not be opened.
+- (nullable RLMMongoWriteQueue *)writeQueueWithError:(NSError **)error;
+
+@end
+
+/// A persistent queue of writes to MongoDB collections, which are saved locally
+/// and sent to the server in order.
+///
+/// Enqueued writes are saved to a local Realm before the method returns, and the
+/// queue then tries to send them. Consecutive inserts into the same collection are
+/// sent together with a single `insertMany` request. If a request fails because the
+/// server could not be reached, the queue waits and tries again, doubling the wait
+/// after each failure up to a minute. Call `-flush` to try again immediately, for
+/// example when the device's network connectivity changes.
+///
+/// Writes which the server rejects are removed from the queue and reported to
+/// `errorHandler`. Inserted documents without an `_id` are given a new `RLMObjectId`
+/// when they are enqueued, so an insert which is retried after a lost response is
+/// rejected as a duplicate rather than inserted twice.
+@interface RLMMongoWriteQueue : NSObject
+
+/// The number of writes which have not yet been sent to the server.
+@property (nonatomic, readonly) NSUInteger pendingOperationCount;
+
+/// The time in seconds which the most recent flush took, from when it started
+/// sending writes to when the queue was empty, including any retries. This is 0
+/// if the queue has not yet been emptied.
+@property (nonatomic, readonly) NSTimeInterval lastFlushDuration;
+
+/// A block called on a background queue with the error for each write which the
+/// server rejected.
+@property (nonatomic, copy, nullable) RLMMongoWriteQueueErrorBlock errorHandler;
+
+/// Enqueues inserting a document into a collection.
+/// @param document The document to insert.
+/// @param collection The collection to insert the document into.
+- (void)insertOneDocument:(NSDictionary<NSString *, id<RLMBSON>> *)document
+             inCollection:(RLMMongoCollection *)collection NS_REFINED_FOR_SWIFT;
+
+/// Enqueues updating the first document in a collection which matches a filter.
+/// @param filterDocument A document as bson that should match the query.
+/// @param updateDocument A document describing the update.
+/// @param upsert When true, creates a new document if no document matches the query.
+/// @param collection The collection to update.
+- (void)updateOneDocumentWhere:(NSDictionary<NSString *, id<RLMBSON>> *)filterDocument
+                updateDocument:(NSDictionary<NSString *, id<RLMBSON>> *)updateDocument
+                        upsert:(BOOL)upsert
+                  inCollection:(RLMMongoCollection *)collection NS_REFINED_FOR_SWIFT;
+
+/// Enqueues deleting the first document in a collection which matches a filter.
+/// @param filterDocument A document as bson that should match the query.
+/// @param collection The collection to delete from.
+- (void)deleteOneDocumentWhere:(NSDictionary<NSString *, id<RLMBSON>> *)filterDocument
+                  inCollection:(RLMMongoCollection *)collection NS_REFINED_FOR_SWIFT;
+
+/// Tries to send the pending writes immediately, rather than waiting until the next
+/// retry after a failure.
+- (void)flush;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("Use -[RLMMongoClient writeQueueWithError:].")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("Use -[RLMMongoClient writeQueueWithError:].")));
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -21,11 +21,25 @@
 #import "RLMMongoDatabase_Private.hpp"
 #import "RLMMongoCollection_Private.hpp"
 #import "RLMApp_Private.hpp"
+#import "RLMBSON_Private.hpp"
+#import "RLMObject.h"
+#import "RLMRealm.h"
+#import "RLMRealmConfiguration.h"
+#import "RLMResults.h"
+#import "RLMUser_Private.hpp"
+#import "RLMUtil.hpp"
 
 #import <realm/object-store/sync/mongo_client.hpp>
+#import <realm/object-store/sync/mongo_collection.hpp>
 #import <realm/object-store/sync/mongo_database.hpp>
+#import <realm/object-store/sync/sync_manager.hpp>
+#import <realm/object-store/sync/sync_user.hpp>
 #import <realm/util/optional.hpp>
 
+#import <atomic>
+#import <mutex>
+#import <sstream>
+
 @implementation RLMMongoClient
 
 - (instancetype)initWithUser:(RLMUser *)user serviceName:(NSString *)serviceName {
@@ -42,6 +56,333 @@
                                      databaseName:name];
 }
 
+- (RLMMongoWriteQueue *)writeQueueWithError:(NSError **)error {
+    return [RLMMongoWriteQueue queueForUser:self.user serviceName:self.name error:error];
+}
+
+@end
+
+#pragma mark RLMMongoWriteQueue
+
+typedef NS_ENUM(NSInteger, RLMMongoQueuedOperationType) {
+    RLMMongoQueuedOperationTypeInsertOne,
+    RLMMongoQueuedOperationTypeUpdateOne,
+    RLMMongoQueuedOperationTypeUpsertOne,
+    RLMMongoQueuedOperationTypeDeleteOne,
+};
+
+// A write waiting to be sent, stored in the write queue's Realm. The arguments
+// are the extended JSON of the document for an insert, and of an array of the
+// filter and update documents for other operations.
+@interface RLMMongoQueuedOperation : RLMObject
+@property NSInteger sequence;
+@property NSInteger type;
+@property NSString *database;
+@property NSString *collection;
+@property NSString *arguments;
+@end
+
+@implementation RLMMongoQueuedOperation
++ (BOOL)shouldIncludeInDefaultSchema {
+    return NO;
+}
+
++ (NSString *)primaryKey {
+    return @"sequence";
+}
+
++ (NSArray *)requiredProperties {
+    return @[@"database", @"collection", @"arguments"];
+}
+@end
+
+namespace {
+using namespace realm;
+
+// The largest number of consecutive inserts which are sent as one request
+constexpr NSUInteger maxInsertBatchCount = 1000;
+constexpr double initialRetryDelay = 1, maxRetryDelay = 60;
+
+std::string toExtendedJson(const bson::Bson& value) {
+    std::ostringstream json;
+    json << value;
+    return json.str();
+}
+
+// Errors reported by the server for the request itself mean that retrying it
+// won't help. Anything else, such as the server not being reachable, an
+// internal server error or the user's session not being valid yet, is retried.
+bool isRetryable(const app::AppError& error) {
+    return !error.is_service_error()
+        || error.error_code.value() == static_cast<int>(app::ServiceErrorCode::invalid_session);
+}
+} // anonymous namespace
+
+@implementation RLMMongoWriteQueue {
+    RLMUser *_user;
+    NSString *_serviceName;
+    RLMRealmConfiguration *_configuration;
+    dispatch_queue_t _queue;
+
+    // Accessed only on _queue
+    bool _flushing;
+    bool _retryScheduled;
+    double _retryDelay;
+    CFAbsoluteTime _flushStart;
+
+    std::atomic<NSUInteger> _pendingOperationCount;
+    std::atomic<double> _lastFlushDuration;
+    RLMMongoWriteQueueErrorBlock _errorHandler;
+    std::mutex _errorHandlerMutex;
+}
+
++ (instancetype)queueForUser:(RLMUser *)user serviceName:(NSString *)serviceName error:(NSError **)error {
+    static std::mutex& mutex = *new std::mutex;
+    static NSMutableDictionary<NSString *, RLMMongoWriteQueue *> *queues = [NSMutableDictionary new];
+
+    auto syncUser = user._syncUser;
+    std::string fileName = "mongo-write-queue-" + std::string(serviceName.UTF8String);
+    NSString *path = @(syncUser->sync_manager()->path_for_realm(*syncUser, fileName).c_str());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (RLMMongoWriteQueue *queue = queues[path]) {
+        return queue;
+    }
+    RLMMongoWriteQueue *queue = [[RLMMongoWriteQueue alloc] initWithUser:user serviceName:serviceName
+                                                                    path:path error:error];
+    if (queue) {
+        queues[path] = queue;
+    }
+    return queue;
+}
+
+- (instancetype)initWithUser:(RLMUser *)user serviceName:(NSString *)serviceName
+                        path:(NSString *)path error:(NSError **)error {
+    if (!(self = [super init])) {
+        return nil;
+    }
+    _user = user;
+    _serviceName = serviceName;
+    _queue = dispatch_queue_create("io.realm.mongo.write-queue", DISPATCH_QUEUE_SERIAL);
+    _retryDelay = initialRetryDelay;
+
+    _configuration = [RLMRealmConfiguration new];
+    _configuration.fileURL = [NSURL fileURLWithPath:path];
+    _configuration.objectClasses = @[RLMMongoQueuedOperation.class];
+
+    RLMRealm *realm = [RLMRealm realmWithConfiguration:_configuration error:error];
+    if (!realm) {
+        return nil;
+    }
+    _pendingOperationCount = [RLMMongoQueuedOperation allObjectsInRealm:realm].count;
+
+    // Send anything left over from a previous launch
+    [self flush];
+    return self;
+}
+
+- (NSUInteger)pendingOperationCount {
+    return _pendingOperationCount;
+}
+
+- (NSTimeInterval)lastFlushDuration {
+    return _lastFlushDuration;
+}
+
+- (RLMMongoWriteQueueErrorBlock)errorHandler {
+    std::lock_guard<std::mutex> lock(_errorHandlerMutex);
+    return _errorHandler;
+}
+
+- (void)setErrorHandler:(RLMMongoWriteQueueErrorBlock)errorHandler {
+    std::lock_guard<std::mutex> lock(_errorHandlerMutex);
+    _errorHandler = errorHandler;
+}
+
+#pragma mark Enqueuing
+
+- (void)enqueueOperation:(RLMMongoQueuedOperationType)type collection:(RLMMongoCollection *)collection
+               arguments:(bson::Bson)arguments {
+    NSString *database = collection.databaseName, *name = collection.name;
+    NSString *json = @(toExtendedJson(arguments).c_str());
+    dispatch_sync(_queue, ^{
+        @autoreleasepool {
+            RLMRealm *realm = [RLMRealm realmWithConfiguration:_configuration error:nil];
+            [realm transactionWithBlock:^{
+                RLMMongoQueuedOperation *last = [[[RLMMongoQueuedOperation allObjectsInRealm:realm]
+                                                  sortedResultsUsingKeyPath:@"sequence" ascending:NO] firstObject];
+                RLMMongoQueuedOperation *operation = [RLMMongoQueuedOperation new];
+                operation.sequence = last ? last.sequence + 1 : 0;
+                operation.type = type;
+                operation.database = database;
+                operation.collection = name;
+                operation.arguments = json;
+                [realm addObject:operation];
+            }];
+        }
+        ++_pendingOperationCount;
+        [self flushIfIdle];
+    });
+}
+
+- (void)insertOneDocument:(NSDictionary<NSString *, id<RLMBSON>> *)document
+             inCollection:(RLMMongoCollection *)collection {
+    bson::BsonDocument bsonDocument(RLMConvertRLMBSONToBson(document));
+    if (bsonDocument.find("_id") == bsonDocument.end()) {
+        bsonDocument["_id"] = ObjectId::gen();
+    }
+    [self enqueueOperation:RLMMongoQueuedOperationTypeInsertOne collection:collection
+                 arguments:std::move(bsonDocument)];
+}
+
+- (void)updateOneDocumentWhere:(NSDictionary<NSString *, id<RLMBSON>> *)filterDocument
+                updateDocument:(NSDictionary<NSString *, id<RLMBSON>> *)updateDocument
+                        upsert:(BOOL)upsert
+                  inCollection:(RLMMongoCollection *)collection {
+    [self enqueueOperation:upsert ? RLMMongoQueuedOperationTypeUpsertOne : RLMMongoQueuedOperationTypeUpdateOne
+                collection:collection
+                 arguments:bson::BsonArray{RLMConvertRLMBSONToBson(filterDocument),
+                                           RLMConvertRLMBSONToBson(updateDocument)}];
+}
+
+- (void)deleteOneDocumentWhere:(NSDictionary<NSString *, id<RLMBSON>> *)filterDocument
+                  inCollection:(RLMMongoCollection *)collection {
+    [self enqueueOperation:RLMMongoQueuedOperationTypeDeleteOne collection:collection
+                 arguments:bson::BsonArray{RLMConvertRLMBSONToBson(filterDocument)}];
+}
+
+#pragma mark Flushing
+
+- (void)flush {
+    dispatch_async(_queue, ^{
+        // A manual flush skips the wait for any scheduled retry
+        _retryDelay = initialRetryDelay;
+        _retryScheduled = false;
+        [self flushIfIdle];
+    });
+}
+
+// Must be called on _queue
+- (void)flushIfIdle {
+    if (_flushing || _retryScheduled) {
+        return;
+    }
+    _flushing = true;
+    _flushStart = CFAbsoluteTimeGetCurrent();
+    [self sendNextBatch];
+}
+
+// Must be called on _queue. Sends the oldest pending operation, along with the
+// inserts into the same collection which immediately follow it if it's an insert.
+- (void)sendNextBatch {
+    NSArray<NSNumber *> *sequences;
+    RLMMongoQueuedOperationType type;
+    std::string database, collectionName;
+    bson::BsonArray arguments;
+    @autoreleasepool {
+        RLMRealm *realm = [RLMRealm realmWithConfiguration:_configuration error:nil];
+        RLMResults *operations = [[RLMMongoQueuedOperation allObjectsInRealm:realm]
+                                  sortedResultsUsingKeyPath:@"sequence" ascending:YES];
+        RLMMongoQueuedOperation *first = operations.firstObject;
+        if (!first) {
+            _flushing = false;
+            _retryDelay = initialRetryDelay;
+            _lastFlushDuration = CFAbsoluteTimeGetCurrent() - _flushStart;
+            return;
+        }
+
+        type = static_cast<RLMMongoQueuedOperationType>(first.type);
+        database = first.database.UTF8String;
+        collectionName = first.collection.UTF8String;
+        NSMutableArray *batch = [NSMutableArray new];
+        for (RLMMongoQueuedOperation *operation in operations) {
+            if (batch.count && (type != RLMMongoQueuedOperationTypeInsertOne
+                                || operation.type != type
+                                || batch.count == maxInsertBatchCount
+                                || ![operation.database isEqualToString:first.database]
+                                || ![operation.collection isEqualToString:first.collection])) {
+                break;
+            }
+            [batch addObject:@(operation.sequence)];
+            arguments.push_back(bson::parse(operation.arguments.UTF8String));
+        }
+        sequences = batch;
+    }
+
+    auto collection = _user._syncUser->mongo_client(_serviceName.UTF8String).db(database).collection(collectionName);
+    auto completion = [self, sequences](util::Optional<app::AppError> error) {
+        dispatch_async(self->_queue, ^{
+            [self batchCompleted:sequences error:std::move(error)];
+        });
+    };
+    switch (type) {
+        case RLMMongoQueuedOperationTypeInsertOne:
+            collection.insert_many(arguments,
+                                   [=](std::vector<bson::Bson>, util::Optional<app::AppError> error) {
+                completion(std::move(error));
+            });
+            break;
+        case RLMMongoQueuedOperationTypeUpdateOne:
+        case RLMMongoQueuedOperationTypeUpsertOne: {
+            bson::BsonArray& args = static_cast<bson::BsonArray&>(arguments[0]);
+            collection.update_one(static_cast<bson::BsonDocument&>(args[0]), static_cast<bson::BsonDocument&>(args[1]),
+                                  type == RLMMongoQueuedOperationTypeUpsertOne,
+                                  [=](app::MongoCollection::UpdateResult, util::Optional<app::AppError> error) {
+                completion(std::move(error));
+            });
+            break;
+        }
+        case RLMMongoQueuedOperationTypeDeleteOne: {
+            bson::BsonArray& args = static_cast<bson::BsonArray&>(arguments[0]);
+            collection.delete_one(static_cast<bson::BsonDocument&>(args[0]),
+                                  [=](uint64_t, util::Optional<app::AppError> error) {
+                completion(std::move(error));
+            });
+            break;
+        }
+    }
+}
+
+// Must be called on _queue
+- (void)batchCompleted:(NSArray<NSNumber *> *)sequences error:(util::Optional<app::AppError>)error {
+    if (error && isRetryable(*error)) {
+        _flushing = false;
+        _retryScheduled = true;
+        double delay = _retryDelay;
+        _retryDelay = std::min(_retryDelay * 2, maxRetryDelay);
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), _queue, ^{
+            // A manual flush may have already restarted sending
+            if (_retryScheduled) {
+                _retryScheduled = false;
+                [self flushIfIdle];
+            }
+        });
+        return;
+    }
+
+    @autoreleasepool {
+        RLMRealm *realm = [RLMRealm realmWithConfiguration:_configuration error:nil];
+        [realm transactionWithBlock:^{
+            for (NSNumber *sequence in sequences) {
+                if (auto operation = [RLMMongoQueuedOperation objectInRealm:realm forPrimaryKey:sequence]) {
+                    [realm deleteObject:operation];
+                }
+            }
+        }];
+    }
+    _pendingOperationCount -= sequences.count;
+
+    if (error) {
+        if (RLMMongoWriteQueueErrorBlock handler = self.errorHandler) {
+            NSError *nsError = RLMAppErrorToNSError(*error);
+            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                handler(nsError);
+            });
+        }
+    }
+    [self sendNextBatch];
+}
+
 @end
 
 @implementation RLMMongoDatabase
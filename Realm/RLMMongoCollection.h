@@ -23,7 +23,7 @@
 NS_ASSUME_NONNULL_BEGIN
 @protocol RLMBSON;
 
-@class RLMFindOptions, RLMFindOneAndModifyOptions, RLMUpdateResult, RLMChangeStream, RLMObjectId;
+@class RLMFindOptions, RLMFindOneAndModifyOptions, RLMUpdateResult, RLMChangeStream, RLMMongoCursor, RLMObjectId;
 
 /// Delegate which is used for subscribing to changes on a `[RLMMongoCollection watch]` stream.
 @protocol RLMChangeEventDelegate
@@ -72,6 +72,11 @@ typedef void(^RLMMongoInsertBlock)(id<RLMBSON> _Nullable, NSError * _Nullable);
 typedef void(^RLMMongoInsertManyBlock)(NSArray<id<RLMBSON>> * _Nullable, NSError * _Nullable);
 /// Block which returns an array of Documents on a successful find operation, or an error should one occur.
 typedef void(^RLMMongoFindBlock)(NSArray<NSDictionary<NSString *, id<RLMBSON>> *> * _Nullable, NSError * _Nullable);
+/// Block which is called once for each Document returned by a streaming find operation.
+/// Set the `BOOL` pointed to by the second argument to `YES` to skip the remaining Documents.
+typedef void(^RLMMongoDocumentBlock)(NSDictionary<NSString *, id<RLMBSON>> *, BOOL *);
+/// Block which is called when a streaming find operation has finished, with an error should one occur.
+typedef void(^RLMMongoFindCompletionBlock)(NSError * _Nullable);
 /// Block which returns a Document on a successful findOne operation, or an error should one occur.
 typedef void(^RLMMongoFindOneBlock)(NSDictionary<NSString *, id<RLMBSON>> * _Nullable, NSError * _Nullable);
 /// Block which returns the number of Documents in a collection on a successful count operation, or an error should one occur.
@@ -93,11 +98,37 @@ typedef void(^RLMMongoDeleteBlock)(NSDictionary<NSString *, id<RLMBSON>> * _Null
 
 /// Encodes the provided values to BSON and inserts them. If any values are missing identifiers,
 /// they will be generated.
+///
+/// Documents are sent one batch at a time, in batches of up to 4MB, so that large
+/// inserts do not exceed the server's request size limit. If a batch fails, the
+/// batches after it are not sent.
 /// @param documents  The `Document` values in a bson array to insert.
 /// @param completion The result of the insert, returns an array inserted document ids in order
 - (void)insertManyDocuments:(NSArray<NSDictionary<NSString *, id<RLMBSON>> *> *)documents
                  completion:(RLMMongoInsertManyBlock)completion NS_REFINED_FOR_SWIFT;
 
+/// Encodes the provided values to BSON and inserts them in batches. If any values are
+/// missing identifiers, they will be generated.
+///
+/// Each batch holds as many documents as fit in `maximumBatchSize` bytes of encoded
+/// request body (a document larger than this is sent in a batch on its own), and up to
+/// `maximumConcurrentBatches` batches are sent at once. Documents are only encoded
+/// when the batch containing them is sent, so memory use is bounded by the number of
+/// batches in flight rather than the total size of the documents.
+///
+/// If a batch fails, the completion is called with its error and no further batches
+/// are sent. Batches which had already been sent may have been inserted.
+/// @param documents  The `Document` values in a bson array to insert.
+/// @param maximumBatchSize The maximum size in bytes of the documents sent in each request.
+/// @param maximumConcurrentBatches The maximum number of requests in flight at once.
+///                                 Batches are inserted in order if this is 1.
+/// @param completion The result of the insert, returns an array inserted document ids
+///                   in the order of `documents`
+- (void)insertManyDocuments:(NSArray<NSDictionary<NSString *, id<RLMBSON>> *> *)documents
+           maximumBatchSize:(NSUInteger)maximumBatchSize
+   maximumConcurrentBatches:(NSUInteger)maximumConcurrentBatches
+                 completion:(RLMMongoInsertManyBlock)completion NS_REFINED_FOR_SWIFT;
+
 /// Finds the documents in this collection which match the provided filter.
 /// @param filterDocument A `Document` as bson that should match the query.
 /// @param options `RLMFindOptions` to use when executing the command.
@@ -112,6 +143,22 @@ typedef void(^RLMMongoDeleteBlock)(NSDictionary<NSString *, id<RLMBSON>> * _Null
 - (void)findWhere:(NSDictionary<NSString *, id<RLMBSON>> *)filterDocument
        completion:(RLMMongoFindBlock)completion NS_REFINED_FOR_SWIFT;
 
+/// Finds the documents in this collection which match the provided filter,
+/// passing them to `documentHandler` one at a time.
+///
+/// Unlike `findWhere:options:completion:`, the matching documents are never
+/// all converted to Objective-C objects at once, and each document is
+/// released as soon as `documentHandler` returns unless it is retained by it.
+/// @param filterDocument A `Document` as bson that should match the query.
+/// @param options `RLMFindOptions` to use when executing the command.
+/// @param documentHandler A block called once for each matching document.
+/// @param completion A block called after the last document has been passed to
+///                   `documentHandler`, or with an error if the query failed.
+- (void)findWhere:(NSDictionary<NSString *, id<RLMBSON>> *)filterDocument
+          options:(RLMFindOptions *)options
+  documentHandler:(RLMMongoDocumentBlock)documentHandler
+       completion:(RLMMongoFindCompletionBlock)completion NS_REFINED_FOR_SWIFT;
+
 /// Returns one document from a collection or view which matches the
 /// provided filter. If multiple documents satisfy the query, this method
 /// returns the first document according to the query's sort order or natural
@@ -138,6 +185,30 @@ typedef void(^RLMMongoDeleteBlock)(NSDictionary<NSString *, id<RLMBSON>> * _Null
 - (void)aggregateWithPipeline:(NSArray<NSDictionary<NSString *, id<RLMBSON>> *> *)pipeline
                    completion:(RLMMongoFindBlock)completion NS_REFINED_FOR_SWIFT;
 
+/// Returns a cursor which fetches the documents in this collection which match
+/// the provided filter in batches of at most `batchSize` documents.
+///
+/// No documents are fetched until `-[RLMMongoCursor nextBatch:]` is called.
+/// If `options` specifies a limit, it applies to the total number of documents
+/// returned by the cursor across all batches.
+/// @param filterDocument A `Document` as bson that should match the query.
+/// @param options `RLMFindOptions` to use when executing the command.
+/// @param batchSize The maximum number of documents to fetch in each batch. Must be greater than zero.
+- (RLMMongoCursor *)findCursorWhere:(NSDictionary<NSString *, id<RLMBSON>> *)filterDocument
+                            options:(RLMFindOptions *)options
+                          batchSize:(NSUInteger)batchSize NS_REFINED_FOR_SWIFT;
+
+/// Returns a cursor which runs an aggregation framework pipeline against this
+/// collection and fetches the results in batches of at most `batchSize` documents.
+///
+/// The batches are fetched by appending `$skip` and `$limit` stages to the
+/// pipeline, so the pipeline should produce its results in a stable order
+/// (e.g. by ending with a `$sort` stage) for the batches to be consistent.
+/// @param pipeline A bson array made up of `Documents` containing the pipeline of aggregation operations to perform.
+/// @param batchSize The maximum number of documents to fetch in each batch. Must be greater than zero.
+- (RLMMongoCursor *)aggregateCursorWithPipeline:(NSArray<NSDictionary<NSString *, id<RLMBSON>> *> *)pipeline
+                                      batchSize:(NSUInteger)batchSize NS_REFINED_FOR_SWIFT;
+
 /// Counts the number of documents in this collection matching the provided filter.
 /// @param filterDocument A `Document` as bson that should match the query.
 /// @param limit The max amount of documents to count
@@ -315,4 +386,32 @@ typedef void(^RLMMongoDeleteBlock)(NSDictionary<NSString *, id<RLMBSON>> * _Null
 
 @end
 
+/// A cursor over the results of a find or aggregate operation on a
+/// `RLMMongoCollection`, which fetches the results in batches.
+///
+/// Each batch is only requested from the server when `nextBatch:` is called, so
+/// at most one batch of documents is held in memory by the cursor at a time.
+@interface RLMMongoCursor : NSObject
+
+/// The maximum number of documents returned by each call to `nextBatch:`.
+@property (nonatomic, readonly) NSUInteger batchSize;
+
+/// Whether all of the documents have been returned. Once this is `YES`,
+/// `nextBatch:` will report an empty array without contacting the server.
+@property (nonatomic, readonly, getter=isExhausted) BOOL exhausted;
+
+/// Fetches the next batch of documents.
+///
+/// Only one batch may be requested at a time: calling this again before the
+/// completion block for the previous batch has been called throws an exception.
+/// @param completion The next batch of documents, or an error if one occurs
+- (void)nextBatch:(RLMMongoFindBlock)completion NS_REFINED_FOR_SWIFT;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMMongoCursor cannot be created directly")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMMongoCursor cannot be created directly")));
+
+@end
+
 NS_ASSUME_NONNULL_END
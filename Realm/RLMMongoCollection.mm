@@ -25,15 +25,196 @@
 #import "RLMNetworkTransport_Private.hpp"
 #import "RLMUpdateResult_Private.hpp"
 #import "RLMUser_Private.hpp"
+#import "RLMUtil.hpp"
 
 #import <realm/object-store/sync/mongo_client.hpp>
 #import <realm/object-store/sync/mongo_collection.hpp>
 #import <realm/object-store/sync/mongo_database.hpp>
 
+#import <mutex>
+#import <sstream>
+
+@class RLMChangeStreamMultiplexer;
+
+@interface RLMChangeStream ()
+- (void)didReceiveChangeEvents:(NSArray<id<RLMBSON>> *)events;
+- (void)attachMultiplexer:(RLMChangeStreamMultiplexer *)multiplexer;
+@end
+
+#pragma mark RLMChangeStreamMultiplexer
+
+// The chunk boundaries are arbitrary and may split a line or even a UTF-8
+// sequence, so the raw bytes are handed to the WatchStream, which buffers
+// any incomplete line until the rest of it arrives. A single chunk often
+// contains many events for a busy collection, so they're returned together to
+// be delivered with one dispatch rather than one per event.
+static NSArray<id<RLMBSON>> *decodeEvents(realm::app::WatchStream& watchStream, NSData *event, NSError **error) {
+    std::string_view str(static_cast<const char *>(event.bytes), event.length);
+    if (!str.empty() && watchStream.state() == realm::app::WatchStream::State::NEED_DATA) {
+        watchStream.feed_buffer(str);
+    }
+
+    NSMutableArray<id<RLMBSON>> *events;
+    while (watchStream.state() == realm::app::WatchStream::State::HAVE_EVENT) {
+        if (!events) {
+            events = [NSMutableArray new];
+        }
+        [events addObject:RLMConvertBsonToRLMBSON(watchStream.next_event())];
+    }
+
+    if (watchStream.state() == realm::app::WatchStream::State::HAVE_ERROR) {
+        *error = RLMAppErrorToNSError(watchStream.error());
+    }
+    return events;
+}
+
+// A single server-sent event stream for a watch request, shared by every
+// RLMChangeStream watching the same collection with the same filter. Events
+// are decoded once and then delivered to each change stream's delegate. The
+// underlying session is cancelled when the last change stream is closed.
+@interface RLMChangeStreamMultiplexer : NSObject <RLMEventDelegate>
+@end
+
+@implementation RLMChangeStreamMultiplexer {
+    NSString *_key;
+    realm::app::WatchStream _watchStream;
+    NSURLSession *_session;
+    // Guarded by s_multiplexerMutex
+    NSMutableArray<RLMChangeStream *> *_streams;
+    bool _opened;
+}
+
+static std::mutex& s_multiplexerMutex = *new std::mutex;
+static NSMutableDictionary<NSString *, RLMChangeStreamMultiplexer *> *s_multiplexers = [NSMutableDictionary new];
+
++ (void)addStream:(RLMChangeStream *)stream key:(NSString *)key
+     startSession:(NS_NOESCAPE NSURLSession *(^)(id<RLMEventDelegate>))startSession {
+    RLMChangeStreamMultiplexer *multiplexer;
+    bool created = false, opened;
+    {
+        std::lock_guard<std::mutex> lock(s_multiplexerMutex);
+        multiplexer = s_multiplexers[key];
+        if (!multiplexer) {
+            multiplexer = [RLMChangeStreamMultiplexer new];
+            multiplexer->_key = key;
+            multiplexer->_streams = [NSMutableArray new];
+            s_multiplexers[key] = multiplexer;
+            created = true;
+        }
+        [multiplexer->_streams addObject:stream];
+        opened = multiplexer->_opened;
+    }
+    [stream attachMultiplexer:multiplexer];
+
+    if (created) {
+        // The session is started outside of the lock as the transport may
+        // call the delegate before returning
+        NSURLSession *session = startSession(multiplexer);
+        bool closed;
+        {
+            std::lock_guard<std::mutex> lock(s_multiplexerMutex);
+            multiplexer->_session = session;
+            closed = multiplexer->_streams.count == 0;
+        }
+        if (closed) {
+            [session invalidateAndCancel];
+        }
+    }
+    else if (opened) {
+        // A stream which joins an already open session won't see it open
+        [stream didOpen];
+    }
+}
+
+- (void)removeStream:(RLMChangeStream *)stream {
+    NSURLSession *session;
+    {
+        std::lock_guard<std::mutex> lock(s_multiplexerMutex);
+        if (![_streams containsObject:stream]) {
+            return;
+        }
+        [_streams removeObject:stream];
+        if (_streams.count == 0) {
+            [self unregister];
+            session = _session;
+        }
+    }
+    [stream didCloseWithError:nil];
+    [session invalidateAndCancel];
+}
+
+// Must be called with s_multiplexerMutex held
+- (void)unregister {
+    if (s_multiplexers[_key] == self) {
+        [s_multiplexers removeObjectForKey:_key];
+    }
+}
+
+- (NSArray<RLMChangeStream *> *)streams {
+    std::lock_guard<std::mutex> lock(s_multiplexerMutex);
+    return [_streams copy];
+}
+
+- (void)didOpen {
+    NSArray *streams;
+    {
+        std::lock_guard<std::mutex> lock(s_multiplexerMutex);
+        _opened = true;
+        streams = [_streams copy];
+    }
+    for (RLMChangeStream *stream in streams) {
+        [stream didOpen];
+    }
+}
+
+- (void)didCloseWithError:(NSError *)error {
+    // The session can't be reused once it has closed, so streams opened after
+    // this point create a new one
+    NSArray *streams;
+    {
+        std::lock_guard<std::mutex> lock(s_multiplexerMutex);
+        [self unregister];
+        streams = _streams;
+        _streams = [NSMutableArray new];
+    }
+    for (RLMChangeStream *stream in streams) {
+        [stream didCloseWithError:error];
+    }
+}
+
+- (void)didReceiveError:(NSError *)error {
+    for (RLMChangeStream *stream in self.streams) {
+        [stream didReceiveError:error];
+    }
+}
+
+- (void)didReceiveEvent:(NSData *)event {
+    // Session delegate callbacks are serialized, so the WatchStream doesn't
+    // need to be guarded
+    NSError *error;
+    NSArray<id<RLMBSON>> *events = decodeEvents(_watchStream, event, &error);
+    NSArray<RLMChangeStream *> *streams = self.streams;
+    if (events) {
+        for (RLMChangeStream *stream in streams) {
+            [stream didReceiveChangeEvents:events];
+        }
+    }
+    if (error) {
+        for (RLMChangeStream *stream in streams) {
+            [stream didReceiveError:error];
+        }
+    }
+}
+
+@end
+
+#pragma mark RLMChangeStream
+
 @implementation RLMChangeStream {
     realm::app::WatchStream _watchStream;
     id<RLMChangeEventDelegate> _subscriber;
     __weak NSURLSession *_session;
+    __weak RLMChangeStreamMultiplexer *_multiplexer;
     _Nonnull dispatch_queue_t _queue;
 }
 
@@ -66,33 +247,156 @@
 }
 
 - (void)didReceiveEvent:(nonnull NSData *)event {
-    std::string_view str = [[NSString alloc] initWithData:event encoding:NSUTF8StringEncoding].UTF8String;
-    if (!str.empty() && _watchStream.state() == realm::app::WatchStream::State::NEED_DATA) {
-        _watchStream.feed_buffer(str);
+    NSError *error;
+    if (NSArray<id<RLMBSON>> *events = decodeEvents(_watchStream, event, &error)) {
+        [self didReceiveChangeEvents:events];
     }
-
-    while (_watchStream.state() == realm::app::WatchStream::State::HAVE_EVENT) {
-        id<RLMBSON> event = RLMConvertBsonToRLMBSON(_watchStream.next_event());
-        dispatch_async(_queue, ^{
-            [_subscriber changeStreamDidReceiveChangeEvent:event];
-        });
+    if (error) {
+        [self didReceiveError:error];
     }
+}
 
-    if (_watchStream.state() == realm::app::WatchStream::State::HAVE_ERROR) {
-        [self didReceiveError:RLMAppErrorToNSError(_watchStream.error())];
-    }
+- (void)didReceiveChangeEvents:(NSArray<id<RLMBSON>> *)events {
+    dispatch_async(_queue, ^{
+        for (id<RLMBSON> event in events) {
+            [_subscriber changeStreamDidReceiveChangeEvent:event];
+        }
+    });
 }
 
 - (void)attachURLSession:(NSURLSession *)urlSession {
     _session = urlSession;
 }
 
+- (void)attachMultiplexer:(RLMChangeStreamMultiplexer *)multiplexer {
+    _multiplexer = multiplexer;
+}
+
 - (void)close {
-    [_session invalidateAndCancel];
+    if (RLMChangeStreamMultiplexer *multiplexer = _multiplexer) {
+        [multiplexer removeStream:self];
+    }
+    else {
+        [_session invalidateAndCancel];
+    }
 }
 
 @end
 
+namespace {
+// Inserts an array of documents in batches limited by their encoded size, with
+// a bounded number of batches in flight. Each document is converted to BSON
+// when the batch containing it is started, and the inserted ids are collected
+// per batch so that they can be reported in the order of the documents.
+class BatchedInsert : public std::enable_shared_from_this<BatchedInsert> {
+public:
+    BatchedInsert(realm::app::MongoCollection collection, NSArray *documents,
+                  size_t maxBatchSize, size_t maxConcurrentBatches, RLMMongoInsertManyBlock completion)
+    : m_collection(std::move(collection)), m_documents(documents)
+    , m_max_batch_size(maxBatchSize), m_max_concurrent_batches(maxConcurrentBatches)
+    , m_completion(completion) { }
+
+    void send_batches() {
+        std::vector<std::pair<size_t, realm::bson::BsonArray>> batches;
+        bool done;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (!m_failed && m_in_flight < m_max_concurrent_batches && has_more_documents()) {
+                batches.emplace_back(m_inserted_ids.size(), next_batch());
+                m_inserted_ids.emplace_back();
+                ++m_in_flight;
+            }
+            done = !m_failed && m_in_flight == 0 && !has_more_documents();
+        }
+        if (done) {
+            return finish();
+        }
+
+        // The requests are sent outside of the lock in case the transport
+        // calls the completion synchronously
+        for (auto& [index, batch] : batches) {
+            m_collection.insert_many(batch, [self = shared_from_this(), index = index]
+                                     (std::vector<realm::bson::Bson> insertedIds,
+                                      realm::util::Optional<realm::app::AppError> error) {
+                self->batch_completed(index, std::move(insertedIds), std::move(error));
+            });
+        }
+    }
+
+private:
+    realm::app::MongoCollection m_collection;
+    NSArray *m_documents;
+    const size_t m_max_batch_size;
+    const size_t m_max_concurrent_batches;
+    RLMMongoInsertManyBlock m_completion;
+
+    std::mutex m_mutex;
+    NSUInteger m_next_document = 0;
+    // A document which was converted but did not fit in the previous batch
+    realm::util::Optional<std::pair<realm::bson::Bson, size_t>> m_carried_document;
+    size_t m_in_flight = 0;
+    bool m_failed = false;
+    std::vector<std::vector<realm::bson::Bson>> m_inserted_ids;
+
+    bool has_more_documents() const {
+        return m_carried_document || m_next_document < m_documents.count;
+    }
+
+    realm::bson::BsonArray next_batch() {
+        realm::bson::BsonArray batch;
+        size_t batchSize = 0;
+        while (has_more_documents()) {
+            if (!m_carried_document) {
+                realm::bson::Bson document = realm::bson::BsonDocument(RLMConvertRLMBSONToBson(m_documents[m_next_document++]));
+                // The request body is the extended JSON of the documents
+                std::ostringstream json;
+                json << document;
+                m_carried_document.emplace(std::move(document), static_cast<size_t>(json.tellp()));
+            }
+            auto& [document, size] = *m_carried_document;
+            if (!batch.empty() && batchSize + size > m_max_batch_size) {
+                break;
+            }
+            batchSize += size;
+            batch.push_back(std::move(document));
+            m_carried_document = realm::util::none;
+        }
+        return batch;
+    }
+
+    void batch_completed(size_t index, std::vector<realm::bson::Bson> insertedIds,
+                         realm::util::Optional<realm::app::AppError> error) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_in_flight;
+            if (m_failed) {
+                return;
+            }
+            if (error) {
+                m_failed = true;
+            }
+            else {
+                m_inserted_ids[index] = std::move(insertedIds);
+            }
+        }
+        if (error) {
+            return m_completion(nil, RLMAppErrorToNSError(*error));
+        }
+        send_batches();
+    }
+
+    void finish() {
+        NSMutableArray *insertedArr = [[NSMutableArray alloc] initWithCapacity:m_documents.count];
+        for (auto& batch : m_inserted_ids) {
+            for (auto& objectId : batch) {
+                [insertedArr addObject:RLMConvertBsonToRLMBSON(objectId)];
+            }
+        }
+        m_completion(insertedArr, nil);
+    }
+};
+} // anonymous namespace
+
 @implementation RLMMongoCollection
 
 static realm::bson::BsonDocument toBsonDocument(id<RLMBSON> bson) {
@@ -142,6 +446,29 @@ static realm::bson::BsonArray toBsonArray(id<RLMBSON> bson) {
     [self findWhere:document options:[[RLMFindOptions alloc] init] completion:completion];
 }
 
+- (void)findWhere:(NSDictionary<NSString *, id<RLMBSON>> *)document
+          options:(RLMFindOptions *)options
+  documentHandler:(RLMMongoDocumentBlock)documentHandler
+       completion:(RLMMongoFindCompletionBlock)completion {
+    self.collection.find(toBsonDocument(document), [options _findOptions],
+                         [documentHandler, completion](realm::util::Optional<realm::bson::BsonArray> documents,
+                                                       realm::util::Optional<realm::app::AppError> error) {
+        if (error) {
+            return completion(RLMAppErrorToNSError(*error));
+        }
+        BOOL stop = NO;
+        for (auto& entry : *documents) {
+            @autoreleasepool {
+                documentHandler((NSDictionary<NSString *, id<RLMBSON>> *)RLMConvertBsonToRLMBSON(entry), &stop);
+            }
+            if (stop) {
+                break;
+            }
+        }
+        completion(nil);
+    });
+}
+
 - (void)findOneDocumentWhere:(NSDictionary<NSString *, id<RLMBSON>> *)document
                      options:(RLMFindOptions *)options
                   completion:(RLMMongoFindOneBlock)completion {
@@ -178,18 +505,33 @@ static realm::bson::BsonArray toBsonArray(id<RLMBSON> bson) {
 
 - (void)insertManyDocuments:(NSArray<NSDictionary<NSString *, id<RLMBSON>> *> *)documents
                  completion:(RLMMongoInsertManyBlock)completion {
-    self.collection.insert_many(toBsonArray(documents),
-                                [completion](std::vector<realm::bson::Bson> insertedIds,
-                                             realm::util::Optional<realm::app::AppError> error) {
-        if (error) {
-            return completion(nil, RLMAppErrorToNSError(*error));
-        }
-        NSMutableArray *insertedArr = [[NSMutableArray alloc] initWithCapacity:insertedIds.size()];
-        for (auto& objectId : insertedIds) {
-            [insertedArr addObject:RLMConvertBsonToRLMBSON(objectId)];
-        }
-        completion(insertedArr, nil);
-    });
+    [self insertManyDocuments:documents
+             maximumBatchSize:4 * 1024 * 1024
+     maximumConcurrentBatches:1
+                   completion:completion];
+}
+
+- (void)insertManyDocuments:(NSArray<NSDictionary<NSString *, id<RLMBSON>> *> *)documents
+           maximumBatchSize:(NSUInteger)maximumBatchSize
+   maximumConcurrentBatches:(NSUInteger)maximumConcurrentBatches
+                 completion:(RLMMongoInsertManyBlock)completion {
+    if (maximumBatchSize == 0 || maximumConcurrentBatches == 0) {
+        @throw RLMException(@"The maximum batch size and number of concurrent batches must be greater than zero");
+    }
+    // An empty array is still sent so that the server validates it as before
+    if (documents.count == 0) {
+        self.collection.insert_many(toBsonArray(documents),
+                                    [completion](std::vector<realm::bson::Bson>,
+                                                 realm::util::Optional<realm::app::AppError> error) {
+            if (error) {
+                return completion(nil, RLMAppErrorToNSError(*error));
+            }
+            completion(@[], nil);
+        });
+        return;
+    }
+    std::make_shared<BatchedInsert>(self.collection, documents, maximumBatchSize,
+                                    maximumConcurrentBatches, completion)->send_batches();
 }
 
 - (void)aggregateWithPipeline:(NSArray<NSDictionary<NSString *, id<RLMBSON>> *> *)pipeline
@@ -204,6 +546,50 @@ static realm::bson::BsonArray toBsonArray(id<RLMBSON> bson) {
     });
 }
 
+- (RLMMongoCursor *)findCursorWhere:(NSDictionary<NSString *, id<RLMBSON>> *)document
+                            options:(RLMFindOptions *)options
+                          batchSize:(NSUInteger)batchSize {
+    realm::bson::BsonDocument match;
+    match["$match"] = toBsonDocument(document);
+    realm::bson::BsonArray pipeline;
+    pipeline.push_back(match);
+
+    // Without a custom sort order we can page on _id rather than with $skip,
+    // which lets the server use the _id index for every batch
+    bool sortById = !options.sort || ((NSDictionary *)options.sort).count == 0;
+    realm::bson::BsonDocument sort;
+    if (sortById) {
+        realm::bson::BsonDocument byId;
+        byId["_id"] = 1;
+        sort["$sort"] = byId;
+    }
+    else {
+        sort["$sort"] = toBsonDocument(options.sort);
+    }
+    pipeline.push_back(sort);
+
+    realm::util::Optional<realm::bson::BsonDocument> projection;
+    if (options.projection && ((NSDictionary *)options.projection).count) {
+        projection = toBsonDocument(options.projection);
+    }
+    return [[RLMMongoCursor alloc] initWithCollection:self
+                                             pipeline:std::move(pipeline)
+                                           projection:std::move(projection)
+                                             pageById:sortById && !projection
+                                                limit:options.limit > 0 ? options.limit : 0
+                                            batchSize:batchSize];
+}
+
+- (RLMMongoCursor *)aggregateCursorWithPipeline:(NSArray<NSDictionary<NSString *, id<RLMBSON>> *> *)pipeline
+                                      batchSize:(NSUInteger)batchSize {
+    return [[RLMMongoCursor alloc] initWithCollection:self
+                                             pipeline:toBsonArray(pipeline)
+                                           projection:realm::util::none
+                                             pageById:false
+                                                limit:0
+                                            batchSize:batchSize];
+}
+
 - (void)countWhere:(NSDictionary<NSString *, id<RLMBSON>> *)document
              limit:(NSInteger)limit
         completion:(RLMMongoCountBlock)completion {
@@ -409,15 +795,140 @@ static realm::bson::BsonArray toBsonArray(id<RLMBSON> bson) {
     }
     auto args = realm::bson::BsonArray{baseArgs};
     auto app = self.user.app._realmApp;
-    auto request = app->make_streaming_request(app->current_user(), "watch", args,
-                                               realm::util::Optional<std::string>(self.serviceName.UTF8String));
+    auto user = app->current_user();
+
+    // Watchers of the same collection with the same filters share one stream
+    std::ostringstream key;
+    key << app->config().app_id << '\0' << (user ? user->identity() : "") << '\0'
+        << self.serviceName.UTF8String << '\0' << realm::bson::Bson(args);
+
     RLMChangeStream *changeStream = [[RLMChangeStream alloc] initWithChangeEventSubscriber:delegate delegateQueue:queue];
-    RLMNetworkTransport *transport = self.user.app.configuration.transport;
-    RLMRequest *rlmRequest = [transport RLMRequestFromRequest:request];
-    NSURLSession *watchSession = [transport doStreamRequest:rlmRequest
-                                            eventSubscriber:changeStream];
-    [changeStream attachURLSession:watchSession];
+    std::string keyString = key.str();
+    NSString *multiplexerKey = [[NSString alloc] initWithBytes:keyString.data() length:keyString.size()
+                                                      encoding:NSUTF8StringEncoding];
+    [RLMChangeStreamMultiplexer addStream:changeStream key:multiplexerKey
+                             startSession:^(id<RLMEventDelegate> subscriber) {
+        auto request = app->make_streaming_request(user, "watch", args,
+                                                   realm::util::Optional<std::string>(self.serviceName.UTF8String));
+        RLMNetworkTransport *transport = self.user.app.configuration.transport;
+        RLMRequest *rlmRequest = [transport RLMRequestFromRequest:request];
+        return [transport doStreamRequest:rlmRequest eventSubscriber:subscriber];
+    }];
     return changeStream;
 }
 
 @end
+
+@implementation RLMMongoCursor {
+    RLMMongoCollection *_collection;
+    realm::bson::BsonArray _pipeline;
+    realm::util::Optional<realm::bson::BsonDocument> _projection;
+    bool _pageById;
+    // Whether the find options specified a limit, and if so how many more
+    // documents can be returned
+    bool _limited;
+    NSUInteger _remaining;
+
+    std::mutex _mutex;
+    realm::util::Optional<realm::bson::Bson> _lastId;
+    NSUInteger _skip;
+    bool _fetching;
+    bool _exhausted;
+}
+
+- (instancetype)initWithCollection:(RLMMongoCollection *)collection
+                          pipeline:(realm::bson::BsonArray)pipeline
+                        projection:(realm::util::Optional<realm::bson::BsonDocument>)projection
+                          pageById:(bool)pageById
+                             limit:(NSUInteger)limit
+                         batchSize:(NSUInteger)batchSize {
+    if (batchSize == 0) {
+        @throw RLMException(@"Invalid batch size %zu: must be greater than zero.", (size_t)batchSize);
+    }
+    if (self = [super init]) {
+        _collection = collection;
+        _pipeline = std::move(pipeline);
+        _projection = std::move(projection);
+        _pageById = pageById;
+        _limited = limit > 0;
+        _remaining = limit;
+        _batchSize = batchSize;
+    }
+    return self;
+}
+
+- (BOOL)isExhausted {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _exhausted;
+}
+
+- (realm::bson::BsonArray)pipelineForBatchOfSize:(NSUInteger)count {
+    realm::bson::BsonArray pipeline = _pipeline;
+    if (_pageById && _lastId) {
+        realm::bson::BsonDocument greaterThan, idFilter, match;
+        greaterThan["$gt"] = *_lastId;
+        idFilter["_id"] = greaterThan;
+        match["$match"] = idFilter;
+        pipeline.push_back(match);
+    }
+    else if (_skip) {
+        realm::bson::BsonDocument skip;
+        skip["$skip"] = static_cast<int64_t>(_skip);
+        pipeline.push_back(skip);
+    }
+    realm::bson::BsonDocument limit;
+    limit["$limit"] = static_cast<int64_t>(count);
+    pipeline.push_back(limit);
+    if (_projection) {
+        realm::bson::BsonDocument project;
+        project["$project"] = *_projection;
+        pipeline.push_back(project);
+    }
+    return pipeline;
+}
+
+- (void)nextBatch:(RLMMongoFindBlock)completion {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_fetching) {
+        lock.unlock();
+        @throw RLMException(@"Cannot request the next batch from a RLMMongoCursor until the previous batch has been delivered.");
+    }
+    if (_exhausted) {
+        lock.unlock();
+        return completion(@[], nil);
+    }
+    NSUInteger count = _limited ? std::min(_remaining, _batchSize) : _batchSize;
+    auto pipeline = [self pipelineForBatchOfSize:count];
+    _fetching = true;
+    lock.unlock();
+
+    // The cursor is retained until the request completes, so that dropping the
+    // last reference to it while a batch is being fetched is harmless
+    RLMMongoCursor *cursor = self;
+    _collection.collection.aggregate(pipeline,
+                                     [cursor, count, completion](realm::util::Optional<realm::bson::BsonArray> documents,
+                                                                 realm::util::Optional<realm::app::AppError> error) {
+        {
+            std::lock_guard<std::mutex> lock(cursor->_mutex);
+            cursor->_fetching = false;
+            if (!error) {
+                NSUInteger received = documents->size();
+                cursor->_skip += received;
+                if (cursor->_pageById && received) {
+                    cursor->_lastId = static_cast<realm::bson::BsonDocument>(documents->back())["_id"];
+                }
+                if (cursor->_limited) {
+                    cursor->_remaining -= std::min(cursor->_remaining, received);
+                }
+                // A short batch means the server has nothing more to give us
+                cursor->_exhausted = received < count || (cursor->_limited && cursor->_remaining == 0);
+            }
+        }
+        if (error) {
+            return completion(nil, RLMAppErrorToNSError(*error));
+        }
+        completion((NSArray<NSDictionary<NSString *, id<RLMBSON>> *> *)RLMConvertBsonToRLMBSON(*documents), nil);
+    });
+}
+
+@end
@@ -18,6 +18,8 @@
 
 #import <Realm/RLMMongoCollection.h>
 
+#import <realm/object-store/sync/mongo_collection.hpp>
+
 NS_ASSUME_NONNULL_BEGIN
 
 @class RLMUser;
@@ -30,6 +32,15 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)attachURLSession:(NSURLSession *)urlSession;
 @end
 
+@interface RLMMongoCursor ()
+- (instancetype)initWithCollection:(RLMMongoCollection *)collection
+                          pipeline:(realm::bson::BsonArray)pipeline
+                        projection:(realm::util::Optional<realm::bson::BsonDocument>)projection
+                          pageById:(bool)pageById
+                             limit:(NSUInteger)limit
+                         batchSize:(NSUInteger)batchSize;
+@end
+
 @interface RLMMongoCollection ()
 
 @property (nonatomic, strong) RLMUser *user;
@@ -53,6 +53,11 @@ typedef RLM_CLOSED_ENUM(int32_t, RLMHTTPMethod) {
 /// The body of the request.
 @property (nonatomic, strong) NSString* body;
 
+/// The body of the request as raw bytes. This and `body` are two views of the
+/// same value, and setting either one replaces the other. Transports should
+/// prefer this property to avoid converting large bodies to and from strings.
+@property (nonatomic, strong, nullable) NSData *bodyData;
+
 @end
 
 /// The contents of an HTTP response.
@@ -70,6 +75,12 @@ typedef RLM_CLOSED_ENUM(int32_t, RLMHTTPMethod) {
 /// The body of the HTTP response.
 @property (nonatomic, strong) NSString *body;
 
+/// The body of the HTTP response as raw bytes. This and `body` are two views
+/// of the same value, and setting either one replaces the other. Transports
+/// should prefer this property to avoid converting large bodies to and from
+/// strings.
+@property (nonatomic, strong, nullable) NSData *bodyData;
+
 @end
 
 /// Delegate which is used for subscribing to changes.
@@ -91,8 +102,23 @@ typedef RLM_CLOSED_ENUM(int32_t, RLMHTTPMethod) {
 /// A block for receiving an `RLMResponse` from the `RLMNetworkTransport`.
 typedef void(^RLMNetworkTransportCompletionBlock)(RLMResponse *);
 
-/// Transporting protocol for foreign interfaces. Allows for custom
-/// request/response handling.
+/**
+ Transporting protocol for foreign interfaces. Allows for custom
+ request/response handling.
+
+ This protocol is the supported way to replace how an `RLMApp` talks to the
+ server, for example to use a shared pool of connections, an HTTP/2 or HTTP/3
+ client which multiplexes requests over a single connection, or a mock which
+ replays canned responses in tests and load tests. Set an instance of a class
+ conforming to it as `RLMAppConfiguration.transport`; there is no need to
+ subclass `RLMNetworkTransport`.
+
+ A transport may be called from any thread, with multiple requests in flight
+ at once, and must call the completion block exactly once for each request. The
+ completion block may be called on any thread. Failures which happen before a
+ response is received should be reported with an `httpStatusCode` of 0 and the
+ error code in `customStatusCode`.
+ */
 @protocol RLMNetworkTransport <NSObject>
 
 /**
@@ -112,10 +138,38 @@ typedef void(^RLMNetworkTransportCompletionBlock)(RLMResponse *);
 
 @end
 
-/// Transporting protocol for foreign interfaces. Allows for custom
-/// request/response handling.
+@class RLMNetworkTransport;
+
+/// A delegate which is told the timings of each request sent by an `RLMNetworkTransport`.
+@protocol RLMNetworkTransportMetricsDelegate <NSObject>
+
+/**
+ Called when the metrics for a request have been collected, shortly before the
+ request's completion block is called.
+
+ The metrics break the request down into DNS lookup, connection and TLS setup,
+ time spent waiting for the server and time spent receiving the response, and
+ report whether an existing connection was reused. This is called on a
+ background queue.
+
+ @param transport The transport which sent the request.
+ @param request The request which the metrics are for.
+ @param metrics The metrics collected by `NSURLSession` for the request.
+ */
+- (void)networkTransport:(RLMNetworkTransport *)transport
+                 request:(RLMRequest *)request
+didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics
+    API_AVAILABLE(macos(10.12), ios(10.0), watchos(3.0), tvos(10.0));
+
+@end
+
+/// The default transport, which sends requests with a shared `NSURLSession`.
 @interface RLMNetworkTransport : NSObject<RLMNetworkTransport>
 
+/// A delegate which is told the `NSURLSessionTaskMetrics` for each request
+/// sent by this transport.
+@property (nonatomic, weak, nullable) id<RLMNetworkTransportMetricsDelegate> metricsDelegate;
+
 /**
  Sends a request to a given endpoint.
 
@@ -27,6 +27,8 @@
 #import <realm/object-store/sync/generic_network_transport.hpp>
 #import <realm/util/scope_exit.hpp>
 
+#import <mutex>
+
 using namespace realm;
 
 static_assert((int)RLMHTTPMethodGET        == (int)app::HttpMethod::get);
@@ -37,8 +39,19 @@ static_assert((int)RLMHTTPMethodDELETE     == (int)app::HttpMethod::del);
 
 #pragma mark RLMSessionDelegate
 
-@interface RLMSessionDelegate <NSURLSessionDelegate> : NSObject
+@interface RLMSessionDelegate : NSObject <NSURLSessionDataDelegate>
 + (instancetype)delegateWithCompletion:(RLMNetworkTransportCompletionBlock)completion;
+@property (nonatomic, strong) RLMNetworkTransport *transport;
+@property (nonatomic, strong) RLMRequest *request;
+@end
+
+// All requests share a single long-lived NSURLSession so that connections and
+// TLS sessions can be reused between requests rather than performing a full
+// handshake for each one. The session's delegate forwards the callbacks for
+// each task to the RLMSessionDelegate created for that request.
+@interface RLMSessionDemultiplexer : NSObject <NSURLSessionDataDelegate>
++ (instancetype)shared;
+- (void)startRequest:(NSURLRequest *)request delegate:(RLMSessionDelegate *)delegate;
 @end
 
 NSString * const RLMHTTPMethodToNSString[] = {
@@ -49,12 +62,46 @@ NSString * const RLMHTTPMethodToNSString[] = {
     [RLMHTTPMethodDELETE] = @"DELETE"
 };
 
-@implementation RLMRequest
+// The body is stored as whichever of NSString or NSData was last set, and
+// converted to the other representation only if it is read.
+#define RLM_BODY_ACCESSORS \
+- (NSString *)body { \
+    if (!_body && _bodyData) { \
+        _body = [[NSString alloc] initWithData:_bodyData encoding:NSUTF8StringEncoding]; \
+    } \
+    return _body; \
+} \
+- (void)setBody:(NSString *)body { \
+    _body = body; \
+    _bodyData = nil; \
+} \
+- (NSData *)bodyData { \
+    if (!_bodyData && _body) { \
+        _bodyData = [_body dataUsingEncoding:NSUTF8StringEncoding]; \
+    } \
+    return _bodyData; \
+} \
+- (void)setBodyData:(NSData *)bodyData { \
+    _bodyData = bodyData; \
+    _body = nil; \
+}
+
+@implementation RLMRequest {
+    NSString *_body;
+    NSData *_bodyData;
+}
+RLM_BODY_ACCESSORS
 @end
 
-@implementation RLMResponse
+@implementation RLMResponse {
+    NSString *_body;
+    NSData *_bodyData;
+}
+RLM_BODY_ACCESSORS
 @end
 
+#undef RLM_BODY_ACCESSORS
+
 @interface RLMEventSessionDelegate <NSURLSessionDelegate> : NSObject
 + (instancetype)delegateWithEventSubscriber:(RLMEventSubscriber *)subscriber;
 @end;
@@ -68,21 +115,20 @@ NSString * const RLMHTTPMethodToNSString[] = {
     NSMutableURLRequest *urlRequest = [NSMutableURLRequest requestWithURL:requestURL];
     urlRequest.HTTPMethod = RLMHTTPMethodToNSString[request.method];
     if (![urlRequest.HTTPMethod isEqualToString:@"GET"]) {
-        urlRequest.HTTPBody = [request.body dataUsingEncoding:NSUTF8StringEncoding];
+        urlRequest.HTTPBody = request.bodyData;
     }
     urlRequest.timeoutInterval = request.timeout;
 
     for (NSString *key in request.headers) {
         [urlRequest addValue:request.headers[key] forHTTPHeaderField:key];
     }
-    id delegate = [RLMSessionDelegate delegateWithCompletion:completionBlock];
-    auto session = [NSURLSession sessionWithConfiguration:NSURLSessionConfiguration.defaultSessionConfiguration
-                                                 delegate:delegate delegateQueue:nil];
-
-    // Add the request to a task and start it
-    [[session dataTaskWithRequest:urlRequest] resume];
-    // Tell the session to destroy itself once it's done with the request
-    [session finishTasksAndInvalidate];
+    RLMSessionDelegate *delegate = [RLMSessionDelegate delegateWithCompletion:completionBlock];
+    // Only hold on to the request if something will want it for the metrics
+    if (_metricsDelegate) {
+        delegate.transport = self;
+        delegate.request = request;
+    }
+    [RLMSessionDemultiplexer.shared startRequest:urlRequest delegate:delegate];
 }
 
 - (NSURLSession *)doStreamRequest:(nonnull RLMRequest *)request
@@ -114,7 +160,7 @@ NSString * const RLMHTTPMethodToNSString[] = {
     rlmRequest.method = static_cast<RLMHTTPMethod>(request.method);
     rlmRequest.timeout = request.timeout_ms;
     rlmRequest.url = @(request.url.c_str());
-    rlmRequest.body = @(request.body.c_str());
+    rlmRequest.bodyData = [NSData dataWithBytes:request.body.data() length:request.body.size()];
     return rlmRequest;
 }
 
@@ -146,6 +192,15 @@ NSString * const RLMHTTPMethodToNSString[] = {
     [(id)_data appendData:data];
 }
 
+- (void)URLSession:(__unused NSURLSession *)session
+              task:(__unused NSURLSessionTask *)task
+didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics
+    API_AVAILABLE(macos(10.12), ios(10.0), watchos(3.0), tvos(10.0)) {
+    if (auto metricsDelegate = _transport.metricsDelegate) {
+        [metricsDelegate networkTransport:_transport request:_request didFinishCollectingMetrics:metrics];
+    }
+}
+
 - (void)URLSession:(__unused NSURLSession *)session
               task:(NSURLSessionTask *)task
 didCompleteWithError:(NSError *)error
@@ -161,13 +216,76 @@ didCompleteWithError:(NSError *)error
         return _completionBlock(response);
     }
 
-    response.body = [[NSString alloc] initWithData:_data encoding:NSUTF8StringEncoding];
+    response.bodyData = _data ?: [NSData data];
 
     _completionBlock(response);
 }
 
 @end
 
+#pragma mark RLMSessionDemultiplexer
+
+@implementation RLMSessionDemultiplexer {
+    NSURLSession *_session;
+    std::mutex _mutex;
+    NSMutableDictionary<NSNumber *, RLMSessionDelegate *> *_delegates;
+}
+
++ (instancetype)shared {
+    static RLMSessionDemultiplexer *demultiplexer;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        demultiplexer = [RLMSessionDemultiplexer new];
+        demultiplexer->_delegates = [NSMutableDictionary new];
+        // The session holds a strong reference to its delegate, which is fine
+        // as neither is ever destroyed
+        demultiplexer->_session = [NSURLSession sessionWithConfiguration:NSURLSessionConfiguration.defaultSessionConfiguration
+                                                                delegate:demultiplexer delegateQueue:nil];
+    });
+    return demultiplexer;
+}
+
+- (void)startRequest:(NSURLRequest *)request delegate:(RLMSessionDelegate *)delegate {
+    NSURLSessionDataTask *task = [_session dataTaskWithRequest:request];
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _delegates[@(task.taskIdentifier)] = delegate;
+    }
+    [task resume];
+}
+
+- (RLMSessionDelegate *)delegateForTask:(NSURLSessionTask *)task remove:(bool)remove {
+    std::lock_guard<std::mutex> lock(_mutex);
+    NSNumber *key = @(task.taskIdentifier);
+    RLMSessionDelegate *delegate = _delegates[key];
+    if (remove) {
+        [_delegates removeObjectForKey:key];
+    }
+    return delegate;
+}
+
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+    didReceiveData:(NSData *)data {
+    [[self delegateForTask:dataTask remove:false] URLSession:session dataTask:dataTask didReceiveData:data];
+}
+
+// Metrics are delivered before the task's completion, so the delegate is still registered
+- (void)URLSession:(NSURLSession *)session
+              task:(NSURLSessionTask *)task
+didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics
+    API_AVAILABLE(macos(10.12), ios(10.0), watchos(3.0), tvos(10.0)) {
+    [[self delegateForTask:task remove:false] URLSession:session task:task didFinishCollectingMetrics:metrics];
+}
+
+- (void)URLSession:(NSURLSession *)session
+              task:(NSURLSessionTask *)task
+didCompleteWithError:(NSError *)error {
+    [[self delegateForTask:task remove:true] URLSession:session task:task didCompleteWithError:error];
+}
+
+@end
+
 @implementation RLMEventSessionDelegate {
     RLMEventSubscriber *_subscriber;
     bool _hasOpened;
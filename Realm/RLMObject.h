@@ -240,6 +240,11 @@ NS_ASSUME_NONNULL_BEGIN
  set, and any change notifications produced by this call will report only which properies have
  actually changed.
 
+ Embedded objects, including those in lists, are updated in place rather than being deleted and
+ recreated. Elements of a list of embedded objects are matched by position: existing elements are
+ updated with the value at the same index, new values past the end of the list are appended, and
+ any elements past the end of the new value are deleted.
+
  Checking which properties have changed imposes a small amount of overhead, and so this method
  may be slower when all or nearly all of the properties being set have changed. If most or all
  of the properties being set have not changed, this method will be much faster than unconditionally
@@ -323,6 +328,11 @@ NS_ASSUME_NONNULL_BEGIN
  set, and any change notifications produced by this call will report only which properies have
  actually changed.
 
+ Embedded objects, including those in lists, are updated in place rather than being deleted and
+ recreated. Elements of a list of embedded objects are matched by position: existing elements are
+ updated with the value at the same index, new values past the end of the list are appended, and
+ any elements past the end of the new value are deleted.
+
  Checking which properties have changed imposes a small amount of overhead, and so this method
  may be slower when all or nearly all of the properties being set have changed. If most or all
  of the properties being set have not changed, this method will be much faster than unconditionally
@@ -374,10 +384,56 @@ NS_ASSUME_NONNULL_BEGIN
 
  Only string, integer, boolean, and `NSDate` properties are supported.
 
+ String indexes are case- and diacritic-sensitive, so queries using the `[c]`
+ or `[d]` modifiers cannot use them and instead check every object. For fast
+ case- and diacritic-insensitive lookups, store a folded copy of the string
+ (for example using `-[NSString stringByFoldingWithOptions:locale:]`) in a
+ separate indexed property and query that property without the modifiers.
+
  @return    An array of property names.
  */
 + (NSArray<NSString *> *)indexedProperties;
 
+/**
+ Returns an array of property names for `NSData` properties whose values should
+ be stored outside of the Realm file.
+
+ The values of these properties are stored in files in a directory next to the
+ Realm file, named by a hash of their contents, and the Realm file stores only
+ a small reference to the file. This keeps large values from bloating the Realm
+ file and slowing down compaction and `writeCopyToURL:encryptionKey:error:`, and
+ reading the property memory-maps the file rather than copying its contents.
+ Storing the same value multiple times only stores it once. Use
+ `-inputStreamForProperty:` to read a value as a stream.
+
+ Files for values which are no longer referenced by any object are not removed
+ automatically; call `-[RLMRealm removeUnreferencedExternalBlobs]` to remove
+ them. External blob values are not encrypted, and queries on external blob
+ properties compare the references rather than the values, so only `nil`
+ checks are meaningful. Collections of `NSData` are not supported.
+
+ @return    An array of property names.
+ */
++ (NSArray<NSString *> *)externalBlobProperties;
+
+/**
+ Override this method to specify `NSData` properties whose values should be
+ compressed in the Realm file, and the algorithm to use for each. `NSString`
+ properties cannot be compressed, as their values must be stored as valid UTF-8.
+
+ Values are compressed when they are set and decompressed when they are read,
+ which trades CPU time for a smaller file and less I/O. This works well for
+ large values such as JSON documents or HTML fragments; values which are too
+ small to benefit from compression are stored uncompressed.
+
+ Compressed properties cannot be indexed or be the primary key, and queries
+ other than `nil` checks on them do not match against the uncompressed values.
+
+ @return    A dictionary mapping property names to `RLMCompressionAlgorithm`
+            values wrapped in `NSNumber`.
+ */
++ (NSDictionary<NSString *, NSNumber *> *)compressedProperties;
+
 /**
  Override this method to specify the default values to be used for each property.
 
@@ -396,6 +452,27 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (nullable NSString *)primaryKey;
 
+/**
+ Override this method to specify the name of an `NSDate` property which records
+ when each object was created or last refreshed, for object types used as a
+ cache which should expire.
+
+ Objects whose value for this property is more than `timeToLive` seconds in
+ the past are deleted by `+[RLMRealm startExpiringObjectsWithConfiguration:interval:maximumWriteDuration:]`.
+ The property should normally be indexed.
+
+ @return    The name of the property used for expiring objects.
+ */
++ (nullable NSString *)timeToLiveProperty;
+
+/**
+ Override this method along with `timeToLiveProperty` to specify how many
+ seconds objects of this type are kept before they expire.
+
+ @return    The number of seconds after which objects expire, or 0 if they never do.
+ */
++ (NSTimeInterval)timeToLive;
+
 /**
  Override this method to specify the names of properties to ignore. These properties will not be managed by the Realm
  that manages the object.
@@ -702,6 +779,31 @@ typedef void (^RLMObjectChangeBlock)(BOOL deleted,
  */
 - (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block keyPaths:(NSArray<NSString *> *)keyPaths;
 
+/**
+ Registers a block to be called each time the object changes, optionally
+ without reading the values of the changed properties.
+
+ This behaves like `-addNotificationBlock:keyPaths:queue:`, except that if
+ `includeValues` is `NO` the `previousValue` and `value` of each
+ `RLMPropertyChange` passed to the block are `nil`. Reading the old and new
+ values requires reading each changed property both before and after each
+ write, which for large strings, data and collections can be expensive, so
+ observers which only need to know which properties changed should pass `NO`.
+
+ @param block The block to be called whenever a change occurs.
+ @param keyPaths The block will be called for changes occuring on these keypaths. If `nil`,
+ notifications are delivered for every property key path.
+ @param queue The serial queue to deliver notifications to, or `nil` to deliver them on the
+ current thread.
+ @param includeValues Whether the changes passed to the block include the old and new values
+ of the changed properties.
+ @return A token which must be held for as long as you want updates to be delivered.
+ */
+- (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block
+                                      keyPaths:(nullable NSArray<NSString *> *)keyPaths
+                                         queue:(nullable dispatch_queue_t)queue
+                                 includeValues:(BOOL)includeValues;
+
 
 #pragma mark - Other Instance Methods
 
@@ -743,6 +845,60 @@ typedef void (^RLMObjectChangeBlock)(BOOL deleted,
  */
 - (instancetype)thaw;
 
+/**
+ Returns the contents of a data or string property without copying them out of
+ the Realm file.
+
+ For managed objects the returned `NSData` points directly at the memory-mapped
+ Realm file, and keeps the version of the Realm which it was read from pinned
+ for as long as the `NSData` is alive. The contents will not change if the
+ object is later modified. String properties are returned as their UTF-8 bytes.
+
+ Unmanaged objects and objects read during a write transaction return a copy of
+ the property's value.
+
+ - warning: Holding onto the returned data for an extended period while
+ performing write transactions on the Realm may result in the Realm file
+ growing to large sizes. See
+ `RLMRealmConfiguration.maximumNumberOfActiveVersions` for more information.
+
+ @param propertyName The name of a `NSData` or `NSString` property.
+
+ @return The contents of the property, or `nil` if the property is `nil`.
+ */
+- (nullable NSData *)dataNoCopyForProperty:(NSString *)propertyName;
+
+/**
+ Returns an input stream which reads the value of a data or string property.
+
+ Properties listed in `externalBlobProperties` are streamed directly from their
+ file in the blob store without being loaded into memory. Other properties are
+ streamed from the data returned by `dataNoCopyForProperty:`.
+
+ @param propertyName The name of a `NSData` or `NSString` property.
+
+ @return An unopened input stream, or `nil` if the property is `nil`.
+ */
+- (nullable NSInputStream *)inputStreamForProperty:(NSString *)propertyName;
+
+/**
+ Returns the number of objects which link to this object through the given
+ linking objects property.
+
+ This reads the number of links directly from the Realm rather than creating
+ the `RLMLinkingObjects` collection, so it is much cheaper than reading the
+ `count` of the linking objects property when only the count is needed.
+ Unmanaged objects always return 0.
+
+ To query on whether objects are linked to from any property, use
+ `@links.@count` in a predicate, e.g. `@"@links.@count > 0"`.
+
+ @param propertyName The name of an `RLMLinkingObjects` property.
+
+ @return The number of objects linking to this object through the property.
+ */
+- (NSUInteger)backlinkCountForProperty:(NSString *)propertyName;
+
 #pragma mark - Dynamic Accessors
 
 /// :nodoc:
@@ -160,29 +160,48 @@
     return RLMObjectThaw(self);
 }
 
+- (NSData *)dataNoCopyForProperty:(NSString *)propertyName {
+    return RLMObjectBaseDataNoCopyForProperty(self, propertyName);
+}
+
+- (NSInputStream *)inputStreamForProperty:(NSString *)propertyName {
+    return RLMObjectBaseInputStreamForProperty(self, propertyName);
+}
+
+- (NSUInteger)backlinkCountForProperty:(NSString *)propertyName {
+    return RLMObjectBaseBacklinkCount(self, propertyName);
+}
+
 - (BOOL)isFrozen {
     return _realm.isFrozen;
 }
 
 - (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block {
-    return RLMObjectAddNotificationBlock(self, block, nil, nil);
+    return RLMObjectAddNotificationBlock(self, block, nil, nil, YES);
 }
 
 - (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block
                                          queue:(nonnull dispatch_queue_t)queue {
-    return RLMObjectAddNotificationBlock(self, block, nil, queue);
+    return RLMObjectAddNotificationBlock(self, block, nil, queue, YES);
 }
 
 - (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block
                                       keyPaths:(NSArray<NSString *> *)keyPaths {
-    return RLMObjectAddNotificationBlock(self, block, keyPaths, nil);
+    return RLMObjectAddNotificationBlock(self, block, keyPaths, nil, YES);
 }
 
 - (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block
                                       keyPaths:(NSArray<NSString *> *)keyPaths
                                          queue:(dispatch_queue_t)queue {
-    return RLMObjectAddNotificationBlock(self, block, keyPaths, queue);
+    return RLMObjectAddNotificationBlock(self, block, keyPaths, queue, YES);
+
+}
 
+- (RLMNotificationToken *)addNotificationBlock:(RLMObjectChangeBlock)block
+                                      keyPaths:(NSArray<NSString *> *)keyPaths
+                                         queue:(dispatch_queue_t)queue
+                                 includeValues:(BOOL)includeValues {
+    return RLMObjectAddNotificationBlock(self, block, keyPaths, queue, includeValues);
 }
 
 + (NSString *)className {
@@ -195,6 +214,14 @@
     return @[];
 }
 
++ (NSArray *)externalBlobProperties {
+    return @[];
+}
+
++ (NSDictionary *)compressedProperties {
+    return @{};
+}
+
 + (NSDictionary *)linkingObjectsProperties {
     return @{};
 }
@@ -21,6 +21,8 @@
 
 #import "RLMAccessor.h"
 #import "RLMArray_Private.hpp"
+#import "RLMBlobStore.hpp"
+#import "RLMCollection_Private.hpp"
 #import "RLMDecimal128.h"
 #import "RLMObjectSchema_Private.hpp"
 #import "RLMObjectStore.h"
@@ -38,9 +40,17 @@
 #import <realm/object-store/object_schema.hpp>
 #import <realm/object-store/shared_realm.hpp>
 
+#import <objc/message.h>
+
 using namespace realm;
 
 const NSUInteger RLMDescriptionMaxDepth = 5;
+const RLMDescriptionOptions RLMDefaultDescriptionOptions = {
+    .maxDepth = RLMDescriptionMaxDepth,
+    .maxLength = 1 << 20,
+    .maxElements = 10000,
+    .summarizeCollections = NO,
+};
 
 
 static bool isManagedAccessorClass(Class cls) {
@@ -88,8 +98,12 @@ static void maybeInitObjectSchemaForUnmanaged(RLMObjectBase *obj) {
     // This can't be a unique_ptr because associated objects are removed
     // *after* c++ members are destroyed and dealloc is called, and we need it
     // to be in a validish state when that happens
-    delete _observationInfo;
-    _observationInfo = nullptr;
+    if (_sideTable) {
+        delete _sideTable->observationInfo;
+        _sideTable->observationInfo = nullptr;
+        delete _sideTable;
+        _sideTable = nullptr;
+    }
 }
 
 static id coerceToObjectType(id obj, Class cls, RLMSchema *schema) {
@@ -134,6 +148,41 @@ static id validatedObjectForProperty(__unsafe_unretained id const obj,
     return obj;
 }
 
+// Whether the ObjC setter for the property takes an object pointer, and so can
+// be called directly rather than going through KVC to box the value. This is
+// conservative: required numeric types may be either a primitive or an
+// NSNumber, so those always use KVC.
+static bool setterTakesObject(__unsafe_unretained RLMProperty *const prop) {
+    if (prop.collection) {
+        return true;
+    }
+    switch (prop.type) {
+        case RLMPropertyTypeInt:
+        case RLMPropertyTypeBool:
+        case RLMPropertyTypeFloat:
+        case RLMPropertyTypeDouble:
+            return prop.optional;
+        default:
+            return true;
+    }
+}
+
+// Set an already-validated value on an unmanaged object, bypassing the
+// string-based KVC lookup where the property has a known setter.
+static void setUnmanagedValue(__unsafe_unretained RLMObjectBase *const obj,
+                              __unsafe_unretained RLMProperty *const prop,
+                              __unsafe_unretained id const value) {
+    if (Class swiftAccessor = prop.swiftAccessor) {
+        [swiftAccessor set:prop on:obj to:value];
+    }
+    else if (SEL setter = prop.setterSel; setter && setterTakesObject(prop) && [obj respondsToSelector:setter]) {
+        ((void (*)(id, SEL, id))objc_msgSend)(obj, setter, value);
+    }
+    else {
+        [obj setValue:value forKey:prop.name];
+    }
+}
+
 void RLMInitializeWithValue(RLMObjectBase *self, id value, RLMSchema *schema) {
     if (!value || value == NSNull.null) {
         @throw RLMException(@"Must provide a non-nil value.");
@@ -155,22 +204,24 @@ void RLMInitializeWithValue(RLMObjectBase *self, id value, RLMSchema *schema) {
         NSUInteger i = 0;
         for (id val in array) {
             RLMProperty *prop = properties[i++];
-            [self setValue:validatedObjectForProperty(RLMCoerceToNil(val), objectSchema, prop, schema)
-                    forKey:prop.name];
+            setUnmanagedValue(self, prop, validatedObjectForProperty(RLMCoerceToNil(val), objectSchema, prop, schema));
         }
     }
     else {
         // assume our object is an NSDictionary or an object with kvc properties
+        NSDictionary *dictionary = RLMDynamicCast<NSDictionary>(value);
         for (RLMProperty *prop in properties) {
-            id obj = RLMValidatedValueForProperty(value, prop.name, objectSchema.className);
+            // NSDictionary's valueForKey: is objectForKey: for keys which
+            // don't start with '@', and a missing key is just nil
+            id obj = dictionary ? [dictionary objectForKey:prop.name]
+                                : RLMValidatedValueForProperty(value, prop.name, objectSchema.className);
 
             // don't set unspecified properties
             if (!obj) {
                 continue;
             }
 
-            [self setValue:validatedObjectForProperty(RLMCoerceToNil(obj), objectSchema, prop, schema)
-                    forKey:prop.name];
+            setUnmanagedValue(self, prop, validatedObjectForProperty(RLMCoerceToNil(obj), objectSchema, prop, schema));
         }
     }
 }
@@ -180,12 +231,15 @@ id RLMCreateManagedAccessor(Class cls, RLMClassInfo *info) {
     obj->_info = info;
     obj->_realm = info->realm;
     obj->_objectSchema = info->rlmObjectSchema;
+    if (info->realm.frozen) {
+        RLMGetSideTable(obj).frozenValueCache = std::make_unique<RLMFrozenValueCache>();
+    }
     return obj;
 }
 
 - (id)valueForKey:(NSString *)key {
-    if (_observationInfo) {
-        return _observationInfo->valueForKey(key);
+    if (auto info = RLMGetObjectObservationInfo(self)) {
+        return info->valueForKey(key);
     }
     return [super valueForKey:key];
 }
@@ -251,37 +305,9 @@ id RLMCreateManagedAccessor(Class cls, RLMClassInfo *info) {
 }
 
 - (NSString *)descriptionWithMaxDepth:(NSUInteger)depth {
-    if (depth == 0) {
-        return @"<Maximum depth exceeded>";
-    }
-
-    NSString *baseClassName = _objectSchema.className;
-    NSMutableString *mString = [NSMutableString stringWithFormat:@"%@ {\n", baseClassName];
-
-    for (RLMProperty *property in _objectSchema.properties) {
-        id object = [(id)self objectForKeyedSubscript:property.name];
-        NSString *sub;
-        if ([object respondsToSelector:@selector(descriptionWithMaxDepth:)]) {
-            sub = [object descriptionWithMaxDepth:depth - 1];
-        }
-        else if (property.type == RLMPropertyTypeData) {
-            static NSUInteger maxPrintedDataLength = 24;
-            NSData *data = object;
-            NSUInteger length = data.length;
-            if (length > maxPrintedDataLength) {
-                data = [NSData dataWithBytes:data.bytes length:maxPrintedDataLength];
-            }
-            NSString *dataDescription = [data description];
-            sub = [NSString stringWithFormat:@"<%@ — %lu total bytes>", [dataDescription substringWithRange:NSMakeRange(1, dataDescription.length - 2)], (unsigned long)length];
-        }
-        else {
-            sub = [object description];
-        }
-        [mString appendFormat:@"\t%@ = %@;\n", property.name, [sub stringByReplacingOccurrencesOfString:@"\n" withString:@"\n\t"]];
-    }
-    [mString appendString:@"}"];
-
-    return [NSString stringWithString:mString];
+    RLMDescriptionOptions options = RLMDefaultDescriptionOptions;
+    options.maxDepth = depth;
+    return RLMDescriptionWithOptions(self, options);
 }
 
 - (RLMRealm *)realm {
@@ -307,17 +333,26 @@ id RLMCreateManagedAccessor(Class cls, RLMClassInfo *info) {
 }
 
 - (NSUInteger)hash {
-    if (_objectSchema.primaryKeyProperty) {
+    if (RLMProperty *primaryKeyProperty = _objectSchema.primaryKeyProperty) {
         // If we have a primary key property, that's an immutable value which we
-        // can use as the identity of the object.
-        id primaryProperty = [self valueForKey:_objectSchema.primaryKeyProperty.name];
+        // can use as the identity of the object. It's hashed the same way
+        // whether or not the object is managed so that the hash doesn't change
+        // when an object is added to a Realm. Managed objects read it straight
+        // from the row rather than going through KVC and the accessors.
+        id primaryProperty;
+        if (_realm && _row.is_valid()) {
+            primaryProperty = RLMCoerceToNil(RLMMixedToObjc(_row.get_any(_info->tableColumn(primaryKeyProperty))));
+        }
+        else {
+            primaryProperty = [self valueForKey:primaryKeyProperty.name];
+        }
 
         // modify the hash of our primary key value to avoid potential (although unlikely) collisions
         return [primaryProperty hash] ^ 1;
     }
     else if (_realm.isFrozen) {
-        // The object key can never change for frozen objects, so that's usable
-        // for objects without primary keys
+        // Frozen objects are equal only if they refer to the same object in
+        // the same Realm, and the object key of a frozen object can never change
         return static_cast<NSUInteger>(_row.get_key().value);
     }
     else {
@@ -336,6 +371,14 @@ id RLMCreateManagedAccessor(Class cls, RLMClassInfo *info) {
     return nil;
 }
 
++ (NSString *)timeToLiveProperty {
+    return nil;
+}
+
++ (NSTimeInterval)timeToLive {
+    return 0;
+}
+
 + (NSString *)_realmObjectName {
     return nil;
 }
@@ -372,18 +415,19 @@ id RLMCreateManagedAccessor(Class cls, RLMClassInfo *info) {
          forKeyPath:(NSString *)keyPath
             options:(NSKeyValueObservingOptions)options
             context:(void *)context {
-    if (!_observationInfo) {
-        _observationInfo = new RLMObservationInfo(self);
+    auto& sideTable = RLMGetSideTable(self);
+    if (!sideTable.observationInfo) {
+        sideTable.observationInfo = new RLMObservationInfo(self);
     }
-    _observationInfo->recordObserver(_row, _info, _objectSchema, keyPath);
+    sideTable.observationInfo->recordObserver(_row, _info, _objectSchema, keyPath);
 
     [super addObserver:observer forKeyPath:keyPath options:options context:context];
 }
 
 - (void)removeObserver:(NSObject *)observer forKeyPath:(NSString *)keyPath {
     [super removeObserver:observer forKeyPath:keyPath];
-    if (_observationInfo)
-        _observationInfo->removeObserver();
+    if (auto info = RLMGetObjectObservationInfo(self))
+        info->removeObserver();
 }
 
 + (BOOL)automaticallyNotifiesObserversForKey:(NSString *)key {
@@ -511,6 +555,125 @@ id RLMObjectFreeze(RLMObjectBase *obj) {
     return obj;
 }
 
+static RLMProperty *bytesProperty(RLMObjectBase *obj, NSString *propertyName) {
+    RLMProperty *prop = obj->_objectSchema[propertyName];
+    if (!prop) {
+        @throw RLMException(@"Property '%@' not found in object of type '%@'",
+                            propertyName, obj->_objectSchema.className);
+    }
+    if (prop.collection || (prop.type != RLMPropertyTypeData && prop.type != RLMPropertyTypeString)) {
+        @throw RLMException(@"Property '%@.%@' must be a data or string property",
+                            obj->_objectSchema.className, propertyName);
+    }
+    return prop;
+}
+
+// Values which aren't stored as plain bytes in the row have to be read through
+// the accessors. External blobs are memory mapped from their own immutable
+// file, so there is no version of the Realm to pin, and compressed values have
+// to be decompressed into a new buffer anyway.
+static bool readsBytesFromRow(RLMObjectBase *obj, RLMProperty *prop) {
+    return obj->_realm && !prop.externalBlob && !prop.compression;
+}
+
+static NSData *copyBytes(RLMObjectBase *obj, RLMProperty *prop) {
+    id value = RLMCoerceToNil([obj valueForKey:prop.name]);
+    if (prop.type == RLMPropertyTypeString) {
+        return [value dataUsingEncoding:NSUTF8StringEncoding];
+    }
+    return prop.externalBlob && obj->_realm ? value : [value copy];
+}
+
+static const char *rowBytes(RLMObjectBase *obj, RLMProperty *prop, size_t& size) {
+    auto col = obj->_info->tableColumn(prop);
+    if (prop.type == RLMPropertyTypeString) {
+        auto value = obj->_row.get<realm::StringData>(col);
+        size = value.size();
+        return value.is_null() ? nullptr : value.data() ?: "";
+    }
+    auto value = obj->_row.get<realm::BinaryData>(col);
+    size = value.size();
+    return value.is_null() ? nullptr : value.data() ?: "";
+}
+
+NSData *RLMObjectBaseDataNoCopyForProperty(RLMObjectBase *obj, NSString *propertyName) {
+    RLMProperty *prop = bytesProperty(obj, propertyName);
+
+    // Nothing to pin for unmanaged objects, and the current version of a Realm
+    // in a write transaction can't be frozen, so just copy the value
+    if (!readsBytesFromRow(obj, prop) || obj->_realm.inWriteTransaction) {
+        return copyBytes(obj, prop);
+    }
+
+    RLMVerifyAttached(obj);
+    RLMObjectBase *frozen = obj->_realm.frozen ? obj : RLMObjectFreeze(obj);
+    size_t size;
+    const char *bytes = rowBytes(frozen, prop, size);
+    if (!bytes) {
+        return nil;
+    }
+    if (size == 0) {
+        return [NSData data];
+    }
+
+    // The deallocator holds a strong reference to the frozen Realm to keep the
+    // version the bytes were read from alive for the lifetime of the data
+    RLMRealm *realm = frozen->_realm;
+    return [[NSData alloc] initWithBytesNoCopy:const_cast<char *>(bytes) length:size
+                                   deallocator:^(void *, NSUInteger) {
+        (void)realm;
+    }];
+}
+
+const void *RLMObjectBaseUnsafeBytesForProperty(RLMObjectBase *obj, NSString *propertyName,
+                                                NSUInteger *length, NSData **owner) {
+    RLMProperty *prop = bytesProperty(obj, propertyName);
+    *owner = nil;
+    if (!readsBytesFromRow(obj, prop)) {
+        NSData *data = copyBytes(obj, prop);
+        *owner = data;
+        *length = data.length;
+        return data.bytes;
+    }
+
+    // The bytes are read straight from the row, and so are valid until the
+    // Realm next advances or is written to on this thread
+    RLMVerifyAttached(obj);
+    size_t size;
+    const char *bytes = rowBytes(obj, prop, size);
+    *length = bytes ? size : 0;
+    return bytes;
+}
+
+NSInputStream *RLMObjectBaseInputStreamForProperty(RLMObjectBase *obj, NSString *propertyName) {
+    RLMProperty *prop = obj->_objectSchema[propertyName];
+    if (prop.externalBlob && obj->_realm) {
+        RLMVerifyAttached(obj);
+        auto value = obj->_row.get<realm::BinaryData>(obj->_info->tableColumn(prop));
+        if (value.is_null()) {
+            return nil;
+        }
+        return [NSInputStream inputStreamWithFileAtPath:RLMBlobPath(obj->_realm->_realm->config().path, value)];
+    }
+    NSData *data = RLMObjectBaseDataNoCopyForProperty(obj, propertyName);
+    return data ? [NSInputStream inputStreamWithData:data] : nil;
+}
+
+NSUInteger RLMObjectBaseBacklinkCount(RLMObjectBase *obj, NSString *propertyName) {
+    RLMProperty *prop = obj->_objectSchema[propertyName];
+    if (prop.type != RLMPropertyTypeLinkingObjects) {
+        @throw RLMException(@"Property '%@' is not a linking objects property of object of type '%@'",
+                            propertyName, obj->_objectSchema.className);
+    }
+    // Unmanaged objects can't be linked to by anything
+    if (!obj->_realm) {
+        return 0;
+    }
+    RLMVerifyAttached(obj);
+    RLMClassInfo& originInfo = obj->_realm->_info[prop.objectClassName];
+    return obj->_row.get_backlink_count(*originInfo.table(), originInfo.tableColumn(prop.linkOriginPropertyName));
+}
+
 id RLMObjectThaw(RLMObjectBase *obj) {
     if (!obj->_realm && !obj.isInvalidated) {
         @throw RLMException(@"Unmanaged objects cannot be frozen.");
@@ -537,10 +700,71 @@ id RLMValidatedValueForProperty(id object, NSString *key, NSString *className) {
 
 #pragma mark - Notifications
 
+// The persisted and computed properties of an object type indexed by table
+// column, so that the names of the changed properties can be found from the
+// changed columns without looking up the column of every property on every
+// notification. Column keys are resolved against a specific RLMRealm's schema,
+// so this lives on the RLMClassInfo.
+class RLMChangedPropertyMap {
+public:
+    RLMChangedPropertyMap(RLMClassInfo& info) {
+        RLMObjectSchema *objectSchema = info.rlmObjectSchema;
+        auto add = [&](RLMProperty *property, realm::ColKey col) {
+            // It's possible for the column key of a persisted property to equal
+            // the column key of a computed property, so a column can map to
+            // more than one property
+            _columns[col.value].push_back(_names.size());
+            _names.push_back(property.name);
+        };
+        _names.reserve(objectSchema.properties.count + objectSchema.computedProperties.count);
+        for (RLMProperty *property in objectSchema.properties) {
+            add(property, info.tableColumn(property));
+        }
+        for (RLMProperty *property in objectSchema.computedProperties) {
+            add(property, info.computedTableColumn(property));
+        }
+    }
+
+    // The names of the properties stored in the changed columns, in schema
+    // order, or nil if none of them are.
+    NSArray<NSString *> *changedProperties(realm::CollectionChangeSet const& c) const {
+        std::vector<bool> changed(_names.size());
+        size_t count = 0;
+        for (auto& [col, _] : c.columns) {
+            auto it = _columns.find(col);
+            if (it == _columns.end()) {
+                continue;
+            }
+            for (size_t index : it->second) {
+                changed[index] = true;
+                ++count;
+            }
+        }
+        if (!count) {
+            return nil;
+        }
+
+        auto properties = [NSMutableArray arrayWithCapacity:count];
+        for (size_t i = 0; i < changed.size(); ++i) {
+            if (changed[i]) {
+                [properties addObject:_names[i]];
+            }
+        }
+        return properties;
+    }
+
+private:
+    std::unordered_map<int64_t, std::vector<size_t>> _columns;
+    std::vector<NSString *> _names;
+};
+
 namespace {
 struct ObjectChangeCallbackWrapper {
     RLMObjectNotificationCallback block;
     RLMObjectBase *object;
+    // If false, only the names of the changed properties are reported, which
+    // avoids reading each changed property both before and after the change
+    bool includeValues;
 
     NSArray<NSString *> *propertyNames = nil;
     NSArray *oldValues = nil;
@@ -558,24 +782,11 @@ struct ObjectChangeCallbackWrapper {
             return;
         }
 
-        // FIXME: It's possible for the column key of a persisted property
-        // to equal the column key of a computed property.
-        auto properties = [NSMutableArray new];
-        for (RLMProperty *property in object->_info->rlmObjectSchema.properties) {
-            auto columnKey = object->_info->tableColumn(property).value;
-            if (c.columns.count(columnKey)) {
-                [properties addObject:property.name];
-            }
-        }
-        for (RLMProperty *property in object->_info->rlmObjectSchema.computedProperties) {
-            auto columnKey = object->_info->computedTableColumn(property).value;
-            if (c.columns.count(columnKey)) {
-                [properties addObject:property.name];
-            }
-        }
-        if (properties.count) {
-            propertyNames = properties;
+        auto& info = *object->_info;
+        if (!info.changedPropertyMap) {
+            info.changedPropertyMap = std::make_shared<RLMChangedPropertyMap>(info);
         }
+        propertyNames = info.changedPropertyMap->changedProperties(c);
     }
 
     NSArray *readValues(realm::CollectionChangeSet const& c) {
@@ -601,6 +812,9 @@ struct ObjectChangeCallbackWrapper {
     }
 
     void before(realm::CollectionChangeSet const& c) {
+        if (!includeValues) {
+            return;
+        }
         @autoreleasepool {
             oldValues = readValues(c);
         }
@@ -608,6 +822,19 @@ struct ObjectChangeCallbackWrapper {
 
     void after(realm::CollectionChangeSet const& c) {
         @autoreleasepool {
+            if (!includeValues) {
+                if (!c.empty()) {
+                    populateProperties(c);
+                }
+                if (deleted) {
+                    block(nil, nil, nil, nil, nil);
+                }
+                else if (propertyNames) {
+                    block(object, propertyNames, nil, nil, nil);
+                }
+                propertyNames = nil;
+                return;
+            }
             auto newValues = readValues(c);
             if (deleted) {
                 block(nil, nil, nil, nil, nil);
@@ -680,6 +907,7 @@ struct ObjectChangeCallbackWrapper {
          threadSafeReference:(RLMThreadSafeReference *)tsr
                       config:(RLMRealmConfiguration *)config
                     keyPaths:(KeyPathArray)keyPaths
+               includeValues:(bool)includeValues
                        queue:(dispatch_queue_t)queue {
     std::lock_guard<std::mutex> lock(_mutex);
     if (!_realm) {
@@ -696,18 +924,22 @@ struct ObjectChangeCallbackWrapper {
     RLMObjectBase *obj = [realm resolveThreadSafeReference:tsr];
 
     _object = realm::Object(obj->_realm->_realm, *obj->_info->objectSchema, obj->_row);
-    _token = _object.add_notification_callback(ObjectChangeCallbackWrapper{block, obj}, std::move(keyPaths));
+    _token = _object.add_notification_callback(ObjectChangeCallbackWrapper{block, obj, includeValues},
+                                               std::move(keyPaths));
 }
 
-- (void)addNotificationBlock:(RLMObjectNotificationCallback)block object:(RLMObjectBase *)obj keyPaths:(KeyPathArray)keyPaths {
+- (void)addNotificationBlock:(RLMObjectNotificationCallback)block object:(RLMObjectBase *)obj
+                    keyPaths:(KeyPathArray)keyPaths includeValues:(bool)includeValues {
     _object = realm::Object(obj->_realm->_realm, *obj->_info->objectSchema, obj->_row);
     _realm = obj->_realm;
-    _token = _object.add_notification_callback(ObjectChangeCallbackWrapper{block, obj}, std::move(keyPaths));
+    _token = _object.add_notification_callback(ObjectChangeCallbackWrapper{block, obj, includeValues},
+                                               std::move(keyPaths));
 }
 
 RLMNotificationToken *RLMObjectBaseAddNotificationBlock(RLMObjectBase *obj,
                                                         NSArray<NSString *> *keyPaths,
                                                         dispatch_queue_t queue,
+                                                        BOOL includeValues,
                                                         RLMObjectNotificationCallback block) {
     if (!obj->_realm) {
         @throw RLMException(@"Only objects which are managed by a Realm support change notifications");
@@ -719,7 +951,7 @@ RLMNotificationToken *RLMObjectBaseAddNotificationBlock(RLMObjectBase *obj,
         [obj->_realm verifyNotificationsAreSupported:true];
         auto token = [[RLMObjectNotificationToken alloc] init];
         token->_realm = obj->_realm;
-        [token addNotificationBlock:block object:obj keyPaths:std::move(keyPathArray)];
+        [token addNotificationBlock:block object:obj keyPaths:std::move(keyPathArray) includeValues:includeValues];
         return token;
     }
 
@@ -729,7 +961,8 @@ RLMNotificationToken *RLMObjectBaseAddNotificationBlock(RLMObjectBase *obj,
     RLMRealmConfiguration *config = obj->_realm.configuration;
     dispatch_async(queue, ^{
         @autoreleasepool {
-            [token addNotificationBlock:block threadSafeReference:tsr config:config keyPaths:std::move(keyPathArray) queue:queue];
+            [token addNotificationBlock:block threadSafeReference:tsr config:config keyPaths:std::move(keyPathArray)
+                          includeValues:includeValues queue:queue];
         }
     });
     return token;
@@ -737,8 +970,9 @@ RLMNotificationToken *RLMObjectBaseAddNotificationBlock(RLMObjectBase *obj,
 
 @end
 
-RLMNotificationToken *RLMObjectAddNotificationBlock(RLMObjectBase *obj, RLMObjectChangeBlock block, NSArray<NSString *> *keyPaths, dispatch_queue_t queue) {
-    return RLMObjectBaseAddNotificationBlock(obj, keyPaths, queue, ^(RLMObjectBase *, NSArray<NSString *> *propertyNames,
+RLMNotificationToken *RLMObjectAddNotificationBlock(RLMObjectBase *obj, RLMObjectChangeBlock block, NSArray<NSString *> *keyPaths,
+                                                    dispatch_queue_t queue, BOOL includeValues) {
+    return RLMObjectBaseAddNotificationBlock(obj, keyPaths, queue, includeValues, ^(RLMObjectBase *, NSArray<NSString *> *propertyNames,
                                                            NSArray *oldValues, NSArray *newValues, NSError *error) {
         if (error) {
             block(false, nil, error);
@@ -36,8 +36,19 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @interface RLMObjectId : NSObject
 /// Creates a new randomly-initialized ObjectId.
+///
+/// ObjectIds are generated using state local to the calling thread, so
+/// generating them concurrently from many threads does not contend on a lock.
 + (nonnull instancetype)objectId NS_SWIFT_NAME(generate());
 
+/// Creates the given number of new ObjectIds.
+///
+/// This is faster than calling `+objectId` repeatedly when generating keys for
+/// a large number of objects at once.
+///
+/// @param count The number of ObjectIds to generate.
++ (NSArray<RLMObjectId *> *)objectIdsWithCount:(NSUInteger)count NS_SWIFT_NAME(objectIds(count:));
+
 /// Creates a new zero-initialized ObjectId.
 - (instancetype)init;
 
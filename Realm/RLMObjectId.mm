@@ -22,6 +22,55 @@
 
 #import <realm/object_id.hpp>
 
+#import <ctime>
+
+namespace {
+// Generates ObjectIds without touching any state shared between threads, as
+// realm::ObjectId::gen() does. Each thread picks its own random value for the
+// five "process unique" bytes, so ids generated by different threads don't
+// collide despite having independent counters.
+class ObjectIdGenerator {
+public:
+    realm::ObjectId next(uint32_t seconds) noexcept {
+        // Pick new random bytes whenever the counter has wrapped around so
+        // that ids generated in the same second can't repeat
+        if (m_remaining == 0) {
+            reseed();
+        }
+        --m_remaining;
+        uint32_t counter = m_counter++ & 0xFFFFFF;
+
+        realm::ObjectId::ObjectIdBytes bytes;
+        bytes[0] = uint8_t(seconds >> 24);
+        bytes[1] = uint8_t(seconds >> 16);
+        bytes[2] = uint8_t(seconds >> 8);
+        bytes[3] = uint8_t(seconds);
+        memcpy(&bytes[4], m_random, sizeof(m_random));
+        bytes[9] = uint8_t(counter >> 16);
+        bytes[10] = uint8_t(counter >> 8);
+        bytes[11] = uint8_t(counter);
+        return realm::ObjectId(bytes);
+    }
+
+private:
+    uint8_t m_random[5];
+    uint32_t m_counter = 0;
+    uint32_t m_remaining = 0;
+
+    void reseed() noexcept {
+        arc4random_buf(m_random, sizeof(m_random));
+        m_counter = arc4random_uniform(1 << 24);
+        m_remaining = 1 << 24;
+    }
+};
+
+thread_local ObjectIdGenerator s_generator;
+
+uint32_t currentSeconds() noexcept {
+    return static_cast<uint32_t>(time(nullptr));
+}
+} // anonymous namespace
+
 // Swift's obj-c bridging does not support making an obj-c defined class conform
 // to Decodable, so we need a Swift-defined subclass for that. This means that
 // when Realm Swift is being used, we need to produce objects of that type rather
@@ -51,8 +100,7 @@
 
 - (instancetype)initWithString:(NSString *)string error:(NSError **)error {
     if ((self = [self init])) {
-        const char *str = string.UTF8String;
-        if (!realm::ObjectId::is_valid_str(str)) {
+        if (!RLMParseObjectId(string, _value)) {
             if (error) {
                 NSString *msg = [NSString stringWithFormat:@"Invalid Object ID string '%@': must be 24 hex digits", string];
                 *error = [NSError errorWithDomain:RLMErrorDomain
@@ -61,7 +109,6 @@
             }
             return nil;
         }
-        _value = realm::ObjectId(str);
     }
     return self;
 }
@@ -83,7 +130,17 @@
 }
 
 + (instancetype)objectId {
-    return [[RLMObjectId alloc] initWithValue:realm::ObjectId::gen()];
+    return [[RLMObjectId alloc] initWithValue:s_generator.next(currentSeconds())];
+}
+
++ (NSArray<RLMObjectId *> *)objectIdsWithCount:(NSUInteger)count {
+    auto& generator = s_generator;
+    uint32_t seconds = currentSeconds();
+    NSMutableArray *objectIds = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger i = 0; i < count; ++i) {
+        [objectIds addObject:[[RLMObjectId alloc] initWithValue:generator.next(seconds)]];
+    }
+    return objectIds;
 }
 
 - (BOOL)isEqual:(id)object {
@@ -18,6 +18,7 @@
 
 #import "RLMObjectSchema_Private.hpp"
 
+#import "RLMAccessor.h"
 #import "RLMEmbeddedObject.h"
 #import "RLMObject_Private.h"
 #import "RLMProperty_Private.hpp"
@@ -28,9 +29,13 @@
 #import "RLMSwiftSupport.h"
 #import "RLMUtil.hpp"
 
+#import <realm/group.hpp>
 #import <realm/object-store/object_schema.hpp>
 #import <realm/object-store/object_store.hpp>
 
+#import <atomic>
+#import <mutex>
+
 using namespace realm;
 
 // private properties
@@ -41,8 +46,13 @@ using namespace realm;
 
 @implementation RLMObjectSchema {
     std::string _objectStoreName;
+    Class _accessorClass;
+    // Set when the managed accessor class has been requested but not yet
+    // created; see -setNeedsManagedAccessorClass
+    std::atomic<bool> _accessorClassPending;
 }
 
+
 - (instancetype)initWithClassName:(NSString *)objectClassName objectClass:(Class)objectClass properties:(NSArray *)properties {
     self = [super init];
     self.className = objectClassName;
@@ -53,11 +63,83 @@ using namespace realm;
     return self;
 }
 
+- (void)setNeedsManagedAccessorClass {
+    if (_accessorClass == _objectClass) {
+        _accessorClassPending.store(true, std::memory_order_release);
+    }
+}
+
+- (Class)accessorClass {
+    if (_accessorClassPending.load(std::memory_order_acquire)) {
+        [self createManagedAccessorClass];
+    }
+    return _accessorClass;
+}
+
+- (void)setAccessorClass:(Class)accessorClass {
+    _accessorClass = accessorClass;
+    _accessorClassPending.store(false, std::memory_order_release);
+}
+
+// The generated accessor methods depend only on the object class and on the
+// position and kind of each property, as the column keys are looked up through
+// the object's RLMClassInfo at runtime. Any two schemas with the same key can
+// therefore share an accessor class.
+static NSString *accessorClassKey(RLMObjectSchema *objectSchema) {
+    NSMutableString *key = [NSMutableString stringWithFormat:@"%p", objectSchema.objectClass];
+    auto append = [&](RLMProperty *prop) {
+        [key appendFormat:@"|%@:%d:%d:%d:%d%d%d:%@:%@", prop.name, (int)prop.type, (int)prop.optional,
+         (int)prop.isPrimary, (int)prop.array, (int)prop.set, (int)prop.dictionary,
+         prop.objectClassName ?: @"", prop.linkOriginPropertyName ?: @""];
+    };
+    for (RLMProperty *prop in objectSchema.properties) {
+        append(prop);
+    }
+    [key appendString:@"|"];
+    for (RLMProperty *prop in objectSchema.computedProperties) {
+        append(prop);
+    }
+    return key;
+}
+
+- (void)createManagedAccessorClass {
+    static constexpr size_t bufferSize = sizeof("RLM:Managed  ") // includes null terminator
+                                       + std::numeric_limits<unsigned long long>::digits10
+                                       + realm::Group::max_table_name_length;
+    static std::mutex s_mutex;
+    static unsigned long long s_count = 0;
+    static NSMutableDictionary<NSString *, Class> *s_accessorClasses = [NSMutableDictionary new];
+
+    NSString *key = accessorClassKey(self);
+    std::lock_guard<std::mutex> lock(s_mutex);
+    // Another thread may have created it while we were waiting for the lock
+    if (!_accessorClassPending.load(std::memory_order_relaxed)) {
+        return;
+    }
+    Class accessorClass = s_accessorClasses[key];
+    if (!accessorClass) {
+        char className[bufferSize];
+        snprintf(className, bufferSize, "RLM:Managed %llu %s", s_count++, _className.UTF8String);
+        accessorClass = RLMManagedAccessorClassForObjectClass(_objectClass, self, className);
+        s_accessorClasses[key] = accessorClass;
+    }
+    _accessorClass = accessorClass;
+    _accessorClassPending.store(false, std::memory_order_release);
+}
+
 // return properties by name
 - (RLMProperty *)objectForKeyedSubscript:(__unsafe_unretained NSString *const)key {
     return _allPropertiesByName[key];
 }
 
+- (RLMPropertyHandle *)handleForProperty:(NSString *)propertyName {
+    RLMProperty *prop = _allPropertiesByName[propertyName];
+    if (!prop) {
+        @throw RLMException(@"Invalid property name '%@' for class '%@'.", propertyName, _className);
+    }
+    return [[RLMPropertyHandle alloc] initWithObjectSchema:self property:prop];
+}
+
 // create property map when setting property array
 - (void)setProperties:(NSArray *)properties {
     _properties = properties;
@@ -192,6 +274,42 @@ using namespace realm;
         }
     }
 
+    if ([objectClass respondsToSelector:@selector(externalBlobProperties)]) {
+        for (NSString *propertyName in [objectClass externalBlobProperties]) {
+            RLMProperty *prop = schema[propertyName];
+            if (!prop) {
+                @throw RLMException(@"External blob property '%@' does not exist on object '%@'", propertyName, className);
+            }
+            if (prop.type != RLMPropertyTypeData || prop.collection || prop.indexed) {
+                @throw RLMException(@"Property '%@.%@' cannot be stored as an external blob because it is not a non-indexed 'data' property.",
+                                    className, propertyName);
+            }
+            prop.externalBlob = YES;
+        }
+    }
+
+    if ([objectClass respondsToSelector:@selector(compressedProperties)]) {
+        NSDictionary<NSString *, NSNumber *> *compressed = [objectClass compressedProperties];
+        for (NSString *propertyName in compressed) {
+            RLMProperty *prop = schema[propertyName];
+            if (!prop) {
+                @throw RLMException(@"Compressed property '%@' does not exist on object '%@'", propertyName, className);
+            }
+            // String columns must hold valid UTF-8, which compressed bytes
+            // aren't, so only data properties can be compressed
+            if (prop.type != RLMPropertyTypeData || prop.collection || prop.indexed || prop.externalBlob) {
+                @throw RLMException(@"Property '%@.%@' cannot be compressed because it is not a non-indexed 'data' property.",
+                                    className, propertyName);
+            }
+            auto algorithm = static_cast<RLMCompressionAlgorithm>(compressed[propertyName].integerValue);
+            if (algorithm < RLMCompressionAlgorithmLZ4 || algorithm > RLMCompressionAlgorithmLZMA) {
+                @throw RLMException(@"Invalid compression algorithm %@ for property '%@.%@'.",
+                                    compressed[propertyName], className, propertyName);
+            }
+            prop.compression = algorithm;
+        }
+    }
+
     for (RLMProperty *prop in schema.properties) {
         if (prop.optional && prop.collection && !prop.dictionary && (prop.type == RLMPropertyTypeObject || prop.type == RLMPropertyTypeLinkingObjects)) {
             // FIXME: message is awkward
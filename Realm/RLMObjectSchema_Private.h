@@ -22,6 +22,8 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class RLMPropertyHandle;
+
 // RLMObjectSchema private
 @interface RLMObjectSchema () {
 @public
@@ -46,8 +48,18 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, copy) NSArray<RLMProperty *> *computedProperties;
 @property (nonatomic, readonly, nullable) NSArray<RLMProperty *> *swiftGenericProperties;
 
+// Request a managed accessor class for this schema. Creating the accessor
+// class is fairly expensive and most apps only ever use a few of their object
+// types at a time, so it is created the first time `accessorClass` is read.
+// Does nothing if the schema already has a non-default accessor class.
+- (void)setNeedsManagedAccessorClass;
+
 // returns a cached or new schema for a given object class
 + (instancetype)schemaForObjectClass:(Class)objectClass;
+
+// Returns a handle for the named property for use with `RLMDynamicGetWithHandle()`
+// and `RLMDynamicValidatedSetWithHandle()`. Throws if there is no such property.
+- (RLMPropertyHandle *)handleForProperty:(NSString *)propertyName;
 @end
 
 @interface RLMObjectSchema (Dynamic)
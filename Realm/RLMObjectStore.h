@@ -16,7 +16,7 @@
 //
 ////////////////////////////////////////////////////////////////////////////
 
-#import <Foundation/Foundation.h>
+#import <Realm/RLMRealm_Dynamic.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -54,21 +54,49 @@ void RLMAddObjectToRealm(RLMObjectBase *object, RLMRealm *realm, RLMUpdatePolicy
 // delete an object from its realm
 void RLMDeleteObjectFromRealm(RLMObjectBase *object, RLMRealm *realm);
 
+// delete all of the given objects from the realm, validating all of them before
+// deleting any and tracking observers once for the whole batch
+void RLMDeleteObjectsFromRealm(id<NSFastEnumeration> objects, RLMRealm *realm);
+
 // deletes all objects from a realm
 void RLMDeleteAllObjectsFromRealm(RLMRealm *realm);
 
+// deletes all objects from a realm without sending KVO notifications for
+// observed objects
+void RLMTruncateAllObjectsInRealm(RLMRealm *realm);
+
 // get objects of a given class
 RLMResults *RLMGetObjects(RLMRealm *realm, NSString *objectClassName, NSPredicate * _Nullable predicate)
 NS_RETURNS_RETAINED;
 
+// get objects of a given class matching a predicate containing `$name`
+// variables, using the value at each index of `values` for the variable at the
+// same index of `variables`
+RLMResults *RLMGetObjectsWithPredicateTemplate(RLMRealm *realm, NSString *objectClassName, NSPredicate *predicate,
+                                               NSArray<NSString *> *variables, NSArray *values)
+NS_RETURNS_RETAINED;
+
 // get an object with the given primary key
 id _Nullable RLMGetObject(RLMRealm *realm, NSString *objectClassName, id _Nullable key) NS_RETURNS_RETAINED;
 
+// get the objects with each of the given primary keys, with NSNull for keys
+// which have no object
+NSArray *RLMGetObjectsForPrimaryKeys(RLMRealm *realm, NSString *objectClassName,
+                                     id<NSFastEnumeration> keys) NS_RETURNS_RETAINED;
+
 // create object from array or dictionary
 RLMObjectBase *RLMCreateObjectInRealmWithValue(RLMRealm *realm, NSString *className,
                                                id _Nullable value, RLMUpdatePolicy updatePolicy)
 NS_RETURNS_RETAINED;
 
+// create objects from a sequence of arrays, dictionaries or KVC-compatible
+// objects without creating accessors for the newly created objects. Unmanaged
+// RLMObjects in `values` are copied rather than promoted to managed accessors.
+// With RLMUpdatePolicyUpdateChanged, existing objects which would not be
+// changed are skipped entirely and counted as unchanged.
+RLMUpsertCounts RLMCreateObjectsInRealmWithValues(RLMRealm *realm, NSString *className,
+                                                  id<NSFastEnumeration> values, RLMUpdatePolicy updatePolicy);
+
 //
 // Accessor Creation
 //
@@ -79,6 +107,10 @@ NS_RETURNS_RETAINED;
 // unmanaged object, and false if it is a newly created object.
 void RLMInitializeSwiftAccessor(RLMObjectBase *object, bool promotingExisting);
 
+// The Swift properties initialized by RLMInitializeSwiftAccessor() which have
+// to be initialized again if the accessor is pointed at a different row
+NSArray<RLMProperty *> *RLMSwiftPropertiesDependingOnRow(RLMObjectBase *object);
+
 #ifdef __cplusplus
 }
 
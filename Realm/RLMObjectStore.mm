@@ -37,27 +37,16 @@
 #import <realm/object-store/results.hpp>
 #import <realm/object-store/shared_realm.hpp>
 #import <realm/group.hpp>
+#import <realm/util/overload.hpp>
 
 #import <objc/message.h>
+#import <numeric>
 
 using namespace realm;
 
 void RLMRealmCreateAccessors(RLMSchema *schema) {
-    const size_t bufferSize = sizeof("RLM:Managed  ") // includes null terminator
-                            + std::numeric_limits<unsigned long long>::digits10
-                            + realm::Group::max_table_name_length;
-
-    char className[bufferSize] = "RLM:Managed ";
-    char *const start = className + strlen(className);
-
     for (RLMObjectSchema *objectSchema in schema.objectSchema) {
-        if (objectSchema.accessorClass != objectSchema.objectClass) {
-            continue;
-        }
-
-        static unsigned long long count = 0;
-        sprintf(start, "%llu %s", count++, objectSchema.className.UTF8String);
-        objectSchema.accessorClass = RLMManagedAccessorClassForObjectClass(objectSchema.objectClass, objectSchema, className);
+        [objectSchema setNeedsManagedAccessorClass];
     }
 }
 
@@ -103,6 +92,19 @@ void RLMInitializeSwiftAccessor(__unsafe_unretained RLMObjectBase *const object,
     }
 }
 
+NSArray<RLMProperty *> *RLMSwiftPropertiesDependingOnRow(__unsafe_unretained RLMObjectBase *const object) {
+    if (!object->_objectSchema->_isSwiftClass || ![object isKindOfClass:object->_objectSchema.objectClass]) {
+        return @[];
+    }
+    NSMutableArray<RLMProperty *> *properties = [NSMutableArray new];
+    for (RLMProperty *prop in object->_objectSchema.swiftGenericProperties) {
+        if ([prop.swiftAccessor initializationDependsOnRow]) {
+            [properties addObject:prop];
+        }
+    }
+    return properties;
+}
+
 void RLMVerifyHasPrimaryKey(Class cls) {
     RLMObjectSchema *schema = [cls sharedSchema];
     if (!schema.primaryKeyProperty) {
@@ -126,6 +128,16 @@ static CreatePolicy updatePolicyToCreatePolicy(RLMUpdatePolicy policy) {
     return createPolicy;
 }
 
+// Convert a validated, non-nil value for a non-collection, non-link property to
+// a Mixed of the property's type
+static Mixed RLMPropertyValueToMixed(RLMStatelessAccessorContext& ctx, RLMRealm *realm,
+                                     RLMProperty *prop, __unsafe_unretained id const value) {
+    return switch_on_type(static_cast<realm::PropertyType>(prop.type), realm::util::overload{
+        [&](realm::Obj*) -> Mixed { REALM_UNREACHABLE(); },
+        [&](realm::Mixed*) { return RLMObjcToMixed(value, realm); },
+        [&](auto t) { return Mixed(ctx.unbox<std::decay_t<decltype(*t)>>(value)); }});
+}
+
 void RLMAddObjectToRealm(__unsafe_unretained RLMObjectBase *const object,
                          __unsafe_unretained RLMRealm *const realm,
                          RLMUpdatePolicy updatePolicy) {
@@ -157,6 +169,102 @@ RLMObjectBase *RLMCreateObjectInRealmWithValue(RLMRealm *realm, NSString *classN
     return object;
 }
 
+// Check if there is an existing object with the primary key given in `value`
+// which `value` would leave unchanged. Only properties whose stored value can be
+// compared directly are checked, so if `value` sets any link or collection
+// properties the object is reported as possibly changed and is left to the
+// property-by-property update in createObject().
+static bool RLMIsUnchangedExistingObject(RLMAccessorContext& c, RLMRealm *realm, RLMClassInfo& info,
+                                         Table& table, __unsafe_unretained id const value) {
+    if (!value || value == NSNull.null) {
+        return false;
+    }
+    auto& objectSchema = *info.objectSchema;
+    auto& properties = objectSchema.persisted_properties;
+    RLMObjectSchema *rlmObjectSchema = info.rlmObjectSchema;
+    RLMProperty *primaryKey = info.propertyForPrimaryKey();
+    size_t primaryKeyIndex = [rlmObjectSchema.properties indexOfObject:primaryKey];
+
+    // A missing primary key will use the default value, which is left
+    // to createObject() to resolve
+    auto pk = c.value_for_property(value, properties[primaryKeyIndex], primaryKeyIndex);
+    if (!pk) {
+        return false;
+    }
+    RLMStatelessAccessorContext ctx;
+    id pkValue = RLMCoerceToNil(*pk);
+    auto key = table.find_primary_key(pkValue ? RLMPropertyValueToMixed(ctx, realm, primaryKey, pkValue) : Mixed());
+    if (!key) {
+        return false;
+    }
+    auto obj = table.get_object(key);
+
+    for (size_t i = 0; i < properties.size(); ++i) {
+        if (i == primaryKeyIndex) {
+            continue;
+        }
+        auto optionalValue = c.value_for_property(value, properties[i], i);
+        if (!optionalValue) {
+            // Properties missing from the value are not modified
+            continue;
+        }
+        RLMProperty *prop = rlmObjectSchema.properties[i];
+        if (prop.collection || prop.type == RLMPropertyTypeObject) {
+            return false;
+        }
+        id propValue = RLMCoerceToNil(*optionalValue);
+        if (prop.type == RLMPropertyTypeAny && [propValue isKindOfClass:[RLMObjectBase class]]) {
+            return false;
+        }
+        auto newValue = propValue ? RLMPropertyValueToMixed(ctx, realm, prop, propValue) : Mixed();
+        // Mixed compares numeric values of different types as equal, but
+        // changing the type of a mixed property's value is still a change
+        auto oldValue = obj.get_any(properties[i].column_key);
+        if (oldValue.is_null() != newValue.is_null()) {
+            return false;
+        }
+        if (!oldValue.is_null() && (oldValue.get_type() != newValue.get_type() || oldValue != newValue)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+RLMUpsertCounts RLMCreateObjectsInRealmWithValues(RLMRealm *realm, NSString *className,
+                                                  id<NSFastEnumeration> values, RLMUpdatePolicy updatePolicy) {
+    RLMVerifyInWriteTransaction(realm);
+
+    CreatePolicy createPolicy = updatePolicyToCreatePolicy(updatePolicy);
+    createPolicy.copy = true;
+
+    // Resolve the class info and set up a single context for the whole batch
+    // so that the schema lookup and default values are only computed once
+    auto& info = realm->_info[className];
+    RLMAccessorContext c{info};
+    RLMUpsertCounts counts{};
+    auto table = info.table();
+    bool skipUnchanged = updatePolicy == RLMUpdatePolicyUpdateChanged && info.propertyForPrimaryKey();
+    for (id value in values) {
+        // Most of the objects in a large upsert are often unchanged, so compare
+        // the stored values up front and skip both the write and the change
+        // notifications for unchanged objects
+        if (skipUnchanged && RLMIsUnchangedExistingObject(c, realm, info, *table, value)) {
+            ++counts.unchanged;
+            continue;
+        }
+
+        size_t size = table->size();
+        c.createObject(value, createPolicy, true);
+        if (table->size() > size) {
+            ++counts.inserted;
+        }
+        else {
+            ++counts.updated;
+        }
+    }
+    return counts;
+}
+
 RLMObjectBase *RLMObjectFromObjLink(RLMRealm *realm, realm::ObjLink&& objLink, bool parentIsSwiftObject) {
     if (auto* tableInfo = realm->_info[objLink.get_table_key()]) {
         return RLMCreateObjectAccessor(*tableInfo, objLink.get_obj_key().value);
@@ -191,6 +299,51 @@ void RLMDeleteObjectFromRealm(__unsafe_unretained RLMObjectBase *const object,
     object->_realm = nil;
 }
 
+void RLMDeleteObjectsFromRealm(id<NSFastEnumeration> objects, __unsafe_unretained RLMRealm *const realm) {
+    std::vector<RLMObjectBase *> accessors;
+    std::vector<std::pair<realm::TableKey, realm::ObjKey>> keys;
+    for (id obj in objects) {
+        if (![obj isKindOfClass:RLMObjectBase.class]) {
+            @throw RLMException(@"Cannot delete objects of type %@ with deleteObjects:. Only RLMObjects can be deleted.",
+                                NSStringFromClass([obj class]));
+        }
+        RLMObjectBase *object = obj;
+        if (realm != object->_realm) {
+            @throw RLMException(@"Can only delete an object from the Realm it belongs to.");
+        }
+        if (object->_row.is_valid()) {
+            keys.emplace_back(object->_row.get_table()->get_key(), object->_row.get_key());
+        }
+        accessors.push_back(object);
+    }
+
+    RLMVerifyInWriteTransaction(realm);
+
+    if (!keys.empty()) {
+        // Sort so that each table is looked up once and duplicates are skipped
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        RLMObservationTracker tracker(realm, true);
+        auto& group = realm.group;
+        realm::TableRef table;
+        for (auto& [tableKey, objKey] : keys) {
+            if (!table || table->get_key() != tableKey) {
+                table = group.get_table(tableKey);
+            }
+            // Objects may have already been removed by a cascading delete
+            // from an earlier object in the batch
+            if (table->is_valid(objKey)) {
+                table->remove_object(objKey);
+            }
+        }
+    }
+
+    for (RLMObjectBase *object : accessors) {
+        object->_realm = nil;
+    }
+}
+
 void RLMDeleteAllObjectsFromRealm(RLMRealm *realm) {
     RLMVerifyInWriteTransaction(realm);
 
@@ -200,6 +353,14 @@ void RLMDeleteAllObjectsFromRealm(RLMRealm *realm) {
     }
 }
 
+void RLMTruncateAllObjectsInRealm(RLMRealm *realm) {
+    RLMVerifyInWriteTransaction(realm);
+
+    for (auto& info : realm->_info) {
+        RLMTruncateTable(info.second);
+    }
+}
+
 RLMResults *RLMGetObjects(__unsafe_unretained RLMRealm *const realm,
                           NSString *objectClassName,
                           NSPredicate *predicate) {
@@ -214,13 +375,27 @@ RLMResults *RLMGetObjects(__unsafe_unretained RLMRealm *const realm,
     }
 
     if (predicate) {
-        realm::Query query = RLMPredicateToQuery(predicate, info.rlmObjectSchema, realm.schema, realm.group);
-        return [RLMResults resultsWithObjectInfo:info
-                                         results:realm::Results(realm->_realm, std::move(query))];
+        realm::Query query = RLMPredicateToQuery(predicate, info);
+        return [RLMResults tableResultsWithObjectInfo:info
+                                              results:realm::Results(realm->_realm, std::move(query))];
     }
 
-    return [RLMResults resultsWithObjectInfo:info
-                                     results:realm::Results(realm->_realm, info.table())];
+    return [RLMResults tableResultsWithObjectInfo:info
+                                          results:realm::Results(realm->_realm, info.table())];
+}
+
+RLMResults *RLMGetObjectsWithPredicateTemplate(__unsafe_unretained RLMRealm *const realm,
+                                               NSString *objectClassName, NSPredicate *predicate,
+                                               NSArray<NSString *> *variables, NSArray *values) {
+    RLMVerifyRealmRead(realm);
+
+    RLMClassInfo& info = realm->_info[objectClassName];
+    if (!info.table()) {
+        return [RLMResults resultsWithObjectInfo:info results:{}];
+    }
+    realm::Query query = RLMPredicateTemplateToQuery(predicate, variables, values, info);
+    return [RLMResults tableResultsWithObjectInfo:info
+                                          results:realm::Results(realm->_realm, std::move(query))];
 }
 
 id RLMGetObject(RLMRealm *realm, NSString *objectClassName, id key) {
@@ -243,6 +418,61 @@ id RLMGetObject(RLMRealm *realm, NSString *objectClassName, id key) {
     }
 }
 
+NSArray *RLMGetObjectsForPrimaryKeys(RLMRealm *realm, NSString *objectClassName,
+                                     id<NSFastEnumeration> keys) {
+    RLMVerifyRealmRead(realm);
+
+    auto& info = realm->_info[objectClassName];
+    RLMProperty *prop = info.propertyForPrimaryKey();
+    if (!prop) {
+        @throw RLMException(@"'%@' does not have a primary key defined", objectClassName);
+    }
+
+    // Validate and convert all of the keys before looking any of them up
+    RLMStatelessAccessorContext ctx;
+    std::vector<realm::Mixed> values;
+    for (id key in keys) {
+        RLMValidateValueForProperty(key, info.rlmObjectSchema, prop);
+        id value = RLMCoerceToNil(key);
+        if (!value) {
+            values.emplace_back();
+            continue;
+        }
+        values.push_back(RLMPropertyValueToMixed(ctx, realm, prop, value));
+    }
+
+    auto results = [NSMutableArray arrayWithCapacity:values.size()];
+    for (size_t i = 0; i < values.size(); ++i) {
+        [results addObject:NSNull.null];
+    }
+    auto table = info.table();
+    if (!table || values.empty()) {
+        return results;
+    }
+
+    // Probe the primary key index in key order rather than the order given so
+    // that neighbouring lookups touch the same parts of the index, and so that
+    // duplicate keys are only looked up once
+    std::vector<size_t> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return values[a] < values[b];
+    });
+
+    RLMTranslateError([&] {
+        id previous = NSNull.null;
+        for (size_t i = 0; i < order.size(); ++i) {
+            auto& value = values[order[i]];
+            if (i == 0 || value != values[order[i - 1]]) {
+                auto key = table->find_primary_key(value);
+                previous = key ? RLMCreateObjectAccessor(info, table->get_object(key)) : NSNull.null;
+            }
+            results[order[i]] = previous;
+        }
+    });
+    return results;
+}
+
 RLMObjectBase *RLMCreateObjectAccessor(RLMClassInfo& info, int64_t key) {
     return RLMCreateObjectAccessor(info, info.table()->get_object(realm::ObjKey(key)));
 }
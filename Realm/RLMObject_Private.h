@@ -56,15 +56,19 @@ typedef void (^RLMObjectNotificationCallback)(RLMObjectBase *_Nullable object,
                                               NSArray *_Nullable newValues,
                                               NSError *_Nullable error);
 
+// If includeValues is NO, the callback is passed nil for oldValues and
+// newValues, and the changed properties are not read
 FOUNDATION_EXTERN RLMNotificationToken *RLMObjectBaseAddNotificationBlock(RLMObjectBase *obj,
                                                                           NSArray<NSString *> *_Nullable key_paths,
                                                                           dispatch_queue_t _Nullable queue,
+                                                                          BOOL includeValues,
                                                                           RLMObjectNotificationCallback block);
 
 RLMNotificationToken *RLMObjectAddNotificationBlock(RLMObjectBase *obj,
                                                     RLMObjectChangeBlock block,
                                                     NSArray<NSString *> *_Nullable key_paths,
-                                                    dispatch_queue_t _Nullable queue);
+                                                    dispatch_queue_t _Nullable queue,
+                                                    BOOL includeValues);
 
 // Returns whether the class is a descendent of RLMObjectBase
 FOUNDATION_EXTERN BOOL RLMIsObjectOrSubclass(Class klass);
@@ -78,6 +82,27 @@ FOUNDATION_EXTERN id RLMObjectFreeze(RLMObjectBase *obj) NS_RETURNS_RETAINED;
 
 FOUNDATION_EXTERN id RLMObjectThaw(RLMObjectBase *obj);
 
+// Reads a data or string property without copying it out of the Realm file.
+// The returned data keeps the frozen version it was read from alive.
+FOUNDATION_EXTERN NSData *_Nullable RLMObjectBaseDataNoCopyForProperty(RLMObjectBase *obj, NSString *propertyName);
+
+// Reads a data or string property without copying or freezing anything. For
+// managed objects the returned bytes point into the row, and are only valid
+// until the Realm is next refreshed or written to. Values which have to be
+// copied are returned in `owner`, which must be kept alive while the bytes are
+// used. Returns NULL with a length of zero if the property is nil.
+FOUNDATION_EXTERN const void *_Nullable RLMObjectBaseUnsafeBytesForProperty(RLMObjectBase *obj, NSString *propertyName,
+                                                                            NSUInteger *length,
+                                                                            NSData *_Nullable __autoreleasing *_Nonnull owner);
+
+// Opens a stream over a data or string property. External blob properties are
+// streamed directly from the blob store.
+FOUNDATION_EXTERN NSInputStream *_Nullable RLMObjectBaseInputStreamForProperty(RLMObjectBase *obj, NSString *propertyName);
+
+// Gets the number of objects linking to this object through the given linking
+// objects property, without creating the linking objects collection.
+FOUNDATION_EXTERN NSUInteger RLMObjectBaseBacklinkCount(RLMObjectBase *obj, NSString *propertyName);
+
 // Gets an object identifier suitable for use with Combine. This value may
 // change when an unmanaged object is added to the Realm.
 FOUNDATION_EXTERN uint64_t RLMObjectBaseGetCombineId(RLMObjectBase *);
@@ -90,6 +115,9 @@ FOUNDATION_EXTERN uint64_t RLMObjectBaseGetCombineId(RLMObjectBase *);
 + (void)promote:(RLMProperty *)property on:(RLMObjectBase *)parent;
 // Initialize the given property on a newly created *managed* object
 + (void)initialize:(RLMProperty *)property on:(RLMObjectBase *)parent;
+// Whether the state set up by initialize:on: refers to the object's row, and so
+// has to be set up again when a managed accessor is pointed at another row
++ (BOOL)initializationDependsOnRow;
 // Read the value of the property, on either kind of object
 + (id)get:(RLMProperty *)property on:(RLMObjectBase *)parent;
 // Set the property to the given value, on either kind of object
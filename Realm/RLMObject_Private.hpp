@@ -23,19 +23,80 @@
 
 #import <realm/obj.hpp>
 
+#import <memory>
+#import <mutex>
+#import <vector>
+
 class RLMObservationInfo;
 
+// Boxed property values read from a frozen object. Frozen objects never change,
+// so each value only needs to be read and boxed once. Frozen objects can be read
+// from multiple threads at once, so all access is guarded by the mutex. The
+// values are tied to the row they were read from as accessors are sometimes
+// reused for multiple rows.
+class RLMFrozenValueCache {
+public:
+    template<typename Fn>
+    id get(realm::ObjKey key, size_t index, size_t count, Fn&& read) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (key == _key && index < _values.size() && _values[index]) {
+                return _values[index] == NSNull.null ? nil : _values[index];
+            }
+        }
+        id value = read();
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (key != _key) {
+            _key = key;
+            _values.clear();
+        }
+        if (_values.size() < count) {
+            _values.resize(count);
+        }
+        if (index < _values.size()) {
+            _values[index] = value ?: NSNull.null;
+        }
+        return value;
+    }
+
+private:
+    std::mutex _mutex;
+    realm::ObjKey _key;
+    std::vector<id> _values;
+};
+
+// Per-accessor state which most accessors never need: the observation info is
+// only created when an object is observed with KVO and the value cache only for
+// objects from frozen Realms. Keeping both behind a single lazily allocated
+// pointer keeps the accessors which make up large collections smaller.
+struct RLMObjectSideTable {
+    RLMObservationInfo *observationInfo = nullptr;
+    std::unique_ptr<RLMFrozenValueCache> frozenValueCache;
+};
+
 // RLMObject accessor and read/write realm
 @interface RLMObjectBase () {
     @public
     realm::Obj _row;
-    RLMObservationInfo *_observationInfo;
     RLMClassInfo *_info;
+    // null until first needed; see RLMObjectSideTable
+    RLMObjectSideTable *_sideTable;
 }
 @end
 
 id RLMCreateManagedAccessor(Class cls, RLMClassInfo *info) NS_RETURNS_RETAINED;
 
+static inline RLMObjectSideTable& RLMGetSideTable(__unsafe_unretained RLMObjectBase *const obj) {
+    if (!obj->_sideTable) {
+        obj->_sideTable = new RLMObjectSideTable;
+    }
+    return *obj->_sideTable;
+}
+
+static inline RLMObservationInfo *RLMGetObjectObservationInfo(__unsafe_unretained RLMObjectBase *const obj) {
+    return obj->_sideTable ? obj->_sideTable->observationInfo : nullptr;
+}
+
 // throw an exception if the object is invalidated or on the wrong thread
 static inline void RLMVerifyAttached(__unsafe_unretained RLMObjectBase *const obj) {
     if (!obj->_row.is_valid()) {
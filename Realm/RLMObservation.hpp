@@ -23,8 +23,12 @@
 #import <realm/object-store/impl/deep_change_checker.hpp>
 #import <realm/table.hpp>
 
+#import <unordered_map>
+#import <vector>
+
 @class RLMObjectBase, RLMRealm, RLMSchema, RLMProperty, RLMObjectSchema;
 class RLMClassInfo;
+class RLMObservedObjects;
 class RLMSchemaInfo;
 
 namespace realm {
@@ -39,8 +43,8 @@ namespace realm {
 // RLMObservationInfo instances, so it could be folded into RLMObjectBase, and
 // is a separate class mostly to avoid making all accessor objects far larger.
 //
-// RLMClassInfo stores a vector of pointers to the first observation info
-// created for each row. If there are multiple observation infos for a single
+// RLMClassInfo stores a pointer to the first observation info created for each
+// row, indexed by the row's key. If there are multiple observation infos for a single
 // row (such as if there are multiple observed objects backed by a single row,
 // or if both an object and an array property of that object are observed),
 // they're stored in an intrusive doubly-linked-list in the `next` and `prev`
@@ -107,10 +111,19 @@ private:
     __unsafe_unretained RLMProperty *lastProp = nil;
 
     // objects returned from valueForKey() to keep them alive in case observers
-    // are added and so that they can still be accessed after row is detached
-    NSMutableDictionary *cachedObjects;
+    // are added and so that they can still be accessed after row is detached.
+    // Indexed by property index with the computed properties after the
+    // persisted ones, and allocated the first time a value is cached. For
+    // link properties `link` is the target row which `value` was created for.
+    struct CachedObject {
+        NSString *key;
+        id value;
+        realm::ObjKey link;
+    };
+    std::vector<CachedObject> cachedObjects;
 
     void setRow(realm::Table const& table, realm::ObjKey newRow);
+    CachedObject& cachedObject(RLMProperty *prop);
 
     template<typename F>
     void forEach(F&& f) const {
@@ -145,6 +158,10 @@ RLMObservationInfo *RLMGetObservationInfo(RLMObservationInfo *info, realm::ObjKe
 // delete all objects from a single table with change notifications
 void RLMClearTable(RLMClassInfo &realm);
 
+// delete all objects from a single table, invalidating any observed objects
+// without sending KVO notifications for them
+void RLMTruncateTable(RLMClassInfo &realm);
+
 class RLMObservationTracker {
 public:
     RLMObservationTracker(RLMRealm *realm, bool trackDeletions=false);
@@ -158,7 +175,10 @@ public:
     void didChange();
 
 private:
-    std::vector<std::vector<RLMObservationInfo *> *> _observedTables;
+    // Observed tables sorted by table key, along with an index from table key
+    // so that the table for each link can be found without a scan
+    std::vector<RLMObservedObjects *> _observedTables;
+    std::unordered_map<uint32_t, RLMObservedObjects *> _observedTablesByKey;
     __unsafe_unretained RLMRealm const*_realm;
     realm::Group& _group;
     RLMObservationInfo *_info = nullptr;
@@ -173,6 +193,14 @@ private:
         NSMutableIndexSet *indexes;
     };
     std::vector<Change> _changes;
+    // Index into _changes for the LinkList changes which accumulate removed
+    // indexes, keyed on the observation info and property name
+    struct ChangeKeyHash {
+        size_t operator()(std::pair<RLMObservationInfo *, void *> const& key) const noexcept {
+            return std::hash<void *>()(key.first) ^ (std::hash<void *>()(key.second) << 1);
+        }
+    };
+    std::unordered_map<std::pair<RLMObservationInfo *, void *>, size_t, ChangeKeyHash> _linkListChanges;
     std::vector<RLMObservationInfo *> _invalidated;
 
     template<typename CascadeNotification>
@@ -183,6 +211,30 @@ std::vector<realm::BindingContext::ObserverState> RLMGetObservedRows(RLMSchemaIn
 void RLMWillChange(std::vector<realm::BindingContext::ObserverState> const& observed, std::vector<void *> const& invalidated);
 void RLMDidChange(std::vector<realm::BindingContext::ObserverState> const& observed, std::vector<void *> const& invalidated);
 
+// The resolved key paths for a single object type. Key paths are resolved
+// against the table and column keys of a specific RLMRealm's schema, so the
+// cache lives on the RLMClassInfo and is discarded along with it if the schema
+// changes. The set of key paths used by an app is normally small and fixed, so
+// the cache is simply cleared if it grows unexpectedly large.
+class RLMKeyPathCache {
+public:
+    static constexpr size_t maxSize = 128;
+
+    // Key paths passed in from Swift are bridged to a new NSString each time,
+    // so the cache has to compare the contents rather than the pointers
+    struct Hash {
+        size_t operator()(__unsafe_unretained NSString *const keyPath) const noexcept {
+            return keyPath.hash;
+        }
+    };
+    struct Equal {
+        bool operator()(__unsafe_unretained NSString *const a, __unsafe_unretained NSString *const b) const noexcept {
+            return [a isEqualToString:b];
+        }
+    };
+    std::unordered_map<NSString *, realm::KeyPath, Hash, Equal> keyPaths;
+};
+
 // KeyPathFromString converts a string keypath to a vector of key
 // pairs to be used for deep change checking across links.
 realm::KeyPathArray RLMKeyPathArrayFromStringArray(RLMRealm *realm,
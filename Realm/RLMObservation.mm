@@ -29,6 +29,7 @@
 #import "RLMSet_Private.hpp"
 #import "RLMSwiftCollectionBase.h"
 #import "RLMSwiftValueStorage.h"
+#import "RLMUtil.hpp"
 
 #import <realm/group.hpp>
 
@@ -81,17 +82,11 @@ RLMObservationInfo::~RLMObservationInfo() {
         // The head of the list, so remove self from the object schema's array
         // of observation info, either replacing self with the next info or
         // removing entirely if there is no next
-        auto end = objectSchema->observedObjects.end();
-        auto it = find(objectSchema->observedObjects.begin(), end, this);
-        if (it != end) {
+        if (objectSchema->observedObjects.find(row.get_key()) == this) {
             if (next) {
-                *it = next;
                 next->prev = nullptr;
             }
-            else {
-                iter_swap(it, std::prev(end));
-                objectSchema->observedObjects.pop_back();
-            }
+            objectSchema->observedObjects.replace(row.get_key(), next);
         }
     }
     // Otherwise the observed object was unmanaged, so nothing to do
@@ -145,17 +140,15 @@ void RLMObservationInfo::setRow(realm::Table const& table, realm::ObjKey key) {
     REALM_ASSERT_DEBUG(!row);
     REALM_ASSERT_DEBUG(objectSchema);
     row = table.get_object(key);
-    for (auto info : objectSchema->observedObjects) {
-        if (info->row && info->row.get_key() == key) {
-            prev = info;
-            next = info->next;
-            if (next)
-                next->prev = this;
-            info->next = this;
-            return;
-        }
+    if (auto info = objectSchema->observedObjects.find(key)) {
+        prev = info;
+        next = info->next;
+        if (next)
+            next->prev = this;
+        info->next = this;
+        return;
     }
-    objectSchema->observedObjects.push_back(this);
+    objectSchema->observedObjects.insert(key, this);
 }
 
 void RLMObservationInfo::recordObserver(realm::Obj& objectRow, RLMClassInfo *objectInfo,
@@ -197,12 +190,32 @@ void RLMObservationInfo::removeObserver() {
     --observerCount;
 }
 
+RLMObservationInfo::CachedObject& RLMObservationInfo::cachedObject(__unsafe_unretained RLMProperty *const prop) {
+    __unsafe_unretained RLMObjectSchema *const rlmObjectSchema = objectSchema->rlmObjectSchema;
+    NSUInteger propertyCount = rlmObjectSchema.properties.count;
+    if (cachedObjects.empty()) {
+        cachedObjects.resize(propertyCount + rlmObjectSchema.computedProperties.count);
+    }
+    size_t index = prop.type == RLMPropertyTypeLinkingObjects ? propertyCount + prop.index : prop.index;
+    auto& cached = cachedObjects[index];
+    if (!cached.key) {
+        cached.key = prop.name;
+    }
+    return cached;
+}
+
 id RLMObservationInfo::valueForKey(NSString *key) {
     if (invalidated) {
         if ([key isEqualToString:RLMInvalidatedKey]) {
             return @YES;
         }
-        return cachedObjects[key];
+        // The schema may no longer exist, so look the key up by name
+        for (auto& cached : cachedObjects) {
+            if (cached.key && [cached.key isEqualToString:key]) {
+                return cached.value;
+            }
+        }
+        return nil;
     }
 
     if (key != lastKey) {
@@ -224,52 +237,75 @@ id RLMObservationInfo::valueForKey(NSString *key) {
     // to work, so we store a cache of them here. We can't just cache them on
     // the object as that leads to retain cycles.
     if (lastProp.collection) {
-        id value = cachedObjects[key];
-        if (!value) {
-            value = getSuper();
-            if (!cachedObjects) {
-                cachedObjects = [NSMutableDictionary new];
-            }
-            cachedObjects[key] = value;
+        auto& cached = cachedObject(lastProp);
+        if (!cached.value) {
+            cached.value = getSuper();
         }
-        return value;
+        return cached.value;
     }
 
     if (lastProp.type == RLMPropertyTypeObject) {
-        auto col = row.get_table()->get_column_key(lastProp.name.UTF8String);
+        auto col = objectSchema->tableColumn(lastProp);
+        auto& cached = cachedObject(lastProp);
         if (row.is_null(col)) {
-            [cachedObjects removeObjectForKey:key];
+            cached.value = nil;
+            cached.link = {};
             return nil;
         }
 
-        RLMObjectBase *value = cachedObjects[key];
-        if (value && value->_row.get_key() == row.get<realm::ObjKey>(col)) {
-            return value;
-        }
-        value = getSuper();
-        if (!cachedObjects) {
-            cachedObjects = [NSMutableDictionary new];
+        auto link = row.get<realm::ObjKey>(col);
+        if (cached.value && cached.link == link) {
+            return cached.value;
         }
-        cachedObjects[key] = value;
-        return value;
+        cached.value = getSuper();
+        cached.link = link;
+        return cached.value;
     }
 
     return getSuper();
 }
 
+RLMObservationInfo *RLMObservedObjects::find(realm::ObjKey row) const noexcept {
+    auto it = m_index.find(row.value);
+    return it == m_index.end() ? nullptr : m_objects[it->second];
+}
+
+void RLMObservedObjects::insert(realm::ObjKey row, RLMObservationInfo *info) {
+    REALM_ASSERT_DEBUG(!m_index.count(row.value));
+    m_index.emplace(row.value, m_objects.size());
+    m_objects.push_back(info);
+}
+
+void RLMObservedObjects::replace(realm::ObjKey row, RLMObservationInfo *info) {
+    auto it = m_index.find(row.value);
+    REALM_ASSERT_DEBUG(it != m_index.end());
+    if (info) {
+        m_objects[it->second] = info;
+        return;
+    }
+
+    // Move the last info into the removed slot so that removal is O(1)
+    size_t index = it->second;
+    m_index.erase(it);
+    if (index + 1 != m_objects.size()) {
+        m_objects[index] = m_objects.back();
+        m_index[m_objects[index]->getRow().get_key().value] = index;
+    }
+    m_objects.pop_back();
+}
+
+void RLMObservedObjects::clear() noexcept {
+    m_objects.clear();
+    m_index.clear();
+}
+
 RLMObservationInfo *RLMGetObservationInfo(RLMObservationInfo *info, realm::ObjKey row,
                                           RLMClassInfo& objectSchema) {
     if (info) {
         return info;
     }
 
-    for (RLMObservationInfo *info : objectSchema.observedObjects) {
-        if (info->isForRow(row)) {
-            return info;
-        }
-    }
-
-    return nullptr;
+    return objectSchema.observedObjects.find(row);
 }
 
 void RLMClearTable(RLMClassInfo &objectSchema) {
@@ -300,6 +336,20 @@ void RLMClearTable(RLMClassInfo &objectSchema) {
     objectSchema.observedObjects.clear();
 }
 
+void RLMTruncateTable(RLMClassInfo &objectSchema) {
+    if (auto table = objectSchema.table()) {
+        // Clearing the table directly rather than through Results skips
+        // reporting each deleted row to the cascade notification handler,
+        // which is what makes clearing large tables slow
+        table->clear();
+    }
+
+    for (auto info : objectSchema.observedObjects) {
+        info->prepareForInvalidation();
+    }
+    objectSchema.observedObjects.clear();
+}
+
 RLMObservationTracker::RLMObservationTracker(__unsafe_unretained RLMRealm *const realm, bool trackDeletions)
 : _realm(realm)
 , _group(realm.group)
@@ -341,6 +391,18 @@ void RLMObservationTracker::trackDeletions() {
         return;
     }
 
+    // The set of observed objects can't change while the cascade handler is
+    // installed, so sort and index the tables once rather than per cascade
+    auto tableKey = [](RLMObservedObjects *table) {
+        return table->front()->getRow().get_table()->get_key();
+    };
+    std::sort(begin(_observedTables), end(_observedTables),
+              [=](auto a, auto b) { return tableKey(a) < tableKey(b); });
+    _observedTablesByKey.reserve(_observedTables.size());
+    for (auto table : _observedTables) {
+        _observedTablesByKey[tableKey(table).value] = table;
+    }
+
     _group.set_cascade_notification_handler([=](realm::Group::CascadeNotification const& cs) {
         cascadeNotification(cs);
     });
@@ -358,43 +420,36 @@ void RLMObservationTracker::cascadeNotification(CascadeNotification const& cs) {
     auto tableKey = [](RLMObservationInfo *info) {
         return info->getRow().get_table()->get_key();
     };
-    std::sort(begin(_observedTables), end(_observedTables),
-              [=](auto a, auto b) { return tableKey(a->front()) < tableKey(b->front()); });
     for (auto const& link : cs.links) {
-        auto table = std::find_if(_observedTables.begin(), _observedTables.end(), [&](auto table) {
-            return tableKey(table->front()) == link.origin_table;
-        });
-        if (table == _observedTables.end()) {
+        auto table = _observedTablesByKey.find(link.origin_table.value);
+        if (table == _observedTablesByKey.end()) {
             continue;
         }
 
-        for (auto observer : **table) {
-            if (!observer->isForRow(link.origin_key)) {
-                continue;
-            }
-
-            NSString *name = observer->columnName(link.origin_col_key);
-            if (observer->getRow().get_table()->get_column_type(link.origin_col_key) != type_LinkList) {
-                _changes.push_back({observer, name});
-                continue;
-            }
+        auto observer = table->second->find(link.origin_key);
+        if (!observer) {
+            continue;
+        }
 
-            auto c = find_if(begin(_changes), end(_changes), [&](auto const& c) {
-                return c.info == observer && c.property == name;
-            });
-            if (c == end(_changes)) {
-                _changes.push_back({observer, name, [NSMutableIndexSet new]});
-                c = prev(end(_changes));
-            }
+        NSString *name = observer->columnName(link.origin_col_key);
+        if (observer->getRow().get_table()->get_column_type(link.origin_col_key) != type_LinkList) {
+            _changes.push_back({observer, name});
+            continue;
+        }
 
-            // We know what row index is being removed from the LinkView,
-            // but what we actually want is the indexes in the LinkView that
-            // are going away
-            auto linkview = observer->getRow().get_linklist(link.origin_col_key);
-            linkview.find_all(link.old_target_key, [&](size_t index) {
-                [c->indexes addIndex:index];
-            });
+        auto [it, inserted] = _linkListChanges.try_emplace({observer, (__bridge void *)name}, _changes.size());
+        if (inserted) {
+            _changes.push_back({observer, name, [NSMutableIndexSet new]});
         }
+        auto c = begin(_changes) + it->second;
+
+        // We know what row index is being removed from the LinkView,
+        // but what we actually want is the indexes in the LinkView that
+        // are going away
+        auto linkview = observer->getRow().get_linklist(link.origin_col_key);
+        linkview.find_all(link.old_target_key, [&](size_t index) {
+            [c->indexes addIndex:index];
+        });
     }
     if (!cs.rows.empty()) {
         using Row = realm::Group::CascadeNotification::row;
@@ -462,7 +517,9 @@ void RLMObservationTracker::didChange() {
         info->didChange(RLMInvalidatedKey);
     }
     _observedTables.clear();
+    _observedTablesByKey.clear();
     _changes.clear();
+    _linkListChanges.clear();
     _invalidated.clear();
 }
 
@@ -539,6 +596,10 @@ void RLMWillChange(std::vector<realm::BindingContext::ObserverState> const& obse
 
 void RLMDidChange(std::vector<realm::BindingContext::ObserverState> const& observed,
                   std::vector<void *> const& invalidated) {
+    if (observed.empty() && invalidated.empty()) {
+        return;
+    }
+    RLM_SIGNPOST_INTERVAL("Deliver KVO notifications");
     if (!observed.empty()) {
         // Loop in reverse order to avoid O(N^2) behavior in Foundation
         NSMutableIndexSet *indexes = [NSMutableIndexSet new];
@@ -590,9 +651,23 @@ static KeyPath keyPathFromString(RLMRealm *realm,
 KeyPathArray RLMKeyPathArrayFromStringArray(RLMRealm *realm,
                                             RLMClassInfo *info,
                                             NSArray<NSString *> *keyPaths) {
+    if (!info->keyPathCache) {
+        info->keyPathCache = std::make_shared<RLMKeyPathCache>();
+    }
+    auto& cache = info->keyPathCache->keyPaths;
+
     KeyPathArray keyPathArray;
+    keyPathArray.reserve(keyPaths.count);
     for (NSString *keyPath in keyPaths) {
-        keyPathArray.push_back(keyPathFromString(realm , realm.schema, info, info->rlmObjectSchema, keyPath));
+        auto it = cache.find(keyPath);
+        if (it == cache.end()) {
+            auto resolved = keyPathFromString(realm, realm.schema, info, info->rlmObjectSchema, keyPath);
+            if (cache.size() >= RLMKeyPathCache::maxSize) {
+                cache.clear();
+            }
+            it = cache.emplace(keyPath.copy, std::move(resolved)).first;
+        }
+        keyPathArray.push_back(it->second);
     }
     return keyPathArray;
 }
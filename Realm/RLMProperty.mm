@@ -643,6 +643,8 @@ static realm::util::Optional<RLMPropertyType> typeFromProtocolString(const char
     prop->_getterSel = _getterSel;
     prop->_setterSel = _setterSel;
     prop->_isPrimary = _isPrimary;
+    prop->_externalBlob = _externalBlob;
+    prop->_compression = _compression;
     prop->_swiftAccessor = _swiftAccessor;
     prop->_swiftIvar = _swiftIvar;
     prop->_optional = _optional;
@@ -95,6 +95,11 @@ static inline NSString *RLMTypeToString(RLMPropertyType type) {
 @property (nonatomic, assign) NSUInteger index;
 @property (nonatomic, assign) BOOL isPrimary;
 @property (nonatomic, assign) BOOL isLegacy;
+// Whether the value is stored in the blob store rather than the column; see RLMBlobStore.hpp
+@property (nonatomic, assign) BOOL externalBlob;
+// The algorithm used to compress the value in the column, or 0 if it isn't
+// compressed; see RLMCompression.hpp
+@property (nonatomic, assign) RLMCompressionAlgorithm compression;
 @property (nonatomic, assign) ptrdiff_t swiftIvar;
 @property (nonatomic, assign, nullable) Class swiftAccessor;
 @property (nonatomic, readwrite, assign) RLMPropertyType dictionaryKeyType;
@@ -35,5 +35,16 @@ extern NSString * const RLMUnsupportedTypesFoundInPropertyComparisonException;
 realm::Query RLMPredicateToQuery(NSPredicate *predicate, RLMObjectSchema *objectSchema,
                                  RLMSchema *schema, realm::Group &group);
 
+// Equivalent to the above, but reuses a previously built query for this class
+// if the same predicate was used before and contains only immutable constants
+realm::Query RLMPredicateToQuery(NSPredicate *predicate, RLMClassInfo& info);
+
+// Builds the query for a predicate containing `$name` variables, with the value
+// at each index of `values` used for the variable at the same index of
+// `variables`. Predicates which only compare properties with variables are
+// compiled once per class, after which only the values need to be bound.
+realm::Query RLMPredicateTemplateToQuery(NSPredicate *predicate, NSArray<NSString *> *variables,
+                                         NSArray *values, RLMClassInfo& info);
+
 // return property - throw for invalid column name
 RLMProperty *RLMValidatedProperty(RLMObjectSchema *objectSchema, NSString *columnName);
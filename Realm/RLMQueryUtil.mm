@@ -18,12 +18,14 @@
 
 #import "RLMQueryUtil.hpp"
 
+#import "RLMClassInfo.hpp"
 #import "RLMDecimal128_Private.hpp"
 #import "RLMObjectId_Private.hpp"
 #import "RLMObjectSchema_Private.hpp"
 #import "RLMObject_Private.hpp"
 #import "RLMPredicateUtil.hpp"
 #import "RLMProperty_Private.h"
+#import "RLMRealm_Private.hpp"
 #import "RLMSchema.h"
 #import "RLMUtil.hpp"
 
@@ -34,6 +36,10 @@
 #import <realm/util/cf_ptr.hpp>
 #import <realm/util/overload.hpp>
 
+#import <algorithm>
+#import <optional>
+#import <string_view>
+
 using namespace realm;
 
 NSString * const RLMPropertiesComparisonTypeMismatchException = @"RLMPropertiesComparisonTypeMismatchException";
@@ -108,12 +114,62 @@ StringData get_string(Mixed const& m) {
     return StringData(b.data(), b.size());
 }
 
+// Diacritic-insensitive comparisons of strings which are entirely ASCII are
+// equivalent to plain (or ASCII case-insensitive) comparisons of the UTF-8
+// bytes, as no ASCII character has a diacritic to strip. Checking for this
+// and comparing the bytes directly is much faster than creating a CFString
+// for each row, so CFString is only used when either string is non-ASCII.
+
+bool is_ascii(StringData s)
+{
+    constexpr uint64_t high_bits = 0x8080808080808080ULL;
+    const char* data = s.data();
+    size_t size = s.size();
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        if (word & high_bits) {
+            return false;
+        }
+    }
+    for (; i < size; ++i) {
+        if (static_cast<unsigned char>(data[i]) & 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+char ascii_fold_case(char c)
+{
+    return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c;
+}
+
+bool ascii_equal(bool case_insensitive, const char* s1, const char* s2, size_t size)
+{
+    if (!case_insensitive) {
+        return memcmp(s1, s2, size) == 0;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        if (ascii_fold_case(s1[i]) != ascii_fold_case(s2[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool equal(CFStringCompareFlags options, StringData v1, StringData v2)
 {
     if (v1.is_null() || v2.is_null()) {
         return v1.is_null() == v2.is_null();
     }
 
+    if (is_ascii(v1) && is_ascii(v2)) {
+        return v1.size() == v2.size()
+            && ascii_equal(options & kCFCompareCaseInsensitive, v1.data(), v2.data(), v1.size());
+    }
+
     auto s1 = util::adoptCF(CFStringCreateWithBytesNoCopy(kCFAllocatorSystemDefault, (const UInt8*)v1.data(), v1.size(),
                                                           kCFStringEncodingUTF8, false, kCFAllocatorNull));
     auto s2 = util::adoptCF(CFStringCreateWithBytesNoCopy(kCFAllocatorSystemDefault, (const UInt8*)v2.data(), v2.size(),
@@ -165,6 +221,24 @@ bool contains_substring(CFStringCompareFlags options, StringData v1, StringData
         return true;
     }
 
+    if (is_ascii(v1) && is_ascii(v2)) {
+        if (v2.size() > v1.size()) {
+            return false;
+        }
+        bool case_insensitive = options & kCFCompareCaseInsensitive;
+        if (options & kCFCompareAnchored) {
+            const char* start = options & kCFCompareBackwards ? v1.data() + v1.size() - v2.size() : v1.data();
+            return ascii_equal(case_insensitive, start, v2.data(), v2.size());
+        }
+        std::string_view haystack(v1.data(), v1.size()), needle(v2.data(), v2.size());
+        if (!case_insensitive) {
+            return haystack.find(needle) != std::string_view::npos;
+        }
+        return std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(), [](char a, char b) {
+            return ascii_fold_case(a) == ascii_fold_case(b);
+        }) != haystack.end();
+    }
+
     auto s1 = util::adoptCF(CFStringCreateWithBytesNoCopy(kCFAllocatorSystemDefault, (const UInt8*)v1.data(), v1.size(),
                                                           kCFStringEncodingUTF8, false, kCFAllocatorNull));
     auto s2 = util::adoptCF(CFStringCreateWithBytesNoCopy(kCFAllocatorSystemDefault, (const UInt8*)v2.data(), v2.size(),
@@ -186,6 +260,91 @@ struct ContainsSubstring {
     static const char* description() { return options & kCFCompareCaseInsensitive ? "CONTAINS[cd]" : "CONTAINS[d]"; }
 };
 
+// Matches is used by QueryBuilder::add_regex_constraint as the comparator for
+// MATCHES. The pattern is validated when the query is built, and the compiled
+// regular expression is cached per thread so that it is compiled only once
+// rather than for each row.
+
+NSRegularExpression *compile_regex(StringData pattern, bool case_insensitive, NSError **error)
+{
+    NSString *str = [[NSString alloc] initWithBytes:pattern.data() length:pattern.size()
+                                           encoding:NSUTF8StringEncoding];
+    if (!str) {
+        return nil;
+    }
+    auto options = case_insensitive ? NSRegularExpressionCaseInsensitive : NSRegularExpressionOptions(0);
+    // MATCHES requires the entire string to match. Validate the pattern on its
+    // own before wrapping it so that unbalanced parentheses can't escape the group.
+    if (![NSRegularExpression regularExpressionWithPattern:str options:options error:error]) {
+        return nil;
+    }
+    return [NSRegularExpression regularExpressionWithPattern:[NSString stringWithFormat:@"\\A(?:%@)\\z", str]
+                                                     options:options error:error];
+}
+
+template <bool case_insensitive>
+struct Matches {
+    bool operator()(Mixed v1, Mixed v2) const
+    {
+        StringData value = get_string(v1), pattern = get_string(v2);
+        if (value.is_null() || pattern.is_null()) {
+            return false;
+        }
+
+        // ARC does not permit thread_local object pointers, so the cached
+        // regex is held as a CF reference
+        thread_local std::string cached_pattern;
+        thread_local util::CFPtr<CFTypeRef> cached_regex;
+        if (!cached_regex || cached_pattern != std::string_view(pattern.data(), pattern.size())) {
+            NSRegularExpression *regex = compile_regex(pattern, case_insensitive, nullptr);
+            if (!regex) {
+                return false;
+            }
+            cached_regex = util::adoptCF((__bridge_retained CFTypeRef)regex);
+            cached_pattern.assign(pattern.data(), pattern.size());
+        }
+
+        auto str = util::adoptCF(CFStringCreateWithBytesNoCopy(kCFAllocatorSystemDefault, (const UInt8*)value.data(), value.size(),
+                                                               kCFStringEncodingUTF8, false, kCFAllocatorNull));
+        if (!str) {
+            return false;
+        }
+        auto regex = (__bridge NSRegularExpression *)cached_regex.get();
+        return [regex rangeOfFirstMatchInString:(__bridge NSString *)str.get()
+                                        options:0
+                                          range:NSMakeRange(0, CFStringGetLength(str.get()))].location != NSNotFound;
+    }
+
+    static const char* description() { return case_insensitive ? "MATCHES[c]" : "MATCHES"; }
+};
+
+// Returns the literal characters every string matching `pattern` must begin
+// with, or an empty string if there are none which can be determined cheaply.
+// `isEntirePattern` is set if the pattern is only that literal.
+std::string regex_literal_prefix(StringData pattern, bool& isEntirePattern)
+{
+    isEntirePattern = false;
+    std::string_view str(pattern.data(), pattern.size());
+    if (str.find('|') != std::string_view::npos) {
+        // A top-level alternation means there is no common prefix
+        return {};
+    }
+
+    size_t i = 0;
+    while (i < str.size() && (isalnum(static_cast<unsigned char>(str[i])) || str[i] == ' ' || str[i] == '_' ||
+                              str[i] == '-' || str[i] == ',' || str[i] == ':' || str[i] == '@')) {
+        ++i;
+    }
+    if (i == str.size()) {
+        isEntirePattern = true;
+        return std::string(str);
+    }
+    // A quantifier which allows zero repetitions makes the last literal optional
+    if (i > 0 && (str[i] == '*' || str[i] == '?' || str[i] == '{')) {
+        --i;
+    }
+    return std::string(str.substr(0, i));
+}
 
 NSString *operatorName(NSPredicateOperatorType operatorType)
 {
@@ -287,6 +446,10 @@ public:
         return type() == RLMPropertyTypeLinkingObjects || type() == RLMPropertyTypeObject;
     }
 
+    bool has_links() const noexcept {
+        return !m_links.empty();
+    }
+
     bool has_any_to_many_links() const {
         return std::any_of(begin(m_links), end(m_links),
                            [](RLMProperty *property) { return property.collection; });
@@ -512,11 +675,18 @@ public:
 
 
     void apply_collection_operator_expression(RLMObjectSchema *desc, NSString *keyPath, id value, NSComparisonPredicate *pred);
+    void apply_backlink_count_expression(id value, NSComparisonPredicate *pred);
     void apply_value_expression(RLMObjectSchema *desc, NSString *keyPath, id value, NSComparisonPredicate *pred);
     void apply_column_expression(RLMObjectSchema *desc, NSString *leftKeyPath, NSString *rightKeyPath, NSComparisonPredicate *predicate);
     void apply_function_expression(RLMObjectSchema *objectSchema, NSExpression *functionExpression,
                                    NSPredicateOperatorType operatorType, NSExpression *right);
 
+    bool add_indexed_in_constraint(const ColumnReference& column, id values,
+                                   NSComparisonPredicateOptions predicateOptions,
+                                   RLMObjectSchema *desc, NSString *keyPath);
+    template <typename T, typename Validate, typename Convert>
+    void add_unique_equality_group(ColKey column, id values, Validate&& validate, Convert&& convert);
+
     template <typename A, typename B>
     void add_numeric_constraint(RLMPropertyType datatype,
                                 NSPredicateOperatorType operatorType,
@@ -560,6 +730,8 @@ public:
                                                    C&& column,
                                                    T value);
     template <typename C, typename T>
+    void add_regex_constraint(NSComparisonPredicateOptions predicateOptions, C&& column, T value);
+    template <typename C, typename T>
     void do_add_diacritic_sensitive_string_constraint(NSPredicateOperatorType operatorType,
                                                       NSComparisonPredicateOptions predicateOptions,
                                                       C&& column,
@@ -782,11 +954,73 @@ void QueryBuilder::add_diacritic_sensitive_string_constraint(NSPredicateOperator
     }
 }
 
+template <typename C, typename T>
+void QueryBuilder::add_regex_constraint(NSComparisonPredicateOptions predicateOptions, C&& column, T value) {
+    if constexpr (is_any_v<C, Columns<String>, Columns<Lst<String>>, Columns<Set<String>>> && std::is_same_v<T, StringData>) {
+        RLMPrecondition(!(predicateOptions & NSDiacriticInsensitivePredicateOption),
+                        @"Invalid operator type",
+                        @"Operator 'MATCHES' not supported with diacritic-insensitive modifier.");
+        bool caseSensitive = !(predicateOptions & NSCaseInsensitivePredicateOption);
+        if (value.is_null()) {
+            // Nothing matches a NULL pattern
+            m_query.and_query(std::unique_ptr<Expression>(new FalseExpression));
+            return;
+        }
+
+        NSError *error;
+        if (!compile_regex(value, !caseSensitive, &error)) {
+            throwException(@"Invalid value", @"'%@' is not a valid regular expression: %@",
+                           RLMStringDataToNSString(value), error.localizedDescription);
+        }
+
+        // Patterns consisting only of literal characters are just equality
+        // checks, which can use the string index. Otherwise, add a prefix check
+        // for any leading literal characters so that the regular expression
+        // only needs to be evaluated for rows which could match.
+        bool isEntirePattern;
+        std::string prefix = regex_literal_prefix(value, isEntirePattern);
+        if (isEntirePattern) {
+            m_query.and_query(column.equal(value, caseSensitive));
+            return;
+        }
+        if (!prefix.empty()) {
+            m_query.and_query(column.begins_with(StringData(prefix), caseSensitive));
+        }
+
+        auto left = column.clone();
+        auto right = make_subexpr<ConstantStringValue>(value);
+        if (caseSensitive) {
+            m_query.and_query(make_expression<Compare<Matches<false>>>(std::move(left), std::move(right)));
+        }
+        else {
+            m_query.and_query(make_expression<Compare<Matches<true>>>(std::move(left), std::move(right)));
+        }
+    }
+    else if constexpr (is_any_v<C, Columns<Binary>, Columns<Lst<Binary>>, Columns<Set<Binary>>>) {
+        unsupportedOperator(RLMPropertyTypeData, NSMatchesPredicateOperatorType);
+    }
+    else if constexpr (is_any_v<C, Columns<Dictionary>>) {
+        throwException(@"Invalid operand type",
+                       @"Operator 'MATCHES' not supported for string queries on Dictionary.");
+    }
+    else if constexpr (is_any_v<C, Columns<String>, Columns<Lst<String>>, Columns<Set<String>>>) {
+        throwException(@"Invalid operand type",
+                       @"Operator 'MATCHES' requires a constant pattern on the right side.");
+    }
+    else {
+        unsupportedOperator(RLMPropertyTypeAny, NSMatchesPredicateOperatorType);
+    }
+}
+
 template <typename C, typename T>
 void QueryBuilder::add_string_constraint(NSPredicateOperatorType operatorType,
                                          NSComparisonPredicateOptions predicateOptions,
                                          C&& column,
                                          T value) {
+    if (operatorType == NSMatchesPredicateOperatorType) {
+        add_regex_constraint(predicateOptions, std::forward<C>(column), value);
+        return;
+    }
     if (!(predicateOptions & NSDiacriticInsensitivePredicateOption)) {
         add_diacritic_sensitive_string_constraint(operatorType, predicateOptions, std::forward<C>(column), value);
         return;
@@ -1748,6 +1982,21 @@ NSPredicateOperatorType invert_comparison_operator(NSPredicateOperatorType type)
     }
 }
 
+// "@links.@count" is the total number of objects linking to each object from
+// any property, which core reads from the size of the backlink columns rather
+// than by building the linking objects
+void QueryBuilder::apply_backlink_count_expression(id value, NSComparisonPredicate *pred) {
+    RLMPrecondition([value isKindOfClass:[NSNumber class]], @"Invalid operand",
+                    @"@links.@count can only be compared with a numeric value.");
+    auto type = pred.predicateOperatorType;
+    if (pred.leftExpression.expressionType != NSKeyPathExpressionType) {
+        type = invert_comparison_operator(type);
+    }
+    add_numeric_constraint(RLMPropertyTypeInt, type,
+                           LinkChain(m_query.get_table()).get_backlink_count<Int>(),
+                           value_of_type<Int>(value));
+}
+
 void QueryBuilder::apply_collection_operator_expression(RLMObjectSchema *desc,
                                                         NSString *keyPath, id value,
                                                         NSComparisonPredicate *pred) {
@@ -1762,10 +2011,105 @@ void QueryBuilder::apply_collection_operator_expression(RLMObjectSchema *desc,
     add_collection_operation_constraint(type, operation, value, pred.options);
 }
 
+// Build "column IN values" for a column with a search index as a flat group of
+// native equality nodes with duplicates removed. Core merges equality nodes on
+// the same column into a single node which does one index lookup per value,
+// so this avoids both the generic per-value constraint dispatch and the cost
+// of evaluating repeated values.
+template <typename T, typename Validate, typename Convert>
+void QueryBuilder::add_unique_equality_group(ColKey column, id values, Validate&& validate, Convert&& convert) {
+    std::vector<T> keys;
+    keys.reserve([values respondsToSelector:@selector(count)] ? [values count] : 0);
+    bool hasNull = false;
+    for (id item in values) {
+        id value = validate(value_from_constant_expression_or_value(item));
+        if (isNSNull(value)) {
+            hasNull = true;
+        }
+        else {
+            keys.push_back(convert(value));
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    if (keys.empty() && !hasNull) {
+        m_query.and_query(std::unique_ptr<Expression>(new FalseExpression));
+        return;
+    }
+
+    m_query.group();
+    if (hasNull) {
+        m_query.equal(column, realm::null());
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (i || hasNull) {
+            m_query.Or();
+        }
+        if constexpr (std::is_same_v<T, std::string>) {
+            m_query.equal(column, StringData(keys[i]));
+        }
+        else {
+            m_query.equal(column, keys[i]);
+        }
+    }
+    m_query.end_group();
+}
+
+bool QueryBuilder::add_indexed_in_constraint(const ColumnReference& column, id values,
+                                             NSComparisonPredicateOptions predicateOptions,
+                                             RLMObjectSchema *desc, NSString *keyPath) {
+    RLMProperty *prop = column.property();
+    if (column.has_links() || prop.collection || !(prop.indexed || prop.isPrimary)) {
+        return false;
+    }
+    values = RLMAsFastEnumeration(values);
+    if (!values) {
+        return false;
+    }
+
+    auto validate = [&](id value) {
+        validate_property_value(column, value,
+                                @"Expected object of type %@ in IN clause for property '%@' on object of type '%@', but received: %@", desc, keyPath);
+        return value;
+    };
+    switch (prop.type) {
+        case RLMPropertyTypeInt:
+            add_unique_equality_group<int64_t>(column.column(), values, validate, [](id value) {
+                return convert<Int>(value);
+            });
+            return true;
+        case RLMPropertyTypeString:
+            if (predicateOptions) {
+                return false;
+            }
+            add_unique_equality_group<std::string>(column.column(), values, validate, [](id value) {
+                return std::string(convert<String>(value));
+            });
+            return true;
+        case RLMPropertyTypeObjectId:
+            add_unique_equality_group<ObjectId>(column.column(), values, validate, [](id value) {
+                return convert<ObjectId>(value);
+            });
+            return true;
+        case RLMPropertyTypeUUID:
+            add_unique_equality_group<UUID>(column.column(), values, validate, [](id value) {
+                return convert<UUID>(value);
+            });
+            return true;
+        default:
+            return false;
+    }
+}
+
 void QueryBuilder::apply_value_expression(RLMObjectSchema *desc,
                                           NSString *keyPath, id value,
                                           NSComparisonPredicate *pred)
 {
+    if ([keyPath isEqualToString:@"@links.@count"]) {
+        apply_backlink_count_expression(value, pred);
+        return;
+    }
     if (key_path_contains_collection_operator(keyPath)) {
         apply_collection_operator_expression(desc, keyPath, value, pred);
         return;
@@ -1782,6 +2126,9 @@ void QueryBuilder::apply_value_expression(RLMObjectSchema *desc,
 
     // turn "key.path IN collection" into ored together ==. "collection IN key.path" is handled elsewhere.
     if (pred.predicateOperatorType == NSInPredicateOperatorType) {
+        if (add_indexed_in_constraint(column, value, pred.options, desc, keyPath)) {
+            return;
+        }
         process_or_group(m_query, value, [&](id item) {
             id normalized = value_from_constant_expression_or_value(item);
             validate_property_value(column, normalized,
@@ -1864,6 +2211,64 @@ NSExpression *simplify_self_value_for_key_path_function_expression(NSExpression
     return expression;
 }
 
+// SUBQUERY(list, $x, $x.prop op value).@count compared to zero only asks
+// whether any (or no) object in the collection matches a single comparison,
+// which is exactly `ANY list.prop op value`. Unlike counting the results of
+// the subquery, that stops at the first matching object in each collection.
+// Returns nil if the subquery can't be rewritten this way.
+NSPredicate *any_predicate_for_subquery_count(NSPredicate *subqueryPredicate, NSString *collectionKeyPath,
+                                              RLMProperty *collectionProperty,
+                                              NSPredicateOperatorType operatorType, int64_t value) {
+    bool anyMatches;
+    if ((operatorType == NSGreaterThanPredicateOperatorType && value == 0)
+        || (operatorType == NSGreaterThanOrEqualToPredicateOperatorType && value == 1)
+        || (operatorType == NSNotEqualToPredicateOperatorType && value == 0)) {
+        anyMatches = true;
+    }
+    else if ((operatorType == NSEqualToPredicateOperatorType && value == 0)
+             || (operatorType == NSLessThanPredicateOperatorType && value == 1)
+             || (operatorType == NSLessThanOrEqualToPredicateOperatorType && value == 0)) {
+        anyMatches = false;
+    }
+    else {
+        return nil;
+    }
+
+    if (collectionProperty.dictionary || ![subqueryPredicate isMemberOfClass:[NSComparisonPredicate class]]) {
+        return nil;
+    }
+    auto compp = (NSComparisonPredicate *)subqueryPredicate;
+    if (compp.comparisonPredicateModifier != NSDirectPredicateModifier
+        || compp.leftExpression.expressionType != NSKeyPathExpressionType
+        || compp.rightExpression.expressionType != NSConstantValueExpressionType
+        || [compp.leftExpression.keyPath rangeOfString:@"@"].location != NSNotFound) {
+        return nil;
+    }
+    switch (compp.predicateOperatorType) {
+        case NSLessThanPredicateOperatorType:
+        case NSLessThanOrEqualToPredicateOperatorType:
+        case NSGreaterThanPredicateOperatorType:
+        case NSGreaterThanOrEqualToPredicateOperatorType:
+        case NSEqualToPredicateOperatorType:
+        case NSNotEqualToPredicateOperatorType:
+        case NSBeginsWithPredicateOperatorType:
+        case NSEndsWithPredicateOperatorType:
+        case NSContainsPredicateOperatorType:
+        case NSLikePredicateOperatorType:
+            break;
+        default:
+            return nil;
+    }
+
+    NSString *keyPath = [NSString stringWithFormat:@"%@.%@", collectionKeyPath, compp.leftExpression.keyPath];
+    NSPredicate *anyPredicate = [NSComparisonPredicate predicateWithLeftExpression:[NSExpression expressionForKeyPath:keyPath]
+                                                                   rightExpression:compp.rightExpression
+                                                                          modifier:NSAnyPredicateModifier
+                                                                              type:compp.predicateOperatorType
+                                                                           options:compp.options];
+    return anyMatches ? anyPredicate : [NSCompoundPredicate notPredicateWithSubpredicate:anyPredicate];
+}
+
 void QueryBuilder::apply_function_expression(RLMObjectSchema *objectSchema, NSExpression *functionExpression,
                                              NSPredicateOperatorType operatorType, NSExpression *right) {
     RLMPrecondition(functionExpression.operand.expressionType == NSSubqueryExpressionType,
@@ -1887,11 +2292,116 @@ void QueryBuilder::apply_function_expression(RLMObjectSchema *objectSchema, NSEx
     NSPredicate *subqueryPredicate = [subqueryExpression.predicate predicateWithSubstitutionVariables:@{subqueryExpression.variable: [NSExpression expressionForEvaluatedObject]}];
     subqueryPredicate = transformPredicate(subqueryPredicate, simplify_self_value_for_key_path_function_expression);
 
+    if (NSPredicate *anyPredicate = any_predicate_for_subquery_count(subqueryPredicate, [subqueryExpression.collection keyPath],
+                                                                     collectionColumn.property(), operatorType, value)) {
+        apply_predicate(anyPredicate, objectSchema);
+        return;
+    }
+
     Query subquery = RLMPredicateToQuery(subqueryPredicate, collectionMemberObjectSchema, m_schema, m_group);
     add_numeric_constraint(RLMPropertyTypeInt, operatorType,
                            collectionColumn.resolve<Link>(std::move(subquery)).count(), value);
 }
 
+// Rough relative costs of evaluating a predicate for a single object, in
+// increasing order. The terms of AND and OR predicates are evaluated in order
+// of cost so that cheap, selective terms can rule out objects before the
+// expensive terms are evaluated for them.
+enum class PredicateCost {
+    Constant,
+    IndexedEquality,
+    Comparison,
+    Link,
+    String,
+    Collection,
+    DiacriticInsensitive,
+};
+
+PredicateCost predicate_cost(NSPredicate *predicate, RLMObjectSchema *objectSchema)
+{
+    if ([predicate isMemberOfClass:[NSCompoundPredicate class]]) {
+        auto cost = PredicateCost::Constant;
+        for (NSPredicate *subp in ((NSCompoundPredicate *)predicate).subpredicates) {
+            cost = std::max(cost, predicate_cost(subp, objectSchema));
+        }
+        return cost;
+    }
+    if (![predicate isMemberOfClass:[NSComparisonPredicate class]]) {
+        return PredicateCost::Constant;
+    }
+
+    auto compp = (NSComparisonPredicate *)predicate;
+    if (compp.options & NSDiacriticInsensitivePredicateOption) {
+        return PredicateCost::DiacriticInsensitive;
+    }
+    if (compp.comparisonPredicateModifier == NSAnyPredicateModifier) {
+        return PredicateCost::Collection;
+    }
+
+    auto cost = PredicateCost::Comparison;
+    NSString *keyPath;
+    for (NSExpression *exp in @[compp.leftExpression, compp.rightExpression]) {
+        switch (exp.expressionType) {
+            case NSConstantValueExpressionType:
+            case NSAggregateExpressionType:
+            case NSEvaluatedObjectExpressionType:
+                break;
+            case NSKeyPathExpressionType:
+                if ([exp.keyPath rangeOfString:@"@"].location != NSNotFound) {
+                    return PredicateCost::Collection;
+                }
+                if ([exp.keyPath rangeOfString:@"."].location != NSNotFound) {
+                    cost = PredicateCost::Link;
+                }
+                keyPath = keyPath ? nil : exp.keyPath;
+                break;
+            default:
+                // SUBQUERY and other functions
+                return PredicateCost::Collection;
+        }
+    }
+
+    switch (compp.predicateOperatorType) {
+        case NSBeginsWithPredicateOperatorType:
+        case NSEndsWithPredicateOperatorType:
+        case NSContainsPredicateOperatorType:
+        case NSLikePredicateOperatorType:
+        case NSMatchesPredicateOperatorType:
+            return PredicateCost::String;
+        case NSEqualToPredicateOperatorType:
+            if (cost == PredicateCost::Comparison && keyPath && objectSchema[keyPath].indexed
+                && !(compp.options & NSCaseInsensitivePredicateOption)) {
+                return PredicateCost::IndexedEquality;
+            }
+            break;
+        default:
+            break;
+    }
+    if (compp.options & NSCaseInsensitivePredicateOption) {
+        return std::max(cost, PredicateCost::String);
+    }
+    return cost;
+}
+
+NSArray<NSPredicate *> *sorted_by_cost(NSArray<NSPredicate *> *subpredicates, RLMObjectSchema *objectSchema)
+{
+    if (subpredicates.count < 2) {
+        return subpredicates;
+    }
+    std::vector<std::pair<PredicateCost, NSUInteger>> costs;
+    costs.reserve(subpredicates.count);
+    for (NSUInteger i = 0; i < subpredicates.count; ++i) {
+        costs.emplace_back(predicate_cost(subpredicates[i], objectSchema), i);
+    }
+    // Sorting the pairs keeps terms of equal cost in the order they were written
+    std::sort(costs.begin(), costs.end());
+    NSMutableArray *sorted = [NSMutableArray arrayWithCapacity:subpredicates.count];
+    for (auto& [cost, index] : costs) {
+        [sorted addObject:subpredicates[index]];
+    }
+    return sorted;
+}
+
 void QueryBuilder::apply_predicate(NSPredicate *predicate, RLMObjectSchema *objectSchema)
 {
     // Compound predicates.
@@ -1903,7 +2413,7 @@ void QueryBuilder::apply_predicate(NSPredicate *predicate, RLMObjectSchema *obje
                 if (comp.subpredicates.count) {
                     // Add all of the subpredicates.
                     m_query.group();
-                    for (NSPredicate *subp in comp.subpredicates) {
+                    for (NSPredicate *subp in sorted_by_cost(comp.subpredicates, objectSchema)) {
                         apply_predicate(subp, objectSchema);
                     }
                     m_query.end_group();
@@ -1915,7 +2425,7 @@ void QueryBuilder::apply_predicate(NSPredicate *predicate, RLMObjectSchema *obje
 
             case NSOrPredicateType: {
                 // Add all of the subpredicates with ors inbetween.
-                process_or_group(m_query, comp.subpredicates, [&](__unsafe_unretained NSPredicate *const subp) {
+                process_or_group(m_query, sorted_by_cost(comp.subpredicates, objectSchema), [&](__unsafe_unretained NSPredicate *const subp) {
                     apply_predicate(subp, objectSchema);
                 });
                 break;
@@ -2022,6 +2532,7 @@ realm::Query RLMPredicateToQuery(NSPredicate *predicate, RLMObjectSchema *object
         return query;
     }
 
+    RLM_SIGNPOST_INTERVAL("Build query");
     @autoreleasepool {
         QueryBuilder(query, group, schema).apply_predicate(predicate, objectSchema);
     }
@@ -2033,6 +2544,447 @@ realm::Query RLMPredicateToQuery(NSPredicate *predicate, RLMObjectSchema *object
     return query;
 }
 
+namespace {
+// Cached queries are keyed on the NSPredicate itself, so any constant in the
+// predicate has to be immutable for a later -isEqual: match to imply that the
+// cached query is still correct. Object and collection constants are resolved
+// against the current transaction and so are never cached.
+bool isCacheableConstant(id value) {
+    if (!value || value == NSNull.null) {
+        return true;
+    }
+    if ([value isKindOfClass:[NSNumber class]] || [value isKindOfClass:[NSDate class]]
+        || [value isKindOfClass:[NSUUID class]] || [value isKindOfClass:[RLMObjectId class]]
+        || [value isKindOfClass:[RLMDecimal128 class]]) {
+        return true;
+    }
+    // Immutable Foundation objects return themselves from -copy
+    if ([value isKindOfClass:[NSString class]] || [value isKindOfClass:[NSData class]]) {
+        return [value copy] == value;
+    }
+    if ([value isKindOfClass:[NSArray class]] || [value isKindOfClass:[NSSet class]]) {
+        if ([value copy] != value) {
+            return false;
+        }
+        for (id element in value) {
+            if (!isCacheableConstant(element)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+bool isCacheableExpression(NSExpression *expression) {
+    switch (expression.expressionType) {
+        case NSKeyPathExpressionType:
+        case NSEvaluatedObjectExpressionType:
+            return true;
+        case NSConstantValueExpressionType:
+            return isCacheableConstant(expression.constantValue);
+        case NSAggregateExpressionType:
+            for (NSExpression *element in (NSArray *)expression.collection) {
+                if (![element isKindOfClass:[NSExpression class]] || !isCacheableExpression(element)) {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool isCacheablePredicate(NSPredicate *predicate) {
+    if ([predicate isKindOfClass:[NSCompoundPredicate class]]) {
+        for (NSPredicate *subpredicate in ((NSCompoundPredicate *)predicate).subpredicates) {
+            if (!isCacheablePredicate(subpredicate)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if ([predicate isKindOfClass:[NSComparisonPredicate class]]) {
+        auto comparison = (NSComparisonPredicate *)predicate;
+        return comparison.predicateOperatorType != NSCustomSelectorPredicateOperatorType
+            && isCacheableExpression(comparison.leftExpression)
+            && isCacheableExpression(comparison.rightExpression);
+    }
+    return [predicate isEqual:[NSPredicate predicateWithValue:YES]]
+        || [predicate isEqual:[NSPredicate predicateWithValue:NO]];
+}
+
+// A predicate made up only of comparisons between a property of the object and
+// one of a prepared query's arguments, with the key paths already resolved to
+// columns. Binding the arguments to it builds the query directly from the
+// columns, without substituting the arguments into the predicate, walking it
+// and resolving and validating its key paths again.
+struct QueryTemplate {
+    enum class Kind { And, Or, Not, Comparison };
+    Kind kind;
+    std::vector<QueryTemplate> children;
+
+    // Only used by comparisons
+    NSPredicateOperatorType operatorType;
+    ColKey column;
+    RLMPropertyType type;
+    bool optional;
+    NSUInteger argument;
+};
+
+NSPredicateOperatorType reversedOperator(NSPredicateOperatorType operatorType) {
+    switch (operatorType) {
+        case NSLessThanPredicateOperatorType:
+            return NSGreaterThanPredicateOperatorType;
+        case NSLessThanOrEqualToPredicateOperatorType:
+            return NSGreaterThanOrEqualToPredicateOperatorType;
+        case NSGreaterThanPredicateOperatorType:
+            return NSLessThanPredicateOperatorType;
+        case NSGreaterThanOrEqualToPredicateOperatorType:
+            return NSLessThanOrEqualToPredicateOperatorType;
+        default:
+            return operatorType;
+    }
+}
+
+bool isEqualityOperator(NSPredicateOperatorType operatorType) {
+    return operatorType == NSEqualToPredicateOperatorType || operatorType == NSNotEqualToPredicateOperatorType;
+}
+
+bool isOrderingOperator(NSPredicateOperatorType operatorType) {
+    switch (operatorType) {
+        case NSLessThanPredicateOperatorType:
+        case NSLessThanOrEqualToPredicateOperatorType:
+        case NSGreaterThanPredicateOperatorType:
+        case NSGreaterThanOrEqualToPredicateOperatorType:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns nullopt if any part of the predicate can't be compiled, in which case
+// the arguments have to be substituted into the predicate instead
+std::optional<QueryTemplate> compileQueryTemplate(NSPredicate *predicate, NSArray<NSString *> *variables,
+                                                  RLMClassInfo& info) {
+    if ([predicate isMemberOfClass:[NSCompoundPredicate class]]) {
+        auto compound = (NSCompoundPredicate *)predicate;
+        QueryTemplate node{};
+        switch (compound.compoundPredicateType) {
+            case NSAndPredicateType:
+                node.kind = QueryTemplate::Kind::And;
+                break;
+            case NSOrPredicateType:
+                node.kind = QueryTemplate::Kind::Or;
+                break;
+            case NSNotPredicateType:
+                node.kind = QueryTemplate::Kind::Not;
+                break;
+            default:
+                return std::nullopt;
+        }
+        if (compound.subpredicates.count == 0
+            || (node.kind == QueryTemplate::Kind::Not && compound.subpredicates.count != 1)) {
+            return std::nullopt;
+        }
+        for (NSPredicate *subpredicate in compound.subpredicates) {
+            auto child = compileQueryTemplate(subpredicate, variables, info);
+            if (!child) {
+                return std::nullopt;
+            }
+            node.children.push_back(std::move(*child));
+        }
+        return node;
+    }
+
+    if (![predicate isMemberOfClass:[NSComparisonPredicate class]]) {
+        return std::nullopt;
+    }
+    auto comparison = (NSComparisonPredicate *)predicate;
+    if (comparison.comparisonPredicateModifier != NSDirectPredicateModifier || comparison.options) {
+        return std::nullopt;
+    }
+    NSExpression *keyPath = comparison.leftExpression;
+    NSExpression *variable = comparison.rightExpression;
+    NSPredicateOperatorType operatorType = comparison.predicateOperatorType;
+    if (keyPath.expressionType == NSVariableExpressionType) {
+        std::swap(keyPath, variable);
+        operatorType = reversedOperator(operatorType);
+    }
+    if (keyPath.expressionType != NSKeyPathExpressionType || variable.expressionType != NSVariableExpressionType) {
+        return std::nullopt;
+    }
+    NSUInteger argument = [variables indexOfObject:variable.variable];
+    RLMProperty *prop = info.rlmObjectSchema[keyPath.keyPath];
+    if (argument == NSNotFound || !prop || prop.collection) {
+        return std::nullopt;
+    }
+    if (!isEqualityOperator(operatorType) && !isOrderingOperator(operatorType)) {
+        return std::nullopt;
+    }
+    switch (prop.type) {
+        case RLMPropertyTypeInt:
+        case RLMPropertyTypeFloat:
+        case RLMPropertyTypeDouble:
+        case RLMPropertyTypeDate:
+            break;
+        case RLMPropertyTypeBool:
+        case RLMPropertyTypeString:
+        case RLMPropertyTypeObjectId:
+        case RLMPropertyTypeUUID:
+            if (!isEqualityOperator(operatorType)) {
+                return std::nullopt;
+            }
+            break;
+        default:
+            return std::nullopt;
+    }
+
+    QueryTemplate node{};
+    node.kind = QueryTemplate::Kind::Comparison;
+    node.operatorType = operatorType;
+    node.column = info.tableColumn(prop);
+    node.type = prop.type;
+    node.optional = prop.optional;
+    node.argument = argument;
+    return node;
+}
+
+template<typename T>
+void addEqualityComparison(Query& query, NSPredicateOperatorType operatorType, ColKey column, T value) {
+    if (operatorType == NSEqualToPredicateOperatorType) {
+        query.equal(column, value);
+    }
+    else {
+        query.not_equal(column, value);
+    }
+}
+
+template<typename T>
+void addComparison(Query& query, NSPredicateOperatorType operatorType, ColKey column, T value) {
+    switch (operatorType) {
+        case NSLessThanPredicateOperatorType:
+            query.less(column, value);
+            break;
+        case NSLessThanOrEqualToPredicateOperatorType:
+            query.less_equal(column, value);
+            break;
+        case NSGreaterThanPredicateOperatorType:
+            query.greater(column, value);
+            break;
+        case NSGreaterThanOrEqualToPredicateOperatorType:
+            query.greater_equal(column, value);
+            break;
+        default:
+            addEqualityComparison(query, operatorType, column, value);
+            break;
+    }
+}
+
+// Returns false if the argument isn't a value of the property's type, which is
+// left to the full query builder to convert or report
+bool bindComparison(Query& query, QueryTemplate const& node, id value) {
+    auto op = node.operatorType;
+    if (!value || value == NSNull.null) {
+        if (!node.optional || !isEqualityOperator(op)) {
+            return false;
+        }
+        addEqualityComparison(query, op, node.column, realm::null());
+        return true;
+    }
+    switch (node.type) {
+        case RLMPropertyTypeInt: {
+            if (![value isKindOfClass:[NSNumber class]]) {
+                return false;
+            }
+            char type = *[(NSNumber *)value objCType];
+            if (type == 'f' || type == 'd') {
+                return false;
+            }
+            addComparison(query, op, node.column, int64_t([value longLongValue]));
+            return true;
+        }
+        case RLMPropertyTypeFloat:
+            if (![value isKindOfClass:[NSNumber class]]) {
+                return false;
+            }
+            addComparison(query, op, node.column, [value floatValue]);
+            return true;
+        case RLMPropertyTypeDouble:
+            if (![value isKindOfClass:[NSNumber class]]) {
+                return false;
+            }
+            addComparison(query, op, node.column, [value doubleValue]);
+            return true;
+        case RLMPropertyTypeDate:
+            if (![value isKindOfClass:[NSDate class]]) {
+                return false;
+            }
+            addComparison(query, op, node.column, RLMTimestampForNSDate(value));
+            return true;
+        case RLMPropertyTypeBool:
+            if (![value isKindOfClass:[NSNumber class]]) {
+                return false;
+            }
+            addEqualityComparison(query, op, node.column, bool([value boolValue]));
+            return true;
+        case RLMPropertyTypeString:
+            if (![value isKindOfClass:[NSString class]]) {
+                return false;
+            }
+            addEqualityComparison(query, op, node.column, RLMStringDataWithNSString(value));
+            return true;
+        case RLMPropertyTypeObjectId:
+            if (![value isKindOfClass:[RLMObjectId class]]) {
+                return false;
+            }
+            addEqualityComparison(query, op, node.column, ((RLMObjectId *)value).value);
+            return true;
+        case RLMPropertyTypeUUID:
+            if (![value isKindOfClass:[NSUUID class]]) {
+                return false;
+            }
+            addEqualityComparison(query, op, node.column, RLMObjcToUUID(value));
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool bindQueryTemplate(Query& query, QueryTemplate const& node, NSArray *values) {
+    switch (node.kind) {
+        case QueryTemplate::Kind::And:
+            query.group();
+            for (auto& child : node.children) {
+                if (!bindQueryTemplate(query, child, values)) {
+                    return false;
+                }
+            }
+            query.end_group();
+            return true;
+        case QueryTemplate::Kind::Or:
+            query.group();
+            for (size_t i = 0; i < node.children.size(); ++i) {
+                if (i) {
+                    query.Or();
+                }
+                if (!bindQueryTemplate(query, node.children[i], values)) {
+                    return false;
+                }
+            }
+            query.end_group();
+            return true;
+        case QueryTemplate::Kind::Not:
+            query.Not();
+            return bindQueryTemplate(query, node.children.front(), values);
+        case QueryTemplate::Kind::Comparison:
+            return bindComparison(query, node, values[node.argument]);
+    }
+    REALM_UNREACHABLE();
+}
+} // anonymous namespace
+
+// A small most-recently-used cache of the queries built for a single class in
+// a single Realm. Building a query from an NSPredicate requires walking the
+// predicate and resolving every key path against the schema, which dominates
+// the cost of running the same simple query repeatedly.
+class RLMQueryCache {
+public:
+    static constexpr size_t capacity = 16;
+
+    util::Optional<Query> get(NSPredicate *predicate, ConstTableRef const& table) {
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (![it->first isEqual:predicate]) {
+                continue;
+            }
+            // The table accessors are recreated if the read transaction was
+            // closed, which invalidates everything built from the old ones
+            if (it->second.get_table() != table) {
+                m_entries.clear();
+                return util::none;
+            }
+            if (it != m_entries.begin()) {
+                std::rotate(m_entries.begin(), it, it + 1);
+            }
+            return m_entries.front().second;
+        }
+        return util::none;
+    }
+
+    void insert(NSPredicate *predicate, Query const& query) {
+        if (m_entries.size() == capacity) {
+            m_entries.pop_back();
+        }
+        m_entries.emplace(m_entries.begin(), predicate, query);
+    }
+
+    // The compiled form of a prepared query's predicate, or nullopt if it
+    // couldn't be compiled. Templates only refer to columns of the class, so
+    // unlike queries they remain valid when the table accessor is recreated.
+    template<typename Fn>
+    std::optional<QueryTemplate> const& get_template(NSPredicate *predicate, Fn&& compile) {
+        for (auto& entry : m_templates) {
+            if ([entry.first isEqual:predicate]) {
+                return entry.second;
+            }
+        }
+        if (m_templates.size() == capacity) {
+            m_templates.pop_back();
+        }
+        m_templates.emplace(m_templates.begin(), predicate, compile());
+        return m_templates.front().second;
+    }
+
+private:
+    std::vector<std::pair<NSPredicate *, Query>> m_entries;
+    std::vector<std::pair<NSPredicate *, std::optional<QueryTemplate>>> m_templates;
+};
+
+Query RLMPredicateToQuery(NSPredicate *predicate, RLMClassInfo& info) {
+    RLMRealm *realm = info.realm;
+    // Frozen Realms can be used from multiple threads at once, so they don't
+    // get a cache
+    if (!predicate || realm.frozen || !isCacheablePredicate(predicate)) {
+        return RLMPredicateToQuery(predicate, info.rlmObjectSchema, realm.schema, realm.group);
+    }
+
+    if (!info.queryCache) {
+        info.queryCache = std::make_shared<RLMQueryCache>();
+    }
+    if (auto query = info.queryCache->get(predicate, info.table())) {
+        return std::move(*query);
+    }
+    auto query = RLMPredicateToQuery(predicate, info.rlmObjectSchema, realm.schema, realm.group);
+    info.queryCache->insert(predicate, query);
+    return query;
+}
+
+Query RLMPredicateTemplateToQuery(NSPredicate *predicate, NSArray<NSString *> *variables,
+                                  NSArray *values, RLMClassInfo& info) {
+    // Frozen Realms can be used from multiple threads at once, so they don't
+    // get a cache
+    if (!info.realm.frozen) {
+        if (!info.queryCache) {
+            info.queryCache = std::make_shared<RLMQueryCache>();
+        }
+        auto& compiled = info.queryCache->get_template(predicate, [&] {
+            return compileQueryTemplate(predicate, variables, info);
+        });
+        if (compiled) {
+            Query query = info.table()->where();
+            if (bindQueryTemplate(query, *compiled, values)) {
+                return query;
+            }
+        }
+    }
+
+    if (variables.count) {
+        predicate = [predicate predicateWithSubstitutionVariables:[NSDictionary dictionaryWithObjects:values
+                                                                                               forKeys:variables]];
+    }
+    return RLMPredicateToQuery(predicate, info);
+}
+
 // return the property for a validated column name
 RLMProperty *RLMValidatedProperty(RLMObjectSchema *desc, NSString *columnName) {
     RLMProperty *prop = desc[columnName];
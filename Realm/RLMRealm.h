@@ -19,7 +19,7 @@
 #import <Foundation/Foundation.h>
 #import <Realm/RLMConstants.h>
 
-@class RLMRealmConfiguration, RLMRealm, RLMObject, RLMSchema, RLMMigration, RLMNotificationToken, RLMThreadSafeReference, RLMAsyncOpenTask;
+@class RLMRealmConfiguration, RLMRealm, RLMObject, RLMSchema, RLMMigration, RLMNotificationToken, RLMThreadSafeReference, RLMThreadSafeReferenceBatch, RLMObjectReference, RLMAsyncOpenTask, RLMVersionPin, RLMFrozenRealmCacheStatistics, RLMStorageStatistics, RLMExpirationSweeper, RLMRealmChangeSummary;
 
 /**
  A callback block for opening Realms asynchronously.
@@ -166,6 +166,28 @@ NS_ASSUME_NONNULL_BEGIN
                                    callbackQueue:(dispatch_queue_t)callbackQueue
                                         callback:(RLMAsyncOpenRealmCallback)callback;
 
+/**
+ Perform the work required to open a Realm on a background queue, so that
+ opening it later on another thread is fast.
+
+ This discovers the schema if needed, opens the Realm file, performs any
+ required migration and creates the accessor classes for the schema's object
+ types. The opened Realm is kept alive until the next time the Realm is opened
+ on a different thread or queue, which lets that open reuse the already
+ opened file and schema rather than repeating the work.
+
+ Unlike `+asyncOpenWithConfiguration:callbackQueue:callback:`, this does not
+ wait for synchronized Realms to download remote content.
+
+ @param configuration A configuration object to use when opening the Realm.
+ @param queue         The serial dispatch queue on which to open the Realm.
+ @param completion    A block called on `queue` once the Realm has been opened,
+                      which is passed an `NSError` if opening the Realm failed.
+ */
++ (void)prewarmWithConfiguration:(RLMRealmConfiguration *)configuration
+                           queue:(dispatch_queue_t)queue
+                      completion:(nullable void (^)(NSError *_Nullable error))completion;
+
 /**
  The `RLMSchema` used by the Realm.
  */
@@ -239,6 +261,82 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (BOOL)writeCopyToURL:(NSURL *)fileURL encryptionKey:(nullable NSData *)key error:(NSError **)error;
 
+/**
+ Writes a compacted and optionally encrypted copy of the Realm to the given
+ output stream.
+
+ The copy is first written to a temporary file, which is then written to the
+ stream in chunks and deleted. The stream must already be open, and is left
+ open when this method returns.
+
+ @param stream                The stream to write the copy to.
+ @param key                   Optional 64-byte encryption key to encrypt the copy with.
+ @param maximumBytesPerSecond If non-zero, writes to the stream are paced to
+                              stay under this rate to avoid saturating the
+                              destination.
+ @param progress              Optional block called on the calling thread
+                              after each chunk is written to the stream.
+ @param error                 If an error occurs, upon return contains an
+                              `NSError` object that describes the problem. If
+                              you are not interested in possible errors, pass
+                              in `NULL`.
+
+ @return `YES` if the whole copy was written to the stream, `NO` if an error occurred.
+ */
+- (BOOL)writeCopyToStream:(NSOutputStream *)stream
+            encryptionKey:(nullable NSData *)key
+    maximumBytesPerSecond:(uint64_t)maximumBytesPerSecond
+                 progress:(nullable void (^)(uint64_t bytesWritten, uint64_t totalBytes))progress
+                    error:(NSError **)error;
+
+/**
+ Asynchronously compacts the Realm file for the given configuration on a
+ background queue.
+
+ Unlike `shouldCompactOnLaunch`, this does not block opening the Realm, and so
+ can be used to compact very large files without delaying launch. Compaction
+ rewrites the file to contain only the data which is currently in use, and so
+ can only be performed while nothing else has the file open. If the file is
+ open on another thread or in another process when the background queue gets to
+ it, the file is left unchanged and the callback is passed `NO`, and the
+ compaction can be tried again later (such as when the app next moves to the
+ background).
+
+ @param configuration A configuration object identifying the Realm to compact.
+ @param callbackQueue The dispatch queue on which the callback should be run.
+ @param callback      A block called with whether the file was compacted, and
+                      an `NSError` describing what went wrong if the Realm
+                      could not be opened.
+ */
++ (void)asyncCompactWithConfiguration:(RLMRealmConfiguration *)configuration
+                        callbackQueue:(dispatch_queue_t)callbackQueue
+                             callback:(void (^)(BOOL compacted, NSError *_Nullable error))callback;
+
+/**
+ Starts periodically deleting expired objects from the Realm file for the given
+ configuration on a background queue.
+
+ Objects expire when their object type overrides `+[RLMObject timeToLiveProperty]`
+ and `+[RLMObject timeToLive]`, and the date stored in the property is more than
+ `timeToLive` seconds in the past.
+
+ Expired objects are deleted in a series of short write transactions, each of
+ which is committed once it has run for `maximumWriteDuration` seconds. The
+ sweeper then waits for the same amount of time before starting the next one, so
+ that writes made on other threads are never blocked for longer than that by a
+ large number of expired objects.
+
+ @param configuration        A configuration object identifying the Realm.
+ @param interval             How often to check for expired objects, in seconds.
+ @param maximumWriteDuration The longest time a single write transaction may take, in seconds.
+
+ @return A sweeper which keeps running until it is invalidated or deallocated.
+ */
++ (RLMExpirationSweeper *)startExpiringObjectsWithConfiguration:(RLMRealmConfiguration *)configuration
+                                                       interval:(NSTimeInterval)interval
+                                           maximumWriteDuration:(NSTimeInterval)maximumWriteDuration
+    NS_SWIFT_NAME(startExpiringObjects(configuration:interval:maximumWriteDuration:));
+
 /**
  Checks if the Realm file for the given configuration exists locally on disk.
 
@@ -273,6 +371,39 @@ NS_ASSUME_NONNULL_BEGIN
 + (BOOL)deleteFilesForConfiguration:(RLMRealmConfiguration *)config error:(NSError **)error
  __attribute__((swift_error(nonnull_error)));
 
+/**
+ Returns the versions of the Realm file for the given configuration which are
+ currently held by `RLMRealm` instances in this process, oldest first.
+
+ This includes both thread- and queue-confined Realms, which hold the version
+ they are reading until they are refreshed or invalidated, and frozen Realms,
+ which hold their version until they are deallocated or invalidated. Realms
+ which were opened without caching (such as those used internally for
+ asynchronous writes), `RLMThreadSafeReference`s and other processes are not
+ included.
+
+ @param configuration A configuration object identifying the Realm file.
+ @return The versions held by each Realm.
+ */
++ (NSArray<RLMVersionPin *> *)versionPinsForConfiguration:(RLMRealmConfiguration *)configuration;
+
+/**
+ Returns statistics about the cache of recently frozen Realms which lets
+ repeated calls to `-freeze` for the same version share a single frozen Realm.
+
+ The counts are for all Realm files in this process.
+ */
++ (RLMFrozenRealmCacheStatistics *)frozenRealmCacheStatistics;
+
+/**
+ Returns the current size of the Realm file and how much of it is in use.
+
+ Unlike the values passed to `shouldCompactOnLaunch`, these can be read at any
+ time while the Realm is open, for example to decide when to compact the file
+ or trim a cache, or to report the file's footprint.
+ */
+@property (nonatomic, readonly) RLMStorageStatistics *storageStatistics;
+
 #pragma mark - Notifications
 
 /**
@@ -313,6 +444,36 @@ typedef void (^RLMNotificationBlock)(RLMNotification notification, RLMRealm *rea
  */
 - (RLMNotificationToken *)addNotificationBlock:(RLMNotificationBlock)block __attribute__((warn_unused_result));
 
+/**
+ The type of a block to run with a summary of which classes were changed
+ whenever the data within the Realm is modified.
+
+ @see `-[RLMRealm addChangeSummaryNotificationBlock:]`
+ */
+typedef void (^RLMChangeSummaryNotificationBlock)(RLMRealm *realm, RLMRealmChangeSummary *summary);
+
+/**
+ Adds a notification handler which is called with a summary of which classes
+ had objects inserted, deleted or modified each time the Realm advances to a
+ new version, and returns a notification token.
+
+ The handler is called at the same times as `RLMRealmDidChangeNotification` is
+ sent to blocks added with `-addNotificationBlock:`, and the summary covers all
+ of the changes between the version the previous summary was for and the
+ version the Realm is now reading. Producing the summary requires reading the
+ changes made by each transaction, so this is more expensive than a plain
+ notification block while any such handlers are registered.
+
+ Handler blocks may only be added on threads which are currently within a run
+ loop, and cannot be added within a write transaction.
+
+ @param block A block which is called with the Realm and a summary of the changes.
+
+ @return A token object which must be retained as long as you wish to continue
+         receiving change notifications.
+ */
+- (RLMNotificationToken *)addChangeSummaryNotificationBlock:(RLMChangeSummaryNotificationBlock)block __attribute__((warn_unused_result));
+
 #pragma mark - Writing to a Realm
 
 /**
@@ -413,6 +574,33 @@ typedef void (^RLMNotificationBlock)(RLMNotification notification, RLMRealm *rea
  */
 - (BOOL)commitWriteTransactionWithoutNotifying:(NSArray<RLMNotificationToken *> *)tokens error:(NSError **)error;
 
+/**
+ Lets a write transaction on the main thread go first if one is waiting for the
+ write lock.
+
+ Write transactions begun on the main thread take priority over writes on
+ other threads of the same process. Long-running writes on background threads,
+ such as imports, should call this method periodically. If a main thread write
+ is waiting, the current write transaction is committed, this method waits for
+ the main thread to acquire the write lock and finish, and then begins a new
+ write transaction before returning. Otherwise it does nothing.
+
+ After yielding, the Realm has been advanced to include the main thread's
+ changes, so objects read earlier in the transaction may have been deleted.
+ This method never yields on the main thread, or while a bulk load begun with
+ `-beginBulkLoadForClasses:error:` is in progress.
+
+ @warning This method may only be called during a write transaction.
+
+ @param error If an error occurs, upon return contains an `NSError` object
+              that describes the problem. If you are not interested in
+              possible errors, pass in `NULL`.
+
+ @return Whether the write transaction is still in progress. If committing or
+         beginning the write transaction fails, this returns `NO`.
+ */
+- (BOOL)yieldWriteTransactionIfNeeded:(NSError **)error;
+
 /**
  Reverts all writes made during the current write transaction and ends the transaction.
 
@@ -444,6 +632,51 @@ typedef void (^RLMNotificationBlock)(RLMNotification notification, RLMRealm *rea
  */
 - (void)cancelWriteTransaction;
 
+/**
+ Suspends maintenance of the search indexes of the given classes for the rest
+ of the current write transaction.
+
+ Inserting objects into a class with indexed properties updates each index for
+ every object inserted. When loading a large number of objects at once it is
+ faster to build the indexes once all of the objects have been inserted. This
+ removes the search indexes of all indexed properties of the given classes
+ other than the primary key, and rebuilds them in a single pass over each
+ column when the write transaction is committed.
+
+ Queries on the affected properties still work during the write transaction,
+ but do not use the index. The primary key's index is always kept, as it is
+ needed to look up objects by primary key and enforce its uniqueness.
+ Cancelling the write transaction restores the indexes along with everything
+ else.
+
+ @param classNames The names of the classes whose indexes should be suspended.
+
+ @warning This method may only be called during a write transaction.
+ */
+- (void)beginBulkLoadForClasses:(NSArray<NSString *> *)classNames
+NS_SWIFT_NAME(beginBulkLoad(forClasses:));
+
+/**
+ Deletes the files in the blob store which are not referenced by any object in
+ the current version of the Realm once the write transaction is committed.
+
+ Values of properties listed in `+[RLMObject externalBlobProperties]` are
+ stored in files next to the Realm file, which are not removed when the objects
+ referring to them are deleted or modified. Call this periodically to reclaim
+ the space.
+
+ Nothing is deleted if the write transaction is cancelled. Files which are
+ still referenced by a version of the Realm that a frozen Realm or an
+ unrefreshed Realm in this process is reading are kept, and are found again
+ by a later call. Realms in other processes are not taken into account.
+
+ @return The number of unreferenced files found, which will be deleted when
+         the write transaction is committed.
+
+ @warning This method may only be called during a write transaction.
+ */
+- (NSUInteger)removeUnreferencedExternalBlobs;
+
 /**
  Performs actions contained within the given block inside a write transaction.
 
@@ -500,6 +733,41 @@ typedef void (^RLMNotificationBlock)(RLMNotification notification, RLMRealm *rea
  */
 - (BOOL)transactionWithoutNotifying:(NSArray<RLMNotificationToken *> *)tokens block:(__attribute__((noescape)) void(^)(void))block error:(NSError **)error;
 
+/**
+ Asynchronously performs actions contained within the given block inside a
+ write transaction on a background queue.
+
+ Unlike `transactionWithBlock:`, this never blocks the calling thread waiting
+ for the write lock or for the changes to be written to disk. The block is
+ called on a background queue with an `RLMRealm` instance for the same file
+ which is already in a write transaction, and so must not use any objects or
+ collections from the calling thread. Pass objects into the block with
+ `RLMThreadSafeReference` or by primary key.
+
+ Asynchronous writes to the same Realm file are performed in the order they
+ were requested. Writes which are requested while a previous write is in
+ progress are performed together in a single write transaction, so that many
+ small writes only pay for one commit. As a result, the block must not commit
+ the write transaction itself. A block which cancels the write transaction or
+ throws an exception discards its own changes along with those of the earlier
+ writes in the same transaction, and the completion blocks of those earlier
+ writes are called with an error. The block's own completion block is called
+ with an error describing the exception, or saying that the write was
+ cancelled.
+
+ If `onComplete` is given, it is called on the thread or queue which this
+ Realm is confined to after the write has been committed, and this Realm is
+ refreshed first so that it is up to date with the changes. Realms confined
+ to a thread other than the main thread must have a running run loop for the
+ completion block to be called.
+
+ @param block      The block containing actions to perform.
+ @param onComplete A block called with `nil` if the write succeeded, or with
+                   an `NSError` describing why it could not be committed.
+ */
+- (void)asyncTransactionWithBlock:(void(^)(RLMRealm *realm))block
+                       onComplete:(nullable void(^)(NSError *_Nullable error))onComplete;
+
 /**
  Updates the Realm and outstanding objects managed by the Realm to point to the
  most recent data.
@@ -590,6 +858,66 @@ typedef void (^RLMNotificationBlock)(RLMNotification notification, RLMRealm *rea
 - (nullable id)resolveThreadSafeReference:(RLMThreadSafeReference *)reference
 NS_REFINED_FOR_SWIFT;
 
+/**
+ Returns the objects referenced by the batch, resolved for this Realm. Objects
+ which were deleted after the batch was created are omitted from the returned
+ array.
+
+ @param batch The thread-safe reference batch to resolve in this Realm.
+
+ @warning Cannot call within a write transaction.
+
+ @note Will refresh this Realm once if the source Realm was at a later version
+       than this one.
+
+ @see `+[RLMThreadSafeReferenceBatch batchWithObjects:]`
+ */
+- (NSArray *)resolveThreadSafeReferenceBatch:(RLMThreadSafeReferenceBatch *)batch
+NS_REFINED_FOR_SWIFT;
+
+/**
+ Returns the object referenced by the object reference as it exists in this
+ Realm, or `nil` if it has since been deleted.
+
+ @param reference The object reference to resolve in this Realm.
+
+ @warning Cannot call within a write transaction.
+
+ @note Will refresh this Realm if the reference was created from a later
+       version of the same Realm file than this one.
+
+ @see `+[RLMObjectReference referenceWithObject:]`
+ */
+- (nullable id)resolveObjectReference:(RLMObjectReference *)reference
+NS_REFINED_FOR_SWIFT;
+
+/**
+ Reads the given properties of every object in the results on a background
+ queue, so that the parts of the Realm file they are stored in are loaded from
+ disk before they are first needed.
+
+ This can be used shortly after opening a large Realm file to avoid stalling
+ the main thread on disk reads the first time a large collection of objects is
+ displayed. It has no effect on the results themselves.
+
+ @warning Cannot call within a write transaction.
+
+ @param results    The results whose objects should be read.
+ @param properties The names of the properties to read, or `nil` to read all of
+                   them. Collection properties are ignored.
+ */
+- (void)prefetchResults:(RLMResults *)results properties:(nullable NSArray<NSString *> *)properties;
+
+/**
+ Reads the given properties of every object of the given class on a background
+ queue. See `prefetchResults:properties:`.
+
+ @param className  The name of the class whose objects should be read.
+ @param properties The names of the properties to read, or `nil` to read all of
+                   them. Collection properties are ignored.
+ */
+- (void)prefetchObjectsOfClass:(NSString *)className properties:(nullable NSArray<NSString *> *)properties;
+
 #pragma mark - Adding and Removing Objects from a Realm
 
 /**
@@ -695,6 +1023,27 @@ NS_REFINED_FOR_SWIFT;
  */
 - (void)deleteAllObjects;
 
+/**
+ Deletes all objects from the Realm without sending key-value observing
+ notifications for the deleted objects.
+
+ `deleteAllObjects` sends a KVO notification for each observed object which is
+ deleted, and reports each deleted object to the KVO machinery so that observed
+ links to it can be updated, which is slow for Realms containing millions of
+ objects. This method instead clears each table in bulk. Realm, collection and
+ object notification blocks are called as usual when the write transaction is
+ committed.
+
+ This is intended for discarding the contents of a cache Realm. Any objects
+ which are being observed with KVO will be invalidated without their observers
+ being told.
+
+ @warning This method may only be called during a write transaction.
+
+ @see `deleteAllObjects`
+ */
+- (void)truncateAllObjects;
+
 
 #pragma mark - Migrations
 
@@ -709,6 +1058,15 @@ NS_REFINED_FOR_SWIFT;
  */
 typedef void (^RLMMigrationBlock)(RLMMigration *migration, uint64_t oldSchemaVersion);
 
+/**
+ The type of a block used to report the progress of a migration.
+
+ @param className   The name of the class whose objects are being enumerated.
+ @param enumerated  The number of objects of the class enumerated so far.
+ @param total       The total number of objects of the class to be enumerated.
+ */
+typedef void (^RLMMigrationProgressBlock)(NSString *className, NSUInteger enumerated, NSUInteger total);
+
 /**
  Returns the schema version for a Realm at a given local URL.
 
@@ -737,6 +1095,62 @@ NS_REFINED_FOR_SWIFT;
  */
 + (BOOL)performMigrationForConfiguration:(RLMRealmConfiguration *)configuration error:(NSError **)error;
 
+/**
+ Asynchronously performs the given Realm configuration's migration block on a
+ background queue.
+
+ Progress is reported as the migration block enumerates objects with
+ `-[RLMMigration enumerateObjects:block:]`, once for roughly every percent of
+ each class's objects. Migrations which modify the Realm without enumerating
+ objects report no progress.
+
+ Opening the Realm while the migration is running blocks until the migration
+ has completed, so rather than opening the Realm on the main thread, either
+ open it from the completion block or use
+ `+asyncOpenWithConfiguration:callbackQueue:callback:`, which waits for the
+ migration in the background.
+
+ @param configuration The Realm configuration used to open and migrate the Realm.
+ @param callbackQueue The dispatch queue on which the progress and completion
+                      blocks are invoked.
+ @param progress      A block which is called with the progress of the
+                      migration, or `nil`.
+ @param completion    A block which is called with the error which occurred
+                      while applying the migration, if any. If the Realm is
+                      opened after this method is called but before the
+                      migration starts, the error has the code
+                      `RLMErrorAlreadyOpen`.
+
+ @see                 RLMMigration
+ */
++ (void)migrateAsyncWithConfiguration:(RLMRealmConfiguration *)configuration
+                        callbackQueue:(dispatch_queue_t)callbackQueue
+                             progress:(nullable RLMMigrationProgressBlock)progress
+                           completion:(void (^)(NSError *_Nullable error))completion
+NS_SWIFT_NAME(migrateAsync(configuration:callbackQueue:progress:completion:));
+
+/**
+ Reads the schema version and other metadata of a Realm file without opening it.
+
+ Unlike opening the Realm or calling `schemaVersionAtURL:encryptionKey:error:`,
+ this does not create the file's lock and notification files or set up any of
+ the state shared between instances of the Realm. Only the file's header and the
+ pages containing the schema version are read (and for encrypted files,
+ decrypted), which makes this suitable for checking several files on launch to
+ decide which ones need to be migrated.
+
+ @param fileURL Local URL to a Realm file.
+ @param key     64-byte key used to encrypt the file, or `nil` if it is unencrypted.
+ @param error   If an error occurs, upon return contains an `NSError` object
+                that describes the problem. If you are not interested in
+                possible errors, pass in `NULL`.
+
+ @return The metadata of the file, or `nil` if it could not be read.
+ */
++ (nullable RLMRealmFileInfo *)fileInfoAtURL:(NSURL *)fileURL
+                               encryptionKey:(nullable NSData *)key
+                                       error:(NSError **)error;
+
 #pragma mark - Unavailable Methods
 
 /**
@@ -760,6 +1174,164 @@ NS_REFINED_FOR_SWIFT;
 
 @end
 
+// MARK: - RLMVersionPin
+
+/**
+ A version of a Realm file which is being kept alive by an `RLMRealm` instance.
+
+ Realm never overwrites data which an `RLMRealm` may still be reading, so each
+ version which is held by a Realm which has not been refreshed (or by a frozen
+ Realm) makes the file grow as later versions are written. Use
+ `+[RLMRealm versionPinsForConfiguration:]` to find out what is holding on to
+ old versions when the file is larger than expected or when
+ `maximumNumberOfActiveVersions` is exceeded.
+ */
+@interface RLMVersionPin : NSObject
+/// The version being read.
+@property (nonatomic, readonly) uint64_t version;
+/// Whether the version is held by a frozen Realm.
+@property (nonatomic, readonly, getter=isFrozen) BOOL frozen;
+/// A description of the thread or queue which the Realm holding the version is confined to.
+@property (nonatomic, readonly) NSString *holder;
+/// When the Realm holding the version started reading it.
+@property (nonatomic, readonly) NSDate *pinnedSince;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMVersionPin cannot be created directly")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMVersionPin cannot be created directly")));
+@end
+
+// MARK: - RLMFrozenRealmCacheStatistics
+
+/**
+ Statistics about the cache of recently frozen Realms, obtained from
+ `+[RLMRealm frozenRealmCacheStatistics]`.
+ */
+@interface RLMFrozenRealmCacheStatistics : NSObject
+/// The number of times freezing a Realm reused an existing frozen Realm.
+@property (nonatomic, readonly) uint64_t hits;
+/// The number of times freezing a Realm had to create a new frozen Realm.
+@property (nonatomic, readonly) uint64_t misses;
+/// The number of versions currently kept alive by the cache. The cache only
+/// retains the newest frozen version of each file, and releases it once a live
+/// Realm for the file advances to a newer version.
+@property (nonatomic, readonly) NSUInteger pinnedVersions;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMFrozenRealmCacheStatistics cannot be created directly")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMFrozenRealmCacheStatistics cannot be created directly")));
+@end
+
+// MARK: - RLMRealmFileInfo
+
+/**
+ Metadata about a Realm file, obtained from
+ `+[RLMRealm fileInfoAtURL:encryptionKey:error:]` without opening the Realm.
+ */
+@interface RLMRealmFileInfo : NSObject
+/// The schema version of the file, or `RLMNotVersioned` if no schema has been
+/// written to it yet.
+@property (nonatomic, readonly) uint64_t schemaVersion;
+/// The version of the storage format used by the file. Files with an older
+/// format are upgraded when they are opened.
+@property (nonatomic, readonly) NSInteger fileFormatVersion;
+/// The size of the file in bytes.
+@property (nonatomic, readonly) uint64_t fileSize;
+/// Whether the file is encrypted.
+@property (nonatomic, readonly, getter=isEncrypted) BOOL encrypted;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMRealmFileInfo cannot be created directly")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMRealmFileInfo cannot be created directly")));
+@end
+
+// MARK: - RLMStorageStatistics
+
+/**
+ A snapshot of the storage used by a Realm file, obtained from
+ `-[RLMRealm storageStatistics]`.
+
+ `freeBytes` is space in the file which is not used by the latest version of
+ the data, either because it could be reused for future writes or because it
+ is still being used by older versions which are pinned by a Realm which has not
+ been refreshed. Compacting the file (or writing a copy of it) reclaims this
+ space.
+ */
+@interface RLMStorageStatistics : NSObject
+/// The total size of the file in bytes. This is the sum of `usedBytes` and `freeBytes`.
+@property (nonatomic, readonly) uint64_t fileSize;
+/// The number of bytes used by the data.
+@property (nonatomic, readonly) uint64_t usedBytes;
+/// The number of bytes in the file which are not used by the latest version of the data.
+@property (nonatomic, readonly) uint64_t freeBytes;
+/// The number of versions of the data which are currently being kept alive,
+/// by this or any other process. See `+[RLMRealm versionPinsForConfiguration:]`.
+@property (nonatomic, readonly) uint64_t numberOfActiveVersions;
+/// The number of objects of each type in the schema, keyed by class name.
+@property (nonatomic, readonly) NSDictionary<NSString *, NSNumber *> *objectCounts;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMStorageStatistics cannot be created directly")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMStorageStatistics cannot be created directly")));
+@end
+
+// MARK: - RLMRealmChangeSummary
+
+/**
+ The names of the classes which were changed between two versions of a Realm,
+ passed to blocks added with `-[RLMRealm addChangeSummaryNotificationBlock:]`.
+ */
+@interface RLMRealmChangeSummary : NSObject
+/// The classes which had at least one object inserted.
+@property (nonatomic, readonly) NSSet<NSString *> *insertedClassNames;
+/// The classes which had at least one object deleted.
+@property (nonatomic, readonly) NSSet<NSString *> *deletedClassNames;
+/// The classes which had at least one existing object modified.
+@property (nonatomic, readonly) NSSet<NSString *> *modifiedClassNames;
+/// All classes which had any insertions, deletions or modifications.
+@property (nonatomic, readonly) NSSet<NSString *> *changedClassNames;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMRealmChangeSummary cannot be created directly")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMRealmChangeSummary cannot be created directly")));
+@end
+
+// MARK: - RLMExpirationSweeper
+
+/**
+ A background task which deletes expired objects from a Realm, created with
+ `+[RLMRealm startExpiringObjectsWithConfiguration:interval:maximumWriteDuration:]`.
+
+ The sweeper stops when it is invalidated or deallocated, so a strong reference
+ to it must be kept for as long as objects should be expired.
+ */
+@interface RLMExpirationSweeper : NSObject
+/**
+ Checks for expired objects immediately rather than waiting for the next
+ scheduled check.
+
+ @param completion Optional block called on the sweeper's background queue
+                   with the number of objects which were deleted, or with an
+                   error if the Realm could not be opened or written to. Errors
+                   from scheduled checks are logged, and the next check tries
+                   again.
+ */
+- (void)sweepWithCompletion:(nullable void (^)(NSUInteger deletedCount, NSError *_Nullable error))completion;
+
+/// Stops the sweeper. A sweep which is in progress stops after its current write transaction.
+- (void)invalidate;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMExpirationSweeper cannot be created directly")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMExpirationSweeper cannot be created directly")));
+@end
+
 // MARK: - RLMNotificationToken
 
 /**
@@ -777,6 +1349,27 @@ NS_REFINED_FOR_SWIFT;
 
 /// Stops notifications for the change subscription that returned this token.
 - (void)stop __attribute__((unavailable("Renamed to -invalidate."))) NS_REFINED_FOR_SWIFT;
+
+/**
+ Temporarily stops the change subscription which returned this token, such as
+ while the view displaying a collection is off-screen.
+
+ While paused, changes to the collection are not computed in the background at
+ all, so other subscriptions are not held up by it. Only tokens returned by
+ collection notification blocks can be paused; for other tokens this does
+ nothing.
+ */
+- (void)pause;
+
+/**
+ Resumes a change subscription which was paused with `-pause`.
+
+ Changes made while the subscription was paused are not tracked, so the block
+ is next called as it is when it is first added, with the current state of the
+ collection and a `nil` change. If the subscription delivers to the thread it
+ was added on, this must be called on that thread.
+ */
+- (void)resume;
 @end
 
 NS_ASSUME_NONNULL_END
@@ -20,8 +20,11 @@
 
 #import "RLMAnalytics.hpp"
 #import "RLMArray_Private.hpp"
+#import "RLMBlobStore.hpp"
+#import "RLMDecimal128.h"
 #import "RLMDictionary_Private.hpp"
 #import "RLMMigration_Private.h"
+#import "RLMObjectId.h"
 #import "RLMObject_Private.h"
 #import "RLMObject_Private.hpp"
 #import "RLMObjectSchema_Private.hpp"
@@ -33,6 +36,7 @@
 #import "RLMRealmConfiguration+Sync.h"
 #import "RLMRealmConfiguration_Private.hpp"
 #import "RLMRealmUtil.hpp"
+#import "RLMResults_Private.h"
 #import "RLMSchema_Private.hpp"
 #import "RLMSet_Private.hpp"
 #import "RLMThreadSafeReference_Private.hpp"
@@ -40,15 +44,29 @@
 #import "RLMUtil.hpp"
 
 #import <realm/disable_sync_to_disk.hpp>
+#import <realm/group.hpp>
+#import <realm/object-store/impl/collection_notifier.hpp>
 #import <realm/object-store/impl/realm_coordinator.hpp>
+#import <realm/object-store/impl/transact_log_handler.hpp>
 #import <realm/object-store/object_store.hpp>
 #import <realm/object-store/schema.hpp>
 #import <realm/object-store/shared_realm.hpp>
 #import <realm/object-store/thread_safe_reference.hpp>
 #import <realm/object-store/util/scheduler.hpp>
+#import <realm/util/file.hpp>
 #import <realm/util/scope_exit.hpp>
 #import <realm/version.hpp>
 
+#import <atomic>
+#import <chrono>
+#import <condition_variable>
+#import <memory>
+#import <mutex>
+#import <optional>
+#import <thread>
+#import <unordered_map>
+#import <vector>
+
 #if REALM_ENABLE_SYNC
 #import "RLMSyncManager_Private.hpp"
 #import "RLMSyncSession_Private.hpp"
@@ -64,10 +82,12 @@ using util::File;
 @interface RLMRealmNotificationToken : RLMNotificationToken
 @property (nonatomic, strong) RLMRealm *realm;
 @property (nonatomic, copy) RLMNotificationBlock block;
+@property (nonatomic, copy) RLMChangeSummaryNotificationBlock summaryBlock;
 @end
 
 @interface RLMRealm ()
 @property (nonatomic, strong) NSHashTable<RLMRealmNotificationToken *> *notificationHandlers;
+@property (nonatomic, strong) NSHashTable<RLMRealmNotificationToken *> *changeSummaryHandlers;
 - (void)sendNotifications:(RLMNotification)notification;
 @end
 
@@ -99,8 +119,10 @@ BOOL RLMIsRealmCachedAtPath(NSString *path) {
 - (void)invalidate {
     [_realm verifyThread];
     [_realm.notificationHandlers removeObject:self];
+    [_realm.changeSummaryHandlers removeObject:self];
     _realm = nil;
     _block = nil;
+    _summaryBlock = nil;
 }
 
 - (void)suppressNextNotification {
@@ -116,10 +138,15 @@ BOOL RLMIsRealmCachedAtPath(NSString *path) {
     _block = ^(RLMNotification, RLMRealm *) {
         _block = notificationBlock;
     };
+    if (auto summaryBlock = _summaryBlock) {
+        _summaryBlock = ^(RLMRealm *, RLMRealmChangeSummary *) {
+            _summaryBlock = summaryBlock;
+        };
+    }
 }
 
 - (void)dealloc {
-    if (_realm || _block) {
+    if (_realm || _block || _summaryBlock) {
         NSLog(@"RLMNotificationToken released without unregistering a notification. You must hold "
               @"on to the RLMNotificationToken returned from addNotificationBlock and call "
               @"-[RLMNotificationToken invalidate] when you no longer wish to receive RLMRealm notifications.");
@@ -129,11 +156,50 @@ BOOL RLMIsRealmCachedAtPath(NSString *path) {
 
 #if !REALM_ENABLE_SYNC
 @interface RLMAsyncOpenTask : NSObject
+@property (atomic) NSInteger priority;
 @end
+
 @implementation RLMAsyncOpenTask
 @end
 #endif
 
+@interface RLMWriteTransactionMetrics ()
+- (instancetype)initWithBegin:(NSTimeInterval)begin transaction:(NSTimeInterval)transaction
+                       commit:(NSTimeInterval)commit cancelled:(BOOL)cancelled
+           objectCountChanges:(NSDictionary<NSString *, NSNumber *> *)objectCountChanges
+                   yieldCount:(NSUInteger)yieldCount yieldDuration:(NSTimeInterval)yieldDuration;
+@end
+
+@interface RLMVersionPin ()
+- (instancetype)initWithVersion:(uint64_t)version frozen:(BOOL)frozen holder:(NSString *)holder pinnedSince:(NSDate *)pinnedSince;
+@end
+
+@interface RLMFrozenRealmCacheStatistics ()
+- (instancetype)initWithHits:(uint64_t)hits misses:(uint64_t)misses pinnedVersions:(NSUInteger)pinnedVersions;
+@end
+
+@interface RLMExpirationSweeper ()
+- (instancetype)initWithConfiguration:(RLMRealmConfiguration *)configuration
+                             interval:(NSTimeInterval)interval
+                 maximumWriteDuration:(NSTimeInterval)maximumWriteDuration;
+@end
+
+@interface RLMRealmFileInfo ()
+- (instancetype)initWithSchemaVersion:(uint64_t)schemaVersion fileFormatVersion:(NSInteger)fileFormatVersion
+                             fileSize:(uint64_t)fileSize encrypted:(BOOL)encrypted;
+@end
+
+@interface RLMRealmChangeSummary ()
+- (instancetype)initWithInserted:(NSSet<NSString *> *)inserted deleted:(NSSet<NSString *> *)deleted
+                        modified:(NSSet<NSString *> *)modified;
+@end
+
+@interface RLMStorageStatistics ()
+- (instancetype)initWithUsedBytes:(uint64_t)usedBytes freeBytes:(uint64_t)freeBytes
+           numberOfActiveVersions:(uint64_t)numberOfActiveVersions
+                     objectCounts:(NSDictionary<NSString *, NSNumber *> *)objectCounts;
+@end
+
 static bool shouldForciblyDisableEncryption() {
     static bool disableEncryption = getenv("REALM_DISABLE_ENCRYPTION");
     return disableEncryption;
@@ -155,6 +221,38 @@ NSData *RLMRealmValidatedEncryptionKey(NSData *key) {
     std::mutex _collectionEnumeratorMutex;
     NSHashTable<RLMFastEnumerator *> *_collectionEnumerators;
     bool _sendingNotifications;
+    // The queue this Realm is confined to, if it was opened for one
+    dispatch_queue_t _queue;
+    NSTimeInterval _groupCommitInterval;
+    NSUInteger _maximumWritesPerGroupCommit;
+    // The version this Realm is reading and when it started reading it, for
+    // versionPinsForConfiguration:. Written on the Realm's thread and read
+    // from any thread.
+    std::atomic<uint64_t> _pinnedVersion;
+    std::atomic<uint32_t> _pinnedVersionIndex;
+    std::atomic<CFAbsoluteTime> _pinnedSince;
+    NSString *_holderDescription;
+    // State for reporting the current write transaction to the observer
+    RLMWriteTransactionObserver _writeTransactionObserver;
+    NSTimeInterval _writeBeginDuration;
+    CFAbsoluteTime _writeBeganAt;
+    std::vector<std::pair<RLMClassInfo *, size_t>> _writeInitialObjectCounts;
+    NSUInteger _writeYieldCount;
+    NSTimeInterval _writeYieldDuration;
+    // Search indexes removed by beginBulkLoadForClasses: which need to be
+    // rebuilt before the current write transaction is committed
+    std::vector<std::pair<TableKey, ColKey>> _suspendedIndexes;
+    // Blob files found to be unreferenced by removeUnreferencedExternalBlobs
+    // in the current write transaction, which are removed once it's committed
+    NSMutableSet<NSString *> *_unreferencedBlobs;
+    // A read transaction at the version the last change summary was produced
+    // for, which is kept only while there are change summary handlers
+    TransactionRef _changeSummaryTransaction;
+    // The frozen Realm most recently returned by freeze and the version it
+    // was frozen at, so that freezing repeatedly at one version (such as once
+    // for each collection in a notification) skips the global cache lookup
+    __weak RLMRealm *_lastFrozenRealm;
+    uint64_t _lastFrozenVersion;
 }
 
 + (void)initialize {
@@ -164,8 +262,17 @@ NSData *RLMRealmValidatedEncryptionKey(NSData *key) {
     }
     initialized = true;
 
-    RLMCheckForUpdates();
-    RLMSendAnalytics();
+    // Neither of these are needed to open a Realm, and both do enough work
+    // (bundle enumeration, sysctl calls and hashing for the analytics payload)
+    // that they shouldn't run on the thread which happens to first use RLMRealm,
+    // which is usually the main thread during launch.
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, 10 * NSEC_PER_SEC),
+                   dispatch_get_global_queue(QOS_CLASS_BACKGROUND, 0), ^{
+        @autoreleasepool {
+            RLMCheckForUpdates();
+            RLMSendAnalytics();
+        }
+    });
 }
 
 - (instancetype)initPrivate {
@@ -227,9 +334,120 @@ void RLMSetAsyncOpenQueue(dispatch_queue_t queue) {
     s_async_open_queue = queue;
 }
 
-static RLMAsyncOpenTask *openAsync(RLMRealmConfiguration *configuration, void (^openCompletion)(ThreadSafeReference, std::exception_ptr)) {
+namespace {
+// Async opens are started in priority order, with at most `maxConcurrent`
+// running at once (or no limit if it is zero). Opens with equal priority are
+// started in the order they were requested.
+struct AsyncOpenScheduler {
+    struct Pending {
+        uint64_t id;
+        RLMAsyncOpenTask *task;
+        dispatch_block_t block;
+    };
+    struct Running {
+        uint64_t id;
+        // The caller may release the task while it runs
+        __weak RLMAsyncOpenTask *task;
+    };
+
+    std::mutex mutex;
+    NSUInteger maxConcurrent = 0;
+    uint64_t nextId = 0;
+    std::vector<Running> running;
+    std::vector<Pending> pending;
+
+    uint64_t makeId() {
+        std::lock_guard lock(mutex);
+        return nextId++;
+    }
+
+    void enqueue(uint64_t id, RLMAsyncOpenTask *task, dispatch_block_t block) {
+        {
+            std::lock_guard lock(mutex);
+            pending.push_back({id, task, block});
+        }
+        startPending();
+    }
+
+    template<typename Predicate>
+    void remove(Predicate&& matches) {
+        {
+            std::lock_guard lock(mutex);
+            if (auto it = std::find_if(running.begin(), running.end(), matches); it != running.end()) {
+                running.erase(it);
+            }
+            // Tasks which are cancelled before starting are never run
+            else if (auto pendingIt = std::find_if(pending.begin(), pending.end(), matches); pendingIt != pending.end()) {
+                pending.erase(pendingIt);
+            }
+            else {
+                return;
+            }
+        }
+        startPending();
+    }
+
+    void finished(uint64_t id) {
+        remove([&](auto& entry) { return entry.id == id; });
+    }
+
+    void cancelled(RLMAsyncOpenTask *task) {
+        remove([&](auto& entry) { return entry.task == task; });
+    }
+
+    void setMaxConcurrent(NSUInteger limit) {
+        {
+            std::lock_guard lock(mutex);
+            maxConcurrent = limit;
+        }
+        startPending();
+    }
+
+    void startPending() {
+        std::vector<dispatch_block_t> toStart;
+        {
+            std::lock_guard lock(mutex);
+            while (!pending.empty() && (maxConcurrent == 0 || running.size() < maxConcurrent)) {
+                // Priorities can change while tasks are queued, so the next
+                // task is selected when a slot becomes free rather than on insertion
+                auto next = std::max_element(pending.begin(), pending.end(), [](auto& a, auto& b) {
+                    return a.task.priority < b.task.priority;
+                });
+                running.push_back({next->id, next->task});
+                toStart.push_back(next->block);
+                pending.erase(next);
+            }
+        }
+        for (dispatch_block_t block : toStart) {
+            dispatch_async(s_async_open_queue, block);
+        }
+    }
+};
+AsyncOpenScheduler& s_async_open_scheduler = *new AsyncOpenScheduler;
+} // anonymous namespace
+
+NSUInteger RLMGetMaximumConcurrentAsyncOpens() {
+    std::lock_guard lock(s_async_open_scheduler.mutex);
+    return s_async_open_scheduler.maxConcurrent;
+}
+
+void RLMSetMaximumConcurrentAsyncOpens(NSUInteger limit) {
+    s_async_open_scheduler.setMaxConcurrent(limit);
+}
+
+void RLMAsyncOpenTaskDidFinish(RLMAsyncOpenTask *task) {
+    s_async_open_scheduler.cancelled(task);
+}
+
+static RLMAsyncOpenTask *openAsync(RLMRealmConfiguration *configuration, void (^callback)(ThreadSafeReference, std::exception_ptr)) {
     RLMAsyncOpenTask *ret = [RLMAsyncOpenTask new];
-    dispatch_async(s_async_open_queue, ^{
+    // Free this open's slot once it completes so that the next queued open can start
+    uint64_t taskId = s_async_open_scheduler.makeId();
+    auto openCompletion = ^(ThreadSafeReference ref, std::exception_ptr err) {
+        callback(std::move(ref), err);
+        s_async_open_scheduler.finished(taskId);
+    };
+    s_async_open_scheduler.enqueue(taskId, ret, ^{
         @autoreleasepool {
             Realm::Config& config = configuration.config;
             if (config.sync_config) {
@@ -291,6 +509,121 @@ static RLMAsyncOpenTask *openAsync(RLMRealmConfiguration *configuration, void (^
     });
 }
 
+// Uncached opens of the same file are serialized so that only the first one
+// initializes the schema (and runs any migration), and the others then reuse
+// its schema. Opens of different files proceed concurrently. The locks are
+// only kept alive while an open is in progress.
+static std::mutex& s_openLocksLock = *new std::mutex();
+static auto& s_openLocks = *new std::unordered_map<std::string, std::weak_ptr<std::mutex>>();
+
+static std::shared_ptr<std::mutex> RLMOpenLockForPath(std::string const& path) {
+    std::lock_guard lock(s_openLocksLock);
+    auto& weakLock = s_openLocks[path];
+    if (auto openLock = weakLock.lock()) {
+        return openLock;
+    }
+    auto openLock = std::make_shared<std::mutex>();
+    weakLock = openLock;
+    // Drop the entries for files which are no longer being opened
+    for (auto it = s_openLocks.begin(); it != s_openLocks.end(); ) {
+        it = it->second.expired() ? s_openLocks.erase(it) : std::next(it);
+    }
+    return openLock;
+}
+
+// Write transactions begun on the main thread register here while they wait
+// for the write lock, so that cooperative writers on background threads can
+// commit early and let them go first. The entries are only kept alive while
+// a main thread write is waiting.
+namespace {
+struct RLMPriorityWriters {
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t count = 0;
+};
+} // anonymous namespace
+
+static std::mutex& s_priorityWritersLock = *new std::mutex();
+static auto& s_priorityWriters = *new std::unordered_map<std::string, std::weak_ptr<RLMPriorityWriters>>();
+
+static std::shared_ptr<RLMPriorityWriters> RLMPriorityWritersForPath(std::string const& path, bool create) {
+    std::lock_guard lock(s_priorityWritersLock);
+    auto it = s_priorityWriters.find(path);
+    if (it != s_priorityWriters.end()) {
+        if (auto writers = it->second.lock()) {
+            return writers;
+        }
+    }
+    if (!create) {
+        return nullptr;
+    }
+    auto writers = std::make_shared<RLMPriorityWriters>();
+    s_priorityWriters[path] = writers;
+    // Drop the entries for files which no longer have a waiting writer
+    for (auto it = s_priorityWriters.begin(); it != s_priorityWriters.end(); ) {
+        it = it->second.expired() ? s_priorityWriters.erase(it) : std::next(it);
+    }
+    return writers;
+}
+
+static bool RLMPriorityWriterIsWaiting(std::string const& path) {
+    auto writers = RLMPriorityWritersForPath(path, false);
+    if (!writers) {
+        return false;
+    }
+    std::lock_guard lock(writers->mutex);
+    return writers->count > 0;
+}
+
+// Realms opened by +prewarmWithConfiguration:queue:completion:, which are kept
+// alive until the next time a Realm at the same path is opened so that it can
+// reuse the coordinator and schema.
+static std::mutex& s_prewarmedRealmsLock = *new std::mutex();
+static auto& s_prewarmedRealms = *new std::unordered_map<std::string, RLMRealm *>();
+
+static void RLMReleasePrewarmedRealm(std::string const& path) {
+    RLMRealm *prewarmed;
+    {
+        std::lock_guard lock(s_prewarmedRealmsLock);
+        auto it = s_prewarmedRealms.find(path);
+        if (it == s_prewarmedRealms.end()) {
+            return;
+        }
+        prewarmed = it->second;
+        s_prewarmedRealms.erase(it);
+    }
+    // The Realm has to be released on the queue it is confined to
+    dispatch_async(prewarmed->_queue, ^{
+        static_cast<void>(prewarmed);
+    });
+}
+
++ (void)prewarmWithConfiguration:(RLMRealmConfiguration *)configuration
+                           queue:(dispatch_queue_t)queue
+                      completion:(void (^)(NSError *))completion {
+    configuration = [configuration copy];
+    dispatch_async(queue, ^{
+        @autoreleasepool {
+            NSError *error;
+            RLMRealm *realm = [RLMRealm realmWithConfiguration:configuration queue:queue error:&error];
+            if (realm) {
+                // Accessor classes are otherwise created lazily the first time
+                // each type is used
+                for (RLMObjectSchema *objectSchema in realm.schema.objectSchema) {
+                    static_cast<void>(objectSchema.accessorClass);
+                }
+                if (configuration.cache) {
+                    std::lock_guard lock(s_prewarmedRealmsLock);
+                    s_prewarmedRealms[realm->_realm->config().path] = realm;
+                }
+            }
+            if (completion) {
+                completion(error);
+            }
+        }
+    });
+}
+
 + (RLMAsyncOpenTask *)asyncOpenWithConfiguration:(RLMRealmConfiguration *)configuration
                                         callback:(void (^)(NSError *))callback {
     return openAsync(configuration, [=](ThreadSafeReference, std::exception_ptr err) {
@@ -446,15 +779,21 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
         }
     }
 
+    RLM_SIGNPOST_INTERVAL("Open Realm");
     configuration = [configuration copy];
     Realm::Config& config = configuration.config;
 
     RLMRealm *realm = [[self alloc] initPrivate];
     realm->_dynamic = dynamic;
+    realm->_queue = queue;
+    realm->_groupCommitInterval = configuration.groupCommitInterval;
+    realm->_maximumWritesPerGroupCommit = configuration.maximumWritesPerGroupCommit;
+    realm->_writeTransactionObserver = configuration.writeTransactionObserver;
 
-    // protects the realm cache and accessors cache
-    static std::mutex& initLock = *new std::mutex();
-    std::lock_guard<std::mutex> lock(initLock);
+    // Managed accessor classes are created lazily under their own lock, so
+    // only opens of this file need to be serialized
+    auto openLock = RLMOpenLockForPath(config.path);
+    std::lock_guard<std::mutex> lock(*openLock);
 
     try {
         if (queue) {
@@ -502,6 +841,7 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
 
         Realm::MigrationFunction migrationFunction;
         auto migrationBlock = configuration.migrationBlock;
+        auto migrationProgressBlock = configuration.migrationProgressBlock;
         if (migrationBlock && configuration.schemaVersion > 0) {
             migrationFunction = [=](SharedRealm old_realm, SharedRealm realm, Schema& mutableSchema) {
                 RLMSchema *oldSchema = [RLMSchema dynamicSchemaFromObjectStoreSchema:old_realm->schema()];
@@ -513,7 +853,9 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
                 // are created
                 RLMRealm *newRealm = [RLMRealm realmWithSharedRealm:realm schema:schema.copy];
 
-                [[[RLMMigration alloc] initWithRealm:newRealm oldRealm:oldRealm schema:mutableSchema] execute:migrationBlock];
+                RLMMigration *migration = [[RLMMigration alloc] initWithRealm:newRealm oldRealm:oldRealm schema:mutableSchema];
+                migration.progressBlock = migrationProgressBlock;
+                [migration execute:migrationBlock];
 
                 oldRealm->_realm = nullptr;
                 newRealm->_realm = nullptr;
@@ -536,7 +878,9 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
         if (!readOnly) {
             REALM_ASSERT(!realm->_realm->is_in_read_transaction());
 
-            if (s_set_skip_backup_attribute) {
+            // In-memory Realms live in the temporary directory, which is never
+            // backed up, so don't spend three file system calls per open on them
+            if (s_set_skip_backup_attribute && !config.in_memory) {
                 RLMAddSkipBackupAttributeToItemAtPath(config.path + ".management");
                 RLMAddSkipBackupAttributeToItemAtPath(config.path + ".lock");
                 RLMAddSkipBackupAttributeToItemAtPath(config.path + ".note");
@@ -544,8 +888,19 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
         }
     }
 
+    if (queue) {
+        realm->_holderDescription = [NSString stringWithFormat:@"queue '%s'", dispatch_queue_get_label(queue)];
+    }
+    else {
+        realm->_holderDescription = pthread_main_np() ? @"main thread" : NSThread.currentThread.description;
+    }
+    [realm recordPinnedVersion];
+
     if (cache) {
         RLMCacheRealm(config.path, cacheKey, realm);
+        // Now that this Realm is cached it can take over from any prewarmed
+        // Realm as the source of the schema for future opens
+        RLMReleasePrewarmedRealm(config.path);
     }
 
     if (!readOnly) {
@@ -597,13 +952,78 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
     return token;
 }
 
+- (RLMNotificationToken *)addChangeSummaryNotificationBlock:(RLMChangeSummaryNotificationBlock)block {
+    if (!block) {
+        @throw RLMException(@"The notification block should not be nil");
+    }
+    [self verifyNotificationsAreSupported:true];
+
+    auto& group = _realm->read_group();
+    if (!_changeSummaryHandlers) {
+        _changeSummaryHandlers = [NSHashTable hashTableWithOptions:NSPointerFunctionsWeakMemory];
+    }
+    if (!_changeSummaryTransaction) {
+        _changeSummaryTransaction = static_cast<Transaction&>(group).duplicate();
+    }
+
+    RLMRealmNotificationToken *token = [[RLMRealmNotificationToken alloc] init];
+    token.realm = self;
+    token.summaryBlock = block;
+    [_changeSummaryHandlers addObject:token];
+    return token;
+}
+
+// Advance the change summary transaction to the version this Realm is now
+// reading, and report which tables were changed along the way
+- (RLMRealmChangeSummary *)advanceChangeSummary {
+    if (_changeSummaryHandlers.count == 0) {
+        _changeSummaryTransaction = nullptr;
+        return nil;
+    }
+    if (!_changeSummaryTransaction) {
+        return nil;
+    }
+
+    _impl::TransactionChangeInfo info;
+    info.track_all = true;
+    _impl::transaction::advance(*_changeSummaryTransaction, info, _realm->read_transaction_version());
+
+    NSMutableSet *inserted = [NSMutableSet new];
+    NSMutableSet *deleted = [NSMutableSet new];
+    NSMutableSet *modified = [NSMutableSet new];
+    for (auto& [tableKey, changes] : info.tables) {
+        if (!_changeSummaryTransaction->has_table(tableKey)) {
+            continue;
+        }
+        auto objectType = ObjectStore::object_type_for_table_name(_changeSummaryTransaction->get_table_name(tableKey));
+        if (objectType.size() == 0) {
+            continue;
+        }
+        NSString *className = RLMStringDataToNSString(objectType);
+        if (!changes.insertions_empty()) {
+            [inserted addObject:className];
+        }
+        if (!changes.deletions_empty()) {
+            [deleted addObject:className];
+        }
+        if (!changes.modifications_empty()) {
+            [modified addObject:className];
+        }
+    }
+    return [[RLMRealmChangeSummary alloc] initWithInserted:inserted deleted:deleted modified:modified];
+}
+
 - (void)sendNotifications:(RLMNotification)notification {
     NSAssert(!_realm->config().immutable(), @"Read-only realms do not have notifications");
     if (_sendingNotifications) {
         return;
     }
     NSUInteger count = _notificationHandlers.count;
-    if (count == 0) {
+    RLMRealmChangeSummary *summary;
+    if ([notification isEqualToString:RLMRealmDidChangeNotification]) {
+        summary = [self advanceChangeSummary];
+    }
+    if (count == 0 && !summary) {
         return;
     }
 
@@ -612,7 +1032,19 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
         _sendingNotifications = false;
     });
 
+    // Summaries are only produced for RLMRealmDidChangeNotification
+    if (summary) {
+        for (RLMRealmNotificationToken *token in _changeSummaryHandlers.allObjects) {
+            if (auto block = token.summaryBlock) {
+                block(self, summary);
+            }
+        }
+    }
+
     // call this realm's notification blocks
+    if (count == 0) {
+        return;
+    }
     if (count == 1) {
         if (auto block = [_notificationHandlers.anyObject block]) {
             block(notification, self);
@@ -632,6 +1064,9 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
     configuration.config = _realm->config();
     configuration.dynamic = _dynamic;
     configuration.customSchema = _schema;
+    configuration.groupCommitInterval = _groupCommitInterval;
+    configuration.maximumWritesPerGroupCommit = _maximumWritesPerGroupCommit;
+    configuration.writeTransactionObserver = _writeTransactionObserver;
     return configuration;
 }
 
@@ -641,13 +1076,87 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
 
 - (BOOL)beginWriteTransactionWithError:(NSError **)error {
     try {
+        if (!_writeTransactionObserver) {
+            [self acquireWriteLock];
+            return YES;
+        }
+
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        [self acquireWriteLock];
+        _writeBeganAt = CFAbsoluteTimeGetCurrent();
+        _writeBeginDuration = _writeBeganAt - start;
+        _writeYieldCount = 0;
+        _writeYieldDuration = 0;
+        _writeInitialObjectCounts.clear();
+        for (auto& info : _info) {
+            auto table = info.second.table();
+            _writeInitialObjectCounts.emplace_back(&info.second, table ? table->size() : 0);
+        }
+        return YES;
+    }
+    catch (...) {
+        RLMRealmTranslateException(error);
+        return NO;
+    }
+}
+
+// Begin the write transaction, registering as a waiting priority writer
+// while doing so if this is the main thread
+- (void)acquireWriteLock {
+    if (!NSThread.isMainThread) {
         _realm->begin_transaction();
+        return;
+    }
+
+    auto waiters = RLMPriorityWritersForPath(_realm->config().path, true);
+    {
+        std::lock_guard lock(waiters->mutex);
+        ++waiters->count;
+    }
+    auto cleanup = util::make_scope_exit([&]() noexcept {
+        {
+            std::lock_guard lock(waiters->mutex);
+            --waiters->count;
+        }
+        waiters->cv.notify_all();
+    });
+    _realm->begin_transaction();
+}
+
+- (BOOL)yieldWriteTransactionIfNeeded:(NSError **)error {
+    if (!_realm->is_in_transaction()) {
+        @throw RLMException(@"Can only yield a write transaction from within a write transaction.");
+    }
+    if (NSThread.isMainThread || !_suspendedIndexes.empty()) {
+        return YES;
+    }
+    auto waiters = RLMPriorityWritersForPath(_realm->config().path, false);
+    if (!waiters) {
         return YES;
     }
+    {
+        std::lock_guard lock(waiters->mutex);
+        if (waiters->count == 0) {
+            return YES;
+        }
+    }
+
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    try {
+        _realm->commit_transaction();
+        {
+            std::unique_lock lock(waiters->mutex);
+            waiters->cv.wait(lock, [&] { return waiters->count == 0; });
+        }
+        _realm->begin_transaction();
+    }
     catch (...) {
         RLMRealmTranslateException(error);
         return NO;
     }
+    ++_writeYieldCount;
+    _writeYieldDuration += CFAbsoluteTimeGetCurrent() - start;
+    return YES;
 }
 
 - (void)commitWriteTransaction {
@@ -666,14 +1175,62 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
         [token suppressNextNotification];
     }
 
+    CFAbsoluteTime start = 0;
+    NSDictionary<NSString *, NSNumber *> *objectCountChanges;
+    // Committing sends notifications which could begin another write, so take
+    // this transaction's blobs first
+    NSMutableSet<NSString *> *unreferencedBlobs = _unreferencedBlobs;
+    _unreferencedBlobs = nil;
     try {
+        if (_writeTransactionObserver) {
+            start = CFAbsoluteTimeGetCurrent();
+            // Measure the changes before committing, as committing sends
+            // notifications which could begin another write
+            objectCountChanges = [self writeObjectCountChanges];
+        }
+        [self rebuildSuspendedIndexes];
         _realm->commit_transaction();
-        return YES;
+        if (tokens.count) {
+            _lastSkippedNotificationVersion = _realm->read_transaction_version().version;
+        }
     }
     catch (...) {
         RLMRealmTranslateException(error);
         return NO;
     }
+    if (unreferencedBlobs.count) {
+        [self removeExternalBlobs:unreferencedBlobs];
+    }
+    if (_writeTransactionObserver) {
+        [self reportWriteTransactionWithCommitStart:start objectCountChanges:objectCountChanges cancelled:NO];
+    }
+    return YES;
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)writeObjectCountChanges {
+    NSMutableDictionary<NSString *, NSNumber *> *changes = [NSMutableDictionary new];
+    for (auto& [info, initialCount] : _writeInitialObjectCounts) {
+        auto table = info->table();
+        auto delta = static_cast<int64_t>(table ? table->size() : 0) - static_cast<int64_t>(initialCount);
+        if (delta) {
+            changes[info->rlmObjectSchema.className] = @(delta);
+        }
+    }
+    return changes;
+}
+
+- (void)reportWriteTransactionWithCommitStart:(CFAbsoluteTime)commitStart
+                           objectCountChanges:(NSDictionary<NSString *, NSNumber *> *)objectCountChanges
+                                    cancelled:(BOOL)cancelled {
+    CFAbsoluteTime end = CFAbsoluteTimeGetCurrent();
+    _writeInitialObjectCounts.clear();
+    _writeTransactionObserver([[RLMWriteTransactionMetrics alloc] initWithBegin:_writeBeginDuration
+                                                                    transaction:commitStart - _writeBeganAt
+                                                                         commit:end - commitStart
+                                                                      cancelled:cancelled
+                                                             objectCountChanges:objectCountChanges
+                                                                     yieldCount:_writeYieldCount
+                                                                  yieldDuration:_writeYieldDuration]);
 }
 
 - (void)transactionWithBlock:(__attribute__((noescape)) void(^)(void))block {
@@ -697,13 +1254,332 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
     return YES;
 }
 
+namespace {
+struct RLMAsyncWrite {
+    RLMRealmConfiguration *configuration;
+    void (^block)(RLMRealm *);
+    void (^complete)(NSError *);
+};
+
+// The pending asynchronous writes for a single Realm file. Each file has its
+// own serial queue, and all of the writes which were requested by the time
+// that queue gets to them (up to the configured maximum) are performed in a
+// single write transaction.
+struct RLMAsyncWriteQueue {
+    dispatch_queue_t queue;
+    std::vector<RLMAsyncWrite> pending;
+    bool scheduled = false;
+    // Incremented each time the pending writes are scheduled, so that a
+    // delayed group commit which was superseded by an earlier flush can tell
+    // that it no longer has anything to do
+    uint64_t generation = 0;
+};
+
+std::mutex& s_asyncWriteMutex = *new std::mutex();
+auto& s_asyncWriteQueues = *new std::unordered_map<std::string, RLMAsyncWriteQueue>();
+
+// Writes from Realms with different schemas need an RLMRealm each, and so
+// can't share a write transaction
+bool RLMCanShareAsyncWrite(RLMRealmConfiguration *a, RLMRealmConfiguration *b) {
+    return a.dynamic == b.dynamic && a.customSchema == b.customSchema;
+}
+
+void RLMPerformAsyncWrites(RLMAsyncWriteQueue& writeQueue, uint64_t generation);
+
+// Must be called with s_asyncWriteMutex held
+void RLMScheduleAsyncWrites(RLMAsyncWriteQueue& writeQueue, NSTimeInterval delay) {
+    writeQueue.scheduled = true;
+    auto generation = ++writeQueue.generation;
+    auto writeQueuePtr = &writeQueue;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, static_cast<int64_t>(delay * NSEC_PER_SEC)),
+                   writeQueue.queue, ^{
+        RLMPerformAsyncWrites(*writeQueuePtr, generation);
+    });
+}
+
+void RLMPerformAsyncWrites(RLMAsyncWriteQueue& writeQueue, uint64_t generation) {
+    std::vector<RLMAsyncWrite> writes;
+    {
+        std::lock_guard<std::mutex> lock(s_asyncWriteMutex);
+        if (generation != writeQueue.generation || writeQueue.pending.empty()) {
+            return;
+        }
+        writes.swap(writeQueue.pending);
+        writeQueue.scheduled = false;
+
+        // Leave any writes past the limit for the next commit, which doesn't
+        // need to wait as they've already waited for this one
+        NSUInteger limit = writes.front().configuration.maximumWritesPerGroupCommit;
+        if (limit && writes.size() > limit) {
+            writeQueue.pending.assign(writes.begin() + limit, writes.end());
+            writes.resize(limit);
+            RLMScheduleAsyncWrites(writeQueue, 0);
+        }
+    }
+
+    for (size_t begin = 0, end; begin < writes.size(); begin = end) {
+        RLMRealmConfiguration *configuration = writes[begin].configuration;
+        for (end = begin + 1; end < writes.size(); ++end) {
+            if (!RLMCanShareAsyncWrite(configuration, writes[end].configuration)) {
+                break;
+            }
+        }
+
+        // Each write is reported with the result of the transaction which
+        // contained it. A block which throws or cancels the transaction also
+        // discards the writes made by the blocks before it in that
+        // transaction, so those fail rather than reporting success.
+        std::vector<NSError *> errors(end - begin);
+        @autoreleasepool {
+            NSError *error;
+            size_t transactionBegin = begin;
+            auto fail = [&](size_t from, size_t to, NSError *error) {
+                for (size_t i = from; i < to; ++i) {
+                    errors[i - begin] = error;
+                }
+            };
+            RLMRealm *realm = [RLMRealm realmWithConfiguration:configuration error:&error];
+            for (size_t i = begin; realm && i < end; ++i) {
+                if (!realm.inWriteTransaction) {
+                    if (![realm beginWriteTransactionWithError:&error]) {
+                        break;
+                    }
+                    transactionBegin = i;
+                }
+                NSError *blockError;
+                @autoreleasepool {
+                    @try {
+                        writes[i].block(realm);
+                    }
+                    @catch (NSException *e) {
+                        blockError = [NSError errorWithDomain:RLMErrorDomain code:RLMErrorFail
+                                                     userInfo:@{NSLocalizedDescriptionKey: e.reason ?: e.name}];
+                        if (realm.inWriteTransaction) {
+                            [realm cancelWriteTransaction];
+                        }
+                    }
+                }
+                if (!blockError && !realm.inWriteTransaction) {
+                    blockError = [NSError errorWithDomain:RLMErrorDomain code:RLMErrorFail
+                                                 userInfo:@{NSLocalizedDescriptionKey: @"The write was cancelled."}];
+                }
+                if (blockError) {
+                    fail(transactionBegin, i, [NSError errorWithDomain:RLMErrorDomain code:RLMErrorFail
+                                                              userInfo:@{NSLocalizedDescriptionKey: @"The write was discarded because a later write in the same transaction was cancelled or threw an exception."}]);
+                    errors[i - begin] = blockError;
+                    transactionBegin = i + 1;
+                }
+            }
+            if (realm.inWriteTransaction) {
+                [realm commitWriteTransaction:&error];
+            }
+            if (error) {
+                fail(transactionBegin, end, error);
+            }
+        }
+        for (size_t i = begin; i < end; ++i) {
+            writes[i].complete(errors[i - begin]);
+        }
+    }
+}
+
+// Returns a block which performs the given block on `queue`, or on the current
+// thread if the Realm is confined to a thread rather than a queue
+void (^RLMCallbackScheduler(dispatch_queue_t queue))(dispatch_block_t) {
+    if (!queue && pthread_main_np()) {
+        queue = dispatch_get_main_queue();
+    }
+    if (queue) {
+        return ^(dispatch_block_t block) {
+            dispatch_async(queue, block);
+        };
+    }
+    CFRunLoopRef runLoop = CFRunLoopGetCurrent();
+    CFRetain(runLoop);
+    return ^(dispatch_block_t block) {
+        CFRunLoopPerformBlock(runLoop, kCFRunLoopDefaultMode, block);
+        CFRunLoopWakeUp(runLoop);
+        CFRelease(runLoop);
+    };
+}
+} // anonymous namespace
+
+- (void)asyncTransactionWithBlock:(void (^)(RLMRealm *))block onComplete:(void (^)(NSError *))onComplete {
+    [self verifyThread];
+    if (self.isFrozen) {
+        @throw RLMException(@"Cannot perform asynchronous writes on a frozen Realm.");
+    }
+    auto& config = _realm->config();
+    if (config.immutable() || config.read_only_alternative()) {
+        @throw RLMException(@"Cannot perform asynchronous writes on a read-only Realm.");
+    }
+
+    RLMRealmConfiguration *configuration = self.configuration;
+    configuration.cache = false;
+
+    void (^complete)(NSError *);
+    if (onComplete) {
+        auto schedule = RLMCallbackScheduler(_queue);
+        RLMRealm *realm = self;
+        complete = ^(NSError *error) {
+            schedule(^{
+                if (!realm.inWriteTransaction) {
+                    [realm refresh];
+                }
+                onComplete(error);
+            });
+        };
+    }
+    else {
+        complete = ^(NSError *) {};
+    }
+
+    std::lock_guard<std::mutex> lock(s_asyncWriteMutex);
+    auto& writeQueue = s_asyncWriteQueues[config.path];
+    if (!writeQueue.queue) {
+        writeQueue.queue = dispatch_queue_create("io.realm.asyncWriteQueue", DISPATCH_QUEUE_SERIAL);
+    }
+    writeQueue.pending.push_back({configuration, block, complete});
+    NSUInteger limit = writeQueue.pending.front().configuration.maximumWritesPerGroupCommit;
+    if (limit && writeQueue.pending.size() >= limit) {
+        // Don't wait for the rest of the group commit interval once the
+        // commit is full
+        RLMScheduleAsyncWrites(writeQueue, 0);
+    }
+    else if (!writeQueue.scheduled) {
+        RLMScheduleAsyncWrites(writeQueue, writeQueue.pending.front().configuration.groupCommitInterval);
+    }
+}
+
+- (void)beginBulkLoadForClasses:(NSArray<NSString *> *)classNames {
+    if (!_realm->is_in_transaction()) {
+        @throw RLMException(@"Can only begin a bulk load during a write transaction - call beginWriteTransaction on an RLMRealm instance first.");
+    }
+    for (NSString *className in classNames) {
+        auto& info = _info[className];
+        auto table = info.table();
+        if (!table) {
+            continue;
+        }
+        for (auto& prop : info.objectSchema->persisted_properties) {
+            if (prop.is_primary || !table->has_search_index(prop.column_key)) {
+                continue;
+            }
+            RLMTranslateError([&] { table->remove_search_index(prop.column_key); });
+            _suspendedIndexes.emplace_back(table->get_key(), prop.column_key);
+        }
+    }
+}
+
+- (NSUInteger)removeUnreferencedExternalBlobs {
+    if (!_realm->is_in_transaction()) {
+        @throw RLMException(@"Can only remove unreferenced external blobs during a write transaction - call beginWriteTransaction on an RLMRealm instance first.");
+    }
+    NSMutableSet<NSString *> *unreferenced = [NSMutableSet new];
+    NSString *directory = RLMBlobDirectory(_realm->config().path);
+    NSCharacterSet *nonHex = [NSCharacterSet characterSetWithCharactersInString:@"0123456789abcdef"].invertedSet;
+    for (NSString *fileName in [NSFileManager.defaultManager contentsOfDirectoryAtPath:directory error:nil]) {
+        if (fileName.length == 64 && [fileName rangeOfCharacterFromSet:nonHex].location == NSNotFound) {
+            [unreferenced addObject:fileName];
+        }
+    }
+    [self removeBlobsReferencedInGroup:_realm->read_group() fromSet:unreferenced];
+
+    // The files are only removed once the write transaction is committed, as
+    // cancelling it would restore the references to them
+    _unreferencedBlobs = unreferenced;
+    return unreferenced.count;
+}
+
+- (void)removeBlobsReferencedInGroup:(realm::Group&)group fromSet:(NSMutableSet<NSString *> *)names {
+    for (auto& [className, info] : _info) {
+        auto table = info.table();
+        if (!table || info.externalBlobColumns().empty() || !group.has_table(table->get_key())) {
+            continue;
+        }
+        // The group may be at an older version where the table or columns differ
+        auto groupTable = group.get_table(table->get_key());
+        for (auto col : info.externalBlobColumns()) {
+            if (!groupTable->valid_column(col)) {
+                continue;
+            }
+            for (auto& obj : *groupTable) {
+                auto value = obj.get<realm::BinaryData>(col);
+                if (!value.is_null()) {
+                    [names removeObject:RLMBlobName(value)];
+                }
+            }
+        }
+    }
+}
+
+- (void)removeExternalBlobs:(NSMutableSet<NSString *> *)names {
+    // A notification sent by the commit began another write, which holds the
+    // write lock. Check the blobs again when that one is committed.
+    if (_realm->is_in_transaction()) {
+        _unreferencedBlobs = names;
+        return;
+    }
+
+    try {
+        // Hold the write lock while removing the files so that no other writer
+        // can store a new reference to one of them, as storing a blob which
+        // already exists doesn't write the file again
+        auto& db = realm::Realm::Internal::get_db(*_realm);
+        auto write = db->start_write();
+        [self removeBlobsReferencedInGroup:*write fromSet:names];
+
+        // Other Realms in this process which have not yet refreshed (including
+        // frozen Realms) may still read blobs which the latest version no
+        // longer references
+        auto latest = write->get_version_of_current_transaction().version;
+        for (RLMRealm *realm : RLMGetCachedRealmsForPath(_realm->config().path)) {
+            uint64_t version = realm->_pinnedVersion.load(std::memory_order_relaxed);
+            if (realm == self || !version || version >= latest || !names.count) {
+                continue;
+            }
+            VersionID versionId(version, realm->_pinnedVersionIndex.load(std::memory_order_relaxed));
+            [self removeBlobsReferencedInGroup:*db->start_frozen(versionId) fromSet:names];
+        }
+
+        NSString *directory = RLMBlobDirectory(_realm->config().path);
+        for (NSString *fileName in names) {
+            [NSFileManager.defaultManager removeItemAtPath:[directory stringByAppendingPathComponent:fileName] error:nil];
+        }
+    }
+    catch (std::exception const& e) {
+        // A pinned version could not be read, so any of the blobs may still be
+        // in use. They'll be found again by the next call.
+        NSLog(@"Not removing unreferenced external blobs for the Realm at '%@': %s",
+              @(_realm->config().path.c_str()), e.what());
+    }
+}
+
+- (void)rebuildSuspendedIndexes {
+    if (_suspendedIndexes.empty()) {
+        return;
+    }
+    auto& group = _realm->read_group();
+    for (auto& [tableKey, colKey] : _suspendedIndexes) {
+        group.get_table(tableKey)->add_search_index(colKey);
+    }
+    _suspendedIndexes.clear();
+}
+
 - (void)cancelWriteTransaction {
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    // Rolling back restores the indexes and any references to the blobs
+    _suspendedIndexes.clear();
+    _unreferencedBlobs = nil;
     try {
         _realm->cancel_transaction();
     }
     catch (std::exception &ex) {
         @throw RLMException(ex);
     }
+    if (_writeTransactionObserver) {
+        [self reportWriteTransactionWithCommitStart:start objectCountChanges:@{} cancelled:YES];
+    }
 }
 
 - (void)invalidate {
@@ -720,6 +1596,8 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
         }
     }
 
+    _suspendedIndexes.clear();
+    _unreferencedBlobs = nil;
     _realm->invalidate();
 
     for (auto& objectInfo : _info) {
@@ -731,12 +1609,77 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
     if (_realm->is_frozen()) {
         _realm->close();
     }
+    [self recordPinnedVersion];
+}
+
+- (void)recordPinnedVersion {
+    uint64_t version = 0;
+    if (!_realm->is_closed() && _realm->is_in_read_transaction()) {
+        auto versionId = _realm->read_transaction_version();
+        version = versionId.version;
+        _pinnedVersionIndex.store(versionId.index, std::memory_order_relaxed);
+    }
+    if (_pinnedVersion.exchange(version, std::memory_order_relaxed) != version) {
+        _pinnedSince.store(CFAbsoluteTimeGetCurrent(), std::memory_order_release);
+    }
+}
+
++ (NSArray<RLMVersionPin *> *)versionPinsForConfiguration:(RLMRealmConfiguration *)configuration {
+    NSMutableArray<RLMVersionPin *> *pins = [NSMutableArray new];
+    for (RLMRealm *realm : RLMGetCachedRealmsForPath(configuration.config.path)) {
+        CFAbsoluteTime pinnedSince = realm->_pinnedSince.load(std::memory_order_acquire);
+        if (uint64_t version = realm->_pinnedVersion.load(std::memory_order_relaxed)) {
+            [pins addObject:[[RLMVersionPin alloc] initWithVersion:version
+                                                            frozen:realm.frozen
+                                                            holder:realm->_holderDescription
+                                                       pinnedSince:[NSDate dateWithTimeIntervalSinceReferenceDate:pinnedSince]]];
+        }
+    }
+    [pins sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"version" ascending:YES]]];
+    return pins;
+}
+
++ (RLMFrozenRealmCacheStatistics *)frozenRealmCacheStatistics {
+    auto metrics = RLMGetFrozenRealmCacheMetrics();
+    return [[RLMFrozenRealmCacheStatistics alloc] initWithHits:metrics.hits misses:metrics.misses
+                                                pinnedVersions:metrics.pinnedVersions];
+}
+
+- (RLMStorageStatistics *)storageStatistics {
+    [self verifyThread];
+    auto objectCounts = [NSMutableDictionary new];
+    for (auto& [className, info] : _info) {
+        // Tables may be missing from read-only Realms
+        auto table = info.table();
+        objectCounts[className] = @(table ? table->size() : 0);
+    }
+
+    size_t freeBytes = 0, usedBytes = 0;
+    uint64_t versions = 0;
+    try {
+        auto& db = realm::Realm::Internal::get_db(*_realm);
+        db->get_stats(freeBytes, usedBytes);
+        versions = db->get_number_of_versions();
+    }
+    catch (std::exception const& e) {
+        @throw RLMException(e);
+    }
+    return [[RLMStorageStatistics alloc] initWithUsedBytes:usedBytes freeBytes:freeBytes
+                                    numberOfActiveVersions:versions objectCounts:objectCounts];
 }
 
 - (nullable id)resolveThreadSafeReference:(RLMThreadSafeReference *)reference {
     return [reference resolveReferenceInRealm:self];
 }
 
+- (NSArray *)resolveThreadSafeReferenceBatch:(RLMThreadSafeReferenceBatch *)batch {
+    return [batch resolveInRealm:self];
+}
+
+- (nullable id)resolveObjectReference:(RLMObjectReference *)reference {
+    return [reference resolveInRealm:self];
+}
+
 /**
  Replaces all string columns in this Realm with a string enumeration column and compacts the
  database file.
@@ -774,6 +1717,45 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
     }
 }
 
++ (void)asyncCompactWithConfiguration:(RLMRealmConfiguration *)configuration
+                        callbackQueue:(dispatch_queue_t)callbackQueue
+                             callback:(void (^)(BOOL, NSError *))callback {
+    configuration = [configuration copy];
+    // Don't reuse (or leave behind) an instance cached for the background thread
+    configuration.cache = false;
+    dispatch_async(s_async_open_queue, ^{
+        BOOL compacted = NO;
+        NSError *error;
+        // Compacting invalidates every other instance's accessors, so as with
+        // shouldCompactOnLaunch, only compact if nothing in this process has
+        // the file open
+        RLMReleaseRecentFrozenRealms(configuration.config.path);
+        if (!RLMGetAnyCachedRealmForPath(configuration.config.path)) {
+            @autoreleasepool {
+                if (RLMRealm *realm = [RLMRealm realmWithConfiguration:configuration error:&error]) {
+                    [realm invalidate];
+                    try {
+                        compacted = realm->_realm->compact();
+                    }
+                    catch (...) {
+                        RLMRealmTranslateException(&error);
+                    }
+                }
+            }
+        }
+        dispatch_async(callbackQueue, ^{
+            callback(compacted, error);
+        });
+    });
+}
+
++ (RLMExpirationSweeper *)startExpiringObjectsWithConfiguration:(RLMRealmConfiguration *)configuration
+                                                       interval:(NSTimeInterval)interval
+                                           maximumWriteDuration:(NSTimeInterval)maximumWriteDuration {
+    return [[RLMExpirationSweeper alloc] initWithConfiguration:configuration interval:interval
+                                          maximumWriteDuration:maximumWriteDuration];
+}
+
 - (void)dealloc {
     if (_realm) {
         if (_realm->is_in_transaction()) {
@@ -782,6 +1764,9 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
                   "pending changes have been rolled back. Make sure to retain a reference to the "
                   "RLMRealm for the duration of the write transaction.");
         }
+        if (!_realm->is_frozen()) {
+            RLMReleaseRecentFrozenRealmsIfUnused(_realm->config().path);
+        }
     }
 }
 
@@ -790,7 +1775,9 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
         @throw RLMException(@"Read-only Realms do not change and cannot be refreshed.");
     }
     try {
-        return _realm->refresh();
+        bool refreshed = _realm->refresh();
+        [self recordPinnedVersion];
+        return refreshed;
     }
     catch (std::exception const& e) {
         @throw RLMException(e);
@@ -863,24 +1850,21 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
             @throw RLMException(@"Cannot delete objects from RLMDictionary of type %@: only RLMObjects can be deleted.",
                                 RLMTypeToString(dictionary.type));
         }
-        for (RLMObject *obj in dictionary.allValues) {
-            RLMDeleteObjectFromRealm(obj, self);
-        }
+        // Create all of the accessors before deleting any of the objects
+        RLMDeleteObjectsFromRealm([NSArray arrayWithArray:dictionary.allValues], self);
         return;
     }
-    for (RLMObject *obj in objects) {
-        if (![obj isKindOfClass:RLMObjectBase.class]) {
-            @throw RLMException(@"Cannot delete objects of type %@ with deleteObjects:. Only RLMObjects can be deleted.",
-                                NSStringFromClass(obj.class));
-        }
-        RLMDeleteObjectFromRealm(obj, self);
-    }
+    RLMDeleteObjectsFromRealm(objects, self);
 }
 
 - (void)deleteAllObjects {
     RLMDeleteAllObjectsFromRealm(self);
 }
 
+- (void)truncateAllObjects {
+    RLMTruncateAllObjectsInRealm(self);
+}
+
 - (RLMResults *)allObjects:(NSString *)objectClassName {
     return RLMGetObjects(self, objectClassName, nil);
 }
@@ -905,6 +1889,10 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
     return RLMGetObject(self, className, primaryKey);
 }
 
+- (NSArray *)objectsWithClassName:(NSString *)className forPrimaryKeys:(NSArray *)primaryKeys {
+    return RLMGetObjectsForPrimaryKeys(self, className, primaryKeys);
+}
+
 + (uint64_t)schemaVersionAtURL:(NSURL *)fileURL encryptionKey:(NSData *)key error:(NSError **)error {
     RLMRealmConfiguration *config = [[RLMRealmConfiguration alloc] init];
     try {
@@ -923,7 +1911,45 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
     }
 }
 
++ (RLMRealmFileInfo *)fileInfoAtURL:(NSURL *)fileURL encryptionKey:(NSData *)key error:(NSError **)error {
+    try {
+        NSData *validatedKey = RLMRealmValidatedEncryptionKey(key);
+        std::string path = fileURL.path.UTF8String;
+
+        // The header of an unencrypted file starts with the two top refs
+        // followed by the "T-DB" mnemonic. Encrypted files start with the
+        // IVs for the first block of pages instead.
+        uint64_t fileSize;
+        bool encrypted;
+        {
+            realm::util::File file(path, realm::util::File::mode_Read);
+            fileSize = file.get_size();
+            char header[24] = {};
+            size_t read = file.read(header, sizeof(header));
+            encrypted = read < sizeof(header) || memcmp(header + 16, "T-DB", 4) != 0;
+        }
+        if (encrypted && !validatedKey) {
+            RLMSetErrorOrThrow([NSError errorWithDomain:RLMErrorDomain code:RLMErrorFileAccess
+                                               userInfo:@{NSLocalizedDescriptionKey: @"Realm file is encrypted or is not a Realm file.",
+                                                          NSFilePathErrorKey: fileURL.path}], error);
+            return nil;
+        }
+
+        // A read-only Group maps the file directly, with no lock file or
+        // coordinator, and only reads the pages it needs
+        realm::Group group(path, static_cast<const char *>(encrypted ? validatedKey.bytes : nullptr));
+        return [[RLMRealmFileInfo alloc] initWithSchemaVersion:realm::ObjectStore::get_schema_version(group)
+                                             fileFormatVersion:group.get_file_format_version()
+                                                      fileSize:fileSize encrypted:encrypted];
+    }
+    catch (...) {
+        RLMRealmTranslateException(error);
+        return nil;
+    }
+}
+
 + (BOOL)performMigrationForConfiguration:(RLMRealmConfiguration *)configuration error:(NSError **)error {
+    RLMReleaseRecentFrozenRealms(configuration.config.path);
     if (RLMGetAnyCachedRealmForPath(configuration.config.path)) {
         @throw RLMException(@"Cannot migrate Realms that are already open.");
     }
@@ -939,17 +1965,222 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
     return success;
 }
 
++ (void)migrateAsyncWithConfiguration:(RLMRealmConfiguration *)configuration
+                        callbackQueue:(dispatch_queue_t)callbackQueue
+                             progress:(RLMMigrationProgressBlock)progress
+                           completion:(void (^)(NSError *))completion {
+    // Check this synchronously so that the exception is thrown on the caller's
+    // thread rather than crashing the background queue
+    RLMReleaseRecentFrozenRealms(configuration.config.path);
+    if (RLMGetAnyCachedRealmForPath(configuration.config.path)) {
+        @throw RLMException(@"Cannot migrate Realms that are already open.");
+    }
+
+    configuration = [configuration copy];
+    if (progress) {
+        configuration.migrationProgressBlock = ^(NSString *className, NSUInteger enumerated, NSUInteger total) {
+            dispatch_async(callbackQueue, ^{
+                progress(className, enumerated, total);
+            });
+        };
+    }
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        // The Realm may have been opened since the check above, and nothing
+        // thrown here would reach the caller, so report it as an error instead
+        NSError *error;
+        @try {
+            [self performMigrationForConfiguration:configuration error:&error];
+        }
+        @catch (NSException *e) {
+            bool alreadyOpen = RLMGetAnyCachedRealmForPath(configuration.config.path) != nil;
+            error = [NSError errorWithDomain:RLMErrorDomain code:alreadyOpen ? RLMErrorAlreadyOpen : RLMErrorFail
+                                    userInfo:@{NSLocalizedDescriptionKey: e.reason ?: e.name}];
+        }
+        dispatch_async(callbackQueue, ^{
+            completion(error);
+        });
+    });
+}
+
 - (RLMObject *)createObject:(NSString *)className withValue:(id)value {
     return (RLMObject *)RLMCreateObjectInRealmWithValue(self, className, value, RLMUpdatePolicyError);
 }
 
+- (void)createObjects:(NSString *)className withValues:(id<NSFastEnumeration>)values {
+    RLMCreateObjectsInRealmWithValues(self, className, values, RLMUpdatePolicyError);
+}
+
+- (RLMUpsertCounts)createOrUpdateModifiedObjects:(NSString *)className
+                                      withValues:(id<NSFastEnumeration>)values {
+    if (!self.schema[className].primaryKeyProperty) {
+        @throw RLMException(@"'%@' does not have a primary key and can not be updated", className);
+    }
+    return RLMCreateObjectsInRealmWithValues(self, className, values, RLMUpdatePolicyUpdateChanged);
+}
+
+- (void)prefetchResults:(RLMResults *)results properties:(NSArray<NSString *> *)properties {
+    [self verifyThread];
+    if (results.realm != self) {
+        @throw RLMException(@"Can only prefetch results from this Realm.");
+    }
+    if (results.type != RLMPropertyTypeObject) {
+        return;
+    }
+    for (NSString *name in properties) {
+        if (!self.schema[results.objectClassName][name]) {
+            @throw RLMException(@"Invalid property name '%@' for class '%@'.", name, results.objectClassName);
+        }
+    }
+
+    // Frozen results can be read on the background queue, and pin the version
+    // being read only until the prefetch completes
+    RLMResults *frozen = results.freeze;
+    properties = [properties copy];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        @autoreleasepool {
+            [frozen prefetchProperties:properties];
+        }
+    });
+}
+
+- (void)prefetchObjectsOfClass:(NSString *)className properties:(NSArray<NSString *> *)properties {
+    [self prefetchResults:[self allObjects:className] properties:properties];
+}
+
+// Convert a value parsed from JSON written by -[RLMResults writeJSONLinesToStream:error:]
+// back to the type used for the property
+static id objectFromJSONValue(__unsafe_unretained id const value, RLMPropertyType type) {
+    if ([value isKindOfClass:[NSNumber class]]) {
+        if (type == RLMPropertyTypeDate) {
+            return [NSDate dateWithTimeIntervalSince1970:[value doubleValue]];
+        }
+        return value;
+    }
+    if (![value isKindOfClass:[NSString class]]) {
+        return value;
+    }
+    switch (type) {
+        case RLMPropertyTypeData:
+            return [[NSData alloc] initWithBase64EncodedString:value options:0] ?: value;
+        case RLMPropertyTypeDecimal128:
+            return [[RLMDecimal128 alloc] initWithString:value error:nil] ?: value;
+        case RLMPropertyTypeObjectId:
+            return [[RLMObjectId alloc] initWithString:value error:nil] ?: value;
+        case RLMPropertyTypeUUID:
+            return [[NSUUID alloc] initWithUUIDString:value] ?: value;
+        default:
+            return value;
+    }
+}
+
+static id objectFromJSONProperty(__unsafe_unretained id const value, RLMProperty *prop) {
+    if (prop.dictionary) {
+        if (NSDictionary *dictionary = RLMDynamicCast<NSDictionary>(value)) {
+            NSMutableDictionary *ret = [NSMutableDictionary dictionaryWithCapacity:dictionary.count];
+            for (id key in dictionary) {
+                ret[key] = objectFromJSONValue(dictionary[key], prop.type);
+            }
+            return ret;
+        }
+        return value;
+    }
+    if (prop.collection) {
+        if (NSArray *array = RLMDynamicCast<NSArray>(value)) {
+            NSMutableArray *ret = [NSMutableArray arrayWithCapacity:array.count];
+            for (id element in array) {
+                [ret addObject:objectFromJSONValue(element, prop.type)];
+            }
+            return ret;
+        }
+        return value;
+    }
+    return objectFromJSONValue(value, prop.type);
+}
+
+- (BOOL)createObjects:(NSString *)className fromJSONLinesStream:(NSInputStream *)stream error:(NSError **)error {
+    RLMVerifyInWriteTransaction(self);
+    RLMObjectSchema *objectSchema = self.schema[className];
+    if (!objectSchema) {
+        @throw RLMException(@"Object type '%@' is not managed by the Realm.", className);
+    }
+
+    static const NSUInteger readSize = 64 * 1024;
+    static const NSUInteger batchSize = 1000;
+    NSMutableData *pending = [NSMutableData data];
+    NSMutableArray *batch = [NSMutableArray arrayWithCapacity:batchSize];
+    std::vector<uint8_t> buffer(readSize);
+
+    // Parse one line into a value dictionary and add it to the batch
+    auto parseLine = [&](NSData *line) -> BOOL {
+        if (line.length == 0) {
+            return YES;
+        }
+        NSError *jsonError;
+        NSDictionary *json = [NSJSONSerialization JSONObjectWithData:line options:0 error:&jsonError];
+        if (![json isKindOfClass:[NSDictionary class]]) {
+            if (error) {
+                *error = jsonError ?: [NSError errorWithDomain:NSCocoaErrorDomain
+                                                          code:NSPropertyListReadCorruptError
+                                                      userInfo:@{NSLocalizedDescriptionKey: @"Each line must contain a JSON object."}];
+            }
+            return NO;
+        }
+        NSMutableDictionary *value = [NSMutableDictionary dictionaryWithCapacity:json.count];
+        for (NSString *key in json) {
+            RLMProperty *prop = objectSchema[key];
+            value[key] = prop ? objectFromJSONProperty(json[key], prop) : json[key];
+        }
+        [batch addObject:value];
+        if (batch.count == batchSize) {
+            RLMCreateObjectsInRealmWithValues(self, className, batch, RLMUpdatePolicyError);
+            [batch removeAllObjects];
+        }
+        return YES;
+    };
+
+    while (true) {
+        @autoreleasepool {
+            NSInteger bytesRead = [stream read:buffer.data() maxLength:readSize];
+            if (bytesRead < 0) {
+                if (error) {
+                    *error = stream.streamError;
+                }
+                return NO;
+            }
+            if (bytesRead == 0) {
+                break;
+            }
+            [pending appendBytes:buffer.data() length:bytesRead];
+
+            // Parse every complete line and keep the remainder for the next read
+            auto bytes = static_cast<const char *>(pending.bytes);
+            NSUInteger start = 0;
+            for (NSUInteger i = pending.length - bytesRead; i < pending.length; ++i) {
+                if (bytes[i] == '\n') {
+                    if (!parseLine([pending subdataWithRange:{start, i - start}])) {
+                        return NO;
+                    }
+                    start = i + 1;
+                }
+            }
+            [pending replaceBytesInRange:{0, start} withBytes:nullptr length:0];
+        }
+    }
+    if (!parseLine(pending)) {
+        return NO;
+    }
+    if (batch.count) {
+        RLMCreateObjectsInRealmWithValues(self, className, batch, RLMUpdatePolicyError);
+    }
+    return YES;
+}
+
 - (BOOL)writeCopyToURL:(NSURL *)fileURL encryptionKey:(NSData *)key error:(NSError **)error {
     key = RLMRealmValidatedEncryptionKey(key);
     NSString *path = fileURL.path;
 
     try {
         _realm->write_copy(path.UTF8String, {static_cast<const char *>(key.bytes), key.length});
-        return YES;
     }
     catch (...) {
         if (error) {
@@ -958,7 +2189,88 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
         return NO;
     }
 
-    return NO;
+    // External blobs live next to the Realm file and need to be copied along
+    // with it for the copy to be usable
+    NSString *blobs = RLMBlobDirectory(_realm->config().path);
+    NSFileManager *manager = NSFileManager.defaultManager;
+    if (![manager fileExistsAtPath:blobs]) {
+        return YES;
+    }
+    NSString *destination = RLMBlobDirectory(path.UTF8String);
+    [manager createDirectoryAtPath:destination withIntermediateDirectories:YES attributes:nil error:nil];
+    for (NSString *fileName in [manager contentsOfDirectoryAtPath:blobs error:nil]) {
+        NSString *target = [destination stringByAppendingPathComponent:fileName];
+        if (![manager fileExistsAtPath:target]
+            && ![manager copyItemAtPath:[blobs stringByAppendingPathComponent:fileName] toPath:target error:error]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+- (BOOL)writeCopyToStream:(NSOutputStream *)stream
+            encryptionKey:(NSData *)key
+    maximumBytesPerSecond:(uint64_t)maximumBytesPerSecond
+                 progress:(void (^)(uint64_t, uint64_t))progress
+                    error:(NSError **)error {
+    NSString *fileName = [NSString stringWithFormat:@"%@.realm", NSUUID.UUID.UUIDString];
+    NSURL *tmpURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:fileName]];
+    if (![self writeCopyToURL:tmpURL encryptionKey:key error:error]) {
+        return NO;
+    }
+
+    NSFileHandle *handle = [NSFileHandle fileHandleForReadingFromURL:tmpURL error:error];
+    if (!handle) {
+        [NSFileManager.defaultManager removeItemAtURL:tmpURL error:nil];
+        return NO;
+    }
+
+    static const NSUInteger chunkSize = 1024 * 1024;
+    uint64_t totalBytes = [handle seekToEndOfFile];
+    [handle seekToFileOffset:0];
+    uint64_t bytesWritten = 0;
+    auto start = std::chrono::steady_clock::now();
+    BOOL success = YES;
+    while (bytesWritten < totalBytes) {
+        @autoreleasepool {
+            NSData *chunk = [handle readDataOfLength:chunkSize];
+            if (chunk.length == 0) {
+                break;
+            }
+            auto bytes = static_cast<const uint8_t *>(chunk.bytes);
+            NSUInteger offset = 0;
+            while (offset < chunk.length) {
+                NSInteger written = [stream write:bytes + offset maxLength:chunk.length - offset];
+                if (written <= 0) {
+                    success = NO;
+                    break;
+                }
+                offset += written;
+            }
+            if (!success) {
+                break;
+            }
+            bytesWritten += chunk.length;
+        }
+        if (progress) {
+            progress(bytesWritten, totalBytes);
+        }
+        if (maximumBytesPerSecond) {
+            // Sleep until the rate so far is back under the limit
+            auto target = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(double(bytesWritten) / maximumBytesPerSecond));
+            std::this_thread::sleep_until(target);
+        }
+    }
+
+    [handle closeFile];
+    [NSFileManager.defaultManager removeItemAtURL:tmpURL error:nil];
+    if (!success && error) {
+        *error = stream.streamError ?: [NSError errorWithDomain:NSCocoaErrorDomain
+                                                           code:NSFileWriteUnknownError
+                                                       userInfo:@{NSLocalizedDescriptionKey: @"Could not write Realm copy to the output stream."}];
+    }
+    return success;
 }
 
 + (BOOL)fileExistsForConfiguration:(RLMRealmConfiguration *)config {
@@ -967,8 +2279,16 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
 
 + (BOOL)deleteFilesForConfiguration:(RLMRealmConfiguration *)config error:(NSError **)error {
     bool didDeleteAny = false;
+    RLMReleaseRecentFrozenRealms(config.config.path);
     try {
         realm::Realm::delete_files(config.config.path, &didDeleteAny);
+        NSString *blobs = RLMBlobDirectory(config.config.path);
+        if ([NSFileManager.defaultManager fileExistsAtPath:blobs]) {
+            if (![NSFileManager.defaultManager removeItemAtPath:blobs error:error]) {
+                return didDeleteAny;
+            }
+            didDeleteAny = true;
+        }
         return didDeleteAny;
     }
     catch (realm::util::File::PermissionDenied const& e) {
@@ -993,7 +2313,21 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
 
 - (RLMRealm *)freeze {
     [self verifyThread];
-    return self.isFrozen ? self : RLMGetFrozenRealmForSourceRealm(self);
+    if (self.isFrozen) {
+        return self;
+    }
+    _realm->read_group();
+    uint64_t version = _realm->read_transaction_version().version;
+    RLMRealm *frozen = _lastFrozenRealm;
+    if (!frozen || _lastFrozenVersion != version || frozen->_realm->is_closed()) {
+        frozen = RLMGetFrozenRealmForSourceRealm(self);
+        _lastFrozenRealm = frozen;
+        _lastFrozenVersion = version;
+    }
+    else {
+        RLMRecordFrozenRealmCacheHit();
+    }
+    return frozen;
 }
 
 - (RLMRealm *)thaw {
@@ -1010,6 +2344,8 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
         realm->_dynamic = _dynamic;
         realm->_schema = _schema;
         realm->_info = RLMSchemaInfo(realm);
+        realm->_holderDescription = @"frozen Realm";
+        [realm recordPinnedVersion];
         return realm;
     }
     catch (std::exception const& e) {
@@ -1039,3 +2375,311 @@ REALM_NOINLINE void RLMRealmTranslateException(NSError **error) {
 }
 
 @end
+
+@implementation RLMVersionPin
+- (instancetype)initWithVersion:(uint64_t)version frozen:(BOOL)frozen holder:(NSString *)holder pinnedSince:(NSDate *)pinnedSince {
+    if ((self = [super init])) {
+        _version = version;
+        _frozen = frozen;
+        _holder = holder;
+        _pinnedSince = pinnedSince;
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<RLMVersionPin: version %llu held by %@ for %.1fs>",
+            _version, _holder, -_pinnedSince.timeIntervalSinceNow];
+}
+@end
+
+@implementation RLMFrozenRealmCacheStatistics
+- (instancetype)initWithHits:(uint64_t)hits misses:(uint64_t)misses pinnedVersions:(NSUInteger)pinnedVersions {
+    if ((self = [super init])) {
+        _hits = hits;
+        _misses = misses;
+        _pinnedVersions = pinnedVersions;
+    }
+    return self;
+}
+@end
+
+namespace {
+struct RLMExpiringType {
+    NSString *className;
+    NSString *propertyName;
+    NSTimeInterval timeToLive;
+};
+} // anonymous namespace
+
+@implementation RLMExpirationSweeper {
+    RLMRealmConfiguration *_configuration;
+    std::vector<RLMExpiringType> _types;
+    std::chrono::steady_clock::duration _maximumWriteDuration;
+    dispatch_queue_t _queue;
+    dispatch_source_t _timer;
+    std::atomic<bool> _invalidated;
+
+    // Only accessed on _queue
+    RLMRealm *_realm;
+    bool _sweeping;
+}
+
+- (instancetype)initWithConfiguration:(RLMRealmConfiguration *)configuration
+                             interval:(NSTimeInterval)interval
+                 maximumWriteDuration:(NSTimeInterval)maximumWriteDuration {
+    if (interval <= 0 || maximumWriteDuration <= 0) {
+        @throw RLMException(@"The expiration interval and maximum write duration must be greater than zero.");
+    }
+    if (!(self = [super init])) {
+        return nil;
+    }
+
+    _configuration = [configuration copy];
+    _configuration.cache = false;
+    _maximumWriteDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(maximumWriteDuration));
+
+    // Validate the schema options up front so that mistakes are reported to
+    // the caller rather than on the background queue
+    for (RLMObjectSchema *objectSchema in (_configuration.customSchema ?: RLMSchema.sharedSchema).objectSchema) {
+        Class cls = objectSchema.objectClass;
+        NSString *propertyName = [cls timeToLiveProperty];
+        NSTimeInterval timeToLive = [cls timeToLive];
+        if (!propertyName || timeToLive <= 0) {
+            continue;
+        }
+        RLMProperty *property = objectSchema[propertyName];
+        if (!property) {
+            @throw RLMException(@"Time to live property '%@' does not exist on object type '%@'.",
+                                propertyName, objectSchema.className);
+        }
+        if (property.type != RLMPropertyTypeDate || property.collection) {
+            @throw RLMException(@"Time to live property '%@.%@' must be a date property.",
+                                objectSchema.className, propertyName);
+        }
+        _types.push_back({objectSchema.className, propertyName, timeToLive});
+    }
+
+    _queue = dispatch_queue_create("io.realm.expiration", DISPATCH_QUEUE_SERIAL);
+    _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, _queue);
+    uint64_t nanoseconds = static_cast<uint64_t>(interval * NSEC_PER_SEC);
+    dispatch_source_set_timer(_timer, dispatch_time(DISPATCH_TIME_NOW, nanoseconds), nanoseconds, nanoseconds / 10);
+    __weak RLMExpirationSweeper *weakSelf = self;
+    dispatch_source_set_event_handler(_timer, ^{
+        [weakSelf sweepOnQueueWithCompletion:nil];
+    });
+    dispatch_resume(_timer);
+    return self;
+}
+
+- (void)dealloc {
+    [self invalidate];
+}
+
+- (void)invalidate {
+    if (!_invalidated.exchange(true)) {
+        dispatch_source_cancel(_timer);
+    }
+}
+
+- (void)sweepWithCompletion:(void (^)(NSUInteger, NSError *))completion {
+    dispatch_async(_queue, ^{
+        [self sweepOnQueueWithCompletion:completion];
+    });
+}
+
+- (void)sweepOnQueueWithCompletion:(void (^)(NSUInteger, NSError *))completion {
+    // A sweep which is still working through a backlog from an earlier check
+    // covers this one too
+    if (_sweeping || _invalidated || _types.empty()) {
+        if (completion) {
+            completion(0, nil);
+        }
+        return;
+    }
+    if (!_realm) {
+        NSError *error;
+        _realm = [RLMRealm realmWithConfiguration:_configuration queue:_queue error:&error];
+        if (!_realm) {
+            if (completion) {
+                completion(0, error);
+            }
+            else {
+                NSLog(@"Opening the Realm at '%@' to delete expired objects failed: %@",
+                      _configuration.fileURL.path, error.localizedDescription);
+            }
+            return;
+        }
+    }
+    _sweeping = true;
+    [self sweepSliceFromType:0 cutoff:[NSDate date] deleted:0 completion:completion];
+}
+
+// Delete expired objects in a single write transaction until either there
+// are none left, the maximum write duration has passed or a write on the main
+// thread is waiting, and then schedule the next slice after giving other
+// writers a chance to acquire the write lock
+- (void)sweepSliceFromType:(size_t)typeIndex cutoff:(NSDate *)now deleted:(NSUInteger)deleted
+                completion:(void (^)(NSUInteger, NSError *))completion {
+    constexpr size_t batchSize = 256;
+    auto deadline = std::chrono::steady_clock::now() + _maximumWriteDuration;
+    bool outOfTime = false;
+    NSUInteger sliceDeleted = 0;
+    NSError *error;
+    // Errors end this sweep and are reported to the completion block; the
+    // next scheduled check starts over with a new sweep
+    @autoreleasepool {
+        @try {
+            if ([_realm beginWriteTransactionWithError:&error]) {
+                try {
+                    for (; typeIndex < _types.size(); ++typeIndex) {
+                        auto& type = _types[typeIndex];
+                        auto& info = _realm->_info[type.className];
+                        if (!info.table()) {
+                            continue;
+                        }
+                        NSDate *cutoff = [now dateByAddingTimeInterval:-type.timeToLive];
+                        auto query = RLMPredicateToQuery([NSPredicate predicateWithFormat:@"%K < %@", type.propertyName, cutoff], info);
+                        while (true) {
+                            auto expired = query.find_all(0, realm::npos, batchSize);
+                            if (expired.size() == 0) {
+                                break;
+                            }
+                            sliceDeleted += expired.size();
+                            expired.clear();
+                            if (std::chrono::steady_clock::now() >= deadline
+                                || RLMPriorityWriterIsWaiting(_realm->_realm->config().path)) {
+                                outOfTime = true;
+                                break;
+                            }
+                        }
+                        if (outOfTime) {
+                            break;
+                        }
+                    }
+                }
+                catch (std::exception const& e) {
+                    @throw RLMException(e);
+                }
+                if ([_realm commitWriteTransaction:&error]) {
+                    deleted += sliceDeleted;
+                }
+                else {
+                    outOfTime = false;
+                }
+            }
+        }
+        @catch (NSException *e) {
+            if (_realm.inWriteTransaction) {
+                [_realm cancelWriteTransaction];
+            }
+            error = [NSError errorWithDomain:RLMErrorDomain code:RLMErrorFail
+                                    userInfo:@{NSLocalizedDescriptionKey: e.reason ?: e.name}];
+            outOfTime = false;
+        }
+    }
+    if (error && !completion) {
+        NSLog(@"Deleting expired objects from the Realm at '%@' failed: %@",
+              _configuration.fileURL.path, error.localizedDescription);
+    }
+
+    if (!outOfTime || _invalidated) {
+        _sweeping = false;
+        if (completion) {
+            completion(deleted, error);
+        }
+        return;
+    }
+    auto delay = std::chrono::duration_cast<std::chrono::nanoseconds>(_maximumWriteDuration).count();
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, delay), _queue, ^{
+        [self sweepSliceFromType:typeIndex cutoff:now deleted:deleted completion:completion];
+    });
+}
+@end
+
+@implementation RLMRealmFileInfo
+- (instancetype)initWithSchemaVersion:(uint64_t)schemaVersion fileFormatVersion:(NSInteger)fileFormatVersion
+                             fileSize:(uint64_t)fileSize encrypted:(BOOL)encrypted {
+    if ((self = [super init])) {
+        _schemaVersion = schemaVersion;
+        _fileFormatVersion = fileFormatVersion;
+        _fileSize = fileSize;
+        _encrypted = encrypted;
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<RLMRealmFileInfo: schema version %llu, file format %ld, %llu bytes%s>",
+            _schemaVersion, (long)_fileFormatVersion, _fileSize, _encrypted ? ", encrypted" : ""];
+}
+@end
+
+@implementation RLMRealmChangeSummary
+- (instancetype)initWithInserted:(NSSet<NSString *> *)inserted deleted:(NSSet<NSString *> *)deleted
+                        modified:(NSSet<NSString *> *)modified {
+    if ((self = [super init])) {
+        _insertedClassNames = [inserted copy];
+        _deletedClassNames = [deleted copy];
+        _modifiedClassNames = [modified copy];
+        NSMutableSet *changed = [inserted mutableCopy];
+        [changed unionSet:deleted];
+        [changed unionSet:modified];
+        _changedClassNames = [changed copy];
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<RLMRealmChangeSummary: inserted %@, deleted %@, modified %@>",
+            _insertedClassNames.allObjects, _deletedClassNames.allObjects, _modifiedClassNames.allObjects];
+}
+@end
+
+@implementation RLMStorageStatistics
+- (instancetype)initWithUsedBytes:(uint64_t)usedBytes freeBytes:(uint64_t)freeBytes
+           numberOfActiveVersions:(uint64_t)numberOfActiveVersions
+                     objectCounts:(NSDictionary<NSString *, NSNumber *> *)objectCounts {
+    if ((self = [super init])) {
+        _usedBytes = usedBytes;
+        _freeBytes = freeBytes;
+        _numberOfActiveVersions = numberOfActiveVersions;
+        _objectCounts = objectCounts.copy;
+    }
+    return self;
+}
+
+- (uint64_t)fileSize {
+    return _usedBytes + _freeBytes;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<RLMStorageStatistics: %llu of %llu bytes used, %llu active versions>",
+            _usedBytes, self.fileSize, _numberOfActiveVersions];
+}
+@end
+
+@implementation RLMWriteTransactionMetrics
+- (instancetype)initWithBegin:(NSTimeInterval)begin transaction:(NSTimeInterval)transaction
+                       commit:(NSTimeInterval)commit cancelled:(BOOL)cancelled
+           objectCountChanges:(NSDictionary<NSString *, NSNumber *> *)objectCountChanges
+                   yieldCount:(NSUInteger)yieldCount yieldDuration:(NSTimeInterval)yieldDuration {
+    if ((self = [super init])) {
+        _beginDuration = begin;
+        _transactionDuration = transaction;
+        _commitDuration = commit;
+        _cancelled = cancelled;
+        _objectCountChanges = objectCountChanges;
+        _yieldCount = yieldCount;
+        _yieldDuration = yieldDuration;
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<RLMWriteTransactionMetrics: begin %.3fms, transaction %.3fms, %@ %.3fms, %lu yields %.3fms, object count changes %@>",
+            _beginDuration * 1000, _transactionDuration * 1000, _cancelled ? @"cancel" : @"commit",
+            _commitDuration * 1000, (unsigned long)_yieldCount, _yieldDuration * 1000, _objectCountChanges];
+}
+@end
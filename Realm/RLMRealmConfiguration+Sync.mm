@@ -53,6 +53,15 @@
 
     if (syncConfiguration.customFileURL) {
         self.config.path = syncConfiguration.customFileURL.path.UTF8String;
+    } else if (NSURL *directoryURL = syncConfiguration.directoryURL) {
+        NSString *defaultPath = @([user pathForPartitionValue:self.config.sync_config->partition_value].c_str());
+        NSError *error;
+        if (![NSFileManager.defaultManager createDirectoryAtURL:directoryURL withIntermediateDirectories:YES
+                                                     attributes:nil error:&error]) {
+            @throw RLMException(@"Unable to create the directory for the synchronized Realm at '%@': %@",
+                                directoryURL.path, error.localizedDescription);
+        }
+        self.config.path = [directoryURL URLByAppendingPathComponent:defaultPath.lastPathComponent].path.UTF8String;
     } else {
         self.config.path = [user pathForPartitionValue:self.config.sync_config->partition_value];
     }
@@ -65,7 +74,17 @@
         return nil;
     }
     realm::SyncConfig& sync_config = *self.config.sync_config;
-    return [[RLMSyncConfiguration alloc] initWithRawConfig:sync_config];
+    RLMSyncConfiguration *syncConfiguration = [[RLMSyncConfiguration alloc] initWithRawConfig:sync_config];
+
+    // Report the directory if it isn't the default one so that setting the
+    // returned configuration again keeps the file in the same place
+    NSString *directory = @(self.config.path.c_str()).stringByDeletingLastPathComponent;
+    auto& user = *sync_config.user;
+    NSString *defaultPath = @(user.sync_manager()->path_for_realm(user, sync_config.partition_value).c_str());
+    if (![directory isEqualToString:defaultPath.stringByDeletingLastPathComponent]) {
+        syncConfiguration.directoryURL = [NSURL fileURLWithPath:directory isDirectory:YES];
+    }
+    return syncConfiguration;
 }
 
 @end
@@ -32,6 +32,53 @@ NS_ASSUME_NONNULL_BEGIN
  */
 typedef BOOL (^RLMShouldCompactOnLaunchBlock)(NSUInteger totalBytes, NSUInteger bytesUsed);
 
+/**
+ Timing and size information about a single write transaction, passed to a
+ configuration's `writeTransactionObserver`.
+ */
+@interface RLMWriteTransactionMetrics : NSObject
+/**
+ How long beginning the write transaction took. This includes waiting for the
+ write lock, and refreshing the Realm to the latest version and delivering
+ notifications for any changes made on other threads.
+ */
+@property (nonatomic, readonly) NSTimeInterval beginDuration;
+/// The time from the write transaction beginning to it being committed or cancelled.
+@property (nonatomic, readonly) NSTimeInterval transactionDuration;
+/// How long committing the write transaction took, including writing it to disk.
+@property (nonatomic, readonly) NSTimeInterval commitDuration;
+/// Whether the write transaction was cancelled rather than committed.
+@property (nonatomic, readonly, getter=isCancelled) BOOL cancelled;
+/**
+ The net change in the number of objects of each type made by the write
+ transaction, keyed by class name. Types which have the same number of objects
+ as before are omitted, and so modifications to existing objects are not
+ counted.
+ */
+@property (nonatomic, readonly) NSDictionary<NSString *, NSNumber *> *objectCountChanges;
+/**
+ The number of times the write transaction let a write on the main thread go
+ first with `-[RLMRealm yieldWriteTransactionIfNeeded:]`.
+ */
+@property (nonatomic, readonly) NSUInteger yieldCount;
+/**
+ How long the write transaction spent waiting for the write lock after letting
+ writes on the main thread go first. This is included in `transactionDuration`.
+ */
+@property (nonatomic, readonly) NSTimeInterval yieldDuration;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMWriteTransactionMetrics cannot be created directly")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMWriteTransactionMetrics cannot be created directly")));
+@end
+
+/**
+ A block called after each write transaction on a Realm has been committed or
+ cancelled, on the thread which performed it.
+ */
+typedef void (^RLMWriteTransactionObserver)(RLMWriteTransactionMetrics *metrics);
+
 /**
  An `RLMRealmConfiguration` instance describes the different options used to
  create an instance of a Realm.
@@ -87,6 +134,11 @@ typedef BOOL (^RLMShouldCompactOnLaunchBlock)(NSUInteger totalBytes, NSUInteger
 /// requires disabling Realm's reader/writer coordination, so committing a
 /// write transaction from another process will result in crashes.
 ///
+/// Read-only local Realms do not create the `.lock` and `.note` files or a
+/// background notification thread. The schema is still read from the file
+/// and validated each time a read-only Realm is opened on a thread which does
+/// not already have it open.
+///
 /// Syncronized Realms must always be writeable (as otherwise no
 /// synchronization could happen), and this instead merely disallows performing
 /// write transactions on the Realm. In addition, it will skip some automatic
@@ -154,6 +206,46 @@ typedef BOOL (^RLMShouldCompactOnLaunchBlock)(NSUInteger totalBytes, NSUInteger
  */
 @property (nonatomic) NSUInteger maximumNumberOfActiveVersions;
 
+/**
+ How long asynchronous writes wait for further writes to be requested before
+ they are committed.
+
+ Each commit has a fixed cost to make the changes durable, which dominates the
+ cost of small write transactions. When this is greater than zero, writes
+ requested with `-[RLMRealm asyncTransactionWithBlock:onComplete:]` wait up to
+ this long for more writes, and then all of them are performed in one write
+ transaction with a single commit. The completion block of each write is called
+ after that shared commit.
+
+ For synchronized Realms each commit produces one changeset to upload, so
+ grouping writes also reduces the number and overhead of upload messages sent
+ when reconnecting after making many small changes while offline.
+
+ This does not affect synchronous write transactions. Defaults to zero, which
+ still groups writes that are requested while a previous commit is in progress.
+ */
+@property (nonatomic) NSTimeInterval groupCommitInterval;
+
+/**
+ The maximum number of asynchronous writes which are grouped into a single
+ commit.
+
+ When this many writes are waiting, they are committed immediately rather than
+ waiting for the rest of `groupCommitInterval`. Defaults to zero, which means
+ there is no limit.
+ */
+@property (nonatomic) NSUInteger maximumWritesPerGroupCommit;
+
+/**
+ A block which is called with timing and size information after each write
+ transaction performed with Realms opened with this configuration.
+
+ This can be used to find slow writers in production. Measuring the write
+ transaction adds a small amount of overhead, and so is only done when this
+ is set.
+ */
+@property (nonatomic, copy, nullable) RLMWriteTransactionObserver writeTransactionObserver;
+
 @end
 
 NS_ASSUME_NONNULL_END
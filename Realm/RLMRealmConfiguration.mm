@@ -43,6 +43,9 @@ static NSString *const c_RLMRealmConfigurationProperties[] = {
     @"shouldCompactOnLaunch",
     @"dynamic",
     @"customSchema",
+    @"groupCommitInterval",
+    @"maximumWritesPerGroupCommit",
+    @"writeTransactionObserver",
 };
 
 static NSString *const c_defaultRealmFileName = @"default.realm";
@@ -116,6 +119,10 @@ NSString *RLMRealmPathForFile(NSString *fileName) {
     configuration->_migrationBlock = _migrationBlock;
     configuration->_shouldCompactOnLaunch = _shouldCompactOnLaunch;
     configuration->_customSchema = _customSchema;
+    configuration->_groupCommitInterval = _groupCommitInterval;
+    configuration->_maximumWritesPerGroupCommit = _maximumWritesPerGroupCommit;
+    configuration->_writeTransactionObserver = _writeTransactionObserver;
+    configuration->_migrationProgressBlock = _migrationProgressBlock;
     return configuration;
 }
 
@@ -281,6 +288,13 @@ static bool isSync(realm::Realm::Config const& config) {
     }
 }
 
+- (void)setGroupCommitInterval:(NSTimeInterval)groupCommitInterval {
+    if (!(groupCommitInterval >= 0)) {
+        @throw RLMException(@"Group commit interval must not be negative.");
+    }
+    _groupCommitInterval = groupCommitInterval;
+}
+
 - (void)setDynamic:(bool)dynamic {
     _dynamic = dynamic;
     self.cache = !dynamic;
@@ -16,6 +16,7 @@
 //
 ////////////////////////////////////////////////////////////////////////////
 
+#import <Realm/RLMRealm.h>
 #import <Realm/RLMRealmConfiguration.h>
 
 @class RLMSchema;
@@ -29,6 +30,8 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readwrite) bool disableFormatUpgrade;
 @property (nonatomic, copy, nullable) RLMSchema *customSchema;
 @property (nonatomic, copy) NSString *pathOnDisk;
+// Passed to the RLMMigration for migrations performed with this configuration
+@property (nonatomic, copy, nullable) RLMMigrationProgressBlock migrationProgressBlock;
 
 // Get the default confiugration without copying it
 + (RLMRealmConfiguration *)rawDefaultConfiguration;
@@ -18,6 +18,7 @@
 
 #import <memory>
 #import <string>
+#import <vector>
 
 @class RLMRealm;
 
@@ -31,9 +32,31 @@ void RLMCacheRealm(std::string const& path, void *key, RLMRealm *realm);
 RLMRealm *RLMGetThreadLocalCachedRealmForPath(std::string const& path, void *key);
 // Get a Realm for the given path
 RLMRealm *RLMGetAnyCachedRealmForPath(std::string const& path);
+// Get all of the live and frozen Realms for the given path in the weak cache
+std::vector<RLMRealm *> RLMGetCachedRealmsForPath(std::string const& path);
 // Clear the weak cache of Realms
 void RLMClearRealmCache();
 
 RLMRealm *RLMGetFrozenRealmForSourceRealm(RLMRealm *realm);
+// Release the strong references the frozen Realm cache holds to recently
+// frozen Realms at the given path, so that the file can be closed
+void RLMReleaseRecentFrozenRealms(std::string const& path);
+// Release them only if there are no live (non-frozen) Realms left at the path
+void RLMReleaseRecentFrozenRealmsIfUnused(std::string const& path);
+// Release the ones older than the given version, which a live Realm at the
+// path has just advanced to
+void RLMReleaseRecentFrozenRealmsBefore(std::string const& path, uint64_t version);
+
+struct RLMFrozenRealmCacheMetrics {
+    // Number of times an existing frozen Realm was reused
+    uint64_t hits;
+    // Number of times a new frozen Realm had to be created
+    uint64_t misses;
+    // Number of versions currently kept alive by the cache
+    size_t pinnedVersions;
+};
+RLMFrozenRealmCacheMetrics RLMGetFrozenRealmCacheMetrics();
+// Record a frozen Realm reused without going through the cache
+void RLMRecordFrozenRealmCacheHit();
 
 std::unique_ptr<realm::BindingContext> RLMCreateBindingContext(RLMRealm *realm);
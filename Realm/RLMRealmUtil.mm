@@ -31,14 +31,84 @@
 #import <realm/object-store/shared_realm.hpp>
 #import <realm/object-store/util/scheduler.hpp>
 
+#import <algorithm>
+#import <array>
+#import <atomic>
 #import <map>
 #import <mutex>
+#import <vector>
 
 // Global realm state
 static auto& s_realmCacheMutex = *new std::mutex();
 static auto& s_realmsPerPath = *new std::map<std::string, NSMapTable *>();
 static auto& s_frozenRealms = *new std::map<std::string, NSMapTable *>();
 
+// The most recently frozen Realms, retained so that freezing the same version
+// repeatedly (such as once per notification in a Combine pipeline) reuses a
+// single frozen Realm even if the previous one was released in between. Only
+// the newest frozen version of each file is retained, and it is released as
+// soon as a live Realm for the file advances past it so that the cache never
+// pins a version which nothing is reading any more. A file's entries are also
+// dropped once the last live RLMRealm for it is deallocated so that the cache
+// never keeps a file open on its own.
+// Ordered from least to most recently used, and guarded by s_realmCacheMutex.
+namespace {
+struct RLMRecentFrozenRealm {
+    std::string path;
+    uint64_t version;
+    RLMRealm *realm;
+};
+} // anonymous namespace
+static constexpr size_t s_maxRecentFrozenRealms = 4;
+static auto& s_recentFrozenRealms = *new std::vector<RLMRecentFrozenRealm>();
+// Hits are also recorded by RLMRealm's own cache of its last frozen Realm
+// without holding the lock
+static std::atomic<uint64_t> s_frozenRealmCacheHits{0};
+static uint64_t s_frozenRealmCacheMisses = 0;
+
+// Incremented whenever the contents of s_realmsPerPath change, which
+// invalidates every thread's local cache. Must only be modified while holding
+// s_realmCacheMutex.
+static std::atomic<uint64_t> s_realmCacheGeneration{1};
+
+namespace {
+// Each thread remembers the last few Realms it looked up, so that obtaining a
+// Realm which is already open on the current thread does not need to take the
+// global cache lock.
+struct RLMThreadLocalRealmCache {
+    struct Entry {
+        uint64_t generation = 0;
+        std::string path;
+        void *key = nullptr;
+        __weak RLMRealm *realm;
+    };
+    std::array<Entry, 4> entries;
+    size_t next = 0;
+
+    RLMRealm *get(std::string const& path, void *key, uint64_t generation) {
+        for (auto& entry : entries) {
+            if (entry.generation == generation && entry.key == key && entry.path == path) {
+                return entry.realm;
+            }
+        }
+        return nil;
+    }
+
+    void set(std::string const& path, void *key, uint64_t generation, RLMRealm *realm) {
+        for (auto& entry : entries) {
+            if (entry.key == key && entry.path == path) {
+                entry.generation = generation;
+                entry.realm = realm;
+                return;
+            }
+        }
+        auto& entry = entries[next++ % entries.size()];
+        entry = {generation, path, key, realm};
+    }
+};
+thread_local RLMThreadLocalRealmCache s_threadLocalRealmCache;
+} // anonymous namespace
+
 void RLMCacheRealm(std::string const& path, void *key, __unsafe_unretained RLMRealm *const realm) {
     std::lock_guard<std::mutex> lock(s_realmCacheMutex);
     NSMapTable *realms = s_realmsPerPath[path];
@@ -47,16 +117,39 @@ void RLMCacheRealm(std::string const& path, void *key, __unsafe_unretained RLMRe
                                                                valueOptions:NSPointerFunctionsWeakMemory];
     }
     [realms setObject:realm forKey:(__bridge id)key];
+    s_realmCacheGeneration.fetch_add(1, std::memory_order_release);
 }
 
 RLMRealm *RLMGetAnyCachedRealmForPath(std::string const& path) {
     std::lock_guard<std::mutex> lock(s_realmCacheMutex);
-    return [s_realmsPerPath[path] objectEnumerator].nextObject;
+    auto it = s_realmsPerPath.find(path);
+    return it == s_realmsPerPath.end() ? nil : [it->second objectEnumerator].nextObject;
 }
 
-RLMRealm *RLMGetThreadLocalCachedRealmForPath(std::string const& path, void *key) {
+std::vector<RLMRealm *> RLMGetCachedRealmsForPath(std::string const& path) {
+    std::vector<RLMRealm *> realms;
     std::lock_guard<std::mutex> lock(s_realmCacheMutex);
-    RLMRealm *realm = [s_realmsPerPath[path] objectForKey:(__bridge id)key];
+    auto it = s_realmsPerPath.find(path);
+    if (it != s_realmsPerPath.end()) {
+        for (RLMRealm *realm in it->second.objectEnumerator) {
+            realms.push_back(realm);
+        }
+    }
+    return realms;
+}
+
+RLMRealm *RLMGetThreadLocalCachedRealmForPath(std::string const& path, void *key) {
+    auto& localCache = s_threadLocalRealmCache;
+    uint64_t generation = s_realmCacheGeneration.load(std::memory_order_acquire);
+    RLMRealm *realm = localCache.get(path, key, generation);
+    if (!realm) {
+        std::lock_guard<std::mutex> lock(s_realmCacheMutex);
+        auto it = s_realmsPerPath.find(path);
+        realm = it == s_realmsPerPath.end() ? nil : [it->second objectForKey:(__bridge id)key];
+        if (realm) {
+            localCache.set(path, key, s_realmCacheGeneration.load(std::memory_order_relaxed), realm);
+        }
+    }
     if (realm && !realm->_realm->scheduler()->is_on_thread()) {
         // We can get here in two cases: if the user is trying to open a
         // queue-bound Realm from the wrong queue, or if we have a stale cached
@@ -70,12 +163,42 @@ RLMRealm *RLMGetThreadLocalCachedRealmForPath(std::string const& path, void *key
 }
 
 void RLMClearRealmCache() {
+    // Declared before the lock so that the Realms are released after unlocking
+    std::vector<RLMRecentFrozenRealm> recentFrozenRealms;
     std::lock_guard<std::mutex> lock(s_realmCacheMutex);
     s_realmsPerPath.clear();
     s_frozenRealms.clear();
+    recentFrozenRealms.swap(s_recentFrozenRealms);
+    s_frozenRealmCacheHits = 0;
+    s_frozenRealmCacheMisses = 0;
+    s_realmCacheGeneration.fetch_add(1, std::memory_order_release);
+}
+
+static void RLMRetainRecentFrozenRealm(std::string const& path, uint64_t version,
+                                       __unsafe_unretained RLMRealm *const realm,
+                                       std::vector<RLMRecentFrozenRealm>& evicted) {
+    for (auto it = s_recentFrozenRealms.begin(); it != s_recentFrozenRealms.end(); ++it) {
+        if (it->path != path) {
+            continue;
+        }
+        if (it->version > version) {
+            // Don't replace a newer version with an older one
+            return;
+        }
+        evicted.push_back(std::move(*it));
+        s_recentFrozenRealms.erase(it);
+        break;
+    }
+    s_recentFrozenRealms.push_back({path, version, realm});
+    if (s_recentFrozenRealms.size() > s_maxRecentFrozenRealms) {
+        evicted.push_back(std::move(s_recentFrozenRealms.front()));
+        s_recentFrozenRealms.erase(s_recentFrozenRealms.begin());
+    }
 }
 
 RLMRealm *RLMGetFrozenRealmForSourceRealm(__unsafe_unretained RLMRealm *const sourceRealm) {
+    // Declared before the lock so that evicted Realms are released after unlocking
+    std::vector<RLMRecentFrozenRealm> evicted;
     std::lock_guard<std::mutex> lock(s_realmCacheMutex);
     auto& r = *sourceRealm->_realm;
     auto& path = r.config().path;
@@ -85,15 +208,71 @@ RLMRealm *RLMGetFrozenRealmForSourceRealm(__unsafe_unretained RLMRealm *const so
                                                                valueOptions:NSPointerFunctionsWeakMemory];
     }
     r.read_group();
-    auto version = reinterpret_cast<void *>(r.read_transaction_version().version);
-    RLMRealm *realm = [realms objectForKey:(__bridge id)version];
-    if (!realm) {
+    uint64_t version = r.read_transaction_version().version;
+    auto key = reinterpret_cast<void *>(version);
+    RLMRealm *realm = [realms objectForKey:(__bridge id)key];
+    // Invalidating a frozen Realm closes it, so it can't be handed out again
+    if (realm && !realm->_realm->is_closed()) {
+        ++s_frozenRealmCacheHits;
+    }
+    else {
+        ++s_frozenRealmCacheMisses;
         realm = [sourceRealm frozenCopy];
-        [realms setObject:realm forKey:(__bridge id)version];
+        [realms setObject:realm forKey:(__bridge id)key];
+        s_realmCacheGeneration.fetch_add(1, std::memory_order_release);
     }
+    RLMRetainRecentFrozenRealm(path, version, realm, evicted);
     return realm;
 }
 
+void RLMReleaseRecentFrozenRealms(std::string const& path) {
+    std::vector<RLMRecentFrozenRealm> evicted;
+    std::lock_guard<std::mutex> lock(s_realmCacheMutex);
+    auto it = std::stable_partition(s_recentFrozenRealms.begin(), s_recentFrozenRealms.end(),
+                                    [&](auto& entry) { return entry.path != path; });
+    std::move(it, s_recentFrozenRealms.end(), std::back_inserter(evicted));
+    s_recentFrozenRealms.erase(it, s_recentFrozenRealms.end());
+}
+
+void RLMReleaseRecentFrozenRealmsIfUnused(std::string const& path) {
+    // Declared before the lock so that the Realms are released after unlocking
+    std::vector<RLMRealm *> realms;
+    std::vector<RLMRecentFrozenRealm> evicted;
+    std::lock_guard<std::mutex> lock(s_realmCacheMutex);
+    auto it = s_realmsPerPath.find(path);
+    if (it != s_realmsPerPath.end()) {
+        for (RLMRealm *realm in it->second.objectEnumerator) {
+            realms.push_back(realm);
+            if (!realm->_realm->is_frozen()) {
+                return;
+            }
+        }
+    }
+    auto end = std::stable_partition(s_recentFrozenRealms.begin(), s_recentFrozenRealms.end(),
+                                     [&](auto& entry) { return entry.path != path; });
+    std::move(end, s_recentFrozenRealms.end(), std::back_inserter(evicted));
+    s_recentFrozenRealms.erase(end, s_recentFrozenRealms.end());
+}
+
+void RLMReleaseRecentFrozenRealmsBefore(std::string const& path, uint64_t version) {
+    // Declared before the lock so that the Realms are released after unlocking
+    std::vector<RLMRecentFrozenRealm> evicted;
+    std::lock_guard<std::mutex> lock(s_realmCacheMutex);
+    auto end = std::stable_partition(s_recentFrozenRealms.begin(), s_recentFrozenRealms.end(),
+                                     [&](auto& entry) { return entry.path != path || entry.version >= version; });
+    std::move(end, s_recentFrozenRealms.end(), std::back_inserter(evicted));
+    s_recentFrozenRealms.erase(end, s_recentFrozenRealms.end());
+}
+
+void RLMRecordFrozenRealmCacheHit() {
+    s_frozenRealmCacheHits.fetch_add(1, std::memory_order_relaxed);
+}
+
+RLMFrozenRealmCacheMetrics RLMGetFrozenRealmCacheMetrics() {
+    std::lock_guard<std::mutex> lock(s_realmCacheMutex);
+    return {s_frozenRealmCacheHits.load(), s_frozenRealmCacheMisses, s_recentFrozenRealms.size()};
+}
+
 namespace {
 class RLMNotificationHelper : public realm::BindingContext {
 public:
@@ -129,6 +308,10 @@ public:
             @autoreleasepool {
                 RLMDidChange(observed, invalidated);
                 if (version_changed) {
+                    [_realm recordPinnedVersion];
+                    if (auto r = realm.lock(); r && r->is_in_read_transaction()) {
+                        RLMReleaseRecentFrozenRealmsBefore(r->config().path, r->read_transaction_version().version);
+                    }
                     [_realm sendNotifications:RLMRealmDidChangeNotification];
                 }
             }
@@ -25,6 +25,17 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/// The number of objects inserted, updated and left unchanged by
+/// `-[RLMRealm createOrUpdateModifiedObjects:withValues:]`.
+typedef struct RLMUpsertCounts {
+    /// The number of new objects created.
+    NSUInteger inserted;
+    /// The number of existing objects which had at least one property updated.
+    NSUInteger updated;
+    /// The number of existing objects which were not modified.
+    NSUInteger unchanged;
+} RLMUpsertCounts;
+
 @interface RLMRealm (Dynamic)
 
 #pragma mark - Getting Objects from a Realm
@@ -92,6 +103,26 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (nullable RLMObject *)objectWithClassName:(NSString *)className forPrimaryKey:(id)primaryKey;
 
+/**
+ Returns the objects of the given type with each of the given primary keys.
+
+ All of the keys are validated before any objects are looked up, and the lookups
+ are batched, which is much faster than calling `objectWithClassName:forPrimaryKey:`
+ for each key when looking up many objects at once.
+
+ @warning This method is useful only in specialized circumstances, for example, when building components
+          that integrate with Realm.
+
+ @param className    The class name for the objects you are looking for.
+ @param primaryKeys  The primary key values for the objects you are looking for.
+
+ @return    An array with the object for each key in the same order as `primaryKeys`,
+            with `NSNull` for each key which does not have an object.
+
+ @see       `objectWithClassName:forPrimaryKey:`
+ */
+- (NSArray *)objectsWithClassName:(NSString *)className forPrimaryKeys:(NSArray *)primaryKeys;
+
 /**
  Creates an `RLMObject` instance of type `className` in the Realm, and populates it using a given object.
 
@@ -113,6 +144,75 @@ NS_ASSUME_NONNULL_BEGIN
  */
 -(RLMObject *)createObject:(NSString *)className withValue:(id)value;
 
+/**
+ Creates an `RLMObject` of type `className` in the Realm for each value in `values`.
+
+ Each element of `values` can be any of the values accepted by `createObject:withValue:`.
+ Unlike calling `createObject:withValue:` in a loop, this does not create an
+ accessor object for each of the newly created objects, and the schema lookup is
+ performed only once for the entire batch. This makes it considerably faster
+ when inserting large numbers of objects which do not need to be used
+ immediately afterwards.
+
+ Unmanaged `RLMObject` instances passed in `values` are copied into the Realm
+ and remain unmanaged.
+
+ @warning This method may only be called during a write transaction.
+
+ @param className The class name of the objects to create.
+ @param values    An enumerable collection of values used to populate the objects.
+ */
+- (void)createObjects:(NSString *)className withValues:(id<NSFastEnumeration>)values;
+
+/**
+ Creates or updates objects in the Realm for each of the given values, only
+ writing the properties which have changed.
+
+ Each element of `values` can be any of the values accepted by
+ `createObject:withValue:`, and must include the primary key of the object.
+ Existing objects for which none of the given property values differ from the
+ stored ones are skipped entirely, so they are neither written nor reported as
+ modified to notification blocks. When most of the objects are unchanged this
+ is much faster than calling `+[RLMObject createOrUpdateModifiedInRealm:withValue:]`
+ for each value.
+
+ Existing objects whose values include link or collection properties are always
+ passed to the same property-by-property update as
+ `createOrUpdateModifiedInRealm:withValue:`, and are counted as updated.
+
+ @warning This method may only be called during a write transaction.
+
+ @param className The class name of the objects to create or update. The class
+                  must have a primary key.
+ @param values    An enumerable collection of values used to populate the objects.
+
+ @return The number of objects which were inserted, updated and unchanged.
+ */
+- (RLMUpsertCounts)createOrUpdateModifiedObjects:(NSString *)className
+                                      withValues:(id<NSFastEnumeration>)values;
+
+/**
+ Creates objects in the Realm from JSON Lines read from the given input stream.
+
+ Each line of the stream must be a JSON object whose keys are property names,
+ in the format written by `-[RLMResults writeJSONLinesToStream:error:]`. The
+ stream is read incrementally and the objects are inserted in batches with
+ `createObjects:withValues:`, so the whole input is never held in memory.
+
+ @warning This method may only be called during a write transaction.
+
+ @param className The class name of the objects to create.
+ @param stream    An open stream to read the objects from.
+ @param error     If an error occurs, upon return contains an `NSError` object
+                  that describes the problem. If you are not interested in
+                  possible errors, pass in `NULL`.
+
+ @return `YES` if all of the objects were read, `NO` if an error occurred.
+ Objects created before the error remain in the write transaction.
+ */
+- (BOOL)createObjects:(NSString *)className fromJSONLinesStream:(NSInputStream *)stream error:(NSError **)error
+    NS_SWIFT_NAME(createObjects(_:fromJSONLines:));
+
 @end
 
 NS_ASSUME_NONNULL_END
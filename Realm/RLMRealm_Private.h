@@ -23,6 +23,10 @@
 NS_ASSUME_NONNULL_BEGIN
 
 // Disable syncing files to disk. Cannot be re-enabled. Use only for tests.
+// This applies to every Realm file in the process: the version of core used
+// does not support choosing the durability of individual files or commits,
+// so there is no per-configuration equivalent. Asynchronous writes are the
+// supported way to avoid waiting for commits to be flushed.
 FOUNDATION_EXTERN void RLMDisableSyncToDisk(void);
 // Set whether the skip backup attribute should be set on temporary files.
 FOUNDATION_EXTERN void RLMSetSkipBackupAttribute(bool value);
@@ -32,6 +36,13 @@ FOUNDATION_EXTERN NSData * _Nullable RLMRealmValidatedEncryptionKey(NSData *key)
 // Set the queue used for async open. For testing purposes only.
 FOUNDATION_EXTERN void RLMSetAsyncOpenQueue(dispatch_queue_t queue);
 
+// The maximum number of async opens which may run at once, or 0 for no limit.
+FOUNDATION_EXTERN NSUInteger RLMGetMaximumConcurrentAsyncOpens(void);
+FOUNDATION_EXTERN void RLMSetMaximumConcurrentAsyncOpens(NSUInteger limit);
+// Mark an async open as complete, either because it finished or was cancelled,
+// letting the next queued async open start. Has no effect if called more than once.
+FOUNDATION_EXTERN void RLMAsyncOpenTaskDidFinish(RLMAsyncOpenTask *task);
+
 // Translate an in-flight exception resulting from an operation on a SharedGroup to
 // an NSError or NSException (if error is nil)
 void RLMRealmTranslateException(NSError **error);
@@ -57,6 +68,9 @@ BOOL RLMIsRealmCachedAtPath(NSString *path);
 - (void)verifyNotificationsAreSupported:(bool)isCollection;
 
 - (RLMRealm *)frozenCopy NS_RETURNS_RETAINED;
+// Update the version reported by versionPinsForConfiguration: after the
+// Realm's read transaction may have changed. Must be called on the Realm's thread.
+- (void)recordPinnedVersion;
 + (RLMAsyncOpenTask *)asyncOpenWithConfiguration:(RLMRealmConfiguration *)configuration
                                         callback:(void (^)(NSError * _Nullable))callback;
 
@@ -40,6 +40,10 @@ struct RLMResultsSetInfo {
     std::shared_ptr<realm::Realm> _realm;
     RLMSchemaInfo _info;
     std::unique_ptr<RLMResultsSetInfo> _resultsSetInfo;
+    // The version created by the most recent commit which skipped
+    // notifications. Changes from that commit are never reported to the
+    // skipped notification blocks.
+    uint64_t _lastSkippedNotificationVersion;
 }
 
 // FIXME - group should not be exposed
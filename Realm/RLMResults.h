@@ -20,7 +20,21 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
-@class RLMObject;
+@class RLMGroupedAggregates, RLMObject, RLMSectionedResults<RLMObjectType>;
+
+/**
+ An aggregate which can be calculated by `-[RLMResults aggregates:ofProperty:]`.
+ */
+typedef NSString *RLMAggregateOperation NS_STRING_ENUM;
+
+/// The minimum value of the property.
+extern RLMAggregateOperation const RLMAggregateOperationMin;
+/// The maximum value of the property.
+extern RLMAggregateOperation const RLMAggregateOperationMax;
+/// The sum of the values of the property.
+extern RLMAggregateOperation const RLMAggregateOperationSum;
+/// The average value of the property.
+extern RLMAggregateOperation const RLMAggregateOperationAverage;
 
 /**
  `RLMResults` is an auto-updating container type in Realm returned from object
@@ -107,6 +121,19 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (nullable NSArray<RLMObjectType> *)objectsAtIndexes:(NSIndexSet *)indexes;
 
+/**
+ Returns an array containing the objects in the results in the given range.
+ `nil` will be returned if the range extends past the end of the results.
+
+ This is faster than calling `objectAtIndex:` for each index when reading a
+ contiguous run of objects, such as the visible rows of a collection view.
+
+ @param range The range of indexes in the results to retrieve objects from.
+
+ @return The objects in the specified range.
+ */
+- (nullable NSArray<RLMObjectType> *)objectsInRange:(NSRange)range;
+
 /**
  Returns the first object in the results collection.
 
@@ -125,6 +152,66 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (nullable RLMObjectType)lastObject;
 
+/**
+ Enumerates the objects in the results collection in chunks of up to the given size.
+
+ Each chunk is created inside its own autorelease pool and the objects in it
+ are only retained for the duration of the call to `block`, which makes this
+ suitable for processing results which are too large to hold in memory at once.
+ The overhead of setting up the enumeration is paid once rather than per chunk.
+
+ As with fast enumeration, if this method is called during a write transaction
+ the objects enumerated are a snapshot of the results at the time of the call.
+
+ @param chunkSize The maximum number of objects passed to each call of `block`.
+ @param block     The block to call with each chunk of objects. Set `stop` to
+                  `YES` to stop the enumeration after the current chunk.
+ */
+- (void)enumerateObjectsInChunksOfSize:(NSUInteger)chunkSize
+                            usingBlock:(void (NS_NOESCAPE ^)(NSArray<RLMObjectType> *chunk, BOOL *stop))block;
+
+/**
+ Enumerates the objects in the results collection using a single accessor object.
+
+ Rather than creating a new object for each element of the results, the same
+ object is passed to every call of `block`, updated to refer to the next
+ object in the results each time. This eliminates all per-object allocations
+ and is intended for read-only scans over very large results.
+
+ @warning The object passed to `block` is only valid until `block` returns.
+          Do not retain it, compare it to other objects, or pass it to other
+          threads; use `objectAtIndex:` to obtain an object which can be kept.
+
+ @param block The block to call with each object. Set `stop` to `YES` to stop
+              the enumeration.
+ */
+- (void)enumerateWithReusedAccessor:(void (NS_NOESCAPE ^)(RLMObjectType object, BOOL *stop))block;
+
+/**
+ Enumerates the objects in the results collection, optionally on multiple threads.
+
+ When `opts` contains `NSEnumerationConcurrent`, the results are split into
+ chunks which are processed in parallel using `dispatch_apply()`, with each
+ chunk creating its own accessor objects inside its own autorelease pool. This
+ is intended for CPU-heavy processing of large results. The order in which
+ objects are passed to `block` is unspecified when enumerating concurrently.
+
+ Without `NSEnumerationConcurrent` the objects are enumerated in order on the
+ calling thread, or in reverse order if `opts` contains `NSEnumerationReverse`.
+
+ Setting `stop` to `YES` stops the enumeration as soon as possible, but when
+ enumerating concurrently objects which are already being processed on other
+ threads may still be passed to `block`.
+
+ @warning Concurrent enumeration is only supported on frozen results, as
+          unfrozen Realm objects cannot be passed between threads.
+
+ @param opts  A bit mask of enumeration options.
+ @param block The block to call with each object and its index in the results.
+ */
+- (void)enumerateObjectsWithOptions:(NSEnumerationOptions)opts
+                         usingBlock:(void (NS_NOESCAPE ^)(RLMObjectType object, NSUInteger index, BOOL *stop))block;
+
 #pragma mark - Querying Results
 
 /**
@@ -206,6 +293,37 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (RLMResults<RLMObjectType> *)distinctResultsUsingKeyPaths:(NSArray<NSString *> *)keyPaths;
 
+/**
+ Returns a window of at most `limit` objects from the results collection,
+ starting after the given object.
+
+ This is intended for paginating over very large sorted results. Pass `nil` to
+ get the first page, and then the last object of each page to get the next
+ one. Rather than finding the object's position in the fully sorted results,
+ the next page is found by filtering on the values of the object's sort
+ properties, so each page only needs to sort and observe the objects which
+ come after the previous page.
+
+     RLMResults *sorted = [posts sortedResultsUsingKeyPath:@"date" ascending:NO];
+     RLMResults *page = [sorted windowedFrom:nil limit:50];
+     RLMResults *next = [sorted windowedFrom:page.lastObject limit:50];
+
+ If the object type has a non-string primary key, it is used to order objects with equal
+ values for the sort properties so that pages never skip or repeat objects.
+ Otherwise the sort properties should uniquely identify each object.
+
+ @warning Continuing after an object requires the results to have been sorted
+          with `-sortedResultsUsingDescriptors:` or
+          `-sortedResultsUsingKeyPath:ascending:`, and string sort properties
+          are not supported.
+
+ @param object The last object of the previous window, or `nil` for the first window.
+ @param limit  The maximum number of objects in the window.
+
+ @return An `RLMResults` containing the objects in the window.
+ */
+- (RLMResults<RLMObjectType> *)windowedFrom:(nullable RLMObjectType)object limit:(NSUInteger)limit;
+
 #pragma mark - Notifications
 
 /**
@@ -362,6 +480,39 @@ __attribute__((warn_unused_result));
                                          queue:(nullable dispatch_queue_t)queue
 __attribute__((warn_unused_result));
 
+/**
+ Registers a block to be called each time the results collection changes, delivering changes
+ no more often than once per `minimumInterval`.
+
+ This behaves like `-addNotificationBlock:keyPaths:queue:`, except that changes
+ which occur less than `minimumInterval` seconds after the previous call to the
+ block are merged together and delivered as a single `RLMCollectionChange`
+ once the interval has elapsed. The initial notification and errors are
+ always delivered immediately. This is useful for reducing the amount of work
+ performed when the results collection is changing very rapidly, such as while a large
+ number of objects are being downloaded by sync.
+
+ If `queue` is `nil`, delayed notifications are delivered via the current
+ thread's run loop.
+
+ @warning This method cannot be called when the containing Realm is read-only or frozen.
+ @warning The queue must be a serial queue.
+
+ @param block The block to be called whenever a change occurs.
+ @param keyPaths The block will be called for changes occuring on these keypaths. If no
+ key paths are given, notifications are delivered for every property key path.
+ @param queue The serial queue to deliver notifications to.
+ @param minimumInterval The minimum time in seconds between calls to the block.
+ @return A token which must be held for as long as you want updates to be delivered.
+ */
+- (RLMNotificationToken *)addNotificationBlock:(void (^)(RLMResults<RLMObjectType> *_Nullable results,
+                                                         RLMCollectionChange *_Nullable change,
+                                                         NSError *_Nullable error))block
+                                      keyPaths:(nullable NSArray<NSString *> *)keyPaths
+                                         queue:(nullable dispatch_queue_t)queue
+                               minimumInterval:(NSTimeInterval)minimumInterval
+__attribute__((warn_unused_result));
+
 /**
  Registers a block to be called each time the results collection changes.
 
@@ -423,7 +574,7 @@ __attribute__((warn_unused_result));
  @warning You cannot use this method on `RLMObject`, `RLMArray`, and `NSData` properties.
 
  @param property The property whose minimum value is desired. Only properties of types `int`, `float`, `double`, and
-                 `NSDate` are supported.
+                 `NSDate` are supported. This may be a key path through to-one links, such as `@"owner.age"`.
 
  @return The minimum value of the property, or `nil` if the Results are empty.
  */
@@ -438,6 +589,7 @@ __attribute__((warn_unused_result));
 
  @param property The property whose maximum value is desired. Only properties of
                  types `int`, `float`, `double`, and `NSDate` are supported.
+                 This may be a key path through to-one links.
 
  @return The maximum value of the property, or `nil` if the Results are empty.
  */
@@ -452,6 +604,7 @@ __attribute__((warn_unused_result));
 
  @param property The property whose values should be summed. Only properties of
                  types `int`, `float`, and `double` are supported.
+                 This may be a key path through to-one links.
 
  @return The sum of the given property.
  */
@@ -466,14 +619,188 @@ __attribute__((warn_unused_result));
 
  @param property The property whose average value should be calculated. Only
                  properties of types `int`, `float`, and `double` are supported.
+                 This may be a key path through to-one links.
 
  @return    The average value of the given property, or `nil` if the Results are empty.
  */
 - (nullable NSNumber *)averageOfProperty:(NSString *)property;
 
+/**
+ Calculates several aggregates of a given property in a single pass over the
+ objects represented by the results collection.
+
+     NSDictionary *stats = [results aggregates:@[RLMAggregateOperationMin,
+                                                 RLMAggregateOperationMax,
+                                                 RLMAggregateOperationAverage]
+                                    ofProperty:@"owner.age"];
+
+ The property may be a key path through to-one links, in which case objects
+ with a `nil` link along the path are skipped. Aggregates whose value would be
+ `nil`, such as the minimum of an empty collection, are omitted from the
+ returned dictionary.
+
+ @param operations The aggregates which should be calculated.
+ @param property   The property or key path to aggregate. The same property
+                   types as the individual aggregate methods are supported.
+
+ @return A dictionary containing the value of each requested aggregate.
+ */
+- (NSDictionary<RLMAggregateOperation, id> *)aggregates:(NSArray<RLMAggregateOperation> *)operations
+                                             ofProperty:(NSString *)property;
+
+/**
+ Groups the objects represented by the results collection by the value of a
+ given key path, and calculates the count of each group along with the
+ minimum, maximum, sum and average of another property within each group.
+
+     RLMGroupedAggregates *totals = [results groupedBy:@"category.name"
+                                           aggregating:@"price"];
+     for (NSUInteger i = 0; i < totals.count; i++) {
+         NSLog(@"%@: %@", totals.keys[i], totals.sums[i]);
+     }
+
+ All of the groups are calculated in a single pass over the results, rather
+ than requiring a separate query for each distinct value of the key path.
+
+ @param keyPath  The property or key path through to-one links whose value
+                 determines which group each object belongs to. Objects with a
+                 `nil` link along the key path are grouped under `NSNull`.
+ @param property The property or key path whose values are aggregated within
+                 each group. Only properties of types `int`, `float`, `double`
+                 and `RLMDecimal128` are supported. If `nil`, only the number
+                 of objects in each group is calculated.
+
+ @return The keys and aggregates of each group.
+ */
+- (RLMGroupedAggregates *)groupedBy:(NSString *)keyPath aggregating:(nullable NSString *)property;
+
+/**
+ Registers a block to be called with the grouped aggregates of the results
+ each time they change.
+
+ The block is called asynchronously with the initial aggregates, as returned by
+ `groupedBy:aggregating:`, and then again after each write transaction which
+ changes any of the counts or aggregated values. Writes which modify the
+ results without changing any group (such as changing a property which isn't
+ part of either key path) do not call the block.
+
+ Rather than recalculating every group after each write, the aggregates are
+ updated from the changeset for the results, so only the objects which were
+ inserted, deleted or modified are read. Groups whose minimum or maximum
+ object was removed are recalculated from cached values.
+
+ Groups are reported in the order that their keys were first seen, and groups
+ which no longer contain any objects are omitted.
+
+ @warning This method cannot be called during a write transaction, or when the
+          containing Realm is read-only.
+
+ @param block    The block to be called with the new aggregates, or with an
+                 error if the results could not be observed.
+ @param keyPath  The key path whose value determines which group each object
+                 belongs to. See `groupedBy:aggregating:`.
+ @param property The key path whose values are aggregated within each group,
+                 or `nil` to only count the objects in each group.
+ @param queue    The serial queue to deliver notifications to, or `nil` to
+                 deliver them to the current thread.
+ @return A token which must be held for as long as you want updates to be delivered.
+ */
+- (RLMNotificationToken *)addGroupedAggregatesNotificationBlock:(void (^)(RLMGroupedAggregates *_Nullable aggregates,
+                                                                          NSError *_Nullable error))block
+                                                      groupedBy:(NSString *)keyPath
+                                                    aggregating:(nullable NSString *)property
+                                                          queue:(nullable dispatch_queue_t)queue
+__attribute__((warn_unused_result));
+
+#pragma mark - Sectioning Results
+
+/**
+ Splits the objects represented by the results collection into sections by the
+ value of a key path, such as for displaying them in a grouped table view.
+
+ The objects are sorted by the key path, and each section contains a run of
+ objects which have the same value for it. Any existing sort order of the
+ results is used to order the objects within each section.
+
+     RLMSectionedResults *sections = [[people sortedResultsUsingKeyPath:@"name" ascending:YES]
+                                      sectionedResultsUsingKeyPath:@"city" ascending:YES];
+
+ @param keyPath   The key path to section the objects by. This may be a key path
+                  through to-one links.
+ @param ascending The direction in which the sections are sorted.
+
+ @return An `RLMSectionedResults` which contains the sectioned objects.
+ */
+- (RLMSectionedResults<RLMObjectType> *)sectionedResultsUsingKeyPath:(NSString *)keyPath ascending:(BOOL)ascending;
+
+#pragma mark - Reading Property Values
+
+/**
+ Returns the values of a given numeric property for all of the objects
+ represented by the results collection as a packed buffer.
+
+ Unlike `valueForKey:`, this reads the values directly from the underlying
+ column without creating an accessor object or boxing each value in an
+ `NSNumber`, making it much faster for reading the values of a single
+ property for a large number of objects.
+
+ For `int` properties the returned data contains one `int64_t` per object. For
+ `float` and `double` properties it contains one `double` per object, with
+ `nil` values represented as NaN. For `NSDate` properties it contains one
+ `int64_t` per object holding the number of nanoseconds since 1970, with `nil`
+ values represented as `INT64_MIN`, so that no `NSDate` is created per object.
+
+     NSData *data = [results packedValuesOfProperty:@"price"];
+     const double *prices = data.bytes;
+
+ @param property The property whose values are desired. Only non-optional `int`
+                 properties and `float`, `double` and `NSDate` properties are
+                 supported. Use `self` for collections of primitive values.
+
+ @return An `NSData` containing the packed values in the order of the results.
+ */
+- (NSData *)packedValuesOfProperty:(NSString *)property;
+
+/**
+ Writes the objects represented by the results collection to the given output
+ stream as JSON Lines: one JSON object per line.
+
+ Values are read directly from the database and written in batches as the
+ results are enumerated, without creating an accessor object for each object
+ or holding all of the output in memory. Link, mixed and linking objects
+ properties are not written. Dates are written as the number of seconds since
+ 1970, data as base64 strings, and decimal128, object id and UUID values as
+ strings.
+
+ The output can be read back with `-[RLMRealm createObjects:fromJSONLinesStream:error:]`.
+
+ @param stream An open stream to write the objects to.
+ @param error  If an error occurs, upon return contains an `NSError` object
+               that describes the problem. If you are not interested in
+               possible errors, pass in `NULL`.
+
+ @return `YES` if all of the objects were written, `NO` if an error occurred.
+ */
+- (BOOL)writeJSONLinesToStream:(NSOutputStream *)stream error:(NSError **)error;
+
 /// :nodoc:
 - (RLMObjectType)objectAtIndexedSubscript:(NSUInteger)index;
 
+#pragma mark - Query Diagnostics
+
+/**
+ Returns a human-readable description of how the query for these results is
+ evaluated, for use when tuning slow queries.
+
+ The description includes the query as it was translated for the database
+ (including how `IN` and `ANY` predicates were expanded), the sort and distinct
+ operations, which properties of the object type are indexed, and the number of
+ matching objects and how long it took to count them.
+
+ This evaluates the query, so it takes as long as the query itself does.
+ */
+- (NSString *)explain;
+
 #pragma mark - Freeze
 
 /**
@@ -510,6 +837,27 @@ __attribute__((warn_unused_result));
 */
 - (instancetype)thaw;
 
+/**
+ Evaluates the query for these frozen results using multiple threads, and
+ returns the matching objects.
+
+ The objects of the type are split into ranges which are filtered in parallel,
+ and the matches are then merged in the same order as the results. This can be
+ much faster than evaluating the query on a single thread when a large number
+ of objects have to be checked by a predicate which cannot use an index, such
+ as `CONTAINS[c]` on a string property.
+
+ Results which are sorted or distinct, or which are not based on a query over
+ all objects of the type (such as results obtained from a list), are evaluated
+ on the calling thread instead.
+
+ @warning This method can only be called on frozen results, as only frozen
+          Realms can be read from multiple threads at once.
+
+ @return The objects in the results, in order.
+ */
+- (NSArray<RLMObjectType> *)objectsByEvaluatingConcurrently;
+
 #pragma mark - Unavailable Methods
 
 /**
@@ -526,6 +874,175 @@ __attribute__((warn_unused_result));
 
 @end
 
+/**
+ A description of the changes to an `RLMSectionedResults` since the previous
+ time its notification block was called.
+
+ Sections are identified by their key, so sections are only ever inserted or
+ deleted and never moved. Changes to the objects inside sections which were
+ inserted or deleted are not reported separately.
+ */
+@interface RLMSectionedResultsChange : NSObject
+
+/// The indices of sections in the previous version which have been deleted.
+@property (nonatomic, readonly) NSIndexSet *sectionDeletions;
+
+/// The indices of sections in the new version which were inserted.
+@property (nonatomic, readonly) NSIndexSet *sectionInsertions;
+
+/// The index paths of objects in the previous version which have been removed
+/// from the sectioned results.
+@property (nonatomic, readonly) NSArray<NSIndexPath *> *deletions;
+
+/// The index paths of objects in the new version which were added.
+@property (nonatomic, readonly) NSArray<NSIndexPath *> *insertions;
+
+/// The index paths of objects in the previous version which were modified.
+@property (nonatomic, readonly) NSArray<NSIndexPath *> *modifications;
+
+@end
+
+/**
+ `RLMSectionedResults` is an auto-updating collection of objects divided into
+ sections by the value of a key path. It is created by calling
+ `-[RLMResults sectionedResultsUsingKeyPath:ascending:]`.
+
+ The sections are calculated from a single sorted results collection, and a
+ single notification block reports both the section and the object changes.
+ */
+@interface RLMSectionedResults<RLMObjectType> : NSObject
+
+/// The number of sections.
+@property (nonatomic, readonly) NSUInteger count;
+
+/// The value of the sectioning key path for each section. `nil` is represented by `NSNull`.
+@property (nonatomic, readonly) NSArray *sectionKeys;
+
+/// All of the objects in every section, in order.
+@property (nonatomic, readonly) RLMResults<RLMObjectType> *allObjects;
+
+/// Returns the number of objects in the given section.
+- (NSUInteger)numberOfObjectsInSection:(NSUInteger)section;
+
+/// Returns the object at the given index within the given section.
+- (RLMObjectType)objectAtIndex:(NSUInteger)index inSection:(NSUInteger)section;
+
+/**
+ Registers a block to be called each time the sectioned results change.
+
+ The block is called with a `nil` change the first time it is called, and after
+ that with a description of the sections and objects which were inserted,
+ deleted or modified. Notifications are delivered in the same way as for
+ `-[RLMResults addNotificationBlock:]`.
+
+ @param block The block to be called whenever a change occurs.
+ @return A token which must be held for as long as you want updates to be delivered.
+ */
+- (RLMNotificationToken *)addNotificationBlock:(void (^)(RLMSectionedResults<RLMObjectType> *_Nullable sections,
+                                                         RLMSectionedResultsChange *_Nullable change,
+                                                         NSError *_Nullable error))block
+__attribute__((warn_unused_result));
+
+#pragma mark - Unavailable Methods
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMSectionedResults cannot be created directly")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMSectionedResults cannot be created directly")));
+
+@end
+
+/**
+ The result of grouping a results collection with `-[RLMResults groupedBy:aggregating:]`.
+
+ Each group's values are stored at the same index in each of the arrays, with
+ the groups in the order that their keys first appear in the results.
+ */
+@interface RLMGroupedAggregates : NSObject
+
+/// The number of groups.
+@property (nonatomic, readonly) NSUInteger count;
+
+/// The distinct values of the grouping key path. `nil` values are represented by `NSNull`.
+@property (nonatomic, readonly) NSArray *keys;
+
+/// The number of objects in each group.
+@property (nonatomic, readonly) NSArray<NSNumber *> *counts;
+
+/// The minimum value of the aggregated property in each group, or `NSNull` for
+/// groups which have no non-`nil` values. Empty if no property was aggregated.
+@property (nonatomic, readonly) NSArray *minimums;
+
+/// The maximum value of the aggregated property in each group, or `NSNull` for
+/// groups which have no non-`nil` values. Empty if no property was aggregated.
+@property (nonatomic, readonly) NSArray *maximums;
+
+/// The sum of the aggregated property in each group. Empty if no property was aggregated.
+@property (nonatomic, readonly) NSArray *sums;
+
+/// The average value of the aggregated property in each group, or `NSNull` for
+/// groups which have no non-`nil` values. Empty if no property was aggregated.
+@property (nonatomic, readonly) NSArray *averages;
+
+#pragma mark - Unavailable Methods
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMGroupedAggregates cannot be created directly")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMGroupedAggregates cannot be created directly")));
+
+@end
+
+/**
+ `RLMPreparedQuery` is a query on a single object type which is parsed once and
+ then run repeatedly with different arguments.
+
+ The predicate format uses `$0`, `$1`, etc. as placeholders for the arguments,
+ which are supplied each time the query is run. Placeholders may appear in the
+ format in any order, and the same placeholder may be used more than once.
+
+     RLMPreparedQuery *query = [RLMPreparedQuery queryWithClassName:@"Person"
+                                                    predicateFormat:@"age > $0 AND name BEGINSWITH $1"];
+     RLMResults *results = [query resultsInRealm:realm withArguments:@[@21, @"J"]];
+
+ Prepared queries are not tied to any specific Realm and can be used from any
+ thread.
+ */
+@interface RLMPreparedQuery : NSObject
+
+/// The name of the object type which this query is run on.
+@property (nonatomic, readonly) NSString *className;
+
+/// The number of arguments which must be supplied when running the query.
+@property (nonatomic, readonly) NSUInteger numberOfArguments;
+
+/**
+ Creates a prepared query on objects of the given type.
+
+ @param className       The name of the object type to query.
+ @param predicateFormat A predicate format string, using `$0`, `$1`, etc. for the
+                        arguments of the query.
+ */
++ (instancetype)queryWithClassName:(NSString *)className predicateFormat:(NSString *)predicateFormat;
+
+/**
+ Runs the query in the given Realm.
+
+ @param realm     The Realm to query.
+ @param arguments The values to use for each of the placeholders in the predicate
+                  format, ordered by their index. `NSNull` can be used to pass `nil`.
+
+ @return An `RLMResults` containing the objects which match the query.
+ */
+- (RLMResults *)resultsInRealm:(RLMRealm *)realm withArguments:(NSArray *)arguments;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("Use +queryWithClassName:predicateFormat:")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("Use +queryWithClassName:predicateFormat:")));
+
+@end
+
 /**
  `RLMLinkingObjects` is an auto-updating container type. It represents a collection of objects that link to its
  parent object.
@@ -37,25 +37,688 @@
 #import <realm/object-store/shared_realm.hpp>
 #import <realm/table_view.hpp>
 
+#import <algorithm>
+#import <array>
+#import <atomic>
+#import <chrono>
+#import <cmath>
 #import <objc/message.h>
+#import <optional>
+#import <string_view>
+#import <unordered_map>
 
 using namespace realm;
 
+RLMAggregateOperation const RLMAggregateOperationMin = @"min";
+RLMAggregateOperation const RLMAggregateOperationMax = @"max";
+RLMAggregateOperation const RLMAggregateOperationSum = @"sum";
+RLMAggregateOperation const RLMAggregateOperationAverage = @"average";
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wincomplete-implementation"
 @implementation RLMNotificationToken
+- (void)pause {
+}
+
+- (void)resume {
+}
 @end
 #pragma clang diagnostic pop
 
 @interface RLMResults () <RLMThreadConfined_Private>
 @end
 
+@interface RLMSectionedResults ()
+- (instancetype)initWithResults:(RLMResults *)results keyPath:(NSString *)keyPath;
+@end
+
+@interface RLMSectionedResultsChange ()
+- (instancetype)initWithSectionDeletions:(NSIndexSet *)sectionDeletions
+                       sectionInsertions:(NSIndexSet *)sectionInsertions
+                               deletions:(NSArray<NSIndexPath *> *)deletions
+                              insertions:(NSArray<NSIndexPath *> *)insertions
+                           modifications:(NSArray<NSIndexPath *> *)modifications;
+@end
+
+@interface RLMGroupedAggregates ()
+- (instancetype)initWithKeys:(NSArray *)keys counts:(NSArray<NSNumber *> *)counts
+                    minimums:(NSArray *)minimums maximums:(NSArray *)maximums
+                        sums:(NSArray *)sums averages:(NSArray *)averages;
+@end
+
+namespace {
+// A property reached from an object type through a chain of to-one links
+struct KeyPathColumn {
+    std::vector<ColKey> links;
+    ColKey column;
+    RLMProperty *property;
+
+    KeyPathColumn(RLMClassInfo& objectInfo, NSString *keyPath) {
+        RLMClassInfo *info = &objectInfo;
+        NSArray<NSString *> *components = [keyPath componentsSeparatedByString:@"."];
+        for (NSUInteger i = 0; i + 1 < components.count; ++i) {
+            RLMProperty *link = RLMValidatedProperty(info->rlmObjectSchema, components[i]);
+            if (link.type != RLMPropertyTypeObject || link.collection) {
+                @throw RLMException(@"Nested key paths through '%@' are not supported: aggregates can only follow to-one links.",
+                                    link.name);
+            }
+            links.push_back(info->tableColumn(link));
+            info = &info->linkTargetType(link.index);
+        }
+        property = RLMValidatedProperty(info->rlmObjectSchema, components.lastObject);
+        column = info->tableColumn(property);
+    }
+
+    // Read the value at the end of the key path for the given row, or none if
+    // one of the links along the path is nil
+    std::optional<Mixed> value(Obj obj) const {
+        for (ColKey link : links) {
+            if (obj.is_null(link)) {
+                return std::nullopt;
+            }
+            obj = obj.get_linked_object(link);
+        }
+        return obj.get_any(column);
+    }
+};
+
+// Calculates the min, max, sum and average of a column in a single pass
+struct KeyPathAggregator {
+    size_t count = 0;
+    Mixed min, max;
+    int64_t intSum = 0;
+    double doubleSum = 0;
+    Decimal128 decimalSum;
+
+    void add(Mixed value) {
+        if (value.is_null()) {
+            return;
+        }
+        if (count++ == 0) {
+            min = max = value;
+        }
+        else if (value.compare(min) < 0) {
+            min = value;
+        }
+        else if (value.compare(max) > 0) {
+            max = value;
+        }
+
+        switch (value.get_type()) {
+            case type_Int:     intSum += value.get_int(); break;
+            case type_Float:   doubleSum += value.get_float(); break;
+            case type_Double:  doubleSum += value.get_double(); break;
+            case type_Decimal: decimalSum = decimalSum + value.get<Decimal128>(); break;
+            default: break;
+        }
+    }
+
+    // Remove a value previously passed to add(). Returns false if the value
+    // was the current minimum or maximum, in which case the aggregator has to
+    // be rebuilt from the remaining values to find the new one.
+    bool remove(Mixed value) {
+        if (value.is_null()) {
+            return true;
+        }
+        switch (value.get_type()) {
+            case type_Int:     intSum -= value.get_int(); break;
+            case type_Float:   doubleSum -= value.get_float(); break;
+            case type_Double:  doubleSum -= value.get_double(); break;
+            case type_Decimal: decimalSum = decimalSum - value.get<Decimal128>(); break;
+            default: break;
+        }
+        if (--count == 0) {
+            *this = {};
+            return true;
+        }
+        return value.compare(min) != 0 && value.compare(max) != 0;
+    }
+
+    id sum(RLMPropertyType type) const {
+        switch (type) {
+            case RLMPropertyTypeInt:        return @(intSum);
+            case RLMPropertyTypeDecimal128: return RLMMixedToObjc(Mixed(decimalSum));
+            default:                        return @(doubleSum);
+        }
+    }
+
+    id average(RLMPropertyType type) const {
+        if (count == 0) {
+            return nil;
+        }
+        switch (type) {
+            case RLMPropertyTypeInt:
+                return @(static_cast<double>(intSum) / count);
+            case RLMPropertyTypeDecimal128:
+                return RLMMixedToObjc(Mixed(decimalSum / Decimal128(static_cast<int64_t>(count))));
+            default:
+                return @(doubleSum / count);
+        }
+    }
+};
+
+KeyPathColumn groupingColumn(RLMClassInfo& info, NSString *keyPath) {
+    KeyPathColumn groupPath(info, keyPath);
+    RLMProperty *groupProperty = groupPath.property;
+    if (groupProperty.collection || groupProperty.type == RLMPropertyTypeObject
+        || groupProperty.type == RLMPropertyTypeLinkingObjects) {
+        @throw RLMException(@"Cannot group by %@ property '%@': only properties with a single non-object value are supported.",
+                            groupProperty.collection ? @"collection" : RLMTypeToString(groupProperty.type), keyPath);
+    }
+    return groupPath;
+}
+
+std::optional<KeyPathColumn> aggregatedColumn(RLMClassInfo& info, NSString *property) {
+    std::optional<KeyPathColumn> valuePath;
+    if (property) {
+        valuePath.emplace(info, property);
+        RLMPropertyType type = valuePath->property.type;
+        if (valuePath->property.collection || (type != RLMPropertyTypeInt && type != RLMPropertyTypeFloat
+                                               && type != RLMPropertyTypeDouble && type != RLMPropertyTypeDecimal128)) {
+            @throw RLMException(@"groupedBy:aggregating: is not supported for %@%s property '%@'.",
+                                RLMTypeToString(type), valuePath->property.optional ? "?" : "", property);
+        }
+    }
+    return valuePath;
+}
+
+// Mixed compares numbers of different types by value, so they have to be
+// hashed by value too for 1 and 1.0 to be put in the same group
+struct GroupKeyHash {
+    size_t operator()(Mixed const& key) const {
+        if (key.is_null()) {
+            return 0;
+        }
+        switch (key.get_type()) {
+            case type_Int:     return hashNumber(static_cast<double>(key.get_int()));
+            case type_Float:   return hashNumber(key.get_float());
+            case type_Double:  return hashNumber(key.get_double());
+            case type_Decimal: return hashNumber(std::strtod(key.get<Decimal128>().to_string().c_str(), nullptr));
+            default:           return std::hash<Mixed>()(key);
+        }
+    }
+
+    static size_t hashNumber(double value) {
+        // -0.0 is equal to 0.0 but may not hash the same
+        return value == 0 ? 0 : std::hash<double>()(value);
+    }
+};
+
+// Box a group key. Rows whose key path passes through a nil link are grouped
+// with the rows whose value is null.
+id groupKeyToObjc(std::optional<Mixed> const& key, NSString *keyPath) {
+    if (!key || key->is_null()) {
+        return NSNull.null;
+    }
+    if (key->get_type() == type_Link || key->get_type() == type_TypedLink) {
+        @throw RLMException(@"Cannot group by mixed property '%@' containing objects: only non-object values are supported.",
+                            keyPath);
+    }
+    return RLMMixedToObjc(*key);
+}
+
+// Grouped aggregates which are kept up to date from the changesets delivered
+// to a collection notification rather than recalculated from scratch. The
+// group and aggregated value of each row of the Results is cached, so that
+// rows which were deleted or modified can have their previous value removed
+// from their group without reading the old version of the object.
+class IncrementalGroupedAggregates {
+public:
+    IncrementalGroupedAggregates(NSString *keyPath, std::optional<KeyPathColumn> groupPath,
+                                 std::optional<KeyPathColumn> valuePath)
+    : _keyPath(keyPath), _groupPath(std::move(groupPath)), _valuePath(std::move(valuePath))
+    , _groupIndex([NSMutableDictionary new]) { }
+
+    // Update the aggregates to reflect the given version of the Results.
+    // Returns the new aggregates, or nil if none of them changed.
+    RLMGroupedAggregates *update(TableView& tv, RLMCollectionChange *change) {
+        if (!change) {
+            _rows.clear();
+            _rows.reserve(tv.size());
+            for (size_t i = 0, size = tv.size(); i < size; ++i) {
+                _rows.push_back(read(tv[i]));
+                addRow(_rows.back());
+            }
+        }
+        else {
+            apply(tv, change);
+        }
+
+        for (size_t i = 0; i < _groups.size(); ++i) {
+            if (_groups[i].stale) {
+                rebuild(i);
+            }
+        }
+
+        RLMGroupedAggregates *snapshot = makeSnapshot();
+        if (_last && [snapshot.keys isEqualToArray:_last.keys] && [snapshot.counts isEqualToArray:_last.counts]
+            && [snapshot.minimums isEqualToArray:_last.minimums] && [snapshot.maximums isEqualToArray:_last.maximums]
+            && [snapshot.sums isEqualToArray:_last.sums] && [snapshot.averages isEqualToArray:_last.averages]) {
+            return nil;
+        }
+        return _last = snapshot;
+    }
+
+private:
+    struct Row {
+        size_t group;
+        // Only numeric values are aggregated, so the Mixed doesn't point into
+        // the Realm file and remains valid after the version changes
+        std::optional<Mixed> value;
+    };
+    struct Group {
+        __strong id key;
+        size_t count = 0;
+        KeyPathAggregator aggregator;
+        bool stale = false;
+    };
+
+    NSString *_keyPath;
+    std::optional<KeyPathColumn> _groupPath;
+    std::optional<KeyPathColumn> _valuePath;
+    std::vector<Row> _rows;
+    // Groups are never removed, so that the group indices stored in _rows stay
+    // valid; groups which become empty are left out of the snapshot instead
+    std::vector<Group> _groups;
+    NSMutableDictionary<id, NSNumber *> *_groupIndex;
+    RLMGroupedAggregates *_last;
+
+    Row read(Obj obj) {
+        id key = groupKeyToObjc(_groupPath->value(obj), _keyPath);
+        NSNumber *index = _groupIndex[key];
+        if (!index) {
+            index = @(_groups.size());
+            _groupIndex[key] = index;
+            _groups.push_back({key});
+        }
+        return {index.unsignedLongValue, _valuePath ? _valuePath->value(obj) : std::nullopt};
+    }
+
+    void addRow(Row const& row) {
+        auto& group = _groups[row.group];
+        ++group.count;
+        if (row.value) {
+            group.aggregator.add(*row.value);
+        }
+    }
+
+    void removeRow(Row const& row) {
+        auto& group = _groups[row.group];
+        --group.count;
+        if (row.value && !group.aggregator.remove(*row.value)) {
+            group.stale = true;
+        }
+    }
+
+    // Recalculate a group whose minimum or maximum was removed from the
+    // cached values of its rows
+    void rebuild(size_t index) {
+        auto& group = _groups[index];
+        group.aggregator = {};
+        group.stale = false;
+        for (auto& row : _rows) {
+            if (row.group == index && row.value) {
+                group.aggregator.add(*row.value);
+            }
+        }
+    }
+
+    // Merge the changeset into the cached rows in a single pass. Collection
+    // changesets never contain moves, so the rows which weren't deleted keep
+    // their relative order, and every index in the new version is either an
+    // insertion or the next surviving row from the old version.
+    void apply(TableView& tv, RLMCollectionChange *change) {
+        std::vector<bool> deleted(_rows.size()), modified(_rows.size());
+        NSIndexSet *deletions = change.deletionIndexes;
+        for (NSUInteger i = deletions.firstIndex; i != NSNotFound; i = [deletions indexGreaterThanIndex:i]) {
+            deleted[i] = true;
+            removeRow(_rows[i]);
+        }
+        NSIndexSet *modifications = change.modificationIndexes;
+        for (NSUInteger i = modifications.firstIndex; i != NSNotFound; i = [modifications indexGreaterThanIndex:i]) {
+            modified[i] = true;
+        }
+        NSIndexSet *insertions = change.insertionIndexes;
+
+        std::vector<Row> rows;
+        rows.reserve(tv.size());
+        size_t old = 0;
+        for (size_t i = 0, size = tv.size(); i < size; ++i) {
+            if ([insertions containsIndex:i]) {
+                rows.push_back(read(tv[i]));
+                addRow(rows.back());
+                continue;
+            }
+            while (deleted[old]) {
+                ++old;
+            }
+            if (modified[old]) {
+                removeRow(_rows[old]);
+                rows.push_back(read(tv[i]));
+                addRow(rows.back());
+            }
+            else {
+                rows.push_back(_rows[old]);
+            }
+            ++old;
+        }
+        _rows = std::move(rows);
+    }
+
+    RLMGroupedAggregates *makeSnapshot() const {
+        auto keyArray = [NSMutableArray new];
+        auto countArray = [NSMutableArray new];
+        auto minArray = [NSMutableArray new];
+        auto maxArray = [NSMutableArray new];
+        auto sumArray = [NSMutableArray new];
+        auto avgArray = [NSMutableArray new];
+        for (auto& group : _groups) {
+            if (group.count == 0) {
+                continue;
+            }
+            [keyArray addObject:group.key];
+            [countArray addObject:@(group.count)];
+            if (!_valuePath) {
+                continue;
+            }
+            auto& aggregator = group.aggregator;
+            RLMPropertyType type = _valuePath->property.type;
+            [minArray addObject:aggregator.count ? RLMMixedToObjc(aggregator.min) : NSNull.null];
+            [maxArray addObject:aggregator.count ? RLMMixedToObjc(aggregator.max) : NSNull.null];
+            [sumArray addObject:aggregator.sum(type)];
+            [avgArray addObject:aggregator.average(type) ?: NSNull.null];
+        }
+        return [[RLMGroupedAggregates alloc] initWithKeys:keyArray counts:countArray minimums:minArray
+                                                 maximums:maxArray sums:sumArray averages:avgArray];
+    }
+};
+} // anonymous namespace
+
 //
 // RLMResults implementation
 //
+namespace {
+void appendJSONString(std::string& out, StringData str) {
+    out += '"';
+    for (char c : std::string_view(str.data(), str.size())) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                }
+                else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+void appendJSONNumber(std::string& out, double value, int precision) {
+    if (!std::isfinite(value)) {
+        // JSON has no representation for NaN or infinity
+        out += "null";
+        return;
+    }
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.*g", precision, value);
+    out += buf;
+}
+
+void appendJSONValue(std::string& out, Mixed const& value) {
+    if (value.is_null()) {
+        out += "null";
+        return;
+    }
+    switch (value.get_type()) {
+        case type_Int:
+            out += std::to_string(value.get_int());
+            break;
+        case type_Bool:
+            out += value.get_bool() ? "true" : "false";
+            break;
+        case type_Float:
+            appendJSONNumber(out, value.get_float(), 9);
+            break;
+        case type_Double:
+            appendJSONNumber(out, value.get_double(), 17);
+            break;
+        case type_String:
+            appendJSONString(out, value.get_string());
+            break;
+        case type_Binary: {
+            auto binary = value.get_binary();
+            NSData *data = [NSData dataWithBytesNoCopy:const_cast<char *>(binary.data())
+                                                length:binary.size() freeWhenDone:NO];
+            out += '"';
+            out += [data base64EncodedStringWithOptions:0].UTF8String;
+            out += '"';
+            break;
+        }
+        case type_Timestamp: {
+            // Dates are written as seconds since 1970, matching NSDate's
+            // timeIntervalSince1970
+            auto ts = value.get_timestamp();
+            appendJSONNumber(out, ts.get_seconds() + ts.get_nanoseconds() / 1e9, 17);
+            break;
+        }
+        case type_Decimal:
+            appendJSONString(out, value.get<Decimal128>().to_string());
+            break;
+        case type_ObjectId:
+            appendJSONString(out, value.get<ObjectId>().to_string());
+            break;
+        case type_UUID:
+            appendJSONString(out, value.get<UUID>().to_string());
+            break;
+        default:
+            out += "null";
+            break;
+    }
+}
+
+// Append the non-link persisted properties of `obj` as a single-line JSON
+// object, reading the values directly from the columns
+void appendJSONObject(std::string& out, Obj const& obj, ObjectSchema const& objectSchema) {
+    out += '{';
+    bool first = true;
+    for (auto& prop : objectSchema.persisted_properties) {
+        auto baseType = prop.type & ~PropertyType::Flags;
+        if (baseType == PropertyType::Object || baseType == PropertyType::Mixed) {
+            continue;
+        }
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+        appendJSONString(out, prop.name);
+        out += ':';
+
+        if (is_dictionary(prop.type)) {
+            auto dictionary = obj.get_dictionary(prop.column_key);
+            out += '{';
+            for (size_t i = 0, size = dictionary.size(); i < size; ++i) {
+                auto [key, value] = dictionary.get_pair(i);
+                if (i) {
+                    out += ',';
+                }
+                appendJSONString(out, key.get_string());
+                out += ':';
+                appendJSONValue(out, value);
+            }
+            out += '}';
+        }
+        else if (is_collection(prop.type)) {
+            std::unique_ptr<CollectionBase> collection;
+            if (is_array(prop.type)) {
+                collection = obj.get_listbase_ptr(prop.column_key);
+            }
+            else {
+                collection = obj.get_setbase_ptr(prop.column_key);
+            }
+            out += '[';
+            for (size_t i = 0, size = collection->size(); i < size; ++i) {
+                if (i) {
+                    out += ',';
+                }
+                appendJSONValue(out, collection->get_any(i));
+            }
+            out += ']';
+        }
+        else {
+            appendJSONValue(out, obj.get_any(prop.column_key));
+        }
+    }
+    out += "}\n";
+}
+
+bool writeFully(NSOutputStream *stream, std::string const& str) {
+    auto bytes = reinterpret_cast<const uint8_t *>(str.data());
+    size_t offset = 0;
+    while (offset < str.size()) {
+        NSInteger written = [stream write:bytes + offset maxLength:str.size() - offset];
+        if (written <= 0) {
+            return false;
+        }
+        offset += written;
+    }
+    return true;
+}
+
+// An object which may be among the first few objects of sorted results, along
+// with the values of the properties being sorted on and its position in the
+// unsorted results
+struct SortCandidate {
+    std::array<Mixed, 4> values;
+    size_t index;
+    Obj obj;
+};
+
+bool appliesSort(DescriptorOrdering const& ordering) {
+    for (size_t i = 0; i < ordering.size(); ++i) {
+        if (ordering.get_type(i) == DescriptorType::Sort) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sorting the full results is O(n log n) even when only the first or last few
+// objects are read. For results which haven't been evaluated yet and are only
+// sorted on properties of the object itself, the first `count` objects can
+// instead be selected with a bounded heap over the unsorted query results in
+// O(n log count). Returns false without doing anything if the results aren't
+// eligible.
+bool selectSortedPrefix(Results& results, RLMClassInfo& info, NSArray<RLMSortDescriptor *> *descriptors,
+                        size_t count, bool fromEnd, std::vector<Obj>& out) {
+    if (!descriptors || descriptors.count > std::tuple_size_v<decltype(SortCandidate::values)>
+        || results.get_mode() != Results::Mode::Query || results.get_type() != PropertyType::Object) {
+        return false;
+    }
+    auto& ordering = results.get_descriptor_ordering();
+    for (size_t i = 0; i < ordering.size(); ++i) {
+        if (ordering.get_type(i) != DescriptorType::Sort) {
+            return false;
+        }
+    }
+
+    // Floats and doubles are excluded as NaN doesn't have a consistent order,
+    // and strings as the sort order isn't a plain comparison of their values
+    std::vector<std::pair<ColKey, bool>> columns;
+    for (RLMSortDescriptor *descriptor in descriptors) {
+        RLMProperty *prop = info.rlmObjectSchema[descriptor.keyPath];
+        if (!prop || prop.collection) {
+            return false;
+        }
+        switch (prop.type) {
+            case RLMPropertyTypeInt:
+            case RLMPropertyTypeBool:
+            case RLMPropertyTypeDate:
+            case RLMPropertyTypeObjectId:
+            case RLMPropertyTypeDecimal128:
+            case RLMPropertyTypeUUID:
+                break;
+            default:
+                return false;
+        }
+        columns.emplace_back(info.tableColumn(prop), descriptor.ascending);
+    }
+
+    // Orders candidates the same way as sorting does, with ties kept in the
+    // order of the unsorted results, or the reverse of that if reading from
+    // the end
+    auto precedes = [&](SortCandidate const& a, SortCandidate const& b) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (int cmp = a.values[i].compare(b.values[i])) {
+                return (columns[i].second ? cmp < 0 : cmp > 0) != fromEnd;
+            }
+        }
+        return (a.index < b.index) != fromEnd;
+    };
+
+    // A max-heap whose top is the candidate which would be sorted last
+    std::vector<SortCandidate> heap;
+    auto tv = results.get_query().find_all();
+    heap.reserve(std::min(count, tv.size()));
+    for (size_t i = 0, size = tv.size(); i < size && count > 0; ++i) {
+        SortCandidate candidate{{}, i, tv.get_object(i)};
+        for (size_t j = 0; j < columns.size(); ++j) {
+            candidate.values[j] = candidate.obj.get_any(columns[j].first);
+        }
+        if (heap.size() < count) {
+            heap.push_back(std::move(candidate));
+            std::push_heap(heap.begin(), heap.end(), precedes);
+        }
+        else if (precedes(candidate, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), precedes);
+            heap.back() = std::move(candidate);
+            std::push_heap(heap.begin(), heap.end(), precedes);
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end(), precedes);
+    out.clear();
+    for (auto& candidate : heap) {
+        out.push_back(std::move(candidate.obj));
+    }
+    return true;
+}
+} // anonymous namespace
+
 @implementation RLMResults {
     RLMRealm *_realm;
     RLMClassInfo *_info;
+    // The sort descriptors applied with sortedResultsUsingDescriptors:, most
+    // significant first, used to continue windows after an object
+    NSArray<RLMSortDescriptor *> *_sortDescriptors;
+    // Whether the results are over the whole table rather than a List, Set or
+    // LinkingObjects view, so that the table can be split into ranges which
+    // are queried separately
+    bool _queriesWholeTable;
+    // The count as of the Realm version in _cachedCountVersion
+    std::optional<uint64_t> _cachedCountVersion;
+    size_t _cachedCount;
+    // The position of each object in the results as of _objectIndexVersion.
+    // Only built for results with a notifier, as otherwise there's nothing to
+    // tell us when it can be reused for a new version.
+    std::unordered_map<int64_t, size_t> _objectIndex;
+    std::optional<uint64_t> _objectIndexVersion;
+    // The version of the most recent notification, which the next one's
+    // changes are relative to
+    std::optional<uint64_t> _notifiedVersion;
+    bool _hasNotifier;
+    // The first _sortedPrefixLength objects of the sorted results, or the last
+    // ones in reverse order if _sortedPrefixFromEnd, as of _sortedPrefixVersion
+    std::vector<Obj> _sortedPrefix;
+    std::optional<uint64_t> _sortedPrefixVersion;
+    size_t _sortedPrefixLength;
+    bool _sortedPrefixFromEnd;
 }
 
 - (instancetype)initPrivate {
@@ -70,6 +733,10 @@ using namespace realm;
     return self;
 }
 
+static bool isKeyPath(NSString *property) {
+    return [property rangeOfString:@"." options:NSLiteralSearch].location != NSNotFound;
+}
+
 static void assertKeyPathIsNotNested(NSString *keyPath) {
     if ([keyPath rangeOfString:@"."].location != NSNotFound) {
         @throw RLMException(@"Nested key paths are not supported yet for KVC collection operators.");
@@ -127,12 +794,22 @@ void RLMThrowResultsError(NSString *aggregateMethod) {
     return [[self alloc] initWithObjectInfo:info results:std::move(results)];
 }
 
++ (instancetype)tableResultsWithObjectInfo:(RLMClassInfo&)info
+                                   results:(realm::Results&&)results {
+    RLMResults *ar = [[self alloc] initWithObjectInfo:info results:std::move(results)];
+    ar->_queriesWholeTable = true;
+    return ar;
+}
+
 + (instancetype)emptyDetachedResults {
     return [[self alloc] initPrivate];
 }
 
 - (instancetype)subresultsWithResults:(realm::Results)results {
-    return [self.class resultsWithObjectInfo:*_info results:std::move(results)];
+    RLMResults *subresults = [self.class resultsWithObjectInfo:*_info results:std::move(results)];
+    subresults->_sortDescriptors = _sortDescriptors;
+    subresults->_queriesWholeTable = _queriesWholeTable;
+    return subresults;
 }
 
 static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMResults *const ar) {
@@ -144,8 +821,124 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
     return translateRLMResultsErrors([&] { return !_results.is_valid(); });
 }
 
+// The version of the read transaction the Realm is in, or nullopt if the
+// results are unmanaged or the Realm is in a write transaction
+static std::optional<uint64_t> currentReadVersion(__unsafe_unretained RLMResults *const results) {
+    RLMRealm *realm = results->_realm;
+    if (!realm) {
+        return std::nullopt;
+    }
+    [realm verifyThread];
+    auto& r = *realm->_realm;
+    if (r.is_closed() || !r.is_in_read_transaction() || r.is_in_transaction()) {
+        return std::nullopt;
+    }
+    return r.read_transaction_version().version;
+}
+
+// The count is cached until the Realm advances to a new version, so repeated
+// reads of the count of a query don't rerun the query. Inside a write
+// transaction the count can change without the version changing, so it's
+// recalculated on every access.
 - (NSUInteger)count {
-    return translateRLMResultsErrors([&] { return _results.size(); });
+    return translateRLMResultsErrors([&] {
+        auto version = currentReadVersion(self);
+        if (!version) {
+            return _results.size();
+        }
+        if (_cachedCountVersion != version) {
+            _cachedCount = _results.size();
+            _cachedCountVersion = version;
+        }
+        return _cachedCount;
+    });
+}
+
+- (void)cacheCountForCurrentVersion {
+    translateRLMResultsErrors([&] {
+        if (auto version = currentReadVersion(self)) {
+            _cachedCount = _results.size();
+            _cachedCountVersion = version;
+        }
+    });
+}
+
+// Selecting a sorted prefix has to scan the entire table, so the selected
+// objects are kept until the Realm advances to a new version and reused for
+// any later read of the same or a shorter prefix from the same end. As with the
+// count, nothing is cached inside a write transaction.
+- (bool)selectSortedPrefixOfLength:(size_t)count fromEnd:(bool)fromEnd into:(std::vector<Obj>&)out {
+    auto version = currentReadVersion(self);
+    if (version && _sortedPrefixVersion == version && _sortedPrefixFromEnd == fromEnd
+        && count <= _sortedPrefixLength) {
+        out.assign(_sortedPrefix.begin(), _sortedPrefix.begin() + std::min(count, _sortedPrefix.size()));
+        return true;
+    }
+    if (!selectSortedPrefix(_results, *_info, _sortDescriptors, count, fromEnd, out)) {
+        return false;
+    }
+    if (version) {
+        _sortedPrefix = out;
+        _sortedPrefixVersion = version;
+        _sortedPrefixLength = count;
+        _sortedPrefixFromEnd = fromEnd;
+    }
+    return true;
+}
+
+// Notifications which only report modifications leave every object where it
+// was, so the index can be carried forward to the new version. Anything which
+// moves objects around discards it, and it's rebuilt by the next
+// indexOfObject: rather than on every notification. The changes only cover
+// the versions since the previous notification, so an index built at any
+// other version, or one which predates a commit that skipped notifications,
+// is discarded too.
+- (void)updateObjectIndexWithChanges:(realm::CollectionChangeSet const *)changes {
+    _hasNotifier = true;
+    auto version = translateRLMResultsErrors([&] { return currentReadVersion(self); });
+    auto notifiedVersion = std::exchange(_notifiedVersion, version);
+    if (!_objectIndexVersion) {
+        return;
+    }
+    if (version && changes && notifiedVersion && _objectIndexVersion == notifiedVersion
+        && _realm->_lastSkippedNotificationVersion <= *notifiedVersion
+        && changes->insertions.empty() && changes->deletions.empty()
+        && changes->moves.empty() && !changes->collection_root_was_deleted) {
+        _objectIndexVersion = version;
+    }
+    else {
+        _objectIndex.clear();
+        _objectIndexVersion.reset();
+    }
+}
+
+// Look up the position of `obj` in the index, building it if needed. Returns
+// nullopt if the index can't be used, in which case the caller should fall
+// back to searching the results.
+static std::optional<size_t> indexOfObjectUsingIndex(__unsafe_unretained RLMResults *const results,
+                                                     __unsafe_unretained RLMObjectBase *const obj) {
+    if (!results->_hasNotifier || obj->_realm != results->_realm || obj->_info != results->_info
+        || !obj->_row.is_valid() || results->_results.get_type() != PropertyType::Object) {
+        return std::nullopt;
+    }
+    auto version = currentReadVersion(results);
+    if (!version) {
+        return std::nullopt;
+    }
+    if (results->_objectIndexVersion != version) {
+        auto& index = results->_objectIndex;
+        index.clear();
+        size_t count = results->_results.size();
+        index.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            // emplace() keeps the first position for objects which appear
+            // more than once, matching index_of()
+            index.emplace(results->_results.get(i).get_key().value, i);
+        }
+        results->_objectIndexVersion = version;
+    }
+    auto it = results->_objectIndex.find(obj->_row.get_key().value);
+    return it == results->_objectIndex.end() ? realm::not_found : it->second;
 }
 
 - (RLMPropertyType)type {
@@ -187,6 +980,105 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
     return RLMFastEnumerate(state, len, self);
 }
 
+- (void)enumerateObjectsInChunksOfSize:(NSUInteger)chunkSize
+                            usingBlock:(void (NS_NOESCAPE ^)(NSArray *, BOOL *))block {
+    if (!_info) {
+        return;
+    }
+    translateRLMResultsErrors([&] {
+        _results.evaluate_query_if_needed();
+    });
+    [self.fastEnumerator enumerateInChunksOfSize:chunkSize usingBlock:block];
+}
+
+- (void)enumerateWithReusedAccessor:(void (NS_NOESCAPE ^)(id, BOOL *))block {
+    if (!_info) {
+        return;
+    }
+    if (self.type != RLMPropertyTypeObject) {
+        @throw RLMException(@"enumerateWithReusedAccessor: is only supported on RLMResults of RLMObjects.");
+    }
+    realm::TableView tv = self.tableView;
+    RLMObjectBase *accessor = RLMCreateManagedAccessor(_info->rlmObjectSchema.accessorClass, _info);
+    // Swift properties are initialized once, and then only the ones which
+    // hold on to the row are set up again for each object
+    NSArray<RLMProperty *> *rowProperties;
+    BOOL stop = NO;
+    for (size_t i = 0, count = tv.size(); i < count && !stop; ++i) {
+        if (!tv.is_obj_valid(i)) {
+            continue;
+        }
+        accessor->_row = tv[i];
+        if (!rowProperties) {
+            RLMInitializeSwiftAccessor(accessor, false);
+            rowProperties = RLMSwiftPropertiesDependingOnRow(accessor);
+        }
+        else {
+            for (RLMProperty *prop in rowProperties) {
+                [prop.swiftAccessor initialize:prop on:accessor];
+            }
+        }
+        block(accessor, &stop);
+    }
+}
+
+- (void)enumerateObjectsWithOptions:(NSEnumerationOptions)opts
+                         usingBlock:(void (NS_NOESCAPE ^)(id, NSUInteger, BOOL *))block {
+    if (!_info) {
+        return;
+    }
+    if (self.type != RLMPropertyTypeObject) {
+        @throw RLMException(@"enumerateObjectsWithOptions:usingBlock: is only supported on RLMResults of RLMObjects.");
+    }
+    bool concurrent = opts & NSEnumerationConcurrent;
+    if (concurrent && !self.frozen) {
+        @throw RLMException(@"Concurrent enumeration is only supported on frozen Results.");
+    }
+    realm::TableView tv = self.tableView;
+    size_t count = tv.size();
+    if (!concurrent) {
+        bool reverse = opts & NSEnumerationReverse;
+        BOOL stop = NO;
+        for (size_t i = 0; i < count && !stop; ++i) {
+            size_t index = reverse ? count - i - 1 : i;
+            if (!tv.is_obj_valid(index)) {
+                continue;
+            }
+            @autoreleasepool {
+                block(RLMCreateObjectAccessor(*_info, tv[index]), index, &stop);
+            }
+        }
+        return;
+    }
+
+    // Use a few chunks per core so that uneven amounts of work per object
+    // still balance out across the threads
+    size_t chunks = std::min<size_t>(count, NSProcessInfo.processInfo.activeProcessorCount * 4);
+    std::atomic<bool> stopped{false};
+    // Blocks copy captured C++ objects, so capture pointers to the shared state
+    auto stoppedPtr = &stopped;
+    auto view = &tv;
+    RLMClassInfo *info = _info;
+    dispatch_apply(chunks, DISPATCH_APPLY_AUTO, ^(size_t chunk) {
+        size_t end = count * (chunk + 1) / chunks;
+        for (size_t i = count * chunk / chunks; i < end; ++i) {
+            if (stoppedPtr->load(std::memory_order_relaxed)) {
+                return;
+            }
+            if (!view->is_obj_valid(i)) {
+                continue;
+            }
+            @autoreleasepool {
+                BOOL stop = NO;
+                block(RLMCreateObjectAccessor(*info, (*view)[i]), i, &stop);
+                if (stop) {
+                    *stoppedPtr = true;
+                }
+            }
+        }
+    });
+}
+
 - (NSUInteger)indexOfObjectWhere:(NSString *)predicateFormat, ... {
     va_list args;
     va_start(args, predicateFormat);
@@ -209,13 +1101,19 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
         if (_results.get_type() != realm::PropertyType::Object) {
             @throw RLMException(@"Querying is currently only implemented for arrays of Realm Objects");
         }
-        return RLMConvertNotFound(_results.index_of(RLMPredicateToQuery(predicate, _info->rlmObjectSchema, _realm.schema, _realm.group)));
+        return RLMConvertNotFound(_results.index_of(RLMPredicateToQuery(predicate, *_info)));
     });
 }
 
 - (id)objectAtIndex:(NSUInteger)index {
-    RLMAccessorContext ctx(*_info);
-    return translateRLMResultsErrors([&] {
+    return translateRLMResultsErrors([&]() -> id {
+        // Create object accessors directly as +1 values rather than boxing
+        // them through an accessor context, as this is the hot path when
+        // indexing into Results in a loop
+        if (_results.get_type() == PropertyType::Object) {
+            return RLMCreateObjectAccessor(*_info, _results.get(index));
+        }
+        RLMAccessorContext ctx(*_info);
         return _results.get(ctx, index);
     });
 }
@@ -224,27 +1122,72 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
     if (!_info) {
         return nil;
     }
-    size_t c = self.count;
-    NSMutableArray *result = [[NSMutableArray alloc] initWithCapacity:indexes.count];
-    NSUInteger i = [indexes firstIndex];
-    RLMAccessorContext context(*_info);
-    while (i != NSNotFound) {
-        if (i >= 0 && i < c) {
-            [result addObject:_results.get(context, i)];
-        } else {
-            return nil;
+    if (indexes.count && indexes.lastIndex >= self.count) {
+        return nil;
+    }
+    return translateRLMResultsErrors([&] {
+        NSMutableArray *result = [[NSMutableArray alloc] initWithCapacity:indexes.count];
+        [indexes enumerateRangesUsingBlock:^(NSRange range, BOOL *) {
+            [self appendObjectsInRange:range to:result];
+        }];
+        return result;
+    });
+}
+
+- (NSArray *)objectsInRange:(NSRange)range {
+    if (!_info) {
+        return nil;
+    }
+    NSUInteger count = self.count;
+    if (NSMaxRange(range) > count) {
+        return nil;
+    }
+    return translateRLMResultsErrors([&] {
+        NSMutableArray *result = [[NSMutableArray alloc] initWithCapacity:range.length];
+        // Reading a small prefix of large sorted results doesn't need all of
+        // them to be sorted
+        std::vector<Obj> prefix;
+        if (NSMaxRange(range) <= count / 16
+            && [self selectSortedPrefixOfLength:NSMaxRange(range) fromEnd:false into:prefix]) {
+            for (NSUInteger i = range.location; i < prefix.size(); ++i) {
+                [result addObject:RLMCreateObjectAccessor(*_info, std::move(prefix[i]))];
+            }
+            return result;
         }
-        i = [indexes indexGreaterThanIndex:i];
+        [self appendObjectsInRange:range to:result];
+        return result;
+    });
+}
+
+// The range must already have been validated against the count, which
+// evaluates the query, so the objects can be read without rechecking it
+- (void)appendObjectsInRange:(NSRange)range to:(NSMutableArray *)result {
+    if (_results.get_type() == PropertyType::Object) {
+        for (NSUInteger i = range.location, end = NSMaxRange(range); i < end; ++i) {
+            [result addObject:RLMCreateObjectAccessor(*_info, _results.get(i))];
+        }
+        return;
+    }
+    RLMAccessorContext context(*_info);
+    for (NSUInteger i = range.location, end = NSMaxRange(range); i < end; ++i) {
+        [result addObject:_results.get(context, i)];
     }
-    return result;
 }
 
 - (id)firstObject {
     if (!_info) {
         return nil;
     }
-    RLMAccessorContext ctx(*_info);
-    return translateRLMResultsErrors([&] {
+    return translateRLMResultsErrors([&]() -> id {
+        if (_results.get_type() == PropertyType::Object) {
+            std::vector<Obj> prefix;
+            if ([self selectSortedPrefixOfLength:1 fromEnd:false into:prefix]) {
+                return prefix.empty() ? nil : RLMCreateObjectAccessor(*_info, std::move(prefix[0]));
+            }
+            auto obj = _results.first();
+            return obj ? RLMCreateObjectAccessor(*_info, std::move(*obj)) : nil;
+        }
+        RLMAccessorContext ctx(*_info);
         return _results.first(ctx);
     });
 }
@@ -253,8 +1196,16 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
     if (!_info) {
         return nil;
     }
-    RLMAccessorContext ctx(*_info);
-    return translateRLMResultsErrors([&] {
+    return translateRLMResultsErrors([&]() -> id {
+        if (_results.get_type() == PropertyType::Object) {
+            std::vector<Obj> prefix;
+            if ([self selectSortedPrefixOfLength:1 fromEnd:true into:prefix]) {
+                return prefix.empty() ? nil : RLMCreateObjectAccessor(*_info, std::move(prefix[0]));
+            }
+            auto obj = _results.last();
+            return obj ? RLMCreateObjectAccessor(*_info, std::move(*obj)) : nil;
+        }
+        RLMAccessorContext ctx(*_info);
         return _results.last(ctx);
     });
 }
@@ -268,6 +1219,10 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
         if (!obj->_realm && !obj.invalidated) {
             return NSNotFound;
         }
+        auto index = translateRLMResultsErrors([&] { return indexOfObjectUsingIndex(self, obj); });
+        if (index) {
+            return RLMConvertNotFound(*index);
+        }
     }
     RLMAccessorContext ctx(*_info);
     return translateRLMResultsErrors([&] {
@@ -315,25 +1270,28 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
 
 - (NSNumber *)_aggregateForKeyPath:(NSString *)keyPath
                             method:(util::Optional<Mixed> (Results::*)(ColKey))method
+                         operation:(RLMAggregateOperation)operation
                         methodName:(NSString *)methodName returnNilForEmpty:(BOOL)returnNilForEmpty {
-    assertKeyPathIsNotNested(keyPath);
-    return [self aggregate:keyPath method:method methodName:methodName returnNilForEmpty:returnNilForEmpty];
+    return [self aggregate:keyPath method:method operation:operation
+                methodName:methodName returnNilForEmpty:returnNilForEmpty];
 }
 
 - (NSNumber *)_minForKeyPath:(NSString *)keyPath {
-    return [self _aggregateForKeyPath:keyPath method:&Results::min methodName:@"@min" returnNilForEmpty:YES];
+    return [self _aggregateForKeyPath:keyPath method:&Results::min operation:RLMAggregateOperationMin
+                           methodName:@"@min" returnNilForEmpty:YES];
 }
 
 - (NSNumber *)_maxForKeyPath:(NSString *)keyPath {
-    return [self _aggregateForKeyPath:keyPath method:&Results::max methodName:@"@max" returnNilForEmpty:YES];
+    return [self _aggregateForKeyPath:keyPath method:&Results::max operation:RLMAggregateOperationMax
+                           methodName:@"@max" returnNilForEmpty:YES];
 }
 
 - (NSNumber *)_sumForKeyPath:(NSString *)keyPath {
-    return [self _aggregateForKeyPath:keyPath method:&Results::sum methodName:@"@sum" returnNilForEmpty:NO];
+    return [self _aggregateForKeyPath:keyPath method:&Results::sum operation:RLMAggregateOperationSum
+                           methodName:@"@sum" returnNilForEmpty:NO];
 }
 
 - (NSNumber *)_avgForKeyPath:(NSString *)keyPath {
-    assertKeyPathIsNotNested(keyPath);
     return [self averageOfProperty:keyPath];
 }
 
@@ -389,7 +1347,7 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
         if (_results.get_type() != realm::PropertyType::Object) {
             @throw RLMException(@"Querying is currently only implemented for arrays of Realm Objects");
         }
-        auto query = RLMPredicateToQuery(predicate, _info->rlmObjectSchema, _realm.schema, _realm.group);
+        auto query = RLMPredicateToQuery(predicate, *_info);
         return [self subresultsWithResults:_results.filter(std::move(query))];
     });
 }
@@ -406,7 +1364,18 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
         if (_results.get_mode() == Results::Mode::Empty) {
             return self;
         }
-        return [self subresultsWithResults:_results.sort(RLMSortDescriptorsToKeypathArray(properties))];
+        RLMResults *sorted = [self subresultsWithResults:RLMSortResults(_results, _info, properties)];
+        // Later sorts take precedence over earlier ones, which are only used
+        // to order objects which the new sort considers equal. Sorted results
+        // obtained from a List or Set don't know which sort they were created
+        // with, so neither do any results sorted again from them.
+        if (_sortDescriptors) {
+            sorted->_sortDescriptors = [properties arrayByAddingObjectsFromArray:_sortDescriptors];
+        }
+        else if (!appliesSort(_results.get_descriptor_ordering())) {
+            sorted->_sortDescriptors = properties;
+        }
+        return sorted;
     });
 }
 
@@ -421,13 +1390,111 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
         if (_results.get_mode() == Results::Mode::Empty) {
             return self;
         }
-        
-        std::vector<std::string> keyPathsVector;
-        for (NSString *keyPath in keyPaths) {
-            keyPathsVector.push_back(keyPath.UTF8String);
+        return [self subresultsWithResults:RLMDistinctResults(_results, _info, keyPaths)];
+    });
+}
+
+// Build a predicate matching the objects which sort after `object`: those
+// which are equal to it in every sort property before some property, and
+// then sort after it in that property. Null sorts before every other value.
+static NSPredicate *continuationPredicate(RLMClassInfo& info, NSArray<RLMSortDescriptor *> *descriptors,
+                                          RLMObjectBase *object) {
+    auto compare = ^(NSExpression *keyPath, id value, NSPredicateOperatorType type) {
+        return [NSComparisonPredicate predicateWithLeftExpression:keyPath
+                                                  rightExpression:[NSExpression expressionForConstantValue:value]
+                                                         modifier:NSDirectPredicateModifier
+                                                             type:type options:0];
+    };
+
+    // Validate every key path before reading any values from the object so
+    // that invalid ones report the usual error rather than a KVC exception
+    std::vector<KeyPathColumn> columns;
+    columns.reserve(descriptors.count);
+    for (RLMSortDescriptor *descriptor in descriptors) {
+        columns.emplace_back(info, descriptor.keyPath);
+    }
+
+    auto alternatives = [NSMutableArray arrayWithCapacity:descriptors.count];
+    auto equalities = [NSMutableArray arrayWithCapacity:descriptors.count];
+    for (NSUInteger i = 0; i < descriptors.count; ++i) {
+        RLMSortDescriptor *descriptor = descriptors[i];
+        KeyPathColumn const& column = columns[i];
+        NSExpression *keyPath = [NSExpression expressionForKeyPath:descriptor.keyPath];
+        id value = RLMCoerceToNil([object valueForKeyPath:descriptor.keyPath]);
+        bool ascending = descriptor.ascending;
+
+        NSPredicate *after;
+        if (!value) {
+            after = ascending ? compare(keyPath, nil, NSNotEqualToPredicateOperatorType) : nil;
+        }
+        else if (column.property.type == RLMPropertyTypeBool) {
+            // Bools can't be compared with < and >, but there's only one
+            // value after each of them
+            bool b = [value boolValue];
+            after = ascending != b ? compare(keyPath, @(!b), NSEqualToPredicateOperatorType) : nil;
+        }
+        else {
+            after = compare(keyPath, value, ascending ? NSGreaterThanPredicateOperatorType
+                                                      : NSLessThanPredicateOperatorType);
+        }
+        // In descending order null sorts after every other value, so it has to
+        // be matched explicitly for key paths which can be null
+        if (value && !ascending && (column.property.optional || !column.links.empty())) {
+            NSPredicate *isNull = compare(keyPath, nil, NSEqualToPredicateOperatorType);
+            after = after ? [NSCompoundPredicate orPredicateWithSubpredicates:@[after, isNull]] : isNull;
+        }
+        if (after) {
+            [alternatives addObject:[NSCompoundPredicate andPredicateWithSubpredicates:[equalities arrayByAddingObject:after]]];
         }
-        
-        return [self subresultsWithResults:_results.distinct(keyPathsVector)];
+        [equalities addObject:compare(keyPath, value, NSEqualToPredicateOperatorType)];
+    }
+    if (alternatives.count == 0) {
+        return [NSPredicate predicateWithValue:NO];
+    }
+    return [NSCompoundPredicate orPredicateWithSubpredicates:alternatives];
+}
+
+- (RLMResults *)windowedFrom:(RLMObjectBase *)object limit:(NSUInteger)limit {
+    if (limit == 0) {
+        @throw RLMException(@"Invalid window limit %lu: must be greater than zero.", (unsigned long)limit);
+    }
+    if (_results.get_mode() == Results::Mode::Empty) {
+        return self;
+    }
+    if (self.type != RLMPropertyTypeObject) {
+        @throw RLMException(@"Windows are only supported for Results of objects.");
+    }
+
+    if (object.invalidated) {
+        @throw RLMException(@"Object has been deleted or invalidated.");
+    }
+    if (object && ![object->_objectSchema.className isEqualToString:_info->rlmObjectSchema.className]) {
+        @throw RLMException(@"Object of type '%@' does not match RLMResults type '%@'.",
+                            object->_objectSchema.className, _info->rlmObjectSchema.className);
+    }
+
+    RLMResults *source = self;
+    if (_sortDescriptors) {
+        // Break ties with the primary key so that the position of every object
+        // can be described by its values. Strings can't be compared with <
+        // and > in queries, so string primary keys can't be used for this.
+        RLMProperty *primaryKey = _info->rlmObjectSchema.primaryKeyProperty;
+        NSArray<RLMSortDescriptor *> *descriptors = _sortDescriptors;
+        if (primaryKey && primaryKey.type != RLMPropertyTypeString && ![[descriptors valueForKey:@"keyPath"] containsObject:primaryKey.name]) {
+            descriptors = [descriptors arrayByAddingObject:[RLMSortDescriptor sortDescriptorWithKeyPath:primaryKey.name
+                                                                                              ascending:YES]];
+            source = [self sortedResultsUsingDescriptors:descriptors];
+            source->_sortDescriptors = descriptors;
+        }
+        if (object) {
+            source = [source objectsWithPredicate:continuationPredicate(*_info, descriptors, object)];
+        }
+    }
+    else if (object) {
+        @throw RLMException(@"Continuing a window after an object requires Results sorted with sortedResultsUsingDescriptors: or sortedResultsUsingKeyPath:ascending:.");
+    }
+    return translateRLMResultsErrors([&] {
+        return [source subresultsWithResults:source->_results.limit(limit)];
     });
 }
 
@@ -436,10 +1503,14 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
 }
 
 - (id)aggregate:(NSString *)property method:(util::Optional<Mixed> (Results::*)(ColKey))method
+      operation:(RLMAggregateOperation)operation
      methodName:(NSString *)methodName returnNilForEmpty:(BOOL)returnNilForEmpty {
     if (_results.get_mode() == Results::Mode::Empty) {
         return returnNilForEmpty ? nil : @0;
     }
+    if (isKeyPath(property)) {
+        return [self aggregates:@[operation] ofKeyPath:property methodName:methodName][operation];
+    }
     ColKey column;
     if (self.type == RLMPropertyTypeObject || ![property isEqualToString:@"self"]) {
         column = _info->tableColumn(property);
@@ -450,17 +1521,17 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
 }
 
 - (id)minOfProperty:(NSString *)property {
-    return [self aggregate:property method:&Results::min
+    return [self aggregate:property method:&Results::min operation:RLMAggregateOperationMin
                 methodName:@"minOfProperty" returnNilForEmpty:YES];
 }
 
 - (id)maxOfProperty:(NSString *)property {
-    return [self aggregate:property method:&Results::max
+    return [self aggregate:property method:&Results::max operation:RLMAggregateOperationMax
                 methodName:@"maxOfProperty" returnNilForEmpty:YES];
 }
 
 - (id)sumOfProperty:(NSString *)property {
-    return [self aggregate:property method:&Results::sum
+    return [self aggregate:property method:&Results::sum operation:RLMAggregateOperationSum
                 methodName:@"sumOfProperty" returnNilForEmpty:NO];
 }
 
@@ -468,6 +1539,10 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
     if (_results.get_mode() == Results::Mode::Empty) {
         return nil;
     }
+    if (isKeyPath(property)) {
+        return [self aggregates:@[RLMAggregateOperationAverage] ofKeyPath:property
+                     methodName:@"averageOfProperty"][RLMAggregateOperationAverage];
+    }
     ColKey column;
     if (self.type == RLMPropertyTypeObject || ![property isEqualToString:@"self"]) {
         column = _info->tableColumn(property);
@@ -476,6 +1551,228 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
     return value ? RLMMixedToObjc(*value) : nil;
 }
 
+- (NSDictionary<RLMAggregateOperation, id> *)aggregates:(NSArray<RLMAggregateOperation> *)operations
+                                             ofProperty:(NSString *)property {
+    for (RLMAggregateOperation operation in operations) {
+        if (![operation isEqualToString:RLMAggregateOperationMin]
+            && ![operation isEqualToString:RLMAggregateOperationMax]
+            && ![operation isEqualToString:RLMAggregateOperationSum]
+            && ![operation isEqualToString:RLMAggregateOperationAverage]) {
+            @throw RLMException(@"Unsupported aggregate operation '%@'.", operation);
+        }
+    }
+    if (_results.get_mode() == Results::Mode::Empty) {
+        return [operations containsObject:RLMAggregateOperationSum] ? @{RLMAggregateOperationSum: @0} : @{};
+    }
+    if (isKeyPath(property)) {
+        return [self aggregates:operations ofKeyPath:property methodName:@"aggregates:ofProperty:"];
+    }
+
+    // Direct columns are aggregated by core, which reads the column's leaves
+    // directly and so is faster per aggregate than a row-by-row scan
+    auto result = [NSMutableDictionary dictionaryWithCapacity:operations.count];
+    for (RLMAggregateOperation operation in operations) {
+        id value;
+        if ([operation isEqualToString:RLMAggregateOperationMin]) {
+            value = [self minOfProperty:property];
+        }
+        else if ([operation isEqualToString:RLMAggregateOperationMax]) {
+            value = [self maxOfProperty:property];
+        }
+        else if ([operation isEqualToString:RLMAggregateOperationSum]) {
+            value = [self sumOfProperty:property];
+        }
+        else {
+            value = [self averageOfProperty:property];
+        }
+        result[operation] = value;
+    }
+    return result;
+}
+
+// Aggregate a property reached through a chain of to-one links. Rather than
+// creating an accessor for each object along the path, this follows the links
+// on the underlying rows and calculates every requested aggregate in one scan
+// over the Results.
+- (NSDictionary<RLMAggregateOperation, id> *)aggregates:(NSArray<RLMAggregateOperation> *)operations
+                                              ofKeyPath:(NSString *)keyPath
+                                             methodName:(NSString *)methodName {
+    if (self.type != RLMPropertyTypeObject) {
+        @throw RLMException(@"Key paths are not supported for aggregates of %@ values.",
+                            RLMTypeToString(self.type));
+    }
+
+    KeyPathColumn path(*_info, keyPath);
+    RLMProperty *property = path.property;
+
+    bool needsArithmetic = [operations containsObject:RLMAggregateOperationSum]
+                        || [operations containsObject:RLMAggregateOperationAverage];
+    bool supported = false;
+    if (!property.collection) {
+        switch (property.type) {
+            case RLMPropertyTypeInt:
+            case RLMPropertyTypeFloat:
+            case RLMPropertyTypeDouble:
+            case RLMPropertyTypeDecimal128:
+                supported = true;
+                break;
+            case RLMPropertyTypeDate:
+                supported = !needsArithmetic;
+                break;
+            default:
+                break;
+        }
+    }
+    if (!supported) {
+        @throw RLMException(@"%@ is not supported for %@%s property '%@'.",
+                            methodName, RLMTypeToString(property.type),
+                            property.optional ? "?" : "", keyPath);
+    }
+
+    KeyPathAggregator aggregator;
+    translateRLMResultsErrors([&] {
+        auto tv = _results.get_tableview();
+        for (size_t i = 0, size = tv.size(); i < size; ++i) {
+            if (auto value = path.value(tv[i])) {
+                aggregator.add(*value);
+            }
+        }
+    }, methodName);
+
+    auto result = [NSMutableDictionary dictionaryWithCapacity:operations.count];
+    for (RLMAggregateOperation operation in operations) {
+        if ([operation isEqualToString:RLMAggregateOperationMin]) {
+            result[operation] = aggregator.count ? RLMMixedToObjc(aggregator.min) : nil;
+        }
+        else if ([operation isEqualToString:RLMAggregateOperationMax]) {
+            result[operation] = aggregator.count ? RLMMixedToObjc(aggregator.max) : nil;
+        }
+        else if ([operation isEqualToString:RLMAggregateOperationSum]) {
+            result[operation] = aggregator.sum(property.type);
+        }
+        else {
+            result[operation] = aggregator.average(property.type);
+        }
+    }
+    return result;
+}
+
+- (RLMSectionedResults *)sectionedResultsUsingKeyPath:(NSString *)keyPath ascending:(BOOL)ascending {
+    if (self.type != RLMPropertyTypeObject) {
+        @throw RLMException(@"Sectioning is not supported for Results of %@ values.",
+                            RLMTypeToString(self.type));
+    }
+    return [[RLMSectionedResults alloc] initWithResults:[self sortedResultsUsingKeyPath:keyPath ascending:ascending]
+                                                keyPath:keyPath];
+}
+
+- (RLMGroupedAggregates *)groupedBy:(NSString *)keyPath aggregating:(NSString *)property {
+    if (self.type != RLMPropertyTypeObject) {
+        @throw RLMException(@"Grouping is not supported for Results of %@ values.",
+                            RLMTypeToString(self.type));
+    }
+    if (_results.get_mode() == Results::Mode::Empty) {
+        return [[RLMGroupedAggregates alloc] initWithKeys:@[] counts:@[] minimums:@[]
+                                                 maximums:@[] sums:@[] averages:@[]];
+    }
+
+    KeyPathColumn groupPath = groupingColumn(*_info, keyPath);
+    std::optional<KeyPathColumn> valuePath = aggregatedColumn(*_info, property);
+
+    // Groups are stored in the order their keys first appear in the Results,
+    // so grouping sorted Results produces sorted groups
+    std::unordered_map<Mixed, size_t, GroupKeyHash> groupIndex;
+    std::vector<Mixed> keys;
+    std::vector<size_t> counts;
+    std::vector<KeyPathAggregator> aggregators;
+    translateRLMResultsErrors([&] {
+        auto tv = _results.get_tableview();
+        for (size_t i = 0, size = tv.size(); i < size; ++i) {
+            Obj obj = tv[i];
+            Mixed key = groupPath.value(obj).value_or(Mixed());
+            auto [it, inserted] = groupIndex.try_emplace(key, keys.size());
+            if (inserted) {
+                keys.push_back(key);
+                counts.push_back(0);
+                aggregators.emplace_back();
+            }
+            ++counts[it->second];
+            if (valuePath) {
+                if (auto value = valuePath->value(obj)) {
+                    aggregators[it->second].add(*value);
+                }
+            }
+        }
+    }, @"groupedBy:aggregating:");
+
+    NSUInteger groupCount = keys.size();
+    auto keyArray = [NSMutableArray arrayWithCapacity:groupCount];
+    auto countArray = [NSMutableArray arrayWithCapacity:groupCount];
+    auto minArray = [NSMutableArray arrayWithCapacity:valuePath ? groupCount : 0];
+    auto maxArray = [NSMutableArray arrayWithCapacity:valuePath ? groupCount : 0];
+    auto sumArray = [NSMutableArray arrayWithCapacity:valuePath ? groupCount : 0];
+    auto avgArray = [NSMutableArray arrayWithCapacity:valuePath ? groupCount : 0];
+    for (NSUInteger i = 0; i < groupCount; ++i) {
+        [keyArray addObject:groupKeyToObjc(keys[i], keyPath)];
+        [countArray addObject:@(counts[i])];
+        if (!valuePath) {
+            continue;
+        }
+        auto& aggregator = aggregators[i];
+        RLMPropertyType type = valuePath->property.type;
+        [minArray addObject:aggregator.count ? RLMMixedToObjc(aggregator.min) : NSNull.null];
+        [maxArray addObject:aggregator.count ? RLMMixedToObjc(aggregator.max) : NSNull.null];
+        [sumArray addObject:aggregator.sum(type)];
+        [avgArray addObject:aggregator.average(type) ?: NSNull.null];
+    }
+    return [[RLMGroupedAggregates alloc] initWithKeys:keyArray counts:countArray minimums:minArray
+                                             maximums:maxArray sums:sumArray averages:avgArray];
+}
+
+- (RLMNotificationToken *)addGroupedAggregatesNotificationBlock:(void (^)(RLMGroupedAggregates *, NSError *))block
+                                                      groupedBy:(NSString *)keyPath
+                                                    aggregating:(NSString *)property
+                                                          queue:(dispatch_queue_t)queue {
+    if (self.type != RLMPropertyTypeObject) {
+        @throw RLMException(@"Grouping is not supported for Results of %@ values.",
+                            RLMTypeToString(self.type));
+    }
+    std::optional<KeyPathColumn> groupPath, valuePath;
+    NSMutableArray<NSString *> *keyPaths = [NSMutableArray arrayWithObject:keyPath];
+    if (_results.get_mode() != Results::Mode::Empty) {
+        groupPath = groupingColumn(*_info, keyPath);
+        valuePath = aggregatedColumn(*_info, property);
+    }
+    if (property) {
+        [keyPaths addObject:property];
+    }
+
+    auto aggregates = std::make_shared<IncrementalGroupedAggregates>(keyPath, std::move(groupPath),
+                                                                     std::move(valuePath));
+    return RLMAddNotificationBlock(self, ^(RLMResults *results, RLMCollectionChange *change, NSError *error) {
+        if (error) {
+            block(nil, error);
+            return;
+        }
+        RLMGroupedAggregates *snapshot = translateRLMResultsErrors([&] {
+            auto tv = results->_results.get_tableview();
+            return aggregates->update(tv, change);
+        });
+        if (snapshot) {
+            block(snapshot, nil);
+        }
+    }, keyPaths, queue);
+}
+
+- (NSData *)packedValuesOfProperty:(NSString *)property {
+    if (!_info) {
+        return [NSData data];
+    }
+    return translateRLMResultsErrors([&] {
+        return RLMCollectionPackedValuesForKey(_results, property, *_info);
+    });
+}
+
 - (void)deleteObjectsFromRealm {
     if (self.type != RLMPropertyTypeObject) {
         @throw RLMException(@"Cannot delete objects from RLMResults<%@>: only RLMObjects can be deleted.",
@@ -497,6 +1794,108 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
     return RLMDescriptionWithMaxDepth(@"RLMResults", self, RLMDescriptionMaxDepth);
 }
 
+- (NSString *)explain {
+    [_realm verifyThread];
+    return translateRLMResultsErrors([&] {
+        auto table = _results.get_table();
+        if (!table) {
+            return [NSString stringWithFormat:@"RLMResults<%@> <%p> is not backed by a query.",
+                    RLMTypeToString(self.type), (void *)self];
+        }
+
+        NSMutableArray *indexedProperties = [NSMutableArray new];
+        for (auto col : table->get_column_keys()) {
+            if (table->has_search_index(col)) {
+                [indexedProperties addObject:RLMStringDataToNSString(table->get_column_name(col))];
+            }
+        }
+
+        auto query = _results.get_query();
+        auto start = std::chrono::steady_clock::now();
+        size_t matchedCount = query.count();
+        std::chrono::duration<double> evaluationTime = std::chrono::steady_clock::now() - start;
+
+        return [NSString stringWithFormat:
+                @"RLMResults<%@> <%p> {\n"
+                "\tquery = %s;\n"
+                "\tordering = %s;\n"
+                "\tindexedProperties = [%@];\n"
+                "\tmatchedCount = %zu;\n"
+                "\tobjectCount = %zu;\n"
+                "\tevaluationTime = %fs;\n"
+                "}",
+                self.objectClassName, (void *)self,
+                query.get_description().c_str(),
+                _results.get_descriptor_ordering().get_description(table).c_str(),
+                [indexedProperties componentsJoinedByString:@", "],
+                matchedCount, table->size(), evaluationTime.count()];
+    });
+}
+
+- (BOOL)writeJSONLinesToStream:(NSOutputStream *)stream error:(NSError **)error {
+    if (self.type != RLMPropertyTypeObject) {
+        @throw RLMException(@"Cannot export RLMResults<%@>: only RLMObjects can be exported.",
+                            RLMTypeToString(self.type));
+    }
+    [_realm verifyThread];
+    bool success = translateRLMResultsErrors([&] {
+        static const size_t bufferSize = 64 * 1024;
+        auto& objectSchema = *_info->objectSchema;
+        std::string buffer;
+        buffer.reserve(bufferSize);
+        for (size_t i = 0, count = _results.size(); i < count; ++i) {
+            appendJSONObject(buffer, _results.get(i), objectSchema);
+            if (buffer.size() >= bufferSize) {
+                if (!writeFully(stream, buffer)) {
+                    return false;
+                }
+                buffer.clear();
+            }
+        }
+        return writeFully(stream, buffer);
+    });
+    if (!success && error) {
+        *error = stream.streamError ?: [NSError errorWithDomain:NSCocoaErrorDomain
+                                                           code:NSFileWriteUnknownError
+                                                       userInfo:@{NSLocalizedDescriptionKey: @"Could not write objects to the output stream."}];
+    }
+    return success;
+}
+
+- (void)prefetchProperties:(NSArray<NSString *> *)properties {
+    if (!_info) {
+        return;
+    }
+    translateRLMResultsErrors([&] {
+        NSArray<RLMProperty *> *props = _info->rlmObjectSchema.properties;
+        if (properties) {
+            NSMutableArray *requested = [NSMutableArray arrayWithCapacity:properties.count];
+            for (NSString *name in properties) {
+                RLMProperty *prop = _info->rlmObjectSchema[name];
+                if (!prop) {
+                    @throw RLMException(@"Invalid property name '%@' for class '%@'.",
+                                        name, _info->rlmObjectSchema.className);
+                }
+                [requested addObject:prop];
+            }
+            props = requested;
+        }
+
+        std::vector<ColKey> columns;
+        for (RLMProperty *prop in props) {
+            if (!prop.collection) {
+                columns.push_back(_info->tableColumn(prop));
+            }
+        }
+        for (size_t i = 0, size = _results.size(); i < size; ++i) {
+            auto obj = _results.get(i);
+            for (auto col : columns) {
+                static_cast<void>(obj.get_any(col));
+            }
+        }
+    });
+}
+
 - (realm::TableView)tableView {
     return translateRLMResultsErrors([&] { return _results.get_tableview(); });
 }
@@ -520,8 +1919,11 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
 
 - (instancetype)resolveInRealm:(RLMRealm *)realm {
     return translateRLMResultsErrors([&] {
-        return [self.class resultsWithObjectInfo:_info->resolve(realm)
-                                         results:_results.freeze(realm->_realm)];
+        RLMResults *resolved = [self.class resultsWithObjectInfo:_info->resolve(realm)
+                                                         results:_results.freeze(realm->_realm)];
+        resolved->_sortDescriptors = _sortDescriptors;
+        resolved->_queriesWholeTable = _queriesWholeTable;
+        return resolved;
     });
 }
 
@@ -539,6 +1941,78 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
     return [self resolveInRealm:_realm.thaw];
 }
 
+- (NSArray *)objectsByEvaluatingConcurrently {
+    if (!_info) {
+        return @[];
+    }
+    if (self.type != RLMPropertyTypeObject) {
+        @throw RLMException(@"objectsByEvaluatingConcurrently is only supported on RLMResults of RLMObjects.");
+    }
+    if (!self.frozen) {
+        @throw RLMException(@"Concurrent query evaluation is only supported on frozen Results.");
+    }
+
+    std::vector<ObjKey> keys = translateRLMResultsErrors([&] {
+        std::vector<ObjKey> keys;
+        // Queries restricted to a List, Set or LinkingObjects view take
+        // ranges of the view rather than the table, so they're evaluated
+        // serially too
+        auto mode = _results.get_mode();
+        if (!_queriesWholeTable || (mode != Results::Mode::Table && mode != Results::Mode::Query)
+            || !_results.get_descriptor_ordering().is_empty()) {
+            auto tv = _results.get_tableview();
+            keys.reserve(tv.size());
+            for (size_t i = 0, size = tv.size(); i < size; ++i) {
+                keys.push_back(tv.get_key(i));
+            }
+            return keys;
+        }
+
+        // Ranges much smaller than this spend more time on thread dispatch
+        // than on evaluating the query
+        static constexpr size_t minimumRangeSize = 1024;
+        size_t size = _info->table()->size();
+        size_t ranges = std::max<size_t>(1, std::min<size_t>(NSProcessInfo.processInfo.activeProcessorCount,
+                                                              size / minimumRangeSize));
+        // Query nodes hold evaluation state, so each range needs its own copy
+        // of the query
+        std::vector<Query> queries(ranges, _results.get_query());
+        std::vector<std::vector<ObjKey>> matches(ranges);
+        std::vector<std::exception_ptr> errors(ranges);
+        auto queriesPtr = &queries;
+        auto matchesPtr = &matches;
+        auto errorsPtr = &errors;
+        dispatch_apply(ranges, DISPATCH_APPLY_AUTO, ^(size_t range) {
+            try {
+                auto tv = (*queriesPtr)[range].find_all(size * range / ranges, size * (range + 1) / ranges);
+                auto& rangeKeys = (*matchesPtr)[range];
+                rangeKeys.reserve(tv.size());
+                for (size_t i = 0, count = tv.size(); i < count; ++i) {
+                    rangeKeys.push_back(tv.get_key(i));
+                }
+            }
+            catch (...) {
+                (*errorsPtr)[range] = std::current_exception();
+            }
+        });
+
+        for (size_t range = 0; range < ranges; ++range) {
+            if (errors[range]) {
+                std::rethrow_exception(errors[range]);
+            }
+            keys.insert(keys.end(), matches[range].begin(), matches[range].end());
+        }
+        return keys;
+    });
+
+    auto table = _info->table();
+    NSMutableArray *objects = [NSMutableArray arrayWithCapacity:keys.size()];
+    for (auto key : keys) {
+        [objects addObject:RLMCreateObjectAccessor(*_info, table->get_object(key))];
+    }
+    return objects;
+}
+
 // The compiler complains about the method's argument type not matching due to
 // it not having the generic type attached, but it doesn't seem to be possible
 // to actually include the generic type
@@ -561,6 +2035,13 @@ static inline void RLMResultsValidateInWriteTransaction(__unsafe_unretained RLMR
                                          queue:(dispatch_queue_t)queue {
     return RLMAddNotificationBlock(self, block, keyPaths, queue);
 }
+
+- (RLMNotificationToken *)addNotificationBlock:(void (^)(RLMResults *, RLMCollectionChange *, NSError *))block
+                                      keyPaths:(NSArray<NSString *> *)keyPaths
+                                         queue:(dispatch_queue_t)queue
+                               minimumInterval:(NSTimeInterval)minimumInterval {
+    return RLMAddNotificationBlock(self, block, keyPaths, queue, minimumInterval);
+}
 #pragma clang diagnostic pop
 
 realm::Results& RLMGetBackingCollection(RLMResults *self) {
@@ -591,8 +2072,325 @@ realm::Results& RLMGetBackingCollection(RLMResults *self) {
 
 @end
 
+static NSString *const RLMPreparedQueryVariablePrefix = @"RLMArgument";
+
+@implementation RLMPreparedQuery {
+    NSPredicate *_template;
+    NSArray<NSString *> *_variableNames;
+}
+
+// Rewrite the `$0` placeholders to valid NSPredicate variable names, skipping
+// over quoted string literals
+static NSString *RLMRewritePlaceholders(NSString *format, NSUInteger *count) {
+    NSMutableString *result = [NSMutableString stringWithCapacity:format.length];
+    NSUInteger length = format.length;
+    unichar quote = 0;
+    *count = 0;
+    for (NSUInteger i = 0; i < length; ++i) {
+        unichar c = [format characterAtIndex:i];
+        if (quote) {
+            if (c == '\\' && i + 1 < length) {
+                [result appendFormat:@"%C%C", c, [format characterAtIndex:++i]];
+                continue;
+            }
+            if (c == quote) {
+                quote = 0;
+            }
+        }
+        else if (c == '"' || c == '\'') {
+            quote = c;
+        }
+        else if (c == '$' && i + 1 < length && isdigit([format characterAtIndex:i + 1])) {
+            NSUInteger index = 0;
+            while (i + 1 < length && isdigit([format characterAtIndex:i + 1])) {
+                index = index * 10 + ([format characterAtIndex:++i] - '0');
+            }
+            [result appendFormat:@"$%@%lu", RLMPreparedQueryVariablePrefix, (unsigned long)index];
+            *count = std::max(*count, index + 1);
+            continue;
+        }
+        [result appendFormat:@"%C", c];
+    }
+    return result;
+}
+
+- (instancetype)initWithClassName:(NSString *)className predicateFormat:(NSString *)predicateFormat {
+    if (self = [super init]) {
+        _className = className;
+        NSUInteger count;
+        _template = [NSPredicate predicateWithFormat:RLMRewritePlaceholders(predicateFormat, &count)];
+        _numberOfArguments = count;
+
+        NSMutableArray *names = [NSMutableArray arrayWithCapacity:count];
+        for (NSUInteger i = 0; i < count; ++i) {
+            [names addObject:[NSString stringWithFormat:@"%@%lu", RLMPreparedQueryVariablePrefix, (unsigned long)i]];
+        }
+        _variableNames = names;
+    }
+    return self;
+}
+
++ (instancetype)queryWithClassName:(NSString *)className predicateFormat:(NSString *)predicateFormat {
+    return [[self alloc] initWithClassName:className predicateFormat:predicateFormat];
+}
+
+- (RLMResults *)resultsInRealm:(RLMRealm *)realm withArguments:(NSArray *)arguments {
+    if (arguments.count != _numberOfArguments) {
+        @throw RLMException(@"Prepared query on '%@' requires %lu arguments but %lu were given",
+                            _className, (unsigned long)_numberOfArguments, (unsigned long)arguments.count);
+    }
+    return RLMGetObjectsWithPredicateTemplate(realm, _className, _template, _variableNames, arguments);
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"RLMPreparedQuery<%@>(%@)", _className, _template.predicateFormat];
+}
+
+@end
+
 @implementation RLMLinkingObjects
 - (NSString *)description {
     return RLMDescriptionWithMaxDepth(@"RLMLinkingObjects", self, RLMDescriptionMaxDepth);
 }
 @end
+
+@implementation RLMGroupedAggregates
+- (instancetype)initWithKeys:(NSArray *)keys counts:(NSArray<NSNumber *> *)counts
+                    minimums:(NSArray *)minimums maximums:(NSArray *)maximums
+                        sums:(NSArray *)sums averages:(NSArray *)averages {
+    if ((self = [super init])) {
+        _keys = keys;
+        _counts = counts;
+        _minimums = minimums;
+        _maximums = maximums;
+        _sums = sums;
+        _averages = averages;
+    }
+    return self;
+}
+
+- (NSUInteger)count {
+    return _keys.count;
+}
+@end
+
+namespace {
+// The position of each section within the sorted Results
+struct RLMSectionBoundaries {
+    // The index of the first object of each section
+    std::vector<size_t> starts;
+    // The key of each section
+    NSArray *keys = @[];
+    // The total number of objects
+    size_t count = 0;
+
+    NSUInteger sectionCount() const {
+        return starts.size();
+    }
+
+    size_t sectionSize(size_t section) const {
+        return (section + 1 < starts.size() ? starts[section + 1] : count) - starts[section];
+    }
+
+    // Convert an index in the flat Results into a section and row
+    NSIndexPath *indexPath(size_t index) const {
+        auto it = std::upper_bound(starts.begin(), starts.end(), index);
+        NSUInteger path[] = {static_cast<NSUInteger>(it - starts.begin() - 1),
+                             static_cast<NSUInteger>(index - *(it - 1))};
+        return [NSIndexPath indexPathWithIndexes:path length:2];
+    }
+};
+
+NSArray<NSIndexPath *> *RLMSectionedIndexPaths(NSIndexSet *indexes, RLMSectionBoundaries const& sections,
+                                               NSIndexSet *excludedSections) {
+    auto paths = [NSMutableArray arrayWithCapacity:indexes.count];
+    auto boundaries = &sections;
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *) {
+        NSIndexPath *path = boundaries->indexPath(index);
+        if (![excludedSections containsIndex:[path indexAtPosition:0]]) {
+            [paths addObject:path];
+        }
+    }];
+    return paths;
+}
+} // anonymous namespace
+
+@implementation RLMSectionedResults {
+    NSString *_keyPath;
+    RLMSectionBoundaries _sections;
+    uint64_t _version;
+    bool _computed;
+}
+
+- (instancetype)initWithResults:(RLMResults *)results keyPath:(NSString *)keyPath {
+    if ((self = [super init])) {
+        _allObjects = results;
+        _keyPath = keyPath;
+        // Validate the key path up front rather than on first access
+        if (RLMClassInfo *info = results.objectInfo) {
+            (void)KeyPathColumn(*info, keyPath);
+        }
+    }
+    return self;
+}
+
+// Section boundaries are cached until the Realm advances to a new version.
+// Inside a write transaction the objects can change without the version
+// changing, so they're recalculated on every access.
+- (RLMSectionBoundaries const&)sections {
+    if (RLMRealm *realm = _allObjects.realm) {
+        [realm verifyThread];
+        auto& r = *realm->_realm;
+        if (!r.is_in_transaction()) {
+            r.read_group();
+            uint64_t version = r.read_transaction_version().version;
+            if (_computed && version == _version) {
+                return _sections;
+            }
+            _version = version;
+        }
+    }
+    _sections = [self calculateSections];
+    _computed = true;
+    return _sections;
+}
+
+// Find the boundaries between runs of equal keys with a single pass over the
+// key values, without creating accessor objects. Only the first key of each
+// section is converted to an Objective-C object.
+- (RLMSectionBoundaries)calculateSections {
+    RLMSectionBoundaries sections;
+    RLMClassInfo *info = _allObjects.objectInfo;
+    if (!info || !_allObjects.realm) {
+        return sections;
+    }
+    KeyPathColumn path(*info, _keyPath);
+    auto keys = [NSMutableArray new];
+    translateRLMResultsErrors([&] {
+        auto tv = _allObjects.tableView;
+        sections.count = tv.size();
+        Mixed previous;
+        for (size_t i = 0; i < sections.count; ++i) {
+            Mixed key = path.value(tv[i]).value_or(Mixed());
+            if (i == 0 || key != previous) {
+                sections.starts.push_back(i);
+                [keys addObject:RLMMixedToObjc(key)];
+            }
+            previous = key;
+        }
+    });
+    sections.keys = keys;
+    return sections;
+}
+
+- (NSUInteger)count {
+    return self.sections.sectionCount();
+}
+
+- (NSArray *)sectionKeys {
+    return self.sections.keys;
+}
+
+static void validateSection(RLMSectionBoundaries const& sections, NSUInteger section) {
+    if (section >= sections.sectionCount()) {
+        @throw RLMException(@"Section index %lu is out of bounds (must be less than %lu).",
+                            (unsigned long)section, (unsigned long)sections.sectionCount());
+    }
+}
+
+- (NSUInteger)numberOfObjectsInSection:(NSUInteger)section {
+    auto& sections = self.sections;
+    validateSection(sections, section);
+    return sections.sectionSize(section);
+}
+
+- (id)objectAtIndex:(NSUInteger)index inSection:(NSUInteger)section {
+    auto& sections = self.sections;
+    validateSection(sections, section);
+    size_t size = sections.sectionSize(section);
+    if (index >= size) {
+        @throw RLMException(@"Index %lu is out of bounds (must be less than %lu).",
+                            (unsigned long)index, (unsigned long)size);
+    }
+    return [_allObjects objectAtIndex:sections.starts[section] + index];
+}
+
+- (RLMNotificationToken *)addNotificationBlock:(void (^)(RLMSectionedResults *, RLMSectionedResultsChange *, NSError *))block {
+    // Each notification block compares against the sections as they were the
+    // last time that block was called, as other accesses may have already
+    // recalculated the cached sections for the new version
+    auto previous = std::make_shared<RLMSectionBoundaries>();
+    return [_allObjects addNotificationBlock:^(RLMResults *, RLMCollectionChange *change, NSError *error) {
+        if (error) {
+            block(nil, nil, error);
+            return;
+        }
+        RLMSectionBoundaries current = self.sections;
+        if (!change) {
+            *previous = std::move(current);
+            block(self, nil, nil);
+            return;
+        }
+
+        // Sections are sorted by their keys, so a section can only be
+        // inserted or deleted and never moved
+        NSMapTable *oldSections = [NSMapTable strongToStrongObjectsMapTable];
+        [previous->keys enumerateObjectsUsingBlock:^(id key, NSUInteger i, BOOL *) {
+            [oldSections setObject:@(i) forKey:key];
+        }];
+        auto sectionInsertions = [NSMutableIndexSet new];
+        auto retainedSections = [NSMutableIndexSet new];
+        [current.keys enumerateObjectsUsingBlock:^(id key, NSUInteger i, BOOL *) {
+            if (NSNumber *oldIndex = [oldSections objectForKey:key]) {
+                [retainedSections addIndex:oldIndex.unsignedIntegerValue];
+            }
+            else {
+                [sectionInsertions addIndex:i];
+            }
+        }];
+        auto sectionDeletions = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, previous->sectionCount())];
+        [sectionDeletions removeIndexes:retainedSections];
+
+        auto sectionChange = [[RLMSectionedResultsChange alloc]
+                              initWithSectionDeletions:sectionDeletions
+                              sectionInsertions:sectionInsertions
+                              deletions:RLMSectionedIndexPaths(change.deletionIndexes, *previous, sectionDeletions)
+                              insertions:RLMSectionedIndexPaths(change.insertionIndexes, current, sectionInsertions)
+                              modifications:RLMSectionedIndexPaths(change.modificationIndexes, *previous, sectionDeletions)];
+        *previous = std::move(current);
+        block(self, sectionChange, nil);
+    }];
+}
+
+- (NSString *)description {
+    auto& sections = self.sections;
+    auto str = [NSMutableString stringWithFormat:@"RLMSectionedResults<%@> <%p> (", _allObjects.objectClassName, (void *)self];
+    for (NSUInteger i = 0; i < sections.sectionCount(); ++i) {
+        [str appendFormat:@"\n\t[%@]: %zu objects", sections.keys[i], sections.sectionSize(i)];
+    }
+    [str appendString:@"\n)"];
+    return str;
+}
+@end
+
+@implementation RLMSectionedResultsChange
+- (instancetype)initWithSectionDeletions:(NSIndexSet *)sectionDeletions
+                       sectionInsertions:(NSIndexSet *)sectionInsertions
+                               deletions:(NSArray<NSIndexPath *> *)deletions
+                              insertions:(NSArray<NSIndexPath *> *)insertions
+                           modifications:(NSArray<NSIndexPath *> *)modifications {
+    if ((self = [super init])) {
+        _sectionDeletions = sectionDeletions;
+        _sectionInsertions = sectionInsertions;
+        _deletions = deletions;
+        _insertions = insertions;
+        _modifications = modifications;
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<RLMSectionedResultsChange: %p> section insertions: %@, section deletions: %@, insertions: %@, deletions: %@, modifications: %@",
+            (__bridge void *)self, _sectionInsertions, _sectionDeletions, _insertions, _deletions, _modifications];
+}
+@end
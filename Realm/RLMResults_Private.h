@@ -28,6 +28,10 @@ NS_ASSUME_NONNULL_BEGIN
 + (instancetype)emptyDetachedResults;
 - (RLMResults *)snapshot;
 
+// Read the given properties (or all of them if nil) of each object in the
+// results, to fault in the pages of the file they are stored in
+- (void)prefetchProperties:(nullable NSArray<NSString *> *)properties;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -21,6 +21,9 @@
 #import <realm/object-store/results.hpp>
 
 class RLMClassInfo;
+namespace realm {
+struct CollectionChangeSet;
+}
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -40,8 +43,21 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (instancetype)initWithObjectInfo:(RLMClassInfo&)info results:(realm::Results&&)results;
 + (instancetype)resultsWithObjectInfo:(RLMClassInfo&)info results:(realm::Results&&)results;
+// Create results over the whole table (optionally filtered by a query), as
+// opposed to ones restricted to a List, Set or LinkingObjects view
++ (instancetype)tableResultsWithObjectInfo:(RLMClassInfo&)info results:(realm::Results&&)results;
 
 - (instancetype)subresultsWithResults:(realm::Results)results;
+
+// Record the current count of the results for the Realm's current version.
+// Called when a notification is delivered, at which point the results have
+// just been updated by the notifier and reading the count is cheap.
+- (void)cacheCountForCurrentVersion;
+
+// Bring the object index used by indexOfObject: forward to the Realm's current
+// version. Called when a notification is delivered, with the changes for that
+// notification, or nullptr if they aren't known.
+- (void)updateObjectIndexWithChanges:(realm::CollectionChangeSet const *_Nullable)changes;
 @end
 
 NS_ASSUME_NONNULL_END
@@ -72,6 +72,24 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (BOOL)isEqualToSchema:(RLMSchema *)schema;
 
+/**
+ Registers the complete list of `RLMObject` subclasses used by the app.
+
+ By default, the first time a Realm is opened without an explicit list of
+ object classes, every class in the process is inspected to find the
+ `RLMObject` subclasses. In apps which link a very large number of classes
+ this can take a noticeable amount of time. Registering the model classes up
+ front (for example with a list generated as part of the build) skips this
+ scan, and Realm configurations with `objectClasses` set are then required to
+ only use registered classes.
+
+ This must be called before any Realm is opened or any `RLMObject` is
+ created, and may be called at most once.
+
+ @param classes The `RLMObject` subclasses which make up the app's default schema.
+ */
++ (void)registerObjectClasses:(NSArray<Class> *)classes;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -60,6 +60,8 @@ const uint64_t RLMNotVersioned = realm::ObjectStore::NotVersioned;
 static RLMSchema *s_sharedSchema = [[RLMSchema alloc] init];
 static NSMutableDictionary *s_localNameToClass = [[NSMutableDictionary alloc] init];
 static RLMSchema *s_privateSharedSchema = [[RLMPrivateSchema alloc] init];
+// The classes passed to +registerObjectClasses:, if it has been called
+static NSSet<Class> *s_registeredClasses;
 
 static enum class SharedSchemaState {
     Uninitialized,
@@ -69,6 +71,9 @@ static enum class SharedSchemaState {
 
 @implementation RLMSchema {
     NSArray *_objectSchema;
+    // Built by the first call to -objectStoreCopy. Realms at different paths
+    // can be opened concurrently with the same schema, so it's guarded by a lock.
+    std::mutex _objectStoreSchemaMutex;
     realm::Schema _objectStoreSchema;
 }
 
@@ -192,6 +197,10 @@ static void RLMRegisterClassLocalNames(Class *classes, NSUInteger count) {
             if (!RLMIsObjectSubclass(cls)) {
                 @throw RLMException(@"Can't add non-Object type '%@' to a schema.", cls);
             }
+            if (s_registeredClasses && ![s_registeredClasses containsObject:cls]) {
+                @throw RLMException(@"Object type '%@' was not included in the classes passed to +[RLMSchema registerObjectClasses:].",
+                                    [cls className]);
+            }
             schema->_objectSchemaByName[[cls className]] = RLMRegisterClass(cls);
         }
     }
@@ -258,10 +267,11 @@ static void RLMRegisterClassLocalNames(Class *classes, NSUInteger count) {
             @throw RLMException(@"Illegal recursive call of +[%@ %@]. Note: Properties of Swift `Object` classes must not be prepopulated with queried results from a Realm.", self, NSStringFromSelector(_cmd));
         }
 
+        RLM_SIGNPOST_INTERVAL("Initialize shared schema");
         s_sharedSchemaState = SharedSchemaState::Initializing;
         try {
             // Make sure we've discovered all classes
-            {
+            if (!s_registeredClasses) {
                 unsigned int numClasses;
                 using malloc_ptr = std::unique_ptr<__unsafe_unretained Class[], decltype(&free)>;
                 malloc_ptr classes(objc_copyClassList(&numClasses), &free);
@@ -288,6 +298,28 @@ static void RLMRegisterClassLocalNames(Class *classes, NSUInteger count) {
     return s_sharedSchema;
 }
 
++ (void)registerObjectClasses:(NSArray<Class> *)classes {
+    NSUInteger count = classes.count;
+    auto classArray = std::make_unique<__unsafe_unretained Class[]>(count);
+    [classes getObjects:classArray.get() range:NSMakeRange(0, count)];
+    for (Class cls in classes) {
+        if (!RLMIsObjectSubclass(cls)) {
+            @throw RLMException(@"Can't register non-Object type '%@'.", cls);
+        }
+    }
+
+    @synchronized(s_localNameToClass) {
+        if (s_registeredClasses) {
+            @throw RLMException(@"Object classes can only be registered once.");
+        }
+        if (s_sharedSchemaState != SharedSchemaState::Uninitialized || s_privateSharedSchema.objectSchemaByName.count) {
+            @throw RLMException(@"Object classes must be registered before any Realm is opened or any Realm object is created.");
+        }
+        RLMRegisterClassLocalNames(classArray.get(), count);
+        s_registeredClasses = [NSSet setWithArray:classes];
+    }
+}
+
 // schema based on tables in a realm
 + (instancetype)dynamicSchemaFromObjectStoreSchema:(Schema const&)objectStoreSchema {
     // cache descriptors for all subclasses of RLMObject
@@ -313,8 +345,9 @@ static void RLMRegisterClassLocalNames(Class *classes, NSUInteger count) {
     }
 
     // className might be the local name of a Swift class we haven't registered
-    // yet, so scan them all then recheck
-    {
+    // yet, so scan them all then recheck. If the app registered its classes
+    // up front then there's nothing else to find.
+    if (!s_registeredClasses) {
         unsigned int numClasses;
         std::unique_ptr<__unsafe_unretained Class[], decltype(&free)> classes(objc_copyClassList(&numClasses), &free);
         RLMRegisterClassLocalNames(classes.get(), numClasses);
@@ -354,27 +387,32 @@ static void RLMRegisterClassLocalNames(Class *classes, NSUInteger count) {
     return [NSString stringWithFormat:@"Schema {\n%@}", objectSchemaString];
 }
 
+- (void)buildObjectStoreSchema {
+    std::vector<realm::ObjectSchema> schema;
+    schema.reserve(_objectSchemaByName.count);
+    [_objectSchemaByName enumerateKeysAndObjectsUsingBlock:[&](NSString *, RLMObjectSchema *objectSchema, BOOL *) {
+        schema.push_back([objectSchema objectStoreCopy:self]);
+    }];
+
+    // Having both obj-c and Swift classes for the same tables results in
+    // duplicate ObjectSchemas that we need to filter out
+    std::sort(begin(schema), end(schema), [](auto&& a, auto&& b) { return a.name < b.name; });
+    schema.erase(std::unique(begin(schema), end(schema), [](auto&& a, auto&& b) {
+        if (a.name == b.name) {
+            // If we make _realmObjectName public this needs to be turned into an exception
+            REALM_ASSERT_DEBUG(a.persisted_properties == b.persisted_properties);
+            return true;
+        }
+        return false;
+    }), end(schema));
+
+    _objectStoreSchema = std::move(schema);
+}
+
 - (Schema)objectStoreCopy {
+    std::lock_guard lock(_objectStoreSchemaMutex);
     if (_objectStoreSchema.size() == 0) {
-        std::vector<realm::ObjectSchema> schema;
-        schema.reserve(_objectSchemaByName.count);
-        [_objectSchemaByName enumerateKeysAndObjectsUsingBlock:[&](NSString *, RLMObjectSchema *objectSchema, BOOL *) {
-            schema.push_back([objectSchema objectStoreCopy:self]);
-        }];
-
-        // Having both obj-c and Swift classes for the same tables results in
-        // duplicate ObjectSchemas that we need to filter out
-        std::sort(begin(schema), end(schema), [](auto&& a, auto&& b) { return a.name < b.name; });
-        schema.erase(std::unique(begin(schema), end(schema), [](auto&& a, auto&& b) {
-            if (a.name == b.name) {
-                // If we make _realmObjectName public this needs to be turned into an exception
-                REALM_ASSERT_DEBUG(a.persisted_properties == b.persisted_properties);
-                return true;
-            }
-            return false;
-        }), end(schema));
-
-        _objectStoreSchema = std::move(schema);
+        [self buildObjectStoreSchema];
     }
     return _objectStoreSchema;
 }
@@ -350,6 +350,39 @@ __attribute__((warn_unused_result));
                                          queue:(nullable dispatch_queue_t)queue
 __attribute__((warn_unused_result));
 
+/**
+ Registers a block to be called each time the set changes, delivering changes
+ no more often than once per `minimumInterval`.
+
+ This behaves like `-addNotificationBlock:keyPaths:queue:`, except that changes
+ which occur less than `minimumInterval` seconds after the previous call to the
+ block are merged together and delivered as a single `RLMCollectionChange`
+ once the interval has elapsed. The initial notification and errors are
+ always delivered immediately. This is useful for reducing the amount of work
+ performed when the set is changing very rapidly, such as while a large
+ number of objects are being downloaded by sync.
+
+ If `queue` is `nil`, delayed notifications are delivered via the current
+ thread's run loop.
+
+ @warning This method cannot be called when the containing Realm is read-only or frozen.
+ @warning The queue must be a serial queue.
+
+ @param block The block to be called whenever a change occurs.
+ @param keyPaths The block will be called for changes occuring on these keypaths. If no
+ key paths are given, notifications are delivered for every property key path.
+ @param queue The serial queue to deliver notifications to.
+ @param minimumInterval The minimum time in seconds between calls to the block.
+ @return A token which must be held for as long as you want updates to be delivered.
+ */
+- (RLMNotificationToken *)addNotificationBlock:(void (^)(RLMSet<RLMObjectType> *_Nullable set,
+                                                         RLMCollectionChange *_Nullable changes,
+                                                         NSError *_Nullable error))block
+                                      keyPaths:(nullable NSArray<NSString *> *)keyPaths
+                                         queue:(nullable dispatch_queue_t)queue
+                               minimumInterval:(NSTimeInterval)minimumInterval
+__attribute__((warn_unused_result));
+
 /**
  Registers a block to be called each time the set changes.
 
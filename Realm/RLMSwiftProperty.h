@@ -54,6 +54,10 @@ REALM_FOR_EACH_SWIFT_PRIMITIVE_TYPE(REALM_SWIFT_PROPERTY_ACCESSOR)
 REALM_FOR_EACH_SWIFT_OBJECT_TYPE(REALM_SWIFT_PROPERTY_ACCESSOR)
 #undef REALM_SWIFT_PROPERTY_ACCESSOR
 
+// Returns a pointer to the UTF-8 bytes of a string property and stores their
+// length in `length`, or returns NULL if the value is nil. The bytes point into
+// the Realm file and must be copied before anything else is done with the Realm.
+const char *_Nullable RLMGetSwiftPropertyStringUTF8(RLMObjectBase *, uint16_t, size_t *length);
 id<RLMValue> _Nullable RLMGetSwiftPropertyAny(RLMObjectBase *, uint16_t);
 void RLMSetSwiftPropertyAny(RLMObjectBase *, uint16_t, id<RLMValue>);
 RLMObjectBase *_Nullable RLMGetSwiftPropertyObject(RLMObjectBase *, uint16_t);
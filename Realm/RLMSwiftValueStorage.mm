@@ -73,11 +73,20 @@ public:
     , _object(obj->_realm->_realm, *obj->_info->objectSchema, obj->_row)
     , _propertyName(prop.name.UTF8String)
     , _ctx(*obj->_info)
+    , _info(*obj->_info)
+    , _column(obj->_info->tableColumn(prop))
     {
     }
 
+    // RealmProperty only supports non-collection properties, so the value can
+    // be read directly from the row with the column key resolved up front
+    // rather than looking the property up by name each time.
     id get() override {
-        return _object.get_property_value<id>(_ctx, _propertyName);
+        if (!_object.obj().is_valid()) {
+            @throw RLMException(@"Object has been deleted or invalidated.");
+        }
+        [_realm verifyThread];
+        return RLMMixedToObjc(_object.obj().get_any(_column), _realm, &_info);
     }
 
     void set(__unsafe_unretained id const value) override {
@@ -96,6 +105,8 @@ private:
     realm::Object _object;
     std::string _propertyName;
     RLMAccessorContext _ctx;
+    RLMClassInfo& _info;
+    realm::ColKey _column;
 };
 } // anonymous namespace
 
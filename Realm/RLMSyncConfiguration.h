@@ -28,6 +28,12 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  A configuration object representing configuration state for a Realm which is intended to sync with a Realm Object
  Server.
+
+ Downloaded changesets are integrated by the sync client in write transactions whose size is determined by the
+ server, and there is no client-side option to limit it. To keep the UI responsive while a large download is being
+ integrated, deliver collection notifications with a `minimumInterval`, pause the notification tokens of
+ collections which are not visible, and have background writers call
+ `-[RLMRealm yieldWriteTransactionIfNeeded:]` so that writes on the main thread are not held up by them.
  */
 @interface RLMSyncConfiguration : NSObject
 
@@ -50,6 +56,18 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic) bool cancelAsyncOpenOnNonFatalErrors;
 
+/**
+ The directory to store the synchronized Realm file in, or `nil` to store it in
+ the user's directory within the app's sync metadata directory.
+
+ Large Realms can be placed on a faster volume, or in the caches directory if
+ the data can be downloaded again, by setting this before setting the
+ configuration on an `RLMRealmConfiguration`. The name of the file is the same
+ as it would be in the default location. The directory is created if it does
+ not exist.
+ */
+@property (nonatomic, nullable) NSURL *directoryURL;
+
 /// :nodoc:
 - (instancetype)initWithUser:(RLMUser *)user
               partitionValue:(nullable id<RLMBSON>)partitionValue __attribute__((unavailable("Use [RLMUser configurationWithPartitionValue:] instead")));
@@ -20,7 +20,7 @@
 
 #import <Realm/RLMSyncUtil.h>
 
-@class RLMSyncSession, RLMSyncTimeoutOptions, RLMAppConfiguration;
+@class RLMSyncSession, RLMSyncSessionStatistics, RLMSyncTimeoutOptions, RLMAppConfiguration;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -119,6 +119,30 @@ typedef void(^RLMSyncErrorReportingBlock)(NSError *, RLMSyncSession * _Nullable)
  */
 @property (nonatomic, nullable) RLMSyncLogFunction logger;
 
+/**
+ The number of log messages to buffer when delivering them to `logger`
+ asynchronously, or 0 to call `logger` synchronously on the sync client's
+ thread. Defaults to 0.
+
+ When this is non-zero, each message is copied into a buffer of this many
+ messages and `logger` is called with them in batches on a background serial
+ queue, so that a slow logger does not slow down sync. If the buffer is full
+ when a message arrives, the message is dropped, and `logger` is then called
+ with a warning saying how many were dropped. Messages which are still buffered
+ when `logger` or `logBufferSize` is changed are delivered to the previous
+ `logger` before the setter returns.
+
+ Messages below `logLevel` are discarded by the sync client before they are
+ formatted, whether or not they are buffered.
+
+ @warning Like `logger`, this must be set before any synced Realms are opened.
+ */
+@property (nonatomic) NSUInteger logBufferSize;
+
+/// The number of log messages which have been dropped because the log buffer
+/// was full since `logger` or `logBufferSize` was last set.
+@property (nonatomic, readonly) NSUInteger droppedLogMessageCount;
+
 /**
  The name of the HTTP header to send authorization data in when making requests to MongoDB Realm which has
  been configured to expect a custom authorization header.
@@ -143,6 +167,16 @@ typedef void(^RLMSyncErrorReportingBlock)(NSError *, RLMSyncSession * _Nullable)
  */
 @property (nullable, nonatomic, copy) RLMSyncTimeoutOptions *timeoutOptions;
 
+/**
+ The combined statistics for all of the currently open sync sessions.
+
+ Byte counts, transfer counts and rates are the sums of those of each session,
+ and the duration is that of the longest-tracked session.
+
+ @see `RLMSyncSessionStatistics`
+ */
+@property (nonatomic, readonly) RLMSyncSessionStatistics *sessionStatistics;
+
 /// :nodoc:
 - (instancetype)init __attribute__((unavailable("RLMSyncManager cannot be created directly")));
 
@@ -30,6 +30,10 @@
 #import <realm/object-store/sync/sync_manager.hpp>
 #import <realm/object-store/sync/sync_session.hpp>
 
+#import <mutex>
+#import <utility>
+#import <vector>
+
 #if !defined(REALM_COCOA_VERSION)
 #import "RLMVersion.h"
 #endif
@@ -106,6 +110,117 @@ struct CallbackLoggerFactory : public realm::SyncLoggerFactory {
     CallbackLoggerFactory(RLMSyncLogFunction logFn) : logFn(logFn) { }
 };
 
+// Copies log messages into a fixed-size ring and delivers them to the log
+// function in batches on a background queue, so that the sync client's thread
+// only has to copy each message. Messages which arrive while the ring is full
+// are dropped and reported in the next batch.
+class BufferedLogSink : public std::enable_shared_from_this<BufferedLogSink> {
+public:
+    BufferedLogSink(RLMSyncLogFunction logFn, size_t capacity)
+    : _logFn(logFn), _ring(capacity)
+    , _queue(dispatch_queue_create("io.realm.sync.logger", DISPATCH_QUEUE_SERIAL)) { }
+
+    void push(Level level, std::string const& message) {
+        {
+            std::lock_guard lock(_mutex);
+            if (_count == _ring.size()) {
+                ++_dropped;
+                ++_totalDropped;
+                return;
+            }
+            auto& entry = _ring[(_head + _count) % _ring.size()];
+            entry.level = level;
+            entry.message = message;
+            ++_count;
+            if (_flushScheduled) {
+                return;
+            }
+            _flushScheduled = true;
+        }
+        auto self = shared_from_this();
+        dispatch_async(_queue, ^{
+            self->flush();
+        });
+    }
+
+    uint64_t totalDropped() {
+        std::lock_guard lock(_mutex);
+        return _totalDropped;
+    }
+
+    // Deliver every message buffered so far before returning
+    void drain() {
+        dispatch_sync(_queue, ^{
+            flush();
+        });
+    }
+
+private:
+    struct Entry {
+        Level level;
+        std::string message;
+    };
+
+    const RLMSyncLogFunction _logFn;
+    std::mutex _mutex;
+    std::vector<Entry> _ring;
+    size_t _head = 0;
+    size_t _count = 0;
+    uint64_t _dropped = 0;
+    uint64_t _totalDropped = 0;
+    bool _flushScheduled = false;
+    dispatch_queue_t _queue;
+
+    void flush() {
+        std::vector<Entry> batch;
+        uint64_t dropped;
+        {
+            std::lock_guard lock(_mutex);
+            batch.reserve(_count);
+            for (; _count > 0; --_count) {
+                batch.push_back(std::move(_ring[_head]));
+                _head = (_head + 1) % _ring.size();
+            }
+            dropped = std::exchange(_dropped, 0);
+            _flushScheduled = false;
+        }
+        @autoreleasepool {
+            for (auto& entry : batch) {
+                _logFn(logLevelForLevel(entry.level), RLMStringDataToNSString(entry.message));
+            }
+            if (dropped) {
+                _logFn(RLMSyncLogLevelWarn, [NSString stringWithFormat:@"Dropped %llu sync log messages because the log buffer was full.",
+                                             (unsigned long long)dropped]);
+            }
+        }
+    }
+};
+
+struct BufferedLogger : public realm::util::RootLogger {
+    std::shared_ptr<BufferedLogSink> sink;
+    void do_log(Level level, const std::string& message) override {
+        sink->push(level, message);
+    }
+};
+struct BufferedLoggerFactory : public realm::SyncLoggerFactory {
+    std::shared_ptr<BufferedLogSink> sink;
+    std::unique_ptr<realm::util::Logger> make_logger(realm::util::Logger::Level level) override {
+        auto logger = std::make_unique<BufferedLogger>();
+        logger->sink = sink;
+        logger->set_level_threshold(level);
+        return std::move(logger);
+    }
+
+    BufferedLoggerFactory(RLMSyncLogFunction logFn, size_t capacity)
+    : sink(std::make_shared<BufferedLogSink>(logFn, capacity)) { }
+
+    // Messages logged before the factory is replaced or torn down are still
+    // delivered to the logger function they were logged for
+    ~BufferedLoggerFactory() {
+        sink->drain();
+    }
+};
+
 } // anonymous namespace
 
 #pragma mark - RLMSyncManager
@@ -118,6 +233,7 @@ struct CallbackLoggerFactory : public realm::SyncLoggerFactory {
 
 @implementation RLMSyncManager {
     std::unique_ptr<CallbackLoggerFactory> _loggerFactory;
+    std::unique_ptr<BufferedLoggerFactory> _bufferedLoggerFactory;
     std::shared_ptr<SyncManager> _syncManager;
 }
 
@@ -183,14 +299,48 @@ struct CallbackLoggerFactory : public realm::SyncLoggerFactory {
 
 - (void)setLogger:(RLMSyncLogFunction)logFn {
     _logger = logFn;
-    if (_logger) {
-        _loggerFactory = std::make_unique<CallbackLoggerFactory>(logFn);
-        _syncManager->set_logger_factory(*_loggerFactory);
+    [self updateLoggerFactory];
+}
+
+- (void)setLogBufferSize:(NSUInteger)logBufferSize {
+    _logBufferSize = logBufferSize;
+    [self updateLoggerFactory];
+}
+
+- (void)updateLoggerFactory {
+    // The new factory is installed before the old one is destroyed, as core
+    // only holds a reference to it
+    if (_logger && _logBufferSize) {
+        auto factory = std::make_unique<BufferedLoggerFactory>(_logger, _logBufferSize);
+        _syncManager->set_logger_factory(*factory);
+        _bufferedLoggerFactory = std::move(factory);
+        _loggerFactory = nullptr;
+    }
+    else if (_logger) {
+        auto factory = std::make_unique<CallbackLoggerFactory>(_logger);
+        _syncManager->set_logger_factory(*factory);
+        _loggerFactory = std::move(factory);
+        _bufferedLoggerFactory = nullptr;
     }
     else {
-        _loggerFactory = nullptr;
         _syncManager->set_logger_factory(s_syncLoggerFactory);
+        _loggerFactory = nullptr;
+        _bufferedLoggerFactory = nullptr;
+    }
+}
+
+- (NSUInteger)droppedLogMessageCount {
+    return _bufferedLoggerFactory ? static_cast<NSUInteger>(_bufferedLoggerFactory->sink->totalDropped()) : 0;
+}
+
+- (RLMSyncSessionStatistics *)sessionStatistics {
+    std::vector<std::shared_ptr<SyncSession>> sessions;
+    for (auto&& user : _syncManager->all_users()) {
+        for (auto&& session : user->all_sessions()) {
+            sessions.push_back(std::move(session));
+        }
     }
+    return RLMCombinedSessionStatistics(sessions);
 }
 
 - (void)setTimeoutOptions:(RLMSyncTimeoutOptions *)timeoutOptions {
@@ -223,6 +373,8 @@ struct CallbackLoggerFactory : public realm::SyncLoggerFactory {
     _appID = nil;
     _userAgent = nil;
     _logger = nil;
+    _logBufferSize = 0;
+    [self updateLoggerFactory];
     _authorizationHeaderName = nil;
     _customRequestHeaders = nil;
     _timeoutOptions = nil;
@@ -101,6 +101,17 @@ typedef NS_ENUM(NSUInteger, RLMSyncProgressMode) {
  */
 typedef void(^RLMProgressNotificationBlock)(NSUInteger transferredBytes, NSUInteger transferrableBytes);
 
+/**
+ The type of a block which is called when a session's connection state changes.
+
+ `timeInPreviousState` is the number of seconds the connection spent in
+ `oldState`, measured from when the block was registered if the connection was
+ already in that state at registration.
+ */
+typedef void(^RLMSyncConnectionStateChangeBlock)(RLMSyncConnectionState oldState,
+                                                 RLMSyncConnectionState newState,
+                                                 NSTimeInterval timeInPreviousState);
+
 NS_ASSUME_NONNULL_BEGIN
 
 /**
@@ -112,6 +123,53 @@ NS_ASSUME_NONNULL_BEGIN
 @interface RLMProgressNotificationToken : RLMNotificationToken
 @end
 
+/**
+ A snapshot of the network activity of one or more sync sessions over a period
+ of time.
+
+ Statistics are derived from the progress reported by the sync client, and are
+ collected for a session from the point at which an `RLMSyncSession` for it is
+ first obtained. Each change in the number of transferred bytes reported by the
+ sync client is counted as one transfer.
+ */
+@interface RLMSyncSessionStatistics : NSObject
+
+/// The length of the period this snapshot covers, in seconds.
+@property (nonatomic, readonly) NSTimeInterval duration;
+
+/// The number of bytes uploaded during the period.
+@property (nonatomic, readonly) NSUInteger uploadedBytes;
+/// The number of bytes downloaded during the period.
+@property (nonatomic, readonly) NSUInteger downloadedBytes;
+
+/// The number of uploads completed during the period.
+@property (nonatomic, readonly) NSUInteger uploadCount;
+/// The number of downloads completed during the period.
+@property (nonatomic, readonly) NSUInteger downloadCount;
+
+/// The average number of bytes uploaded per second.
+@property (nonatomic, readonly) double uploadBytesPerSecond;
+/// The average number of bytes downloaded per second.
+@property (nonatomic, readonly) double downloadBytesPerSecond;
+
+/// The average number of uploads completed per second.
+@property (nonatomic, readonly) double uploadsPerSecond;
+/// The average number of downloads completed per second.
+@property (nonatomic, readonly) double downloadsPerSecond;
+
+/// The average size in bytes of each upload, or 0 if there were no uploads.
+@property (nonatomic, readonly) double averageUploadSize;
+/// The average size in bytes of each download, or 0 if there were no downloads.
+@property (nonatomic, readonly) double averageDownloadSize;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMSyncSessionStatistics cannot be created directly")));
+
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMSyncSessionStatistics cannot be created directly")));
+
+@end
+
 /**
  An object encapsulating a MongoDB Realm "session". Sessions represent the
  communication between the client (and a local Realm file on disk), and the server
@@ -195,6 +253,60 @@ NS_ASSUME_NONNULL_BEGIN
                                                                          block:(RLMProgressNotificationBlock)block
 NS_REFINED_FOR_SWIFT;
 
+/**
+ Register a block which is called each time the session's connection state
+ changes.
+
+ The block is invoked on a side queue devoted to progress notifications. The
+ time spent in the disconnected and connecting states before each transition to
+ `RLMSyncConnectionStateConnected` can be used to measure how long reconnecting
+ takes.
+
+ @param block The block to invoke when the connection state changes.
+
+ @return A token which must be held for as long as you want notifications to be
+         delivered, or `nil` if the session is no longer valid.
+ */
+- (nullable RLMNotificationToken *)addConnectionStateChangeNotificationBlock:(RLMSyncConnectionStateChangeBlock)block
+NS_REFINED_FOR_SWIFT;
+
+/**
+ The statistics for this session since they began being collected.
+ */
+@property (nonatomic, readonly) RLMSyncSessionStatistics *statistics;
+
+/**
+ Register a block which is periodically called with the statistics for the
+ preceding interval.
+
+ The block is invoked on a side queue devoted to progress notifications once
+ per `interval` seconds until the returned token is invalidated, including
+ when there was no network activity during the interval.
+
+ @param interval The number of seconds between each invocation of the block.
+ @param block    The block to invoke with each snapshot.
+
+ @return A token which must be held for as long as you want notifications to be delivered.
+ */
+- (RLMNotificationToken *)addStatisticsNotificationWithInterval:(NSTimeInterval)interval
+                                                          block:(void (^)(RLMSyncSessionStatistics *))block;
+
+/**
+ The priority of this session relative to the user's other sessions.
+
+ Setting the priority of a session marks it as downloading until it has caught
+ up with the server. While any of a user's sessions with a higher priority are
+ downloading, the user's sessions with a lower priority are suspended, and
+ they are resumed once the higher priority sessions have caught up, so that a
+ large download for a partition which is not currently being displayed does
+ not hold up a small one for a partition which is. Sessions which were
+ suspended with `-suspend` are not resumed. Defaults to 0.
+
+ The priority can be changed at any time, and is shared by all
+ `RLMSyncSession` objects for the same session.
+ */
+@property (atomic) NSInteger priority;
+
 /**
  Given an error action token, immediately handle the corresponding action.
  
@@ -270,6 +382,26 @@ NS_REFINED_FOR_SWIFT;
  happening concurrently, all other opens will fail with the error "operation cancelled".
  */
 - (void)cancel;
+
+/**
+ The priority of this async open relative to other async opens.
+
+ When the number of async opens which can run at once is limited by
+ `maximumConcurrentOpens`, queued opens with a higher priority are started
+ before those with a lower priority, and opens with the same priority are
+ started in the order they were requested. Changing the priority of an open
+ which is still queued changes its position in the queue. Defaults to 0.
+ */
+@property (atomic) NSInteger priority;
+
+/**
+ The maximum number of async opens which can be in progress at once.
+
+ Async opens requested while this many are already in progress are queued
+ until one of the in-progress opens completes or is cancelled. Setting this
+ to 0, the default, places no limit on the number of concurrent opens.
+ */
+@property (class, nonatomic) NSUInteger maximumConcurrentOpens;
 @end
 
 NS_ASSUME_NONNULL_END
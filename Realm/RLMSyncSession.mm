@@ -24,12 +24,463 @@
 #import "RLMUser_Private.hpp"
 #import "RLMSyncManager_Private.hpp"
 #import "RLMSyncUtil_Private.hpp"
+#import "RLMUtil.hpp"
 
 #import <realm/object-store/sync/async_open_task.hpp>
 #import <realm/object-store/sync/sync_session.hpp>
+#import <realm/object-store/sync/sync_user.hpp>
+
+#import <algorithm>
+#import <chrono>
+#import <mutex>
+#import <optional>
+#import <unordered_map>
+#import <vector>
 
 using namespace realm;
 
+#pragma mark - Statistics
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct TransferCounts {
+    uint64_t bytes = 0;
+    uint64_t count = 0;
+};
+
+struct StatisticsTotals {
+    TransferCounts upload, download;
+    Clock::time_point time;
+};
+
+// Accumulates the transfers reported by the progress notifiers for a single
+// SyncSession. The sync client reports the cumulative number of transferred
+// bytes, so each direction tracks the last value it saw to derive the size of
+// each transfer.
+class SessionStatistics {
+public:
+    SessionStatistics() : _start(Clock::now()) { }
+
+    void record(SyncSession::NotifierType direction, uint64_t transferred) {
+        std::lock_guard lock(_mutex);
+        auto& last = direction == SyncSession::NotifierType::upload ? _lastUploaded : _lastDownloaded;
+        auto& counts = direction == SyncSession::NotifierType::upload ? _upload : _download;
+        // The first notification reports the state at registration rather
+        // than a transfer, and a decrease means the counter was reset
+        if (last && transferred > *last) {
+            counts.bytes += transferred - *last;
+            ++counts.count;
+        }
+        last = transferred;
+    }
+
+    StatisticsTotals totals() {
+        std::lock_guard lock(_mutex);
+        return {_upload, _download, Clock::now()};
+    }
+
+    Clock::time_point start() const { return _start; }
+
+private:
+    std::mutex _mutex;
+    const Clock::time_point _start;
+    TransferCounts _upload, _download;
+    std::optional<uint64_t> _lastUploaded, _lastDownloaded;
+};
+
+struct TrackedSession {
+    std::weak_ptr<SyncSession> session;
+    std::shared_ptr<SessionStatistics> statistics;
+};
+
+// Keyed by the SyncSession's path so that all RLMSyncSession objects wrapping
+// the same session share a single set of progress notifiers
+std::mutex& s_trackedSessionsMutex = *new std::mutex;
+auto& s_trackedSessions = *new std::unordered_map<std::string, TrackedSession>;
+
+std::shared_ptr<SessionStatistics> statisticsForSession(std::shared_ptr<SyncSession> const& session) {
+    std::lock_guard lock(s_trackedSessionsMutex);
+    auto& tracked = s_trackedSessions[session->path()];
+    if (tracked.statistics && tracked.session.lock() == session) {
+        return tracked.statistics;
+    }
+
+    tracked.session = session;
+    tracked.statistics = std::make_shared<SessionStatistics>();
+    for (auto direction : {SyncSession::NotifierType::upload, SyncSession::NotifierType::download}) {
+        // The notifiers are unregistered when the session is destroyed, so
+        // the tokens do not need to be stored
+        session->register_progress_notifier([direction, statistics = tracked.statistics](uint64_t transferred, uint64_t) {
+            statistics->record(direction, transferred);
+        }, direction, true);
+    }
+    return tracked.statistics;
+}
+} // anonymous namespace
+
+@interface RLMSyncSessionStatistics ()
+@property (nonatomic, readwrite) double uploadBytesPerSecond;
+@property (nonatomic, readwrite) double downloadBytesPerSecond;
+@property (nonatomic, readwrite) double uploadsPerSecond;
+@property (nonatomic, readwrite) double downloadsPerSecond;
+@end
+
+@implementation RLMSyncSessionStatistics
+
+- (instancetype)initWithDuration:(NSTimeInterval)duration
+                          upload:(TransferCounts)upload
+                        download:(TransferCounts)download {
+    if (self = [super init]) {
+        _duration = duration;
+        _uploadedBytes = (NSUInteger)upload.bytes;
+        _downloadedBytes = (NSUInteger)download.bytes;
+        _uploadCount = (NSUInteger)upload.count;
+        _downloadCount = (NSUInteger)download.count;
+        if (duration > 0) {
+            _uploadBytesPerSecond = upload.bytes / duration;
+            _downloadBytesPerSecond = download.bytes / duration;
+            _uploadsPerSecond = upload.count / duration;
+            _downloadsPerSecond = download.count / duration;
+        }
+        _averageUploadSize = upload.count ? double(upload.bytes) / upload.count : 0;
+        _averageDownloadSize = download.count ? double(download.bytes) / download.count : 0;
+    }
+    return self;
+}
+
+- (instancetype)initWithStart:(Clock::time_point)start
+                       totals:(StatisticsTotals const&)totals
+                     previous:(StatisticsTotals const&)previous {
+    std::chrono::duration<double> duration = totals.time - start;
+    return [self initWithDuration:duration.count()
+                           upload:TransferCounts{totals.upload.bytes - previous.upload.bytes,
+                                                 totals.upload.count - previous.upload.count}
+                         download:TransferCounts{totals.download.bytes - previous.download.bytes,
+                                                 totals.download.count - previous.download.count}];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:
+            @"<RLMSyncSessionStatistics: %p> {\n"
+            "\tduration = %f;\n"
+            "\tuploadedBytes = %zu;\n"
+            "\tdownloadedBytes = %zu;\n"
+            "\tuploadCount = %zu;\n"
+            "\tdownloadCount = %zu;\n"
+            "}",
+            (__bridge void *)self, _duration, (size_t)_uploadedBytes, (size_t)_downloadedBytes,
+            (size_t)_uploadCount, (size_t)_downloadCount];
+}
+
+@end
+
+#pragma mark - Priority
+
+namespace {
+struct SessionPriority {
+    std::weak_ptr<SyncSession> session;
+    NSInteger priority = 0;
+    // Set when the priority is set, and cleared once the session has
+    // downloaded everything which was on the server at that point
+    bool downloading = false;
+    // Whether the session was suspended because a session with a higher
+    // priority was downloading, and so should be resumed by us
+    bool suspendedForPriority = false;
+    uint64_t generation = 0;
+};
+
+// Keyed by the SyncSession's path, like the tracked statistics
+std::mutex& s_sessionPrioritiesMutex = *new std::mutex;
+auto& s_sessionPriorities = *new std::unordered_map<std::string, SessionPriority>;
+
+SessionPriority& priorityForSession(std::shared_ptr<SyncSession> const& session) {
+    auto& entry = s_sessionPriorities[session->path()];
+    if (entry.session.lock() != session) {
+        entry = SessionPriority{session};
+    }
+    return entry;
+}
+
+// Suspend each of the user's sessions which has a lower priority than the
+// highest priority session which is still downloading, and resume the ones
+// which we previously suspended and which no longer have a lower priority
+void rescheduleSessions(std::shared_ptr<SyncUser> const& user) {
+    std::vector<std::shared_ptr<SyncSession>> suspend, resume;
+    {
+        std::lock_guard lock(s_sessionPrioritiesMutex);
+        auto sessions = user->all_sessions();
+        std::optional<NSInteger> highest;
+        for (auto& session : sessions) {
+            auto& entry = priorityForSession(session);
+            // Sessions which are suspended can't finish downloading, so
+            // they don't hold up lower priority ones
+            bool active = session->state() != SyncSession::PublicState::Inactive;
+            if (entry.downloading && active && (!highest || entry.priority > *highest)) {
+                highest = entry.priority;
+            }
+        }
+        for (auto& session : sessions) {
+            auto& entry = priorityForSession(session);
+            bool shouldSuspend = highest && entry.priority < *highest;
+            if (shouldSuspend && !entry.suspendedForPriority && session->state() != SyncSession::PublicState::Inactive) {
+                entry.suspendedForPriority = true;
+                suspend.push_back(session);
+            }
+            else if (!shouldSuspend && entry.suspendedForPriority) {
+                entry.suspendedForPriority = false;
+                resume.push_back(session);
+            }
+        }
+    }
+    // Done outside of the lock as these can synchronously call back into us
+    for (auto& session : suspend) {
+        session->log_out();
+    }
+    for (auto& session : resume) {
+        session->revive_if_needed();
+    }
+}
+
+void setSessionPriority(std::shared_ptr<SyncSession> const& session, NSInteger priority) {
+    uint64_t generation;
+    {
+        std::lock_guard lock(s_sessionPrioritiesMutex);
+        auto& entry = priorityForSession(session);
+        entry.priority = priority;
+        entry.downloading = true;
+        generation = ++entry.generation;
+    }
+    rescheduleSessions(session->user());
+
+    std::weak_ptr<SyncSession> weakSession = session;
+    session->wait_for_download_completion([weakSession, generation](std::error_code) {
+        auto session = weakSession.lock();
+        if (!session) {
+            return;
+        }
+        {
+            std::lock_guard lock(s_sessionPrioritiesMutex);
+            auto& entry = priorityForSession(session);
+            // A newer priority is waiting for its own download completion
+            if (entry.generation != generation) {
+                return;
+            }
+            entry.downloading = false;
+        }
+        rescheduleSessions(session->user());
+    });
+}
+} // anonymous namespace
+
+RLMSyncSessionStatistics *RLMCombinedSessionStatistics(std::vector<std::shared_ptr<SyncSession>> const& sessions) {
+    // Rates are summed per session rather than derived from the combined
+    // totals as each session may have been tracked for a different duration
+    NSTimeInterval duration = 0;
+    TransferCounts upload, download;
+    double uploadBytesPerSecond = 0, downloadBytesPerSecond = 0, uploadsPerSecond = 0, downloadsPerSecond = 0;
+    for (auto& session : sessions) {
+        auto statistics = statisticsForSession(session);
+        auto snapshot = [[RLMSyncSessionStatistics alloc] initWithStart:statistics->start()
+                                                                 totals:statistics->totals()
+                                                               previous:StatisticsTotals{}];
+        duration = std::max(duration, snapshot.duration);
+        upload.bytes += snapshot.uploadedBytes;
+        upload.count += snapshot.uploadCount;
+        download.bytes += snapshot.downloadedBytes;
+        download.count += snapshot.downloadCount;
+        uploadBytesPerSecond += snapshot.uploadBytesPerSecond;
+        downloadBytesPerSecond += snapshot.downloadBytesPerSecond;
+        uploadsPerSecond += snapshot.uploadsPerSecond;
+        downloadsPerSecond += snapshot.downloadsPerSecond;
+    }
+
+    auto combined = [[RLMSyncSessionStatistics alloc] initWithDuration:duration upload:upload download:download];
+    combined.uploadBytesPerSecond = uploadBytesPerSecond;
+    combined.downloadBytesPerSecond = downloadBytesPerSecond;
+    combined.uploadsPerSecond = uploadsPerSecond;
+    combined.downloadsPerSecond = downloadsPerSecond;
+    return combined;
+}
+
+@interface RLMSyncStatisticsNotificationToken : RLMNotificationToken
+@end
+
+@implementation RLMSyncStatisticsNotificationToken {
+    dispatch_source_t _timer;
+}
+
+- (instancetype)initWithTimer:(dispatch_source_t)timer {
+    if (self = [super init]) {
+        _timer = timer;
+    }
+    return self;
+}
+
+- (void)suppressNextNotification {
+    // No-op, but implemented in case this token is passed to
+    // `-[RLMRealm commitWriteTransactionWithoutNotifying:]`.
+}
+
+- (void)invalidate {
+    @synchronized (self) {
+        if (_timer) {
+            dispatch_source_cancel(_timer);
+            _timer = nil;
+        }
+    }
+}
+
+@end
+
+#pragma mark - Aggregated progress
+
+namespace {
+struct Progress {
+    uint64_t transferred = 0;
+    uint64_t transferrable = 0;
+
+    bool operator==(Progress const& other) const {
+        return transferred == other.transferred && transferrable == other.transferrable;
+    }
+};
+
+// The most recent progress reported by each of a user's sessions, keyed by
+// path. Sessions which have been closed keep their final progress so that the
+// combined progress doesn't go backwards.
+class AggregatedProgress {
+public:
+    void update(std::string const& path, uint64_t transferred, uint64_t transferrable) {
+        std::lock_guard lock(_mutex);
+        _progress[path] = {transferred, transferrable};
+    }
+
+    Progress total() {
+        std::lock_guard lock(_mutex);
+        Progress total;
+        for (auto& [path, progress] : _progress) {
+            total.transferred += progress.transferred;
+            total.transferrable += progress.transferrable;
+        }
+        return total;
+    }
+
+private:
+    std::mutex _mutex;
+    std::unordered_map<std::string, Progress> _progress;
+};
+
+// Only accessed on the progress notifications queue
+struct AggregatedProgressState {
+    std::weak_ptr<SyncUser> user;
+    SyncSession::NotifierType direction;
+    std::shared_ptr<AggregatedProgress> progress = std::make_shared<AggregatedProgress>();
+    std::vector<std::pair<std::weak_ptr<SyncSession>, uint64_t>> notifiers;
+    std::optional<Progress> lastDelivered;
+
+    // Begin tracking any sessions which have been opened since the last check
+    void registerNewSessions() {
+        auto user = this->user.lock();
+        if (!user) {
+            return;
+        }
+        notifiers.erase(std::remove_if(notifiers.begin(), notifiers.end(), [](auto& notifier) {
+            return notifier.first.expired();
+        }), notifiers.end());
+        for (auto& session : user->all_sessions()) {
+            bool registered = std::any_of(notifiers.begin(), notifiers.end(), [&](auto& notifier) {
+                return notifier.first.lock() == session;
+            });
+            if (registered) {
+                continue;
+            }
+            auto token = session->register_progress_notifier([progress = progress, path = session->path()](uint64_t transferred, uint64_t transferrable) {
+                progress->update(path, transferred, transferrable);
+            }, direction, true);
+            notifiers.emplace_back(session, token);
+        }
+    }
+
+    void unregister() {
+        for (auto& [weakSession, token] : notifiers) {
+            if (auto session = weakSession.lock()) {
+                session->unregister_progress_notifier(token);
+            }
+        }
+        notifiers.clear();
+    }
+};
+} // anonymous namespace
+
+@interface RLMAggregatedProgressNotificationToken : RLMNotificationToken
+@end
+
+@implementation RLMAggregatedProgressNotificationToken {
+    dispatch_source_t _timer;
+    std::shared_ptr<AggregatedProgressState> _state;
+}
+
+- (instancetype)initWithTimer:(dispatch_source_t)timer state:(std::shared_ptr<AggregatedProgressState>)state {
+    if (self = [super init]) {
+        _timer = timer;
+        _state = std::move(state);
+    }
+    return self;
+}
+
+- (void)suppressNextNotification {
+    // No-op, but implemented in case this token is passed to
+    // `-[RLMRealm commitWriteTransactionWithoutNotifying:]`.
+}
+
+- (void)invalidate {
+    @synchronized (self) {
+        if (_timer) {
+            dispatch_source_cancel(_timer);
+            _timer = nil;
+            auto state = std::move(_state);
+            dispatch_async(RLMSyncSession.notificationsQueue, ^{
+                state->unregister();
+            });
+        }
+    }
+}
+
+@end
+
+RLMNotificationToken *RLMAddAggregatedProgressNotification(std::shared_ptr<SyncUser> const& user,
+                                                           RLMSyncProgressDirection direction,
+                                                           NSTimeInterval interval,
+                                                           RLMProgressNotificationBlock block) {
+    if (interval <= 0) {
+        @throw RLMException(@"Progress notification interval must be greater than zero, but was %f.", interval);
+    }
+
+    auto state = std::make_shared<AggregatedProgressState>();
+    state->user = user;
+    state->direction = direction == RLMSyncProgressDirectionUpload ? SyncSession::NotifierType::upload
+                                                                   : SyncSession::NotifierType::download;
+    dispatch_queue_t queue = RLMSyncSession.notificationsQueue;
+    dispatch_async(queue, ^{
+        state->registerNewSessions();
+    });
+
+    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, queue);
+    auto nanoseconds = static_cast<int64_t>(interval * NSEC_PER_SEC);
+    dispatch_source_set_timer(timer, dispatch_time(DISPATCH_TIME_NOW, nanoseconds), nanoseconds, nanoseconds / 10);
+    dispatch_source_set_event_handler(timer, ^{
+        state->registerNewSessions();
+        auto total = state->progress->total();
+        if (state->lastDelivered == total) {
+            return;
+        }
+        state->lastDelivered = total;
+        block((NSUInteger)total.transferred, (NSUInteger)total.transferrable);
+    });
+    dispatch_resume(timer);
+    return [[RLMAggregatedProgressNotificationToken alloc] initWithTimer:timer state:state];
+}
+
 @interface RLMSyncErrorActionToken () {
 @public
     std::string _originalPath;
@@ -82,12 +533,44 @@ using namespace realm;
 
 @end
 
+@interface RLMSyncConnectionStateNotificationToken : RLMNotificationToken
+@end
+
+@implementation RLMSyncConnectionStateNotificationToken {
+    uint64_t _token;
+    std::weak_ptr<SyncSession> _session;
+}
+
+- (instancetype)initWithTokenValue:(uint64_t)token session:(std::shared_ptr<SyncSession>)session {
+    if (self = [super init]) {
+        _token = token;
+        _session = session;
+    }
+    return self;
+}
+
+- (void)suppressNextNotification {
+    // No-op, but implemented in case this token is passed to
+    // `-[RLMRealm commitWriteTransactionWithoutNotifying:]`.
+}
+
+- (void)invalidate {
+    if (auto session = _session.lock()) {
+        session->unregister_connection_change_callback(_token);
+        _session.reset();
+    }
+}
+
+@end
+
 @interface RLMSyncSession ()
 @property (class, nonatomic, readonly) dispatch_queue_t notificationsQueue;
 @property (atomic, readwrite) RLMSyncConnectionState connectionState;
 @end
 
-@implementation RLMSyncSession
+@implementation RLMSyncSession {
+    std::shared_ptr<SessionStatistics> _statistics;
+}
 
 + (dispatch_queue_t)notificationsQueue {
     static dispatch_queue_t queue;
@@ -109,6 +592,7 @@ static RLMSyncConnectionState convertConnectionState(SyncSession::ConnectionStat
 - (instancetype)initWithSyncSession:(std::shared_ptr<SyncSession> const&)session {
     if (self = [super init]) {
         _session = session;
+        _statistics = statisticsForSession(session);
         _connectionState = convertConnectionState(session->connection_state());
         // No need to save the token as RLMSyncSession always outlives the
         // underlying SyncSession
@@ -160,13 +644,23 @@ static RLMSyncConnectionState convertConnectionState(SyncSession::ConnectionStat
 
 - (void)suspend {
     if (auto session = _session.lock()) {
+        {
+            // The app suspending the session takes precedence over it having
+            // been suspended for priority, so it isn't resumed by us
+            std::lock_guard lock(s_sessionPrioritiesMutex);
+            priorityForSession(session).suspendedForPriority = false;
+        }
         session->log_out();
+        // A suspended session no longer holds up lower priority ones
+        rescheduleSessions(session->user());
     }
 }
 
 - (void)resume {
     if (auto session = _session.lock()) {
         session->revive_if_needed();
+        // A resumed session which is downloading holds up lower priority ones
+        rescheduleSessions(session->user());
     }
 }
 
@@ -217,6 +711,69 @@ static RLMSyncConnectionState convertConnectionState(SyncSession::ConnectionStat
     return nil;
 }
 
+- (RLMNotificationToken *)addConnectionStateChangeNotificationBlock:(RLMSyncConnectionStateChangeBlock)block {
+    auto session = _session.lock();
+    if (!session) {
+        return nil;
+    }
+
+    dispatch_queue_t queue = RLMSyncSession.notificationsQueue;
+    auto lastChange = std::make_shared<Clock::time_point>(Clock::now());
+    uint64_t token = session->register_connection_change_callback([=](auto oldState, auto newState) {
+        // Measure when the change happened rather than when it is delivered
+        auto now = Clock::now();
+        dispatch_async(queue, ^{
+            std::chrono::duration<double> timeInPreviousState = now - *lastChange;
+            *lastChange = now;
+            block(convertConnectionState(oldState), convertConnectionState(newState), timeInPreviousState.count());
+        });
+    });
+    return [[RLMSyncConnectionStateNotificationToken alloc] initWithTokenValue:token session:std::move(session)];
+}
+
+- (RLMSyncSessionStatistics *)statistics {
+    return [[RLMSyncSessionStatistics alloc] initWithStart:_statistics->start()
+                                                    totals:_statistics->totals()
+                                                  previous:StatisticsTotals{}];
+}
+
+- (RLMNotificationToken *)addStatisticsNotificationWithInterval:(NSTimeInterval)interval
+                                                          block:(void (^)(RLMSyncSessionStatistics *))block {
+    if (interval <= 0) {
+        @throw RLMException(@"Statistics notification interval must be greater than zero, but was %f.", interval);
+    }
+
+    auto statistics = _statistics;
+    auto previous = std::make_shared<StatisticsTotals>(statistics->totals());
+    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0,
+                                                     RLMSyncSession.notificationsQueue);
+    auto nanoseconds = static_cast<int64_t>(interval * NSEC_PER_SEC);
+    dispatch_source_set_timer(timer, dispatch_time(DISPATCH_TIME_NOW, nanoseconds), nanoseconds, nanoseconds / 10);
+    dispatch_source_set_event_handler(timer, ^{
+        auto totals = statistics->totals();
+        @autoreleasepool {
+            block([[RLMSyncSessionStatistics alloc] initWithStart:previous->time totals:totals previous:*previous]);
+        }
+        *previous = totals;
+    });
+    dispatch_resume(timer);
+    return [[RLMSyncStatisticsNotificationToken alloc] initWithTimer:timer];
+}
+
+- (NSInteger)priority {
+    if (auto session = _session.lock()) {
+        std::lock_guard lock(s_sessionPrioritiesMutex);
+        return priorityForSession(session).priority;
+    }
+    return 0;
+}
+
+- (void)setPriority:(NSInteger)priority {
+    if (auto session = _session.lock()) {
+        setSessionPriority(session, priority);
+    }
+}
+
 + (void)immediatelyHandleError:(RLMSyncErrorActionToken *)token syncManager:(RLMSyncManager *)syncManager {
     if (!token->_isValid) {
         return;
@@ -310,6 +867,17 @@ static RLMSyncConnectionState convertConnectionState(SyncSession::ConnectionStat
             _blocks = nil;
         }
     }
+    // The completion handler is not called for cancelled tasks, so free up
+    // the task's slot for the next queued open here
+    RLMAsyncOpenTaskDidFinish(self);
+}
+
++ (NSUInteger)maximumConcurrentOpens {
+    return RLMGetMaximumConcurrentAsyncOpens();
+}
+
++ (void)setMaximumConcurrentOpens:(NSUInteger)maximumConcurrentOpens {
+    RLMSetMaximumConcurrentAsyncOpens(maximumConcurrentOpens);
 }
 
 - (void)setTask:(std::shared_ptr<realm::AsyncOpenTask>)task {
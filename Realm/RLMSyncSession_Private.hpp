@@ -20,10 +20,12 @@
 
 #import "RLMSyncUtil_Private.h"
 #import <memory>
+#import <vector>
 
 namespace realm {
 class AsyncOpenTask;
 class SyncSession;
+class SyncUser;
 }
 
 NS_ASSUME_NONNULL_BEGIN
@@ -53,4 +55,15 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic) std::shared_ptr<realm::AsyncOpenTask> task;
 @end
 
+// Combine the statistics for the given sessions, beginning to collect them for
+// any sessions which were not already tracked
+RLMSyncSessionStatistics *RLMCombinedSessionStatistics(std::vector<std::shared_ptr<realm::SyncSession>> const& sessions);
+
+// Periodically report the summed progress of all of the user's sessions,
+// including ones which are opened after the notification is added
+RLMNotificationToken *RLMAddAggregatedProgressNotification(std::shared_ptr<realm::SyncUser> const& user,
+                                                           RLMSyncProgressDirection direction,
+                                                           NSTimeInterval interval,
+                                                           RLMProgressNotificationBlock block);
+
 NS_ASSUME_NONNULL_END
@@ -18,7 +18,7 @@
 
 #import <Foundation/Foundation.h>
 
-@class RLMRealm;
+@class RLMObjectBase, RLMRealm;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -103,4 +103,74 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+/**
+ A thread-safe reference to a group of managed objects, intended for handing
+ over many objects at once.
+
+ Rather than wrapping each object individually, a batch records the key of each
+ object along with the version of the Realm they were read at. Resolving the
+ batch with `-[RLMRealm resolveThreadSafeReferenceBatch:]` refreshes the target
+ Realm at most once and then looks up each object in turn.
+
+ Unlike `RLMThreadSafeReference`, a batch does not pin the source version of the
+ Realm and may be resolved any number of times.
+
+ @see `-[RLMRealm resolveThreadSafeReferenceBatch:]`
+ */
+@interface RLMThreadSafeReferenceBatch : NSObject
+
+/**
+ Create a thread-safe reference to each of the given managed objects.
+
+ @param objects The objects to create a reference to. All of the objects must be
+                managed by the same Realm.
+ */
++ (instancetype)batchWithObjects:(id<NSFastEnumeration>)objects;
+
+/// The number of objects in the batch.
+@property (nonatomic, readonly) NSUInteger count;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMThreadSafeReferenceBatch cannot be created directly")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMThreadSafeReferenceBatch cannot be created directly")));
+
+@end
+
+/**
+ A lightweight reference to a managed object which can be passed between threads.
+
+ An `RLMObjectReference` stores only the class name of the object and its
+ primary key, or the object's key if it has no primary key. It does not pin the
+ source version of the Realm, which makes it much cheaper than an
+ `RLMThreadSafeReference` when handing over many objects in turn.
+
+ Resolving the reference with `-[RLMRealm resolveObjectReference:]` looks the
+ object up again in the target Realm, and returns `nil` if it has been deleted.
+ References to objects with a primary key can also be resolved in other Realm
+ files with a matching schema.
+ */
+@interface RLMObjectReference : NSObject
+
+/**
+ Create a reference to a managed object.
+
+ @param object The managed object to create a reference to.
+ */
++ (instancetype)referenceWithObject:(RLMObjectBase *)object;
+
+/// The name of the referenced object's class.
+@property (nonatomic, readonly) NSString *objectClassName;
+
+/// The primary key of the referenced object, or `nil` if the object's type has
+/// no primary key or its primary key is `nil`.
+@property (nonatomic, readonly, nullable) id primaryKey;
+
+/// :nodoc:
+- (instancetype)init __attribute__((unavailable("RLMObjectReference cannot be created directly")));
+/// :nodoc:
++ (instancetype)new __attribute__((unavailable("RLMObjectReference cannot be created directly")));
+
+@end
+
 NS_ASSUME_NONNULL_END
@@ -17,8 +17,15 @@
 ////////////////////////////////////////////////////////////////////////////
 
 #import "RLMThreadSafeReference_Private.hpp"
+
+#import "RLMClassInfo.hpp"
+#import "RLMObjectBase_Private.h"
+#import "RLMObjectStore.h"
+#import "RLMRealm_Private.hpp"
 #import "RLMUtil.hpp"
 
+#import <realm/object-store/shared_realm.hpp>
+
 @implementation RLMThreadSafeReference {
     realm::ThreadSafeReference _reference;
     id _metadata;
@@ -67,3 +74,167 @@
 }
 
 @end
+
+static RLMRealm *RLMHandoverSourceRealm(RLMObjectBase *object) {
+    if (!object->_realm) {
+        @throw RLMException(@"Cannot construct reference to unmanaged object, "
+                            "which can be passed across threads directly");
+    }
+    if (object.invalidated) {
+        @throw RLMException(@"Cannot construct reference to invalidated object");
+    }
+    RLMRealm *realm = object->_realm;
+    [realm verifyThread];
+    if (realm.inWriteTransaction) {
+        @throw RLMException(@"Cannot obtain thread safe reference during a write transaction.");
+    }
+    return realm;
+}
+
+// Prepare the target Realm for looking up objects which were read at `version`
+// of the Realm file at `path`, refreshing it if it is behind. Objects identified
+// by their primary key can also be looked up in other files.
+static void RLMPrepareHandoverTarget(RLMRealm *realm, std::string const& path, uint64_t version,
+                                     bool allowOtherFiles=false) {
+    [realm verifyThread];
+    if (realm.inWriteTransaction) {
+        @throw RLMException(@"Cannot resolve thread safe reference during a write transaction.");
+    }
+    if (realm->_realm->config().path != path) {
+        if (allowOtherFiles) {
+            return;
+        }
+        @throw RLMException(@"Cannot resolve thread safe reference in a different Realm file.");
+    }
+    if (!realm.frozen && realm->_realm->read_transaction_version().version < version) {
+        [realm refresh];
+    }
+}
+
+@implementation RLMThreadSafeReferenceBatch {
+    std::string _path;
+    uint64_t _version;
+    std::vector<std::pair<realm::TableKey, realm::ObjKey>> _keys;
+}
+
++ (instancetype)batchWithObjects:(id<NSFastEnumeration>)objects {
+    return [[self alloc] initWithObjects:objects];
+}
+
+- (instancetype)initWithObjects:(id<NSFastEnumeration>)objects {
+    if (!(self = [super init])) {
+        return nil;
+    }
+
+    RLMRealm *realm;
+    for (id obj in objects) {
+        if (![obj isKindOfClass:RLMObjectBase.class]) {
+            @throw RLMException(@"Cannot construct reference batch containing object of type '%@'. Only RLMObjects can be batched.",
+                                [obj class]);
+        }
+        RLMObjectBase *object = obj;
+        if (!realm) {
+            realm = RLMHandoverSourceRealm(object);
+        }
+        else if (object.invalidated || realm != object->_realm) {
+            RLMHandoverSourceRealm(object);
+            @throw RLMException(@"All objects in a reference batch must belong to the same Realm.");
+        }
+        _keys.emplace_back(object->_row.get_table()->get_key(), object->_row.get_key());
+    }
+
+    if (realm) {
+        _path = realm->_realm->config().path;
+        _version = realm->_realm->read_transaction_version().version;
+    }
+    return self;
+}
+
+- (NSUInteger)count {
+    return _keys.size();
+}
+
+- (NSArray *)resolveInRealm:(RLMRealm *)realm {
+    if (_keys.empty()) {
+        return @[];
+    }
+    // Advance at most once for the entire batch rather than once per object
+    RLMPrepareHandoverTarget(realm, _path, _version);
+
+    NSMutableArray *objects = [NSMutableArray arrayWithCapacity:_keys.size()];
+    RLMTranslateError([&] {
+        auto& group = realm.group;
+        realm::TableKey tableKey;
+        RLMClassInfo *info = nullptr;
+        realm::TableRef table;
+        for (auto& [key, objKey] : _keys) {
+            if (!info || key != tableKey) {
+                tableKey = key;
+                info = realm->_info[key];
+                table = group.get_table(key);
+            }
+            // Objects which were deleted after the batch was created are skipped
+            if (info && table->is_valid(objKey)) {
+                [objects addObject:RLMCreateObjectAccessor(*info, objKey.value)];
+            }
+        }
+    });
+    return objects;
+}
+
+@end
+
+@implementation RLMObjectReference {
+    std::string _path;
+    uint64_t _version;
+    realm::TableKey _tableKey;
+    realm::ObjKey _objKey;
+    id _primaryKey;
+    bool _hasPrimaryKey;
+}
+
++ (instancetype)referenceWithObject:(RLMObjectBase *)object {
+    return [[self alloc] initWithObject:object];
+}
+
+- (instancetype)initWithObject:(RLMObjectBase *)object {
+    if (!(self = [super init])) {
+        return nil;
+    }
+
+    RLMRealm *realm = RLMHandoverSourceRealm(object);
+    _objectClassName = object->_info->rlmObjectSchema.className;
+    _path = realm->_realm->config().path;
+    _version = realm->_realm->read_transaction_version().version;
+    if (RLMProperty *pk = object->_info->rlmObjectSchema.primaryKeyProperty) {
+        // Objects with a primary key are looked up by it, which also works in
+        // other Realm files with a matching schema
+        _hasPrimaryKey = true;
+        _primaryKey = RLMCoerceToNil([object valueForKey:pk.name]);
+    }
+    else {
+        _tableKey = object->_row.get_table()->get_key();
+        _objKey = object->_row.get_key();
+    }
+    return self;
+}
+
+- (id)primaryKey {
+    return _primaryKey;
+}
+
+- (nullable RLMObjectBase *)resolveInRealm:(RLMRealm *)realm {
+    RLMPrepareHandoverTarget(realm, _path, _version, _hasPrimaryKey);
+    if (_hasPrimaryKey) {
+        return RLMGetObject(realm, _objectClassName, _primaryKey);
+    }
+    return RLMTranslateError([&]() -> RLMObjectBase * {
+        RLMClassInfo *info = realm->_info[_tableKey];
+        if (!info || !info->table()->is_valid(_objKey)) {
+            return nil;
+        }
+        return RLMCreateObjectAccessor(*info, _objKey.value);
+    });
+}
+
+@end
@@ -42,4 +42,16 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+@interface RLMThreadSafeReferenceBatch ()
+
+- (NSArray *)resolveInRealm:(RLMRealm *)realm;
+
+@end
+
+@interface RLMObjectReference ()
+
+- (nullable RLMObjectBase *)resolveInRealm:(RLMRealm *)realm;
+
+@end
+
 NS_ASSUME_NONNULL_END
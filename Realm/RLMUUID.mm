@@ -28,7 +28,10 @@
 }
 
 - (realm::UUID)rlm_uuidValue {
-    return realm::UUID(self.UUIDString.UTF8String);
+    realm::UUID::UUIDBytes bytes;
+    static_assert(sizeof(bytes) == sizeof(uuid_t));
+    [self getUUIDBytes:bytes.data()];
+    return realm::UUID(bytes);
 }
 
 @end
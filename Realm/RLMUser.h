@@ -20,6 +20,7 @@
 
 #import <Realm/RLMCredentials.h>
 #import <Realm/RLMRealmConfiguration.h>
+#import <Realm/RLMSyncSession.h>
 
 @class RLMUser, RLMSyncSession, RLMRealm, RLMUserIdentity, RLMAPIKeyAuth, RLMMongoClient, RLMMongoDatabase, RLMMongoCollection;
 @protocol RLMBSON;
@@ -118,6 +119,26 @@ NS_ASSUME_NONNULL_BEGIN
 /// Retrieve all the valid sessions belonging to this user.
 @property (nonatomic, readonly) NSArray<RLMSyncSession *> *allSessions;
 
+/**
+ Register a block which is called with the combined progress of all of this
+ user's sessions, no more often than once per `interval` seconds.
+
+ The block is passed the sum of the transferred and transferrable bytes most
+ recently reported by each of the user's sessions, including sessions which
+ are opened after the block is registered, and is only called when the
+ combined progress has changed since the previous call. It is invoked on the
+ side queue devoted to progress notifications.
+
+ @param direction Whether the progress of uploads or downloads should be reported.
+ @param interval  The minimum number of seconds between each invocation of the block.
+ @param block     The block to invoke with the combined progress.
+
+ @return A token which must be held for as long as you want notifications to be delivered.
+ */
+- (RLMNotificationToken *)addProgressNotificationForDirection:(RLMSyncProgressDirection)direction
+                                                     interval:(NSTimeInterval)interval
+                                                        block:(RLMProgressNotificationBlock)block;
+
 #pragma mark - Custom Data
 
 /**
@@ -23,7 +23,9 @@
 #import "RLMBSON_Private.hpp"
 #import "RLMCredentials_Private.hpp"
 #import "RLMMongoClient_Private.hpp"
+#import "RLMObjectId.h"
 #import "RLMRealmConfiguration+Sync.h"
+#import "RLMRealmConfiguration_Private.hpp"
 #import "RLMSyncConfiguration_Private.hpp"
 #import "RLMSyncSession_Private.hpp"
 
@@ -32,10 +34,22 @@
 #import <realm/object-store/sync/sync_user.hpp>
 #import <realm/object-store/util/bson/bson.hpp>
 
+#import <mutex>
+#import <unordered_map>
+
 using namespace realm;
 
 @interface RLMUser () {
     std::shared_ptr<SyncUser> _user;
+
+    // Opening a synchronized Realm looks up the configuration and on-disk
+    // path for its partition each time, so both are cached per partition
+    // value. Configurations are cached only for partition values which can
+    // be used as dictionary keys without ambiguity (NSNumber is excluded as
+    // @1, @1.0 and @YES compare equal but are different partition values).
+    std::mutex _partitionCacheMutex;
+    NSMutableDictionary<id, RLMRealmConfiguration *> *_configurations;
+    std::unordered_map<std::string, std::pair<std::string, std::string>> _partitionPaths;
 }
 @end
 
@@ -80,13 +94,46 @@ using namespace realm;
     return _user == ((RLMUser *)object)->_user;
 }
 
+static id RLMPartitionCacheKey(id<RLMBSON> partitionValue) {
+    if (!partitionValue || [(id)partitionValue isKindOfClass:[NSNull class]]) {
+        return NSNull.null;
+    }
+    if ([(id)partitionValue isKindOfClass:[NSString class]]
+        || [(id)partitionValue isKindOfClass:[RLMObjectId class]]
+        || [(id)partitionValue isKindOfClass:[NSUUID class]]) {
+        return partitionValue;
+    }
+    return nil;
+}
+
 - (RLMRealmConfiguration *)configurationWithPartitionValue:(nullable id<RLMBSON>)partitionValue {
+    id key = RLMPartitionCacheKey(partitionValue);
+    RLMRealmConfiguration *cached;
+    if (key) {
+        std::lock_guard lock(_partitionCacheMutex);
+        cached = _configurations[key];
+    }
+    if (cached) {
+        RLMRealmConfiguration *config = [cached copy];
+        // Which of the current and legacy paths exists may have changed
+        // since the configuration was cached, so the path is re-resolved
+        config.config.path = [self pathForPartitionValue:config.config.sync_config->partition_value];
+        return config;
+    }
+
     auto syncConfig = [[RLMSyncConfiguration alloc] initWithUser:self
                                                   partitionValue:partitionValue
                                                    customFileURL:nil
                                                       stopPolicy:RLMSyncStopPolicyAfterChangesUploaded];
     RLMRealmConfiguration *config = [[RLMRealmConfiguration alloc] init];
     config.syncConfiguration = syncConfig;
+    if (key) {
+        std::lock_guard lock(_partitionCacheMutex);
+        if (!_configurations) {
+            _configurations = [NSMutableDictionary new];
+        }
+        _configurations[key] = [config copy];
+    }
     return config;
 }
 
@@ -106,6 +153,9 @@ using namespace realm;
         return;
     }
     _user = nullptr;
+    std::lock_guard lock(_partitionCacheMutex);
+    _configurations = nil;
+    _partitionPaths.clear();
 }
 
 - (std::string)pathForPartitionValue:(std::string const&)partitionValue {
@@ -113,17 +163,30 @@ using namespace realm;
         return "";
     }
 
-    auto path = _user->sync_manager()->path_for_realm(*_user, partitionValue);
+    std::string path, legacyPath;
+    {
+        std::lock_guard lock(_partitionCacheMutex);
+        if (auto it = _partitionPaths.find(partitionValue); it != _partitionPaths.end()) {
+            std::tie(path, legacyPath) = it->second;
+        }
+    }
+    if (path.empty()) {
+        path = _user->sync_manager()->path_for_realm(*_user, partitionValue);
+
+        // Previous versions converted the partition value to a path *twice*,
+        // so if the file resulting from that exists open it instead
+        NSString *encodedPartitionValue = [@(partitionValue.data())
+                                           stringByAddingPercentEncodingWithAllowedCharacters:[NSCharacterSet URLPathAllowedCharacterSet]];
+        NSString *overEncodedRealmName = [[NSString alloc] initWithFormat:@"%@/%@", self.identifier, encodedPartitionValue];
+        legacyPath = _user->sync_manager()->path_for_realm(*_user, overEncodedRealmName.UTF8String);
+
+        std::lock_guard lock(_partitionCacheMutex);
+        _partitionPaths.emplace(partitionValue, std::make_pair(path, legacyPath));
+    }
+
     if ([NSFileManager.defaultManager fileExistsAtPath:@(path.c_str())]) {
         return path;
     }
-
-    // Previous versions converted the partition value to a path *twice*,
-    // so if the file resulting from that exists open it instead
-    NSString *encodedPartitionValue = [@(partitionValue.data())
-                                       stringByAddingPercentEncodingWithAllowedCharacters:[NSCharacterSet URLPathAllowedCharacterSet]];
-    NSString *overEncodedRealmName = [[NSString alloc] initWithFormat:@"%@/%@", self.identifier, encodedPartitionValue];
-    auto legacyPath = _user->sync_manager()->path_for_realm(*_user, overEncodedRealmName.UTF8String);
     if ([NSFileManager.defaultManager fileExistsAtPath:@(legacyPath.c_str())]) {
         return legacyPath;
     }
@@ -138,10 +201,17 @@ using namespace realm;
 
     std::stringstream s;
     s << RLMConvertRLMBSONToBson(partitionValue);
-    auto path = [self pathForPartitionValue:s.str()];
+    auto partition = s.str();
+    auto path = [self pathForPartitionValue:partition];
     if (auto session = _user->session_for_on_disk_path(path)) {
         return [[RLMSyncSession alloc] initWithSyncSession:session];
     }
+    // The Realm may have been stored in a custom directory
+    for (auto& session : _user->all_sessions()) {
+        if (session->config().partition_value == partition) {
+            return [[RLMSyncSession alloc] initWithSyncSession:session];
+        }
+    }
     return nil;
 }
 
@@ -157,6 +227,12 @@ using namespace realm;
     return [buffer copy];
 }
 
+- (RLMNotificationToken *)addProgressNotificationForDirection:(RLMSyncProgressDirection)direction
+                                                     interval:(NSTimeInterval)interval
+                                                        block:(RLMProgressNotificationBlock)block {
+    return RLMAddAggregatedProgressNotification(_user, direction, interval, block);
+}
+
 - (NSString *)identifier {
     if (!_user) {
         return @"";
@@ -243,16 +319,17 @@ using namespace realm;
         args.push_back(RLMConvertRLMBSONToBson(argument));
     }
 
-    _app._realmApp->call_function(_user,
-                        std::string(name.UTF8String),
-                        args, [completionBlock](util::Optional<app::AppError> error,
-                                                util::Optional<bson::Bson> response) {
+    [_app callFunctionNamed:name.UTF8String
+                  arguments:std::move(args)
+                       user:_user
+                 completion:[completionBlock](util::Optional<app::AppError> error,
+                                              util::Optional<bson::Bson> response) {
         if (error) {
             return completionBlock(nil, RLMAppErrorToNSError(*error));
         }
 
         completionBlock(RLMConvertBsonToRLMBSON(*response), nil);
-    });
+    }];
 }
 
 - (void)handleResponse:(realm::util::Optional<realm::app::AppError>)error
@@ -286,11 +363,15 @@ using namespace realm;
 }
 
 - (NSDictionary *)customData {
-    if (!_user || !_user->custom_data()) {
+    if (!_user) {
         return @{};
     }
+    if (_app) {
+        return [_app customDataForUser:*_user];
+    }
 
-    return (NSDictionary *)RLMConvertBsonToRLMBSON(*_user->custom_data());
+    auto customData = _user->custom_data();
+    return customData ? (NSDictionary *)RLMConvertBsonToRLMBSON(*customData) : @{};
 }
 
 - (std::shared_ptr<SyncUser>)_syncUser {
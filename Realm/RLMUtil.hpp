@@ -21,6 +21,7 @@
 #import <Realm/RLMValue.h>
 
 #import <objc/runtime.h>
+#import <os/signpost.h>
 
 #import <realm/array.hpp>
 #import <realm/binary_data.hpp>
@@ -51,6 +52,48 @@ NSError *RLMMakeError(std::system_error const& exception);
 
 void RLMSetErrorOrThrow(NSError *error, NSError **outError);
 
+// The log which os_signpost intervals around potentially slow operations are
+// emitted to, or nil if they're disabled. Signposts are enabled by setting the
+// REALM_ENABLE_SIGNPOSTS environment variable before launching the process.
+os_log_t RLMSignpostLog() API_AVAILABLE(macos(10.14), ios(12.0), tvos(12.0), watchos(5.0));
+
+// Ends an os_signpost interval begun by RLM_SIGNPOST_INTERVAL() when the
+// scope it was declared in exits
+class RLMSignpostInterval {
+public:
+    os_signpost_id_t id = OS_SIGNPOST_ID_NULL;
+
+    void begin(os_log_t log, void (^end)(os_log_t, os_signpost_id_t))
+    API_AVAILABLE(macos(10.14), ios(12.0), tvos(12.0), watchos(5.0)) {
+        _log = log;
+        _end = end;
+        id = os_signpost_id_generate(log);
+    }
+
+    ~RLMSignpostInterval() {
+        if (_end) {
+            _end(_log, id);
+        }
+    }
+
+private:
+    os_log_t _log;
+    void (^_end)(os_log_t, os_signpost_id_t);
+};
+
+// Emit an os_signpost interval covering the rest of the current scope if
+// signposts are enabled. `name` must be a string literal.
+#define RLM_SIGNPOST_INTERVAL(name) \
+    RLMSignpostInterval rlmSignpostInterval; \
+    if (@available(macOS 10.14, iOS 12.0, tvOS 12.0, watchOS 5.0, *)) { \
+        if (os_log_t rlmSignpostLog = RLMSignpostLog()) { \
+            rlmSignpostInterval.begin(rlmSignpostLog, ^(os_log_t log, os_signpost_id_t id) { \
+                os_signpost_interval_end(log, id, name); \
+            }); \
+            os_signpost_interval_begin(rlmSignpostLog, rlmSignpostInterval.id, name); \
+        } \
+    }
+
 // returns if the object can be inserted as the given type
 BOOL RLMIsObjectValidForProperty(id obj, RLMProperty *prop);
 // throw an exception if the object is not a valid value for the property
@@ -174,6 +217,20 @@ static inline realm::Timestamp RLMTimestampForNSDate(__unsafe_unretained NSDate
     return {seconds, nanoseconds};
 }
 
+// Nanoseconds since the Unix epoch, saturating for timestamps which can't be
+// represented (more than ~292 years from 1970). Null is INT64_MIN.
+static inline int64_t RLMTimestampToNanoseconds(realm::Timestamp ts) {
+    constexpr int64_t nanosecondsPerSecond = 1'000'000'000;
+    constexpr int64_t maxSeconds = std::numeric_limits<int64_t>::max() / nanosecondsPerSecond - 1;
+    if (ts.is_null())
+        return std::numeric_limits<int64_t>::min();
+    if (ts.get_seconds() > maxSeconds)
+        return std::numeric_limits<int64_t>::max();
+    if (ts.get_seconds() < -maxSeconds)
+        return std::numeric_limits<int64_t>::min() + 1;
+    return ts.get_seconds() * nanosecondsPerSecond + ts.get_nanoseconds();
+}
+
 static inline NSUInteger RLMConvertNotFound(size_t index) {
     return index == realm::not_found ? NSNotFound : index;
 }
@@ -206,6 +263,11 @@ id RLMMixedToObjc(realm::Mixed const& value,
 realm::Decimal128 RLMObjcToDecimal128(id value);
 realm::UUID RLMObjcToUUID(__unsafe_unretained id const value);
 
+// Parse the string representations of object ids and UUIDs without creating a
+// C string copy of the input. Return false if the string is not valid.
+bool RLMParseObjectId(__unsafe_unretained NSString *const string, realm::ObjectId& out);
+bool RLMParseUUID(__unsafe_unretained NSString *const string, realm::UUID& out);
+
 // Given a bundle identifier, return the base directory on the disk within which Realm database and support files should
 // be stored.
 NSString *RLMDefaultDirectoryForBundleIdentifier(NSString *bundleIdentifier);
@@ -40,6 +40,10 @@
 #import <realm/table_view.hpp>
 #import <realm/util/overload.hpp>
 
+#import <algorithm>
+#import <array>
+#import <atomic>
+
 #if REALM_ENABLE_SYNC
 #import "RLMSyncUtil.h"
 #import <realm/sync/client.hpp>
@@ -99,6 +103,54 @@ bool RLMIsSwiftObjectClass(Class cls) {
         || [cls isSubclassOfClass:RealmSwiftEmbeddedObject.class];
 }
 
+namespace {
+// How a value of a given class is converted to a Mixed
+enum class MixedClassTag : uintptr_t {
+    none,
+    string,
+    number,
+    value,
+    bridged,
+};
+
+// Checking whether a class conforms to RLMValue walks its entire class
+// hierarchy, which is slow enough to be noticeable when reading or writing
+// large numbers of RLMValue properties or collections. The result can only
+// change if the class does, so it is cached in a small direct-mapped table
+// keyed on the class pointer, with the tag stored in the low bits of each slot.
+// Collisions simply overwrite the old entry, so the table never needs a lock.
+MixedClassTag mixedClassTag(__unsafe_unretained id const value) {
+    static constexpr uintptr_t tagMask = 7;
+    static std::atomic<uintptr_t> s_cache[64];
+
+    Class cls = object_getClass(value);
+    auto bits = reinterpret_cast<uintptr_t>(cls);
+    auto& slot = s_cache[(bits >> 4) % 64];
+    uintptr_t entry = slot.load(std::memory_order_relaxed);
+    if ((entry & ~tagMask) == bits) {
+        return static_cast<MixedClassTag>(entry & tagMask);
+    }
+
+    MixedClassTag tag;
+    if ([cls isSubclassOfClass:NSString.class]) {
+        tag = MixedClassTag::string;
+    }
+    else if ([cls isSubclassOfClass:NSNumber.class]) {
+        tag = MixedClassTag::number;
+    }
+    else if ([cls conformsToProtocol:@protocol(RLMValue)]) {
+        tag = MixedClassTag::value;
+    }
+    else {
+        tag = MixedClassTag::bridged;
+    }
+    if ((bits & tagMask) == 0) {
+        slot.store(bits | static_cast<uintptr_t>(tag), std::memory_order_relaxed);
+    }
+    return tag;
+}
+} // anonymous namespace
+
 static BOOL validateValue(__unsafe_unretained id const value,
                           RLMPropertyType type,
                           bool optional,
@@ -162,7 +214,7 @@ static BOOL validateValue(__unsafe_unretained id const value,
             return [value isKindOfClass:[NSData class]];
         case RLMPropertyTypeAny: {
             return !value
-                || [value conformsToProtocol:@protocol(RLMValue)];
+                || mixedClassTag(value) != MixedClassTag::bridged;
         }
         case RLMPropertyTypeLinkingObjects:
             return YES;
@@ -394,6 +446,11 @@ NSError *RLMMakeError(std::system_error const& exception) {
                                       @"Category": category}];
 }
 
+os_log_t RLMSignpostLog() {
+    static os_log_t log = getenv("REALM_ENABLE_SIGNPOSTS") ? os_log_create("io.realm", "Realm") : nil;
+    return log;
+}
+
 void RLMSetErrorOrThrow(NSError *error, NSError **outError) {
     if (outError) {
         *outError = error;
@@ -436,8 +493,28 @@ realm::Mixed RLMObjcToMixed(__unsafe_unretained id const value,
     if (!value || value == NSNull.null) {
         return realm::Mixed();
     }
+    // Strings and numbers are by far the most common values, so convert them
+    // directly rather than going through the generic unboxing below
+    auto tag = mixedClassTag(value);
+    if (tag == MixedClassTag::string) {
+        return realm::Mixed(RLMStringDataWithNSString(value));
+    }
+    if (tag == MixedClassTag::number) {
+        NSNumber *number = value;
+        switch ([number rlm_valueType]) {
+            case RLMPropertyTypeBool:
+                return realm::Mixed(static_cast<bool>(number.boolValue));
+            case RLMPropertyTypeInt:
+                return realm::Mixed(static_cast<int64_t>(number.longLongValue));
+            case RLMPropertyTypeFloat:
+                return realm::Mixed(number.floatValue);
+            default:
+                return realm::Mixed(number.doubleValue);
+        }
+    }
+
     id v;
-    if ([value conformsToProtocol:@protocol(RLMValue)]) {
+    if (tag == MixedClassTag::value) {
         v = value;
     }
     else {
@@ -506,12 +583,92 @@ id RLMMixedToObjc(realm::Mixed const& mixed,
     }
 }
 
+namespace {
+// Value of each ASCII hex digit, or -1 for characters which aren't one
+constexpr auto hexDigitValues = [] {
+    std::array<int8_t, 128> values{};
+    for (auto& v : values) {
+        v = -1;
+    }
+    for (int i = 0; i < 10; ++i) {
+        values['0' + i] = i;
+    }
+    for (int i = 0; i < 6; ++i) {
+        values['a' + i] = values['A' + i] = 10 + i;
+    }
+    return values;
+}();
+
+// Decode pairs of hex digits from `chars` into `out`, skipping the characters
+// at the positions in `separators`, which must be '-'.
+template<size_t N>
+bool decodeHex(const UniChar *chars, size_t length, std::array<uint8_t, N>& out,
+               std::initializer_list<size_t> separators = {}) {
+    size_t pos = 0;
+    auto nextNibble = [&]() -> int {
+        while (std::find(separators.begin(), separators.end(), pos) != separators.end()) {
+            if (chars[pos++] != '-') {
+                return -1;
+            }
+        }
+        UniChar c = chars[pos++];
+        return c < hexDigitValues.size() ? hexDigitValues[c] : -1;
+    };
+    if (length != N * 2 + separators.size()) {
+        return false;
+    }
+    for (auto& byte : out) {
+        int high = nextNibble();
+        int low = nextNibble();
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        byte = static_cast<uint8_t>(high << 4 | low);
+    }
+    return true;
+}
+} // anonymous namespace
+
+bool RLMParseObjectId(__unsafe_unretained NSString *const string, realm::ObjectId& out) {
+    UniChar chars[24];
+    CFIndex length = CFStringGetLength((__bridge CFStringRef)string);
+    if (length != 24) {
+        return false;
+    }
+    CFStringGetCharacters((__bridge CFStringRef)string, CFRangeMake(0, length), chars);
+    realm::ObjectId::ObjectIdBytes bytes;
+    if (!decodeHex(chars, length, bytes)) {
+        return false;
+    }
+    out = realm::ObjectId(bytes);
+    return true;
+}
+
+bool RLMParseUUID(__unsafe_unretained NSString *const string, realm::UUID& out) {
+    UniChar chars[36];
+    CFIndex length = CFStringGetLength((__bridge CFStringRef)string);
+    if (length != 36) {
+        return false;
+    }
+    CFStringGetCharacters((__bridge CFStringRef)string, CFRangeMake(0, length), chars);
+    realm::UUID::UUIDBytes bytes;
+    if (!decodeHex(chars, length, bytes, {8, 13, 18, 23})) {
+        return false;
+    }
+    out = realm::UUID(bytes);
+    return true;
+}
+
 realm::UUID RLMObjcToUUID(__unsafe_unretained id const value) {
     try {
         if (auto uuid = RLMDynamicCast<NSUUID>(value)) {
             return uuid.rlm_uuidValue;
         }
         if (auto string = RLMDynamicCast<NSString>(value)) {
+            realm::UUID uuid;
+            if (RLMParseUUID(string, uuid)) {
+                return uuid;
+            }
             return realm::UUID(string.UTF8String);
         }
     }
@@ -522,6 +679,53 @@ realm::UUID RLMObjcToUUID(__unsafe_unretained id const value) {
     @throw RLMException(@"Cannot convert value '%@' of type '%@' to uuid", value, [value class]);
 }
 
+// Convert an NSDecimal by formatting its mantissa and exponent directly, as
+// -[NSDecimalNumber stringValue] is much slower and locale-aware
+static realm::Decimal128 decimal128FromNSDecimal(NSDecimal decimal) {
+    // Produce the same representation as parsing -stringValue would: trailing
+    // zeros after the decimal point are dropped, so strip trailing zeros from
+    // the mantissa, but integral values are written out in full, so any
+    // positive exponent is then turned back into trailing zeros below
+    NSDecimalCompact(&decimal);
+    if (decimal._length == 0) {
+        return realm::Decimal128(decimal._isNegative ? "NaN" : "0");
+    }
+
+    // The mantissa is a little-endian 128-bit integer stored in 16-bit words
+    // which is converted to decimal digits by repeated division by 10
+    uint16_t words[8];
+    std::copy(std::begin(decimal._mantissa), std::end(decimal._mantissa), words);
+    char digits[48];
+    char *end = std::end(digits), *p = end;
+    size_t length = decimal._length;
+    *--p = '\0';
+    while (length) {
+        uint32_t remainder = 0;
+        for (size_t i = length; i-- > 0;) {
+            uint32_t value = remainder << 16 | words[i];
+            words[i] = static_cast<uint16_t>(value / 10);
+            remainder = value % 10;
+        }
+        *--p = static_cast<char>('0' + remainder);
+        while (length && words[length - 1] == 0) {
+            --length;
+        }
+    }
+
+    std::string str;
+    if (decimal._isNegative) {
+        str += '-';
+    }
+    str += p;
+    if (decimal._exponent > 0) {
+        str.append(decimal._exponent, '0');
+    }
+    else if (decimal._exponent < 0) {
+        str += "E" + std::to_string(decimal._exponent);
+    }
+    return realm::Decimal128(str.c_str());
+}
+
 realm::Decimal128 RLMObjcToDecimal128(__unsafe_unretained id const value) {
     try {
         if (!value || value == NSNull.null) {
@@ -534,7 +738,7 @@ realm::Decimal128 RLMObjcToDecimal128(__unsafe_unretained id const value) {
             return realm::Decimal128(string.UTF8String);
         }
         if (auto decimal = RLMDynamicCast<NSDecimalNumber>(value)) {
-            return realm::Decimal128(decimal.stringValue.UTF8String);
+            return decimal128FromNSDecimal(decimal.decimalValue);
         }
         if (auto number = RLMDynamicCast<NSNumber>(value)) {
             auto type = number.objCType[0];
@@ -128,6 +128,7 @@ static BOOL encryptTests() {
     deleteOrThrow(fileURL);
     deleteOrThrow([fileURL URLByAppendingPathExtension:@"lock"]);
     deleteOrThrow([fileURL URLByAppendingPathExtension:@"note"]);
+    deleteOrThrow([fileURL URLByAppendingPathExtension:@"blobs"]);
 }
 
 - (BOOL)encryptTests {
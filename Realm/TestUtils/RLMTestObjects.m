@@ -30,6 +30,12 @@
 @implementation IntObject
 @end
 
+@implementation IntAndStringObject
++ (NSArray *)requiredProperties {
+    return @[@"stringCol"];
+}
+@end
+
 @implementation AllIntSizesObject
 @end
 
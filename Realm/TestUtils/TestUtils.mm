@@ -22,6 +22,7 @@
 #import <Realm/Realm.h>
 #import <Realm/RLMSchema_Private.h>
 
+#import "RLMBSON_Private.hpp"
 #import "RLMRealmUtil.hpp"
 #import "RLMSyncConfiguration_Private.hpp"
 #import "RLMSyncManager_Private.hpp"
@@ -33,6 +34,11 @@
 #import <realm/util/base64.hpp>
 
 #import <Availability.h>
+#import <malloc/malloc.h>
+
+#import <algorithm>
+#import <numeric>
+#import <vector>
 
 static void recordFailure(XCTestCase *self, NSString *message, NSString *fileName, NSUInteger lineNumber) {
 #ifndef __MAC_10_16
@@ -189,6 +195,10 @@ static std::string fakeJWT() {
     return encoded_prefix + "." + encoded_body + "." + suffix;
 }
 
+id RLMBSONFromExtendedJSON(NSString *json) {
+    return RLMConvertBsonToRLMBSON(realm::bson::parse(json.UTF8String));
+}
+
 RLMUser *RLMDummyUser() {
     // Add a fake user to the metadata Realm
     @autoreleasepool {
@@ -212,6 +222,185 @@ RLMUser *RLMDummyUser() {
     return app.allUsers.allValues.firstObject;
 }
 
+static NSDictionary<NSString *, NSString *> *benchmarkEnvironment() {
+    return NSProcessInfo.processInfo.environment;
+}
+
+static double benchmarkThreshold(NSString *name) {
+    NSString *value = benchmarkEnvironment()[name];
+    return value ? value.doubleValue : 0.1;
+}
+
+// The results from the baseline file, keyed by operation. Sets `error` if the
+// file couldn't be read; lines which aren't valid results are skipped.
+static NSDictionary<NSString *, NSDictionary *> *benchmarkBaseline(NSError **error) {
+    static NSDictionary *baseline;
+    static NSError *readError;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSMutableDictionary *results = [NSMutableDictionary new];
+        if (NSString *path = benchmarkEnvironment()[@"REALM_BENCHMARK_BASELINE"]) {
+            NSError *err;
+            NSString *contents = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:&err];
+            readError = err;
+            for (NSString *line in [contents componentsSeparatedByCharactersInSet:NSCharacterSet.newlineCharacterSet]) {
+                NSData *data = [line dataUsingEncoding:NSUTF8StringEncoding];
+                NSDictionary *result = line.length ? [NSJSONSerialization JSONObjectWithData:data options:0 error:nil] : nil;
+                if ([result isKindOfClass:[NSDictionary class]] && result[@"operation"]) {
+                    results[result[@"operation"]] = result;
+                }
+            }
+        }
+        baseline = results;
+    });
+    if (error) {
+        *error = readError;
+    }
+    return baseline;
+}
+
+static uint64_t benchmarkNanosecondsNow() {
+    return clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+}
+
+@implementation RLMBenchmark {
+    __weak XCTestCase *_testCase;
+    NSString *_operation;
+    std::vector<uint64_t> _samples;
+    uint64_t _start;
+    bool _measuring;
+    malloc_statistics_t _startStatistics;
+    int64_t _blocks;
+    int64_t _bytes;
+}
+
++ (BOOL)isEnabled {
+    return benchmarkEnvironment()[@"REALM_BENCHMARK_OUTPUT"] != nil;
+}
+
+- (instancetype)initWithTestCase:(XCTestCase *)testCase {
+    if ((self = [super init])) {
+        _testCase = testCase;
+        _operation = [NSString stringWithFormat:@"%@.%@", NSStringFromClass(testCase.class),
+                      NSStringFromSelector(testCase.invocation.selector)];
+    }
+    return self;
+}
+
+- (void)measureBlock:(__attribute__((noescape)) void (^)(void))block
+    automaticallyStartMeasuring:(BOOL)automaticallyStartMeasuring {
+    NSInteger iterations = [benchmarkEnvironment()[@"REALM_BENCHMARK_ITERATIONS"] integerValue] ?: 10;
+    for (NSInteger i = 0; i < iterations; ++i) {
+        @autoreleasepool {
+            if (automaticallyStartMeasuring) {
+                [self startMeasuring];
+            }
+            block();
+            if (_measuring) {
+                [self stopMeasuring];
+            }
+        }
+    }
+    if (_samples.empty()) {
+        recordFailure(_testCase, @"Benchmark never called startMeasuring", @(__FILE__), __LINE__);
+        return;
+    }
+    [self report];
+}
+
+- (void)startMeasuring {
+    malloc_zone_statistics(nullptr, &_startStatistics);
+    _measuring = true;
+    _start = benchmarkNanosecondsNow();
+}
+
+- (void)stopMeasuring {
+    uint64_t end = benchmarkNanosecondsNow();
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(nullptr, &statistics);
+    _samples.push_back(end - _start);
+    _blocks += (int64_t)statistics.blocks_in_use - (int64_t)_startStatistics.blocks_in_use;
+    _bytes += (int64_t)statistics.size_in_use - (int64_t)_startStatistics.size_in_use;
+    _measuring = false;
+}
+
+- (void)report {
+    std::sort(_samples.begin(), _samples.end());
+    size_t count = _samples.size();
+    double mean = std::accumulate(_samples.begin(), _samples.end(), 0.0) / count / 1e9;
+    NSMutableDictionary *result = [@{
+        @"operation": _operation,
+        @"iterations": @(count),
+        @"mean": @(mean),
+        @"p50": @(_samples[count / 2] / 1e9),
+        @"p99": @(_samples[std::min(count - 1, count * 99 / 100)] / 1e9),
+        @"allocations": @((double)_blocks / count),
+        @"bytes": @((double)_bytes / count),
+        @"timestamp": @(NSDate.date.timeIntervalSince1970),
+    } mutableCopy];
+
+    NSError *error;
+    NSDictionary *baselines = benchmarkBaseline(&error);
+    if (error) {
+        recordFailure(_testCase, [NSString stringWithFormat:@"Failed to read benchmark baseline: %@", error],
+                      @(__FILE__), __LINE__);
+    }
+    if (NSDictionary *baseline = baselines[_operation]) {
+        double baselineMean = [baseline[@"mean"] doubleValue];
+        double baselineAllocations = [baseline[@"allocations"] doubleValue];
+        result[@"baselineMean"] = @(baselineMean);
+        result[@"baselineAllocations"] = @(baselineAllocations);
+        double timeThreshold = benchmarkThreshold(@"REALM_BENCHMARK_THRESHOLD");
+        if (baselineMean > 0 && mean > baselineMean * (1 + timeThreshold)) {
+            recordFailure(_testCase, [NSString stringWithFormat:@"%@ took %.6fs, which is %.1f%% slower than the baseline of %.6fs",
+                                      _operation, mean, (mean / baselineMean - 1) * 100, baselineMean],
+                          @(__FILE__), __LINE__);
+        }
+        double allocations = [result[@"allocations"] doubleValue];
+        double allocationThreshold = benchmarkThreshold(@"REALM_BENCHMARK_ALLOCATION_THRESHOLD");
+        if (baselineAllocations > 0 && allocations > baselineAllocations * (1 + allocationThreshold)) {
+            recordFailure(_testCase, [NSString stringWithFormat:@"%@ left %.1f allocations per iteration, up from %.1f in the baseline",
+                                      _operation, allocations, baselineAllocations],
+                          @(__FILE__), __LINE__);
+        }
+    }
+
+    NSData *json = [NSJSONSerialization dataWithJSONObject:result options:NSJSONWritingSortedKeys error:&error];
+    if (!json) {
+        recordFailure(_testCase, [NSString stringWithFormat:@"Failed to serialize benchmark result for %@: %@",
+                                  _operation, error], @(__FILE__), __LINE__);
+        return;
+    }
+    NSString *line = [[NSString alloc] initWithData:json encoding:NSUTF8StringEncoding];
+    NSLog(@"BENCHMARK %@", line);
+
+    NSString *path = benchmarkEnvironment()[@"REALM_BENCHMARK_OUTPUT"];
+    if (![NSFileManager.defaultManager fileExistsAtPath:path]
+        && ![NSFileManager.defaultManager createFileAtPath:path contents:nil attributes:nil]) {
+        recordFailure(_testCase, [NSString stringWithFormat:@"Failed to create benchmark output file at %@", path],
+                      @(__FILE__), __LINE__);
+        return;
+    }
+    NSFileHandle *handle = [NSFileHandle fileHandleForWritingAtPath:path];
+    if (!handle) {
+        recordFailure(_testCase, [NSString stringWithFormat:@"Failed to open benchmark output file at %@", path],
+                      @(__FILE__), __LINE__);
+        return;
+    }
+    @try {
+        [handle seekToEndOfFile];
+        [handle writeData:[[line stringByAppendingString:@"\n"] dataUsingEncoding:NSUTF8StringEncoding]];
+    }
+    @catch (NSException *e) {
+        recordFailure(_testCase, [NSString stringWithFormat:@"Failed to write benchmark output to %@: %@", path, e.reason],
+                      @(__FILE__), __LINE__);
+    }
+    @finally {
+        [handle closeFile];
+    }
+}
+@end
+
 // Xcode 13 adds -[NSUUID compare:] so this warns about the category
 // implementing a method which already exists, but we can't use just the
 // built-in one yet.
@@ -43,6 +43,15 @@
 
 @end
 
+@interface IntAndStringObject : RLMObject
+
+@property int intCol;
+@property NSNumber<RLMInt> *optIntCol;
+@property NSString *stringCol;
+@property NSString *optStringCol;
+
+@end
+
 @interface AllIntSizesObject : RLMObject
 // int8_t not supported due to being ambiguous with BOOL
 
@@ -32,6 +32,35 @@ FOUNDATION_EXTERN void RLMAssertThrowsWithReasonMatchingSwift(XCTestCase *self,
 // for tests which don't actually need to talk to the server
 FOUNDATION_EXTERN RLMUser *RLMDummyUser(void);
 
+// Decode a MongoDB extended JSON string to RLMBSON the same way the results of
+// remote MongoDB calls are decoded
+FOUNDATION_EXTERN id RLMBSONFromExtendedJSON(NSString *json);
+
+// Runs a performance test's measured block in place of XCTest's measurement
+// when benchmark runner mode is enabled, which is done by setting
+// `REALM_BENCHMARK_OUTPUT` to the path of a file to write results to. Each
+// result is appended to it as a line of JSON containing the operation, the
+// number of iterations, the mean, p50 and p99 time in seconds, and the
+// average number of allocations and bytes left allocated by each iteration.
+// Results are also logged with the prefix `BENCHMARK`.
+//
+// If `REALM_BENCHMARK_BASELINE` is set to the path of the output from an
+// earlier run, each result is compared to the result for the same operation
+// there, and the test fails if the mean time or allocations have grown by more
+// than `REALM_BENCHMARK_THRESHOLD` or `REALM_BENCHMARK_ALLOCATION_THRESHOLD`
+// (fractions of the baseline, defaulting to 0.1). The number of iterations can
+// be set with `REALM_BENCHMARK_ITERATIONS` (default 10).
+@interface RLMBenchmark : NSObject
+@property (class, nonatomic, readonly, getter=isEnabled) BOOL enabled;
+
+- (instancetype)initWithTestCase:(XCTestCase *)testCase;
+- (void)measureBlock:(__attribute__((noescape)) void (^)(void))block
+    automaticallyStartMeasuring:(BOOL)automaticallyStartMeasuring
+    NS_SWIFT_NAME(measure(_:automaticallyStartMeasuring:));
+- (void)startMeasuring;
+- (void)stopMeasuring;
+@end
+
 @interface NSUUID (RLMUUIDCompareTests)
 - (NSComparisonResult)compare:(NSUUID *)other;
 @end
@@ -370,6 +370,47 @@
     [realm cancelWriteTransaction];
 }
 
+- (void)testGetPrimitiveValues {
+    __block AllPrimitiveArrays *obj = [[AllPrimitiveArrays alloc] init];
+    [obj.intObj addObjects:@[@1, @2, @3]];
+    [obj.doubleObj addObjects:@[@1.5, @2.5]];
+    [obj.dateObj addObjects:@[[NSDate dateWithTimeIntervalSince1970:1.5], [NSDate dateWithTimeIntervalSince1970:-2]]];
+
+    void (^check)(void) = ^{
+        int64_t ints[3] = {0};
+        [obj.intObj getInt64Values:ints range:NSMakeRange(0, 3)];
+        XCTAssertEqual(ints[0], 1);
+        XCTAssertEqual(ints[1], 2);
+        XCTAssertEqual(ints[2], 3);
+        [obj.intObj getInt64Values:ints range:NSMakeRange(2, 1)];
+        XCTAssertEqual(ints[0], 3);
+
+        double doubles[2] = {0};
+        [obj.doubleObj getDoubleValues:doubles range:NSMakeRange(0, 2)];
+        XCTAssertEqual(doubles[0], 1.5);
+        XCTAssertEqual(doubles[1], 2.5);
+
+        RLMAssertThrowsWithReason([obj.intObj getInt64Values:ints range:NSMakeRange(2, 2)],
+                                  @"Range {2, 2} is out of bounds (must be within 3).");
+        RLMAssertThrowsWithReason([obj.intObj getDoubleValues:doubles range:NSMakeRange(0, 1)],
+                                  @"Cannot read double values from an array of type 'int'.");
+        RLMAssertThrowsWithReason([obj.stringObj getInt64Values:ints range:NSMakeRange(0, 0)],
+                                  @"Cannot read int values from an array of type 'string'.");
+
+        int64_t timestamps[2] = {0};
+        [obj.dateObj getTimestampValues:timestamps range:NSMakeRange(0, 2)];
+        XCTAssertEqual(timestamps[0], 1500000000);
+        XCTAssertEqual(timestamps[1], -2000000000);
+    };
+    check();
+
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    [realm beginWriteTransaction];
+    obj = [AllPrimitiveArrays createInRealm:realm withValue:obj];
+    check();
+    [realm cancelWriteTransaction];
+}
+
 - (void)testReplaceObjectAtIndexInUnmanagedArray {
     ArrayPropertyObject *array = [[ArrayPropertyObject alloc] init];
     array.name = @"name";
@@ -508,6 +549,53 @@
     [realm commitWriteTransaction];
 }
 
+- (void)testApplyPermutation {
+    void (^test)(RLMArray *) = ^(RLMArray *array) {
+        NSArray *(^names)(void) = ^{
+            return [array valueForKey:@"stringCol"];
+        };
+        [array applyPermutation:@[@2, @0, @3, @1]];
+        XCTAssertEqualObjects(names(), (@[@"c", @"a", @"d", @"b"]));
+
+        [array applyPermutation:@[@0, @1, @2, @3]];
+        XCTAssertEqualObjects(names(), (@[@"c", @"a", @"d", @"b"]));
+
+        [array applyPermutation:@[@1, @3, @0, @2]];
+        XCTAssertEqualObjects(names(), (@[@"a", @"b", @"c", @"d"]));
+
+        RLMAssertThrowsWithReasonMatching([array applyPermutation:@[@0, @1, @2]], @"contains 3 indexes");
+        RLMAssertThrowsWithReasonMatching([array applyPermutation:@[@0, @1, @1, @2]], @"exactly once");
+        RLMAssertThrowsWithReasonMatching([array applyPermutation:@[@0, @1, @2, @4]], @"less than 4");
+        RLMAssertThrowsWithReasonMatching([array applyPermutation:@[@0, @1, @2, @-1]], @"exactly once");
+        XCTAssertEqualObjects(names(), (@[@"a", @"b", @"c", @"d"]));
+    };
+
+    ArrayPropertyObject *array = [[ArrayPropertyObject alloc] initWithValue:@[@"foo", @[@[@"a"], @[@"b"], @[@"c"], @[@"d"]], @[]]];
+    test(array.array);
+
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    [realm beginWriteTransaction];
+    [realm addObject:array];
+    test(array.array);
+    [realm commitWriteTransaction];
+
+    RLMAssertThrowsWithReasonMatching([array.array applyPermutation:@[@1, @0, @2, @3]], @"write transaction");
+}
+
+- (void)testAddObjectsValidatesAllObjectsFirst {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    [realm beginWriteTransaction];
+    ArrayPropertyObject *array = [ArrayPropertyObject createInRealm:realm withValue:@[@"foo", @[@[@"a"]], @[]]];
+    StringObject *valid = [[StringObject alloc] initWithValue:@[@"b"]];
+    IntObject *invalid = [[IntObject alloc] initWithValue:@[@1]];
+    RLMAssertThrowsWithReasonMatching([array.array addObjects:@[valid, invalid]], @"does not match");
+    XCTAssertEqual(1U, array.array.count);
+
+    [array.array addObjects:[StringObject allObjectsInRealm:realm]];
+    XCTAssertEqualObjects([array.array valueForKey:@"stringCol"], (@[@"a", @"a"]));
+    [realm cancelWriteTransaction];
+}
+
 - (void)testIndexOfObject
 {
     RLMRealm *realm = [RLMRealm defaultRealm];
@@ -74,6 +74,35 @@ static const NSUInteger count = 1000;
     XCTAssertGreaterThan(fileSizeBefore, fileSizeAfter);
 }
 
+- (void)testAsyncCompact {
+    RLMRealmConfiguration *configuration = [RLMRealmConfiguration defaultConfiguration];
+    configuration.fileURL = RLMTestRealmURL();
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"compacted"];
+    [RLMRealm asyncCompactWithConfiguration:configuration callbackQueue:dispatch_get_main_queue()
+                                   callback:^(BOOL compacted, NSError *error) {
+        XCTAssertTrue(compacted);
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    XCTAssertGreaterThan(_expectedTotalBytesBefore, [self fileSize:configuration.fileURL]);
+    RLMRealm *realm = [RLMRealm realmWithConfiguration:configuration error:nil];
+    XCTAssertEqual([[StringObject allObjectsInRealm:realm] count], count + 2);
+
+    // The file can't be compacted while it's open on another thread
+    expectation = [self expectationWithDescription:@"not compacted"];
+    [RLMRealm asyncCompactWithConfiguration:configuration callbackQueue:dispatch_get_main_queue()
+                                   callback:^(BOOL compacted, NSError *error) {
+        XCTAssertFalse(compacted);
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+    XCTAssertEqual([[StringObject allObjectsInRealm:realm] count], count + 2);
+}
+
 - (void)testSuccessfulCompactOnLaunch {
     // Configure the Realm to compact on launch
     RLMRealmConfiguration *configuration = [RLMRealmConfiguration defaultConfiguration];
@@ -58,6 +58,42 @@
     XCTAssertEqual(n1.decimalValue._reserved, d1.decimalValue._reserved);
 }
 
+- (void)testDecimal128FromDecimalNumber {
+    NSArray<NSString *> *strings = @[@"0", @"1", @"-1", @"123.456", @"-0.000001", @"1.5",
+                                     @"12345678901234567890123456789012", @"0.1234567890123456789",
+                                     @"1e100", @"-9.87e-50", @"100", @"-1500", @"1.50", @"150.00",
+                                     @"1234500000000000000000000000000000000000", @"1.5e30"];
+    for (NSString *string in strings) {
+        NSDecimalNumber *number = [NSDecimalNumber decimalNumberWithString:string];
+        RLMDecimal128 *fromNumber = [[RLMDecimal128 alloc] initWithNumber:number];
+        RLMDecimal128 *fromString = [[RLMDecimal128 alloc] initWithString:number.stringValue error:nil];
+        XCTAssertEqualObjects(fromNumber, fromString, @"%@", string);
+        XCTAssertEqualObjects(fromNumber.stringValue, fromString.stringValue, @"%@", string);
+    }
+
+    XCTAssertTrue([[RLMDecimal128 alloc] initWithNumber:NSDecimalNumber.notANumber].isNaN);
+}
+
+- (void)testDecimal128FromDecimalNumberRoundTrips {
+    // Values with trailing zeros in the integral part are stored with a
+    // positive exponent by NSDecimal, but are written out in full by
+    // -stringValue, and so by Decimal128
+    NSDictionary<NSString *, NSString *> *expected = @{
+        @"100": @"100",
+        @"1.5e3": @"1500",
+        @"-2e5": @"-200000",
+        @"1.50": @"1.5",
+        @"120.0": @"120",
+        @"1.5e30": @"1500000000000000000000000000000",
+    };
+    for (NSString *string in expected) {
+        NSDecimalNumber *number = [NSDecimalNumber decimalNumberWithString:string];
+        RLMDecimal128 *decimal = [[RLMDecimal128 alloc] initWithNumber:number];
+        XCTAssertEqualObjects(decimal.stringValue, expected[string], @"%@", string);
+        XCTAssertEqualObjects([NSDecimalNumber decimalNumberWithDecimal:decimal.decimalValue], number, @"%@", string);
+    }
+}
+
 #pragma mark - Arithmetic
 
 - (void)testDecimal128Addition {
@@ -1211,6 +1211,50 @@
     [(RLMNotificationToken *)token invalidate];
 }
 
+- (void)testSetDictionaryOnlyReportsChangedKeys {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    DictionaryPropertyObject *obj = [DictionaryPropertyObject createInRealm:realm withValue:@{}];
+    [obj.intDictionary setDictionary:@{@"a": @1, @"b": @2, @"c": @3}];
+    [realm commitWriteTransaction];
+
+    __block bool first = true;
+    __block id expectation = [self expectationWithDescription:@""];
+    id token = [obj.intDictionary addNotificationBlock:^(RLMDictionary *dictionary, RLMDictionaryChange *change, NSError *error) {
+        XCTAssertNotNil(dictionary);
+        XCTAssertNil(error);
+        if (first) {
+            XCTAssertNil(change);
+        }
+        else {
+            XCTAssertEqualObjects(change.insertions, @[@"d"]);
+            XCTAssertEqualObjects(change.modifications, @[@"b"]);
+            XCTAssertEqualObjects(change.deletions, @[@"c"]);
+        }
+        first = false;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    expectation = [self expectationWithDescription:@""];
+    [self dispatchAsyncAndWait:^{
+        RLMRealm *realm = self.realmWithTestPath;
+        [realm transactionWithBlock:^{
+            DictionaryPropertyObject *obj = [DictionaryPropertyObject allObjectsInRealm:realm].firstObject;
+            [obj.intDictionary setDictionary:@{@"a": @1, @"b": @5, @"d": @4}];
+        }];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    XCTAssertEqual(obj.intDictionary.count, 3U);
+    XCTAssertEqualObjects(obj.intDictionary[@"a"], @1);
+    XCTAssertEqualObjects(obj.intDictionary[@"b"], @5);
+    XCTAssertEqualObjects(obj.intDictionary[@"d"], @4);
+    XCTAssertNil(obj.intDictionary[@"c"]);
+
+    [(RLMNotificationToken *)token invalidate];
+}
+
 - (void)testNotificationNotSentForUnrelatedChange {
     RLMRealm *realm = self.realmWithTestPath;
     [realm beginWriteTransaction];
@@ -1313,6 +1357,48 @@ static RLMDictionary<NSString *, IntObject *><RLMString, IntObject> *managedTest
     return dict;
 }
 
+- (void)testAllKeysAndValuesAreUnaffectedByLaterChanges {
+    RLMDictionary<NSString *, IntObject *><RLMString, IntObject> *dict = managedTestDictionary();
+    NSArray *keys = dict.allKeys;
+    NSArray *values = dict.allValues;
+    XCTAssertEqual(keys.count, 2U);
+    XCTAssertEqual(values.count, 2U);
+
+    RLMRealm *realm = dict.realm;
+    [realm transactionWithBlock:^{
+        [dict removeObjectForKey:@"0"];
+        dict[@"1"] = [IntObject createInRealm:realm withValue:@[@5]];
+        dict[@"2"] = [IntObject createInRealm:realm withValue:@[@2]];
+    }];
+
+    XCTAssertEqualObjects([keys sortedArrayUsingSelector:@selector(compare:)], (@[@"0", @"1"]));
+    XCTAssertEqualObjects([[values valueForKey:@"intCol"] sortedArrayUsingSelector:@selector(compare:)], (@[@0, @1]));
+    XCTAssertEqual(dict.allKeys.count, 2U);
+    RLMAssertThrowsWithReasonMatching(keys[2], @"out of bounds");
+}
+
+- (void)testAllValuesAfterLinkedObjectsAreDeleted {
+    RLMDictionary<NSString *, IntObject *><RLMString, IntObject> *dict = managedTestDictionary();
+    NSArray<IntObject *> *values = dict.allValues;
+    RLMRealm *realm = dict.realm;
+    [realm transactionWithBlock:^{
+        [realm deleteObjects:[IntObject allObjectsInRealm:realm]];
+    }];
+    XCTAssertEqual(values.count, 2U);
+    XCTAssertTrue(values[0].isInvalidated);
+    XCTAssertTrue(values[1].isInvalidated);
+}
+
+- (void)testAllKeysAndValuesOfFrozenDictionaryFromOtherThreads {
+    RLMDictionary<NSString *, IntObject *><RLMString, IntObject> *frozen = [managedTestDictionary() freeze];
+    NSArray *keys = frozen.allKeys;
+    NSArray *values = frozen.allValues;
+    dispatch_apply(8, dispatch_get_global_queue(0, 0), ^(__unused size_t i) {
+        XCTAssertEqualObjects([keys sortedArrayUsingSelector:@selector(compare:)], (@[@"0", @"1"]));
+        XCTAssertEqualObjects([[values valueForKey:@"intCol"] sortedArrayUsingSelector:@selector(compare:)], (@[@0, @1]));
+    });
+}
+
 - (void)testAllMethodsCheckThread {
     RLMDictionary<NSString *, IntObject *><RLMString, IntObject> *dict = managedTestDictionary();
     IntObject *io = dict.allValues.firstObject;
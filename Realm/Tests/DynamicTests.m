@@ -17,6 +17,7 @@
 ////////////////////////////////////////////////////////////////////////////
 
 #import "RLMTestCase.h"
+#import "RLMAccessor.h"
 #import "RLMRealm_Dynamic.h"
 #import "RLMRealm_Private.h"
 #import "RLMProperty_Private.h"
@@ -149,6 +150,40 @@
     RLMAssertThrowsWithReason(o1[@"invalid"] = nil, @"Invalid property name");
 }
 
+- (void)testDynamicPropertyHandles {
+    @autoreleasepool {
+        RLMRealm *realm = [RLMRealm realmWithURL:RLMTestRealmURL()];
+        [realm beginWriteTransaction];
+        [DynamicTestObject createInRealm:realm withValue:@[@"column1", @1]];
+        [DynamicTestObject createInRealm:realm withValue:@[@"column2", @2]];
+        [realm commitWriteTransaction];
+    }
+
+    RLMRealm *dyrealm = [self realmWithTestPathAndSchema:nil];
+    RLMResults *results = [dyrealm allObjects:@"DynamicTestObject"];
+    RLMObjectSchema *objectSchema = dyrealm.schema[@"DynamicTestObject"];
+    RLMPropertyHandle *intHandle = [objectSchema handleForProperty:@"intCol"];
+    RLMPropertyHandle *stringHandle = [objectSchema handleForProperty:@"stringCol"];
+    XCTAssertEqualObjects(intHandle.property.name, @"intCol");
+    RLMAssertThrowsWithReason([objectSchema handleForProperty:@"invalid"], @"Invalid property name");
+
+    RLMObject *o1 = results[0], *o2 = results[1];
+    XCTAssertEqualObjects(RLMDynamicGetWithHandle(o1, intHandle), @1);
+    XCTAssertEqualObjects(RLMDynamicGetWithHandle(o2, stringHandle), @"column2");
+
+    [dyrealm beginWriteTransaction];
+    RLMDynamicValidatedSetWithHandle(o1, intHandle, @5);
+    RLMDynamicValidatedSetWithHandle(o2, stringHandle, @"changed");
+    RLMAssertThrowsWithReason(RLMDynamicValidatedSetWithHandle(o1, intHandle, @"a"), @"Invalid value");
+    [dyrealm commitWriteTransaction];
+    XCTAssertEqualObjects(o1[@"intCol"], @5);
+    XCTAssertEqualObjects(o2[@"stringCol"], @"changed");
+
+    // Handles from another Realm's schema still work by name
+    RLMObjectSchema *sharedSchema = [RLMSchema sharedSchemaForClass:DynamicTestObject.class];
+    XCTAssertEqualObjects(RLMDynamicGetWithHandle(o1, [sharedSchema handleForProperty:@"intCol"]), @5);
+}
+
 - (void)testDynamicTypes {
     StringObject *so = [[StringObject alloc] init];
     so.stringCol = @"string";
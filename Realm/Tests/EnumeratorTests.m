@@ -18,6 +18,8 @@
 
 #import "RLMTestCase.h"
 
+#import "RLMCollection_Private.h"
+
 @interface EnumeratorTests : RLMTestCase
 @end
 
@@ -76,4 +78,33 @@
     }
 }
 
+- (void)testEnumerationBufferSize {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    [realm transactionWithBlock:^{
+        for (int i = 0; i < 100; i++) {
+            [IntObject createInRealm:realm withValue:@[@(i)]];
+        }
+    }];
+    RLMResults *results = [IntObject allObjects];
+    NSUInteger (^firstBatchSize)(void) = ^{
+        NSFastEnumerationState state = {0};
+        __unsafe_unretained id buffer[1];
+        return [results countByEnumeratingWithState:&state objects:buffer count:1];
+    };
+
+    XCTAssertEqual(RLMGetEnumerationBufferSize(), 64U);
+    XCTAssertEqual(firstBatchSize(), 64U);
+
+    RLMSetEnumerationBufferSize(10);
+    XCTAssertEqual(firstBatchSize(), 10U);
+    NSUInteger count = 0;
+    for (IntObject *obj in results) {
+        XCTAssertEqual(obj.intCol, (int)count++);
+    }
+    XCTAssertEqual(count, 100U);
+
+    RLMSetEnumerationBufferSize(0);
+    XCTAssertEqual(RLMGetEnumerationBufferSize(), 64U);
+}
+
 @end
@@ -294,6 +294,64 @@
     [token invalidate];
 }
 
+- (void)testCrossProcessNotificationLatency {
+    const int stopValue = 500;
+
+    RLMRealm *realm = [self inMemoryRealmWithIdentifier:@"test"];
+    [realm beginWriteTransaction];
+    IntObject *obj = [IntObject allObjectsInRealm:realm].firstObject;
+    if (!obj) {
+        obj = [IntObject createInRealm:realm withValue:@[@0]];
+        [realm commitWriteTransaction];
+    }
+    else {
+        [realm cancelWriteTransaction];
+    }
+
+    // Each process increments the value when it is the other process's turn,
+    // so the parent's round-trip time is two cross-process notifications
+    NSMutableArray<NSNumber *> *roundTrips = [NSMutableArray new];
+    __block CFAbsoluteTime lastWrite = 0;
+    RLMNotificationToken *token = [realm addNotificationBlock:^(__unused NSString *note, __unused RLMRealm *realm) {
+        if (obj.intCol % 2 == self.isParent && obj.intCol < stopValue) {
+            CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+            if (self.isParent && lastWrite) {
+                [roundTrips addObject:@(now - lastWrite)];
+            }
+            [realm transactionWithBlock:^{
+                obj.intCol++;
+            }];
+            lastWrite = CFAbsoluteTimeGetCurrent();
+        }
+    }];
+
+    if (self.isParent) {
+        dispatch_queue_t queue = dispatch_queue_create("background", 0);
+        dispatch_async(queue, ^{ RLMRunChildAndWait(); });
+        while (obj.intCol < stopValue) {
+            [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate distantFuture]];
+        }
+        dispatch_sync(queue, ^{});
+
+        XCTAssertGreaterThan(roundTrips.count, 0U);
+        NSArray<NSNumber *> *sorted = [roundTrips sortedArrayUsingSelector:@selector(compare:)];
+        NSLog(@"Cross-process notification round trips: %lu, p50 %.1fus, p99 %.1fus, max %.1fus",
+              (unsigned long)sorted.count, sorted[sorted.count / 2].doubleValue * 1e6,
+              sorted[MIN(sorted.count - 1, sorted.count * 99 / 100)].doubleValue * 1e6,
+              sorted.lastObject.doubleValue * 1e6);
+    }
+    else {
+        [realm transactionWithBlock:^{
+            obj.intCol++;
+        }];
+        while (obj.intCol < stopValue) {
+            [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate distantFuture]];
+        }
+    }
+
+    [token invalidate];
+}
+
 - (void)testManyWriters {
     const int stopValue = 100;
     const int workers = 10;
@@ -18,6 +18,7 @@
 
 #import "RLMTestCase.h"
 
+#import "RLMArray_Private.h"
 #import "RLMObjectSchema_Private.hpp"
 #import "RLMObjectStore.h"
 #import "RLMObject_Private.hpp"
@@ -1850,6 +1851,31 @@ public:
     XCTAssertTrue(r3.empty());
 }
 
+- (void)testModifyManyObservedObjectsFromOtherAccessors {
+    std::vector<KVOObject *> objects;
+    std::vector<std::unique_ptr<KVORecorder>> recorders;
+    for (int i = 0; i < 100; ++i) {
+        objects.push_back([self createObject]);
+        recorders.push_back(std::make_unique<KVORecorder>(self, objects.back(), @"int32Col"));
+    }
+
+    // Stop observing every third object, which removes them from the middle
+    // of the table's observed objects
+    for (size_t i = 0; i < recorders.size(); i += 3) {
+        recorders[i].reset();
+    }
+
+    for (auto obj : objects) {
+        KVOObject *other = [KVOObject objectInRealm:self.realm forPrimaryKey:@(obj.pk)];
+        other.int32Col = 10;
+    }
+    for (size_t i = 0; i < recorders.size(); ++i) {
+        if (recorders[i]) {
+            AssertChanged(*recorders[i], @2, @10);
+        }
+    }
+}
+
 - (void)testDeleteMiddleOfKeyPath {
     KVOLinkObject2 *obj = [self createLinkObject];
     KVORecorder r(self, obj, @"obj.obj.boolCol");
@@ -1857,6 +1883,25 @@ public:
     AssertChanged(r, @NO, NSNull.null);
 }
 
+- (void)testReplaceAllObjectsInArray {
+    KVOLinkObject2 *obj = [self createLinkObject];
+    {
+        KVORecorder r(self, obj, @"array");
+        [obj.array replaceAllObjectsWithObjects:@[obj.obj, obj.obj]];
+        AssertIndexChange(NSKeyValueChangeInsertion, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)]);
+    }
+    {
+        KVORecorder r(self, obj, @"array");
+        [obj.array replaceAllObjectsWithObjects:@[obj.obj, obj.obj, obj.obj]];
+        AssertIndexChange(NSKeyValueChangeSetting, nil);
+    }
+    {
+        KVORecorder r(self, obj, @"array");
+        [obj.array replaceAllObjectsWithObjects:@[]];
+        AssertIndexChange(NSKeyValueChangeRemoval, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 3)]);
+    }
+}
+
 - (void)testDeleteParentOfObservedRLMArray {
     KVOObject *obj = [self createObject];
     KVORecorder r1(self, obj, @"objectArray");
@@ -53,6 +53,33 @@
     XCTAssertEqualObjects(asArray(hannahsParents), (@[ ]));
 }
 
+- (void)testBacklinkCount {
+    RLMRealm *realm = [self realmWithTestPath];
+    [realm beginWriteTransaction];
+    PersonObject *hannah = [PersonObject createInRealm:realm withValue:@[ @"Hannah", @0 ]];
+    XCTAssertEqual(0U, [hannah backlinkCountForProperty:@"parents"]);
+    PersonObject *mark = [PersonObject createInRealm:realm withValue:@[ @"Mark", @30, @[ hannah ]]];
+    [PersonObject createInRealm:realm withValue:@[ @"Diane", @29, @[ hannah ]]];
+    [realm commitWriteTransaction];
+
+    XCTAssertEqual(2U, [hannah backlinkCountForProperty:@"parents"]);
+    XCTAssertEqual(0U, [mark backlinkCountForProperty:@"parents"]);
+    XCTAssertEqual(0U, [[[PersonObject alloc] init] backlinkCountForProperty:@"parents"]);
+    RLMAssertThrowsWithReason([hannah backlinkCountForProperty:@"children"],
+                              @"Property 'children' is not a linking objects property of object of type 'PersonObject'");
+
+    XCTAssertEqual(1U, [PersonObject objectsInRealm:realm where:@"@links.@count > 0"].count);
+    XCTAssertEqual(2U, [PersonObject objectsInRealm:realm where:@"@links.@count == 0"].count);
+    XCTAssertEqual(1U, [PersonObject objectsInRealm:realm where:@"1 < @links.@count"].count);
+    RLMAssertThrowsWithReason([PersonObject objectsInRealm:realm where:@"@links.@count == 'a'"],
+                              @"@links.@count can only be compared with a numeric value.");
+
+    [realm beginWriteTransaction];
+    [realm deleteObject:mark];
+    [realm commitWriteTransaction];
+    XCTAssertEqual(1U, [hannah backlinkCountForProperty:@"parents"]);
+}
+
 - (void)testLinkingObjectsOnUnmanagedObject {
     PersonObject *don = [[PersonObject alloc] initWithValue:@[ @"Don", @60, @[] ]];
 
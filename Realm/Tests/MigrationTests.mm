@@ -63,6 +63,13 @@ RLM_COLLECTION_TYPE(MigrationTestObject);
 @implementation MigrationTestObject
 @end
 
+@interface MigrationDoubleObject : RLMObject
+@property double doubleCol;
+@end
+
+@implementation MigrationDoubleObject
+@end
+
 @interface MigrationPrimaryKeyObject : RLMObject
 @property int intCol;
 @end
@@ -323,6 +330,26 @@ RLM_COLLECTION_TYPE(MigrationTestObject);
     XCTAssertEqual(1U, [RLMRealm schemaVersionAtURL:config.fileURL encryptionKey:nil error:nil]);
 }
 
+- (void)testFileInfo {
+    RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+    config.schemaVersion = 3;
+    @autoreleasepool { [RLMRealm realmWithConfiguration:config error:nil]; }
+    [NSFileManager.defaultManager removeItemAtURL:[config.fileURL URLByAppendingPathExtension:@"lock"] error:nil];
+
+    NSError *error;
+    RLMRealmFileInfo *info = [RLMRealm fileInfoAtURL:config.fileURL encryptionKey:nil error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqual(info.schemaVersion, 3U);
+    XCTAssertFalse(info.encrypted);
+    XCTAssertGreaterThan(info.fileFormatVersion, 0);
+    XCTAssertEqual(info.fileSize, [[NSFileManager.defaultManager attributesOfItemAtPath:config.fileURL.path error:nil] fileSize]);
+    // Reading the metadata doesn't create a lock file
+    XCTAssertFalse([NSFileManager.defaultManager fileExistsAtPath:[config.fileURL URLByAppendingPathExtension:@"lock"].path]);
+
+    XCTAssertNil([RLMRealm fileInfoAtURL:[NSURL fileURLWithPath:@"/dev/null"] encryptionKey:nil error:&error]);
+    XCTAssertNotNil(error);
+}
+
 - (void)testSchemaVersionCannotGoDown {
     RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
     config.schemaVersion = 10;
@@ -350,6 +377,24 @@ RLM_COLLECTION_TYPE(MigrationTestObject);
     XCTAssertEqual(10U, [RLMRealm schemaVersionAtURL:config.fileURL encryptionKey:config.encryptionKey error:nil]);
 }
 
+- (void)testOpeningDifferentRealmDuringMigration {
+    RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+    @autoreleasepool { [RLMRealm realmWithConfiguration:config error:nil]; }
+
+    RLMRealmConfiguration *otherConfig = [RLMRealmConfiguration defaultConfiguration];
+    otherConfig.fileURL = RLMTestRealmURL();
+
+    __block bool migrationCalled = false;
+    config.schemaVersion = 1;
+    config.migrationBlock = ^(__unused RLMMigration *migration, __unused uint64_t oldSchemaVersion) {
+        // Opens are only serialized per file, so this doesn't deadlock
+        XCTAssertNotNil([RLMRealm realmWithConfiguration:otherConfig error:nil]);
+        migrationCalled = true;
+    };
+    @autoreleasepool { XCTAssertNotNil([RLMRealm realmWithConfiguration:config error:nil]); }
+    XCTAssertTrue(migrationCalled);
+}
+
 #pragma mark - Migration Requirements
 
 - (void)testAddingClassDoesNotRequireMigration {
@@ -690,6 +735,103 @@ RLM_COLLECTION_TYPE(MigrationTestObject);
     XCTAssertNil(RLMGetAnyCachedRealmForPath(c.pathOnDisk.UTF8String));
 }
 
+- (void)testMigrateAsyncReportsProgress {
+    RLMRealmConfiguration *c = self.config;
+    c.schemaVersion = 1;
+    @autoreleasepool {
+        RLMRealm *realm = [RLMRealm realmWithConfiguration:c error:nil];
+        [realm transactionWithBlock:^{
+            for (int i = 0; i < 250; ++i) {
+                [IntObject createInRealm:realm withValue:@[@(i)]];
+            }
+        }];
+    }
+
+    __block bool migrationCalled = false;
+    c.schemaVersion = 2;
+    c.migrationBlock = ^(RLMMigration *migration, __unused uint64_t oldSchemaVersion) {
+        XCTAssertFalse(NSThread.isMainThread);
+        migrationCalled = true;
+        [migration enumerateObjects:IntObject.className block:^(__unused RLMObject *oldObject, RLMObject *newObject) {
+            newObject[@"intCol"] = @([newObject[@"intCol"] intValue] * 2);
+        }];
+    };
+
+    XCTestExpectation *ex = [self expectationWithDescription:@"async-migration"];
+    NSMutableArray<NSNumber *> *progress = [NSMutableArray new];
+    [RLMRealm migrateAsyncWithConfiguration:c
+                              callbackQueue:dispatch_get_main_queue()
+                                   progress:^(NSString *className, NSUInteger enumerated, NSUInteger total) {
+        XCTAssertTrue(NSThread.isMainThread);
+        XCTAssertEqualObjects(className, IntObject.className);
+        XCTAssertEqual(total, 250U);
+        [progress addObject:@(enumerated)];
+    } completion:^(NSError *error) {
+        XCTAssertTrue(NSThread.isMainThread);
+        XCTAssertNil(error);
+        [ex fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    XCTAssertTrue(migrationCalled);
+    XCTAssertEqual(progress.count, 125U);
+    XCTAssertEqualObjects(progress.firstObject, @2);
+    XCTAssertEqualObjects(progress.lastObject, @250);
+
+    RLMRealm *realm = [RLMRealm realmWithConfiguration:c error:nil];
+    XCTAssertEqualObjects([[IntObject allObjectsInRealm:realm] maxOfProperty:@"intCol"], @498);
+}
+
+- (void)testMigrateAsyncReportsFinalProgressForEachClass {
+    RLMRealmConfiguration *c = self.config;
+    c.schemaVersion = 1;
+    // Neither count is a multiple of the reporting interval, so the final
+    // callback has to come from reaching the total rather than the interval
+    @autoreleasepool {
+        RLMRealm *realm = [RLMRealm realmWithConfiguration:c error:nil];
+        [realm transactionWithBlock:^{
+            for (int i = 0; i < 1234; ++i) {
+                [IntObject createInRealm:realm withValue:@[@(i)]];
+            }
+            for (int i = 0; i < 347; ++i) {
+                [StringObject createInRealm:realm withValue:@[@"a"]];
+            }
+        }];
+    }
+
+    c.schemaVersion = 2;
+    c.migrationBlock = ^(RLMMigration *migration, __unused uint64_t oldSchemaVersion) {
+        for (NSString *className in @[IntObject.className, StringObject.className]) {
+            [migration enumerateObjects:className block:^(__unused RLMObject *oldObject, __unused RLMObject *newObject) {}];
+        }
+    };
+
+    XCTestExpectation *ex = [self expectationWithDescription:@"async-migration"];
+    NSMutableDictionary<NSString *, NSArray<NSNumber *> *> *lastProgress = [NSMutableDictionary new];
+    [RLMRealm migrateAsyncWithConfiguration:c
+                              callbackQueue:dispatch_get_main_queue()
+                                   progress:^(NSString *className, NSUInteger enumerated, NSUInteger total) {
+        lastProgress[className] = @[@(enumerated), @(total)];
+    } completion:^(NSError *error) {
+        XCTAssertNil(error);
+        [ex fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    XCTAssertEqualObjects(lastProgress[IntObject.className], (@[@1234, @1234]));
+    XCTAssertEqualObjects(lastProgress[StringObject.className], (@[@347, @347]));
+}
+
+- (void)testMigrateAsyncThrowsForOpenRealm {
+    RLMRealmConfiguration *c = self.config;
+    __unused RLMRealm *realm = [RLMRealm realmWithConfiguration:c error:nil];
+    RLMAssertThrowsWithReason([RLMRealm migrateAsyncWithConfiguration:c
+                                                        callbackQueue:dispatch_get_main_queue()
+                                                             progress:nil
+                                                           completion:^(NSError *) { XCTFail(@"should not be called"); }],
+                              @"Cannot migrate Realms that are already open.");
+}
+
 #pragma mark - Migration Correctness
 
 - (void)testRemovingSubclass {
@@ -868,6 +1010,132 @@ RLM_COLLECTION_TYPE(MigrationTestObject);
     XCTAssertEqualObjects(mig1[@"stringCol"], @"2", @"stringCol should be string after migration.");
 }
 
+- (void)testTransformPropertyValues {
+    // make string an int
+    RLMObjectSchema *objectSchema = [RLMObjectSchema schemaForObjectClass:MigrationTestObject.class];
+    objectSchema.objectClass = RLMObject.class;
+    RLMProperty *stringCol = objectSchema.properties[1];
+    stringCol.type = RLMPropertyTypeInt;
+    stringCol.optional = NO;
+
+    [self createTestRealmWithSchema:@[objectSchema] block:^(RLMRealm *realm) {
+        for (int i = 0; i < 10; ++i) {
+            [realm createObject:MigrationTestObject.className withValue:@[@(i), @(i * 10)]];
+        }
+    }];
+
+    RLMRealm *realm = [self migrateTestRealmWithBlock:^(RLMMigration *migration, uint64_t) {
+        RLMAssertThrowsWithReason([migration transformValuesOfClass:MigrationTestObject.className
+                                                       fromProperty:@"stringCol" toProperty:@"stringCol" block:nil],
+                                  @"Cannot copy values of property 'MigrationTestObject.stringCol' of type 'int' to property 'stringCol' of type 'string' without a conversion block.");
+        RLMAssertThrowsWithReason([migration transformValuesOfClass:MigrationTestObject.className
+                                                       fromProperty:@"invalid" toProperty:@"stringCol" block:nil],
+                                  @"Property 'invalid' not found in the old schema of class 'MigrationTestObject'.");
+        RLMAssertThrowsWithReason([migration transformValuesOfClass:@"NoSuchClass"
+                                                       fromProperty:@"intCol" toProperty:@"intCol" block:nil],
+                                  @"Class 'NoSuchClass' must be present in both the old and new schemas");
+        RLMAssertThrowsWithReason([migration transformValuesOfClass:MigrationTestObject.className
+                                                       fromProperty:@"stringCol" toProperty:@"intCol"
+                                                              block:^id(id) { return @"not an int"; }],
+                                  @"for 'int' property 'MigrationTestObject.intCol'.");
+
+        [migration transformValuesOfClass:MigrationTestObject.className
+                             fromProperty:@"stringCol" toProperty:@"stringCol"
+                                    block:^id(NSNumber *value) {
+            XCTAssert([value isKindOfClass:NSNumber.class]);
+            return value.stringValue;
+        }];
+        // Copying without a block between properties of the same type
+        [migration transformValuesOfClass:MigrationTestObject.className
+                             fromProperty:@"intCol" toProperty:@"intCol" block:nil];
+    }];
+
+    RLMResults *objects = [MigrationTestObject allObjectsInRealm:realm];
+    XCTAssertEqual(objects.count, 10U);
+    for (MigrationTestObject *obj in objects) {
+        XCTAssertEqualObjects(obj[@"stringCol"], ([NSString stringWithFormat:@"%@", @([obj[@"intCol"] intValue] * 10)]));
+    }
+}
+
+- (void)testConvertPropertyType {
+    // make string an int
+    RLMObjectSchema *objectSchema = [RLMObjectSchema schemaForObjectClass:MigrationTestObject.class];
+    objectSchema.objectClass = RLMObject.class;
+    RLMProperty *stringCol = objectSchema.properties[1];
+    stringCol.type = RLMPropertyTypeInt;
+    stringCol.optional = NO;
+
+    [self createTestRealmWithSchema:@[objectSchema] block:^(RLMRealm *realm) {
+        for (int i = 0; i < 10; ++i) {
+            [realm createObject:MigrationTestObject.className withValue:@[@(i), @(i * 10)]];
+        }
+    }];
+
+    RLMRealm *realm = [self migrateTestRealmWithBlock:^(RLMMigration *migration, uint64_t) {
+        RLMAssertThrowsWithReason([migration convertProperty:@"stringCol" ofClass:MigrationTestObject.className
+                                                      toType:RLMPropertyTypeDouble using:nil],
+                                  @"Cannot convert property 'MigrationTestObject.stringCol' to 'double': the property is of type 'string' in the new schema.");
+        RLMAssertThrowsWithReason([migration copyProperty:@"stringCol" toProperty:@"stringCol"
+                                                  ofClass:MigrationTestObject.className],
+                                  @"without a conversion block.");
+
+        [migration convertProperty:@"stringCol" ofClass:MigrationTestObject.className
+                            toType:RLMPropertyTypeString using:nil];
+        [migration copyProperty:@"intCol" toProperty:@"intCol" ofClass:MigrationTestObject.className];
+    }];
+
+    RLMResults *objects = [MigrationTestObject allObjectsInRealm:realm];
+    XCTAssertEqual(objects.count, 10U);
+    for (MigrationTestObject *obj in objects) {
+        XCTAssertEqualObjects(obj[@"stringCol"], ([NSString stringWithFormat:@"%@", @([obj[@"intCol"] intValue] * 10)]));
+    }
+}
+
+- (void)testConvertPropertyRequiresBlockForRoundingConversion {
+    // make double an int
+    RLMObjectSchema *objectSchema = [RLMObjectSchema schemaForObjectClass:MigrationDoubleObject.class];
+    objectSchema.objectClass = RLMObject.class;
+    RLMProperty *doubleCol = objectSchema.properties[0];
+    doubleCol.type = RLMPropertyTypeInt;
+
+    // 2^53 + 1 can't be represented exactly as a double
+    int64_t value = (1LL << 53) + 1;
+    [self createTestRealmWithSchema:@[objectSchema] block:^(RLMRealm *realm) {
+        [realm createObject:MigrationDoubleObject.className withValue:@[@(value)]];
+    }];
+
+    RLMRealm *realm = [self migrateTestRealmWithBlock:^(RLMMigration *migration, uint64_t) {
+        RLMAssertThrowsWithReason([migration convertProperty:@"doubleCol" ofClass:MigrationDoubleObject.className
+                                                      toType:RLMPropertyTypeDouble using:nil],
+                                  @"Cannot convert property 'MigrationDoubleObject.doubleCol' from 'int' to 'double' without a conversion block.");
+        [migration convertProperty:@"doubleCol" ofClass:MigrationDoubleObject.className
+                            toType:RLMPropertyTypeDouble using:^id(id oldValue) {
+            return @([oldValue doubleValue]);
+        }];
+    }];
+
+    XCTAssertEqualObjects([MigrationDoubleObject allObjectsInRealm:realm].firstObject[@"doubleCol"], @((double)value));
+}
+
+- (void)testConvertPropertyFromUnparseableString {
+    // make int a string
+    RLMObjectSchema *objectSchema = [RLMObjectSchema schemaForObjectClass:MigrationTestObject.class];
+    objectSchema.objectClass = RLMObject.class;
+    RLMProperty *intCol = objectSchema.properties[0];
+    intCol.type = RLMPropertyTypeString;
+
+    [self createTestRealmWithSchema:@[objectSchema] block:^(RLMRealm *realm) {
+        [realm createObject:MigrationTestObject.className withValue:@[@"12", @"a"]];
+        [realm createObject:MigrationTestObject.className withValue:@[@"12a", @"b"]];
+    }];
+
+    [self migrateTestRealmWithBlock:^(RLMMigration *migration, uint64_t) {
+        RLMAssertThrowsWithReason([migration convertProperty:@"intCol" ofClass:MigrationTestObject.className
+                                                      toType:RLMPropertyTypeInt using:nil],
+                                  @"Cannot convert value '12a' of property 'MigrationTestObject.intCol' to 'int'.");
+    }];
+}
+
 - (void)testChangeObjectLinkType {
     // create realm with old schema and populate
     [self createTestRealmWithSchema:RLMSchema.sharedSchema.objectSchema block:^(RLMRealm *realm) {
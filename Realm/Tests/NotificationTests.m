@@ -291,6 +291,27 @@ static RLMCollectionChange *getChange(RLMTestCase<ChangesetTestCase> *self, void
     return changes;
 }
 
+static NSArray *indexSetToArray(NSIndexSet *indexes) {
+    NSMutableArray *ret = [NSMutableArray new];
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, __unused BOOL *stop) {
+        [ret addObject:@(index)];
+    }];
+    return ret;
+}
+
+static NSIndexSet *rangesToIndexSet(id self, void (^enumerate)(void (^)(NSRange, BOOL *))) {
+    NSMutableIndexSet *ret = [NSMutableIndexSet new];
+    __block NSUInteger previousEnd = 0;
+    enumerate(^(NSRange range, __unused BOOL *stop) {
+        // Ranges should be non-empty, ascending and non-adjacent
+        XCTAssertGreaterThan(range.length, 0U);
+        XCTAssertTrue(ret.count == 0 || range.location > previousEnd);
+        previousEnd = NSMaxRange(range);
+        [ret addIndexesInRange:range];
+    });
+    return ret;
+}
+
 static void ExpectChange(id self, NSArray *deletions, NSArray *insertions,
                          NSArray *modifications, void (^block)(RLMRealm *)) {
     RLMCollectionChange *changes = getChange(self, block);
@@ -302,6 +323,21 @@ static void ExpectChange(id self, NSArray *deletions, NSArray *insertions,
     XCTAssertEqualObjects(deletions, changes.deletions);
     XCTAssertEqualObjects(insertions, changes.insertions);
     XCTAssertEqualObjects(modifications, changes.modifications);
+    XCTAssertEqual(changes.deletions, changes.deletions);
+    XCTAssertEqual(changes.insertionIndexes, changes.insertionIndexes);
+
+    XCTAssertEqualObjects(deletions, indexSetToArray(changes.deletionIndexes));
+    XCTAssertEqualObjects(insertions, indexSetToArray(changes.insertionIndexes));
+    XCTAssertEqualObjects(modifications, indexSetToArray(changes.modificationIndexes));
+    XCTAssertEqualObjects(changes.deletionIndexes, rangesToIndexSet(self, ^(void (^fn)(NSRange, BOOL *)) {
+        [changes enumerateDeletionRangesUsingBlock:fn];
+    }));
+    XCTAssertEqualObjects(changes.insertionIndexes, rangesToIndexSet(self, ^(void (^fn)(NSRange, BOOL *)) {
+        [changes enumerateInsertionRangesUsingBlock:fn];
+    }));
+    XCTAssertEqualObjects(changes.modificationIndexes, rangesToIndexSet(self, ^(void (^fn)(NSRange, BOOL *)) {
+        [changes enumerateModificationRangesUsingBlock:fn];
+    }));
 
     NSInteger section = __LINE__;
     NSArray *deletionPaths = [changes deletionsInSection:section];
@@ -516,6 +552,117 @@ static void ExpectChange(id self, NSArray *deletions, NSArray *insertions,
     XCTAssertEqualObjects(@[@5], changes.insertions);
 }
 
+- (void)testMinimumIntervalCoalescesChanges {
+    [self prepare];
+
+    RLMResults *query = [self query];
+    __block int calls = 0;
+    __block RLMCollectionChange *changes;
+    __block XCTestExpectation *ex = [self expectationWithDescription:@"initial notification"];
+    RLMNotificationToken *token = [query addNotificationBlock:^(RLMResults *results, RLMCollectionChange *c, NSError *error) {
+        XCTAssertNotNil(results);
+        XCTAssertNil(error);
+        ++calls;
+        changes = c;
+        [ex fulfill];
+    } keyPaths:nil queue:nil minimumInterval:0.5];
+    [self waitForExpectations:@[ex] timeout:2.0];
+    XCTAssertNil(changes);
+
+    // Each of these is delivered by the notifier separately, but they all
+    // occur within the interval and so should reach the block as one change
+    ex = [self expectationWithDescription:@"coalesced notification"];
+    RLMRealm *realm = query.realm;
+    for (int i = 0; i < 3; ++i) {
+        [realm transactionWithBlock:^{
+            [IntObject createInRealm:realm withValue:@[@3]];
+        }];
+        [NSRunLoop.currentRunLoop runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+    }
+    [self waitForExpectations:@[ex] timeout:2.0];
+    [token invalidate];
+
+    XCTAssertEqual(calls, 2);
+    XCTAssertEqualObjects((@[@4, @5, @6]), changes.insertions);
+    XCTAssertEqualObjects(@[], changes.deletions);
+}
+
+- (void)testMinimumIntervalSkipsChangesWhichCancelOut {
+    [self prepare];
+
+    RLMResults *query = [self query];
+    __block int calls = 0;
+    __block XCTestExpectation *ex = [self expectationWithDescription:@"initial notification"];
+    RLMNotificationToken *token = [query addNotificationBlock:^(RLMResults *results, RLMCollectionChange *, NSError *error) {
+        XCTAssertNotNil(results);
+        XCTAssertNil(error);
+        ++calls;
+        [ex fulfill];
+    } keyPaths:nil queue:nil minimumInterval:0.5];
+    [self waitForExpectations:@[ex] timeout:2.0];
+
+    // The insertion and the deletion are merged into an empty changeset,
+    // which shouldn't be delivered at all
+    RLMRealm *realm = query.realm;
+    __block IntObject *obj;
+    [realm transactionWithBlock:^{
+        obj = [IntObject createInRealm:realm withValue:@[@3]];
+    }];
+    [NSRunLoop.currentRunLoop runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+    [realm transactionWithBlock:^{
+        [realm deleteObject:obj];
+    }];
+    [NSRunLoop.currentRunLoop runUntilDate:[NSDate dateWithTimeIntervalSinceNow:1.0]];
+    [token invalidate];
+
+    XCTAssertEqual(calls, 1);
+}
+
+- (void)testPausedTokenDoesNotDeliverChanges {
+    [self prepare];
+
+    RLMResults *query = [self query];
+    __block int calls = 0;
+    __block RLMCollectionChange *changes;
+    __block XCTestExpectation *ex = [self expectationWithDescription:@"initial notification"];
+    RLMNotificationToken *token = [query addNotificationBlock:^(RLMResults *results, RLMCollectionChange *c, NSError *error) {
+        XCTAssertNotNil(results);
+        XCTAssertNil(error);
+        ++calls;
+        changes = c;
+        [ex fulfill];
+    }];
+    [self waitForExpectations:@[ex] timeout:2.0];
+
+    [token pause];
+    RLMRealm *realm = query.realm;
+    [self waitForNotification:RLMRealmDidChangeNotification realm:realm block:^{
+        RLMRealm *realm = [RLMRealm defaultRealm];
+        [realm transactionWithBlock:^{
+            [IntObject createInRealm:realm withValue:@[@3]];
+        }];
+    }];
+    [NSRunLoop.currentRunLoop runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    XCTAssertEqual(calls, 1);
+
+    // Resuming delivers the current state without the changes made while paused
+    ex = [self expectationWithDescription:@"resumed notification"];
+    [token resume];
+    [self waitForExpectations:@[ex] timeout:2.0];
+    XCTAssertEqual(calls, 2);
+    XCTAssertNil(changes);
+
+    ex = [self expectationWithDescription:@"change after resuming"];
+    [realm transactionWithBlock:^{
+        [IntObject createInRealm:realm withValue:@[@3]];
+    }];
+    [self waitForExpectations:@[ex] timeout:2.0];
+    [token invalidate];
+
+    XCTAssertEqual(calls, 3);
+    XCTAssertEqualObjects(@[@6], changes.insertions);
+}
+
 - (void)testMultipleWriteTransactionsWithinNotification {
     [self prepare];
 
@@ -1150,6 +1150,44 @@
     [realm2 cancelWriteTransaction];
 }
 
+- (void)testCreateOnManagedObjectInDifferentRealmCopiesAllPropertyTypes {
+    auto realm = [RLMRealm defaultRealm];
+    [realm beginWriteTransaction];
+    auto realm2 = [self realmWithTestPath];
+    [realm2 beginWriteTransaction];
+
+    auto so = [StringObject createInRealm:realm withValue:@[@"string"]];
+    auto source = [AllTypesObject createInRealm:realm withValue:[AllTypesObject values:1 stringObject:so]];
+    auto opt = [AllOptionalTypes createInRealm:realm withValue:@[NSNull.null, NSNull.null,
+                                                                 NSNull.null, NSNull.null,
+                                                                 NSNull.null, NSNull.null,
+                                                                 NSNull.null]];
+
+    auto copy = [AllTypesObject createInRealm:realm2 withValue:source];
+    XCTAssertEqual(copy.boolCol, source.boolCol);
+    XCTAssertEqual(copy.intCol, source.intCol);
+    XCTAssertEqual(copy.floatCol, source.floatCol);
+    XCTAssertEqual(copy.doubleCol, source.doubleCol);
+    XCTAssertEqualObjects(copy.stringCol, source.stringCol);
+    XCTAssertEqualObjects(copy.binaryCol, source.binaryCol);
+    XCTAssertEqualObjects(copy.dateCol, source.dateCol);
+    XCTAssertEqual(copy.cBoolCol, source.cBoolCol);
+    XCTAssertEqual(copy.longCol, source.longCol);
+    XCTAssertEqualObjects(copy.decimalCol, source.decimalCol);
+    XCTAssertEqualObjects(copy.objectIdCol, source.objectIdCol);
+    XCTAssertEqualObjects(copy.uuidCol, source.uuidCol);
+    XCTAssertEqualObjects(copy.objectCol.stringCol, @"string");
+    XCTAssertEqual(copy.objectCol.realm, realm2);
+
+    auto optCopy = [AllOptionalTypes createInRealm:realm2 withValue:opt];
+    XCTAssertNil(optCopy.intObj);
+    XCTAssertNil(optCopy.string);
+    XCTAssertNil(optCopy.date);
+
+    [realm cancelWriteTransaction];
+    [realm2 cancelWriteTransaction];
+}
+
 - (void)testCreateOnManagedObjectInDifferentRealmDoesntReallyWorkUsefullyWithLinkedPKs {
     auto realm = [RLMRealm defaultRealm];
     [realm beginWriteTransaction];
@@ -1290,6 +1328,55 @@
     [realm cancelWriteTransaction];
 }
 
+#pragma mark - Bulk Create
+
+- (void)testCreateObjectsWithValues {
+    auto realm = [RLMRealm defaultRealm];
+    [realm beginWriteTransaction];
+    StringObject *unmanaged = [[StringObject alloc] initWithValue:@[@"c"]];
+    [realm createObjects:@"StringObject" withValues:@[@[@"a"], @{@"stringCol": @"b"}, unmanaged]];
+    RLMResults *results = [[StringObject allObjectsInRealm:realm] sortedResultsUsingKeyPath:@"stringCol" ascending:YES];
+    XCTAssertEqual(3U, results.count);
+    XCTAssertEqualObjects([results valueForKey:@"stringCol"], (@[@"a", @"b", @"c"]));
+    XCTAssertNil(unmanaged.realm);
+    [realm cancelWriteTransaction];
+}
+
+- (void)testCreateObjectsWithNestedValuesOfDifferentKinds {
+    auto realm = [RLMRealm defaultRealm];
+    [realm beginWriteTransaction];
+    EmployeeObject *unmanaged = [[EmployeeObject alloc] initWithValue:@[@"e3", @40, @YES]];
+    [realm createObjects:@"CompanyObject" withValues:@[
+        @{@"name": @"a", @"employees": @[@[@"e1", @20, @YES], @{@"name": @"e2", @"age": @30, @"hired": @NO}, unmanaged]},
+        @[@"b", @[@{@"name": @"e4", @"age": @50, @"hired": @YES}]],
+    ]];
+
+    RLMResults *companies = [[CompanyObject allObjectsInRealm:realm] sortedResultsUsingKeyPath:@"name" ascending:YES];
+    XCTAssertEqualObjects([companies valueForKey:@"name"], (@[@"a", @"b"]));
+    CompanyObject *a = companies[0];
+    XCTAssertEqualObjects([a.employees valueForKey:@"name"], (@[@"e1", @"e2", @"e3"]));
+    XCTAssertEqualObjects([a.employees valueForKey:@"age"], (@[@20, @30, @40]));
+    XCTAssertEqualObjects([a.employees valueForKey:@"hired"], (@[@YES, @NO, @YES]));
+    CompanyObject *b = companies[1];
+    XCTAssertEqualObjects([b.employees valueForKey:@"name"], (@[@"e4"]));
+    XCTAssertEqual(b.employees.firstObject.age, 50);
+    [realm cancelWriteTransaction];
+}
+
+- (void)testCreateObjectsWithInvalidValues {
+    auto realm = [RLMRealm defaultRealm];
+    [realm beginWriteTransaction];
+    RLMAssertThrowsWithReason([realm createObjects:@"IntObject" withValues:@[@[@1], @[@"a"]]],
+                              @"Invalid value 'a' of type '__NSCFConstantString' for 'int' property 'IntObject.intCol'.");
+    [realm cancelWriteTransaction];
+}
+
+- (void)testCreateObjectsOutsideWriteTransaction {
+    auto realm = [RLMRealm defaultRealm];
+    RLMAssertThrowsWithReason([realm createObjects:@"IntObject" withValues:@[@[@1]]],
+                              @"call beginWriteTransaction");
+}
+
 #pragma mark - Create Or Update
 
 - (void)testCreateOrUpdateWithoutPKThrows {
@@ -1424,6 +1511,33 @@
     [realm cancelWriteTransaction];
 }
 
+- (void)testCreateOrUpdateModifiedUpdatesEmbeddedObjectsInPlace {
+    auto realm = [RLMRealm defaultRealm];
+    [realm beginWriteTransaction];
+    auto parent = [EmbeddedIntParentObject createInRealm:realm
+                                               withValue:@[@1, @[@1], @[@[@1], @[@2], @[@3]]]];
+    EmbeddedIntObject *object = parent.object;
+    EmbeddedIntObject *first = parent.array[0];
+    EmbeddedIntObject *second = parent.array[1];
+    EmbeddedIntObject *third = parent.array[2];
+
+    [EmbeddedIntParentObject createOrUpdateModifiedInRealm:realm
+                                                 withValue:@[@1, @[@10], @[@[@1], @[@5]]]];
+
+    // Existing embedded objects are updated in place, matched by position,
+    // and only the left over ones are deleted
+    XCTAssertFalse(object.invalidated);
+    XCTAssertEqual(object.intCol, 10);
+    XCTAssertFalse(first.invalidated);
+    XCTAssertEqual(first.intCol, 1);
+    XCTAssertFalse(second.invalidated);
+    XCTAssertEqual(second.intCol, 5);
+    XCTAssertTrue(third.invalidated);
+    XCTAssertEqual(parent.array.count, 2U);
+
+    [realm cancelWriteTransaction];
+}
+
 - (void)testCreateOrUpdateOnManagedObjectInDifferentRealmDeepCopies {
     auto realm = [RLMRealm defaultRealm];
     [realm beginWriteTransaction];
@@ -39,6 +39,20 @@
     XCTAssertEqual((int)now.timeIntervalSince1970, objectId2.timestamp.timeIntervalSince1970);
 }
 
+- (void)testObjectIdInvalidStrings {
+    NSArray<NSString *> *invalid = @[@"", @"000123450000ffbeef91906", @"000123450000ffbeef91906c0",
+                                     @"000123450000ffbeef91906g", @"000123450000ffbeef91906\u00e9",
+                                     @" 00123450000ffbeef91906c"];
+    for (NSString *string in invalid) {
+        NSError *error;
+        XCTAssertNil([[RLMObjectId alloc] initWithString:string error:&error], @"%@", string);
+        XCTAssertEqual(error.code, RLMErrorInvalidInput);
+    }
+
+    RLMObjectId *upper = [[RLMObjectId alloc] initWithString:@"000123450000FFBEEF91906C" error:nil];
+    XCTAssertEqualObjects(upper.stringValue, @"000123450000ffbeef91906c");
+}
+
 - (void)testObjectIdComparision {
     NSString *strValue = @"000123450000ffbeef91906c";
     RLMObjectId *objectId = [[RLMObjectId alloc] initWithString:strValue error:nil];
@@ -109,4 +123,36 @@
     XCTAssertTrue([objectId isLessThanOrEqualTo:objectId3]);
 }
 
+- (void)testObjectIdsWithCount {
+    NSArray<RLMObjectId *> *objectIds = [RLMObjectId objectIdsWithCount:1000];
+    XCTAssertEqual(objectIds.count, 1000U);
+    XCTAssertEqual([NSSet setWithArray:objectIds].count, 1000U);
+    XCTAssertEqualWithAccuracy(objectIds[0].timestamp.timeIntervalSinceNow, 0, 2);
+    XCTAssertEqual([RLMObjectId objectIdsWithCount:0].count, 0U);
+}
+
+- (void)testObjectIdGenerationIsUniqueAcrossThreads {
+    static const NSUInteger threadCount = 8, perThread = 10000;
+    NSMutableArray<NSSet *> *generated = [NSMutableArray new];
+    for (NSUInteger i = 0; i < threadCount; ++i) {
+        [generated addObject:[NSSet set]];
+    }
+    dispatch_apply(threadCount, DISPATCH_APPLY_AUTO, ^(size_t i) {
+        NSMutableSet *objectIds = [NSMutableSet setWithCapacity:perThread];
+        for (NSUInteger j = 0; j < perThread; ++j) {
+            [objectIds addObject:[RLMObjectId objectId]];
+        }
+        @synchronized (generated) {
+            generated[i] = objectIds;
+        }
+    });
+
+    NSMutableSet *all = [NSMutableSet new];
+    for (NSSet *objectIds in generated) {
+        XCTAssertEqual(objectIds.count, perThread);
+        [all unionSet:objectIds];
+    }
+    XCTAssertEqual(all.count, threadCount * perThread);
+}
+
 @end
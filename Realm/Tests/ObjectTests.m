@@ -18,6 +18,7 @@
 
 #import "RLMTestCase.h"
 
+#import "RLMCollection_Private.h"
 #import "RLMObjectSchema_Private.h"
 #import "RLMSchema_Private.h"
 
@@ -994,6 +995,38 @@ static void addProperty(Class cls, const char *name, const char *type, size_t si
     XCTAssertNoThrow(obj.description);
 }
 
+- (void)testObjectDescriptionLimits {
+    CycleObject *obj = [[CycleObject alloc] init];
+    [RLMRealm.defaultRealm transactionWithBlock:^{
+        [RLMRealm.defaultRealm addObject:obj];
+        for (int i = 0; i < 50; i++) {
+            CycleObject *child = [[CycleObject alloc] init];
+            [child.objects addObject:obj];
+            [obj.objects addObject:child];
+            [obj.objectSet addObject:child];
+        }
+    }];
+
+    RLMDescriptionOptions options = RLMDefaultDescriptionOptions;
+    options.maxElements = 10;
+    NSString *description = RLMDescriptionWithOptions(obj, options);
+    XCTAssertTrue([description rangeOfString:@"objects skipped."].location != NSNotFound);
+    XCTAssertTrue([description rangeOfString:@"[10]"].location == NSNotFound);
+
+    options = RLMDefaultDescriptionOptions;
+    options.maxLength = 200;
+    description = RLMDescriptionWithOptions(obj, options);
+    XCTAssertLessThan(description.length, 1000U);
+    XCTAssertTrue([description rangeOfString:@"skipped."].location != NSNotFound);
+
+    options = RLMDefaultDescriptionOptions;
+    options.summarizeCollections = YES;
+    description = RLMDescriptionWithOptions(obj, options);
+    XCTAssertTrue([description hasPrefix:@"CycleObject {\n\tobjects = RLMArray<CycleObject> <0x"]);
+    XCTAssertTrue([description rangeOfString:@"> (50 objects);\n\tobjectSet = RLMSet<CycleObject> <0x"].location != NSNotFound);
+    XCTAssertTrue([description hasSuffix:@"> (50 objects);\n}"]);
+}
+
 - (void)testDataObjectDescription {
     RLMRealm *realm = [RLMRealm defaultRealm];
 
@@ -1369,6 +1402,32 @@ static void addProperty(Class cls, const char *name, const char *type, size_t si
                               @"Realm must not be nil");
 }
 
+- (void)testObjectsForKeys {
+    RLMRealm *realm = RLMRealm.defaultRealm;
+    [realm beginWriteTransaction];
+    PrimaryStringObject *a = [PrimaryStringObject createInRealm:realm withValue:@[@"a", @0]];
+    PrimaryStringObject *b = [PrimaryStringObject createInRealm:realm withValue:@[@"b", @1]];
+    PrimaryNullableIntObject *nullIntObj = [PrimaryNullableIntObject createInRealm:realm withValue:@[NSNull.null]];
+    [realm commitWriteTransaction];
+
+    NSArray *objects = [realm objectsWithClassName:@"PrimaryStringObject"
+                                    forPrimaryKeys:@[@"b", @"z", @"a", @"b"]];
+    XCTAssertEqual(objects.count, 4U);
+    XCTAssertEqualObjects(objects[0], b);
+    XCTAssertEqualObjects(objects[1], NSNull.null);
+    XCTAssertEqualObjects(objects[2], a);
+    XCTAssertEqualObjects(objects[3], b);
+
+    objects = [realm objectsWithClassName:@"PrimaryNullableIntObject" forPrimaryKeys:@[@1, NSNull.null]];
+    XCTAssertEqualObjects(objects, (@[NSNull.null, nullIntObj]));
+    XCTAssertEqualObjects([realm objectsWithClassName:@"PrimaryIntObject" forPrimaryKeys:@[]], @[]);
+
+    RLMAssertThrowsWithReason([realm objectsWithClassName:@"StringObject" forPrimaryKeys:@[@""]],
+                              @"does not have a primary key");
+    RLMAssertThrowsWithReasonMatching([realm objectsWithClassName:@"PrimaryStringObject" forPrimaryKeys:@[@"a", @0]],
+                                      @"Invalid value '0' of type '.*Number.*' for 'string' property 'PrimaryStringObject.stringCol'.");
+}
+
 - (void)testClassExtension {
     RLMRealm *realm = [RLMRealm defaultRealm];
 
@@ -1505,6 +1564,39 @@ static IntObject *managedObject() {
     }
 }
 
+- (void)testPrimaryKeyObjectHashing {
+    RLMRealm *realm = RLMRealm.defaultRealm;
+    [realm transactionWithBlock:^{
+        for (int i = 0; i < 200; ++i) {
+            [PrimaryIntObject createInRealm:realm withValue:@[@(i)]];
+        }
+    }];
+
+    NSMutableSet *set = [NSMutableSet new];
+    RLMResults<PrimaryIntObject *> *allObjects = [PrimaryIntObject allObjectsInRealm:realm];
+    for (int i = 0; i < 100; ++i) {
+        [set addObject:allObjects[i]];
+    }
+    // Every read from the Results creates a new accessor object
+    for (PrimaryIntObject *obj in allObjects) {
+        XCTAssertEqual([set containsObject:obj], obj.intCol < 100);
+        XCTAssertEqual([set containsObject:[PrimaryIntObject objectForPrimaryKey:@(obj.intCol)]], obj.intCol < 100);
+    }
+    XCTAssertEqual(set.count, 100U);
+
+    // Unmanaged objects with the same primary key are not equal to managed ones
+    XCTAssertFalse([set containsObject:[[PrimaryIntObject alloc] initWithValue:@[@0]]]);
+
+    // The hash is the same before and after an object is added to the Realm
+    PrimaryIntObject *unmanaged = [[PrimaryIntObject alloc] initWithValue:@[@500]];
+    NSUInteger hash = unmanaged.hash;
+    [realm transactionWithBlock:^{
+        [realm addObject:unmanaged];
+    }];
+    XCTAssertEqual(unmanaged.hash, hash);
+    XCTAssertEqual([PrimaryIntObject objectForPrimaryKey:@500].hash, hash);
+}
+
 - (void)testFreezeInsideWriteTransaction {
     RLMRealm *realm = RLMRealm.defaultRealm;
     [realm beginWriteTransaction];
@@ -1519,6 +1611,40 @@ static IntObject *managedObject() {
     [realm cancelWriteTransaction];
 }
 
+- (void)testFrozenObjectReusesBoxedValues {
+    RLMRealm *realm = RLMRealm.defaultRealm;
+    [realm beginWriteTransaction];
+    [OwnerObject createInRealm:realm withValue:@[@"a", @[@"dog a", @1]]];
+    [OwnerObject createInRealm:realm withValue:@[@"b", NSNull.null]];
+    [realm commitWriteTransaction];
+
+    RLMResults<OwnerObject *> *frozen = [[OwnerObject allObjectsInRealm:realm] freeze];
+    OwnerObject *owner = frozen.firstObject;
+    XCTAssertEqualObjects(owner.name, @"a");
+    XCTAssertEqual(owner.name, owner.name);
+    XCTAssertEqual(owner.dog, owner.dog);
+    XCTAssertEqualObjects(owner.dog.dogName, @"dog a");
+
+    // Values cached for one row must not leak into the next row read with
+    // the same accessor
+    NSMutableArray *names = [NSMutableArray new];
+    NSMutableArray *dogs = [NSMutableArray new];
+    [frozen enumerateWithReusedAccessor:^(OwnerObject *obj, BOOL *stop) {
+        [names addObject:obj.name];
+        [dogs addObject:obj.dog.dogName ?: NSNull.null];
+    }];
+    XCTAssertEqualObjects(names, (@[@"a", @"b"]));
+    XCTAssertEqualObjects(dogs, (@[@"dog a", NSNull.null]));
+
+    // Live objects continue to reflect changes
+    OwnerObject *live = [OwnerObject allObjectsInRealm:realm].firstObject;
+    [realm transactionWithBlock:^{
+        live.name = @"c";
+    }];
+    XCTAssertEqualObjects(live.name, @"c");
+    XCTAssertEqualObjects(owner.name, @"a");
+}
+
 - (void)testThaw {
     IntObject *frozen = [managedObject() freeze];
     XCTAssertTrue([frozen isFrozen]);
@@ -1597,4 +1723,40 @@ static IntObject *managedObject() {
     XCTAssertEqual([[IntObject allObjects] count], 1);
 }
 
+- (void)testDataNoCopyForProperty {
+    RLMRealm *realm = RLMRealm.defaultRealm;
+    NSData *bytes = [@"binary contents" dataUsingEncoding:NSUTF8StringEncoding];
+
+    BinaryObject *unmanaged = [[BinaryObject alloc] initWithValue:@[bytes]];
+    XCTAssertEqualObjects([unmanaged dataNoCopyForProperty:@"binaryCol"], bytes);
+
+    [realm beginWriteTransaction];
+    BinaryObject *binary = [BinaryObject createInRealm:realm withValue:@[bytes]];
+    StringObject *string = [StringObject createInRealm:realm withValue:@[@"string contents"]];
+    StringObject *nullString = [StringObject createInRealm:realm withValue:@[NSNull.null]];
+    StringObject *emptyString = [StringObject createInRealm:realm withValue:@[@""]];
+    XCTAssertEqualObjects([binary dataNoCopyForProperty:@"binaryCol"], bytes);
+    [realm commitWriteTransaction];
+
+    NSData *data = [binary dataNoCopyForProperty:@"binaryCol"];
+    XCTAssertEqualObjects(data, bytes);
+    XCTAssertEqualObjects([string dataNoCopyForProperty:@"stringCol"],
+                          [@"string contents" dataUsingEncoding:NSUTF8StringEncoding]);
+    XCTAssertNil([nullString dataNoCopyForProperty:@"stringCol"]);
+    XCTAssertEqual([emptyString dataNoCopyForProperty:@"stringCol"].length, 0U);
+
+    // The data is pinned to the version it was read from
+    [realm transactionWithBlock:^{
+        binary.binaryCol = [@"new" dataUsingEncoding:NSUTF8StringEncoding];
+    }];
+    XCTAssertEqualObjects(data, bytes);
+    XCTAssertEqualObjects([binary dataNoCopyForProperty:@"binaryCol"], binary.binaryCol);
+
+    RLMAssertThrowsWithReason([binary dataNoCopyForProperty:@"invalid"],
+                              @"Property 'invalid' not found in object of type 'BinaryObject'");
+    IntObject *intObject = [[IntObject alloc] init];
+    RLMAssertThrowsWithReason([intObject dataNoCopyForProperty:@"intCol"],
+                              @"Property 'IntObject.intCol' must be a data or string property");
+}
+
 @end
@@ -17,20 +17,136 @@
 ////////////////////////////////////////////////////////////////////////////
 
 #import "RLMTestCase.h"
+#import "TestUtils.h"
 
+#import "RLMObjectSchema_Private.h"
+#import "RLMObjectStore.h"
 #import "RLMRealm_Dynamic.h"
 #import "RLMRealm_Private.h"
+#import "RLMSchema_Private.h"
+
+#import <mach/mach_time.h>
+#import <malloc/malloc.h>
+#import <objc/runtime.h>
+#import <stdatomic.h>
 
 #if !DEBUG && TARGET_OS_IPHONE && !TARGET_IPHONE_SIMULATOR
 
+static uint64_t RLMNanosecondsNow(void) {
+    static mach_timebase_info_data_t timebase;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info(&timebase);
+    });
+    return mach_absolute_time() * timebase.numer / timebase.denom;
+}
+
+static int RLMCompareSamples(const void *a, const void *b) {
+    uint64_t lhs = *(const uint64_t *)a, rhs = *(const uint64_t *)b;
+    return lhs < rhs ? -1 : lhs > rhs;
+}
+
+// Collects the latencies of individual operations and reports the throughput
+// and latency percentiles, which the averages reported by -measureBlock: hide.
+// -addSample: is not thread-safe, so concurrent benchmarks should record into
+// a recorder per thread and then merge them.
+@interface RLMLatencyRecorder : NSObject
+- (instancetype)initWithName:(NSString *)name;
+- (void)addSample:(uint64_t)nanoseconds;
+- (void)addSampleSince:(uint64_t)start;
+- (void)mergeSamplesFromRecorder:(RLMLatencyRecorder *)recorder;
+- (void)reportWithWallTime:(uint64_t)wallTime;
+@end
+
+@implementation RLMLatencyRecorder {
+    NSString *_name;
+    NSMutableData *_samples;
+}
+
+- (instancetype)initWithName:(NSString *)name {
+    if ((self = [super init])) {
+        _name = name;
+        _samples = [NSMutableData new];
+    }
+    return self;
+}
+
+- (void)addSample:(uint64_t)nanoseconds {
+    [_samples appendBytes:&nanoseconds length:sizeof(nanoseconds)];
+}
+
+- (void)addSampleSince:(uint64_t)start {
+    [self addSample:RLMNanosecondsNow() - start];
+}
+
+- (void)mergeSamplesFromRecorder:(RLMLatencyRecorder *)recorder {
+    @synchronized (self) {
+        [_samples appendData:recorder->_samples];
+    }
+}
+
+- (void)reportWithWallTime:(uint64_t)wallTime {
+    NSUInteger count = _samples.length / sizeof(uint64_t);
+    if (count == 0 || wallTime == 0) {
+        return;
+    }
+    uint64_t *samples = _samples.mutableBytes;
+    qsort(samples, count, sizeof(uint64_t), RLMCompareSamples);
+    NSLog(@"%@: %lu operations, %.0f ops/sec, p50 %.1fus, p99 %.1fus, max %.1fus",
+          _name, (unsigned long)count, count / (wallTime / 1e9),
+          samples[count / 2] / 1e3, samples[MIN(count - 1, count * 99 / 100)] / 1e3,
+          samples[count - 1] / 1e3);
+}
+@end
+
+static void addGeneratedProperty(Class cls, const char *name, const char *type, size_t size, size_t align) {
+    objc_property_attribute_t attrs[] = {
+        {"T", type},
+        {"V", name},
+    };
+    class_addIvar(cls, name, size, (uint8_t)__builtin_ctzl(align), type);
+    class_addProperty(cls, name, attrs, sizeof(attrs) / sizeof(objc_property_attribute_t));
+}
+
+// Create `count` RLMObject subclasses at runtime to stand in for an app with a
+// large model, each with a few properties and a link to the next class. Every
+// call uses new class names so that nothing is reused from earlier calls. The
+// classes opt out of the default schema so that they don't end up in every
+// Realm opened by later tests.
+static NSArray<Class> *RLMCreateGeneratedModelClasses(NSUInteger count) {
+    static int generation = 0;
+    ++generation;
+    NSMutableArray<Class> *classes = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; ++i) {
+        NSString *name = [NSString stringWithFormat:@"GeneratedModel%d_%lu", generation, (unsigned long)i];
+        NSString *linkType = [NSString stringWithFormat:@"@\"GeneratedModel%d_%lu\"",
+                              generation, (unsigned long)((i + 1) % count)];
+        Class cls = objc_allocateClassPair(RLMObject.class, name.UTF8String, 0);
+        addGeneratedProperty(cls, "intCol", "i", sizeof(int), alignof(int));
+        addGeneratedProperty(cls, "doubleCol", "d", sizeof(double), alignof(double));
+        addGeneratedProperty(cls, "stringCol", "@\"NSString\"", sizeof(id), alignof(id));
+        addGeneratedProperty(cls, "dateCol", "@\"NSDate\"", sizeof(id), alignof(id));
+        addGeneratedProperty(cls, "linkCol", linkType.UTF8String, sizeof(id), alignof(id));
+        class_addMethod(object_getClass(cls), @selector(shouldIncludeInDefaultSchema),
+                        imp_implementationWithBlock(^BOOL(__unused Class cls) { return NO; }),
+                        method_getTypeEncoding(class_getClassMethod(RLMObject.class, @selector(shouldIncludeInDefaultSchema))));
+        objc_registerClassPair(cls);
+        [classes addObject:cls];
+    }
+    return classes;
+}
+
 @interface PerformanceTests : RLMTestCase
 @property (nonatomic) dispatch_queue_t queue;
 @property (nonatomic) dispatch_semaphore_t sema;
 @end
 
-static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
+static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm, *s_queryRealm;
 
-@implementation PerformanceTests
+@implementation PerformanceTests {
+    // The benchmark currently being run in benchmark runner mode
+    RLMBenchmark *_benchmark;
+}
 
 + (void)setUp {
     [super setUp];
@@ -41,7 +157,7 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
 }
 
 + (void)tearDown {
-    s_smallRealm = s_mediumRealm = s_largeRealm = nil;
+    s_smallRealm = s_mediumRealm = s_largeRealm = s_queryRealm = nil;
     [RLMRealm resetRealmState];
     [super tearDown];
 }
@@ -50,7 +166,17 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
     // Do nothing, as we need to keep our in-memory realms around between tests
 }
 
+- (void)runBenchmark:(void (^)(void))block automaticallyStartMeasuring:(BOOL)automaticallyStartMeasuring {
+    _benchmark = [[RLMBenchmark alloc] initWithTestCase:self];
+    [_benchmark measureBlock:block automaticallyStartMeasuring:automaticallyStartMeasuring];
+    _benchmark = nil;
+}
+
 - (void)measureBlock:(void (^)(void))block {
+    if (RLMBenchmark.enabled) {
+        [self runBenchmark:block automaticallyStartMeasuring:YES];
+        return;
+    }
     [super measureBlock:^{
         @autoreleasepool {
             block();
@@ -59,6 +185,10 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
 }
 
 - (void)measureMetrics:(NSArray *)metrics automaticallyStartMeasuring:(BOOL)automaticallyStartMeasuring forBlock:(void (^)(void))block {
+    if (RLMBenchmark.enabled) {
+        [self runBenchmark:block automaticallyStartMeasuring:automaticallyStartMeasuring];
+        return;
+    }
     [super measureMetrics:metrics automaticallyStartMeasuring:automaticallyStartMeasuring forBlock:^{
         @autoreleasepool {
             block();
@@ -66,6 +196,32 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
     }];
 }
 
+- (void)measureWithMetrics:(NSArray<id<XCTMetric>> *)metrics block:(void (^)(void))block API_AVAILABLE(ios(13.0)) {
+    if (RLMBenchmark.enabled) {
+        [self runBenchmark:block automaticallyStartMeasuring:YES];
+        return;
+    }
+    [super measureWithMetrics:metrics block:block];
+}
+
+- (void)startMeasuring {
+    if (_benchmark) {
+        [_benchmark startMeasuring];
+    }
+    else {
+        [super startMeasuring];
+    }
+}
+
+- (void)stopMeasuring {
+    if (_benchmark) {
+        [_benchmark stopMeasuring];
+    }
+    else {
+        [super stopMeasuring];
+    }
+}
+
 + (RLMRealm *)createStringObjects:(int)factor {
     RLMRealmConfiguration *config = [RLMRealmConfiguration new];
     config.inMemoryIdentifier = @(factor).stringValue;
@@ -127,6 +283,17 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
     }];
 }
 
+- (void)testInitUnmanagedWithDictionary {
+    NSDictionary *value = @{@"name": @"name", @"age": @30, @"hired": @YES};
+    [self measureBlock:^{
+        for (int i = 0; i < 10000; ++i) {
+            @autoreleasepool {
+                (void)[[EmployeeObject alloc] initWithValue:value];
+            }
+        }
+    }];
+}
+
 - (RLMRealm *)getStringObjects:(int)factor {
     RLMRealmConfiguration *config = [RLMRealmConfiguration new];
     config.inMemoryIdentifier = @(factor).stringValue;
@@ -136,6 +303,59 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
     return [self realmWithTestPath];
 }
 
+- (RLMRealm *)getEncryptedStringObjects:(int)factor {
+    RLMRealmConfiguration *config = [RLMRealmConfiguration new];
+    config.inMemoryIdentifier = @(factor).stringValue;
+    RLMRealm *realm = [RLMRealm realmWithConfiguration:config error:nil];
+    NSData *key = RLMGenerateKey();
+    [NSFileManager.defaultManager removeItemAtURL:RLMTestRealmURL() error:nil];
+    [realm writeCopyToURL:RLMTestRealmURL() encryptionKey:key error:nil];
+
+    RLMRealmConfiguration *encrypted = [RLMRealmConfiguration defaultConfiguration];
+    encrypted.fileURL = RLMTestRealmURL();
+    encrypted.encryptionKey = key;
+    return [RLMRealm realmWithConfiguration:encrypted error:nil];
+}
+
+- (void)testInsertMultipleEncrypted {
+    [self measureMetrics:self.class.defaultPerformanceMetrics automaticallyStartMeasuring:NO forBlock:^{
+        RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+        config.fileURL = RLMTestRealmURL();
+        config.encryptionKey = RLMGenerateKey();
+        RLMRealm *realm = [RLMRealm realmWithConfiguration:config error:nil];
+        [self startMeasuring];
+        [realm beginWriteTransaction];
+        for (int i = 0; i < 5000; ++i) {
+            StringObject *obj = [[StringObject alloc] init];
+            obj.stringCol = @"a";
+            [realm addObject:obj];
+        }
+        [realm commitWriteTransaction];
+        [self stopMeasuring];
+        [self tearDown];
+    }];
+}
+
+- (void)testCountWhereQueryEncrypted {
+    RLMRealm *realm = [self getEncryptedStringObjects:50];
+    [self measureBlock:^{
+        for (int i = 0; i < 50; ++i) {
+            RLMResults *array = [StringObject objectsInRealm:realm where:@"stringCol = 'a'"];
+            [array count];
+        }
+    }];
+}
+
+- (void)testEnumerateAndAccessAllEncrypted {
+    RLMRealm *realm = [self getEncryptedStringObjects:5];
+
+    [self measureBlock:^{
+        for (StringObject *so in [StringObject allObjectsInRealm:realm]) {
+            (void)[so stringCol];
+        }
+    }];
+}
+
 - (void)testCountWhereQuery {
     RLMRealm *realm = [self getStringObjects:50];
     [self measureBlock:^{
@@ -177,6 +397,59 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
     }];
 }
 
+- (void)testAccessorMemoryFootprint {
+    RLMRealm *realm = s_largeRealm;
+    RLMResults *all = [StringObject allObjectsInRealm:realm];
+    NSUInteger count = all.count;
+
+    [self measureBlock:^{
+        NSMutableArray *accessors = [NSMutableArray arrayWithCapacity:count];
+        for (NSUInteger i = 0; i < count; ++i) {
+            [accessors addObject:all[i]];
+        }
+    }];
+
+    StringObject *obj = all.firstObject;
+    NSLog(@"%@: %zu bytes per accessor (%zu bytes instance size)", StringObject.className,
+          malloc_size((__bridge const void *)obj), class_getInstanceSize(obj.class));
+}
+
+// The ObjC counterparts of the Swift accessor benchmarks in
+// SwiftPerformanceTests, using the same properties and iteration counts
+- (void)testPropertyGet {
+    RLMRealm *realm = self.testRealm;
+    [realm beginWriteTransaction];
+    IntAndStringObject *obj = [IntAndStringObject createInRealm:realm withValue:@[@1, @1, @"a", @"b"]];
+    [realm commitWriteTransaction];
+
+    [self measureBlock:^{
+        for (int i = 0; i < 10000; ++i) {
+            (void)obj.intCol;
+            (void)obj.stringCol;
+            (void)obj.optIntCol;
+            (void)obj.optStringCol;
+        }
+    }];
+}
+
+- (void)testPropertySet {
+    RLMRealm *realm = self.testRealm;
+    [realm beginWriteTransaction];
+    IntAndStringObject *obj = [IntAndStringObject createInRealm:realm withValue:@[@1, @1, @"a", @"b"]];
+    [realm commitWriteTransaction];
+
+    [self measureBlock:^{
+        [realm beginWriteTransaction];
+        for (int i = 0; i < 10000; ++i) {
+            obj.intCol = i;
+            obj.stringCol = @"a";
+            obj.optIntCol = @(i);
+            obj.optStringCol = nil;
+        }
+        [realm commitWriteTransaction];
+    }];
+}
+
 - (void)testEnumerateAndAccessAllTV {
     RLMRealm *realm = [self getStringObjects:50];
 
@@ -319,6 +592,239 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
     }];
 }
 
+#pragma mark - Query corpus
+
+// A fixed data set for the query benchmarks. Values are drawn from a seeded
+// generator so every run sees the same data, and names are skewed so that a
+// few are common and most are rare, with a mix of case and diacritics.
++ (RLMRealm *)queryCorpusRealm {
+    if (s_queryRealm) {
+        return s_queryRealm;
+    }
+
+    static NSString *const names[] = {
+        @"Anne", @"anne", @"Zoë", @"Zoe", @"José", @"jose", @"Ann-Marie", @"Björn",
+        @"Bjorn", @"Chloé", @"Daniel", @"Élodie", @"Elodie", @"François", @"Hannah", @"Søren",
+    };
+    const uint32_t nameCount = sizeof(names) / sizeof(names[0]);
+    __block uint32_t seed = 12345;
+    uint32_t (^next)(uint32_t) = ^(uint32_t bound) {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) % bound;
+    };
+    NSString *(^name)(void) = ^{
+        uint32_t r = next(nameCount);
+        return names[r * r / nameCount];
+    };
+
+    RLMRealmConfiguration *config = [RLMRealmConfiguration new];
+    config.inMemoryIdentifier = @"query corpus";
+    RLMRealm *realm = [RLMRealm realmWithConfiguration:config error:nil];
+    [realm beginWriteTransaction];
+    for (int i = 0; i < 500; ++i) {
+        CompanyObject *company = [CompanyObject createInRealm:realm withValue:@{
+            @"name": [NSString stringWithFormat:@"Company %d", i]
+        }];
+        uint32_t employees = 5 + next(30);
+        for (uint32_t j = 0; j < employees; ++j) {
+            EmployeeObject *employee = [EmployeeObject createInRealm:realm withValue:@{
+                @"name": name(), @"age": @(18 + next(48)), @"hired": @(next(10) < 7)
+            }];
+            [company.employees addObject:employee];
+            [company.employeeSet addObject:employee];
+            company.employeeDict[[NSString stringWithFormat:@"%u", j]] = employee;
+        }
+        [LinkToCompanyObject createInRealm:realm withValue:@[company]];
+    }
+    for (int i = 0; i < 5000; ++i) {
+        DictionaryPropertyObject *obj = [DictionaryPropertyObject createInRealm:realm withValue:@{}];
+        uint32_t keys = 1 + next(5);
+        for (uint32_t j = 0; j < keys; ++j) {
+            NSString *key = [NSString stringWithFormat:@"%c", 'a' + j];
+            obj.intDictionary[key] = @(next(100));
+            obj.primitiveStringDictionary[key] = name();
+        }
+    }
+    for (int i = 0; i < 10000; ++i) {
+        id value;
+        switch (next(4)) {
+            case 0: value = @(next(100)); break;
+            case 1: value = @(next(1000) / 10.0); break;
+            case 2: value = name(); break;
+            default: value = NSNull.null; break;
+        }
+        [MixedObject createInRealm:realm withValue:@{@"anyCol": value}];
+    }
+    [realm commitWriteTransaction];
+
+    s_queryRealm = realm;
+    return realm;
+}
+
+// Measures converting the predicates to core queries, which happens when the
+// results are created, separately from running them
+- (void)measureConstructionOfQueries:(NSArray<NSString *> *)formats className:(NSString *)className {
+    RLMRealm *realm = [self.class queryCorpusRealm];
+    NSMutableArray<NSPredicate *> *predicates = [NSMutableArray new];
+    for (NSString *format in formats) {
+        [predicates addObject:[NSPredicate predicateWithFormat:format argumentArray:nil]];
+    }
+    [self measureBlock:^{
+        for (int i = 0; i < 100; ++i) {
+            for (NSPredicate *predicate in predicates) {
+                (void)[realm objects:className withPredicate:predicate];
+            }
+        }
+    }];
+}
+
+// Measures running the queries. Results cache their count, so new results are
+// created for each iteration outside of the measured section.
+- (void)measureEvaluationOfQueries:(NSArray<NSString *> *)formats className:(NSString *)className {
+    RLMRealm *realm = [self.class queryCorpusRealm];
+    [self measureMetrics:self.class.defaultPerformanceMetrics automaticallyStartMeasuring:NO forBlock:^{
+        NSMutableArray<RLMResults *> *results = [NSMutableArray new];
+        for (NSString *format in formats) {
+            [results addObject:[realm objects:className
+                                    withPredicate:[NSPredicate predicateWithFormat:format argumentArray:nil]]];
+        }
+        [self startMeasuring];
+        for (RLMResults *r in results) {
+            (void)r.count;
+        }
+        [self stopMeasuring];
+    }];
+}
+
+static NSArray<NSString *> *stringQueries(void) {
+    return @[
+        @"name == 'Anne'",
+        @"name ==[c] 'anne'",
+        @"name ==[cd] 'jose'",
+        @"name BEGINSWITH[cd] 'zo'",
+        @"name CONTAINS[c] 'ann'",
+        @"name ENDSWITH[d] 'e'",
+        @"name LIKE[c] '*an?e*'",
+    ];
+}
+
+static NSArray<NSString *> *numericQueries(void) {
+    return @[
+        @"age > 40",
+        @"age BETWEEN {25, 40}",
+        @"age IN {20, 30, 40, 50}",
+        @"age > 30 AND hired == YES",
+        @"age < 20 OR age > 60 OR name == 'Hannah'",
+    ];
+}
+
+static NSArray<NSString *> *linkQueries(void) {
+    return @[
+        @"company.name == 'Company 7'",
+        @"company.name BEGINSWITH 'Company 4'",
+        @"ANY company.employees.age > 60",
+        @"ANY company.employees.name ==[cd] 'zoe'",
+    ];
+}
+
+static NSArray<NSString *> *collectionOperatorQueries(void) {
+    return @[
+        @"employees.@count > 20",
+        @"employees.@avg.age > 40",
+        @"employees.@max.age < 50",
+        @"employees.@sum.age > 800",
+        @"employeeSet.@min.age > 20",
+        @"ALL employees.hired == YES",
+    ];
+}
+
+static NSArray<NSString *> *subqueryQueries(void) {
+    return @[
+        @"SUBQUERY(employees, $e, $e.age > 40 AND $e.hired == YES).@count > 5",
+        @"SUBQUERY(employees, $e, $e.name BEGINSWITH[c] 'a').@count == 0",
+        @"SUBQUERY(employeeSet, $e, $e.age BETWEEN {30, 35}).@count > 2",
+    ];
+}
+
+static NSArray<NSString *> *dictionaryQueries(void) {
+    return @[
+        @"intDictionary['a'] > 50",
+        @"ANY intDictionary.@values > 95",
+        @"ANY intDictionary.@keys == 'e'",
+        @"intDictionary.@count > 3",
+        @"intDictionary.@max > 90",
+        @"ANY primitiveStringDictionary.@values ==[cd] 'bjorn'",
+    ];
+}
+
+static NSArray<NSString *> *mixedQueries(void) {
+    return @[
+        @"anyCol == 5",
+        @"anyCol > 50",
+        @"anyCol == 'Anne'",
+        @"anyCol == nil",
+        @"anyCol >= 10 AND anyCol <= 20",
+    ];
+}
+
+- (void)testStringQueryConstruction {
+    [self measureConstructionOfQueries:stringQueries() className:@"EmployeeObject"];
+}
+
+- (void)testStringQueryEvaluation {
+    [self measureEvaluationOfQueries:stringQueries() className:@"EmployeeObject"];
+}
+
+- (void)testNumericQueryConstruction {
+    [self measureConstructionOfQueries:numericQueries() className:@"EmployeeObject"];
+}
+
+- (void)testNumericQueryEvaluation {
+    [self measureEvaluationOfQueries:numericQueries() className:@"EmployeeObject"];
+}
+
+- (void)testLinkQueryConstruction {
+    [self measureConstructionOfQueries:linkQueries() className:@"LinkToCompanyObject"];
+}
+
+- (void)testLinkQueryEvaluation {
+    [self measureEvaluationOfQueries:linkQueries() className:@"LinkToCompanyObject"];
+}
+
+- (void)testCollectionOperatorQueryConstruction {
+    [self measureConstructionOfQueries:collectionOperatorQueries() className:@"CompanyObject"];
+}
+
+- (void)testCollectionOperatorQueryEvaluation {
+    [self measureEvaluationOfQueries:collectionOperatorQueries() className:@"CompanyObject"];
+}
+
+- (void)testSubqueryConstruction {
+    [self measureConstructionOfQueries:subqueryQueries() className:@"CompanyObject"];
+}
+
+- (void)testSubqueryEvaluation {
+    [self measureEvaluationOfQueries:subqueryQueries() className:@"CompanyObject"];
+}
+
+- (void)testDictionaryQueryConstruction {
+    [self measureConstructionOfQueries:dictionaryQueries() className:@"DictionaryPropertyObject"];
+}
+
+- (void)testDictionaryQueryEvaluation {
+    [self measureEvaluationOfQueries:dictionaryQueries() className:@"DictionaryPropertyObject"];
+}
+
+- (void)testMixedQueryConstruction {
+    [self measureConstructionOfQueries:mixedQueries() className:@"MixedObject"];
+}
+
+- (void)testMixedQueryEvaluation {
+    [self measureEvaluationOfQueries:mixedQueries() className:@"MixedObject"];
+}
+
+#pragma mark -
+
 - (void)testDeleteAll {
     [self measureMetrics:self.class.defaultPerformanceMetrics automaticallyStartMeasuring:NO forBlock:^{
         RLMRealm *realm = [self getStringObjects:50];
@@ -331,6 +837,29 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
     }];
 }
 
+- (void)testAsyncCompact {
+    [self measureMetrics:self.class.defaultPerformanceMetrics automaticallyStartMeasuring:NO forBlock:^{
+        @autoreleasepool {
+            RLMRealm *realm = [self getStringObjects:50];
+            [realm transactionWithBlock:^{
+                [realm deleteObjects:[StringObject objectsInRealm:realm where:@"stringCol = 'a'"]];
+            }];
+        }
+        RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+        config.fileURL = RLMTestRealmURL();
+        XCTestExpectation *expectation = [self expectationWithDescription:@"compacted"];
+
+        [self startMeasuring];
+        [RLMRealm asyncCompactWithConfiguration:config callbackQueue:dispatch_get_main_queue()
+                                       callback:^(BOOL compacted, __unused NSError *error) {
+            XCTAssertTrue(compacted);
+            [expectation fulfill];
+        }];
+        [self waitForExpectationsWithTimeout:10.0 handler:nil];
+        [self stopMeasuring];
+    }];
+}
+
 - (void)testQueryDeletion {
     [self measureMetrics:self.class.defaultPerformanceMetrics automaticallyStartMeasuring:NO forBlock:^{
         RLMRealm *realm = [self getStringObjects:5];
@@ -407,6 +936,80 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
     }];
 }
 
+- (RLMRealm *)realmWithObjectLists {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    for (int i = 0; i < 1000; ++i) {
+        NSMutableArray *ints = [NSMutableArray arrayWithCapacity:20];
+        for (int j = 0; j < 20; ++j) {
+            [ints addObject:@[@(i % 100 + j)]];
+        }
+        [ArrayPropertyObject createInRealm:realm withValue:@[@"name", @[], ints]];
+    }
+    [realm commitWriteTransaction];
+    return realm;
+}
+
+- (void)testSubqueryCountGreaterThanZero {
+    RLMRealm *realm = [self realmWithObjectLists];
+    [self measureBlock:^{
+        (void)[ArrayPropertyObject objectsInRealm:realm
+                                            where:@"SUBQUERY(intArray, $i, $i.intCol > 100).@count > 0"].count;
+    }];
+}
+
+- (void)testSubqueryCountCompound {
+    RLMRealm *realm = [self realmWithObjectLists];
+    [self measureBlock:^{
+        (void)[ArrayPropertyObject objectsInRealm:realm
+                                            where:@"SUBQUERY(intArray, $i, $i.intCol > 50 AND $i.intCol < 60).@count > 5"].count;
+    }];
+}
+
+- (void)testListAggregateQuery {
+    RLMRealm *realm = [self realmWithObjectLists];
+    [self measureBlock:^{
+        (void)[ArrayPropertyObject objectsInRealm:realm where:@"intArray.@sum.intCol > 1000"].count;
+        (void)[ArrayPropertyObject objectsInRealm:realm where:@"intArray.@max.intCol > 100"].count;
+    }];
+}
+
+- (void)testPrimitiveListAggregateQuery {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    for (int i = 0; i < 1000; ++i) {
+        NSMutableArray *ints = [NSMutableArray arrayWithCapacity:20];
+        for (int j = 0; j < 20; ++j) {
+            [ints addObject:@(i % 100 + j)];
+        }
+        [AllPrimitiveArrays createInRealm:realm withValue:@{@"intObj": ints}];
+    }
+    [realm commitWriteTransaction];
+
+    [self measureBlock:^{
+        (void)[AllPrimitiveArrays objectsInRealm:realm where:@"intObj.@sum > 1000"].count;
+        (void)[AllPrimitiveArrays objectsInRealm:realm where:@"intObj.@avg > 50"].count;
+        (void)[AllPrimitiveArrays objectsInRealm:realm where:@"ANY intObj > 110"].count;
+    }];
+}
+
+- (void)testLargeINQueryOnPrimaryKey {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    NSMutableArray *ids = [NSMutableArray arrayWithCapacity:10000];
+    for (int i = 0; i < 20000; ++i) {
+        [PrimaryIntObject createInRealm:realm withValue:@[@(i)]];
+        if (i % 2) {
+            [ids addObject:@(i)];
+        }
+    }
+    [realm commitWriteTransaction];
+
+    [self measureBlock:^{
+        (void)[[PrimaryIntObject objectsInRealm:realm where:@"intCol IN %@", ids] count];
+    }];
+}
+
 - (void)testSortingAllObjects {
     RLMRealm *realm = self.realmWithTestPath;
     [realm beginWriteTransaction];
@@ -436,6 +1039,31 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
     [realm configuration];
 }
 
+- (void)testRealmCreationCachedMultipleThreads {
+    __block RLMRealm *realm;
+    [self dispatchAsyncAndWait:^{
+        realm = [self realmWithTestPath]; // ensure a cached realm for the path
+    }];
+
+    dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+    [self measureBlock:^{
+        dispatch_apply(8, queue, ^(__unused size_t i) {
+            @autoreleasepool {
+                // Keep a Realm open on this thread so that all of the
+                // subsequent calls are cache hits
+                RLMRealm *threadRealm = [self realmWithTestPath];
+                for (int j = 0; j < 250; ++j) {
+                    @autoreleasepool {
+                        [self realmWithTestPath];
+                    }
+                }
+                [threadRealm configuration];
+            }
+        });
+    }];
+    [realm configuration];
+}
+
 - (void)testRealmCreationUncached {
     [self measureBlock:^{
         for (int i = 0; i < 50; ++i) {
@@ -446,6 +1074,52 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
     }];
 }
 
+- (void)testSchemaDiscoveryWithManyClasses {
+    [self measureMetrics:self.class.defaultPerformanceMetrics automaticallyStartMeasuring:NO forBlock:^{
+        NSArray<Class> *classes = RLMCreateGeneratedModelClasses(500);
+        [self startMeasuring];
+        (void)[RLMSchema schemaWithObjectClasses:classes];
+        [self stopMeasuring];
+    }];
+}
+
+- (void)testClassListScanWithManyClasses {
+    // Looking up a name which isn't a known class scans every class in the
+    // process, which is the same work the first use of the shared schema does
+    RLMCreateGeneratedModelClasses(500);
+    [self measureBlock:^{
+        for (int i = 0; i < 10; ++i) {
+            (void)[RLMSchema classForString:@"NotAModelClass"];
+        }
+    }];
+}
+
+- (void)testAccessorCreationWithManyClasses {
+    [self measureMetrics:self.class.defaultPerformanceMetrics automaticallyStartMeasuring:NO forBlock:^{
+        RLMSchema *schema = [RLMSchema schemaWithObjectClasses:RLMCreateGeneratedModelClasses(500)];
+        // Accessor classes are generated lazily on first use after this
+        RLMRealmCreateAccessors(schema);
+        [self startMeasuring];
+        for (RLMObjectSchema *objectSchema in schema.objectSchema) {
+            (void)objectSchema.accessorClass;
+        }
+        [self stopMeasuring];
+    }];
+}
+
+- (void)testFirstOpenWithManyClasses {
+    [self measureMetrics:self.class.defaultPerformanceMetrics automaticallyStartMeasuring:NO forBlock:^{
+        RLMRealmConfiguration *config = [RLMRealmConfiguration new];
+        config.inMemoryIdentifier = NSUUID.UUID.UUIDString;
+        config.objectClasses = RLMCreateGeneratedModelClasses(500);
+        [self startMeasuring];
+        @autoreleasepool {
+            (void)[RLMRealm realmWithConfiguration:config error:nil];
+        }
+        [self stopMeasuring];
+    }];
+}
+
 - (void)testRealmFileCreation {
     RLMRealmConfiguration *config = [RLMRealmConfiguration new];
     __block int measurement = 0;
@@ -461,6 +1135,27 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
     }];
 }
 
+- (void)testInMemoryRealmCreationWithSingleClass {
+    // Scratch Realms usually only need a few types, and creating the tables
+    // for the full test schema dominates testRealmFileCreation
+    RLMRealmConfiguration *config = [RLMRealmConfiguration new];
+    config.objectClasses = @[StringObject.class];
+    __block int measurement = 0;
+    const int iterations = 10;
+    [self measureBlock:^{
+        for (int i = 0; i < iterations; ++i) {
+            @autoreleasepool {
+                config.inMemoryIdentifier = [NSString stringWithFormat:@"single-%d", measurement * iterations + i];
+                RLMRealm *realm = [RLMRealm realmWithConfiguration:config error:nil];
+                [realm transactionWithBlock:^{
+                    [StringObject createInRealm:realm withValue:@[@"a"]];
+                }];
+            }
+        }
+        ++measurement;
+    }];
+}
+
 - (void)testInvalidateRefresh {
     RLMRealm *realm = [self testRealm];
     [self measureBlock:^{
@@ -650,6 +1345,304 @@ static RLMRealm *s_smallRealm, *s_mediumRealm, *s_largeRealm;
     }];
 }
 
+#pragma mark - Concurrency
+
+- (void)testConcurrentReaderScaling {
+    [self getStringObjects:5];
+    dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+
+    for (size_t threadCount = 1; threadCount <= 8; threadCount *= 2) {
+        RLMLatencyRecorder *recorder = [[RLMLatencyRecorder alloc] initWithName:
+                                        [NSString stringWithFormat:@"Query with %zu reader threads", threadCount]];
+        uint64_t start = RLMNanosecondsNow();
+        dispatch_apply(threadCount, queue, ^(__unused size_t i) {
+            @autoreleasepool {
+                RLMLatencyRecorder *local = [[RLMLatencyRecorder alloc] initWithName:@""];
+                RLMRealm *realm = [self realmWithTestPath];
+                for (int j = 0; j < 200; ++j) {
+                    @autoreleasepool {
+                        uint64_t opStart = RLMNanosecondsNow();
+                        (void)[[StringObject objectsInRealm:realm where:@"stringCol = 'a'"] count];
+                        [local addSampleSince:opStart];
+                    }
+                }
+                [recorder mergeSamplesFromRecorder:local];
+            }
+        });
+        [recorder reportWithWallTime:RLMNanosecondsNow() - start];
+    }
+}
+
+static atomic_bool s_writerDone;
+
+- (void)testWriterReaderContention {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    IntObject *obj = [IntObject createInRealm:realm withValue:@[@0]];
+    [realm commitWriteTransaction];
+
+    const int readerCount = 4;
+    RLMLatencyRecorder *readers = [[RLMLatencyRecorder alloc] initWithName:
+                                   [NSString stringWithFormat:@"Refresh and read with %d readers and one writer", readerCount]];
+    RLMLatencyRecorder *writer = [[RLMLatencyRecorder alloc] initWithName:
+                                  [NSString stringWithFormat:@"Commit with %d concurrent readers", readerCount]];
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+    atomic_store(&s_writerDone, false);
+
+    uint64_t start = RLMNanosecondsNow();
+    for (int i = 0; i < readerCount; ++i) {
+        dispatch_group_async(group, queue, ^{
+            @autoreleasepool {
+                RLMLatencyRecorder *local = [[RLMLatencyRecorder alloc] initWithName:@""];
+                RLMRealm *realm = [self realmWithTestPath];
+                realm.autorefresh = NO;
+                IntObject *obj = [[IntObject allObjectsInRealm:realm] firstObject];
+                while (!atomic_load(&s_writerDone)) {
+                    uint64_t opStart = RLMNanosecondsNow();
+                    [realm refresh];
+                    (void)obj.intCol;
+                    [local addSampleSince:opStart];
+                }
+                [readers mergeSamplesFromRecorder:local];
+            }
+        });
+    }
+
+    for (int i = 0; i < 500; ++i) {
+        uint64_t opStart = RLMNanosecondsNow();
+        [realm transactionWithBlock:^{
+            obj.intCol++;
+        }];
+        [writer addSampleSince:opStart];
+    }
+    atomic_store(&s_writerDone, true);
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+    uint64_t wallTime = RLMNanosecondsNow() - start;
+    [writer reportWithWallTime:wallTime];
+    [readers reportWithWallTime:wallTime];
+}
+
+- (void)testAsyncOpenConcurrency {
+    // Create the file up front so that only opening it is measured
+    @autoreleasepool {
+        [self realmWithTestPath];
+    }
+
+    RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+    config.fileURL = RLMTestRealmURL();
+    dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+
+    const int concurrentOpens = 16;
+    RLMLatencyRecorder *recorder = [[RLMLatencyRecorder alloc] initWithName:
+                                    [NSString stringWithFormat:@"Async open with %d concurrent opens", concurrentOpens]];
+    uint64_t start = RLMNanosecondsNow();
+    for (int round = 0; round < 20; ++round) {
+        @autoreleasepool {
+            dispatch_group_t group = dispatch_group_create();
+            for (int i = 0; i < concurrentOpens; ++i) {
+                dispatch_group_enter(group);
+                uint64_t opStart = RLMNanosecondsNow();
+                [RLMRealm asyncOpenWithConfiguration:config callbackQueue:queue
+                                            callback:^(RLMRealm *realm, NSError *error) {
+                    XCTAssertNotNil(realm);
+                    XCTAssertNil(error);
+                    uint64_t latency = RLMNanosecondsNow() - opStart;
+                    @synchronized (recorder) {
+                        [recorder addSample:latency];
+                    }
+                    dispatch_group_leave(group);
+                }];
+            }
+            dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+        }
+    }
+    [recorder reportWithWallTime:RLMNanosecondsNow() - start];
+}
+
+static _Atomic(uint64_t) s_commitTime;
+
+- (void)testNotificationFanOut {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    IntObject *obj = [IntObject createInRealm:realm withValue:@[@0]];
+    [realm commitWriteTransaction];
+
+    RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+    config.fileURL = RLMTestRealmURL();
+
+    const int queueCount = 8;
+    RLMLatencyRecorder *recorder = [[RLMLatencyRecorder alloc] initWithName:
+                                    [NSString stringWithFormat:@"Notification delivery to %d queues", queueCount]];
+    dispatch_semaphore_t sema = dispatch_semaphore_create(0);
+    NSMutableArray *queues = [NSMutableArray new];
+    NSMutableArray *realms = [NSMutableArray new];
+    NSMutableArray *tokens = [NSMutableArray new];
+    for (int i = 0; i < queueCount; ++i) {
+        dispatch_queue_t queue = dispatch_queue_create("fan out", DISPATCH_QUEUE_SERIAL);
+        [queues addObject:queue];
+        dispatch_sync(queue, ^{
+            RLMRealm *queueRealm = [RLMRealm realmWithConfiguration:config queue:queue error:nil];
+            RLMNotificationToken *token = [queueRealm addNotificationBlock:^(__unused NSString *note, __unused RLMRealm *realm) {
+                uint64_t latency = RLMNanosecondsNow() - atomic_load(&s_commitTime);
+                @synchronized (recorder) {
+                    [recorder addSample:latency];
+                }
+                dispatch_semaphore_signal(sema);
+            }];
+            [realms addObject:queueRealm];
+            [tokens addObject:token];
+        });
+    }
+
+    uint64_t start = RLMNanosecondsNow();
+    for (int i = 0; i < 100; ++i) {
+        [realm beginWriteTransaction];
+        obj.intCol++;
+        atomic_store(&s_commitTime, RLMNanosecondsNow());
+        [realm commitWriteTransaction];
+        for (int j = 0; j < queueCount; ++j) {
+            dispatch_semaphore_wait(sema, DISPATCH_TIME_FOREVER);
+        }
+    }
+    [recorder reportWithWallTime:RLMNanosecondsNow() - start];
+
+    for (int i = 0; i < queueCount; ++i) {
+        dispatch_sync(queues[i], ^{
+            [(RLMNotificationToken *)tokens[i] invalidate];
+            [realms replaceObjectAtIndex:i withObject:NSNull.null];
+        });
+    }
+}
+
+// Measures the peak memory used by `block` with XCTMemoryMetric, and reports
+// the average number of allocations and bytes which are still live once the
+// block's autorelease pool has been drained, per operation. The malloc zone
+// statistics only count live allocations, so memory which is allocated and
+// freed within the block shows up in the peak but not in the counts.
+- (void)measureMemoryWithName:(NSString *)name operations:(NSUInteger)operations block:(void (^)(void))block {
+    __block int64_t blocks = 0, bytes = 0, iterations = 0;
+    void (^measured)(void) = ^{
+        malloc_statistics_t before, after;
+        malloc_zone_statistics(NULL, &before);
+        @autoreleasepool {
+            block();
+        }
+        malloc_zone_statistics(NULL, &after);
+        blocks += (int64_t)after.blocks_in_use - (int64_t)before.blocks_in_use;
+        bytes += (int64_t)after.size_in_use - (int64_t)before.size_in_use;
+        ++iterations;
+    };
+    if (@available(iOS 13.0, *)) {
+        [self measureWithMetrics:@[[XCTMemoryMetric new], [XCTClockMetric new]] block:measured];
+    }
+    else {
+        [self measureBlock:measured];
+    }
+    double divisor = (double)MAX(iterations, 1) * MAX(operations, 1U);
+    NSLog(@"%@: %.2f allocations and %.1f bytes retained per operation",
+          name, blocks / divisor, bytes / divisor);
+}
+
+- (void)testEnumerationMemory {
+    RLMRealm *realm = [self getStringObjects:50];
+    RLMResults *all = [StringObject allObjectsInRealm:realm];
+    [self measureMemoryWithName:@"Enumeration" operations:all.count block:^{
+        for (StringObject *so in all) {
+            (void)[so stringCol];
+        }
+    }];
+}
+
+- (void)testEnumerationMemoryWithAutoreleasePool {
+    RLMRealm *realm = [self getStringObjects:50];
+    RLMResults *all = [StringObject allObjectsInRealm:realm];
+    [self measureMemoryWithName:@"Enumeration with autorelease pool" operations:all.count block:^{
+        for (StringObject *so in all) {
+            @autoreleasepool {
+                (void)[so stringCol];
+            }
+        }
+    }];
+}
+
+- (void)testValueForKeyMemory {
+    RLMRealm *realm = [self getStringObjects:50];
+    RLMResults *all = [StringObject allObjectsInRealm:realm];
+    [self measureMemoryWithName:@"valueForKey:" operations:all.count block:^{
+        (void)[all valueForKey:@"stringCol"];
+    }];
+}
+
+- (void)testCollectionOperatorMemory {
+    RLMRealm *realm = self.testRealm;
+    [realm beginWriteTransaction];
+    for (int i = 0; i < 10000; ++i) {
+        [IntObject createInRealm:realm withValue:@[@(i)]];
+    }
+    [realm commitWriteTransaction];
+
+    RLMResults *all = [IntObject allObjectsInRealm:realm];
+    [self measureMemoryWithName:@"KVC collection operators" operations:all.count block:^{
+        (void)[all valueForKeyPath:@"@sum.intCol"];
+        (void)[all valueForKeyPath:@"@max.intCol"];
+        (void)[all valueForKeyPath:@"@avg.intCol"];
+    }];
+
+    [realm beginWriteTransaction];
+    [realm deleteAllObjects];
+    [realm commitWriteTransaction];
+}
+
+- (void)testObjectCreationMemory {
+    RLMRealm *realm = self.testRealm;
+    [self measureMemoryWithName:@"Object creation" operations:10000 block:^{
+        [realm beginWriteTransaction];
+        for (int i = 0; i < 10000; ++i) {
+            [StringObject createInRealm:realm withValue:@[@"a"]];
+        }
+        [realm cancelWriteTransaction];
+    }];
+}
+
+- (void)testNotificationMemory {
+    RLMRealm *realm = self.testRealm;
+    [realm beginWriteTransaction];
+    IntObject *obj = [IntObject createInRealm:realm withValue:@[@0]];
+    [realm commitWriteTransaction];
+
+    RLMNotificationToken *token = [[IntObject allObjectsInRealm:realm]
+                                   addNotificationBlock:^(__unused RLMResults *results, __unused RLMCollectionChange *change,
+                                                          __unused NSError *error) {}];
+    [self measureMemoryWithName:@"Results notifications" operations:100 block:^{
+        for (int i = 0; i < 100; ++i) {
+            [realm transactionWithBlock:^{
+                obj.intCol++;
+            }];
+        }
+    }];
+    [token invalidate];
+
+    [realm beginWriteTransaction];
+    [realm deleteAllObjects];
+    [realm commitWriteTransaction];
+}
+
+- (void)testExtendedJSONDecodingMemory {
+    NSMutableString *json = [NSMutableString stringWithString:@"["];
+    for (int i = 0; i < 1000; ++i) {
+        [json appendFormat:@"%@{\"_id\":{\"$oid\":\"%024x\"},\"name\":\"document %d\","
+         "\"count\":{\"$numberLong\":\"%d\"},\"tags\":[\"a\",\"b\",\"c\"],"
+         "\"nested\":{\"value\":{\"$numberDouble\":\"%d.5\"}}}", i ? @"," : @"", i, i, i, i];
+    }
+    [json appendString:@"]"];
+
+    [self measureMemoryWithName:@"Extended JSON decoding" operations:1000 block:^{
+        (void)RLMBSONFromExtendedJSON(json);
+    }];
+}
+
 - (void)testArrayKVOIndexHandlingRemoveForward {
     [self measureMetrics:self.class.defaultPerformanceMetrics automaticallyStartMeasuring:NO forBlock:^{
         RLMRealm *realm = [self getStringObjects:50];
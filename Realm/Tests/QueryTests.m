@@ -364,11 +364,13 @@
 
 - (void)testStringUnsupportedOperations
 {
-    XCTAssertThrows([StringObject objectsWhere:@"stringCol MATCHES 'abc'"]);
+    XCTAssertThrows([StringObject objectsWhere:@"stringCol MATCHES[d] 'abc'"]);
+    XCTAssertThrows([StringObject objectsWhere:@"stringCol MATCHES 'a('"]);
+    XCTAssertThrows([StringObject objectsWhere:@"stringCol MATCHES stringCol"]);
     XCTAssertThrows([StringObject objectsWhere:@"stringCol BETWEEN {'a', 'b'}"]);
     XCTAssertThrows([StringObject objectsWhere:@"stringCol < 'abc'"]);
 
-    XCTAssertThrows([AllTypesObject objectsWhere:@"objectCol.stringCol MATCHES 'abc'"]);
+    XCTAssertThrows([AllTypesObject objectsWhere:@"objectCol.stringCol MATCHES[d] 'abc'"]);
     XCTAssertThrows([AllTypesObject objectsWhere:@"objectCol.stringCol BETWEEN {'a', 'b'}"]);
     XCTAssertThrows([AllTypesObject objectsWhere:@"objectCol.stringCol < 'abc'"]);
 }
@@ -481,6 +483,71 @@
     XCTAssertEqualObjects([results[0] name], @"Tim", @"Tim should be first results");
 }
 
+- (void)testRepeatedQuery {
+    RLMRealm *realm = [self realm];
+
+    [realm beginWriteTransaction];
+    [PersonObject createInRealm:realm withValue:@[@"Fiel", @27]];
+    [PersonObject createInRealm:realm withValue:@[@"Ari", @33]];
+    [realm commitWriteTransaction];
+
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"age > %@", @28];
+    XCTAssertEqual(1U, [PersonObject objectsInRealm:realm withPredicate:predicate].count);
+    XCTAssertEqual(1U, [PersonObject objectsInRealm:realm withPredicate:[predicate copy]].count);
+    XCTAssertEqual(2U, [PersonObject objectsInRealm:realm where:@"age > %@", @20].count);
+
+    // Queries must still be valid after the read transaction is reopened
+    [realm invalidate];
+    XCTAssertEqual(1U, [PersonObject objectsInRealm:realm withPredicate:predicate].count);
+
+    // Mutating a constant in the predicate must change the results
+    NSMutableString *name = [@"Ari" mutableCopy];
+    predicate = [NSPredicate predicateWithFormat:@"name = %@", name];
+    XCTAssertEqual(1U, [PersonObject objectsInRealm:realm withPredicate:predicate].count);
+    [name setString:@"Fiel"];
+    XCTAssertEqualObjects(@"Fiel", [[PersonObject objectsInRealm:realm withPredicate:predicate].firstObject name]);
+}
+
+- (void)testPreparedQuery {
+    RLMRealm *realm = [self realm];
+
+    [realm beginWriteTransaction];
+    [PersonObject createInRealm:realm withValue:@[@"Fiel", @27]];
+    [PersonObject createInRealm:realm withValue:@[@"Ari", @33]];
+    [PersonObject createInRealm:realm withValue:@[@"Tim", @29]];
+    [realm commitWriteTransaction];
+
+    RLMPreparedQuery *query = [RLMPreparedQuery queryWithClassName:@"PersonObject"
+                                                   predicateFormat:@"age > $1 AND name != $0 AND name != '$2'"];
+    XCTAssertEqual(2U, query.numberOfArguments);
+    XCTAssertEqual(1U, [query resultsInRealm:realm withArguments:@[@"Ari", @28]].count);
+    XCTAssertEqual(3U, [query resultsInRealm:realm withArguments:@[@"", @0]].count);
+    XCTAssertEqual(0U, [query resultsInRealm:realm withArguments:@[@"Tim", @40]].count);
+
+    RLMAssertThrowsWithReason([query resultsInRealm:realm withArguments:@[@1]],
+                              @"requires 2 arguments but 1 were given");
+    RLMAssertThrowsWithReason([query resultsInRealm:realm withArguments:@[@1, @2]],
+                              @"Expected object of type string");
+
+    query = [RLMPreparedQuery queryWithClassName:@"PersonObject" predicateFormat:@"age > 30"];
+    XCTAssertEqual(0U, query.numberOfArguments);
+    XCTAssertEqual(1U, [query resultsInRealm:realm withArguments:@[]].count);
+
+    // Queries which only compare properties with arguments are bound without
+    // going through the predicate again
+    query = [RLMPreparedQuery queryWithClassName:@"PersonObject"
+                                 predicateFormat:@"($0 < age AND age <= $1) OR NOT name != $2"];
+    NSArray *(^names)(NSArray *) = ^(NSArray *arguments) {
+        RLMResults *results = [query resultsInRealm:realm withArguments:arguments];
+        return [[results sortedResultsUsingKeyPath:@"age" ascending:YES] valueForKey:@"name"];
+    };
+    XCTAssertEqualObjects(names(@[@28, @30, @"Ari"]), (@[@"Tim", @"Ari"]));
+    XCTAssertEqualObjects(names(@[@20, @28, @"Tim"]), (@[@"Fiel", @"Tim"]));
+    XCTAssertEqualObjects(names(@[@40, @50, NSNull.null]), (@[]));
+    RLMAssertThrowsWithReason([query resultsInRealm:realm withArguments:@[@1, @2, @3]],
+                              @"Expected object of type string");
+}
+
 - (void)testQueryBetween {
     RLMRealm *realm = [self realm];
 
@@ -1469,6 +1536,111 @@
     testBlock(@"mixedObjectCol", @"anyCol", [MixedObject class]);
 }
 
+- (void)testExplain
+{
+    RLMRealm *realm = [self realm];
+
+    [realm beginWriteTransaction];
+    [IndexedStringObject createInRealm:realm withValue:@[@"a"]];
+    [IndexedStringObject createInRealm:realm withValue:@[@"b"]];
+    [realm commitWriteTransaction];
+
+    NSString *explanation = [[[IndexedStringObject objectsInRealm:realm where:@"stringCol = 'a'"]
+                              sortedResultsUsingKeyPath:@"stringCol" ascending:NO] explain];
+    XCTAssertTrue([explanation containsString:@"stringCol == \"a\""], @"%@", explanation);
+    XCTAssertTrue([explanation containsString:@"SORT(stringCol DESC)"], @"%@", explanation);
+    XCTAssertTrue([explanation containsString:@"indexedProperties = [stringCol]"], @"%@", explanation);
+    XCTAssertTrue([explanation containsString:@"matchedCount = 1;"], @"%@", explanation);
+    XCTAssertTrue([explanation containsString:@"objectCount = 2;"], @"%@", explanation);
+}
+
+- (void)testCompoundPredicateTermsAreOrderedByCost
+{
+    RLMRealm *realm = [self realm];
+
+    [realm beginWriteTransaction];
+    [IndexedStringObject createInRealm:realm withValue:@[@"abc"]];
+    [IndexedStringObject createInRealm:realm withValue:@[@"ábc"]];
+    [realm commitWriteTransaction];
+
+    RLMResults *results = [IndexedStringObject objectsInRealm:realm
+                                                        where:@"stringCol CONTAINS[cd] 'B' AND stringCol == 'abc'"];
+    XCTAssertEqual(results.count, 1U);
+    NSString *explanation = results.explain;
+    NSRange equality = [explanation rangeOfString:@"stringCol == \"abc\""];
+    NSRange contains = [explanation rangeOfString:@"CONTAINS[cd]"];
+    XCTAssertNotEqual(equality.location, NSNotFound, @"%@", explanation);
+    XCTAssertNotEqual(contains.location, NSNotFound, @"%@", explanation);
+    XCTAssertLessThan(equality.location, contains.location, @"%@", explanation);
+
+    RLMAssertCount(IndexedStringObject, 2U, @"stringCol CONTAINS[cd] 'B' OR stringCol == 'abc'");
+    RLMAssertCount(IndexedStringObject, 1U, @"stringCol CONTAINS[c] 'B' AND NOT stringCol == 'ábc'");
+}
+
+- (void)testStringMatches
+{
+    RLMRealm *realm = [self realm];
+
+    [realm beginWriteTransaction];
+    StringObject *so = [StringObject createInRealm:realm withValue:@[@"abc"]];
+    [StringObject createInRealm:realm withValue:@[@"abd"]];
+    [StringObject createInRealm:realm withValue:@[@"ABC"]];
+    [StringObject createInRealm:realm withValue:@[@"xabc"]];
+    [StringObject createInRealm:realm withValue:@[@"üvw"]];
+    [StringObject createInRealm:realm withValue:@[@""]];
+    [AllTypesObject createInRealm:realm withValue:[AllTypesObject values:1 stringObject:so]];
+    [realm commitWriteTransaction];
+
+    RLMAssertCount(StringObject, 1U, @"stringCol MATCHES 'abc'");
+    RLMAssertCount(StringObject, 2U, @"stringCol MATCHES[c] 'abc'");
+    RLMAssertCount(StringObject, 2U, @"stringCol MATCHES 'ab.'");
+    RLMAssertCount(StringObject, 3U, @"stringCol MATCHES[c] 'ab[cd]'");
+    RLMAssertCount(StringObject, 0U, @"stringCol MATCHES 'ab'");
+    RLMAssertCount(StringObject, 2U, @"stringCol MATCHES '.*bc'");
+    RLMAssertCount(StringObject, 2U, @"stringCol MATCHES 'x?abc'");
+    RLMAssertCount(StringObject, 2U, @"stringCol MATCHES 'abc|abd'");
+    RLMAssertCount(StringObject, 1U, @"stringCol MATCHES 'a|ab|abc'");
+    RLMAssertCount(StringObject, 1U, @"stringCol MATCHES '\\\\w{3}' && stringCol BEGINSWITH 'ü'");
+    RLMAssertCount(StringObject, 1U, @"stringCol MATCHES ''");
+    RLMAssertCount(StringObject, 0U, @"stringCol MATCHES NULL");
+    RLMAssertCount(StringObject, 5U, @"NOT stringCol MATCHES 'abc'");
+
+    RLMAssertCount(AllTypesObject, 1U, @"objectCol.stringCol MATCHES 'a.c'");
+    RLMAssertCount(AllTypesObject, 0U, @"objectCol.stringCol MATCHES 'a.d'");
+}
+
+- (void)testDiacriticInsensitiveLongStrings
+{
+    RLMRealm *realm = [self realm];
+
+    [realm beginWriteTransaction];
+    [StringObject createInRealm:realm withValue:@[@"The quick brown fox jumps over the lazy dog"]];
+    [StringObject createInRealm:realm withValue:@[@"THE QUICK BROWN FOX"]];
+    [StringObject createInRealm:realm withValue:@[@"The quick brown fox jumps over the lazy dög"]];
+    [StringObject createInRealm:realm withValue:@[@"Thé quick"]];
+    [realm commitWriteTransaction];
+
+    RLMAssertCount(StringObject, 2U, @"stringCol ==[d] 'The quick brown fox jumps over the lazy dog'");
+    RLMAssertCount(StringObject, 1U, @"stringCol ==[d] 'THE QUICK BROWN FOX'");
+    RLMAssertCount(StringObject, 1U, @"stringCol ==[cd] 'the quick brown fox'");
+    RLMAssertCount(StringObject, 0U, @"stringCol ==[cd] 'the quick brown fo'");
+    RLMAssertCount(StringObject, 3U, @"stringCol !=[cd] 'the quick brown fox'");
+
+    RLMAssertCount(StringObject, 3U, @"stringCol BEGINSWITH[d] 'The quick'");
+    RLMAssertCount(StringObject, 4U, @"stringCol BEGINSWITH[cd] 'the quick'");
+    RLMAssertCount(StringObject, 0U, @"stringCol BEGINSWITH[cd] 'quick'");
+
+    RLMAssertCount(StringObject, 2U, @"stringCol ENDSWITH[d] 'lazy dog'");
+    RLMAssertCount(StringObject, 2U, @"stringCol ENDSWITH[cd] 'LAZY DOG'");
+    RLMAssertCount(StringObject, 1U, @"stringCol ENDSWITH[cd] 'brown fox'");
+
+    RLMAssertCount(StringObject, 2U, @"stringCol CONTAINS[d] 'brown fox'");
+    RLMAssertCount(StringObject, 2U, @"stringCol CONTAINS[d] 'fox jumps'");
+    RLMAssertCount(StringObject, 3U, @"stringCol CONTAINS[cd] 'BROWN FOX'");
+    RLMAssertCount(StringObject, 0U, @"stringCol CONTAINS[cd] 'brown dog'");
+    RLMAssertCount(StringObject, 0U, @"stringCol CONTAINS[cd] 'the quick brown fox jumps over the lazy dog!'");
+}
+
 - (void)testStringLike
 {
     RLMRealm *realm = [self realm];
@@ -2444,6 +2616,39 @@
     [self testClass:[AllTypesObject class] withNormalCount:1U notCount:0U where:@"anyCol IN %@", @[@1, @2]];
 }
 
+- (void)testINPredicateOnIndexedProperties {
+    RLMRealm *realm = [self realm];
+
+    [realm beginWriteTransaction];
+    for (int i = 0; i < 10; ++i) {
+        [PrimaryIntObject createInRealm:realm withValue:@[@(i)]];
+        [PrimaryStringObject createInRealm:realm withValue:@[[NSString stringWithFormat:@"%d", i], @(i)]];
+        [PrimaryNullableIntObject createInRealm:realm withValue:@[@(i), @(i)]];
+        [IndexedStringObject createInRealm:realm withValue:@[i % 2 ? @"odd" : @"even"]];
+    }
+    [PrimaryNullableIntObject createInRealm:realm withValue:@[NSNull.null, @10]];
+    [realm commitWriteTransaction];
+
+    RLMAssertCount(PrimaryIntObject, 3U, @"intCol IN %@", @[@1, @3, @5]);
+    RLMAssertCount(PrimaryIntObject, 3U, @"intCol IN %@", @[@5, @1, @3, @1, @5]);
+    RLMAssertCount(PrimaryIntObject, 1U, @"intCol IN %@", [NSSet setWithObjects:@2, @20, nil]);
+    RLMAssertCount(PrimaryIntObject, 0U, @"intCol IN %@", @[]);
+    RLMAssertCount(PrimaryIntObject, 7U, @"NOT intCol IN %@", @[@1, @3, @3]);
+    RLMAssertCount(PrimaryIntObject, 2U, @"intCol IN %@ AND intCol < 6", @[@1, @3, @7]);
+
+    RLMAssertCount(PrimaryStringObject, 2U, @"stringCol IN %@", @[@"1", @"9", @"9", @"a"]);
+
+    RLMAssertCount(PrimaryNullableIntObject, 2U, @"optIntCol IN %@", @[@1, NSNull.null]);
+    RLMAssertCount(PrimaryNullableIntObject, 1U, @"optIntCol IN %@", @[NSNull.null, NSNull.null]);
+
+    RLMAssertCount(IndexedStringObject, 5U, @"stringCol IN %@", @[@"odd", @"odd"]);
+    RLMAssertCount(IndexedStringObject, 10U, @"stringCol IN %@", @[@"odd", @"even"]);
+    RLMAssertCount(IndexedStringObject, 10U, @"stringCol IN[c] %@", @[@"ODD", @"EVEN"]);
+
+    RLMAssertThrowsWithReason(([PrimaryIntObject objectsInRealm:realm where:@"intCol IN %@", @[@1, @"a"]]),
+                              @"Expected object of type int in IN clause for property 'intCol' on object of type 'PrimaryIntObject', but received: a");
+}
+
 - (void)testArrayIn {
     RLMRealm *realm = [self realm];
     [realm beginWriteTransaction];
@@ -2962,6 +3167,17 @@ static NSData *data(const char *str) {
 
     RLMAssertCount(LinkToCompanyObject, 1U, @"SUBQUERY(company.employeeDict, $employee, $employee.age > 30 AND $employee.hired = FALSE).@count > 0");
     RLMAssertCount(LinkToCompanyObject, 2U, @"SUBQUERY(company.employeeDict, $employee, $employee.age < 30 AND $employee.hired = TRUE).@count == 0");
+
+    // Subqueries with a single comparison compared to zero are evaluated as ANY
+    RLMAssertCount(CompanyObject, 1U, @"SUBQUERY(employees, $employee, $employee.age > 50).@count > 0");
+    RLMAssertCount(CompanyObject, 1U, @"SUBQUERY(employees, $employee, $employee.age > 50).@count == 0");
+    RLMAssertCount(CompanyObject, 2U, @"SUBQUERY(employees, $employee, $employee.age >= 30).@count >= 1");
+    RLMAssertCount(CompanyObject, 0U, @"SUBQUERY(employees, $employee, $employee.age >= 30).@count < 1");
+    RLMAssertCount(CompanyObject, 1U, @"SUBQUERY(employeeSet, $employee, $employee.name BEGINSWITH 'J').@count != 0");
+    RLMAssertCount(CompanyObject, 1U, @"SUBQUERY(employeeSet, $employee, $employee.name BEGINSWITH[c] 'j').@count <= 0");
+    RLMAssertCount(CompanyObject, 2U, @"SUBQUERY(employees, $employee, $employee.age > 30).@count > 1");
+    RLMAssertCount(LinkToCompanyObject, 1U, @"SUBQUERY(company.employees, $employee, $employee.age < 31).@count < 1");
+    RLMAssertCount(LinkToCompanyObject, 1U, @"SUBQUERY(company.employeeDict, $employee, $employee.age < 31).@count > 0");
 }
 
 - (void)testLinkingObjects {
@@ -257,6 +257,30 @@
     XCTAssertEqual(mo.anyCol.rlm_valueType, RLMPropertyTypeString);
 }
 
+- (void)testAssignValuesOfDifferentClassesRepeatedly {
+    // Values of each class are converted using a per-class cache, so make sure
+    // that switching back and forth between classes (including mutable and
+    // Swift-style subclasses of NSString) always stores the right type
+    RLMRealm *r = [self realmWithTestPath];
+    [r beginWriteTransaction];
+    MixedObject *mo = [MixedObject createInRealm:r withValue:@[@0, @[]]];
+    NSArray *values = @[@"a", [NSMutableString stringWithString:@"b"], @YES, @1, @2.5f, @3.5,
+                        [@"c" dataUsingEncoding:NSUTF8StringEncoding], [NSDate dateWithTimeIntervalSince1970:1],
+                        [RLMObjectId objectId], [RLMDecimal128 decimalWithNumber:@4]];
+    NSArray *types = @[@(RLMPropertyTypeString), @(RLMPropertyTypeString), @(RLMPropertyTypeBool),
+                       @(RLMPropertyTypeInt), @(RLMPropertyTypeFloat), @(RLMPropertyTypeDouble),
+                       @(RLMPropertyTypeData), @(RLMPropertyTypeDate), @(RLMPropertyTypeObjectId),
+                       @(RLMPropertyTypeDecimal128)];
+    for (int i = 0; i < 3; ++i) {
+        for (NSUInteger j = 0; j < values.count; ++j) {
+            mo.anyCol = values[j];
+            XCTAssertEqualObjects(mo.anyCol, values[j]);
+            XCTAssertEqual(mo.anyCol.rlm_valueType, [types[j] intValue]);
+        }
+    }
+    [r cancelWriteTransaction];
+}
+
 - (void)testCreateManagedData {
     RLMRealm *r = [self realmWithTestPath];
     NSData *d1 = [NSData dataWithBytes:"hey" length:3];
@@ -18,13 +18,17 @@
 
 #import "RLMTestCase.h"
 
+#import "RLMClassInfo.hpp"
 #import "RLMObjectSchema_Private.hpp"
+#import "RLMObject_Private.hpp"
+#import "RLMObservation.hpp"
 #import "RLMRealmConfiguration_Private.hpp"
 #import "RLMRealmUtil.hpp"
 #import "RLMRealm_Dynamic.h"
 #import "RLMRealm_Private.hpp"
 #import "RLMSchema_Private.h"
 
+#import <atomic>
 #import <mach/mach_init.h>
 #import <mach/vm_map.h>
 #import <sys/resource.h>
@@ -47,6 +51,54 @@
 @interface RealmTests : RLMTestCase
 @end
 
+@interface ExpiringObject : RLMObject
+@property NSDate *createdAt;
+@end
+
+@implementation ExpiringObject
++ (NSString *)timeToLiveProperty {
+    return @"createdAt";
+}
+
++ (NSTimeInterval)timeToLive {
+    return 60;
+}
+@end
+
+@interface ExternalBlobObject : RLMObject
+@property NSData *data;
+@end
+
+@implementation ExternalBlobObject
++ (NSArray<NSString *> *)externalBlobProperties {
+    return @[@"data"];
+}
+@end
+
+@interface CompressedObject : RLMObject
+@property NSString *string;
+@property NSData *data;
+@end
+
+@implementation CompressedObject
++ (NSDictionary<NSString *, NSNumber *> *)compressedProperties {
+    return @{@"data": @(RLMCompressionAlgorithmLZFSE)};
+}
+@end
+
+@interface CompressedStringObject : RLMObject
+@property NSString *string;
+@end
+
+@implementation CompressedStringObject
++ (NSDictionary<NSString *, NSNumber *> *)compressedProperties {
+    return @{@"string": @(RLMCompressionAlgorithmLZ4)};
+}
++ (BOOL)shouldIncludeInDefaultSchema {
+    return NO;
+}
+@end
+
 @implementation RealmTests
 
 - (void)deleteFiles {
@@ -373,6 +425,73 @@
     assertNoCachedRealm();
 }
 
+- (void)testAsyncOpenConcurrencyLimitAndPriority {
+    dispatch_queue_t queue = dispatch_queue_create("async open", DISPATCH_QUEUE_SERIAL);
+    dispatch_suspend(queue);
+    RLMSetAsyncOpenQueue(queue);
+    RLMAsyncOpenTask.maximumConcurrentOpens = 1;
+
+    NSMutableArray *order = [NSMutableArray new];
+    XCTestExpectation *ex = [self expectationWithDescription:@"opens"];
+    ex.expectedFulfillmentCount = 3;
+    auto open = ^(NSString *name) {
+        RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+        config.fileURL = [RLMTestRealmURL() URLByAppendingPathExtension:name];
+        return [RLMRealm asyncOpenWithConfiguration:config callbackQueue:dispatch_get_main_queue()
+                                           callback:^(RLMRealm *realm, NSError *error) {
+            XCTAssertNotNil(realm);
+            XCTAssertNil(error);
+            [order addObject:name];
+            [ex fulfill];
+        }];
+    };
+
+    // The first open starts immediately, and the rest are queued behind it
+    open(@"a");
+    open(@"b");
+    RLMAsyncOpenTask *c = open(@"c");
+    c.priority = 1;
+    RLMAsyncOpenTask *d = open(@"d");
+    [d cancel];
+
+    dispatch_resume(queue);
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+    XCTAssertEqualObjects(order, (@[@"a", @"c", @"b"]));
+
+    RLMAsyncOpenTask.maximumConcurrentOpens = 0;
+    RLMSetAsyncOpenQueue(dispatch_queue_create("io.realm.asyncOpenDispatchQueue", DISPATCH_QUEUE_CONCURRENT));
+}
+
+- (void)testPrewarm {
+    RLMRealmConfiguration *c = [RLMRealmConfiguration defaultConfiguration];
+    dispatch_queue_t queue = dispatch_queue_create("prewarm", DISPATCH_QUEUE_SERIAL);
+    XCTestExpectation *ex = [self expectationWithDescription:@"prewarm"];
+    [RLMRealm prewarmWithConfiguration:c queue:queue completion:^(NSError *error) {
+        XCTAssertNil(error);
+        [ex fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    // The prewarmed Realm is kept open until the Realm is next opened
+    XCTAssertNotNil(RLMGetAnyCachedRealmForPath(c.pathOnDisk.UTF8String));
+    @autoreleasepool {
+        RLMRealm *realm = [RLMRealm realmWithConfiguration:c error:nil];
+        XCTAssertNotNil(realm);
+    }
+    dispatch_sync(queue, ^{});
+    XCTAssertNil(RLMGetAnyCachedRealmForPath(c.pathOnDisk.UTF8String));
+
+    // Errors are reported to the completion block
+    c.readOnly = true;
+    c.fileURL = [c.fileURL URLByAppendingPathExtension:@"missing"];
+    ex = [self expectationWithDescription:@"prewarm failure"];
+    [RLMRealm prewarmWithConfiguration:c queue:queue completion:^(NSError *error) {
+        XCTAssertEqual(error.code, RLMErrorFileNotFound);
+        [ex fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+}
+
 #pragma mark - Adding and Removing Objects
 
 - (void)testRealmAddAndRemoveObjects {
@@ -497,6 +616,37 @@
     XCTAssertEqual((id)dictObj.stringDictionary[@"b"], NSNull.null);
 }
 
+- (void)testRealmBatchRemoveObjectsFromNSArray {
+    RLMRealm *realm = [self realmWithTestPath];
+    [realm beginWriteTransaction];
+    StringObject *str1 = [StringObject createInRealm:realm withValue:@[@"a"]];
+    StringObject *str2 = [StringObject createInRealm:realm withValue:@[@"b"]];
+    IntObject *int1 = [IntObject createInRealm:realm withValue:@[@1]];
+    [IntObject createInRealm:realm withValue:@[@2]];
+    EmbeddedIntParentObject *parent = [EmbeddedIntParentObject createInRealm:realm withValue:@[@1, @[@2], @[]]];
+    [realm commitWriteTransaction];
+
+    [realm beginWriteTransaction];
+    // Nothing is deleted if any of the objects are invalid
+    RLMAssertThrowsWithReason([realm deleteObjects:@[str1, @"str"]],
+                              @"Only RLMObjects can be deleted.");
+    RLMAssertThrowsWithReason([realm deleteObjects:@[str1, [[StringObject alloc] init]]],
+                              @"Can only delete an object from the Realm it belongs to.");
+    XCTAssertEqual(2U, [StringObject allObjectsInRealm:realm].count);
+
+    // Mixed types, duplicates and objects implicitly deleted by an earlier object
+    EmbeddedIntObject *child = parent.object;
+    [realm deleteObjects:@[str1, int1, str1, parent, child, str2]];
+    XCTAssertEqual(0U, [StringObject allObjectsInRealm:realm].count);
+    XCTAssertEqual(1U, [IntObject allObjectsInRealm:realm].count);
+    XCTAssertEqual(0U, [EmbeddedIntParentObject allObjectsInRealm:realm].count);
+    XCTAssertTrue(str1.invalidated);
+    XCTAssertTrue(child.invalidated);
+    [realm commitWriteTransaction];
+
+    RLMAssertThrowsWithReason([realm deleteObjects:@[int1]], @"Can only delete an object from the Realm it belongs to.");
+}
+
 - (void)testAddManagedObjectToOtherRealm {
     RLMRealm *realm1 = [self realmWithTestPath];
     RLMRealm *realm2 = [RLMRealm defaultRealm];
@@ -808,6 +958,164 @@
     XCTAssertEqualObjects([objects.firstObject stringCol], @"b", @"Expecting column to be 'b'");
 }
 
+- (void)testBulkLoadSuspendsIndexes {
+    RLMRealm *realm = [self realmWithTestPath];
+    auto& info = realm->_info[IndexedStringObject.className];
+    auto col = info.tableColumn(@"stringCol");
+    auto& pkInfo = realm->_info[PrimaryStringObject.className];
+    auto pkCol = pkInfo.tableColumn(@"stringCol");
+
+    RLMAssertThrowsWithReason([realm beginBulkLoadForClasses:@[IndexedStringObject.className]],
+                              @"Can only begin a bulk load during a write transaction");
+
+    [realm beginWriteTransaction];
+    [realm beginBulkLoadForClasses:@[IndexedStringObject.className, PrimaryStringObject.className]];
+    XCTAssertFalse(info.table()->has_search_index(col));
+    XCTAssertTrue(pkInfo.table()->has_search_index(pkCol));
+    for (int i = 0; i < 100; ++i) {
+        [IndexedStringObject createInRealm:realm withValue:@[@(i).stringValue]];
+    }
+    XCTAssertEqual([IndexedStringObject objectsInRealm:realm where:@"stringCol = '50'"].count, 1U);
+    [realm cancelWriteTransaction];
+    XCTAssertTrue(info.table()->has_search_index(col));
+
+    [realm beginWriteTransaction];
+    [realm beginBulkLoadForClasses:@[IndexedStringObject.className]];
+    for (int i = 0; i < 100; ++i) {
+        [IndexedStringObject createInRealm:realm withValue:@[@(i).stringValue]];
+    }
+    [realm commitWriteTransaction];
+    XCTAssertTrue(info.table()->has_search_index(col));
+    XCTAssertEqual([IndexedStringObject objectsInRealm:realm where:@"stringCol = '50'"].count, 1U);
+}
+
+- (void)testExternalBlobProperties {
+    RLMRealmConfiguration *config;
+    NSString *blobs;
+    @autoreleasepool {
+        RLMRealm *realm = [self realmWithTestPath];
+        blobs = [realm.configuration.fileURL.path stringByAppendingString:@".blobs"];
+        NSMutableData *data = [NSMutableData dataWithLength:1024 * 1024];
+        memset(data.mutableBytes, 'a', data.length);
+
+        [realm beginWriteTransaction];
+        ExternalBlobObject *obj = [ExternalBlobObject createInRealm:realm withValue:@[data]];
+        [ExternalBlobObject createInRealm:realm withValue:@[data]];
+        [ExternalBlobObject createInRealm:realm withValue:@[NSNull.null]];
+        [realm commitWriteTransaction];
+
+        // Identical values are only stored once, and the column holds a reference
+        XCTAssertEqual([NSFileManager.defaultManager contentsOfDirectoryAtPath:blobs error:nil].count, 1U);
+        auto& info = realm->_info[ExternalBlobObject.className];
+        XCTAssertLessThan(obj->_row.get<realm::BinaryData>(info.tableColumn(@"data")).size(), 64U);
+
+        XCTAssertEqualObjects(obj.data, data);
+        XCTAssertEqualObjects([obj dataNoCopyForProperty:@"data"], data);
+        XCTAssertNil([ExternalBlobObject allObjectsInRealm:realm][2].data);
+
+        NSInputStream *stream = [obj inputStreamForProperty:@"data"];
+        [stream open];
+        NSMutableData *streamed = [NSMutableData data];
+        uint8_t buffer[4096];
+        NSInteger read;
+        while ((read = [stream read:buffer maxLength:sizeof(buffer)]) > 0) {
+            [streamed appendBytes:buffer length:read];
+        }
+        [stream close];
+        XCTAssertEqualObjects(streamed, data);
+
+        RLMAssertThrowsWithReason([realm removeUnreferencedExternalBlobs],
+                                  @"Can only remove unreferenced external blobs during a write transaction");
+
+        [realm beginWriteTransaction];
+        obj.data = [@"replacement" dataUsingEncoding:NSUTF8StringEncoding];
+        XCTAssertEqual([realm removeUnreferencedExternalBlobs], 0U);
+        [realm deleteObjects:[ExternalBlobObject allObjectsInRealm:realm]];
+        XCTAssertEqual([realm removeUnreferencedExternalBlobs], 2U);
+        [realm commitWriteTransaction];
+        XCTAssertEqual([NSFileManager.defaultManager contentsOfDirectoryAtPath:blobs error:nil].count, 0U);
+        config = realm.configuration;
+    }
+
+    XCTAssertTrue([RLMRealm deleteFilesForConfiguration:config error:nil]);
+    XCTAssertFalse([NSFileManager.defaultManager fileExistsAtPath:blobs]);
+}
+
+- (void)testCancelledWriteDoesNotRemoveExternalBlobs {
+    RLMRealm *realm = [self realmWithTestPath];
+    NSString *blobs = [realm.configuration.fileURL.path stringByAppendingString:@".blobs"];
+    NSData *data = [@"external" dataUsingEncoding:NSUTF8StringEncoding];
+
+    [realm beginWriteTransaction];
+    ExternalBlobObject *obj = [ExternalBlobObject createInRealm:realm withValue:@[data]];
+    [realm commitWriteTransaction];
+
+    [realm beginWriteTransaction];
+    [realm deleteObject:obj];
+    XCTAssertEqual([realm removeUnreferencedExternalBlobs], 1U);
+    XCTAssertEqual([NSFileManager.defaultManager contentsOfDirectoryAtPath:blobs error:nil].count, 1U);
+    [realm cancelWriteTransaction];
+
+    // The cancelled write's blobs aren't removed by the next commit either
+    [realm transactionWithBlock:^{}];
+    XCTAssertEqual([NSFileManager.defaultManager contentsOfDirectoryAtPath:blobs error:nil].count, 1U);
+    XCTAssertEqualObjects([ExternalBlobObject allObjectsInRealm:realm].firstObject.data, data);
+}
+
+- (void)testRemoveUnreferencedExternalBlobsKeepsBlobsOfPinnedVersions {
+    RLMRealm *realm = [self realmWithTestPath];
+    NSString *blobs = [realm.configuration.fileURL.path stringByAppendingString:@".blobs"];
+    NSData *data = [@"external" dataUsingEncoding:NSUTF8StringEncoding];
+
+    [realm beginWriteTransaction];
+    [ExternalBlobObject createInRealm:realm withValue:@[data]];
+    [realm commitWriteTransaction];
+    ExternalBlobObject *frozen = [ExternalBlobObject allObjectsInRealm:realm.freeze].firstObject;
+
+    [realm beginWriteTransaction];
+    [realm deleteAllObjects];
+    XCTAssertEqual([realm removeUnreferencedExternalBlobs], 1U);
+    [realm commitWriteTransaction];
+    XCTAssertEqual([NSFileManager.defaultManager contentsOfDirectoryAtPath:blobs error:nil].count, 1U);
+    XCTAssertEqualObjects(frozen.data, data);
+}
+
+- (void)testCompressedProperties {
+    RLMRealm *realm = [self realmWithTestPath];
+    NSString *string = [@"" stringByPaddingToLength:10000 withString:@"{\"key\": \"value\"} " startingIndex:0];
+    NSData *data = [string dataUsingEncoding:NSUTF8StringEncoding];
+
+    [realm beginWriteTransaction];
+    CompressedObject *obj = [CompressedObject createInRealm:realm withValue:@[string, data]];
+    CompressedObject *small = [CompressedObject createInRealm:realm withValue:@[@"short", NSNull.null]];
+    [realm commitWriteTransaction];
+
+    auto& info = realm->_info[CompressedObject.className];
+    XCTAssertLessThan(obj->_row.get<realm::BinaryData>(info.tableColumn(@"data")).size(), data.length / 5);
+    XCTAssertEqualObjects(obj.data, data);
+    XCTAssertEqualObjects(obj[@"data"], data);
+    XCTAssertEqualObjects([obj dataNoCopyForProperty:@"data"], data);
+    // Properties which aren't listed are stored as-is
+    XCTAssertEqual(obj->_row.get<realm::StringData>(info.tableColumn(@"string")).size(), string.length);
+    XCTAssertEqualObjects(obj.string, string);
+
+    // Small values are stored as-is
+    XCTAssertNil(small.data);
+
+    [realm beginWriteTransaction];
+    small.data = [@"short" dataUsingEncoding:NSUTF8StringEncoding];
+    obj.data = data;
+    [realm commitWriteTransaction];
+    XCTAssertEqual(small->_row.get<realm::BinaryData>(info.tableColumn(@"data")).size(), 5U);
+    XCTAssertEqualObjects(small.data, [@"short" dataUsingEncoding:NSUTF8StringEncoding]);
+    XCTAssertEqualObjects(obj.data, data);
+    XCTAssertEqual([CompressedObject objectsInRealm:realm where:@"data = nil"].count, 0U);
+
+    // String columns must hold valid UTF-8, so can't store compressed bytes
+    RLMAssertThrowsWithReason([RLMObjectSchema schemaForObjectClass:CompressedStringObject.class],
+                              @"Property 'CompressedStringObject.string' cannot be compressed because it is not a non-indexed 'data' property.");
+}
+
 - (void)testInWriteTransaction {
     RLMRealm *realm = [self realmWithTestPath];
     XCTAssertFalse(realm.inWriteTransaction);
@@ -825,6 +1133,210 @@
     XCTAssertFalse(realm.inWriteTransaction);
 }
 
+- (void)testAsyncTransaction {
+    RLMRealm *realm = [self realmWithTestPath];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"writes completed"];
+    expectation.expectedFulfillmentCount = 3;
+    for (NSString *value in @[@"a", @"b", @"c"]) {
+        [realm asyncTransactionWithBlock:^(RLMRealm *realm) {
+            XCTAssertFalse(NSThread.isMainThread);
+            XCTAssertTrue(realm.inWriteTransaction);
+            [StringObject createInRealm:realm withValue:@[value]];
+        } onComplete:^(NSError *error) {
+            XCTAssertNil(error);
+            XCTAssertTrue(NSThread.isMainThread);
+            XCTAssertNotNil([StringObject objectsInRealm:realm where:@"stringCol = %@", value].firstObject);
+            [expectation fulfill];
+        }];
+    }
+    XCTAssertFalse(realm.inWriteTransaction);
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+    XCTAssertEqualObjects([[StringObject allObjectsInRealm:realm] valueForKey:@"stringCol"], (@[@"a", @"b", @"c"]));
+
+    // Writes without a completion block are still performed in order
+    [realm asyncTransactionWithBlock:^(RLMRealm *realm) {
+        [realm deleteAllObjects];
+    } onComplete:nil];
+    [self waitForNotification:RLMRealmDidChangeNotification realm:realm block:^{}];
+    XCTAssertEqual(0U, [StringObject allObjectsInRealm:realm].count);
+
+    RLMAssertThrowsWithReason([realm.freeze asyncTransactionWithBlock:^(RLMRealm *) {} onComplete:nil],
+                              @"Cannot perform asynchronous writes on a frozen Realm.");
+}
+
+- (void)testAsyncTransactionGroupCommit {
+    RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+    XCTAssertEqual(config.groupCommitInterval, 0);
+    XCTAssertEqual(config.maximumWritesPerGroupCommit, 0U);
+    RLMAssertThrowsWithReason(config.groupCommitInterval = -1,
+                              @"Group commit interval must not be negative.");
+
+    // A full group is committed without waiting for the rest of the interval
+    config.groupCommitInterval = 10;
+    config.maximumWritesPerGroupCommit = 2;
+    RLMRealm *realm = [RLMRealm realmWithConfiguration:config error:nil];
+    XCTAssertEqual(realm.configuration.groupCommitInterval, 10);
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"writes completed"];
+    expectation.expectedFulfillmentCount = 2;
+    NSMutableSet *transactionRealms = [NSMutableSet new];
+    for (int i = 0; i < 2; ++i) {
+        [realm asyncTransactionWithBlock:^(RLMRealm *realm) {
+            [transactionRealms addObject:[NSValue valueWithNonretainedObject:realm]];
+            [IntObject createInRealm:realm withValue:@[@(i)]];
+        } onComplete:^(NSError *error) {
+            XCTAssertNil(error);
+            XCTAssertEqual([IntObject allObjectsInRealm:realm].count, 2U);
+            [expectation fulfill];
+        }];
+    }
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+    XCTAssertEqual(transactionRealms.count, 1U);
+}
+
+- (void)testAsyncTransactionGroupCommitWithCancelledAndThrowingWrites {
+    RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+    config.groupCommitInterval = 10;
+    config.maximumWritesPerGroupCommit = 4;
+    RLMRealm *realm = [RLMRealm realmWithConfiguration:config error:nil];
+
+    NSMutableArray *results = [NSMutableArray new];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"writes completed"];
+    expectation.expectedFulfillmentCount = 4;
+    void (^blocks[])(RLMRealm *) = {
+        ^(RLMRealm *realm) { [IntObject createInRealm:realm withValue:@[@1]]; },
+        ^(RLMRealm *realm) {
+            [IntObject createInRealm:realm withValue:@[@2]];
+            [realm cancelWriteTransaction];
+        },
+        ^(RLMRealm *realm) {
+            [IntObject createInRealm:realm withValue:@[@3]];
+            @throw [NSException exceptionWithName:@"Test" reason:@"thrown from a write" userInfo:nil];
+        },
+        ^(RLMRealm *realm) { [IntObject createInRealm:realm withValue:@[@4]]; },
+    };
+    for (auto block : blocks) {
+        [realm asyncTransactionWithBlock:block onComplete:^(NSError *error) {
+            [results addObject:error ?: NSNull.null];
+            [expectation fulfill];
+        }];
+    }
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    // The first write was discarded by the cancellation after it, and the
+    // cancellation and the exception are reported to their own writes
+    XCTAssertEqual(results.count, 4U);
+    XCTAssertTrue([results[0] isKindOfClass:[NSError class]]);
+    XCTAssertEqualObjects([results[1] localizedDescription], @"The write was cancelled.");
+    XCTAssertEqualObjects([results[2] localizedDescription], @"thrown from a write");
+    XCTAssertEqualObjects(results[3], NSNull.null);
+    XCTAssertEqualObjects([[IntObject allObjectsInRealm:realm] valueForKey:@"intCol"], @[@4]);
+}
+
+- (void)testVersionPins {
+    RLMRealm *realm = [self realmWithTestPath];
+    NSArray<RLMVersionPin *> *pins = [RLMRealm versionPinsForConfiguration:realm.configuration];
+    XCTAssertEqual(pins.count, 1U);
+    XCTAssertEqualObjects(pins[0].holder, @"main thread");
+    XCTAssertFalse(pins[0].frozen);
+    uint64_t initialVersion = pins[0].version;
+
+    RLMRealm *frozen = realm.freeze;
+    [realm transactionWithBlock:^{
+        [StringObject createInRealm:realm withValue:@[@"a"]];
+    }];
+    pins = [RLMRealm versionPinsForConfiguration:realm.configuration];
+    XCTAssertEqual(pins.count, 2U);
+    XCTAssertEqual(pins[0].version, initialVersion);
+    XCTAssertTrue(pins[0].frozen);
+    XCTAssertGreaterThan(pins[1].version, initialVersion);
+    XCTAssertFalse(pins[1].frozen);
+
+    [frozen invalidate];
+    [realm invalidate];
+    XCTAssertEqual([RLMRealm versionPinsForConfiguration:realm.configuration].count, 0U);
+}
+
+- (void)testWriteTransactionObserver {
+    NSMutableArray<RLMWriteTransactionMetrics *> *metrics = [NSMutableArray new];
+    RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+    config.writeTransactionObserver = ^(RLMWriteTransactionMetrics *m) {
+        [metrics addObject:m];
+    };
+    RLMRealm *realm = [RLMRealm realmWithConfiguration:config error:nil];
+    XCTAssertNotNil(realm.configuration.writeTransactionObserver);
+
+    [realm transactionWithBlock:^{
+        [StringObject createInRealm:realm withValue:@[@"a"]];
+        [StringObject createInRealm:realm withValue:@[@"b"]];
+        [IntObject createInRealm:realm withValue:@[@1]];
+    }];
+    XCTAssertEqual(metrics.count, 1U);
+    XCTAssertFalse(metrics[0].cancelled);
+    XCTAssertGreaterThanOrEqual(metrics[0].beginDuration, 0);
+    XCTAssertGreaterThanOrEqual(metrics[0].transactionDuration, 0);
+    XCTAssertGreaterThanOrEqual(metrics[0].commitDuration, 0);
+    XCTAssertEqualObjects(metrics[0].objectCountChanges, (@{@"StringObject": @2, @"IntObject": @1}));
+
+    [realm beginWriteTransaction];
+    [realm deleteObjects:[StringObject allObjectsInRealm:realm]];
+    [realm cancelWriteTransaction];
+    XCTAssertEqual(metrics.count, 2U);
+    XCTAssertTrue(metrics[1].cancelled);
+    XCTAssertEqualObjects(metrics[1].objectCountChanges, @{});
+
+    [realm transactionWithBlock:^{
+        [realm deleteObjects:[StringObject allObjectsInRealm:realm]];
+    }];
+    XCTAssertEqualObjects(metrics[2].objectCountChanges, @{@"StringObject": @(-2)});
+}
+
+- (void)testBackgroundWriteYieldsToMainThreadWrite {
+    RLMRealm *realm = RLMRealm.defaultRealm;
+    dispatch_semaphore_t started = dispatch_semaphore_create(0);
+    XCTestExpectation *finished = [self expectationWithDescription:@"background write finished"];
+    __block std::atomic<bool> mainThreadWrote{false};
+    __block RLMWriteTransactionMetrics *backgroundMetrics;
+
+    [self dispatchAsync:^{
+        RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+        config.writeTransactionObserver = ^(RLMWriteTransactionMetrics *m) {
+            backgroundMetrics = m;
+        };
+        RLMRealm *realm = [RLMRealm realmWithConfiguration:config error:nil];
+        [realm beginWriteTransaction];
+        dispatch_semaphore_signal(started);
+        while (!mainThreadWrote) {
+            [IntObject createInRealm:realm withValue:@[@0]];
+            XCTAssertTrue([realm yieldWriteTransactionIfNeeded:nil]);
+        }
+        // The main thread's write is visible after yielding to it
+        XCTAssertEqual(1U, [IntObject objectsInRealm:realm where:@"intCol = 1"].count);
+        [realm commitWriteTransaction];
+        [finished fulfill];
+    }];
+
+    // Without the background writer yielding this would wait for it forever
+    dispatch_semaphore_wait(started, DISPATCH_TIME_FOREVER);
+    [realm transactionWithBlock:^{
+        [IntObject createInRealm:realm withValue:@[@1]];
+    }];
+    mainThreadWrote = true;
+    [self waitForExpectations:@[finished] timeout:5.0];
+
+    XCTAssertGreaterThanOrEqual(backgroundMetrics.yieldCount, 1U);
+    XCTAssertGreaterThan(backgroundMetrics.yieldDuration, 0);
+}
+
+- (void)testYieldWriteTransactionOutsideWriteThrows {
+    RLMRealm *realm = RLMRealm.defaultRealm;
+    RLMAssertThrowsWithReason([realm yieldWriteTransactionIfNeeded:nil], @"from within a write transaction");
+    [realm beginWriteTransaction];
+    XCTAssertTrue([realm yieldWriteTransactionIfNeeded:nil]);
+    XCTAssertTrue(realm.inWriteTransaction);
+    [realm cancelWriteTransaction];
+}
+
 - (void)testAutorefreshAfterBackgroundUpdate {
     RLMRealm *realm = [self realmWithTestPath];
 
@@ -1423,6 +1935,84 @@
     XCTAssertThrows([realm addNotificationBlock:self.nonLiteralNil]);
 }
 
+- (void)testChangeSummaryNotificationReportsChangedClasses {
+    RLMRealm *realm = RLMRealm.defaultRealm;
+    [realm transactionWithBlock:^{
+        [IntObject createInRealm:realm withValue:@[@0]];
+        [StringObject createInRealm:realm withValue:@[@"a"]];
+    }];
+
+    __block RLMRealmChangeSummary *summary;
+    RLMNotificationToken *token = [realm addChangeSummaryNotificationBlock:^(RLMRealm *, RLMRealmChangeSummary *s) {
+        summary = s;
+    }];
+
+    [realm transactionWithBlock:^{
+        [IntObject createInRealm:realm withValue:@[@1]];
+        [[StringObject allObjectsInRealm:realm].firstObject setStringCol:@"b"];
+    }];
+    XCTAssertEqualObjects(summary.insertedClassNames, [NSSet setWithObject:@"IntObject"]);
+    XCTAssertEqualObjects(summary.deletedClassNames, [NSSet set]);
+    XCTAssertEqualObjects(summary.modifiedClassNames, [NSSet setWithObject:@"StringObject"]);
+    XCTAssertEqualObjects(summary.changedClassNames, ([NSSet setWithObjects:@"IntObject", @"StringObject", nil]));
+
+    [realm transactionWithBlock:^{
+        [realm deleteObjects:[StringObject allObjectsInRealm:realm]];
+    }];
+    XCTAssertEqualObjects(summary.insertedClassNames, [NSSet set]);
+    XCTAssertEqualObjects(summary.deletedClassNames, [NSSet setWithObject:@"StringObject"]);
+    XCTAssertEqualObjects(summary.changedClassNames, [NSSet setWithObject:@"StringObject"]);
+
+    [token invalidate];
+}
+
+- (void)testChangeSummaryNotificationIsOnlySentForDidChange {
+    RLMRealm *realm = [self realmWithTestPath];
+    realm.autorefresh = NO;
+
+    __block NSUInteger calls = 0;
+    __block RLMRealmChangeSummary *summary;
+    RLMNotificationToken *token = [realm addChangeSummaryNotificationBlock:^(RLMRealm *, RLMRealmChangeSummary *s) {
+        XCTAssertNotNil(s);
+        summary = s;
+        ++calls;
+    }];
+
+    [self waitForNotification:RLMRealmRefreshRequiredNotification realm:realm block:^{
+        RLMRealm *realm = [self realmWithTestPath];
+        [realm transactionWithBlock:^{
+            [StringObject createInRealm:realm withValue:@[@"string"]];
+        }];
+    }];
+    XCTAssertEqual(calls, 0U);
+
+    [realm refresh];
+    XCTAssertEqual(calls, 1U);
+    XCTAssertEqualObjects(summary.insertedClassNames, [NSSet setWithObject:@"StringObject"]);
+
+    [token invalidate];
+}
+
+- (void)testKeyPathCacheComparesStringContents {
+    RLMRealm *realm = RLMRealm.defaultRealm;
+    RLMClassInfo& info = realm->_info[@"LinkStringObject"];
+
+    // Mutable strings are never tagged pointers, so each of these is a
+    // distinct object with the same contents
+    auto first = RLMKeyPathArrayFromStringArray(realm, &info, @[[NSMutableString stringWithString:@"objectCol.stringCol"]]);
+    auto second = RLMKeyPathArrayFromStringArray(realm, &info, @[[NSMutableString stringWithString:@"objectCol.stringCol"]]);
+    XCTAssertTrue(first == second);
+    XCTAssertEqual(info.keyPathCache->keyPaths.size(), 1U);
+}
+
+- (void)testChangeSummaryNotificationBlockMustNotBeNil {
+    RLMRealm *realm = RLMRealm.defaultRealm;
+    XCTAssertThrows([realm addChangeSummaryNotificationBlock:self.nonLiteralNil]);
+    [realm beginWriteTransaction];
+    XCTAssertThrows([realm addChangeSummaryNotificationBlock:^(RLMRealm *, RLMRealmChangeSummary *) {}]);
+    [realm cancelWriteTransaction];
+}
+
 - (void)testRefreshInWriteTransactionReturnsFalse {
     RLMRealm *realm = RLMRealm.defaultRealm;
     [realm beginWriteTransaction];
@@ -1777,6 +2367,49 @@
     XCTAssertEqual(1U, [IntObject allObjectsInRealm:copy].count);
 }
 
+- (void)testWriteCopyOfRealmToStream {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    [realm transactionWithBlock:^{
+        [IntObject createInRealm:realm withValue:@[@0]];
+    }];
+
+    NSOutputStream *stream = [NSOutputStream outputStreamWithURL:RLMTestRealmURL() append:NO];
+    [stream open];
+    __block uint64_t lastWritten = 0, lastTotal = 0;
+    NSError *writeError;
+    XCTAssertTrue([realm writeCopyToStream:stream encryptionKey:nil maximumBytesPerSecond:0
+                                  progress:^(uint64_t written, uint64_t total) {
+        XCTAssertGreaterThan(written, lastWritten);
+        lastWritten = written;
+        lastTotal = total;
+    } error:&writeError]);
+    [stream close];
+    XCTAssertNil(writeError);
+    XCTAssertGreaterThan(lastTotal, 0U);
+    XCTAssertEqual(lastWritten, lastTotal);
+
+    RLMRealm *copy = [self realmWithTestPath];
+    XCTAssertEqual(1U, [IntObject allObjectsInRealm:copy].count);
+}
+
+- (void)testPrefetch {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    [realm transactionWithBlock:^{
+        for (int i = 0; i < 10; ++i) {
+            [IntObject createInRealm:realm withValue:@[@(i)]];
+        }
+    }];
+
+    XCTAssertNoThrow([realm prefetchObjectsOfClass:@"IntObject" properties:nil]);
+    XCTAssertNoThrow([realm prefetchResults:[IntObject objectsInRealm:realm where:@"intCol > 5"]
+                                 properties:@[@"intCol"]]);
+    RLMAssertThrowsWithReason([realm prefetchObjectsOfClass:@"IntObject" properties:@[@"invalid"]],
+                              @"Invalid property name 'invalid' for class 'IntObject'.");
+    RLMAssertThrowsWithReason([realm prefetchResults:[IntObject allObjectsInRealm:self.realmWithTestPath] properties:nil],
+                              @"Can only prefetch results from this Realm.");
+    XCTAssertEqual(10U, [IntObject allObjectsInRealm:realm].count);
+}
+
 - (void)testCannotOverwriteWithWriteCopy
 {
     RLMRealm *realm = [self realmWithTestPath];
@@ -1920,6 +2553,87 @@
     XCTAssertNotEqual(fr1, fr3);
 }
 
+- (void)testFrozenRealmCacheReusesReleasedVersions {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    @autoreleasepool {
+        XCTAssertTrue(realm.freeze.frozen);
+    }
+    RLMFrozenRealmCacheStatistics *metrics = RLMRealm.frozenRealmCacheStatistics;
+    XCTAssertEqual(metrics.misses, 1U);
+    XCTAssertEqual(metrics.hits, 0U);
+    XCTAssertEqual(metrics.pinnedVersions, 1U);
+
+    // The frozen Realm was released but the version is still cached
+    @autoreleasepool {
+        XCTAssertTrue(realm.freeze.frozen);
+    }
+    metrics = RLMRealm.frozenRealmCacheStatistics;
+    XCTAssertEqual(metrics.misses, 1U);
+    XCTAssertEqual(metrics.hits, 1U);
+
+    // Freezing a newer version replaces the older one rather than pinning both
+    [realm transactionWithBlock:^{ }];
+    @autoreleasepool {
+        XCTAssertTrue(realm.freeze.frozen);
+    }
+    metrics = RLMRealm.frozenRealmCacheStatistics;
+    XCTAssertEqual(metrics.misses, 2U);
+    XCTAssertEqual(metrics.pinnedVersions, 1U);
+
+    // Invalidated frozen Realms are never handed out again
+    RLMRealm *frozen = realm.freeze;
+    [frozen invalidate];
+    XCTAssertNotEqual(realm.freeze, frozen);
+    XCTAssertEqual(RLMRealm.frozenRealmCacheStatistics.misses, 3U);
+}
+
+- (void)testRefreshingReleasesOlderCachedFrozenRealms {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    @autoreleasepool {
+        [realm freeze];
+    }
+    XCTAssertEqual(RLMRealm.frozenRealmCacheStatistics.pinnedVersions, 1U);
+
+    // The cache must not keep the old version alive once nothing reads it
+    [self dispatchAsyncAndWait:^{
+        [RLMRealm.defaultRealm transactionWithBlock:^{ }];
+    }];
+    [realm refresh];
+    XCTAssertEqual(RLMRealm.frozenRealmCacheStatistics.pinnedVersions, 0U);
+    XCTAssertEqual([RLMRealm versionPinsForConfiguration:realm.configuration].count, 1U);
+}
+
+- (void)testClosingLastLiveRealmReleasesCachedFrozenRealms {
+    RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+    @autoreleasepool {
+        RLMRealm *realm = [RLMRealm realmWithConfiguration:config error:nil];
+        @autoreleasepool {
+            [realm freeze];
+        }
+        XCTAssertEqual(RLMRealm.frozenRealmCacheStatistics.pinnedVersions, 1U);
+    }
+    // The cache must not keep the file open once the app has released it
+    XCTAssertEqual(RLMRealm.frozenRealmCacheStatistics.pinnedVersions, 0U);
+    NSError *error;
+    XCTAssertTrue([RLMRealm deleteFilesForConfiguration:config error:&error]);
+    XCTAssertNil(error);
+}
+
+- (void)testDeleteFilesReleasesCachedFrozenRealms {
+    RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+    @autoreleasepool {
+        RLMRealm *realm = [RLMRealm realmWithConfiguration:config error:nil];
+        @autoreleasepool {
+            [realm freeze];
+        }
+        XCTAssertEqual(RLMRealm.frozenRealmCacheStatistics.pinnedVersions, 1U);
+        // Deleting the files while a live Realm is open fails, but the cached
+        // frozen Realms are still released
+        [RLMRealm deleteFilesForConfiguration:config error:nil];
+        XCTAssertEqual(RLMRealm.frozenRealmCacheStatistics.pinnedVersions, 0U);
+    }
+}
+
 - (void)testReadAfterInvalidateFrozen {
     RLMRealm *realm = [RLMRealm defaultRealm].freeze;
     [realm invalidate];
@@ -2008,6 +2722,87 @@
     XCTAssertFalse(realm.isEmpty, @"Realm should not be empty after committing a write transaction that added an object.");
 }
 
+- (void)testReopeningReadOnlyRealmOnAnotherThread {
+    @autoreleasepool {
+        RLMRealm *realm = self.realmWithTestPath;
+        [realm transactionWithBlock:^{
+            [StringObject createInRealm:realm withValue:@[@"a"]];
+        }];
+    }
+    NSURL *lockURL = [RLMTestRealmURL() URLByAppendingPathExtension:@"lock"];
+    NSURL *noteURL = [RLMTestRealmURL() URLByAppendingPathExtension:@"note"];
+    [NSFileManager.defaultManager removeItemAtURL:lockURL error:nil];
+    [NSFileManager.defaultManager removeItemAtURL:noteURL error:nil];
+
+    RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+    config.fileURL = RLMTestRealmURL();
+    config.readOnly = true;
+    @autoreleasepool {
+        XCTAssertEqual([StringObject allObjectsInRealm:[RLMRealm realmWithConfiguration:config error:nil]].count, 1U);
+    }
+    // Reopened after every instance was closed
+    [self dispatchAsyncAndWait:^{
+        RLMRealm *realm = [RLMRealm realmWithConfiguration:config error:nil];
+        XCTAssertEqual([StringObject allObjectsInRealm:realm].count, 1U);
+        XCTAssertEqualObjects([[StringObject allObjectsInRealm:realm].firstObject stringCol], @"a");
+    }];
+
+    // Neither open coordinated with other readers or writers
+    XCTAssertFalse([NSFileManager.defaultManager fileExistsAtPath:lockURL.path]);
+    XCTAssertFalse([NSFileManager.defaultManager fileExistsAtPath:noteURL.path]);
+}
+
+- (void)testStorageStatistics {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    RLMStorageStatistics *before = realm.storageStatistics;
+    XCTAssertGreaterThan(before.usedBytes, 0U);
+    XCTAssertEqual(before.fileSize, before.usedBytes + before.freeBytes);
+    XCTAssertGreaterThanOrEqual(before.numberOfActiveVersions, 1U);
+    XCTAssertEqualObjects(before.objectCounts[@"StringObject"], @0);
+
+    [realm transactionWithBlock:^{
+        for (int i = 0; i < 1000; ++i) {
+            [StringObject createInRealm:realm withValue:@[@"a"]];
+        }
+    }];
+    RLMStorageStatistics *after = realm.storageStatistics;
+    XCTAssertEqualObjects(after.objectCounts[@"StringObject"], @1000);
+    XCTAssertGreaterThan(after.usedBytes, before.usedBytes);
+}
+
+- (void)testExpirationSweeper {
+    RLMRealmConfiguration *config = [RLMRealmConfiguration defaultConfiguration];
+    config.objectClasses = @[ExpiringObject.class, StringObject.class];
+    RLMRealm *realm = [RLMRealm realmWithConfiguration:config error:nil];
+    [realm transactionWithBlock:^{
+        for (int i = 0; i < 1000; ++i) {
+            [ExpiringObject createInRealm:realm withValue:@[[NSDate dateWithTimeIntervalSinceNow:-120]]];
+        }
+        [ExpiringObject createInRealm:realm withValue:@[[NSDate date]]];
+        [StringObject createInRealm:realm withValue:@[@"a"]];
+    }];
+
+    RLMExpirationSweeper *sweeper = [RLMRealm startExpiringObjectsWithConfiguration:config
+                                                                           interval:3600
+                                                               maximumWriteDuration:0.001];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"sweep"];
+    [sweeper sweepWithCompletion:^(NSUInteger deletedCount, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqual(deletedCount, 1000U);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    [sweeper invalidate];
+
+    [realm refresh];
+    XCTAssertEqual([ExpiringObject allObjectsInRealm:realm].count, 1U);
+    XCTAssertEqual([StringObject allObjectsInRealm:realm].count, 1U);
+
+    RLMAssertThrowsWithReason([RLMRealm startExpiringObjectsWithConfiguration:config interval:0
+                                                         maximumWriteDuration:1],
+                              @"must be greater than zero");
+}
+
 - (void)testRealmFileAccessNilPath {
     RLMAssertThrowsWithReasonMatching([RLMRealm realmWithURL:self.nonLiteralNil],
                                       @"Realm path must not be empty", @"nil path");
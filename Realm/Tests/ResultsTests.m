@@ -72,6 +72,158 @@
     XCTAssertNil(objects[0], @"Object should have been released");
 }
 
+- (void)testEnumerateInChunks {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    for (int i = 0; i < 10; ++i) {
+        [IntObject createInRealm:realm withValue:@[@(i)]];
+    }
+    [realm commitWriteTransaction];
+
+    RLMResults *results = [IntObject allObjectsInRealm:realm];
+    NSMutableArray *chunkSizes = [NSMutableArray new];
+    NSMutableArray *values = [NSMutableArray new];
+    [results enumerateObjectsInChunksOfSize:4 usingBlock:^(NSArray<IntObject *> *chunk, __unused BOOL *stop) {
+        [chunkSizes addObject:@(chunk.count)];
+        [values addObjectsFromArray:[chunk valueForKey:@"intCol"]];
+    }];
+    XCTAssertEqualObjects(chunkSizes, (@[@4, @4, @2]));
+    XCTAssertEqualObjects(values, (@[@0, @1, @2, @3, @4, @5, @6, @7, @8, @9]));
+
+    __block NSUInteger calls = 0;
+    [results enumerateObjectsInChunksOfSize:3 usingBlock:^(__unused NSArray *chunk, BOOL *stop) {
+        ++calls;
+        *stop = YES;
+    }];
+    XCTAssertEqual(calls, 1U);
+
+    RLMAssertThrowsWithReason([results enumerateObjectsInChunksOfSize:0 usingBlock:^(__unused NSArray *chunk, __unused BOOL *stop) {}],
+                              @"Chunk size must be greater than zero.");
+}
+
+- (void)testEnumerateWithReusedAccessor {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    for (int i = 0; i < 5; ++i) {
+        [IntObject createInRealm:realm withValue:@[@(i)]];
+    }
+    [realm commitWriteTransaction];
+
+    __block int sum = 0;
+    __block __unsafe_unretained IntObject *first = nil;
+    RLMResults *results = [IntObject objectsInRealm:realm where:@"intCol > 0"];
+    [results enumerateWithReusedAccessor:^(IntObject *obj, __unused BOOL *stop) {
+        if (!first) {
+            first = obj;
+        }
+        XCTAssertEqual(first, obj);
+        sum += obj.intCol;
+    }];
+    XCTAssertEqual(sum, 1 + 2 + 3 + 4);
+
+    __block int calls = 0;
+    [results enumerateWithReusedAccessor:^(__unused IntObject *obj, BOOL *stop) {
+        ++calls;
+        *stop = YES;
+    }];
+    XCTAssertEqual(calls, 1);
+}
+
+- (void)testEnumerateWithOptions {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    for (int i = 0; i < 100; ++i) {
+        [IntObject createInRealm:realm withValue:@[@(i)]];
+    }
+    [realm commitWriteTransaction];
+
+    RLMResults *results = [IntObject allObjectsInRealm:realm];
+    NSMutableArray *values = [NSMutableArray new];
+    [results enumerateObjectsWithOptions:NSEnumerationReverse usingBlock:^(IntObject *obj, NSUInteger index, BOOL *stop) {
+        XCTAssertEqual(obj.intCol, (int)index);
+        [values addObject:@(obj.intCol)];
+        *stop = values.count == 3;
+    }];
+    XCTAssertEqualObjects(values, (@[@99, @98, @97]));
+
+    RLMAssertThrowsWithReason([results enumerateObjectsWithOptions:NSEnumerationConcurrent
+                                                        usingBlock:^(__unused IntObject *obj, __unused NSUInteger index, __unused BOOL *stop) {}],
+                              @"Concurrent enumeration is only supported on frozen Results.");
+
+    __block int sum = 0;
+    NSLock *lock = [NSLock new];
+    [results.freeze enumerateObjectsWithOptions:NSEnumerationConcurrent
+                                     usingBlock:^(IntObject *obj, NSUInteger index, __unused BOOL *stop) {
+        XCTAssertEqual(obj.intCol, (int)index);
+        [lock lock];
+        sum += obj.intCol;
+        [lock unlock];
+    }];
+    XCTAssertEqual(sum, 4950);
+}
+
+- (void)testObjectsByEvaluatingConcurrently {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    for (int i = 0; i < 5000; ++i) {
+        [StringObject createInRealm:realm withValue:@[i % 7 ? @"abc" : @"xyZ"]];
+    }
+    [realm commitWriteTransaction];
+
+    RLMResults *results = [StringObject objectsInRealm:realm where:@"stringCol CONTAINS[c] 'z'"];
+    RLMAssertThrowsWithReason(results.objectsByEvaluatingConcurrently,
+                              @"Concurrent query evaluation is only supported on frozen Results.");
+
+    RLMResults *frozen = results.freeze;
+    NSArray *objects = frozen.objectsByEvaluatingConcurrently;
+    XCTAssertEqual(objects.count, frozen.count);
+    for (NSUInteger i = 0; i < objects.count; ++i) {
+        XCTAssertTrue([objects[i] isEqualToObject:frozen[i]]);
+    }
+
+    // Sorted results are evaluated on the calling thread
+    RLMResults *sorted = [frozen sortedResultsUsingKeyPath:@"stringCol" ascending:NO];
+    XCTAssertEqual(sorted.objectsByEvaluatingConcurrently.count, frozen.count);
+}
+
+- (void)testObjectsByEvaluatingConcurrentlyOnList {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    // Objects outside the list make the table much larger than the list, so
+    // splitting the table into ranges would index past the end of the list
+    for (int i = 0; i < 5000; ++i) {
+        [StringObject createInRealm:realm withValue:@[@"xyz"]];
+    }
+    ArrayPropertyObject *obj = [ArrayPropertyObject createInRealm:realm withValue:@[@"list", @[], @[]]];
+    for (int i = 0; i < 100; ++i) {
+        [obj.array addObject:[StringObject createInRealm:realm withValue:@[i % 2 ? @"abc" : @"xyZ"]]];
+    }
+    [realm commitWriteTransaction];
+
+    RLMResults *frozen = [obj.array objectsWhere:@"stringCol CONTAINS[c] 'z'"].freeze;
+    NSArray *objects = frozen.objectsByEvaluatingConcurrently;
+    XCTAssertEqual(objects.count, 50U);
+    XCTAssertEqual(objects.count, frozen.count);
+    for (NSUInteger i = 0; i < objects.count; ++i) {
+        XCTAssertTrue([objects[i] isEqualToObject:frozen[i]]);
+    }
+}
+
+- (void)testFastEnumerationLargerThanBuffer {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    for (int i = 0; i < 200; ++i) {
+        [IntObject createInRealm:realm withValue:@[@(i)]];
+    }
+    [realm commitWriteTransaction];
+
+    int expected = 0;
+    for (IntObject *obj in [IntObject allObjectsInRealm:realm]) {
+        XCTAssertEqual(obj.intCol, expected++);
+    }
+    XCTAssertEqual(expected, 200);
+}
+
 - (void)testFirst {
     XCTAssertNil(IntObject.allObjects.firstObject);
     XCTAssertNil([IntObject objectsWhere:@"intCol > 5"].firstObject);
@@ -140,6 +292,23 @@
     XCTAssertNil([[IntObject allObjects] objectsAtIndexes:indexSet]);
 }
 
+- (void)testObjectsInRange {
+    XCTAssertNil([[IntObject allObjects] objectsInRange:NSMakeRange(0, 1)]);
+    XCTAssertEqualObjects([[IntObject allObjects] objectsInRange:NSMakeRange(0, 0)], @[]);
+
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    [realm beginWriteTransaction];
+    for (int i = 0; i < 10; ++i) {
+        [IntObject createInDefaultRealmWithValue:@[@(i)]];
+    }
+    [realm commitWriteTransaction];
+
+    RLMResults *results = [IntObject objectsWhere:@"intCol >= 2"];
+    XCTAssertEqualObjects([[results objectsInRange:NSMakeRange(1, 3)] valueForKey:@"intCol"], (@[@3, @4, @5]));
+    XCTAssertEqual([results objectsInRange:NSMakeRange(0, 8)].count, 8U);
+    XCTAssertNil([results objectsInRange:NSMakeRange(5, 4)]);
+}
+
 - (void)testValueForKey {
     RLMRealm *realm = self.realmWithTestPath;
 
@@ -185,6 +354,178 @@
     XCTAssertThrows([[AggregateObject allObjectsInRealm:realm] valueForKey:@"invalid"]);
 }
 
+- (void)testPackedValuesOfProperty {
+    RLMRealm *realm = self.realmWithTestPath;
+
+    XCTAssertEqual([[AggregateObject allObjectsInRealm:realm] packedValuesOfProperty:@"intCol"].length, 0U);
+
+    [realm beginWriteTransaction];
+    [AggregateObject createInRealm:realm withValue:@[@3, @1.5f, @0.25, @YES, NSDate.date]];
+    [AggregateObject createInRealm:realm withValue:@[@-1, @0.0f, @2.5, @NO, NSDate.date]];
+    [realm commitWriteTransaction];
+
+    RLMResults *results = [AggregateObject allObjectsInRealm:realm];
+    NSData *ints = [results packedValuesOfProperty:@"intCol"];
+    XCTAssertEqual(ints.length, 2 * sizeof(int64_t));
+    XCTAssertEqual(((const int64_t *)ints.bytes)[0], 3);
+    XCTAssertEqual(((const int64_t *)ints.bytes)[1], -1);
+
+    NSData *floats = [results packedValuesOfProperty:@"floatCol"];
+    XCTAssertEqual(floats.length, 2 * sizeof(double));
+    XCTAssertEqual(((const double *)floats.bytes)[0], 1.5);
+    XCTAssertEqual(((const double *)floats.bytes)[1], 0.0);
+
+    NSData *doubles = [[results objectsWhere:@"intCol > 0"] packedValuesOfProperty:@"doubleCol"];
+    XCTAssertEqual(doubles.length, sizeof(double));
+    XCTAssertEqual(((const double *)doubles.bytes)[0], 0.25);
+
+    NSData *dates = [results packedValuesOfProperty:@"dateCol"];
+    XCTAssertEqual(dates.length, 2 * sizeof(int64_t));
+    XCTAssertEqualWithAccuracy(((const int64_t *)dates.bytes)[1] / 1e9,
+                               [results[1] dateCol].timeIntervalSince1970, 1e-6);
+
+    RLMAssertThrowsWithReason([results packedValuesOfProperty:@"boolCol"],
+                              @"only int, float, double and date properties are supported");
+    RLMAssertThrowsWithReason([results packedValuesOfProperty:@"invalid"],
+                              @"Invalid property name 'invalid' for class 'AggregateObject'.");
+}
+
+- (void)testSortedPrefixMatchesFullSort {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    for (int i = 0; i < 200; ++i) {
+        [AggregateObject createInRealm:realm withValue:@[@(i % 7), @0.0f, @0.0, @(i % 2 == 0),
+                                                         [NSDate dateWithTimeIntervalSince1970:i % 13]]];
+    }
+    [realm commitWriteTransaction];
+
+    NSArray *descriptors = @[[RLMSortDescriptor sortDescriptorWithKeyPath:@"intCol" ascending:NO],
+                             [RLMSortDescriptor sortDescriptorWithKeyPath:@"dateCol" ascending:YES]];
+    // Each read uses new results so that none of them have been evaluated yet
+    RLMResults *(^sorted)(void) = ^{
+        return [[AggregateObject allObjectsInRealm:realm] sortedResultsUsingDescriptors:descriptors];
+    };
+    NSMutableArray *all = [NSMutableArray new];
+    for (AggregateObject *obj in sorted()) {
+        [all addObject:obj];
+    }
+
+    XCTAssertEqualObjects(sorted().firstObject, all.firstObject);
+    XCTAssertEqualObjects(sorted().lastObject, all.lastObject);
+    XCTAssertEqualObjects([sorted() objectsInRange:NSMakeRange(3, 9)], [all subarrayWithRange:NSMakeRange(3, 9)]);
+    XCTAssertEqualObjects([[sorted() objectsWhere:@"boolCol = true"] firstObject],
+                          [all filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"boolCol = true"]].firstObject);
+    XCTAssertNil([sorted() objectsWhere:@"intCol > 10"].firstObject);
+
+    // Repeated reads from the same results reuse the selected prefix until
+    // the Realm advances to a new version
+    RLMResults *results = sorted();
+    XCTAssertEqualObjects([results objectsInRange:NSMakeRange(0, 5)], [all subarrayWithRange:NSMakeRange(0, 5)]);
+    XCTAssertEqualObjects(results.firstObject, all.firstObject);
+    XCTAssertEqualObjects(results.lastObject, all.lastObject);
+    XCTAssertEqualObjects(results.firstObject, all.firstObject);
+    [realm transactionWithBlock:^{
+        [AggregateObject createInRealm:realm withValue:@[@100, @0.0f, @0.0, @NO, [NSDate date]]];
+    }];
+    XCTAssertEqual([results.firstObject intCol], 100);
+}
+
+- (void)testSortedPrefixOfResortedListResults {
+    RLMRealm *realm = self.realmWithTestPath;
+    [realm beginWriteTransaction];
+    DogArrayObject *owner = [DogArrayObject createInRealm:realm withValue:@[@[@[@"a", @2], @[@"b", @1],
+                                                                              @[@"c", @2], @[@"d", @1]]]];
+    [realm commitWriteTransaction];
+
+    // Objects with the same age are ordered by the List's sort on the name
+    RLMResults *(^sorted)(void) = ^{
+        return [[[owner.dogs sortedResultsUsingKeyPath:@"dogName" ascending:NO] objectsWhere:@"age > 0"]
+                sortedResultsUsingKeyPath:@"age" ascending:YES];
+    };
+    XCTAssertEqualObjects([sorted() valueForKey:@"dogName"], (@[@"d", @"b", @"c", @"a"]));
+    XCTAssertEqualObjects([sorted().firstObject dogName], @"d");
+    XCTAssertEqualObjects([sorted().lastObject dogName], @"a");
+    XCTAssertEqualObjects([[sorted() objectsInRange:NSMakeRange(0, 2)] valueForKey:@"dogName"], (@[@"d", @"b"]));
+}
+
+- (void)testJSONLinesRoundTrip {
+    RLMRealm *realm = self.realmWithTestPath;
+
+    NSData *bytes = [NSData dataWithBytes:"a\nb" length:3];
+    NSDate *date = [NSDate dateWithTimeIntervalSince1970:1000];
+    RLMDecimal128 *decimal = [[RLMDecimal128 alloc] initWithString:@"123.456" error:nil];
+    RLMObjectId *objectId = [RLMObjectId objectId];
+    NSUUID *uuid = [NSUUID UUID];
+
+    [realm beginWriteTransaction];
+    [AllOptionalTypes createInRealm:realm withValue:@[@1, @1.5f, @2.5, @YES, @"line\n\"quoted\"",
+                                                      bytes, date, decimal, objectId, uuid]];
+    [AllOptionalTypes createInRealm:realm withValue:@[]];
+    [AllPrimitiveArrays createInRealm:realm withValue:@{@"intObj": @[@1, @2], @"stringObj": @[@"a", @"b"],
+                                                        @"dateObj": @[date], @"dataObj": @[bytes]}];
+    [realm commitWriteTransaction];
+
+    NSOutputStream *output = [NSOutputStream outputStreamToMemory];
+    [output open];
+    NSError *error;
+    XCTAssertTrue([[AllOptionalTypes allObjectsInRealm:realm] writeJSONLinesToStream:output error:&error]);
+    XCTAssertTrue([[AllPrimitiveArrays allObjectsInRealm:realm] writeJSONLinesToStream:output error:&error]);
+    XCTAssertNil(error);
+    NSData *data = [output propertyForKey:NSStreamDataWrittenToMemoryStreamKey];
+    [output close];
+    NSArray *lines = [[[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding]
+                      componentsSeparatedByString:@"\n"];
+    XCTAssertEqual(lines.count, 4U);
+
+    NSData *(^linesData)(NSRange) = ^(NSRange range) {
+        return [[[lines subarrayWithRange:range] componentsJoinedByString:@"\n"] dataUsingEncoding:NSUTF8StringEncoding];
+    };
+
+    RLMRealm *copy = [RLMRealm defaultRealm];
+    [copy beginWriteTransaction];
+    NSInputStream *input = [NSInputStream inputStreamWithData:linesData(NSMakeRange(0, 2))];
+    [input open];
+    XCTAssertTrue([copy createObjects:@"AllOptionalTypes" fromJSONLinesStream:input error:&error]);
+    [input close];
+    input = [NSInputStream inputStreamWithData:linesData(NSMakeRange(2, 1))];
+    [input open];
+    XCTAssertTrue([copy createObjects:@"AllPrimitiveArrays" fromJSONLinesStream:input error:&error]);
+    [input close];
+    XCTAssertNil(error);
+    [copy commitWriteTransaction];
+
+    RLMResults<AllOptionalTypes *> *optionals = [AllOptionalTypes allObjectsInRealm:copy];
+    XCTAssertEqual(optionals.count, 2U);
+    AllOptionalTypes *obj = optionals[0];
+    XCTAssertEqualObjects(obj.intObj, @1);
+    XCTAssertEqualObjects(obj.floatObj, @1.5f);
+    XCTAssertEqualObjects(obj.doubleObj, @2.5);
+    XCTAssertEqualObjects(obj.boolObj, @YES);
+    XCTAssertEqualObjects(obj.string, @"line\n\"quoted\"");
+    XCTAssertEqualObjects(obj.data, bytes);
+    XCTAssertEqualObjects(obj.date, date);
+    XCTAssertEqualObjects(obj.decimal, decimal);
+    XCTAssertEqualObjects(obj.objectId, objectId);
+    XCTAssertEqualObjects(obj.uuidCol, uuid);
+    XCTAssertNil(optionals[1].intObj);
+    XCTAssertNil(optionals[1].string);
+    XCTAssertNil(optionals[1].date);
+
+    AllPrimitiveArrays *arrays = [AllPrimitiveArrays allObjectsInRealm:copy].firstObject;
+    XCTAssertEqualObjects([arrays.intObj valueForKey:@"self"], (@[@1, @2]));
+    XCTAssertEqualObjects([arrays.stringObj valueForKey:@"self"], (@[@"a", @"b"]));
+    XCTAssertEqualObjects(arrays.dateObj.firstObject, date);
+    XCTAssertEqualObjects(arrays.dataObj.firstObject, bytes);
+
+    [copy beginWriteTransaction];
+    input = [NSInputStream inputStreamWithData:[@"{\"intObj\": 1}\nnot json\n" dataUsingEncoding:NSUTF8StringEncoding]];
+    [input open];
+    XCTAssertFalse([copy createObjects:@"AllOptionalTypes" fromJSONLinesStream:input error:&error]);
+    XCTAssertNotNil(error);
+    [input close];
+    [copy cancelWriteTransaction];
+}
+
 - (void)testSetValueForKey {
     RLMRealm *realm = self.realmWithTestPath;
 
@@ -412,6 +753,175 @@
     XCTAssertEqual(3, [[results maxOfProperty:@"propA"] intValue]);
 }
 
+- (void)testAggregateThroughLinks {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+
+    RLMResults *results = [OwnerObject allObjectsInRealm:realm];
+    XCTAssertEqual(0, [results sumOfProperty:@"dog.age"].intValue);
+    XCTAssertNil([results averageOfProperty:@"dog.age"]);
+    XCTAssertNil([results minOfProperty:@"dog.age"]);
+    XCTAssertNil([results maxOfProperty:@"dog.age"]);
+
+    [realm transactionWithBlock:^{
+        [OwnerObject createInRealm:realm withValue:@[@"a", @[@"Fido", @2]]];
+        [OwnerObject createInRealm:realm withValue:@[@"b", @[@"Rex", @4]]];
+        [OwnerObject createInRealm:realm withValue:@[@"c", @[@"Spot", @9]]];
+        [OwnerObject createInRealm:realm withValue:@[@"d", NSNull.null]];
+    }];
+
+    XCTAssertEqual(15, [results sumOfProperty:@"dog.age"].intValue);
+    XCTAssertEqual(5.0, [results averageOfProperty:@"dog.age"].doubleValue);
+    XCTAssertEqual(2, [[results minOfProperty:@"dog.age"] intValue]);
+    XCTAssertEqual(9, [[results maxOfProperty:@"dog.age"] intValue]);
+    XCTAssertEqual(15, [[results valueForKeyPath:@"@sum.dog.age"] intValue]);
+    XCTAssertEqual(6, [[[results objectsWhere:@"name != 'c'"] valueForKeyPath:@"@sum.dog.age"] intValue]);
+
+    NSDictionary *aggregates = [results aggregates:@[RLMAggregateOperationMin, RLMAggregateOperationMax,
+                                                     RLMAggregateOperationSum, RLMAggregateOperationAverage]
+                                        ofProperty:@"dog.age"];
+    XCTAssertEqualObjects(aggregates, (@{RLMAggregateOperationMin: @2, RLMAggregateOperationMax: @9,
+                                         RLMAggregateOperationSum: @15, RLMAggregateOperationAverage: @5.0}));
+    aggregates = [[DogObject allObjectsInRealm:realm] aggregates:@[RLMAggregateOperationMin, RLMAggregateOperationSum]
+                                                      ofProperty:@"age"];
+    XCTAssertEqualObjects(aggregates, (@{RLMAggregateOperationMin: @2, RLMAggregateOperationSum: @15}));
+    XCTAssertEqualObjects([[results objectsWhere:@"dog = nil"] aggregates:@[RLMAggregateOperationMin, RLMAggregateOperationSum]
+                                                                ofProperty:@"dog.age"],
+                          @{RLMAggregateOperationSum: @0});
+
+    RLMAssertThrowsWithReason([results sumOfProperty:@"dog.dogName"],
+                              @"sumOfProperty is not supported for string property 'dog.dogName'.");
+    RLMAssertThrowsWithReason([results sumOfProperty:@"name.age"],
+                              @"Nested key paths through 'name' are not supported");
+    RLMAssertThrowsWithReason([results sumOfProperty:@"dog.invalid"],
+                              @"Property 'invalid' not found in object of type 'DogObject'");
+    RLMAssertThrowsWithReason([results aggregates:@[@"median"] ofProperty:@"dog.age"],
+                              @"Unsupported aggregate operation 'median'.");
+}
+
+- (void)testGroupedAggregates {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+
+    RLMGroupedAggregates *groups = [[EmployeeObject allObjectsInRealm:realm] groupedBy:@"hired" aggregating:@"age"];
+    XCTAssertEqual(groups.count, 0U);
+
+    [realm transactionWithBlock:^{
+        [EmployeeObject createInRealm:realm withValue:@[@"A", @20, @YES]];
+        [EmployeeObject createInRealm:realm withValue:@[@"B", @30, @NO]];
+        [EmployeeObject createInRealm:realm withValue:@[@"C", @40, @YES]];
+        [EmployeeObject createInRealm:realm withValue:@[@"D", @50, @YES]];
+        [OwnerObject createInRealm:realm withValue:@[@"a", @[@"Fido", @2]]];
+        [OwnerObject createInRealm:realm withValue:@[@"b", @[@"Rex", @4]]];
+        [OwnerObject createInRealm:realm withValue:@[@"c", @[@"Fido", @9]]];
+        [OwnerObject createInRealm:realm withValue:@[@"d", NSNull.null]];
+    }];
+
+    groups = [[EmployeeObject allObjectsInRealm:realm] groupedBy:@"hired" aggregating:@"age"];
+    XCTAssertEqual(groups.count, 2U);
+    XCTAssertEqualObjects(groups.keys, (@[@YES, @NO]));
+    XCTAssertEqualObjects(groups.counts, (@[@3, @1]));
+    XCTAssertEqualObjects(groups.minimums, (@[@20, @30]));
+    XCTAssertEqualObjects(groups.maximums, (@[@50, @30]));
+    XCTAssertEqualObjects(groups.sums, (@[@110, @30]));
+    XCTAssertEqualObjects(groups.averages, (@[@(110.0 / 3), @30.0]));
+
+    groups = [[OwnerObject allObjectsInRealm:realm] groupedBy:@"dog.dogName" aggregating:@"dog.age"];
+    XCTAssertEqualObjects(groups.keys, (@[@"Fido", @"Rex", NSNull.null]));
+    XCTAssertEqualObjects(groups.counts, (@[@2, @1, @1]));
+    XCTAssertEqualObjects(groups.sums, (@[@11, @4, @0]));
+    XCTAssertEqualObjects(groups.averages, (@[@5.5, @4.0, NSNull.null]));
+
+    groups = [[OwnerObject objectsInRealm:realm where:@"dog != nil"] groupedBy:@"dog.dogName" aggregating:nil];
+    XCTAssertEqualObjects(groups.keys, (@[@"Fido", @"Rex"]));
+    XCTAssertEqualObjects(groups.counts, (@[@2, @1]));
+    XCTAssertEqualObjects(groups.sums, @[]);
+
+    RLMAssertThrowsWithReason([[OwnerObject allObjectsInRealm:realm] groupedBy:@"dog" aggregating:nil],
+                              @"Cannot group by object property 'dog'");
+    RLMAssertThrowsWithReason([[OwnerObject allObjectsInRealm:realm] groupedBy:@"name" aggregating:@"dog.dogName"],
+                              @"groupedBy:aggregating: is not supported for string property 'dog.dogName'.");
+}
+
+- (void)testGroupedAggregatesOfMixedKeys {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    [realm transactionWithBlock:^{
+        [MixedObject createInRealm:realm withValue:@{@"anyCol": @1}];
+        [MixedObject createInRealm:realm withValue:@{@"anyCol": @"a"}];
+        [MixedObject createInRealm:realm withValue:@{@"anyCol": @1.0}];
+        [MixedObject createInRealm:realm withValue:@{}];
+        [MixedObject createInRealm:realm withValue:@{@"anyCol": [RLMDecimal128 decimalWithNumber:@1]}];
+        [MixedObject createInRealm:realm withValue:@{@"anyCol": @2.5f}];
+        [MixedObject createInRealm:realm withValue:@{@"anyCol": NSNull.null}];
+    }];
+
+    // Numbers which compare equal are grouped together regardless of their type
+    RLMGroupedAggregates *groups = [[MixedObject allObjectsInRealm:realm] groupedBy:@"anyCol" aggregating:nil];
+    XCTAssertEqualObjects(groups.keys, (@[@1, @"a", NSNull.null, @2.5]));
+    XCTAssertEqualObjects(groups.counts, (@[@3, @1, @2, @1]));
+
+    [realm transactionWithBlock:^{
+        [MixedObject createInRealm:realm withValue:@{@"anyCol": [StringObject createInRealm:realm withValue:@[@"a"]]}];
+    }];
+    RLMAssertThrowsWithReason([[MixedObject allObjectsInRealm:realm] groupedBy:@"anyCol" aggregating:nil],
+                              @"Cannot group by mixed property 'anyCol' containing objects");
+}
+
+- (void)testGroupedAggregatesNotifications {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    __block EmployeeObject *oldest;
+    [realm transactionWithBlock:^{
+        [EmployeeObject createInRealm:realm withValue:@[@"A", @20, @YES]];
+        [EmployeeObject createInRealm:realm withValue:@[@"B", @30, @NO]];
+        oldest = [EmployeeObject createInRealm:realm withValue:@[@"C", @40, @YES]];
+    }];
+
+    __block RLMGroupedAggregates *groups;
+    __block NSUInteger calls = 0;
+    id token = [[EmployeeObject allObjectsInRealm:realm]
+                addGroupedAggregatesNotificationBlock:^(RLMGroupedAggregates *aggregates, NSError *error) {
+        XCTAssertNil(error);
+        groups = aggregates;
+        ++calls;
+        CFRunLoopStop(CFRunLoopGetCurrent());
+    } groupedBy:@"hired" aggregating:@"age" queue:nil];
+    CFRunLoopRun();
+    XCTAssertEqual(calls, 1U);
+    XCTAssertEqualObjects(groups.keys, (@[@YES, @NO]));
+    XCTAssertEqualObjects(groups.sums, (@[@60, @30]));
+    XCTAssertEqualObjects(groups.maximums, (@[@40, @30]));
+
+    // Changing a property which isn't grouped or aggregated doesn't notify
+    [realm transactionWithBlock:^{
+        oldest.name = @"D";
+    }];
+    // Removing the maximum of a group recalculates it
+    [realm transactionWithBlock:^{
+        oldest.hired = NO;
+        [EmployeeObject createInRealm:realm withValue:@[@"E", @25, @YES]];
+    }];
+    CFRunLoopRun();
+    XCTAssertEqual(calls, 2U);
+    XCTAssertEqualObjects(groups.keys, (@[@YES, @NO]));
+    XCTAssertEqualObjects(groups.counts, (@[@2, @2]));
+    XCTAssertEqualObjects(groups.sums, (@[@45, @70]));
+    XCTAssertEqualObjects(groups.maximums, (@[@25, @40]));
+
+    // Empty groups are omitted
+    [realm transactionWithBlock:^{
+        [realm deleteObjects:[EmployeeObject objectsInRealm:realm where:@"hired = YES"]];
+    }];
+    CFRunLoopRun();
+    XCTAssertEqual(calls, 3U);
+    XCTAssertEqualObjects(groups.keys, (@[@NO]));
+    XCTAssertEqualObjects(groups.averages, (@[@35.0]));
+
+    // The incrementally maintained groups match recalculating them
+    RLMGroupedAggregates *recalculated = [[EmployeeObject allObjectsInRealm:realm] groupedBy:@"hired" aggregating:@"age"];
+    XCTAssertEqualObjects(groups.counts, recalculated.counts);
+    XCTAssertEqualObjects(groups.sums, recalculated.sums);
+    XCTAssertEqualObjects(groups.minimums, recalculated.minimums);
+    [token invalidate];
+}
+
 
 - (void)testValueForCollectionOperationKeyPath {
     RLMRealm *realm = [RLMRealm defaultRealm];
@@ -1082,6 +1592,278 @@ static vm_size_t get_resident_size() {
     token = nil;
 }
 
+- (void)testCountTracksChangesAcrossVersions {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    RLMResults *results = [IntObject objectsWhere:@"intCol > 5"];
+    XCTAssertEqual(0u, results.count);
+
+    [realm beginWriteTransaction];
+    [IntObject createInRealm:realm withValue:@[@10]];
+    XCTAssertEqual(1u, results.count);
+    [IntObject createInRealm:realm withValue:@[@1]];
+    [IntObject createInRealm:realm withValue:@[@11]];
+    XCTAssertEqual(2u, results.count);
+    [realm commitWriteTransaction];
+    XCTAssertEqual(2u, results.count);
+
+    [self dispatchAsyncAndWait:^{
+        RLMRealm *realm = [RLMRealm defaultRealm];
+        [realm transactionWithBlock:^{
+            [IntObject createInRealm:realm withValue:@[@12]];
+        }];
+    }];
+    XCTAssertEqual(2u, results.count);
+    [realm refresh];
+    XCTAssertEqual(3u, results.count);
+
+    __block NSUInteger notifiedCount = 0;
+    id token = [results addNotificationBlock:^(RLMResults *results, __unused RLMCollectionChange *change, __unused NSError *error) {
+        notifiedCount = results.count;
+        CFRunLoopStop(CFRunLoopGetCurrent());
+    }];
+    CFRunLoopRun();
+    XCTAssertEqual(3u, notifiedCount);
+
+    [self dispatchAsyncAndWait:^{
+        RLMRealm *realm = [RLMRealm defaultRealm];
+        [realm transactionWithBlock:^{
+            [realm deleteObjects:[IntObject objectsInRealm:realm where:@"intCol = 10"]];
+        }];
+    }];
+    CFRunLoopRun();
+    XCTAssertEqual(2u, notifiedCount);
+    XCTAssertEqual(2u, results.count);
+    [token invalidate];
+}
+
+- (void)testIndexOfObjectTracksChangesWithNotifier {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    __block IntObject *five, *ten, *fifteen;
+    [realm transactionWithBlock:^{
+        ten = [IntObject createInRealm:realm withValue:@[@10]];
+        five = [IntObject createInRealm:realm withValue:@[@5]];
+        fifteen = [IntObject createInRealm:realm withValue:@[@15]];
+    }];
+
+    RLMResults *results = [[IntObject objectsWhere:@"intCol > 1"] sortedResultsUsingKeyPath:@"intCol" ascending:YES];
+    id token = [results addNotificationBlock:^(__unused RLMResults *results, __unused RLMCollectionChange *change, __unused NSError *error) {
+        CFRunLoopStop(CFRunLoopGetCurrent());
+    }];
+    CFRunLoopRun();
+
+    XCTAssertEqual(0U, [results indexOfObject:five]);
+    XCTAssertEqual(1U, [results indexOfObject:ten]);
+    XCTAssertEqual(2U, [results indexOfObject:fifteen]);
+
+    // Modifications which don't change the order
+    [realm transactionWithBlock:^{
+        ten.intCol = 11;
+    }];
+    XCTAssertEqual(0U, [results indexOfObject:five]);
+    XCTAssertEqual(1U, [results indexOfObject:ten]);
+    XCTAssertEqual(2U, [results indexOfObject:fifteen]);
+
+    // Modifications which do change the order
+    [realm transactionWithBlock:^{
+        five.intCol = 20;
+    }];
+    XCTAssertEqual(2U, [results indexOfObject:five]);
+    XCTAssertEqual(0U, [results indexOfObject:ten]);
+    XCTAssertEqual(1U, [results indexOfObject:fifteen]);
+
+    // Insertions and deletions
+    __block IntObject *two;
+    [realm transactionWithBlock:^{
+        two = [IntObject createInRealm:realm withValue:@[@2]];
+        [realm deleteObject:fifteen];
+    }];
+    XCTAssertEqual(0U, [results indexOfObject:two]);
+    XCTAssertEqual(1U, [results indexOfObject:ten]);
+    XCTAssertEqual(2U, [results indexOfObject:five]);
+
+    // Changes made on another thread which haven't been delivered yet
+    [self dispatchAsyncAndWait:^{
+        RLMRealm *realm = [RLMRealm defaultRealm];
+        [realm transactionWithBlock:^{
+            [IntObject createInRealm:realm withValue:@[@1]];
+            [realm deleteObjects:[IntObject objectsInRealm:realm where:@"intCol = 2"]];
+        }];
+    }];
+    [realm refresh];
+    XCTAssertEqual((NSUInteger)NSNotFound, [results indexOfObject:two]);
+    XCTAssertEqual(0U, [results indexOfObject:ten]);
+    XCTAssertEqual(1U, [results indexOfObject:five]);
+
+    // Inside a write transaction
+    [realm beginWriteTransaction];
+    IntObject *three = [IntObject createInRealm:realm withValue:@[@3]];
+    XCTAssertEqual(0U, [results indexOfObject:three]);
+    XCTAssertEqual(1U, [results indexOfObject:ten]);
+    [realm cancelWriteTransaction];
+    XCTAssertEqual(0U, [results indexOfObject:ten]);
+    [token invalidate];
+}
+
+- (void)testIndexOfObjectAfterSkippedNotification {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    __block IntObject *five, *ten, *fifteen;
+    [realm transactionWithBlock:^{
+        ten = [IntObject createInRealm:realm withValue:@[@10]];
+        five = [IntObject createInRealm:realm withValue:@[@5]];
+        fifteen = [IntObject createInRealm:realm withValue:@[@15]];
+    }];
+
+    RLMResults *results = [[IntObject objectsWhere:@"intCol > 1"] sortedResultsUsingKeyPath:@"intCol" ascending:YES];
+    __block int calls = 0;
+    id token = [results addNotificationBlock:^(__unused RLMResults *results, __unused RLMCollectionChange *change, __unused NSError *error) {
+        ++calls;
+        CFRunLoopStop(CFRunLoopGetCurrent());
+    }];
+    CFRunLoopRun();
+    XCTAssertEqual(0U, [results indexOfObject:five]);
+    XCTAssertEqual(1U, [results indexOfObject:ten]);
+
+    // The insertion is never reported, so the following modification-only
+    // notification mustn't carry the index forward
+    [realm beginWriteTransaction];
+    IntObject *two = [IntObject createInRealm:realm withValue:@[@2]];
+    XCTAssertTrue([realm commitWriteTransactionWithoutNotifying:@[token] error:nil]);
+    [realm transactionWithBlock:^{
+        fifteen.intCol = 16;
+    }];
+    XCTAssertEqual(2, calls);
+
+    XCTAssertEqual(0U, [results indexOfObject:two]);
+    XCTAssertEqual(1U, [results indexOfObject:five]);
+    XCTAssertEqual(2U, [results indexOfObject:ten]);
+    XCTAssertEqual(3U, [results indexOfObject:fifteen]);
+    [token invalidate];
+}
+
+- (void)testSectionedResults {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    [realm transactionWithBlock:^{
+        [DogObject createInRealm:realm withValue:@[@"Fido", @3]];
+        [DogObject createInRealm:realm withValue:@[@"Cujo", @3]];
+        [DogObject createInRealm:realm withValue:@[@"Buster", @5]];
+    }];
+
+    RLMSectionedResults *sections = [[[DogObject allObjectsInRealm:realm] sortedResultsUsingKeyPath:@"dogName" ascending:YES]
+                                     sectionedResultsUsingKeyPath:@"age" ascending:YES];
+    XCTAssertEqual(sections.count, 2U);
+    XCTAssertEqualObjects(sections.sectionKeys, (@[@3, @5]));
+    XCTAssertEqual([sections numberOfObjectsInSection:0], 2U);
+    XCTAssertEqual([sections numberOfObjectsInSection:1], 1U);
+    XCTAssertEqualObjects([[sections objectAtIndex:0 inSection:0] dogName], @"Cujo");
+    XCTAssertEqualObjects([[sections objectAtIndex:1 inSection:0] dogName], @"Fido");
+    XCTAssertEqualObjects([[sections objectAtIndex:0 inSection:1] dogName], @"Buster");
+    RLMAssertThrowsWithReason([sections numberOfObjectsInSection:2],
+                              @"Section index 2 is out of bounds (must be less than 2).");
+    RLMAssertThrowsWithReason([sections objectAtIndex:1 inSection:1],
+                              @"Index 1 is out of bounds (must be less than 1).");
+    RLMAssertThrowsWithReason([[DogObject allObjectsInRealm:realm] sectionedResultsUsingKeyPath:@"owners" ascending:YES],
+                              @"Nested key paths through 'owners' are not supported");
+
+    __block RLMSectionedResultsChange *lastChange;
+    id token = [sections addNotificationBlock:^(__unused RLMSectionedResults *sectioned, RLMSectionedResultsChange *change, NSError *error) {
+        XCTAssertNil(error);
+        lastChange = change;
+        CFRunLoopStop(CFRunLoopGetCurrent());
+    }];
+    CFRunLoopRun();
+    XCTAssertNil(lastChange);
+
+    [realm transactionWithBlock:^{
+        [DogObject createInRealm:realm withValue:@[@"Rex", @1]];
+        [DogObject createInRealm:realm withValue:@[@"Odie", @5]];
+        [realm deleteObjects:[DogObject objectsInRealm:realm where:@"dogName = 'Fido'"]];
+    }];
+    CFRunLoopRun();
+
+    XCTAssertEqualObjects(sections.sectionKeys, (@[@1, @3, @5]));
+    XCTAssertEqualObjects(lastChange.sectionInsertions, [NSIndexSet indexSetWithIndex:0]);
+    XCTAssertEqual(lastChange.sectionDeletions.count, 0U);
+    NSUInteger deleted[] = {0, 1}, inserted[] = {2, 1};
+    XCTAssertEqualObjects(lastChange.deletions, @[[NSIndexPath indexPathWithIndexes:deleted length:2]]);
+    XCTAssertEqualObjects(lastChange.insertions, @[[NSIndexPath indexPathWithIndexes:inserted length:2]]);
+    XCTAssertEqual(lastChange.modifications.count, 0U);
+
+    [realm transactionWithBlock:^{
+        [realm deleteObjects:[DogObject objectsInRealm:realm where:@"age = 3"]];
+    }];
+    CFRunLoopRun();
+    XCTAssertEqualObjects(sections.sectionKeys, (@[@1, @5]));
+    XCTAssertEqualObjects(lastChange.sectionDeletions, [NSIndexSet indexSetWithIndex:1]);
+    XCTAssertEqual(lastChange.deletions.count, 0U);
+    [token invalidate];
+}
+
+- (void)testWindowedResults {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    [realm transactionWithBlock:^{
+        for (int i = 0; i < 10; i++) {
+            [IntObject createInRealm:realm withValue:@[@(i)]];
+            [PrimaryNullableIntObject createInRealm:realm withValue:@[@(9 - i), @(i / 3)]];
+        }
+    }];
+
+    RLMResults *sorted = [IntObject.allObjects sortedResultsUsingKeyPath:@"intCol" ascending:NO];
+    RLMResults *page = [sorted windowedFrom:nil limit:4];
+    XCTAssertEqualObjects([page valueForKey:@"intCol"], (@[@9, @8, @7, @6]));
+    page = [sorted windowedFrom:page.lastObject limit:4];
+    XCTAssertEqualObjects([page valueForKey:@"intCol"], (@[@5, @4, @3, @2]));
+    page = [sorted windowedFrom:page.lastObject limit:4];
+    XCTAssertEqualObjects([page valueForKey:@"intCol"], (@[@1, @0]));
+    XCTAssertEqual([sorted windowedFrom:page.lastObject limit:4].count, 0U);
+
+    // Objects with equal values are ordered by their primary key
+    sorted = [PrimaryNullableIntObject.allObjects sortedResultsUsingKeyPath:@"value" ascending:YES];
+    NSMutableArray *keys = [NSMutableArray new];
+    for (page = [sorted windowedFrom:nil limit:2]; page.count; page = [sorted windowedFrom:page.lastObject limit:2]) {
+        [keys addObjectsFromArray:[page valueForKey:@"optIntCol"]];
+    }
+    XCTAssertEqualObjects(keys, (@[@7, @8, @9, @4, @5, @6, @1, @2, @3, @0]));
+
+    // Windows are live
+    page = [[IntObject.allObjects sortedResultsUsingKeyPath:@"intCol" ascending:YES] windowedFrom:nil limit:2];
+    [realm transactionWithBlock:^{
+        [IntObject createInRealm:realm withValue:@[@(-1)]];
+    }];
+    XCTAssertEqualObjects([page valueForKey:@"intCol"], (@[@(-1), @0]));
+
+    RLMAssertThrowsWithReason([IntObject.allObjects windowedFrom:page.firstObject limit:2],
+                              @"requires Results sorted with");
+    RLMAssertThrowsWithReason([sorted windowedFrom:nil limit:0],
+                              @"Invalid window limit 0: must be greater than zero.");
+    RLMAssertThrowsWithReason([sorted windowedFrom:page.firstObject limit:2],
+                              @"Object of type 'IntObject' does not match RLMResults type 'PrimaryNullableIntObject'.");
+}
+
+- (void)testWindowedResultsDescendingOnOptionalProperties {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    [realm transactionWithBlock:^{
+        [AllOptionalTypesPK createInRealm:realm withValue:@{@"pk": @0, @"intObj": @3, @"boolObj": @YES}];
+        [AllOptionalTypesPK createInRealm:realm withValue:@{@"pk": @1, @"intObj": @2}];
+        [AllOptionalTypesPK createInRealm:realm withValue:@{@"pk": @2, @"boolObj": @NO}];
+        [AllOptionalTypesPK createInRealm:realm withValue:@{@"pk": @3, @"intObj": @1, @"boolObj": @YES}];
+        [AllOptionalTypesPK createInRealm:realm withValue:@{@"pk": @4}];
+    }];
+
+    // Null sorts last in descending order, so every page has to include the
+    // nulls after the non-null values
+    NSArray *(^pagedKeys)(NSString *, NSUInteger) = ^(NSString *keyPath, NSUInteger limit) {
+        RLMResults *sorted = [AllOptionalTypesPK.allObjects sortedResultsUsingKeyPath:keyPath ascending:NO];
+        NSMutableArray *keys = [NSMutableArray new];
+        for (RLMResults *page = [sorted windowedFrom:nil limit:limit]; page.count;
+             page = [sorted windowedFrom:page.lastObject limit:limit]) {
+            [keys addObjectsFromArray:[page valueForKey:@"pk"]];
+        }
+        return keys;
+    };
+    XCTAssertEqualObjects(pagedKeys(@"intObj", 2), (@[@0, @1, @3, @2, @4]));
+    XCTAssertEqualObjects(pagedKeys(@"boolObj", 1), (@[@0, @3, @2, @1, @4]));
+}
+
 - (void)testDistinctQuery {
     RLMRealm *realm = [RLMRealm defaultRealm];
     __block DogObject *fido;
@@ -1129,6 +1911,65 @@ static vm_size_t get_resident_size() {
     
     XCTAssertEqualObjects(resultsArr, (@[@"Fido/3", @"Fido/4", @"Cujo/3", @"Buster/3", @"Rotunda/7"]));
 }
+
+- (void)testRepeatedSortsAndDistinctsWithSameKeyPaths {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    [realm transactionWithBlock:^{
+        [DogObject createInDefaultRealmWithValue:@[@"Fido", @3]];
+        [DogObject createInDefaultRealmWithValue:@[@"Cujo", @5]];
+        [DogObject createInDefaultRealmWithValue:@[@"Buster", @3]];
+        [DogObject createInDefaultRealmWithValue:@[@"Fido", @7]];
+    }];
+
+    NSArray *descriptors = @[[RLMSortDescriptor sortDescriptorWithKeyPath:@"age" ascending:YES],
+                             [RLMSortDescriptor sortDescriptorWithKeyPath:@"dogName" ascending:NO]];
+    NSArray *reversed = @[[RLMSortDescriptor sortDescriptorWithKeyPath:@"age" ascending:NO],
+                          [RLMSortDescriptor sortDescriptorWithKeyPath:@"dogName" ascending:NO]];
+    for (int i = 0; i < 2; ++i) {
+        XCTAssertEqualObjects([[[DogObject allObjects] sortedResultsUsingDescriptors:descriptors] valueForKey:@"dogName"],
+                              (@[@"Fido", @"Buster", @"Cujo", @"Fido"]));
+        XCTAssertEqualObjects([[[DogObject allObjects] sortedResultsUsingDescriptors:reversed] valueForKey:@"dogName"],
+                              (@[@"Fido", @"Cujo", @"Fido", @"Buster"]));
+        XCTAssertEqualObjects([[[DogObject objectsWhere:@"age > 3"] sortedResultsUsingDescriptors:descriptors] valueForKey:@"age"],
+                              (@[@5, @7]));
+        XCTAssertEqualObjects([[[[DogObject allObjects] sortedResultsUsingKeyPath:@"dogName" ascending:YES]
+                                distinctResultsUsingKeyPaths:@[@"dogName"]] valueForKey:@"dogName"],
+                              (@[@"Buster", @"Cujo", @"Fido"]));
+    }
+
+    // A sort on top of an existing sort still breaks ties with the earlier sort
+    RLMResults *sorted = [[[DogObject allObjects] sortedResultsUsingKeyPath:@"dogName" ascending:YES]
+                          sortedResultsUsingDescriptors:descriptors];
+    XCTAssertEqualObjects([sorted valueForKey:@"dogName"], (@[@"Fido", @"Buster", @"Cujo", @"Fido"]));
+    XCTAssertThrows([[DogObject allObjects] sortedResultsUsingKeyPath:@"missing" ascending:YES]);
+}
+
+- (void)testSortAndDistinctWithNoKeyPaths {
+    RLMRealm *realm = [RLMRealm defaultRealm];
+    __block DogArrayObject *array;
+    __block DogSetObject *set;
+    [realm transactionWithBlock:^{
+        DogObject *fido = [DogObject createInDefaultRealmWithValue:@[@"Fido", @3]];
+        DogObject *cujo = [DogObject createInDefaultRealmWithValue:@[@"Cujo", @5]];
+        array = [DogArrayObject createInDefaultRealmWithValue:@[@[cujo, fido]]];
+        set = [DogSetObject createInDefaultRealmWithValue:@[@[fido]]];
+    }];
+
+    for (int i = 0; i < 2; ++i) {
+        XCTAssertEqualObjects([[array.dogs sortedResultsUsingDescriptors:@[]] valueForKey:@"dogName"],
+                              (@[@"Cujo", @"Fido"]));
+        XCTAssertEqualObjects([[set.dogs sortedResultsUsingDescriptors:@[]] valueForKey:@"dogName"],
+                              (@[@"Fido"]));
+        XCTAssertEqualObjects([[array.dogs distinctResultsUsingKeyPaths:@[]] valueForKey:@"dogName"],
+                              (@[@"Cujo", @"Fido"]));
+
+        // An empty distinct on sorted results must not be mistaken for the sort
+        RLMResults *sorted = [[DogObject allObjects] sortedResultsUsingKeyPath:@"dogName" ascending:YES];
+        XCTAssertEqualObjects([[sorted distinctResultsUsingKeyPaths:@[]] valueForKey:@"dogName"],
+                              (@[@"Cujo", @"Fido"]));
+    }
+}
+
 - (void)testDistinctQueryWithMultilevelKeyPath {
     RLMRealm *realm = [RLMRealm defaultRealm];
     __block OwnerObject *owner1;
@@ -359,6 +359,44 @@ RLM_COLLECTION_TYPE(NotARealClass)
     XCTAssertNil([RLMSchema.sharedSchema schemaForClassName:@"RLMDynamicObject"]);
 }
 
+- (void)testRegisterObjectClassesValidation {
+    RLMAssertThrowsWithReason([RLMSchema registerObjectClasses:@[NSObject.class]],
+                              @"Can't register non-Object type 'NSObject'.");
+    // The shared schema is always initialized by the time tests run
+    [RLMSchema sharedSchema];
+    RLMAssertThrowsWithReason([RLMSchema registerObjectClasses:@[StringObject.class]],
+                              @"Object classes must be registered before any Realm is opened");
+}
+
+- (void)testManagedAccessorClasses {
+    RLMObjectSchema *objectSchema = [[RLMObjectSchema schemaForObjectClass:IntObject.class] copy];
+    XCTAssertEqual(objectSchema.accessorClass, IntObject.class);
+    [objectSchema setNeedsManagedAccessorClass];
+    Class accessorClass = objectSchema.accessorClass;
+    XCTAssertNotEqual(accessorClass, IntObject.class);
+    XCTAssertEqual(class_getSuperclass(accessorClass), IntObject.class);
+    XCTAssertTrue([@(class_getName(accessorClass)) hasPrefix:@"RLM:Managed "]);
+    // Reading it again, or requesting it again, reuses the same class
+    XCTAssertEqual(objectSchema.accessorClass, accessorClass);
+    [objectSchema setNeedsManagedAccessorClass];
+    XCTAssertEqual(objectSchema.accessorClass, accessorClass);
+
+    objectSchema.accessorClass = RLMDynamicObject.class;
+    [objectSchema setNeedsManagedAccessorClass];
+    XCTAssertEqual(objectSchema.accessorClass, RLMDynamicObject.class);
+
+    // Schemas with the same properties share an accessor class, but
+    // different ones need their own
+    RLMObjectSchema *sameSchema = [[RLMObjectSchema schemaForObjectClass:IntObject.class] copy];
+    [sameSchema setNeedsManagedAccessorClass];
+    XCTAssertEqual(sameSchema.accessorClass, accessorClass);
+
+    RLMObjectSchema *differentSchema = [[RLMObjectSchema schemaForObjectClass:IntObject.class] copy];
+    differentSchema.properties[0].optional = !differentSchema.properties[0].optional;
+    [differentSchema setNeedsManagedAccessorClass];
+    XCTAssertNotEqual(differentSchema.accessorClass, accessorClass);
+}
+
 - (void)testInheritanceInitialization
 {
     Class testClasses[] = {
@@ -97,7 +97,12 @@
     [realm commitWriteTransaction];
     AllPrimitiveSets *unman = [AllPrimitiveSets new];
 
-    XCTAssertThrows([setObj1.stringObj isSubsetOfSet:unman.stringObj]);
+    XCTAssertFalse([setObj1.stringObj isSubsetOfSet:unman.stringObj]);
+    [unman.stringObj addObjects:@[@"ten", @"one", @"nine", @"two", @"eight", @"three"]];
+    XCTAssertTrue([setObj1.stringObj isSubsetOfSet:unman.stringObj]);
+    XCTAssertTrue([setObj1.stringObj intersectsSet:unman.stringObj]);
+    XCTAssertFalse([setObj2.stringObj isSubsetOfSet:unman.stringObj]);
+    XCTAssertThrows([setObj1.stringObj isSubsetOfSet:unman.intObj]);
     XCTAssertThrows([setObj1.stringObj isSubsetOfSet:setObj2.intObj]);
     XCTAssertFalse([setObj1.stringObj isSubsetOfSet:setObj2.stringObj]);
     XCTAssertTrue([setObj3.stringObj isSubsetOfSet:setObj1.stringObj]);
@@ -119,8 +124,13 @@
     XCTAssertThrows([setObj1.stringObj intersectSet:setObj2.stringObj]);
     XCTAssertTrue([setObj1.stringObj intersectsSet:setObj2.stringObj]);
 
-    [realm beginWriteTransaction];
+    [unman.stringObj addObjects:@[@"nine", @"two", @"eight", @"three"]];
     XCTAssertThrows([setObj1.stringObj intersectSet:unman.stringObj]);
+
+    [realm beginWriteTransaction];
+    XCTAssertThrows([setObj1.stringObj intersectSet:unman.intObj]);
+    [setObj1.stringObj intersectSet:unman.stringObj];
+    XCTAssertEqual(setObj1.stringObj.count, 3U);
     [setObj1.stringObj intersectSet:setObj2.stringObj];
     [realm commitWriteTransaction];
 
@@ -167,11 +177,19 @@
     XCTAssertThrows([setObj1.stringObj minusSet:setObj2.stringObj]);
     XCTAssertThrows([setObj2.stringObj minusSet:setObj1.stringObj]);
 
+    AllPrimitiveSets *unman = [AllPrimitiveSets new];
+    [unman.stringObj addObjects:@[@"four", @"six"]];
+
     [realm beginWriteTransaction];
     [setObj1.stringObj minusSet:setObj2.stringObj];
     [setObj2.stringObj minusSet:setObj3.stringObj];
+    [setObj3.stringObj minusSet:unman.stringObj];
+    [setObj3.stringObj unionSet:unman.stringObj];
     [realm commitWriteTransaction];
 
+    XCTAssertEqual(setObj3.stringObj.count, 6U);
+    XCTAssertTrue([setObj3.stringObj containsObject:@"six"]);
+
     XCTAssertEqual(setObj1.stringObj.count, 2U);
     XCTAssertTrue([setObj1.stringObj.allObjects[0] isEqualToString:@"five"]);
     XCTAssertTrue([setObj1.stringObj.allObjects[1] isEqualToString:@"four"]);
@@ -51,6 +51,13 @@ import Realm
 */
 public typealias PropertyType = RLMPropertyType
 
+/**
+ The algorithm used to compress the values of a property listed in `Object.compressedProperties()`.
+
+ - see: `RLMCompressionAlgorithm`
+ */
+public typealias CompressionAlgorithm = RLMCompressionAlgorithm
+
 /**
  An opaque token which is returned from methods which subscribe to changes to a Realm.
 
@@ -58,6 +65,48 @@ public typealias PropertyType = RLMPropertyType
  */
 public typealias NotificationToken = RLMNotificationToken
 
+/**
+ A version of a Realm file which is being kept alive by a `Realm` instance.
+
+ - see: `Realm.versionPins(configuration:)`
+ */
+public typealias VersionPin = RLMVersionPin
+
+/**
+ A snapshot of the storage used by a Realm file.
+
+ - see: `Realm.storageStatistics`
+ */
+public typealias StorageStatistics = RLMStorageStatistics
+
+/**
+ The names of the classes which were changed between two versions of a Realm.
+
+ - see: `Realm.observeChangeSummary(_:)`
+ */
+public typealias RealmChangeSummary = RLMRealmChangeSummary
+
+/**
+ Metadata about a Realm file which has not been opened.
+
+ - see: `realmFileInfo(at:encryptionKey:)`
+ */
+public typealias RealmFileInfo = RLMRealmFileInfo
+
+/**
+ A background task which deletes expired objects from a Realm.
+
+ - see: `Realm.startExpiringObjects(configuration:interval:maximumWriteDuration:)`
+ */
+public typealias ExpirationSweeper = RLMExpirationSweeper
+
+/**
+ Timing and size information about a single write transaction.
+
+ - see: `Realm.Configuration.writeTransactionObserver`
+ */
+public typealias WriteTransactionMetrics = RLMWriteTransactionMetrics
+
 /// :nodoc:
 public typealias ObjectBase = RLMObjectBase
 extension ObjectBase {
@@ -140,19 +189,20 @@ extension ObjectBase {
     // swiftlint:disable:next identifier_name
     internal func _observe<T: ObjectBase>(keyPaths: [String]? = nil,
                                           on queue: DispatchQueue? = nil,
+                                          includeValues: Bool = true,
                                           _ block: @escaping (ObjectChange<T>) -> Void) -> NotificationToken {
-        return RLMObjectBaseAddNotificationBlock(self, keyPaths, queue) { object, names, oldValues, newValues, error in
+        return RLMObjectBaseAddNotificationBlock(self, keyPaths, queue, includeValues) { object, names, oldValues, newValues, error in
             if let error = error {
                 block(.error(error as NSError))
                 return
             }
-            guard let names = names, let newValues = newValues else {
+            guard let names = names else {
                 block(.deleted)
                 return
             }
 
-            block(.change(object as! T, (0..<newValues.count).map { i in
-                PropertyChange(name: names[i], oldValue: oldValues?[i], newValue: newValues[i])
+            block(.change(object as! T, (0..<names.count).map { i in
+                PropertyChange(name: names[i], oldValue: oldValues?[i], newValue: newValues?[i])
             }))
         }
     }
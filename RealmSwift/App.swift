@@ -105,6 +105,11 @@ let credentials = Credentials.JWT(token: myToken)
     case anonymous
 }
 
+/// A snapshot of how the function calls made through an `App` have used its
+/// function result cache.
+/// - see: `App.cacheResults(ofFunctionNamed:timeToLive:)`
+public typealias FunctionCacheStatistics = RLMFunctionCacheStatistics
+
 /// The `App` has the fundamental set of methods for communicating with a Realm
 /// application backend.
 /// This interface provides access to login and authentication.
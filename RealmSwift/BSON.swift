@@ -479,3 +479,260 @@ extension AnyBSON: ExpressibleByArrayLiteral {
 extension AnyBSON: Equatable {}
 
 extension AnyBSON: Hashable {}
+
+// MARK: - Decoding
+
+/// Decodes `Decodable` values directly from the Objective-C representation of
+/// a BSON document, without first converting it to `AnyBSON`.
+internal struct BSONDecoder {
+    func decode<T: Decodable>(_ type: T.Type, from document: NSDictionary) throws -> T {
+        return try BSONValueDecoder(value: document, codingPath: []).unbox(type)
+    }
+}
+
+private struct BSONCodingKey: CodingKey {
+    var stringValue: String
+    var intValue: Int?
+
+    init(stringValue: String) {
+        self.stringValue = stringValue
+    }
+
+    init(intValue: Int) {
+        self.stringValue = "Index \(intValue)"
+        self.intValue = intValue
+    }
+}
+
+private struct BSONValueDecoder: Decoder {
+    let value: Any
+    let codingPath: [CodingKey]
+    var userInfo: [CodingUserInfoKey: Any] { [:] }
+
+    func container<Key>(keyedBy type: Key.Type) throws -> KeyedDecodingContainer<Key> where Key: CodingKey {
+        guard let document = value as? NSDictionary else {
+            throw typeMismatch([String: Any].self)
+        }
+        return KeyedDecodingContainer(KeyedContainer<Key>(document: document, codingPath: codingPath))
+    }
+
+    func unkeyedContainer() throws -> UnkeyedDecodingContainer {
+        guard let array = value as? NSArray else {
+            throw typeMismatch([Any].self)
+        }
+        return UnkeyedContainer(array: array, codingPath: codingPath)
+    }
+
+    func singleValueContainer() throws -> SingleValueDecodingContainer {
+        return self
+    }
+
+    func typeMismatch(_ type: Any.Type) -> DecodingError {
+        return DecodingError.typeMismatch(type, .init(codingPath: codingPath,
+                                                      debugDescription: "Expected \(type) but found \(Swift.type(of: value)) instead."))
+    }
+
+    func unboxInteger<T: FixedWidthInteger>(_ type: T.Type) throws -> T {
+        guard let number = value as? NSNumber, (value as? RLMBSON)?.__bsonType != .bool else {
+            throw typeMismatch(type)
+        }
+        guard let result = T(exactly: number.int64Value), number.doubleValue == Double(number.int64Value) else {
+            throw DecodingError.dataCorrupted(.init(codingPath: codingPath,
+                                                    debugDescription: "Number \(number) does not fit in \(type)."))
+        }
+        return result
+    }
+
+    func unbox<T: Decodable>(_ type: T.Type) throws -> T {
+        // BSON types which are stored natively rather than through their
+        // Codable representation
+        switch type {
+        case is ObjectId.Type:
+            guard let oid = value as? RLMObjectId else { throw typeMismatch(type) }
+            return try ObjectId(string: oid.stringValue) as! T
+        case is Decimal128.Type:
+            guard let decimal = value as? RLMDecimal128 else { throw typeMismatch(type) }
+            return Decimal128(value: decimal) as! T
+        case is Date.Type:
+            guard let date = value as? NSDate else { throw typeMismatch(type) }
+            return date as Date as! T
+        case is Data.Type:
+            guard let data = value as? NSData else { throw typeMismatch(type) }
+            return data as Data as! T
+        case is UUID.Type:
+            guard let uuid = value as? NSUUID else { throw typeMismatch(type) }
+            return uuid as UUID as! T
+        default:
+            return try T(from: self)
+        }
+    }
+}
+
+extension BSONValueDecoder: SingleValueDecodingContainer {
+    func decodeNil() -> Bool {
+        return value is NSNull
+    }
+
+    func decode(_ type: Bool.Type) throws -> Bool {
+        guard let number = value as? NSNumber, (value as? RLMBSON)?.__bsonType == .bool else {
+            throw typeMismatch(type)
+        }
+        return number.boolValue
+    }
+
+    func decode(_ type: String.Type) throws -> String {
+        guard let string = value as? String else { throw typeMismatch(type) }
+        return string
+    }
+
+    func decode(_ type: Double.Type) throws -> Double {
+        guard let number = value as? NSNumber, (value as? RLMBSON)?.__bsonType != .bool else {
+            throw typeMismatch(type)
+        }
+        return number.doubleValue
+    }
+
+    func decode(_ type: Float.Type) throws -> Float {
+        return Float(try decode(Double.self))
+    }
+
+    func decode(_ type: Int.Type) throws -> Int { try unboxInteger(type) }
+    func decode(_ type: Int8.Type) throws -> Int8 { try unboxInteger(type) }
+    func decode(_ type: Int16.Type) throws -> Int16 { try unboxInteger(type) }
+    func decode(_ type: Int32.Type) throws -> Int32 { try unboxInteger(type) }
+    func decode(_ type: Int64.Type) throws -> Int64 { try unboxInteger(type) }
+    func decode(_ type: UInt.Type) throws -> UInt { try unboxInteger(type) }
+    func decode(_ type: UInt8.Type) throws -> UInt8 { try unboxInteger(type) }
+    func decode(_ type: UInt16.Type) throws -> UInt16 { try unboxInteger(type) }
+    func decode(_ type: UInt32.Type) throws -> UInt32 { try unboxInteger(type) }
+    func decode(_ type: UInt64.Type) throws -> UInt64 { try unboxInteger(type) }
+
+    func decode<T: Decodable>(_ type: T.Type) throws -> T {
+        return try unbox(type)
+    }
+}
+
+private struct KeyedContainer<Key: CodingKey>: KeyedDecodingContainerProtocol {
+    let document: NSDictionary
+    let codingPath: [CodingKey]
+
+    var allKeys: [Key] {
+        return document.allKeys.compactMap { ($0 as? String).flatMap(Key.init(stringValue:)) }
+    }
+
+    func contains(_ key: Key) -> Bool {
+        return document[key.stringValue] != nil
+    }
+
+    private func decoder(forKey key: Key) throws -> BSONValueDecoder {
+        guard let value = document[key.stringValue] else {
+            throw DecodingError.keyNotFound(key, .init(codingPath: codingPath,
+                                                       debugDescription: "No value associated with key \(key.stringValue)."))
+        }
+        return BSONValueDecoder(value: value, codingPath: codingPath + [key])
+    }
+
+    func decodeNil(forKey key: Key) throws -> Bool {
+        return try decoder(forKey: key).decodeNil()
+    }
+
+    func decode(_ type: Bool.Type, forKey key: Key) throws -> Bool { try decoder(forKey: key).decode(type) }
+    func decode(_ type: String.Type, forKey key: Key) throws -> String { try decoder(forKey: key).decode(type) }
+    func decode(_ type: Double.Type, forKey key: Key) throws -> Double { try decoder(forKey: key).decode(type) }
+    func decode(_ type: Float.Type, forKey key: Key) throws -> Float { try decoder(forKey: key).decode(type) }
+    func decode(_ type: Int.Type, forKey key: Key) throws -> Int { try decoder(forKey: key).decode(type) }
+    func decode(_ type: Int8.Type, forKey key: Key) throws -> Int8 { try decoder(forKey: key).decode(type) }
+    func decode(_ type: Int16.Type, forKey key: Key) throws -> Int16 { try decoder(forKey: key).decode(type) }
+    func decode(_ type: Int32.Type, forKey key: Key) throws -> Int32 { try decoder(forKey: key).decode(type) }
+    func decode(_ type: Int64.Type, forKey key: Key) throws -> Int64 { try decoder(forKey: key).decode(type) }
+    func decode(_ type: UInt.Type, forKey key: Key) throws -> UInt { try decoder(forKey: key).decode(type) }
+    func decode(_ type: UInt8.Type, forKey key: Key) throws -> UInt8 { try decoder(forKey: key).decode(type) }
+    func decode(_ type: UInt16.Type, forKey key: Key) throws -> UInt16 { try decoder(forKey: key).decode(type) }
+    func decode(_ type: UInt32.Type, forKey key: Key) throws -> UInt32 { try decoder(forKey: key).decode(type) }
+    func decode(_ type: UInt64.Type, forKey key: Key) throws -> UInt64 { try decoder(forKey: key).decode(type) }
+
+    func decode<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T {
+        return try decoder(forKey: key).unbox(type)
+    }
+
+    func nestedContainer<NestedKey>(keyedBy type: NestedKey.Type,
+                                    forKey key: Key) throws -> KeyedDecodingContainer<NestedKey> where NestedKey: CodingKey {
+        return try decoder(forKey: key).container(keyedBy: type)
+    }
+
+    func nestedUnkeyedContainer(forKey key: Key) throws -> UnkeyedDecodingContainer {
+        return try decoder(forKey: key).unkeyedContainer()
+    }
+
+    func superDecoder() throws -> Decoder {
+        return BSONValueDecoder(value: document["super"] ?? NSNull(), codingPath: codingPath + [BSONCodingKey(stringValue: "super")])
+    }
+
+    func superDecoder(forKey key: Key) throws -> Decoder {
+        return BSONValueDecoder(value: document[key.stringValue] ?? NSNull(), codingPath: codingPath + [key])
+    }
+}
+
+private struct UnkeyedContainer: UnkeyedDecodingContainer {
+    let array: NSArray
+    let codingPath: [CodingKey]
+    private(set) var currentIndex = 0
+
+    init(array: NSArray, codingPath: [CodingKey]) {
+        self.array = array
+        self.codingPath = codingPath
+    }
+
+    var count: Int? { array.count }
+    var isAtEnd: Bool { currentIndex >= array.count }
+
+    private mutating func nextDecoder() throws -> BSONValueDecoder {
+        let key = BSONCodingKey(intValue: currentIndex)
+        guard !isAtEnd else {
+            throw DecodingError.valueNotFound(Any.self, .init(codingPath: codingPath + [key],
+                                                              debugDescription: "Unkeyed container is at end."))
+        }
+        let decoder = BSONValueDecoder(value: array[currentIndex], codingPath: codingPath + [key])
+        currentIndex += 1
+        return decoder
+    }
+
+    mutating func decodeNil() throws -> Bool {
+        guard !isAtEnd, array[currentIndex] is NSNull else {
+            return false
+        }
+        currentIndex += 1
+        return true
+    }
+
+    mutating func decode(_ type: Bool.Type) throws -> Bool { try nextDecoder().decode(type) }
+    mutating func decode(_ type: String.Type) throws -> String { try nextDecoder().decode(type) }
+    mutating func decode(_ type: Double.Type) throws -> Double { try nextDecoder().decode(type) }
+    mutating func decode(_ type: Float.Type) throws -> Float { try nextDecoder().decode(type) }
+    mutating func decode(_ type: Int.Type) throws -> Int { try nextDecoder().decode(type) }
+    mutating func decode(_ type: Int8.Type) throws -> Int8 { try nextDecoder().decode(type) }
+    mutating func decode(_ type: Int16.Type) throws -> Int16 { try nextDecoder().decode(type) }
+    mutating func decode(_ type: Int32.Type) throws -> Int32 { try nextDecoder().decode(type) }
+    mutating func decode(_ type: Int64.Type) throws -> Int64 { try nextDecoder().decode(type) }
+    mutating func decode(_ type: UInt.Type) throws -> UInt { try nextDecoder().decode(type) }
+    mutating func decode(_ type: UInt8.Type) throws -> UInt8 { try nextDecoder().decode(type) }
+    mutating func decode(_ type: UInt16.Type) throws -> UInt16 { try nextDecoder().decode(type) }
+    mutating func decode(_ type: UInt32.Type) throws -> UInt32 { try nextDecoder().decode(type) }
+    mutating func decode(_ type: UInt64.Type) throws -> UInt64 { try nextDecoder().decode(type) }
+
+    mutating func decode<T: Decodable>(_ type: T.Type) throws -> T {
+        return try nextDecoder().unbox(type)
+    }
+
+    mutating func nestedContainer<NestedKey>(keyedBy type: NestedKey.Type) throws -> KeyedDecodingContainer<NestedKey> where NestedKey: CodingKey {
+        return try nextDecoder().container(keyedBy: type)
+    }
+
+    mutating func nestedUnkeyedContainer() throws -> UnkeyedDecodingContainer {
+        return try nextDecoder().unkeyedContainer()
+    }
+
+    mutating func superDecoder() throws -> Decoder {
+        return try nextDecoder()
+    }
+}
@@ -0,0 +1,310 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2021 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+import Foundation
+import Realm
+
+#if swift(>=5.5) && canImport(_Concurrency)
+
+/**
+ How a change stream buffers changes which have been produced but not yet
+ consumed by the task iterating over it.
+ */
+@frozen public enum ChangeBuffering {
+    /// Only the newest change is kept. A collection change which replaces an
+    /// unconsumed change is delivered as `.initial`, as the changes in between
+    /// are lost, and an object change only reports the most recently changed
+    /// properties.
+    case latest
+    /// Up to the given number of changes are kept, after which each new change
+    /// is merged into the newest buffered change.
+    case bounded(Int)
+    /// All unconsumed changes are merged into a single change.
+    case coalesced
+}
+
+/**
+ An asynchronous sequence of the changes made to a Realm collection or object,
+ created with `changes(keyPaths:buffering:)`.
+
+ The collections and objects in the changes are frozen, so they can be used
+ from whichever thread the consuming task runs on. Notifications are delivered
+ on a background queue, and changes which arrive faster than they are consumed
+ are buffered according to the stream's `ChangeBuffering` policy rather than
+ accumulating without bound.
+
+ Iteration ends when the observed object is deleted or an error occurs, and the
+ notifications stop once the iterator is released or its task is cancelled.
+ */
+@available(macOS 12.0, tvOS 15.0, iOS 15.0, watchOS 8.0, *)
+public struct RealmChangeStream<Change>: AsyncSequence {
+    /// :nodoc:
+    public typealias Element = Change
+
+    private let buffer: ChangeStreamBuffer<Change>
+
+    fileprivate init(_ buffer: ChangeStreamBuffer<Change>) {
+        self.buffer = buffer
+    }
+
+    /// The iterator for a `RealmChangeStream`.
+    public struct AsyncIterator: AsyncIteratorProtocol {
+        fileprivate let buffer: ChangeStreamBuffer<Change>
+
+        /// Waits for and returns the next change, or `nil` if the stream has ended.
+        public mutating func next() async -> Change? {
+            return await buffer.next()
+        }
+    }
+
+    /// :nodoc:
+    public func makeAsyncIterator() -> AsyncIterator {
+        return AsyncIterator(buffer: buffer)
+    }
+}
+
+@available(macOS 12.0, tvOS 15.0, iOS 15.0, watchOS 8.0, *)
+private final class ChangeStreamBuffer<Change> {
+    private let lock = NSLock()
+    private let buffering: ChangeBuffering
+    private let merge: (Change, Change) -> Change
+    private let replace: (Change) -> Change
+    private var pending = [Change]()
+    private var waiter: CheckedContinuation<Change?, Never>?
+    private var finished = false
+    var token: NotificationToken?
+
+    init(_ buffering: ChangeBuffering, merge: @escaping (Change, Change) -> Change,
+         replace: @escaping (Change) -> Change) {
+        self.buffering = buffering
+        self.merge = merge
+        self.replace = replace
+    }
+
+    deinit {
+        token?.invalidate()
+    }
+
+    func push(_ change: Change, isFinal: Bool = false) {
+        lock.lock()
+        guard !finished else {
+            lock.unlock()
+            return
+        }
+        finished = isFinal
+        if let waiter = waiter {
+            self.waiter = nil
+            lock.unlock()
+            waiter.resume(returning: change)
+            return
+        }
+        if let last = pending.last {
+            switch buffering {
+            case .latest:
+                pending[pending.count - 1] = replace(change)
+            case .bounded(let limit) where pending.count < limit:
+                pending.append(change)
+            case .bounded, .coalesced:
+                pending[pending.count - 1] = merge(last, change)
+            }
+        } else {
+            pending.append(change)
+        }
+        lock.unlock()
+    }
+
+    private func finish() {
+        lock.lock()
+        finished = true
+        let waiter = self.waiter
+        self.waiter = nil
+        lock.unlock()
+        token?.invalidate()
+        waiter?.resume(returning: nil)
+    }
+
+    func next() async -> Change? {
+        return await onCancel({ self.finish() }) {
+            await withCheckedContinuation { (continuation: CheckedContinuation<Change?, Never>) in
+                lock.lock()
+                if !pending.isEmpty {
+                    let change = pending.removeFirst()
+                    lock.unlock()
+                    continuation.resume(returning: change)
+                } else if finished || Task.isCancelled {
+                    lock.unlock()
+                    continuation.resume(returning: nil)
+                } else {
+                    waiter = continuation
+                    lock.unlock()
+                }
+            }
+        }
+    }
+}
+
+@available(macOS 12.0, tvOS 15.0, iOS 15.0, watchOS 8.0, *)
+private func onCancel<T>(_ handler: @escaping @Sendable () -> Void,
+                         _ operation: () async -> T) async -> T {
+#if swift(>=5.7)
+    return await withTaskCancellationHandler(operation: operation, onCancel: handler)
+#else
+    return await withTaskCancellationHandler(handler: handler, operation: operation)
+#endif
+}
+
+// MARK: Collection Changes
+
+/// Combines two consecutive collection changes into a single change from the
+/// state before the first to the state after the second.
+private func merge<C: RealmCollection>(_ first: RealmCollectionChange<C>,
+                                       _ second: RealmCollectionChange<C>) -> RealmCollectionChange<C> {
+    switch (first, second) {
+    case (.error, _), (_, .error), (.update, .initial), (.initial, .initial):
+        return second
+    case (.initial, .update(let collection, _, _, _)):
+        return .initial(collection)
+    case let (.update(middle, deletions1, insertions1, modifications1),
+              .update(collection, deletions2, insertions2, modifications2)):
+        // Index changes never contain moves, so rows which are not deleted
+        // keep their relative order. Track which row of the original collection
+        // (or nil for inserted rows) is at each index after each change.
+        let oldCount = middle.count - insertions1.count + deletions1.count
+        func apply(_ rows: [Int?], deletions: [Int], insertions: [Int], count: Int) -> [Int?] {
+            let deleted = Set(deletions), inserted = Set(insertions)
+            var kept = rows.indices.lazy.filter { !deleted.contains($0) }.map { rows[$0] }.makeIterator()
+            return (0..<count).map { inserted.contains($0) ? nil : kept.next()! }
+        }
+        let middleRows = apply((0..<oldCount).map { $0 }, deletions: deletions1, insertions: insertions1, count: middle.count)
+        let newRows = apply(middleRows, deletions: deletions2, insertions: insertions2, count: collection.count)
+
+        let remaining = Set(newRows.compactMap { $0 })
+        var modified = Set(modifications1)
+        modified.formUnion(modifications2.compactMap { middleRows[$0] })
+        return .update(collection,
+                       deletions: (0..<oldCount).filter { !remaining.contains($0) },
+                       insertions: newRows.indices.filter { newRows[$0] == nil },
+                       modifications: modified.intersection(remaining).sorted())
+    }
+}
+
+private func replace<C: RealmCollection>(_ change: RealmCollectionChange<C>) -> RealmCollectionChange<C> {
+    if case .update(let collection, _, _, _) = change {
+        return .initial(collection)
+    }
+    return change
+}
+
+@available(macOS 12.0, tvOS 15.0, iOS 15.0, watchOS 8.0, *)
+private func changeStream<Collection: RealmCollection>(
+        buffering: ChangeBuffering,
+        _ observe: (DispatchQueue, @escaping (RealmCollectionChange<Collection>) -> Void) -> NotificationToken
+    ) -> RealmChangeStream<RealmCollectionChange<Collection>> {
+    let buffer = ChangeStreamBuffer<RealmCollectionChange<Collection>>(buffering, merge: merge, replace: replace)
+    let queue = DispatchQueue(label: "io.realm.changes")
+    buffer.token = observe(queue) { [weak buffer] change in
+        switch change {
+        case .initial(let collection):
+            buffer?.push(.initial(collection.freeze()))
+        case let .update(collection, deletions, insertions, modifications):
+            buffer?.push(.update(collection.freeze(), deletions: deletions,
+                                 insertions: insertions, modifications: modifications))
+        case .error:
+            buffer?.push(change, isFinal: true)
+        }
+    }
+    return RealmChangeStream(buffer)
+}
+
+@available(macOS 12.0, tvOS 15.0, iOS 15.0, watchOS 8.0, *)
+extension Results {
+    /**
+     Returns an asynchronous sequence of the changes to the results.
+
+     The first element is an `.initial` change with the current results, and
+     each subsequent element describes a write which changed them. The results
+     in each change are frozen.
+
+     ```swift
+     for await change in realm.objects(Dog.self).changes(buffering: .latest) {
+         if case .initial(let dogs) = change { reload(dogs) }
+     }
+     ```
+
+     - parameter keyPaths: Only properties contained in the key paths array will trigger
+                           a change. See `observe(keyPaths:on:_:)`.
+     - parameter buffering: How changes which have not been consumed yet are buffered.
+     - returns: An asynchronous sequence of the changes to the results.
+     */
+    public func changes(keyPaths: [String]? = nil,
+                        buffering: ChangeBuffering = .coalesced) -> RealmChangeStream<RealmCollectionChange<Results>> {
+        return changeStream(buffering: buffering) { queue, block in
+            observe(keyPaths: keyPaths, on: queue, block)
+        }
+    }
+}
+
+// MARK: Object Changes
+
+private func merge<T: ObjectBase>(_ first: ObjectChange<T>, _ second: ObjectChange<T>) -> ObjectChange<T> {
+    guard case .change(_, let properties1) = first, case .change(let object, let properties2) = second else {
+        return second
+    }
+    var properties = properties1
+    for property in properties2 {
+        if let index = properties.firstIndex(where: { $0.name == property.name }) {
+            properties[index] = PropertyChange(name: property.name, oldValue: properties[index].oldValue,
+                                               newValue: property.newValue)
+        } else {
+            properties.append(property)
+        }
+    }
+    return .change(object, properties)
+}
+
+@available(macOS 12.0, tvOS 15.0, iOS 15.0, watchOS 8.0, *)
+extension ThreadConfined where Self: Object {
+    /**
+     Returns an asynchronous sequence of the changes to the object.
+
+     Each element describes a write which changed the object, with the object
+     in `.change` frozen at the version after the write. The sequence ends after
+     delivering `.deleted` or `.error`.
+
+     - parameter keyPaths: Only properties contained in the key paths array will trigger
+                           a change. See `observe(keyPaths:on:_:)`.
+     - parameter buffering: How changes which have not been consumed yet are buffered.
+     - returns: An asynchronous sequence of the changes to the object.
+     */
+    public func changes(keyPaths: [String]? = nil,
+                        buffering: ChangeBuffering = .coalesced) -> RealmChangeStream<ObjectChange<Self>> {
+        let buffer = ChangeStreamBuffer<ObjectChange<Self>>(buffering, merge: merge, replace: { $0 })
+        let queue = DispatchQueue(label: "io.realm.changes")
+        buffer.token = observe(keyPaths: keyPaths, on: queue) { [weak buffer] (change: ObjectChange<Self>) in
+            switch change {
+            case .change(let object, let properties):
+                buffer?.push(.change(object.freeze(), properties))
+            case .deleted, .error:
+                buffer?.push(change, isFinal: true)
+            }
+        }
+        return RealmChangeStream(buffer)
+    }
+}
+
+#endif // swift(>=5.5)
@@ -152,16 +152,7 @@ extension Publisher {
     ///            which the upstream publisher publishes.
     public func freeze<T: RealmCollection>()
         -> Publishers.Map<Self, RealmCollectionChange<T>> where Output == RealmCollectionChange<T> {
-            return map {
-                switch $0 {
-                case .initial(let collection):
-                    return .initial(collection.freeze())
-                case .update(let collection, deletions: let deletions, insertions: let insertions, modifications: let modifications):
-                    return .update(collection.freeze(), deletions: deletions, insertions: insertions, modifications: modifications)
-                case .error(let error):
-                    return .error(error)
-                }
-            }
+            return map { $0.freeze() }
     }
 
     /// Freezes all Realm collection changesets from the upstream publisher.
@@ -189,16 +180,7 @@ extension Publisher {
     ///            which the upstream publisher publishes.
     public func freeze<T: RealmKeyedCollection>()
         -> Publishers.Map<Self, RealmMapChange<T>> where Output == RealmMapChange<T> {
-            return map {
-                switch $0 {
-                case .initial(let collection):
-                    return .initial(collection.freeze())
-                case .update(let collection, deletions: let deletions, insertions: let insertions, modifications: let modifications):
-                    return .update(collection.freeze(), deletions: deletions, insertions: insertions, modifications: modifications)
-                case .error(let error):
-                    return .error(error)
-                }
-            }
+            return map { $0.freeze() }
     }
 }
 
@@ -471,7 +453,8 @@ extension ObjectBase: RealmSubscribable {
     /// :nodoc:
     public func _observe<S>(_ keyPaths: [String]?, on queue: DispatchQueue?, _ subscriber: S) -> NotificationToken
         where S.Input: ObjectBase, S: Subscriber, S.Failure == Error {
-        return _observe(keyPaths: keyPaths, on: queue) { (change: ObjectChange<S.Input>) in
+        // The publisher only emits the object, so the changed values aren't needed
+        return _observe(keyPaths: keyPaths, on: queue, includeValues: false) { (change: ObjectChange<S.Input>) in
             switch change {
             case .change(let object, _):
                 _ = subscriber.receive(object)
@@ -484,7 +467,7 @@ extension ObjectBase: RealmSubscribable {
     }
     /// :nodoc:
     public func _observe<S>(_ keyPaths: [String]?, _ subscriber: S) -> NotificationToken where S: Subscriber, S.Failure == Never, S.Input == Void {
-        return _observe(keyPaths: keyPaths, { _ in _ = subscriber.receive()})
+        return _observe(keyPaths: keyPaths, includeValues: false, { _ in _ = subscriber.receive()})
     }
 }
 
@@ -606,6 +589,149 @@ extension RealmKeyedCollection {
     }
 }
 
+// MARK: Handover
+
+/// Managed objects are handed over by key with an `ObjectReference` rather than
+/// with a `ThreadSafeReference`, which avoids pinning the source version of the
+/// Realm for each value passing through the pipeline. Collections still require
+/// a `ThreadSafeReference`.
+private enum HandoverReference<Confined: ThreadConfined> {
+    case frozen(Confined)
+    case object(RLMObjectReference)
+    case threadSafeReference(ThreadSafeReference<Confined>)
+
+    init(to value: Confined) {
+        if value.isFrozen {
+            self = .frozen(value)
+        } else if let object = value as? ObjectBase {
+            self = .object(RLMObjectReference(object: object))
+        } else {
+            self = .threadSafeReference(ThreadSafeReference(to: value))
+        }
+    }
+
+    func resolve(in realm: Realm) -> Confined? {
+        switch self {
+        case .frozen(let value):
+            return value
+        case .object(let reference):
+            return realm.rlmRealm.__resolve(reference).map { $0 as! Confined }
+        case .threadSafeReference(let reference):
+            return realm.resolve(reference)
+        }
+    }
+}
+
+@available(OSX 10.15, watchOS 6.0, iOS 13.0, iOSApplicationExtension 13.0, OSXApplicationExtension 10.15, tvOS 13.0, *)
+extension RealmCollectionChange where CollectionType: RealmCollection {
+    fileprivate func freeze() -> RealmCollectionChange {
+        switch self {
+        case .initial(let collection):
+            return .initial(collection.freeze())
+        case .update(let collection, deletions: let deletions, insertions: let insertions, modifications: let modifications):
+            return .update(collection.freeze(), deletions: deletions, insertions: insertions, modifications: modifications)
+        case .error(let error):
+            return .error(error)
+        }
+    }
+}
+
+@available(OSX 10.15, watchOS 6.0, iOS 13.0, iOSApplicationExtension 13.0, OSXApplicationExtension 10.15, tvOS 13.0, *)
+extension RealmMapChange {
+    fileprivate func freeze() -> RealmMapChange {
+        switch self {
+        case .initial(let collection):
+            return .initial(collection.freeze())
+        case .update(let collection, deletions: let deletions, insertions: let insertions, modifications: let modifications):
+            return .update(collection.freeze(), deletions: deletions, insertions: insertions, modifications: modifications)
+        case .error(let error):
+            return .error(error)
+        }
+    }
+}
+
+/// Forwards to the wrapped subscriber, freezing each value as it's received.
+/// Used by publishers which freeze inside the change notification.
+@available(OSX 10.15, watchOS 6.0, iOS 13.0, iOSApplicationExtension 13.0, OSXApplicationExtension 10.15, tvOS 13.0, *)
+private struct FreezingSubscriber<Wrapped: Subscriber>: Subscriber where Wrapped.Input: ThreadConfined {
+    typealias Input = Wrapped.Input
+    typealias Failure = Wrapped.Failure
+
+    private let wrapped: Wrapped
+    init(_ wrapped: Wrapped) {
+        self.wrapped = wrapped
+    }
+
+    var combineIdentifier: CombineIdentifier {
+        wrapped.combineIdentifier
+    }
+
+    func receive(subscription: Subscription) {
+        wrapped.receive(subscription: subscription)
+    }
+
+    func receive(_ input: Input) -> Subscribers.Demand {
+        wrapped.receive(input.freeze())
+    }
+
+    func receive(completion: Subscribers.Completion<Failure>) {
+        wrapped.receive(completion: completion)
+    }
+}
+
+/// Coalesces the values handed over to a scheduler by a single subscription.
+/// If a new value arrives before the scheduler has delivered the previous one,
+/// the previous one is discarded without being resolved, so a publisher which
+/// emits faster than its subscriber can keep up only resolves the latest value.
+/// The Realm opened on a dispatch queue scheduler is kept for the lifetime of
+/// the subscription rather than looked up for each value.
+private final class HandoverCoalescer<Confined: ThreadConfined> {
+    private let lock = NSLock()
+    private var pending: HandoverReference<Confined>?
+    private let config: RLMRealmConfiguration
+    private var realm: Realm?
+
+    init(_ config: RLMRealmConfiguration) {
+        self.config = config
+    }
+
+    /// Stores the value as the next one to deliver, returning `true` if no
+    /// delivery was already scheduled for a previous value.
+    func push(_ value: Confined) -> Bool {
+        let reference = HandoverReference(to: value)
+        lock.lock()
+        defer { lock.unlock() }
+        let needsDelivery = pending == nil
+        pending = reference
+        return needsDelivery
+    }
+
+    /// Resolves the latest pushed value. Must be called on the scheduler.
+    func pop<S: Scheduler>(on scheduler: S) -> Confined? {
+        lock.lock()
+        let reference = pending
+        pending = nil
+        lock.unlock()
+        guard let reference = reference, let realm = realm(for: scheduler) else {
+            return nil
+        }
+        return reference.resolve(in: realm)
+    }
+
+    private func realm<S: Scheduler>(for scheduler: S) -> Realm? {
+        if let realm = realm {
+            return realm
+        }
+        // Other schedulers may run each action on a different thread, so only
+        // a queue-confined Realm can be reused
+        guard let queue = scheduler as? DispatchQueue else {
+            return try? Realm(RLMRealm(configuration: config, queue: nil))
+        }
+        realm = try? Realm(RLMRealm(configuration: config, queue: queue))
+        return realm
+    }
+}
+
 // MARK: Subscriptions
 
 /// A subscription which wraps a Realm notification.
@@ -689,13 +815,29 @@ public enum RealmPublishers {
         private let configuration: Realm.Configuration
         private let callbackQueue: DispatchQueue
         private let onProgressNotificationCallback: ((SyncSession.Progress) -> Void)?
+        private let priority: Int
 
         internal init(configuration: Realm.Configuration,
                       callbackQueue: DispatchQueue = .main,
-                      onProgressNotificationCallback: ((SyncSession.Progress) -> Void)? = nil) {
+                      onProgressNotificationCallback: ((SyncSession.Progress) -> Void)? = nil,
+                      priority: Int = 0) {
             self.configuration = configuration
             self.callbackQueue = callbackQueue
             self.onProgressNotificationCallback = onProgressNotificationCallback
+            self.priority = priority
+        }
+
+        /// Sets the priority of the async open relative to other async opens.
+        ///
+        /// See `Realm.AsyncOpenTask.priority` for details.
+        ///
+        /// - Parameter priority: The priority of the async open task.
+        /// - Returns: A publisher that emits an asynchronously opened Realm.
+        public func priority(_ priority: Int) -> Self {
+            Self(configuration: configuration,
+                 callbackQueue: callbackQueue,
+                 onProgressNotificationCallback: onProgressNotificationCallback,
+                 priority: priority)
         }
 
         /// Triggers an event when there is a notification on the async open progress.
@@ -707,19 +849,22 @@ public enum RealmPublishers {
         public func onProgressNotification(_ onProgressNotificationCallback: @escaping ((SyncSession.Progress) -> Void)) -> Self {
             Self(configuration: configuration,
                  callbackQueue: callbackQueue,
-                 onProgressNotificationCallback: onProgressNotificationCallback)
+                 onProgressNotificationCallback: onProgressNotificationCallback,
+                 priority: priority)
         }
 
         /// :nodoc:
         public func receive<S>(subscriber: S) where S: Subscriber, S.Failure == Failure, Output == S.Input {
-            subscriber.receive(subscription: AsyncOpenSubscription(task: Realm.AsyncOpenTask(rlmTask: RLMRealm.asyncOpen(with: configuration.rlmConfiguration, callbackQueue: callbackQueue, callback: { rlmRealm, error in
+            let task = Realm.AsyncOpenTask(rlmTask: RLMRealm.asyncOpen(with: configuration.rlmConfiguration, callbackQueue: callbackQueue, callback: { rlmRealm, error in
                 if let realm = rlmRealm.flatMap(Realm.init) {
                     _ = subscriber.receive(realm)
                     subscriber.receive(completion: .finished)
                 } else {
                     subscriber.receive(completion: .failure(error ?? Realm.Error.callFailed))
                 }
-            })), callbackQueue: callbackQueue, onProgressNotificationCallback: onProgressNotificationCallback))
+            }))
+            task.priority = priority
+            subscriber.receive(subscription: AsyncOpenSubscription(task: task, callbackQueue: callbackQueue, onProgressNotificationCallback: onProgressNotificationCallback))
         }
 
         /// Specifies the scheduler on which to perform the async open task.
@@ -733,7 +878,8 @@ public enum RealmPublishers {
 
             return Self(configuration: configuration,
                         callbackQueue: queue,
-                        onProgressNotificationCallback: onProgressNotificationCallback)
+                        onProgressNotificationCallback: onProgressNotificationCallback,
+                        priority: priority)
         }
     }
 
@@ -885,11 +1031,13 @@ public enum RealmPublishers {
         private let subscribable: Subscribable
         private let keyPaths: [String]?
         private let queue: DispatchQueue?
-        internal init(_ subscribable: Subscribable, keyPaths: [String]? = nil, queue: DispatchQueue? = nil) {
+        private let frozen: Bool
+        internal init(_ subscribable: Subscribable, keyPaths: [String]? = nil, queue: DispatchQueue? = nil, frozen: Bool = false) {
             precondition(subscribable.realm != nil, "Only managed objects can be published")
             self.subscribable = subscribable
             self.keyPaths = keyPaths
             self.queue = queue
+            self.frozen = frozen
         }
 
         /// Captures the `NotificationToken` produced by observing a Realm Collection.
@@ -908,7 +1056,24 @@ public enum RealmPublishers {
 
         /// :nodoc:
         public func receive<S>(subscriber: S) where S: Subscriber, S.Failure == Failure, Output == S.Input {
-            subscriber.receive(subscription: ObservationSubscription(token: self.subscribable._observe(keyPaths, on: queue, subscriber)))
+            let token = frozen
+                ? self.subscribable._observe(keyPaths, on: queue, FreezingSubscriber(subscriber))
+                : self.subscribable._observe(keyPaths, on: queue, subscriber)
+            subscriber.receive(subscription: ObservationSubscription(token: token))
+        }
+
+        /// Freezes each value emitted by this publisher.
+        ///
+        /// This has the same effect as the generic `freeze()` operator, but
+        /// the value is frozen inside the change notification which produces
+        /// it rather than by a downstream operator. Frozen values are then
+        /// passed to `receive(on:)` directly rather than through a
+        /// `ThreadSafeReference`.
+        ///
+        /// - returns: A publisher that publishes frozen copies of the values
+        ///            which this publisher publishes.
+        public func freeze() -> Value<Subscribable> {
+            return Value(subscribable, keyPaths: keyPaths, queue: queue, frozen: true)
         }
 
         /// Specifies the scheduler on which to perform subscribe, cancel, and request operations.
@@ -926,7 +1091,7 @@ public enum RealmPublishers {
             guard let queue = scheduler as? DispatchQueue else {
                 fatalError("Cannot subscribe on scheduler \(scheduler): only serial dispatch queues are currently implemented.")
             }
-            return Value(subscribable, keyPaths: keyPaths, queue: queue)
+            return Value(subscribable, keyPaths: keyPaths, queue: queue, frozen: frozen)
         }
 
         /// Specifies the scheduler on which to perform downstream operations.
@@ -938,7 +1103,8 @@ public enum RealmPublishers {
         /// collection is then converted to a `ThreadSafeReference` and
         /// delivered to the target scheduler with no integration into the
         /// autorefresh cycle, meaning it may arrive some time after the
-        /// refresh occurs.
+        /// refresh occurs. If a new collection is emitted before the previous
+        /// one has been delivered, only the newest one is delivered.
         ///
         /// When in doubt, you probably want `subscribe(on:)`.
         ///
@@ -1010,7 +1176,8 @@ public enum RealmPublishers {
         /// collection is then converted to a `ThreadSafeReference` and
         /// delivered to the target scheduler with no integration into the
         /// autorefresh cycle, meaning it may arrive some time after the
-        /// refresh occurs.
+        /// refresh occurs. If a new value is emitted before the previous one
+        /// has been delivered, only the newest one is delivered.
         ///
         /// When in doubt, you probably want `subscribe(on:)`.
         ///
@@ -1022,6 +1189,10 @@ public enum RealmPublishers {
     }
 
     /// A helper publisher used to support `receive(on:)` on Realm publishers.
+    ///
+    /// Values which arrive while an earlier one is still waiting to be
+    /// delivered on the scheduler replace it, so that only the latest value is
+    /// resolved when the subscriber falls behind.
     @frozen public struct Handover<Upstream: Publisher, S: Scheduler>: Publisher where Upstream.Output: ThreadConfined {
         /// :nodoc:
         public typealias Failure = Upstream.Failure
@@ -1041,11 +1212,12 @@ public enum RealmPublishers {
         /// :nodoc:
         public func receive<Sub>(subscriber: Sub) where Sub: Subscriber, Sub.Failure == Failure, Output == Sub.Input {
             let scheduler = self.scheduler
-            let config = self.config
+            let coalescer = HandoverCoalescer<Output>(self.config)
             self.upstream
-                .map { ThreadSafeReference(to: $0) }
+                .filter { coalescer.push($0) }
+                .map { _ in () }
                 .receive(on: scheduler)
-                .compactMap { realm(config, scheduler)?.resolve($0) }
+                .compactMap { _ in coalescer.pop(on: scheduler) }
                 .receive(subscriber: subscriber)
         }
     }
@@ -1101,7 +1273,7 @@ public enum RealmPublishers {
 
         private enum Handover {
             case object(_ object: Output)
-            case tsr(_ tsr: ThreadSafeReference<Output>, config: RLMRealmConfiguration)
+            case reference(_ reference: HandoverReference<Output>, config: RLMRealmConfiguration)
         }
 
         /// :nodoc:
@@ -1110,15 +1282,15 @@ public enum RealmPublishers {
             self.upstream
                 .map { (obj: Output) -> Handover in
                     guard let realm = obj.realm, !realm.isFrozen else { return .object(obj) }
-                    return .tsr(ThreadSafeReference(to: obj), config: realm.rlmRealm.configuration)
+                    return .reference(HandoverReference(to: obj), config: realm.rlmRealm.configuration)
             }
             .receive(on: scheduler)
             .compactMap { (handover: Handover) -> Output? in
                 switch handover {
                 case .object(let obj):
                     return obj
-                case .tsr(let tsr, let config):
-                    return realm(config, scheduler)?.resolve(tsr)
+                case .reference(let reference, let config):
+                    return realm(config, scheduler).flatMap { reference.resolve(in: $0) }
                 }
             }
             .receive(subscriber: subscriber)
@@ -1419,11 +1591,13 @@ public enum RealmPublishers {
         private let collection: Collection
         private let keyPaths: [String]?
         private let queue: DispatchQueue?
-        internal init(_ collection: Collection, keyPaths: [String]? = nil, queue: DispatchQueue? = nil) {
+        private let frozen: Bool
+        internal init(_ collection: Collection, keyPaths: [String]? = nil, queue: DispatchQueue? = nil, frozen: Bool = false) {
             precondition(collection.realm != nil, "Only managed collections can be published")
             self.collection = collection
             self.keyPaths = keyPaths
             self.queue = queue
+            self.frozen = frozen
         }
 
         /// Captures the `NotificationToken` produced by observing a Realm Collection.
@@ -1442,12 +1616,27 @@ public enum RealmPublishers {
 
         /// :nodoc:
         public func receive<S>(subscriber: S) where S: Subscriber, S.Failure == Never, Output == S.Input {
+            let frozen = self.frozen
             let token = self.collection.observe(keyPaths: self.keyPaths, on: self.queue) { change in
-                _ = subscriber.receive(change)
+                _ = subscriber.receive(frozen ? change.freeze() : change)
             }
             subscriber.receive(subscription: ObservationSubscription(token: token))
         }
 
+        /// Freezes all Realm collection changesets emitted by this publisher.
+        ///
+        /// This has the same effect as the generic `freeze()` operator, but
+        /// the collection is frozen inside the change notification which
+        /// produces the changeset rather than by a downstream operator.
+        /// Frozen changesets are then passed to `receive(on:)` directly rather
+        /// than through a `ThreadSafeReference`.
+        ///
+        /// - returns: A publisher that publishes frozen copies of the
+        ///            changesets which this publisher publishes.
+        public func freeze() -> CollectionChangeset<Collection> {
+            return CollectionChangeset(collection, keyPaths: keyPaths, queue: queue, frozen: true)
+        }
+
         /// Specifies the scheduler on which to perform subscribe, cancel, and request operations.
         ///
         /// For Realm Publishers, this determines which queue the underlying
@@ -1463,7 +1652,7 @@ public enum RealmPublishers {
             guard let queue = scheduler as? DispatchQueue else {
                 fatalError("Cannot subscribe on scheduler \(scheduler): only serial dispatch queues are currently implemented.")
             }
-            return CollectionChangeset(collection, keyPaths: self.keyPaths, queue: queue)
+            return CollectionChangeset(collection, keyPaths: self.keyPaths, queue: queue, frozen: frozen)
         }
 
         /// Specifies the scheduler on which to perform downstream operations.
@@ -1502,11 +1691,13 @@ public enum RealmPublishers {
         private let collection: Collection
         private let keyPaths: [String]?
         private let queue: DispatchQueue?
-        internal init(_ collection: Collection, keyPaths: [String]? = nil, queue: DispatchQueue? = nil) {
+        private let frozen: Bool
+        internal init(_ collection: Collection, keyPaths: [String]? = nil, queue: DispatchQueue? = nil, frozen: Bool = false) {
             precondition(collection.realm != nil, "Only managed collections can be published")
             self.collection = collection
             self.keyPaths = keyPaths
             self.queue = queue
+            self.frozen = frozen
         }
 
         /// Captures the `NotificationToken` produced by observing a Realm Collection.
@@ -1525,12 +1716,27 @@ public enum RealmPublishers {
 
         /// :nodoc:
         public func receive<S>(subscriber: S) where S: Subscriber, S.Failure == Never, Output == S.Input {
+            let frozen = self.frozen
             let token = self.collection.observe(keyPaths: self.keyPaths, on: self.queue) { change in
-                _ = subscriber.receive(change)
+                _ = subscriber.receive(frozen ? change.freeze() : change)
             }
             subscriber.receive(subscription: ObservationSubscription(token: token))
         }
 
+        /// Freezes all Realm collection changesets emitted by this publisher.
+        ///
+        /// This has the same effect as the generic `freeze()` operator, but
+        /// the collection is frozen inside the change notification which
+        /// produces the changeset rather than by a downstream operator.
+        /// Frozen changesets are then passed to `receive(on:)` directly rather
+        /// than through a `ThreadSafeReference`.
+        ///
+        /// - returns: A publisher that publishes frozen copies of the
+        ///            changesets which this publisher publishes.
+        public func freeze() -> MapChangeset<Collection> {
+            return MapChangeset(collection, keyPaths: keyPaths, queue: queue, frozen: true)
+        }
+
         /// Specifies the scheduler on which to perform subscribe, cancel, and request operations.
         ///
         /// For Realm Publishers, this determines which queue the underlying
@@ -1546,7 +1752,7 @@ public enum RealmPublishers {
             guard let queue = scheduler as? DispatchQueue else {
                 fatalError("Cannot subscribe on scheduler \(scheduler): only serial dispatch queues are currently implemented.")
             }
-            return MapChangeset(collection, keyPaths: self.keyPaths, queue: queue)
+            return MapChangeset(collection, keyPaths: self.keyPaths, queue: queue, frozen: frozen)
         }
 
         /// Specifies the scheduler on which to perform downstream operations.
@@ -196,12 +196,18 @@ extension Double: _OptionalPersistable, _BuiltInPersistable, _DefaultConstructib
 extension String: _OptionalPersistable, _BuiltInPersistable, _DefaultConstructible, _PrimaryKey, _Indexable {
     @inlinable
     public static func _rlmGetProperty(_ obj: ObjectBase, _ key: PropertyKey) -> String {
-        return RLMGetSwiftPropertyString(obj, key)!
+        return _rlmGetPropertyOptional(obj, key)!
     }
 
     @inlinable
     public static func _rlmGetPropertyOptional(_ obj: ObjectBase, _ key: PropertyKey) -> String? {
-        return RLMGetSwiftPropertyString(obj, key)
+        // Decode the UTF-8 stored in the file directly rather than bridging
+        // from an intermediate NSString
+        var length = 0
+        guard let bytes = RLMGetSwiftPropertyStringUTF8(obj, key, &length) else {
+            return nil
+        }
+        return String(decoding: UnsafeRawBufferPointer(start: bytes, count: length), as: UTF8.self)
     }
 
     @inlinable
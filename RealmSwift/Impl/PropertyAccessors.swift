@@ -203,6 +203,11 @@ internal class PersistedPropertyAccessor<T: _Persistable>: RLMManagedPropertyAcc
         bound(property, parent).pointee.initialize(parent, key: PropertyKey(property.index))
     }
 
+    // Values which aren't cached are read from the object's current row
+    @objc override class func initializationDependsOnRow() -> Bool {
+        return T._rlmRequiresCaching
+    }
+
     @objc override class func observe(_ property: RLMProperty, on parent: RLMObjectBase) {
         bound(property, parent).pointee.observe(parent, property: property)
     }
@@ -285,9 +285,7 @@ public final class List<Element: RealmCollectionValue>: RLMSwiftCollectionBase {
      - warning: This method may only be called during a write transaction.
     */
     public func append<S: Sequence>(objectsIn objects: S) where S.Iterator.Element == Element {
-        for obj in objects {
-            rlmArray.add(dynamicBridgeCast(fromSwift: obj) as AnyObject)
-        }
+        rlmArray.addObjects(objects.map { dynamicBridgeCast(fromSwift: $0) as AnyObject } as NSArray)
     }
 
     /**
@@ -375,6 +373,24 @@ public final class List<Element: RealmCollectionValue>: RLMSwiftCollectionBase {
         rlmArray.exchangeObject(at: UInt(index1), withObjectAt: UInt(index2))
     }
 
+    /**
+     Reorders the objects in the list so that the object which was at index
+     `permutation[i]` is at index `i`.
+
+     This has the same result as a series of `move(from:to:)` calls, but is
+     performed as a single change to the list.
+
+     - warning: This method may only be called during a write transaction.
+
+     - warning: This method will throw an exception if `permutation` does not
+                contain each index of the list exactly once.
+
+     - parameter permutation: The indexes of the objects in their new order.
+     */
+    public func applyPermutation(_ permutation: [Int]) {
+        rlmArray.applyPermutation(permutation.map { NSNumber(value: $0) })
+    }
+
     // MARK: Notifications
 
     /**
@@ -702,6 +718,35 @@ public final class List<Element: RealmCollectionValue>: RLMSwiftCollectionBase {
         return rlmArray.addNotificationBlock(wrapObserveBlock(block), keyPaths: keyPaths.map(_name(for:)), queue: queue)
     }
 
+    /**
+     Registers a block to be called each time the list changes, delivering changes no
+     more often than once per `minimumInterval`.
+
+     This behaves like `observe(keyPaths:on:_:)`, except that changes which occur less than
+     `minimumInterval` seconds after the previous call to the block are merged together and
+     delivered as a single `.update` once the interval has elapsed. The `.initial`
+     notification and errors are always delivered immediately.
+
+     If `queue` is `nil`, delayed notifications are delivered via the current thread's run loop.
+
+     - warning: This method cannot be called during a write transaction, or when the containing Realm is read-only.
+     - parameter keyPaths: Only properties contained in the key paths array will trigger
+                           the block when they are modified. If `nil`, notifications
+                           will be delivered for any property change on the object.
+     - parameter queue: The serial dispatch queue to receive notification on. If
+                        `nil`, notifications are delivered to the current thread.
+     - parameter minimumInterval: The minimum time in seconds between calls to the block.
+     - parameter block: The block to be called whenever a change occurs.
+     - returns: A token which must be held for as long as you want updates to be delivered.
+     */
+    public func observe(keyPaths: [String]? = nil,
+                        on queue: DispatchQueue? = nil,
+                        minimumInterval: TimeInterval,
+                        _ block: @escaping (RealmCollectionChange<List>) -> Void) -> NotificationToken {
+        return rlmArray.addNotificationBlock(wrapObserveBlock(block), keyPaths: keyPaths,
+                                              queue: queue, minimumInterval: minimumInterval)
+    }
+
     // MARK: Frozen Objects
 
     public var isFrozen: Bool {
@@ -774,6 +819,212 @@ extension List where Element: AddableType {
     }
 }
 
+extension List where Element == Int64 {
+    /**
+     Calls the given closure with a buffer containing a copy of the values in
+     the list. The values are copied directly from the Realm without being
+     bridged to Objective-C one at a time, which is much faster than iterating
+     over the list for large lists.
+
+     - parameter body: A closure which is passed the values in the list.
+     */
+    public func withContiguousValues<R>(_ body: (UnsafeBufferPointer<Int64>) throws -> R) rethrows -> R {
+        return try readInt64Values(rlmArray).withUnsafeBufferPointer(body)
+    }
+}
+
+extension List where Element == Int {
+    /**
+     Calls the given closure with a buffer containing a copy of the values in
+     the list. The values are copied directly from the Realm without being
+     bridged to Objective-C one at a time, which is much faster than iterating
+     over the list for large lists.
+
+     - parameter body: A closure which is passed the values in the list.
+     */
+    public func withContiguousValues<R>(_ body: (UnsafeBufferPointer<Int>) throws -> R) rethrows -> R {
+        let values = readInt64Values(rlmArray)
+        if MemoryLayout<Int>.size != MemoryLayout<Int64>.size {
+            return try values.map { Int($0) }.withUnsafeBufferPointer(body)
+        }
+        return try values.withUnsafeBufferPointer { buffer in
+            guard let base = buffer.baseAddress else {
+                return try body(UnsafeBufferPointer(start: nil, count: 0))
+            }
+            return try base.withMemoryRebound(to: Int.self, capacity: buffer.count) {
+                try body(UnsafeBufferPointer(start: $0, count: buffer.count))
+            }
+        }
+    }
+}
+
+extension List where Element == Int8 {
+    /**
+     Calls the given closure with a buffer containing a copy of the values in
+     the list. The values are copied directly from the Realm without being
+     bridged to Objective-C one at a time, which is much faster than iterating
+     over the list for large lists.
+
+     - parameter body: A closure which is passed the values in the list.
+     */
+    public func withContiguousValues<R>(_ body: (UnsafeBufferPointer<Int8>) throws -> R) rethrows -> R {
+        return try readIntegerValues(rlmArray).withUnsafeBufferPointer(body)
+    }
+}
+
+extension List where Element == Int16 {
+    /**
+     Calls the given closure with a buffer containing a copy of the values in
+     the list. The values are copied directly from the Realm without being
+     bridged to Objective-C one at a time, which is much faster than iterating
+     over the list for large lists.
+
+     - parameter body: A closure which is passed the values in the list.
+     */
+    public func withContiguousValues<R>(_ body: (UnsafeBufferPointer<Int16>) throws -> R) rethrows -> R {
+        return try readIntegerValues(rlmArray).withUnsafeBufferPointer(body)
+    }
+}
+
+extension List where Element == Int32 {
+    /**
+     Calls the given closure with a buffer containing a copy of the values in
+     the list. The values are copied directly from the Realm without being
+     bridged to Objective-C one at a time, which is much faster than iterating
+     over the list for large lists.
+
+     - parameter body: A closure which is passed the values in the list.
+     */
+    public func withContiguousValues<R>(_ body: (UnsafeBufferPointer<Int32>) throws -> R) rethrows -> R {
+        return try readIntegerValues(rlmArray).withUnsafeBufferPointer(body)
+    }
+}
+
+extension List where Element == Double {
+    /**
+     Calls the given closure with a buffer containing a copy of the values in
+     the list. The values are copied directly from the Realm without being
+     bridged to Objective-C one at a time, which is much faster than iterating
+     over the list for large lists.
+
+     - parameter body: A closure which is passed the values in the list.
+     */
+    public func withContiguousValues<R>(_ body: (UnsafeBufferPointer<Double>) throws -> R) rethrows -> R {
+        let count = Int(rlmArray.count)
+        let values = [Double](unsafeUninitializedCapacity: count) { buffer, initializedCount in
+            if let base = buffer.baseAddress {
+                rlmArray.getDoubleValues(base, range: NSRange(location: 0, length: count))
+            }
+            initializedCount = count
+        }
+        return try values.withUnsafeBufferPointer(body)
+    }
+}
+
+extension List where Element == Date {
+    /**
+     Returns the values in the list as the number of seconds since 1970. The
+     values are read directly from the Realm without creating a `Date` for each
+     value, which is much faster than iterating over the list for large lists.
+     */
+    public func timeIntervalsSince1970() -> [TimeInterval] {
+        let count = Int(rlmArray.count)
+        let nanoseconds = [Int64](unsafeUninitializedCapacity: count) { buffer, initializedCount in
+            if let base = buffer.baseAddress {
+                rlmArray.getTimestampValues(base, range: NSRange(location: 0, length: count))
+            }
+            initializedCount = count
+        }
+        return nanoseconds.map { TimeInterval($0) / 1_000_000_000 }
+    }
+}
+
+extension List where Element == AnyRealmValue {
+    /**
+     Returns the values in the list as an array. Strings, data, dates and
+     numeric values are read directly from the Realm without creating an
+     Objective-C object for each value, which is much faster than iterating
+     over the list for large lists.
+     */
+    public func allValues() -> [AnyRealmValue] {
+        let count = Int(rlmArray.count)
+        let values = [RLMMixedValue](unsafeUninitializedCapacity: count) { buffer, initializedCount in
+            if let base = buffer.baseAddress {
+                rlmArray.getMixedValues(base, range: NSRange(location: 0, length: count))
+            }
+            initializedCount = count
+        }
+        return values.enumerated().map { (index, value) -> AnyRealmValue in
+            if value.boxed {
+                return dynamicBridgeCast(fromObjectiveC: rlmArray.object(at: UInt(index)))
+            }
+            return AnyRealmValue(unboxed: value)
+        }
+    }
+}
+
+extension AnyRealmValue {
+    /// Converts a value read by the bulk mixed value readers. The strings and
+    /// data in `value` point into the Realm file, so they're copied here.
+    internal init(unboxed value: RLMMixedValue) {
+        if value.isNull {
+            self = .none
+            return
+        }
+        switch value.type {
+        case .int:
+            self = .int(Int(value.intValue))
+        case .bool:
+            self = .bool(value.intValue != 0)
+        case .float:
+            self = .float(Float(value.doubleValue))
+        case .double:
+            self = .double(value.doubleValue)
+        case .date:
+            self = .date(Date(timeIntervalSinceReferenceDate: value.doubleValue))
+        case .string:
+            self = .string(String(unboxed: value))
+        case .data:
+            guard let bytes = value.bytes else {
+                self = .data(Data())
+                return
+            }
+            self = .data(Data(bytes: bytes, count: value.size))
+        default:
+            throwRealmException("Mixed value of type \(value.type) must be read as an object")
+        }
+    }
+}
+
+extension String {
+    /// Copies a string read by the bulk mixed value readers.
+    internal init(unboxed value: RLMMixedValue) {
+        guard let bytes = value.bytes else {
+            self = ""
+            return
+        }
+        self = bytes.withMemoryRebound(to: UInt8.self, capacity: value.size) {
+            String(decoding: UnsafeBufferPointer(start: $0, count: value.size), as: UTF8.self)
+        }
+    }
+}
+
+private func readInt64Values(_ array: RLMArray<AnyObject>) -> [Int64] {
+    let count = Int(array.count)
+    return [Int64](unsafeUninitializedCapacity: count) { buffer, initializedCount in
+        if let base = buffer.baseAddress {
+            array.getInt64Values(base, range: NSRange(location: 0, length: count))
+        }
+        initializedCount = count
+    }
+}
+
+// Core stores every integer width as an int64, so narrower lists are read as
+// int64 and then narrowed
+private func readIntegerValues<T: FixedWidthInteger>(_ array: RLMArray<AnyObject>) -> [T] {
+    return readInt64Values(array).map { T(truncatingIfNeeded: $0) }
+}
+
 extension List: RealmCollection {
     /// The type of the objects stored within the list.
     public typealias ElementType = Element
@@ -732,6 +732,37 @@ extension Map: AssistedObjectiveCBridgeable {
     }
 }
 
+extension Map where Key == String, Value == AnyRealmValue {
+    /**
+     Returns the entries in the map as a dictionary. Strings, data, dates and
+     numeric values are read directly from the Realm without creating an
+     Objective-C object for each value, which is much faster than iterating
+     over the map for large maps.
+     */
+    public func allEntries() -> [String: AnyRealmValue] {
+        let count = Int(rlmDictionary.count)
+        var keys = [RLMMixedValue](repeating: RLMMixedValue(), count: count)
+        var values = [RLMMixedValue](repeating: RLMMixedValue(), count: count)
+        keys.withUnsafeMutableBufferPointer { keys in
+            values.withUnsafeMutableBufferPointer { values in
+                if let keys = keys.baseAddress, let values = values.baseAddress {
+                    rlmDictionary.getMixedKeys(keys, values: values, count: UInt(count))
+                }
+            }
+        }
+        var entries = [String: AnyRealmValue](minimumCapacity: count)
+        for (key, value) in zip(keys, values) {
+            let key = String(unboxed: key)
+            if value.boxed {
+                entries[key] = rlmDictionary[key as NSString].map(dynamicBridgeCast) ?? AnyRealmValue.none
+            } else {
+                entries[key] = AnyRealmValue(unboxed: value)
+            }
+        }
+        return entries
+    }
+}
+
 // MARK: Sequence Support
 
 extension Map: Sequence {
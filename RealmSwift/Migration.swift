@@ -59,6 +59,22 @@ public func schemaVersionAtURL(_ fileURL: URL, encryptionKey: Data? = nil) throw
     return version
 }
 
+/**
+ Reads the schema version and other metadata of a Realm file without opening it.
+
+ This does not create the file's lock and notification files, and only reads the parts of the
+ file needed to find the schema version, which makes it suitable for checking several files on
+ launch to decide which ones need to be migrated.
+
+ - parameter fileURL:       Local URL to a Realm file.
+ - parameter encryptionKey: 64-byte key used to encrypt the file, or `nil` if it is unencrypted.
+
+ - throws: An `NSError` that describes the problem.
+ */
+public func realmFileInfo(at fileURL: URL, encryptionKey: Data? = nil) throws -> RealmFileInfo {
+    return try RLMRealm.fileInfo(at: fileURL, encryptionKey: encryptionKey)
+}
+
 extension Realm {
     /**
      Performs the given Realm configuration's migration block on a Realm at the given path.
@@ -71,6 +87,29 @@ extension Realm {
     public static func performMigration(for configuration: Realm.Configuration = Realm.Configuration.defaultConfiguration) throws {
         try RLMRealm.performMigration(for: configuration.rlmConfiguration)
     }
+
+    /**
+     Asynchronously performs the given Realm configuration's migration block on a background queue.
+
+     Progress is reported as the migration block enumerates objects with `Migration.enumerateObjects(ofType:_:)`,
+     once for roughly every percent of each type's objects. Opening the Realm while the migration is running blocks
+     until it has completed, so open it from the completion handler or with `Realm.asyncOpen()`.
+
+     - parameter configuration: The Realm configuration used to open and migrate the Realm.
+     - parameter callbackQueue: The dispatch queue on which the progress and completion handlers are invoked.
+     - parameter progress: A block which is called with the name of the type being enumerated, the number of
+                           objects enumerated so far, and the total number of objects of that type.
+     - parameter completion: A block which is called with the error which occurred during the migration, if any.
+     */
+    public static func migrateAsync(for configuration: Realm.Configuration = Realm.Configuration.defaultConfiguration,
+                                    callbackQueue: DispatchQueue = .main,
+                                    progress: ((_ typeName: String, _ enumerated: Int, _ total: Int) -> Void)? = nil,
+                                    completion: @escaping (Error?) -> Void) {
+        RLMRealm.migrateAsync(configuration: configuration.rlmConfiguration,
+                              callbackQueue: callbackQueue,
+                              progress: progress.map { progress in { progress($0, Int($1), Int($2)) } },
+                              completion: completion)
+    }
 }
 
 /**
@@ -169,6 +208,61 @@ extension Realm {
         rlmMigration.renameProperty(forClass: typeName, oldName: oldName, newName: newName)
     }
 
+    /**
+     Copies the value of a property for every object of the given type, optionally converting
+     each value with the given block.
+
+     This operates on the underlying columns directly rather than creating an object for each
+     row, and so is much faster than `enumerateObjects(ofType:_:)` for copying or converting the
+     values of a single property of a large number of objects. Link and collection properties
+     are not supported.
+
+     - parameter typeName: The name of the class whose property should be transformed. This class
+                           must be present in both the old and new Realm schemas.
+     - parameter oldName:  The name of the property in the old Realm schema to read values from.
+     - parameter newName:  The name of the property in the new Realm schema to write values to.
+     - parameter block:    A block which converts each old value to the new value. If `nil`, values
+                           are copied as-is, which requires both properties to be of the same type.
+     */
+    public func transformValues(ofType typeName: String, from oldName: String, to newName: String,
+                                _ block: ((Any?) -> Any?)? = nil) {
+        rlmMigration.transformValues(ofClass: typeName, fromProperty: oldName, toProperty: newName, block: block)
+    }
+
+    /**
+     Copies the value of a property for every object of the given type to another property of the same type.
+
+     - parameter oldName:  The name of the property in the old Realm schema to read values from.
+     - parameter newName:  The name of the property in the new Realm schema to write values to.
+     - parameter typeName: The name of the class whose property should be copied. This class must be
+                           present in both the old and new Realm schemas.
+     */
+    public func copyProperty(_ oldName: String, to newName: String, ofType typeName: String) {
+        rlmMigration.copyProperty(oldName, to: newName, ofClass: typeName)
+    }
+
+    /**
+     Converts the values of a property whose type has changed between the old and new Realm schemas.
+
+     If `block` is `nil`, lossless conversions between numeric types such as `Float` to `Double`
+     (but not `Int` to `Float` or `Double`, which can round values), conversions to and from strings
+     for numbers, `ObjectId`, `UUID` and `Decimal128`, and conversions to `AnyRealmValue` are performed
+     on the underlying columns without creating any objects. See
+     `-[RLMMigration convertProperty:ofClass:toType:using:]` for the full list. Other conversions
+     require a block.
+
+     - parameter propertyName: The name of the property to convert, which must be present in both
+                               the old and new Realm schemas.
+     - parameter typeName:     The name of the class whose property should be converted.
+     - parameter type:         The type of the property in the new Realm schema.
+     - parameter block:        A block which converts each old value to the new value, or `nil` to
+                               use the built-in conversion.
+     */
+    public func convertProperty(_ propertyName: String, ofType typeName: String, to type: PropertyType,
+                                using block: ((Any?) -> Any?)? = nil) {
+        rlmMigration.convertProperty(propertyName, ofClass: typeName, to: type, using: block)
+    }
+
     internal init(_ rlmMigration: RLMMigration) {
         self.rlmMigration = rlmMigration
     }
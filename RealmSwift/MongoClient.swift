@@ -198,6 +198,68 @@ public typealias MongoCollection = RLMMongoCollection
 /// Acts as a middleman and processes events with WatchStream
 public typealias ChangeStream = RLMChangeStream
 
+/// A cursor over the results of a find or aggregate operation on a
+/// `MongoCollection`, which fetches the results in batches.
+public typealias MongoCursor = RLMMongoCursor
+
+extension MongoCursor {
+    /// Fetches the next batch of documents.
+    ///
+    /// Only one batch may be requested at a time: calling this again before
+    /// `completion` has been called for the previous batch is an error.
+    /// - Parameter completion: The next batch of documents, or an error if one occurs.
+    ///                         The batch is empty once the cursor is exhausted.
+    public func nextBatch(_ completion: @escaping MongoFindBlock) {
+        self.__nextBatch { documents, error in
+            let bson: [Document]? = documents?.map { $0.mapValues { ObjectiveCSupport.convert(object: $0) } }
+            if let bson = bson {
+                completion(.success(bson))
+            } else {
+                completion(.failure(error ?? Realm.Error.callFailed))
+            }
+        }
+    }
+}
+
+/// A persistent queue of writes to MongoDB collections, which are saved locally
+/// and sent to the server in order, retrying while the server can't be reached.
+public typealias MongoWriteQueue = RLMMongoWriteQueue
+
+extension MongoWriteQueue {
+    /// Enqueues inserting a document into a collection.
+    /// - Parameters:
+    ///   - document: The document to insert. It is given a new `ObjectId` if it has no `_id`.
+    ///   - collection: The collection to insert the document into.
+    public func insertOne(_ document: Document, into collection: MongoCollection) {
+        let bson = ObjectiveCSupport.convert(object: .document(document))
+        self.__insertOneDocument(bson as! [String: RLMBSON], in: collection)
+    }
+
+    /// Enqueues updating the first document in a collection which matches a filter.
+    /// - Parameters:
+    ///   - filter: A `Document` as bson that should match the query.
+    ///   - update: A `Document` describing the update.
+    ///   - upsert: When true, creates a new document if no document matches the query.
+    ///   - collection: The collection to update.
+    public func updateOneDocument(filter: Document, update: Document, upsert: Bool = false,
+                                  in collection: MongoCollection) {
+        let filterBSON = ObjectiveCSupport.convert(object: .document(filter))
+        let updateBSON = ObjectiveCSupport.convert(object: .document(update))
+        self.__updateOneDocumentWhere(filterBSON as! [String: RLMBSON],
+                                      updateDocument: updateBSON as! [String: RLMBSON],
+                                      upsert: upsert, in: collection)
+    }
+
+    /// Enqueues deleting the first document in a collection which matches a filter.
+    /// - Parameters:
+    ///   - filter: A `Document` as bson that should match the query.
+    ///   - collection: The collection to delete from.
+    public func deleteOneDocument(filter: Document, in collection: MongoCollection) {
+        let filterBSON = ObjectiveCSupport.convert(object: .document(filter))
+        self.__deleteOneDocumentWhere(filterBSON as! [String: RLMBSON], in: collection)
+    }
+}
+
 /// Delegate which is used for subscribing to changes on a `MongoCollection.watch()` stream.
 public protocol ChangeEventDelegate: AnyObject {
     /// The stream was opened.
@@ -297,6 +359,31 @@ extension MongoCollection {
         }
     }
 
+    /// Encodes the provided values to BSON and inserts them in batches. If any values are
+    /// missing identifiers, they will be generated.
+    ///
+    /// Each batch holds as many documents as fit in `maximumBatchSize` bytes of encoded
+    /// request body, and up to `maximumConcurrentBatches` batches are sent at once. If a
+    /// batch fails, the completion is called with its error and no further batches are sent.
+    /// - Parameters:
+    ///   - documents: The `Document` values in a bson array to insert.
+    ///   - maximumBatchSize: The maximum size in bytes of the documents sent in each request.
+    ///   - maximumConcurrentBatches: The maximum number of requests in flight at once.
+    ///   - completion: The result of the insert, returns an array inserted document ids in order.
+    public func insertMany(_ documents: [Document], maximumBatchSize: Int,
+                           maximumConcurrentBatches: Int = 1,
+                           _ completion: @escaping MongoInsertManyBlock) {
+        let bson = ObjectiveCSupport.convert(object: .array(documents.map {.document($0)}))
+        self.__insertManyDocuments(bson as! [[String: RLMBSON]], maximumBatchSize: UInt(maximumBatchSize),
+                                   maximumConcurrentBatches: UInt(maximumConcurrentBatches)) { objectIds, error in
+            if let objectIds = objectIds?.compactMap(ObjectiveCSupport.convert) {
+                completion(.success(objectIds))
+            } else {
+                completion(.failure(error ?? Realm.Error.callFailed))
+            }
+        }
+    }
+
     /// Finds the documents in this collection which match the provided filter.
     /// - Parameters:
     ///   - filter: A `Document` as bson that should match the query.
@@ -333,6 +420,60 @@ extension MongoCollection {
         }
     }
 
+    /// Finds the documents in this collection which match the provided filter,
+    /// passing them to `body` one at a time rather than collecting them into an
+    /// array first.
+    /// - Parameters:
+    ///   - filter: A `Document` as bson that should match the query.
+    ///   - options: `FindOptions` to use when executing the command.
+    ///   - body: A closure called once for each matching document. Return `false` to skip the remaining documents.
+    ///   - completion: Called after the last document has been passed to `body`, or with an error if one occurs
+    public func find(filter: Document,
+                     options: FindOptions = FindOptions(),
+                     forEach body: @escaping (Document) -> Bool,
+                     _ completion: @escaping (Error?) -> Void) {
+        let bson = ObjectiveCSupport.convert(object: .document(filter))
+        self.__findWhere(bson as! [String: RLMBSON], options: options, documentHandler: { document, stop in
+            if !body(document.mapValues { ObjectiveCSupport.convert(object: $0) }) {
+                stop.pointee = true
+            }
+        }, completion: completion)
+    }
+
+    /// Finds the documents in this collection which match the provided filter
+    /// and decodes them as `T`.
+    ///
+    /// The documents are decoded directly from the server's response without
+    /// first being converted to `Document`s.
+    /// - Parameters:
+    ///   - filter: A `Document` as bson that should match the query.
+    ///   - options: `FindOptions` to use when executing the command.
+    ///   - type: The `Decodable` type to decode each document as.
+    ///   - completion: The decoded documents, or an error if the query or decoding any of the documents failed
+    public func find<T: Decodable>(filter: Document,
+                                   options: FindOptions = FindOptions(),
+                                   as type: T.Type,
+                                   _ completion: @escaping (Result<[T], Error>) -> Void) {
+        let bson = ObjectiveCSupport.convert(object: .document(filter))
+        let decoder = BSONDecoder()
+        var values = [T]()
+        var decodingError: Error?
+        self.__findWhere(bson as! [String: RLMBSON], options: options, documentHandler: { document, stop in
+            do {
+                values.append(try decoder.decode(type, from: document as NSDictionary))
+            } catch {
+                decodingError = error
+                stop.pointee = true
+            }
+        }, completion: { error in
+            if let error = error ?? decodingError {
+                completion(.failure(error))
+            } else {
+                completion(.success(values))
+            }
+        })
+    }
+
     /// Returns one document from a collection or view which matches the
     /// provided filter. If multiple documents satisfy the query, this method
     /// returns the first document according to the query's sort order or natural
@@ -392,6 +533,37 @@ extension MongoCollection {
         }
     }
 
+    /// Returns a cursor which fetches the documents in this collection which
+    /// match the provided filter in batches of at most `batchSize` documents.
+    ///
+    /// No documents are fetched until `MongoCursor.nextBatch(_:)` is called. If
+    /// `options` specifies a limit, it applies to the total number of documents
+    /// returned by the cursor across all batches.
+    /// - Parameters:
+    ///   - filter: A `Document` as bson that should match the query.
+    ///   - options: `FindOptions` to use when executing the command.
+    ///   - batchSize: The maximum number of documents to fetch in each batch.
+    public func findCursor(filter: Document,
+                           options: FindOptions = FindOptions(),
+                           batchSize: Int) -> MongoCursor {
+        let bson = ObjectiveCSupport.convert(object: .document(filter))
+        return self.__findCursorWhere(bson as! [String: RLMBSON], options: options, batchSize: UInt(batchSize))
+    }
+
+    /// Returns a cursor which runs an aggregation framework pipeline against
+    /// this collection and fetches the results in batches of at most
+    /// `batchSize` documents.
+    ///
+    /// The pipeline should produce its results in a stable order (e.g. by
+    /// ending with a `$sort` stage) for the batches to be consistent.
+    /// - Parameters:
+    ///   - pipeline: A bson array made up of `Documents` containing the pipeline of aggregation operations to perform.
+    ///   - batchSize: The maximum number of documents to fetch in each batch.
+    public func aggregateCursor(pipeline: [Document], batchSize: Int) -> MongoCursor {
+        let bson = ObjectiveCSupport.convert(object: .array(pipeline.map {.document($0)}))
+        return self.__aggregateCursor(withPipeline: bson as! [[String: RLMBSON]], batchSize: UInt(batchSize))
+    }
+
     /// Counts the number of documents in this collection matching the provided filter.
     /// - Parameters:
     ///   - filter: A `Document` as bson that should match the query.
@@ -728,6 +900,22 @@ extension MongoCollection {
         }
     }
 
+    /// Encodes the provided values to BSON and inserts them in batches. If any values are
+    /// missing identifiers, they will be generated.
+    /// - see: `insertMany(_:maximumBatchSize:maximumConcurrentBatches:_:)`
+    /// - Parameters:
+    ///   - documents: The `Document` values in a bson array to insert.
+    ///   - maximumBatchSize: The maximum size in bytes of the documents sent in each request.
+    ///   - maximumConcurrentBatches: The maximum number of requests in flight at once.
+    /// - Returns: The object ids of inserted documents, in order.
+    public func insertMany(_ documents: [Document], maximumBatchSize: Int,
+                           maximumConcurrentBatches: Int = 1) async throws -> [AnyBSON] {
+        return try await withCheckedThrowingContinuation { continuation in
+            insertMany(documents, maximumBatchSize: maximumBatchSize,
+                       maximumConcurrentBatches: maximumConcurrentBatches, continuation.resume)
+        }
+    }
+
     /// Finds the documents in this collection which match the provided filter.
     /// - Parameters:
     ///   - filter: A `Document` as bson that should match the query.
@@ -935,6 +1123,16 @@ extension MongoCollection {
         }
     }
 }
+@available(macOS 12.0, tvOS 15.0, iOS 15.0, watchOS 8.0, *)
+extension MongoCursor {
+    /// Fetches the next batch of documents.
+    /// - Returns: The next batch of documents, which is empty once the cursor is exhausted.
+    public func nextBatch() async throws -> [Document] {
+        return try await withCheckedThrowingContinuation { continuation in
+            nextBatch(continuation.resume)
+        }
+    }
+}
 #endif // swift(>=5.5)
 
 private class ChangeEventDelegateProxy: RLMChangeEventDelegate {
@@ -610,6 +610,35 @@ public final class MutableSet<Element: RealmCollectionValue>: RLMSwiftCollection
         return rlmSet.addNotificationBlock(wrapObserveBlock(block), keyPaths: keyPaths.map(_name(for:)), queue: queue)
     }
 
+    /**
+     Registers a block to be called each time the set changes, delivering changes no
+     more often than once per `minimumInterval`.
+
+     This behaves like `observe(keyPaths:on:_:)`, except that changes which occur less than
+     `minimumInterval` seconds after the previous call to the block are merged together and
+     delivered as a single `.update` once the interval has elapsed. The `.initial`
+     notification and errors are always delivered immediately.
+
+     If `queue` is `nil`, delayed notifications are delivered via the current thread's run loop.
+
+     - warning: This method cannot be called during a write transaction, or when the containing Realm is read-only.
+     - parameter keyPaths: Only properties contained in the key paths array will trigger
+                           the block when they are modified. If `nil`, notifications
+                           will be delivered for any property change on the object.
+     - parameter queue: The serial dispatch queue to receive notification on. If
+                        `nil`, notifications are delivered to the current thread.
+     - parameter minimumInterval: The minimum time in seconds between calls to the block.
+     - parameter block: The block to be called whenever a change occurs.
+     - returns: A token which must be held for as long as you want updates to be delivered.
+     */
+    public func observe(keyPaths: [String]? = nil,
+                        on queue: DispatchQueue? = nil,
+                        minimumInterval: TimeInterval,
+                        _ block: @escaping (RealmCollectionChange<MutableSet>) -> Void) -> NotificationToken {
+        return rlmSet.addNotificationBlock(wrapObserveBlock(block), keyPaths: keyPaths,
+                                              queue: queue, minimumInterval: minimumInterval)
+    }
+
     // MARK: Frozen Objects
 
     public var isFrozen: Bool {
@@ -156,6 +156,26 @@ extension Object: RealmCollectionValue {
      */
     @objc open class func primaryKey() -> String? { return nil }
 
+    /**
+     Override this method to specify the name of a `Date` property which records when each object was
+     created or last refreshed, for object types used as a cache which should expire.
+
+     Objects whose value for this property is more than `timeToLive()` seconds in the past are deleted by
+     `Realm.startExpiringObjects(configuration:interval:maximumWriteDuration:)`. The property should
+     normally be indexed.
+
+     - returns: The name of the property used for expiring objects.
+     */
+    @objc open class func timeToLiveProperty() -> String? { return nil }
+
+    /**
+     Override this method along with `timeToLiveProperty()` to specify how many seconds objects of this
+     type are kept before they expire.
+
+     - returns: The number of seconds after which objects expire, or 0 if they never do.
+     */
+    @objc open class func timeToLive() -> TimeInterval { return 0 }
+
     /**
      Override this method to specify the names of properties to ignore. These
      properties will not be managed by the Realm that manages the object.
@@ -179,6 +199,36 @@ extension Object: RealmCollectionValue {
      */
     @objc open class func indexedProperties() -> [String] { return [] }
 
+    /**
+     Returns an array of property names for `Data` properties whose values should be stored outside of the Realm file.
+
+     The values of these properties are stored in files in a directory next to the Realm file, named by a hash of
+     their contents, and the Realm file stores only a small reference to the file. Reading the property
+     memory-maps the file rather than copying its contents, and `inputStream(forProperty:)` reads it as a stream.
+     Call `Realm.removeUnreferencedExternalBlobs()` to remove the files of values which are no longer referenced.
+
+     External blob values are not encrypted, and queries on external blob properties compare the references rather
+     than the values, so only `nil` checks are meaningful.
+
+     - returns: An array of property names.
+     */
+    @objc open class func externalBlobProperties() -> [String] { return [] }
+
+    /**
+     Returns a dictionary mapping the names of `Data` properties whose values should be compressed in the Realm file to
+     the raw value of the `CompressionAlgorithm` to use, e.g. `["payload": CompressionAlgorithm.LZFSE.rawValue]`.
+     `String` properties cannot be compressed, as their values must be stored as valid UTF-8.
+
+     Values are compressed when they are set and decompressed when they are read, which trades CPU time for a smaller
+     file and less I/O. Values which are too small to benefit from compression are stored uncompressed.
+
+     Compressed properties cannot be indexed or be the primary key, and queries other than `nil` checks on them do
+     not match against the uncompressed values.
+
+     - returns: A dictionary mapping property names to compression algorithms.
+     */
+    @objc open class func compressedProperties() -> [String: Int] { return [:] }
+
     // MARK: Key-Value Coding & Subscripting
 
     /// Returns or sets the value of the property with the given name.
@@ -266,13 +316,18 @@ extension Object: RealmCollectionValue {
                            See description above for more detail on linked properties.
      - parameter queue: The serial dispatch queue to receive notification on. If
                         `nil`, notifications are delivered to the current thread.
+     - parameter includeValues: If `false`, the `oldValue` and `newValue` of each
+                                `PropertyChange` are `nil`, which avoids reading each changed
+                                property before and after every write. Pass `false` if only
+                                the names of the changed properties are needed.
      - parameter block: The block to call with information about changes to the object.
      - returns: A token which must be held for as long as you want updates to be delivered.
      */
     public func observe<T: RLMObjectBase>(keyPaths: [String]? = nil,
                                           on queue: DispatchQueue? = nil,
+                                          includeValues: Bool = true,
                                           _ block: @escaping (ObjectChange<T>) -> Void) -> NotificationToken {
-        return _observe(keyPaths: keyPaths, on: queue, block)
+        return _observe(keyPaths: keyPaths, on: queue, includeValues: includeValues, block)
     }
 
     /**
@@ -346,13 +401,18 @@ extension Object: RealmCollectionValue {
                            See description above for more detail on linked properties.
      - parameter queue: The serial dispatch queue to receive notification on. If
                         `nil`, notifications are delivered to the current thread.
+     - parameter includeValues: If `false`, the `oldValue` and `newValue` of each
+                                `PropertyChange` are `nil`, which avoids reading each changed
+                                property before and after every write. Pass `false` if only
+                                the names of the changed properties are needed.
      - parameter block: The block to call with information about changes to the object.
      - returns: A token which must be held for as long as you want updates to be delivered.
      */
     public func observe<T: ObjectBase>(keyPaths: [PartialKeyPath<T>],
                                        on queue: DispatchQueue? = nil,
+                                       includeValues: Bool = true,
                                        _ block: @escaping (ObjectChange<T>) -> Void) -> NotificationToken {
-        return _observe(keyPaths: keyPaths.map(_name(for:)), on: queue, block)
+        return _observe(keyPaths: keyPaths.map(_name(for:)), on: queue, includeValues: includeValues, block)
     }
 
     // MARK: Dynamic list
@@ -443,6 +503,93 @@ extension Object: RealmCollectionValue {
     public func isSameObject(as object: Object?) -> Bool {
         return RLMObjectBaseAreEqual(self, object)
     }
+
+    // MARK: Zero-copy Access
+
+    /**
+     Invokes the given closure with a buffer pointing at the contents of a `Data` or
+     `String` property, without copying them out of the Realm file.
+
+     String properties are exposed as their UTF-8 bytes. The buffer is only valid for
+     the duration of the closure, and is empty if the property is `nil`. The closure
+     must not write to or refresh the Realm. Unmanaged objects are given a copy of the
+     value.
+
+     - parameter propertyName: The name of a `Data` or `String` property.
+     - parameter body: A closure which receives the property's bytes.
+     - returns: The value returned by `body`.
+     */
+    public func withUnsafeBytes<Result>(forProperty propertyName: String,
+                                        _ body: (UnsafeRawBufferPointer) throws -> Result) rethrows -> Result {
+        var length: UInt = 0
+        var owner: NSData?
+        let bytes = RLMObjectBaseUnsafeBytesForProperty(self, propertyName, &length, &owner)
+        return try withExtendedLifetime(owner) {
+            try body(UnsafeRawBufferPointer(start: bytes, count: Int(length)))
+        }
+    }
+
+    /**
+     Invokes the given closure with a buffer pointing at the contents of a `Data` or
+     `String` property, without copying them out of the Realm file.
+
+     - see: `withUnsafeBytes(forProperty:_:)`
+
+     - parameter keyPath: The key path to a `Data` or `String` property.
+     - parameter body: A closure which receives the property's bytes.
+     - returns: The value returned by `body`.
+     */
+    public func withUnsafeBytes<T: ObjectBase, Result>(for keyPath: PartialKeyPath<T>,
+                                                       _ body: (UnsafeRawBufferPointer) throws -> Result) rethrows -> Result {
+        return try withUnsafeBytes(forProperty: _name(for: keyPath), body)
+    }
+
+    /**
+     Returns an input stream which reads the value of a `Data` or `String` property.
+
+     Properties listed in `externalBlobProperties()` are streamed directly from their
+     file in the blob store without being loaded into memory.
+
+     - parameter propertyName: The name of a `Data` or `String` property.
+     - returns: An unopened input stream, or `nil` if the property is `nil`.
+     */
+    public func inputStream(forProperty propertyName: String) -> InputStream? {
+        return RLMObjectBaseInputStreamForProperty(self, propertyName)
+    }
+
+    // MARK: Backlinks
+
+    /**
+     Returns the number of objects which link to this object through the given
+     `LinkingObjects` property.
+
+     This reads the number of links directly from the Realm rather than creating
+     the `LinkingObjects` collection, so it is much cheaper than reading `count`
+     on the property when only the count is needed. Unmanaged objects always
+     return 0.
+
+     To query on whether objects are linked to from any property, use
+     `@links.@count` in a predicate, e.g. `"@links.@count > 0"`.
+
+     - parameter propertyName: The name of a `LinkingObjects` property.
+     - returns: The number of objects linking to this object through the property.
+     */
+    public func backlinkCount(forProperty propertyName: String) -> Int {
+        return Int(RLMObjectBaseBacklinkCount(self, propertyName))
+    }
+
+    /**
+     Returns the number of objects which link to this object through the given
+     `LinkingObjects` property.
+
+     - see: `backlinkCount(forProperty:)`
+
+     - parameter keyPath: The key path to a `LinkingObjects` property.
+     - returns: The number of objects linking to this object through the property.
+     */
+    public func backlinkCount<T: ObjectBase, Origin: ObjectBase>(for keyPath: KeyPath<T, LinkingObjects<Origin>>) -> Int {
+        return backlinkCount(forProperty: _name(for: keyPath))
+    }
 }
 
 extension Object: ThreadConfined {
@@ -691,6 +838,26 @@ public func _name<T: ObjectBase>(for keyPath: PartialKeyPath<T>) -> String {
     if let name = keyPath._kvcKeyPathString {
         return name
     }
+    // Resolving a key path requires creating and tracing an object, and this
+    // is done each time a view using it is updated in SwiftUI, so cache the
+    // names. Key paths are Hashable and there is a small fixed set of them.
+    keyPathNameCacheLock.lock()
+    let cached = keyPathNameCache[keyPath]
+    keyPathNameCacheLock.unlock()
+    if let name = cached {
+        return name
+    }
+    let name = _traceName(for: keyPath)
+    keyPathNameCacheLock.lock()
+    keyPathNameCache[keyPath] = name
+    keyPathNameCacheLock.unlock()
+    return name
+}
+
+private var keyPathNameCache = [AnyKeyPath: String]()
+private let keyPathNameCacheLock = NSLock()
+
+private func _traceName<T: ObjectBase>(for keyPath: PartialKeyPath<T>) -> String {
     let traceObject = T()
     traceObject.lastAccessedNames = NSMutableArray()
     traceObject.prepareForRecording()
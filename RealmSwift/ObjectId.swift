@@ -44,6 +44,13 @@ public final class ObjectId: RLMObjectId, Decodable {
         return unsafeDowncast(super.generate(), to: ObjectId.self)
     }
 
+    /// Creates the given number of new ObjectIds.
+    ///
+    /// This is faster than calling `generate()` repeatedly when generating keys for a large number of objects at once.
+    public class func generate(count: Int) -> [ObjectId] {
+        return objectIds(count: UInt(count)).map { unsafeDowncast($0, to: ObjectId.self) }
+    }
+
     /// Creates a new ObjectId from the given 24-byte hexadecimal string.
     ///
     /// Throws if the string is not 24 characters or contains any characters other than 0-9a-fA-F.
@@ -135,3 +142,23 @@ extension ObjectId: Comparable {
         lhs.isGreaterThan(rhs)
     }
 }
+
+extension UUID {
+    /// Creates the given number of new random (version 4) UUIDs.
+    ///
+    /// This reads the random bytes for every UUID at once, which is faster than calling `UUID()` repeatedly when
+    /// generating primary keys for a large number of objects.
+    public static func generate(count: Int) -> [UUID] {
+        var bytes = [UInt8](repeating: 0, count: count * MemoryLayout<uuid_t>.size)
+        bytes.withUnsafeMutableBytes { arc4random_buf($0.baseAddress, $0.count) }
+        return bytes.withUnsafeMutableBytes { buffer in
+            (0..<count).map { i in
+                let offset = i * MemoryLayout<uuid_t>.size
+                // Set the version and variant bits of a random UUID
+                buffer[offset + 6] = (buffer[offset + 6] & 0x0F) | 0x40
+                buffer[offset + 8] = (buffer[offset + 8] & 0x3F) | 0x80
+                return UUID(uuid: buffer.load(fromByteOffset: offset, as: uuid_t.self))
+            }
+        }
+    }
+}
@@ -64,11 +64,19 @@ public extension ObjectiveCSupport {
         case .objectId(let val):
             return val as RLMObjectId
         case .document(let val):
-            return val.reduce(into: Dictionary<String, RLMBSON?>()) { (result: inout [String: RLMBSON?], kvp) in
-                result[kvp.key] = kvp.value.map(convertBson) ?? NSNull()
-            } as NSDictionary
+            // Build the Objective-C collections directly rather than bridging a
+            // Swift collection of optionals, which boxes every value
+            let dictionary = NSMutableDictionary(capacity: val.count)
+            for (key, value) in val {
+                dictionary[key] = value.map(convertBson) ?? NSNull()
+            }
+            return dictionary
         case .array(let val):
-            return val.map { $0.map(convertBson) } as NSArray
+            let array = NSMutableArray(capacity: val.count)
+            for value in val {
+                array.add(value.map(convertBson) ?? NSNull())
+            }
+            return array
         case .maxKey:
             return MaxKey()
         case .minKey:
@@ -130,16 +138,22 @@ public extension ObjectiveCSupport {
             }
             return .datetime(val as Date)
         case .objectId:
+            if let val = bson as? ObjectId {
+                return .objectId(val)
+            }
             guard let val = bson as? RLMObjectId,
                 let oid = try? ObjectId(string: val.stringValue) else {
                 return nil
             }
             return .objectId(oid)
         case .decimal128:
+            if let val = bson as? Decimal128 {
+                return .decimal128(val)
+            }
             guard let val = bson as? RLMDecimal128 else {
                 return nil
             }
-            return .decimal128(Decimal128(stringLiteral: val.stringValue))
+            return .decimal128(Decimal128(value: val))
         case .regularExpression:
             guard let val = bson as? NSRegularExpression else {
                 return nil
@@ -150,22 +164,28 @@ public extension ObjectiveCSupport {
         case .minKey:
             return .minKey
         case .document:
-            guard let val = bson as? Dictionary<String, RLMBSON?> else {
+            // Enumerate the NSDictionary rather than casting it to a Swift
+            // dictionary, which would eagerly bridge and type check every value
+            guard let val = bson as? NSDictionary else {
                 return nil
             }
-            return .document(val.reduce(into: Dictionary<String, AnyBSON?>()) { (result: inout [String: AnyBSON?], kvp) in
-                result[kvp.key] = kvp.value.map(convert)
-            })
+            var document = Document(minimumCapacity: val.count)
+            for case let (key as String, value as RLMBSON) in val {
+                document.updateValue(convert(object: value), forKey: key)
+            }
+            return .document(document)
         case .array:
-            guard let val = bson as? Array<RLMBSON?> else {
+            guard let val = bson as? NSArray else {
                 return nil
             }
-            return .array(val.compactMap {
-                if let value = $0 {
-                    return convertBson(object: value)
+            var array = [AnyBSON?]()
+            array.reserveCapacity(val.count)
+            for case let value as RLMBSON in val {
+                if let converted = convertBson(object: value) {
+                    array.append(converted == .null ? nil : converted)
                 }
-                return .null
-            }.map { (v: AnyBSON) -> AnyBSON? in v == .null ? nil : v })
+            }
+            return .array(array)
         case .UUID:
             guard let val = bson as? NSUUID else {
                 return nil
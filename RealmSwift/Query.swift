@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2021 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+import Foundation
+import Realm
+
+/**
+ A type-safe query over the properties of a Realm object, for use with `where(_:)`.
+
+ Properties are named with member lookup on the query rather than with strings, so
+ misspelled property names and comparisons against values of the wrong type are
+ reported by the compiler rather than when the query is run:
+
+ ```swift
+ let adults = realm.objects(Person.self).where {
+     $0.age >= 18 && $0.name.starts(with: "A")
+ }
+ ```
+
+ The resulting predicate is assembled directly from `NSComparisonPredicate` and
+ `NSCompoundPredicate` values, so there is no format string to parse.
+ */
+@dynamicMemberLookup
+public struct Query<T> {
+    private enum Node {
+        case keyPath(String)
+        case predicate(NSPredicate)
+    }
+    private let node: Node
+
+    private init(_ node: Node) {
+        self.node = node
+    }
+
+    internal init() {
+        self.node = .keyPath("")
+    }
+
+    private var keyPath: String {
+        switch node {
+        case .keyPath(let name):
+            return name
+        case .predicate(let predicate):
+            throwRealmException("Cannot use the result of a comparison (\(predicate)) as a property.")
+        }
+    }
+
+    private func appending(_ name: String) -> String {
+        let prefix = keyPath
+        return prefix.isEmpty ? name : "\(prefix).\(name)"
+    }
+
+    private func comparison(_ type: NSComparisonPredicate.Operator, _ value: Any,
+                            options: NSComparisonPredicate.Options = []) -> Query<Bool> {
+        let predicate = NSComparisonPredicate(leftExpression: NSExpression(forKeyPath: keyPath),
+                                              rightExpression: NSExpression(forConstantValue: value),
+                                              modifier: .direct, type: type, options: options)
+        return Query<Bool>(.predicate(predicate))
+    }
+}
+
+// MARK: Property Lookup
+
+extension Query where T: ObjectBase {
+    /// Returns a query on the given property of the object.
+    public subscript<V>(dynamicMember keyPath: KeyPath<T, V>) -> Query<V> {
+        return Query<V>(.keyPath(appending(_name(for: keyPath))))
+    }
+}
+
+extension Query where T: OptionalProtocol, T.Wrapped: ObjectBase {
+    /// Returns a query on the given property of the linked object.
+    public subscript<V>(dynamicMember keyPath: KeyPath<T.Wrapped, V>) -> Query<V> {
+        return Query<V>(.keyPath(appending(_name(for: keyPath))))
+    }
+}
+
+// MARK: Comparisons
+
+extension Query where T: Equatable {
+    /// Matches objects whose property is equal to the given value.
+    public static func == (lhs: Query<T>, rhs: T) -> Query<Bool> {
+        return lhs.comparison(.equalTo, dynamicBridgeCast(fromSwift: rhs))
+    }
+
+    /// Matches objects whose property is not equal to the given value.
+    public static func != (lhs: Query<T>, rhs: T) -> Query<Bool> {
+        return lhs.comparison(.notEqualTo, dynamicBridgeCast(fromSwift: rhs))
+    }
+
+    /// Matches objects whose property is equal to any of the given values.
+    public func `in`<S: Sequence>(_ values: S) -> Query<Bool> where S.Element == T {
+        return comparison(.in, values.map(dynamicBridgeCast(fromSwift:)))
+    }
+}
+
+/// :nodoc:
+public protocol _QueryComparable {}
+extension Int: _QueryComparable {}
+extension Int8: _QueryComparable {}
+extension Int16: _QueryComparable {}
+extension Int32: _QueryComparable {}
+extension Int64: _QueryComparable {}
+extension Float: _QueryComparable {}
+extension Double: _QueryComparable {}
+extension Date: _QueryComparable {}
+extension Decimal128: _QueryComparable {}
+extension Optional: _QueryComparable where Wrapped: _QueryComparable {}
+
+extension Query where T: _QueryComparable {
+    /// Matches objects whose property is greater than the given value.
+    public static func > (lhs: Query<T>, rhs: T) -> Query<Bool> {
+        return lhs.comparison(.greaterThan, dynamicBridgeCast(fromSwift: rhs))
+    }
+
+    /// Matches objects whose property is greater than or equal to the given value.
+    public static func >= (lhs: Query<T>, rhs: T) -> Query<Bool> {
+        return lhs.comparison(.greaterThanOrEqualTo, dynamicBridgeCast(fromSwift: rhs))
+    }
+
+    /// Matches objects whose property is less than the given value.
+    public static func < (lhs: Query<T>, rhs: T) -> Query<Bool> {
+        return lhs.comparison(.lessThan, dynamicBridgeCast(fromSwift: rhs))
+    }
+
+    /// Matches objects whose property is less than or equal to the given value.
+    public static func <= (lhs: Query<T>, rhs: T) -> Query<Bool> {
+        return lhs.comparison(.lessThanOrEqualTo, dynamicBridgeCast(fromSwift: rhs))
+    }
+
+    /// Matches objects whose property is within the given closed range.
+    public func contains(_ range: ClosedRange<T>) -> Query<Bool> where T: Comparable {
+        return comparison(.between, [dynamicBridgeCast(fromSwift: range.lowerBound),
+                                     dynamicBridgeCast(fromSwift: range.upperBound)])
+    }
+}
+
+// MARK: Strings
+
+/// :nodoc:
+public protocol _QueryString {}
+extension String: _QueryString {}
+extension Optional: _QueryString where Wrapped == String {}
+
+extension Query where T: _QueryString {
+    private static func options(_ caseSensitive: Bool, _ diacriticSensitive: Bool) -> NSComparisonPredicate.Options {
+        var options: NSComparisonPredicate.Options = []
+        if !caseSensitive {
+            options.insert(.caseInsensitive)
+        }
+        if !diacriticSensitive {
+            options.insert(.diacriticInsensitive)
+        }
+        return options
+    }
+
+    /// Matches objects whose string property begins with the given string.
+    public func starts(with value: String, caseSensitive: Bool = true,
+                       diacriticSensitive: Bool = true) -> Query<Bool> {
+        return comparison(.beginsWith, value, options: Self.options(caseSensitive, diacriticSensitive))
+    }
+
+    /// Matches objects whose string property ends with the given string.
+    public func ends(with value: String, caseSensitive: Bool = true,
+                     diacriticSensitive: Bool = true) -> Query<Bool> {
+        return comparison(.endsWith, value, options: Self.options(caseSensitive, diacriticSensitive))
+    }
+
+    /// Matches objects whose string property contains the given string.
+    public func contains(_ value: String, caseSensitive: Bool = true,
+                         diacriticSensitive: Bool = true) -> Query<Bool> {
+        return comparison(.contains, value, options: Self.options(caseSensitive, diacriticSensitive))
+    }
+
+    /**
+     Matches objects whose string property matches the given wildcard pattern, where `?`
+     matches a single character and `*` matches zero or more characters.
+     */
+    public func like(_ pattern: String, caseSensitive: Bool = true) -> Query<Bool> {
+        return comparison(.like, pattern, options: Self.options(caseSensitive, true))
+    }
+}
+
+// MARK: Compound Predicates
+
+extension Query where T == Bool {
+    /// The predicate which this query evaluates to.
+    internal var predicate: NSPredicate {
+        switch node {
+        case .predicate(let predicate):
+            return predicate
+        case .keyPath:
+            // A bare boolean property matches objects where it is true
+            return (self == true).predicate
+        }
+    }
+
+    /// Matches objects which match both of the given queries.
+    public static func && (lhs: Query<Bool>, rhs: Query<Bool>) -> Query<Bool> {
+        return Query<Bool>(.predicate(NSCompoundPredicate(andPredicateWithSubpredicates: [lhs.predicate, rhs.predicate])))
+    }
+
+    /// Matches objects which match either of the given queries.
+    public static func || (lhs: Query<Bool>, rhs: Query<Bool>) -> Query<Bool> {
+        return Query<Bool>(.predicate(NSCompoundPredicate(orPredicateWithSubpredicates: [lhs.predicate, rhs.predicate])))
+    }
+
+    /// Matches objects which do not match the given query.
+    public static prefix func ! (query: Query<Bool>) -> Query<Bool> {
+        return Query<Bool>(.predicate(NSCompoundPredicate(notPredicateWithSubpredicate: query.predicate)))
+    }
+}
@@ -55,6 +55,14 @@ import Realm.Private
     /// Indicates if the Realm contains any objects.
     public var isEmpty: Bool { return rlmRealm.isEmpty }
 
+    /**
+     The current size of the Realm file and how much of it is in use.
+
+     Unlike the values passed to `shouldCompactOnLaunch`, these can be read at any time while the
+     Realm is open, for example to decide when to compact the file or trim a cache.
+     */
+    public var storageStatistics: StorageStatistics { return rlmRealm.storageStatistics }
+
     // MARK: Initializers
 
     /**
@@ -187,6 +195,32 @@ import Realm.Private
          */
         public func cancel() { rlmTask.cancel() }
 
+        /**
+         The priority of this async open relative to other async opens.
+
+         When the number of async opens which can run at once is limited by
+         `maximumConcurrentOpens`, queued opens with a higher priority are started
+         before those with a lower priority, and opens with the same priority are
+         started in the order they were requested. Changing the priority of an open
+         which is still queued changes its position in the queue. Defaults to 0.
+         */
+        public var priority: Int {
+            get { rlmTask.priority }
+            nonmutating set { rlmTask.priority = newValue }
+        }
+
+        /**
+         The maximum number of async opens which can be in progress at once.
+
+         Async opens requested while this many are already in progress are queued
+         until one of the in-progress opens completes or is cancelled. Setting this
+         to 0, the default, places no limit on the number of concurrent opens.
+         */
+        public static var maximumConcurrentOpens: UInt {
+            get { RLMAsyncOpenTask.maximumConcurrentOpens }
+            set { RLMAsyncOpenTask.maximumConcurrentOpens = newValue }
+        }
+
         /**
          Register a progress notification block.
 
@@ -206,6 +240,70 @@ import Realm.Private
         }
     }
 
+    /**
+     Asynchronously compacts the Realm file for the given configuration on a background queue.
+
+     Unlike `shouldCompactOnLaunch`, this does not block opening the Realm, and so can be used to
+     compact very large files without delaying launch. Compaction can only be performed while
+     nothing else has the file open. If the file is open on another thread or in another process
+     when the background queue gets to it, the file is left unchanged and the callback is passed
+     `false`, and the compaction can be tried again later.
+
+     - parameter configuration: A configuration object identifying the Realm to compact.
+     - parameter callbackQueue: The dispatch queue on which the callback should be run.
+     - parameter callback:      A callback block passed whether the file was compacted, or a
+                                `Swift.Error` describing why the Realm could not be opened.
+     */
+    public static func asyncCompact(configuration: Realm.Configuration = .defaultConfiguration,
+                                    callbackQueue: DispatchQueue = .main,
+                                    callback: @escaping (Result<Bool, Swift.Error>) -> Void) {
+        RLMRealm.asyncCompact(with: configuration.rlmConfiguration, callbackQueue: callbackQueue) { compacted, error in
+            if let error = error {
+                callback(.failure(error))
+            } else {
+                callback(.success(compacted))
+            }
+        }
+    }
+
+    /**
+     Returns the versions of the Realm file for the given configuration which are currently held by
+     `Realm` instances in this process, oldest first.
+
+     Each version held by a Realm which has not been refreshed, or by a frozen Realm, makes the file
+     grow as later versions are written. Use this to find out what is holding on to old versions
+     when the file is larger than expected or when `maximumNumberOfActiveVersions` is exceeded.
+     Realms used internally for asynchronous writes, `ThreadSafeReference`s and other processes are
+     not included.
+
+     - parameter configuration: A configuration object identifying the Realm file.
+     */
+    public static func versionPins(configuration: Realm.Configuration = .defaultConfiguration) -> [VersionPin] {
+        return RLMRealm.versionPins(for: configuration.rlmConfiguration)
+    }
+
+    /**
+     Starts periodically deleting expired objects from the Realm file for the given configuration on a
+     background queue.
+
+     Objects expire when their object type overrides `Object.timeToLiveProperty()` and
+     `Object.timeToLive()`, and the date stored in the property is more than `timeToLive()` seconds
+     in the past. Expired objects are deleted in a series of short write transactions, each of which is
+     committed once it has run for `maximumWriteDuration` seconds, with a pause of the same length
+     between them so that writes made on other threads are never blocked for long.
+
+     - parameter configuration: A configuration object identifying the Realm.
+     - parameter interval: How often to check for expired objects, in seconds.
+     - parameter maximumWriteDuration: The longest time a single write transaction may take, in seconds.
+     - returns: A sweeper which keeps running until it is invalidated or deallocated.
+     */
+    public static func startExpiringObjects(configuration: Realm.Configuration = .defaultConfiguration,
+                                            interval: TimeInterval,
+                                            maximumWriteDuration: TimeInterval = 0.01) -> ExpirationSweeper {
+        return RLMRealm.startExpiringObjects(configuration: configuration.rlmConfiguration, interval: interval,
+                                             maximumWriteDuration: maximumWriteDuration)
+    }
+
     // MARK: Transactions
 
     /**
@@ -261,6 +359,39 @@ import Realm.Private
         return ret
     }
 
+    /**
+     Asynchronously performs actions contained within the given block inside a
+     write transaction on a background queue.
+
+     Unlike `write`, this never blocks the calling thread waiting for the write
+     lock or for the changes to be written to disk. The block is called on a
+     background queue with a `Realm` for the same file which is already in a
+     write transaction, and so must not use any objects or collections from the
+     calling thread. Pass objects into the block with `ThreadSafeReference` or
+     by primary key.
+
+     Asynchronous writes to the same Realm file are performed in the order they
+     were requested. Writes which are requested while a previous write is in
+     progress are performed together in a single write transaction, so the block
+     must not commit the write transaction itself. A block which cancels the
+     write transaction discards its own changes along with those of the earlier
+     writes in the same transaction, and the completion blocks of those earlier
+     writes are called with an error. The block's own completion block is also
+     called with an error saying that the write was cancelled.
+
+     If `onComplete` is given, it is called on the thread or queue which this
+     Realm is confined to after the write has been committed, and this Realm is
+     refreshed first so that it is up to date with the changes.
+
+     - parameter block: The block containing actions to perform.
+     - parameter onComplete: A block called with `nil` if the write succeeded,
+                             or with the error which prevented it from being
+                             committed.
+     */
+    public func writeAsync(_ block: @escaping (Realm) -> Void, onComplete: ((Swift.Error?) -> Void)? = nil) {
+        rlmRealm.asyncTransaction({ block(Realm($0)) }, onComplete: onComplete)
+    }
+
     /**
      Begins a write transaction on the Realm.
 
@@ -319,6 +450,27 @@ import Realm.Private
         try rlmRealm.commitWriteTransactionWithoutNotifying(tokens)
     }
 
+    /**
+     Lets a write transaction on the main thread go first if one is waiting for the write lock.
+
+     Write transactions begun on the main thread take priority over writes on other threads of the same process.
+     Long-running writes on background threads, such as imports, should call this method periodically. If a main
+     thread write is waiting, the current write transaction is committed, this method waits for the main thread to
+     acquire the write lock and finish, and then begins a new write transaction before returning. Otherwise it does
+     nothing.
+
+     After yielding, the Realm has been advanced to include the main thread's changes, so objects read earlier in the
+     transaction may have been deleted. This method never yields on the main thread, or during a bulk load begun with
+     `beginBulkLoad(forClasses:)`.
+
+     - warning: This method may only be called during a write transaction.
+
+     - throws: An `NSError` if the transaction could not be committed or begun again.
+     */
+    public func yieldWriteIfNeeded() throws {
+        try rlmRealm.yieldWriteTransactionIfNeeded()
+    }
+
     /**
      Reverts all writes made in the current write transaction and ends the transaction.
 
@@ -355,6 +507,45 @@ import Realm.Private
         rlmRealm.cancelWriteTransaction()
     }
 
+    /**
+     Suspends maintenance of the search indexes of the given types for the rest of the current write transaction.
+
+     The search indexes of all indexed properties of the given types other than the primary key are removed, and
+     rebuilt in a single pass over each column when the write transaction is committed. This makes loading a large
+     number of objects into types with indexed properties faster. Queries on the affected properties still work
+     during the write transaction, but do not use the index. Cancelling the write transaction restores the indexes.
+
+     - parameter types: The types whose indexes should be suspended.
+
+     - warning: This method may only be called during a write transaction.
+     */
+    public func beginBulkLoad(for types: [Object.Type]) {
+        rlmRealm.beginBulkLoad(forClasses: types.map { $0.className() })
+    }
+
+    /**
+     Deletes the files in the blob store which are not referenced by any object in the
+     current version of the Realm once the write transaction is committed.
+
+     Values of properties listed in `Object.externalBlobProperties()` are stored in
+     files next to the Realm file, which are not removed when the objects referring to
+     them are deleted or modified. Call this periodically to reclaim the space.
+
+     Nothing is deleted if the write transaction is cancelled. Files which are still
+     referenced by a version of the Realm that a frozen Realm or an unrefreshed Realm in
+     this process is reading are kept, and are found again by a later call. Realms in
+     other processes are not taken into account.
+
+     - warning: This method may only be called during a write transaction.
+
+     - returns: The number of unreferenced files found, which will be deleted when the
+                write transaction is committed.
+     */
+    @discardableResult
+    public func removeUnreferencedExternalBlobs() -> Int {
+        return Int(rlmRealm.removeUnreferencedExternalBlobs())
+    }
+
     /**
      Indicates whether the Realm is currently in a write transaction.
 
@@ -385,6 +576,9 @@ import Realm.Private
          If few or no of the properties are changing this will be faster than .all and reduce how much data has
          to be written to the Realm file. If all of the properties are changing, it may be slower than .all (but
          will never result in *more* data being written).
+
+         Embedded objects, including those in lists, are updated in place rather than being deleted and
+         recreated, with the elements of a list of embedded objects matched by position.
          */
         case modified = 3
         /**
@@ -396,6 +590,19 @@ import Realm.Private
         case all = 2
     }
 
+    /**
+     The number of objects inserted, updated and left unchanged by `create(_:values:update:)`.
+     */
+    public struct UpsertCounts {
+        /// The number of new objects created.
+        public let inserted: Int
+        /// The number of existing objects which were updated.
+        public let updated: Int
+        /// The number of existing objects which were not modified. This is only
+        /// counted for `.modified`, as the other policies always write every object.
+        public let unchanged: Int
+    }
+
     /// :nodoc:
     @available(*, unavailable, message: "Pass .error, .modified or .all rather than a boolean. .error is equivalent to false and .all is equivalent to true.")
     public func add(_ object: Object, update: Bool) {
@@ -504,6 +711,123 @@ import Realm.Private
                                                               RLMUpdatePolicy(rawValue: UInt(update.rawValue))!), to: type)
     }
 
+    /**
+     Creates a Realm object for each value in a sequence, adding them to the Realm.
+
+     Each element of `values` can be any of the values accepted by `create(_:value:update:)`.
+     Unlike calling `create(_:value:update:)` in a loop, this does not create an
+     accessor object for each of the newly created objects, and the schema lookup
+     is performed only once for the entire batch, which makes it considerably
+     faster when inserting large numbers of objects.
+
+     Unmanaged objects passed in `values` are copied into the Realm and remain
+     unmanaged.
+
+     - warning: This method may only be called during a write transaction.
+
+     - parameter type:   The type of the objects to create.
+     - parameter values: A sequence of values used to populate the objects.
+     With `.modified`, existing objects for which none of the given property values differ from
+     the stored ones are skipped entirely, so they are neither written nor reported as modified
+     to notification blocks. This makes upserting a large batch of mostly-unchanged objects
+     much faster than calling `create(_:value:update:)` for each of them.
+
+     - parameter update: What to do if an object with the same primary key alredy exists. Must be `.error` for object
+     types without a primary key.
+     - returns: The number of objects which were inserted, updated and unchanged.
+     */
+    @discardableResult
+    public func create<T: Object, S: Sequence>(_ type: T.Type, values: S, update: UpdatePolicy = .error) -> UpsertCounts {
+        if update != .error {
+            RLMVerifyHasPrimaryKey(type)
+        }
+        let typeName = (type as Object.Type).className()
+        let counts = RLMCreateObjectsInRealmWithValues(rlmRealm, typeName, Array(values) as NSArray,
+                                                       RLMUpdatePolicy(rawValue: UInt(update.rawValue))!)
+        return UpsertCounts(inserted: Int(counts.inserted), updated: Int(counts.updated),
+                            unchanged: Int(counts.unchanged))
+    }
+
+    /**
+     Creates Realm objects from JSON Lines read from an input stream, adding them to the Realm.
+
+     Each line of the stream must be a JSON object whose keys are property names, in the format
+     written by `Results.writeJSONLines(to:)`. The stream is read incrementally and the objects are
+     inserted in batches, so the whole input is never held in memory.
+
+     - warning: This method may only be called during a write transaction.
+
+     - parameter type:   The type of the objects to create.
+     - parameter stream: An open stream to read the objects from.
+
+     - throws: An `NSError` if the stream could not be read or contains invalid JSON. Objects created
+               before the error remain in the write transaction.
+     */
+    public func create<T: Object>(_ type: T.Type, fromJSONLines stream: InputStream) throws {
+        try rlmRealm.createObjects((type as Object.Type).className(), fromJSONLines: stream)
+    }
+
+    /**
+     Decodes a Realm object from JSON data, adding it to the Realm.
+
+     The JSON is converted directly into the values used to create the object
+     rather than first decoding an unmanaged object and then adding it to the
+     Realm, so no unmanaged `Object`, `List` or `Map` instances are created for
+     the object or any of the objects nested in it.
+
+     Values are decoded in the same way as the synthesized `Decodable`
+     implementation with `JSONDecoder`'s default strategies: keys must match the
+     property names, dates are numbers of seconds since the reference date,
+     binary data is Base64-encoded, and ObjectIds, UUIDs and Decimal128s are
+     strings. Keys which do not correspond to a persisted property are ignored.
+
+     - warning: This method may only be called during a write transaction.
+
+     - parameter type:   The type of the object to create.
+     - parameter data:   A JSON object.
+     - parameter update: What to do if an object with the same primary key alredy exists. Must be `.error` for object
+     types without a primary key.
+     - throws: A `DecodingError` if the data is not valid JSON or does not match the object's schema.
+
+     - returns: The newly created object.
+     */
+    @discardableResult
+    public func decode<T: Object>(_ type: T.Type, from data: Data, update: UpdatePolicy = .error) throws -> T {
+        let converter = JSONValueConverter(schema: rlmRealm.schema)
+        let value = try converter.convertObject(try converter.parse(data),
+                                                className: (type as Object.Type).className(), codingPath: [])
+        return create(type, value: value, update: update)
+    }
+
+    /**
+     Decodes a JSON array of Realm objects, adding them to the Realm.
+
+     This is the batch equivalent of `decode(_:from:update:)`, and creates the
+     objects in the same way as `create(_:values:update:)`, without creating an
+     accessor object for each of the newly created objects.
+
+     - warning: This method may only be called during a write transaction.
+
+     - parameter type:   The type of the objects to create.
+     - parameter data:   A JSON array of objects.
+     - parameter update: What to do if an object with the same primary key alredy exists. Must be `.error` for object
+     types without a primary key.
+     - throws: A `DecodingError` if the data is not valid JSON or does not match the object's schema.
+     */
+    public func decodeObjects<T: Object>(_ type: T.Type, from data: Data, update: UpdatePolicy = .error) throws {
+        let converter = JSONValueConverter(schema: rlmRealm.schema)
+        let json = try converter.parse(data)
+        guard let array = json as? [Any] else {
+            throw converter.typeMismatch([Any].self, json, codingPath: [])
+        }
+        let className = (type as Object.Type).className()
+        let values = try array.enumerated().map { index, element in
+            try converter.convertObject(element, className: className,
+                                        codingPath: [JSONCodingKey(intValue: index)])
+        }
+        create(type, values: values, update: update)
+    }
+
     /// :nodoc:
     @discardableResult
     @available(*, unavailable, message: "Pass .error, .modified or .all rather than a boolean. .error is equivalent to false and .all is equivalent to true.")
@@ -588,9 +912,7 @@ import Realm.Private
                             elements are `Object`s (subject to the caveats above).
      */
     public func delete<S: Sequence>(_ objects: S) where S.Iterator.Element: ObjectBase {
-        for obj in objects {
-            delete(obj)
-        }
+        RLMDeleteObjectsFromRealm(Array(objects) as NSArray, rlmRealm)
     }
 
     /**
@@ -641,6 +963,24 @@ import Realm.Private
         RLMDeleteAllObjectsFromRealm(rlmRealm)
     }
 
+    /**
+     Deletes all objects from the Realm without sending key-value observing notifications for the
+     deleted objects.
+
+     The tables are cleared in bulk without sending KVO notifications for each observed object,
+     which makes this much faster than `deleteAll()` for Realms containing millions of objects.
+     Realm, collection and object notification blocks are called as usual when the write transaction
+     is committed.
+
+     This is intended for discarding the contents of a cache Realm. Any objects which are being
+     observed with KVO will be invalidated without their observers being told.
+
+     - warning: This method may only be called during a write transaction.
+     */
+    public func truncateAll() {
+        RLMTruncateAllObjectsInRealm(rlmRealm)
+    }
+
     // MARK: Object Retrieval
 
     /**
@@ -670,6 +1010,34 @@ import Realm.Private
         return Results<DynamicObject>(RLMGetObjects(rlmRealm, typeName, nil))
     }
 
+    /**
+     Reads the given properties of every object in the results on a background queue, so that the
+     parts of the Realm file they are stored in are loaded from disk before they are first needed.
+
+     This can be used shortly after opening a large Realm file to avoid stalling the main thread on
+     disk reads the first time a large collection of objects is displayed.
+
+     - warning: Cannot call within a write transaction.
+
+     - parameter results:    The results whose objects should be read.
+     - parameter properties: The names of the properties to read, or `nil` to read all of them.
+                             Collection properties are ignored.
+     */
+    public func prefetch<Element: Object>(_ results: Results<Element>, properties: [String]? = nil) {
+        rlmRealm.prefetchResults(results.rlmResults, properties: properties)
+    }
+
+    /**
+     Reads the given properties of every object of the given type on a background queue.
+     See `prefetch(_:properties:)`.
+
+     - parameter type:       The type of the objects to read.
+     - parameter properties: The names of the properties to read, or `nil` to read all of them.
+     */
+    public func prefetch<Element: Object>(_ type: Element.Type, properties: [String]? = nil) {
+        prefetch(objects(type), properties: properties)
+    }
+
     /**
      Retrieves the single instance of a given object type with the given primary key from the Realm.
 
@@ -688,6 +1056,30 @@ import Realm.Private
                              to: Optional<Element>.self)
     }
 
+    /**
+     Retrieves the instances of a given object type with each of the given primary keys from the Realm.
+
+     All of the keys are validated before any objects are looked up, and the lookups are
+     batched, which is much faster than calling `object(ofType:forPrimaryKey:)` for each key
+     when looking up many objects at once.
+
+     This method requires that `primaryKey()` be overridden on the given object class.
+
+     - see: `Object.primaryKey()`
+
+     - parameter type: The type of the objects to be returned.
+     - parameter keys: The primary keys of the desired objects.
+
+     - returns: The object for each key in the same order as `keys`, or `nil` for each key
+                which has no instance.
+     */
+    public func objects<Element: Object, S: Sequence>(ofType type: Element.Type,
+                                                      forPrimaryKeys keys: S) -> [Element?] {
+        let objects = RLMGetObjectsForPrimaryKeys(rlmRealm, (type as Object.Type).className(),
+                                                  keys.map(dynamicBridgeCast(fromSwift:)) as NSArray)
+        return objects.map { $0 is NSNull ? nil : unsafeBitCast($0 as AnyObject, to: Element.self) }
+    }
+
     /**
      This method is useful only in specialized circumstances, for example, when building
      components that integrate with Realm. If you are simply building an app on Realm, it is
@@ -750,6 +1142,27 @@ import Realm.Private
         }
     }
 
+    /**
+     Adds a notification handler which is called with a summary of which object types had objects inserted, deleted
+     or modified each time this Realm advances to a new version, and returns a notification token.
+
+     The handler is called at the same times as `.didChange` notifications are delivered to blocks added with
+     `observe(_:)`. Producing the summary requires reading the changes made by each transaction, so this is more
+     expensive than `observe(_:)` while any such handlers are registered.
+
+     You must retain the returned token for as long as you want updates to be sent to the block. To stop receiving
+     updates, call `invalidate()` on the token.
+
+     - parameter block: A block which is called with this Realm and a summary of the changed object types.
+
+     - returns: A token which must be held for as long as you wish to continue receiving change notifications.
+     */
+    public func observeChangeSummary(_ block: @escaping (Realm, RealmChangeSummary) -> Void) -> NotificationToken {
+        return rlmRealm.addChangeSummaryNotificationBlock { _, summary in
+            block(self, summary)
+        }
+    }
+
     // MARK: Autorefresh and Refresh
 
     /**
@@ -914,6 +1327,27 @@ import Realm.Private
         try rlmRealm.writeCopy(to: fileURL, encryptionKey: encryptionKey)
     }
 
+    /**
+     Writes a compacted and optionally encrypted copy of the Realm to the given output stream.
+
+     The copy is first written to a temporary file, which is then written to the stream in chunks and deleted. The
+     stream must already be open, and is left open when this method returns.
+
+     - parameter stream:                The stream to write the copy to.
+     - parameter encryptionKey:         Optional 64-byte encryption key to encrypt the copy with.
+     - parameter maximumBytesPerSecond: If non-zero, writes to the stream are paced to stay under this rate.
+     - parameter progress:              Optional block called after each chunk is written to the stream, with the
+                                        number of bytes written so far and the total size of the copy.
+
+     - throws: An `NSError` if the copy could not be written.
+     */
+    public func writeCopy(to stream: OutputStream, encryptionKey: Data? = nil,
+                          maximumBytesPerSecond: UInt64 = 0,
+                          progress: ((_ bytesWritten: UInt64, _ totalBytes: UInt64) -> Void)? = nil) throws {
+        try rlmRealm.writeCopy(to: stream, encryptionKey: encryptionKey,
+                               maximumBytesPerSecond: maximumBytesPerSecond, progress: progress)
+    }
+
     /**
      Checks if the Realm file for the given configuration exists locally on disk.
 
@@ -1049,6 +1483,12 @@ extension Realm {
     public init(configuration: Realm.Configuration = .defaultConfiguration,
                 downloadBeforeOpen: OpenBehavior = .never,
                 queue: DispatchQueue? = nil) async throws {
+        try await Realm.prepare(configuration: configuration, downloadBeforeOpen: downloadBeforeOpen)
+        try self.init(RLMRealm(configuration: configuration.rlmConfiguration, queue: queue))
+    }
+
+    fileprivate static func prepare(configuration: Realm.Configuration,
+                                    downloadBeforeOpen: OpenBehavior) async throws {
         switch downloadBeforeOpen {
         case .never:
             break
@@ -1067,7 +1507,288 @@ extension Realm {
                 })
             }
         }
-        try self.init(RLMRealm(configuration: configuration.rlmConfiguration, queue: queue))
+    }
+}
+
+/**
+ A `Realm` isolated to an actor, which can be kept and used from async code
+ without reopening the Realm after each suspension point.
+
+ A `Realm` is confined to the thread or dispatch queue it was opened on, while
+ an async task may resume on a different thread after each `await`. A
+ `RealmActor` opens its Realm confined to a private serial queue and performs
+ all work with it on that queue, so a single instance can be shared between
+ tasks and used for as long as needed:
+
+ ```swift
+ let realm = try await RealmActor()
+ try await realm.write { realm in
+     realm.add(Dog(value: ["Rex"]))
+ }
+ let count = try await realm.read { $0.objects(Dog.self).count }
+ ```
+
+ Objects and collections from the Realm passed to the blocks must not escape
+ them, as they can only be used on the actor's queue. Return plain values or
+ frozen objects instead.
+ */
+@available(macOS 12.0, tvOS 15.0, iOS 15.0, watchOS 8.0, *)
+public actor RealmActor {
+    /// The configuration used to open the Realm.
+    public nonisolated let configuration: Realm.Configuration
+
+    private let queue: DispatchQueue
+    private let realm: Realm
+
+    /**
+     Opens the Realm with the given configuration, confined to the actor.
+
+     - parameter configuration: A configuration object to use when opening the Realm.
+     - parameter downloadBeforeOpen: When opening the Realm should first download
+                                     all data from the server.
+     - throws: An `NSError` if the Realm could not be initialized.
+     */
+    public init(configuration: Realm.Configuration = .defaultConfiguration,
+                downloadBeforeOpen: Realm.OpenBehavior = .never) async throws {
+        try await Realm.prepare(configuration: configuration, downloadBeforeOpen: downloadBeforeOpen)
+        let queue = DispatchQueue(label: "io.realm.RealmActor")
+        self.configuration = configuration
+        self.queue = queue
+        self.realm = try await RealmActor.perform(on: queue) {
+            try Realm(RLMRealm(configuration: configuration.rlmConfiguration, queue: queue))
+        }
+    }
+
+    /**
+     Calls the given block with the Realm and returns its result.
+
+     The Realm is refreshed before the block is called if another thread or
+     process has written to it.
+     */
+    public func read<Result>(_ block: @escaping (Realm) throws -> Result) async throws -> Result {
+        let realm = self.realm
+        return try await RealmActor.perform(on: queue) {
+            realm.refresh()
+            return try block(realm)
+        }
+    }
+
+    /**
+     Performs the actions in the given block inside a write transaction on the
+     Realm and returns its result.
+
+     See `Realm.write(withoutNotifying:_:)` for details.
+     */
+    public func write<Result>(withoutNotifying tokens: [NotificationToken] = [],
+                              _ block: @escaping (Realm) throws -> Result) async throws -> Result {
+        let realm = self.realm
+        return try await RealmActor.perform(on: queue) {
+            try realm.write(withoutNotifying: tokens) { try block(realm) }
+        }
+    }
+
+    /**
+     Returns a stream of frozen snapshots of all objects of the given type,
+     yielding the current objects immediately and then again after each write
+     which changes them.
+
+     If the objects change again before a snapshot has been consumed, only the
+     newest snapshot is kept. The stream finishes if the notifications fail.
+     */
+    public func objects<Element: Object>(_ type: Element.Type) -> AsyncStream<Results<Element>> {
+        let realm = self.realm
+        return AsyncStream(bufferingPolicy: .bufferingNewest(1)) { continuation in
+            queue.async {
+                let token = realm.objects(type).observe { change in
+                    switch change {
+                    case .initial(let results), .update(let results, _, _, _):
+                        continuation.yield(results.freeze())
+                    case .error:
+                        continuation.finish()
+                    }
+                }
+                continuation.onTermination = { @Sendable _ in token.invalidate() }
+            }
+        }
+    }
+
+    // Runs the block on the Realm's queue without blocking the thread the
+    // actor is running on while waiting for it
+    private static func perform<Result>(on queue: DispatchQueue,
+                                        _ block: @escaping () throws -> Result) async throws -> Result {
+        try await withCheckedThrowingContinuation { continuation in
+            queue.async {
+                continuation.resume(with: Swift.Result { try block() })
+            }
+        }
     }
 }
 #endif // swift(>=5.5)
+
+// MARK: - JSON Decoding
+
+private struct JSONCodingKey: CodingKey {
+    var stringValue: String
+    var intValue: Int?
+
+    init(stringValue: String) {
+        self.stringValue = stringValue
+    }
+
+    init(intValue: Int) {
+        self.stringValue = "Index \(intValue)"
+        self.intValue = intValue
+    }
+}
+
+/// Converts the output of `JSONSerialization` into values which can be passed
+/// to `RLMCreateObjectInRealmWithValue()`, using the Realm's schema to decide
+/// how each value should be interpreted.
+private struct JSONValueConverter {
+    let schema: RLMSchema
+
+    func parse(_ data: Data) throws -> Any {
+        do {
+            return try JSONSerialization.jsonObject(with: data, options: [.fragmentsAllowed])
+        } catch {
+            throw DecodingError.dataCorrupted(.init(codingPath: [],
+                                                    debugDescription: "The given data was not valid JSON.",
+                                                    underlyingError: error))
+        }
+    }
+
+    func typeMismatch(_ type: Any.Type, _ value: Any, codingPath: [CodingKey]) -> DecodingError {
+        return DecodingError.typeMismatch(type, .init(codingPath: codingPath,
+                                                      debugDescription: "Expected \(type) but found \(Swift.type(of: value)) instead."))
+    }
+
+    func dataCorrupted(_ description: String, codingPath: [CodingKey]) -> DecodingError {
+        return DecodingError.dataCorrupted(.init(codingPath: codingPath, debugDescription: description))
+    }
+
+    func convertObject(_ value: Any, className: String, codingPath: [CodingKey]) throws -> [String: Any] {
+        guard let dictionary = value as? [String: Any] else {
+            throw typeMismatch([String: Any].self, value, codingPath: codingPath)
+        }
+        guard let objectSchema = schema.schema(forClassName: className) else {
+            // Let object creation report the unknown type
+            return dictionary
+        }
+        var result = [String: Any](minimumCapacity: dictionary.count)
+        for property in objectSchema.properties {
+            guard let value = dictionary[property.name] else { continue }
+            let path = codingPath + [JSONCodingKey(stringValue: property.name)]
+            result[property.name] = try convertProperty(value, property, codingPath: path)
+        }
+        return result
+    }
+
+    func convertProperty(_ value: Any, _ property: RLMProperty, codingPath: [CodingKey]) throws -> Any {
+        if property.array || property.set {
+            guard let array = value as? [Any] else {
+                throw typeMismatch([Any].self, value, codingPath: codingPath)
+            }
+            return try array.enumerated().map { index, element in
+                try convertValue(element, property, codingPath: codingPath + [JSONCodingKey(intValue: index)])
+            }
+        }
+        if property.dictionary {
+            guard let dictionary = value as? [String: Any] else {
+                throw typeMismatch([String: Any].self, value, codingPath: codingPath)
+            }
+            return try dictionary.mapValues { element in
+                try convertValue(element, property, codingPath: codingPath)
+            }
+        }
+        return try convertValue(value, property, codingPath: codingPath)
+    }
+
+    func convertValue(_ value: Any, _ property: RLMProperty, codingPath: [CodingKey]) throws -> Any {
+        if value is NSNull {
+            guard property.optional || property.type == .object || property.type == .any else {
+                throw DecodingError.valueNotFound(Any.self, .init(codingPath: codingPath,
+                                                                  debugDescription: "Expected a value for non-optional property '\(property.name)' but found null instead."))
+            }
+            return value
+        }
+
+        switch property.type {
+        case .object:
+            return try convertObject(value, className: property.objectClassName!, codingPath: codingPath)
+        case .int:
+            guard let number = value as? NSNumber, !isBool(number),
+                  number.doubleValue == Double(number.int64Value) else {
+                throw typeMismatch(Int.self, value, codingPath: codingPath)
+            }
+            return number
+        case .bool:
+            guard let number = value as? NSNumber, isBool(number) else {
+                throw typeMismatch(Bool.self, value, codingPath: codingPath)
+            }
+            return number
+        case .float, .double:
+            guard let number = value as? NSNumber, !isBool(number) else {
+                throw typeMismatch(Double.self, value, codingPath: codingPath)
+            }
+            return number
+        case .string:
+            guard let string = value as? String else {
+                throw typeMismatch(String.self, value, codingPath: codingPath)
+            }
+            return string
+        case .date:
+            guard let number = value as? NSNumber, !isBool(number) else {
+                throw typeMismatch(Double.self, value, codingPath: codingPath)
+            }
+            return Date(timeIntervalSinceReferenceDate: number.doubleValue)
+        case .data:
+            guard let string = value as? String else {
+                throw typeMismatch(String.self, value, codingPath: codingPath)
+            }
+            guard let data = Data(base64Encoded: string) else {
+                throw dataCorrupted("Encountered Data is not valid Base64.", codingPath: codingPath)
+            }
+            return data
+        case .objectId:
+            guard let string = value as? String else {
+                throw typeMismatch(String.self, value, codingPath: codingPath)
+            }
+            do {
+                return try ObjectId(string: string)
+            } catch {
+                throw dataCorrupted("Invalid ObjectId string '\(string)'.", codingPath: codingPath)
+            }
+        case .UUID:
+            guard let string = value as? String else {
+                throw typeMismatch(String.self, value, codingPath: codingPath)
+            }
+            guard let uuid = UUID(uuidString: string) else {
+                throw dataCorrupted("Attempted to decode UUID from invalid UUID string.", codingPath: codingPath)
+            }
+            return uuid
+        case .decimal128:
+            if let string = value as? String {
+                do {
+                    return try Decimal128(string: string)
+                } catch {
+                    throw dataCorrupted("Invalid Decimal128 string '\(string)'.", codingPath: codingPath)
+                }
+            }
+            guard let number = value as? NSNumber, !isBool(number) else {
+                throw typeMismatch(Decimal128.self, value, codingPath: codingPath)
+            }
+            return Decimal128(number: number)
+        case .any:
+            guard value is String || value is NSNumber else {
+                throw typeMismatch(AnyRealmValue.self, value, codingPath: codingPath)
+            }
+            return value
+        default:
+            throw typeMismatch(Any.self, value, codingPath: codingPath)
+        }
+    }
+
+    private func isBool(_ number: NSNumber) -> Bool {
+        return CFGetTypeID(number) == CFBooleanGetTypeID()
+    }
+}
@@ -174,18 +174,14 @@ public protocol _RealmMapValue {
         }
         if let change = change {
             return .update(value!,
-                deletions: forceCast(change.deletions, to: [Int].self),
-                insertions: forceCast(change.insertions, to: [Int].self),
-                modifications: forceCast(change.modifications, to: [Int].self))
+                deletions: Array(change.deletionIndexes as IndexSet),
+                insertions: Array(change.insertionIndexes as IndexSet),
+                modifications: Array(change.modificationIndexes as IndexSet))
         }
         return .initial(value!)
     }
 }
 
-private func forceCast<A, U>(_ from: A, to type: U.Type) -> U {
-    return from as! U
-}
-
 /// A type which can be stored in a Realm List, MutableSet, or Results.
 ///
 /// Declaring additional types as conforming to this protocol will not make them
@@ -845,6 +841,19 @@ public extension RealmCollection where Element: ObjectBase {
  enables sortable operations.
  */
 public extension RealmCollection where Element: ObjectBase {
+    /**
+     Returns a `Results` containing all objects in the collection which match the given query.
+
+     ```swift
+     let adults = people.where { $0.age >= 18 && $0.name.starts(with: "A") }
+     ```
+
+     - parameter isIncluded: A closure which builds the query from the object's properties.
+     */
+    func `where`(_ isIncluded: (Query<Element>) -> Query<Bool>) -> Results<Element> {
+        return filter(isIncluded(Query()).predicate)
+    }
+
     /**
      Returns a `Results` containing the objects in the collection, but sorted.
 
@@ -1038,6 +1047,7 @@ private class _AnyRealmCollectionBase<T: RealmCollectionValue>: AssistedObjectiv
     class func bridging(from objectiveCValue: Any, with metadata: Any?) -> Self { fatalError() }
     var bridged: (objectiveCValue: Any, metadata: Any?) { fatalError() }
     func asNSFastEnumerator() -> Any { fatalError() }
+    var rlmCollection: RLMCollection? { fatalError() }
     var isFrozen: Bool { fatalError() }
     func freeze() -> AnyRealmCollection<T> { fatalError() }
     func thaw() -> AnyRealmCollection<T> { fatalError() }
@@ -1117,6 +1127,12 @@ private final class _AnyRealmCollection<C: RealmCollection>: _AnyRealmCollection
         return (base as! UntypedCollection).asNSFastEnumerator()
     }
 
+    // Read on each access rather than stored, as the collection backing a List
+    // or MutableSet is replaced when it's added to a Realm
+    override var rlmCollection: RLMCollection? {
+        return (base as? UntypedCollection)?.asNSFastEnumerator() as? RLMCollection
+    }
+
     // MARK: Collection Support
 
     override var startIndex: Int {
@@ -1190,6 +1206,9 @@ public struct AnyRealmCollection<Element: RealmCollectionValue>: RealmCollection
 
     /// The type of the objects contained in the collection.
     fileprivate let base: _AnyRealmCollectionBase<Element>
+    /// The Objective-C collection backing the wrapped collection, if any.
+    /// Element access uses this directly rather than going through `base`.
+    private var rlmCollection: RLMCollection? { return base.rlmCollection }
 
     fileprivate init(base: _AnyRealmCollectionBase<Element>) {
         self.base = base
@@ -1197,6 +1216,10 @@ public struct AnyRealmCollection<Element: RealmCollectionValue>: RealmCollection
 
     /// Creates an `AnyRealmCollection` wrapping `base`.
     public init<C: RealmCollection>(_ base: C) where C.Element == Element {
+        if let base = base as? AnyRealmCollection<Element> {
+            self = base
+            return
+        }
         self.base = _AnyRealmCollection(base: base)
     }
 
@@ -1348,10 +1371,41 @@ public struct AnyRealmCollection<Element: RealmCollectionValue>: RealmCollection
 
      - parameter index: The index.
      */
-    public subscript(position: Int) -> Element { return base[position] }
+    public subscript(position: Int) -> Element {
+        guard let collection = rlmCollection else {
+            return base[position]
+        }
+        throwForNegativeIndex(position)
+        return dynamicBridgeCast(fromObjectiveC: collection.object(at: UInt(position)))
+    }
 
     /// Returns a `RLMIterator` that yields successive elements in the collection.
-    public func makeIterator() -> RLMIterator<Element> { return base.makeIterator() }
+    public func makeIterator() -> RLMIterator<Element> {
+        if let collection = rlmCollection {
+            return RLMIterator(collection: collection)
+        }
+        return base.makeIterator()
+    }
+
+    /**
+     Returns the objects at the given range of indexes.
+
+     This reads all of the objects in a single call to the underlying
+     collection, which is faster than reading them one at a time with the
+     subscript.
+
+     - parameter range: The range of indexes to read.
+     */
+    public func elements(in range: Range<Int>) -> [Element] {
+        guard let collection = rlmCollection else {
+            return base.objects(at: IndexSet(integersIn: range))
+        }
+        throwForNegativeIndex(range.lowerBound)
+        guard let objects = collection.objects(at: IndexSet(integersIn: range)) else {
+            throwRealmException("Indexes for collection are out of bounds")
+        }
+        return objects.map(dynamicBridgeCast)
+    }
 
     internal func asNSFastEnumerator() -> Any { return base.asNSFastEnumerator() }
 
@@ -113,6 +113,10 @@ extension Realm {
             set {
                 _inMemoryIdentifier = nil
                 _syncConfiguration = newValue
+                // Move the file to the requested directory, keeping its name
+                if let directoryURL = newValue?.directoryURL, let path = _path {
+                    _path = directoryURL.appendingPathComponent(URL(fileURLWithPath: path).lastPathComponent).path
+                }
             }
         }
 
@@ -243,6 +247,36 @@ extension Realm {
          */
         public var maximumNumberOfActiveVersions: UInt?
 
+        /**
+         How long asynchronous writes wait for further writes to be requested before they are committed.
+
+         Each commit has a fixed cost to make the changes durable, which dominates the cost of small
+         write transactions. When this is greater than zero, writes requested with
+         `Realm.writeAsync(_:onComplete:)` wait up to this long for more writes, and then all of them
+         are performed in one write transaction with a single commit. The completion block of each
+         write is called after that shared commit.
+
+         This does not affect synchronous write transactions.
+         */
+        public var groupCommitInterval: TimeInterval = 0
+
+        /**
+         The maximum number of asynchronous writes which are grouped into a single commit.
+
+         When this many writes are waiting, they are committed immediately rather than waiting for the
+         rest of `groupCommitInterval`. `nil` means there is no limit.
+         */
+        public var maximumWritesPerGroupCommit: UInt?
+
+        /**
+         A block which is called with timing and size information after each write transaction
+         performed with Realms opened with this configuration, on the thread which performed it.
+
+         This can be used to find slow writers in production. Measuring the write transaction adds a
+         small amount of overhead, and so is only done when this is set.
+         */
+        public var writeTransactionObserver: ((WriteTransactionMetrics) -> Void)?
+
         /// A custom schema to use for the Realm.
         private var customSchema: RLMSchema?
 
@@ -276,6 +310,9 @@ extension Realm {
             configuration.setCustomSchemaWithoutCopying(self.customSchema)
             configuration.disableFormatUpgrade = self.disableFormatUpgrade
             configuration.maximumNumberOfActiveVersions = self.maximumNumberOfActiveVersions ?? 0
+            configuration.groupCommitInterval = self.groupCommitInterval
+            configuration.maximumWritesPerGroupCommit = self.maximumWritesPerGroupCommit ?? 0
+            configuration.writeTransactionObserver = self.writeTransactionObserver
             return configuration
         }
 
@@ -301,6 +338,10 @@ extension Realm {
             configuration.customSchema = rlmConfiguration.customSchema
             configuration.disableFormatUpgrade = rlmConfiguration.disableFormatUpgrade
             configuration.maximumNumberOfActiveVersions = rlmConfiguration.maximumNumberOfActiveVersions
+            configuration.groupCommitInterval = rlmConfiguration.groupCommitInterval
+            let maximumWrites = rlmConfiguration.maximumWritesPerGroupCommit
+            configuration.maximumWritesPerGroupCommit = maximumWrites == 0 ? nil : maximumWrites
+            configuration.writeTransactionObserver = rlmConfiguration.writeTransactionObserver
             return configuration
         }
     }
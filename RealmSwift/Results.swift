@@ -303,6 +303,22 @@ extension AnyRealmValue: AddableType {}
         return rlmResults.average(ofProperty: property).map(dynamicBridgeCast)
     }
 
+    // MARK: Query Diagnostics
+
+    /**
+     Returns a human-readable description of how the query for these results is evaluated,
+     for use when tuning slow queries.
+
+     The description includes the query as it was translated for the database, the sort and
+     distinct operations, which properties of the object type are indexed, and the number of
+     matching objects and how long it took to count them.
+
+     - warning: This evaluates the query, so it takes as long as the query itself does.
+     */
+    public func explain() -> String {
+        return rlmResults.explain()
+    }
+
     // MARK: Notifications
 
     /**
@@ -612,6 +628,35 @@ extension AnyRealmValue: AddableType {}
         return rlmResults.addNotificationBlock(wrapObserveBlock(block), keyPaths: keyPaths.map(_name(for:)), queue: queue)
     }
 
+    /**
+     Registers a block to be called each time the results collection changes, delivering changes no
+     more often than once per `minimumInterval`.
+
+     This behaves like `observe(keyPaths:on:_:)`, except that changes which occur less than
+     `minimumInterval` seconds after the previous call to the block are merged together and
+     delivered as a single `.update` once the interval has elapsed. The `.initial`
+     notification and errors are always delivered immediately.
+
+     If `queue` is `nil`, delayed notifications are delivered via the current thread's run loop.
+
+     - warning: This method cannot be called during a write transaction, or when the containing Realm is read-only.
+     - parameter keyPaths: Only properties contained in the key paths array will trigger
+                           the block when they are modified. If `nil`, notifications
+                           will be delivered for any property change on the object.
+     - parameter queue: The serial dispatch queue to receive notification on. If
+                        `nil`, notifications are delivered to the current thread.
+     - parameter minimumInterval: The minimum time in seconds between calls to the block.
+     - parameter block: The block to be called whenever a change occurs.
+     - returns: A token which must be held for as long as you want updates to be delivered.
+     */
+    public func observe(keyPaths: [String]? = nil,
+                        on queue: DispatchQueue? = nil,
+                        minimumInterval: TimeInterval,
+                        _ block: @escaping (RealmCollectionChange<Results>) -> Void) -> NotificationToken {
+        return rlmResults.addNotificationBlock(wrapObserveBlock(block), keyPaths: keyPaths,
+                                              queue: queue, minimumInterval: minimumInterval)
+    }
+
     // MARK: Frozen Objects
 
     public var isFrozen: Bool {
@@ -681,6 +726,379 @@ extension Results: Encodable where Element: Encodable {
     }
 }
 
+// MARK: Windows
+
+extension Results where Element: ObjectBase {
+    /**
+     Returns a window of at most `limit` objects from the results, starting after the given object.
+
+     This is intended for paginating over very large sorted results. Pass `nil` to get the first
+     page, and then the last object of each page to get the next one. The next page is found by
+     filtering on the values of the object's sort properties rather than by its position in the
+     fully sorted results, so each page only sorts and observes the objects which come after it.
+
+     - warning: Continuing after an object requires the results to have been sorted with
+                `sorted(byKeyPath:ascending:)` or `sorted(by:)`, and string sort properties are not
+                supported.
+
+     - parameter object: The last object of the previous window, or `nil` for the first window.
+     - parameter limit: The maximum number of objects in the window.
+     */
+    public func windowed(after object: Element?, limit: Int) -> Results<Element> {
+        return Results<Element>(rlmResults.windowed(from: object, limit: UInt(limit)))
+    }
+}
+
+// MARK: Grouped Aggregates
+
+/**
+ The result of grouping `Results` with `grouped(by:aggregating:)`.
+
+ Each group's values are stored at the same index in each of the arrays, with the
+ groups in the order that their keys first appear in the results.
+ */
+public struct GroupedAggregates<Key: RealmCollectionValue, Value: AddableType & MinMaxType> {
+    /// The distinct values of the grouping key path.
+    public let keys: [Key]
+    /// The number of objects in each group.
+    public let counts: [Int]
+    /// The minimum value of the aggregated property in each group, or `nil` if the group has no non-`nil` values.
+    public let minimums: [Value?]
+    /// The maximum value of the aggregated property in each group, or `nil` if the group has no non-`nil` values.
+    public let maximums: [Value?]
+    /// The sum of the aggregated property in each group.
+    public let sums: [Value]
+    /// The average value of the aggregated property in each group, or `nil` if the group has no non-`nil` values.
+    ///
+    /// Averages of integer properties are not truncated. Averages of `Decimal128` properties are converted to
+    /// `Double`, and so may lose precision; use `decimalAverages` for their exact values.
+    public let averages: [Double?]
+    /// The average value of the aggregated property in each group as a `Decimal128`, or `nil` if the group has no
+    /// non-`nil` values. This is exact for `Decimal128` properties.
+    public let decimalAverages: [Decimal128?]
+
+    internal init(_ groups: RLMGroupedAggregates) {
+        keys = groups.keys.map { dynamicBridgeCast(fromObjectiveC: $0) }
+        counts = groups.counts.map { $0.intValue }
+        minimums = groups.minimums.map(GroupedAggregates.optionalValue)
+        maximums = groups.maximums.map(GroupedAggregates.optionalValue)
+        sums = groups.sums.map { dynamicBridgeCast(fromObjectiveC: $0) }
+        averages = groups.averages.map(GroupedAggregates.doubleValue)
+        decimalAverages = groups.averages.map(GroupedAggregates.decimalValue)
+    }
+
+    private static func optionalValue(_ value: Any) -> Value? {
+        return value is NSNull ? nil : dynamicBridgeCast(fromObjectiveC: value)
+    }
+
+    // Averages are NSNumbers holding a double, or decimals for Decimal128 properties
+    private static func doubleValue(_ value: Any) -> Double? {
+        switch value {
+        case let number as NSNumber:
+            return number.doubleValue
+        case let decimal as RLMDecimal128:
+            return decimal.doubleValue
+        default:
+            return nil
+        }
+    }
+
+    private static func decimalValue(_ value: Any) -> Decimal128? {
+        switch value {
+        case let number as NSNumber:
+            return Decimal128(number: number)
+        case is RLMDecimal128:
+            return dynamicBridgeCast(fromObjectiveC: value) as Decimal128
+        default:
+            return nil
+        }
+    }
+}
+
+extension Results {
+    /**
+     Groups the results by the value of the given key path and calculates the count of each
+     group, along with the minimum, maximum, sum and average of `property` within each group.
+
+     All of the groups are calculated in a single pass over the results.
+
+     - parameter keyPath: The property, or key path through to-one links, whose value determines
+                          which group each object belongs to.
+     - parameter property: The property, or key path through to-one links, whose values should be
+                           aggregated within each group.
+     */
+    public func grouped<Key: RealmCollectionValue, Value: AddableType & MinMaxType>(
+            by keyPath: String, aggregating property: String) -> GroupedAggregates<Key, Value> {
+        return GroupedAggregates(rlmResults.grouped(by: keyPath, aggregating: property))
+    }
+
+    /**
+     Groups the results by the value of the given key path and returns the number of objects in
+     each group, in the order that each key first appears in the results.
+
+     - parameter keyPath: The property, or key path through to-one links, whose value determines
+                          which group each object belongs to.
+     */
+    public func grouped<Key: RealmCollectionValue>(by keyPath: String) -> [(key: Key, count: Int)] {
+        let groups = rlmResults.grouped(by: keyPath, aggregating: nil)
+        return zip(groups.keys, groups.counts).map { (dynamicBridgeCast(fromObjectiveC: $0), $1.intValue) }
+    }
+
+    /**
+     Registers a block to be called with the grouped aggregates of the results each time
+     they change.
+
+     The block is called asynchronously with the initial aggregates, and then again after
+     each write transaction which changes any of the counts or aggregated values. The
+     aggregates are updated from the changes to the results rather than being recalculated,
+     so only the objects which were inserted, deleted or modified are read.
+
+     Groups are in the order that their keys were first seen, and groups which no longer
+     contain any objects are omitted.
+
+     - parameter keyPath: The property, or key path through to-one links, whose value determines
+                          which group each object belongs to.
+     - parameter property: The property, or key path through to-one links, whose values should be
+                           aggregated within each group.
+     - parameter queue: The serial dispatch queue to receive notification on. If
+                        `nil`, notifications are delivered to the current thread.
+     - parameter block: The block to be called whenever the aggregates change.
+     - returns: A token which must be held for as long as you want updates to be delivered.
+     */
+    public func observe<Key: RealmCollectionValue, Value: AddableType & MinMaxType>(
+            groupedBy keyPath: String, aggregating property: String, on queue: DispatchQueue? = nil,
+            _ block: @escaping (Result<GroupedAggregates<Key, Value>, Error>) -> Void) -> NotificationToken {
+        return rlmResults.addGroupedAggregatesNotificationBlock({ groups, error in
+            if let groups = groups {
+                block(.success(GroupedAggregates(groups)))
+            } else {
+                block(.failure(error!))
+            }
+        }, groupedBy: keyPath, aggregating: property, queue: queue)
+    }
+}
+
+extension Results where Element: ObjectBase {
+    /**
+     Groups the results by the value of the given key path and calculates the count of each
+     group, along with the minimum, maximum, sum and average of `property` within each group.
+
+     - parameter keyPath: The key path whose value determines which group each object belongs to.
+     - parameter property: The key path whose values should be aggregated within each group.
+     */
+    public func grouped<Key: RealmCollectionValue, Value: AddableType & MinMaxType>(
+            by keyPath: KeyPath<Element, Key>, aggregating property: KeyPath<Element, Value>) -> GroupedAggregates<Key, Value> {
+        return grouped(by: _name(for: keyPath), aggregating: _name(for: property))
+    }
+
+    /**
+     Groups the results by the value of the given key path and returns the number of objects in
+     each group, in the order that each key first appears in the results.
+
+     - parameter keyPath: The key path whose value determines which group each object belongs to.
+     */
+    public func grouped<Key: RealmCollectionValue>(by keyPath: KeyPath<Element, Key>) -> [(key: Key, count: Int)] {
+        return grouped(by: _name(for: keyPath))
+    }
+
+    /**
+     Registers a block to be called with the grouped aggregates of the results each time
+     they change. See `observe(groupedBy:aggregating:on:_:)`.
+
+     - parameter keyPath: The key path whose value determines which group each object belongs to.
+     - parameter property: The key path whose values should be aggregated within each group.
+     - parameter queue: The serial dispatch queue to receive notification on. If
+                        `nil`, notifications are delivered to the current thread.
+     - parameter block: The block to be called whenever the aggregates change.
+     - returns: A token which must be held for as long as you want updates to be delivered.
+     */
+    public func observe<Key: RealmCollectionValue, Value: AddableType & MinMaxType>(
+            groupedBy keyPath: KeyPath<Element, Key>, aggregating property: KeyPath<Element, Value>,
+            on queue: DispatchQueue? = nil,
+            _ block: @escaping (Result<GroupedAggregates<Key, Value>, Error>) -> Void) -> NotificationToken {
+        return observe(groupedBy: _name(for: keyPath), aggregating: _name(for: property), on: queue, block)
+    }
+}
+
+// MARK: Exporting
+
+extension Results where Element: ObjectBase {
+    /**
+     Writes the objects in the results to an output stream as JSON Lines: one JSON object per line.
+
+     Values are read directly from the database and written in batches, without creating an accessor
+     object for each object or holding all of the output in memory. Link and `AnyRealmValue` properties
+     are not written. The output can be read back with `Realm.create(_:fromJSONLines:)`.
+
+     - parameter stream: An open stream to write the objects to.
+
+     - throws: An `NSError` if the stream could not be written to.
+     */
+    public func writeJSONLines(to stream: OutputStream) throws {
+        try rlmResults.writeJSONLines(to: stream)
+    }
+}
+
+// MARK: Packed Values
+
+extension Results where Element: ObjectBase {
+    /**
+     Returns the values of the given `Double` property for every object in the results.
+
+     This reads the values directly from the underlying column without creating an
+     accessor object for each element.
+
+     - parameter keyPath: The property whose values are desired.
+     */
+    public func values(for keyPath: KeyPath<Element, Double>) -> [Double] {
+        return packedValues(of: _name(for: keyPath), as: Double.self)
+    }
+
+    /**
+     Returns the values of the given `Int` property for every object in the results.
+
+     This reads the values directly from the underlying column without creating an
+     accessor object for each element.
+
+     - parameter keyPath: The property whose values are desired.
+     */
+    public func values(for keyPath: KeyPath<Element, Int>) -> [Int] {
+        return packedValues(of: _name(for: keyPath), as: Int64.self).map { Int($0) }
+    }
+
+    /**
+     Returns the values of the given `Date` property for every object in the results as
+     the number of seconds since 1970.
+
+     This reads the values directly from the underlying column without creating an
+     accessor object or a `Date` for each element.
+
+     - parameter keyPath: The property whose values are desired.
+     */
+    public func timeIntervals(for keyPath: KeyPath<Element, Date>) -> [TimeInterval] {
+        return packedValues(of: _name(for: keyPath), as: Int64.self).map { TimeInterval($0) / 1_000_000_000 }
+    }
+
+    private func packedValues<T>(of property: String, as type: T.Type) -> [T] {
+        let data = rlmResults.packedValues(ofProperty: property)
+        return data.withUnsafeBytes { Array($0.bindMemory(to: T.self)) }
+    }
+}
+
+// MARK: Transient Enumeration
+
+extension Results where Element: ObjectBase {
+    /**
+     Calls the given closure on each object in the results, reusing a single object
+     accessor for every element.
+
+     This performs no per-element allocations and is intended for read-only scans
+     over very large results.
+
+     - warning: The object passed to `body` is only valid until `body` returns. Do
+       not store it or compare it to other objects.
+
+     - parameter body: A closure that takes an object of the results as a parameter.
+     */
+    public func forEachTransient(_ body: (Element) -> Void) {
+        rlmResults.enumerate(withReusedAccessor: { object, _ in
+            body(unsafeDowncast(object as AnyObject, to: Element.self))
+        })
+    }
+
+    /**
+     Returns an array containing the result of calling the given closure on each
+     object in the results, reusing a single object accessor for every element.
+
+     This is intended for copying the values needed to display a large number of
+     objects into plain Swift values, such as structs:
+
+     ```swift
+     struct Row { let name: String; let age: Int }
+     let rows = realm.objects(Person.self).project(into: Row.self) {
+         Row(name: $0.name, age: $0.age)
+     }
+     ```
+
+     No `Object` instance is created for each element, so the only allocations
+     are the ones performed by `transform` and the returned array.
+
+     - warning: The object passed to `transform` is only valid until `transform`
+       returns. Do not store it or compare it to other objects.
+
+     - parameter rowType: The type of value to project each object into.
+     - parameter transform: A closure which reads the values it needs from an object.
+     */
+    public func project<Row>(into rowType: Row.Type = Row.self, _ transform: (Element) -> Row) -> [Row] {
+        var rows = [Row]()
+        rows.reserveCapacity(count)
+        forEachTransient { rows.append(transform($0)) }
+        return rows
+    }
+}
+
+// MARK: Concurrent Enumeration
+
+extension Results where Element: ObjectBase {
+    /**
+     Calls the given closure on each object in the results, splitting the work across
+     multiple threads.
+
+     The results are divided into chunks which are processed in parallel, so `body` is
+     called concurrently from several threads and in no particular order. This is
+     intended for CPU-heavy processing of large results.
+
+     - warning: This can only be called on frozen results. See `freeze()`.
+
+     - parameter body: A closure that takes an object of the results as a parameter.
+     */
+    public func concurrentForEach(_ body: (Element) -> Void) {
+        rlmResults.enumerateObjects(options: .concurrent) { object, _, _ in
+            body(unsafeDowncast(object as AnyObject, to: Element.self))
+        }
+    }
+
+    /**
+     Returns an array containing the result of calling the given closure on each
+     object in the results, splitting the work across multiple threads.
+
+     `transform` is called concurrently from several threads, but the returned array
+     is in the same order as the results. A reduction over the results can be
+     performed by reducing the returned array.
+
+     - warning: This can only be called on frozen results. See `freeze()`.
+
+     - parameter transform: A closure which maps an object to a value.
+     */
+    public func concurrentMap<T>(_ transform: (Element) -> T) -> [T] {
+        var values = [T?](repeating: nil, count: count)
+        values.withUnsafeMutableBufferPointer { buffer in
+            rlmResults.enumerateObjects(options: .concurrent) { object, index, _ in
+                // Each index is written by exactly one thread
+                buffer[Int(index)] = transform(unsafeDowncast(object as AnyObject, to: Element.self))
+            }
+        }
+        return values.compactMap { $0 }
+    }
+
+    /**
+     Evaluates the query for these frozen results using multiple threads, and returns
+     the matching objects in order.
+
+     The objects of the type are split into ranges which are filtered in parallel. This
+     can be much faster than evaluating the query on a single thread when a large number
+     of objects have to be checked by a predicate which cannot use an index. Sorted or
+     distinct results are evaluated on the calling thread instead.
+
+     - warning: This can only be called on frozen results. See `freeze()`.
+     */
+    public func evaluateConcurrently() -> [Element] {
+        return rlmResults.objectsByEvaluatingConcurrently().map {
+            unsafeDowncast($0 as AnyObject, to: Element.self)
+        }
+    }
+}
+
 // MARK: KeyPath Distinct
 
 extension Results where Element: ObjectBase {
@@ -694,3 +1112,49 @@ extension Results where Element: ObjectBase {
             return Results<Element>(rlmResults.distinctResults(usingKeyPaths: keyPaths.map(_name(for:))))
     }
 }
+
+// MARK: Prepared Queries
+
+/**
+ A query on a single object type which is parsed once and then run repeatedly
+ with different arguments.
+
+ The predicate format uses `$0`, `$1`, etc. as placeholders for the arguments,
+ which are supplied each time the query is run.
+
+ ```swift
+ let adults = PreparedQuery<Person>("age >= $0 AND name BEGINSWITH $1")
+ let results = adults.results(in: realm, 18, "J")
+ ```
+
+ Prepared queries are not tied to any specific Realm and can be used from any
+ thread.
+ */
+public struct PreparedQuery<Element: Object> {
+    internal let rlmQuery: RLMPreparedQuery
+
+    /// The number of arguments which must be supplied when running the query.
+    public var numberOfArguments: Int {
+        return Int(rlmQuery.numberOfArguments)
+    }
+
+    /**
+     Creates a prepared query on objects of type `Element`.
+
+     - parameter predicateFormat: A predicate format string, using `$0`, `$1`, etc.
+                                  for the arguments of the query.
+     */
+    public init(_ predicateFormat: String) {
+        rlmQuery = RLMPreparedQuery(className: Element.className(), predicateFormat: predicateFormat)
+    }
+
+    /**
+     Runs the query in the given Realm.
+
+     - parameter realm: The Realm to query.
+     - parameter args:  The values to use for each placeholder, in order.
+     */
+    public func results(in realm: Realm, _ args: Any...) -> Results<Element> {
+        return Results(rlmQuery.results(in: realm.rlmRealm, withArguments: unwrapOptionals(in: args)))
+    }
+}
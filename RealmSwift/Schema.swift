@@ -61,6 +61,29 @@ import Realm
     }
 }
 
+// MARK: Registration
+
+extension Schema {
+    /**
+     Registers the complete list of `Object` and `EmbeddedObject` subclasses used by the app.
+
+     By default, the first time a Realm is opened without `Realm.Configuration.objectTypes`
+     set, every class in the process is inspected to find the Realm model classes, which can
+     take a noticeable amount of time in apps which link a very large number of classes.
+     Registering the model types up front (for example with a list generated as part of the
+     build) skips this scan, and configurations with `objectTypes` set are then required to
+     only use registered types.
+
+     This must be called before any Realm is opened or any Realm object is created, and may be
+     called at most once.
+
+     - parameter types: The types which make up the app's default schema.
+     */
+    public static func registerObjectTypes(_ types: [ObjectBase.Type]) {
+        RLMSchema.registerObjectClasses(types)
+    }
+}
+
 // MARK: Equatable
 
 extension Schema: Equatable {
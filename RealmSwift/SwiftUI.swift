@@ -35,6 +35,143 @@ private func safeWrite<Value>(_ value: Value, _ block: (Value) -> Void) where Va
     }
 }
 
+// MARK: Binding Writes
+
+/// How changes made through SwiftUI bindings to the properties of managed
+/// objects are written to the Realm.
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0, *)
+public enum BindingWriteMode {
+    /// Each change is written in its own write transaction. This is the default.
+    case immediate
+    /// Changes are held in memory and written together in a single write
+    /// transaction once no change has been made through a binding for the
+    /// given number of seconds, or when `Realm.commitPendingBindingWrites()` is
+    /// called. Bindings read back the values which are waiting to be written,
+    /// so views show a change as soon as it is made, but it isn't visible to
+    /// anything else reading the Realm until it is written.
+    ///
+    /// Only changes made on the main thread are coalesced.
+    case coalesced(interval: TimeInterval)
+}
+
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0, *)
+extension Realm {
+    /// How changes made through SwiftUI bindings to the properties of managed
+    /// objects are written. Set this to `.coalesced(interval:)` to avoid
+    /// committing a write transaction for every keystroke in a `TextField`.
+    public static var bindingWriteMode: BindingWriteMode = .immediate
+
+    /// Immediately writes any changes made through bindings which are waiting
+    /// to be written because `bindingWriteMode` is `.coalesced(interval:)`, such
+    /// as when a `TextField` finishes editing or the app moves to the background.
+    public static func commitPendingBindingWrites() {
+        BindingWriteBuffer.shared.commit()
+    }
+}
+
+/// The changes made through bindings which have not yet been written when
+/// `Realm.bindingWriteMode` is `.coalesced(interval:)`. Only used on the
+/// main thread.
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0, *)
+private final class BindingWriteBuffer {
+    static let shared = BindingWriteBuffer()
+
+    /// A property of a managed object. Bindings create their own thawed copies
+    /// of the objects, so objects are identified by their Realm, type and key
+    /// rather than by the accessor instance.
+    struct Key: Hashable {
+        let realmPath: String
+        let className: String
+        let objectKey: UInt64
+        let keyPath: AnyKeyPath
+
+        init?<T>(_ value: T, _ keyPath: AnyKeyPath) {
+            guard let object = value as? ObjectBase, !object.isInvalidated,
+                  let realm = RLMObjectBaseRealm(object), let schema = RLMObjectBaseObjectSchema(object) else {
+                return nil
+            }
+            realmPath = realm.configuration.pathOnDisk
+            className = schema.className
+            objectKey = RLMObjectBaseGetCombineId(object)
+            self.keyPath = keyPath
+        }
+    }
+
+    private struct PendingWrite {
+        let value: Any
+        let realm: Realm
+        let write: () -> Void
+    }
+
+    private var writes = [Key: PendingWrite]()
+    private var timer: Timer?
+
+    func pendingValue<V>(for key: @autoclosure () -> Key?) -> V? {
+        guard !writes.isEmpty, let key = key() else { return nil }
+        return writes[key]?.value as? V
+    }
+
+    func add<T: ThreadConfined, V>(_ newValue: V, to object: T, keyPath: ReferenceWritableKeyPath<T, V>,
+                                   key: Key, interval: TimeInterval) {
+        writes[key] = PendingWrite(value: newValue, realm: object.realm!) {
+            guard !object.isInvalidated else { return }
+            object[keyPath: keyPath] = newValue
+        }
+        timer?.invalidate()
+        timer = Timer.scheduledTimer(withTimeInterval: interval, repeats: false) { [weak self] _ in
+            self?.commit()
+        }
+    }
+
+    func commit() {
+        timer?.invalidate()
+        timer = nil
+        guard !writes.isEmpty else { return }
+        let pending = writes
+        writes.removeAll()
+
+        var byRealm = [String: [PendingWrite]]()
+        for (key, write) in pending {
+            byRealm[key.realmPath, default: []].append(write)
+        }
+        for writes in byRealm.values {
+            let realm = writes[0].realm
+            if realm.isInWriteTransaction {
+                writes.forEach { $0.write() }
+            } else {
+                try! realm.write {
+                    writes.forEach { $0.write() }
+                }
+            }
+        }
+    }
+}
+
+/// Read the value of a bound property, including a change made through a
+/// binding which hasn't been written yet.
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0, *)
+private func bindingValue<T: ThreadConfined, V>(_ value: T, _ keyPath: ReferenceWritableKeyPath<T, V>) -> V {
+    if let pending: V = BindingWriteBuffer.shared.pendingValue(for: .init(value, keyPath)) {
+        return pending
+    }
+    return value[keyPath: keyPath]
+}
+
+/// Write a change made through a binding, either immediately or as part of
+/// a later coalesced write depending on `Realm.bindingWriteMode`.
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0, *)
+private func bindingWrite<T: ThreadConfined, V>(_ newValue: V, to value: T,
+                                                 keyPath: ReferenceWritableKeyPath<T, V>) {
+    if case let .coalesced(interval) = Realm.bindingWriteMode, Thread.isMainThread,
+       let key = BindingWriteBuffer.Key(value, keyPath) {
+        BindingWriteBuffer.shared.add(newValue, to: value, keyPath: keyPath, key: key, interval: interval)
+        return
+    }
+    safeWrite(value) { value in
+        value[keyPath: keyPath] = newValue
+    }
+}
+
 @available(iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0, *)
 private func createBinding<T: ThreadConfined, V>(
     _ value: T,
@@ -46,16 +183,14 @@ private func createBinding<T: ThreadConfined, V>(
 
     // store last known value outside of the binding so that we can reference it if the parent
     // is invalidated
-    var lastValue = value[keyPath: keyPath]
+    var lastValue = bindingValue(value, keyPath)
     return Binding(get: {
         guard !value.isInvalidated else { return lastValue }
-        lastValue = value[keyPath: keyPath]
+        lastValue = bindingValue(value, keyPath)
         return lastValue
     }, set: { newValue in
         guard !value.isInvalidated else { return }
-        safeWrite(value) { value in
-            value[keyPath: keyPath] = newValue
-        }
+        bindingWrite(newValue, to: value, keyPath: keyPath)
     })
 }
 
@@ -93,17 +228,15 @@ private func createEquatableBinding<T: ThreadConfined, V: Equatable>(
         throwRealmException("Could not bind value")
     }
 
-    var lastValue = value[keyPath: keyPath]
+    var lastValue = bindingValue(value, keyPath)
     return Binding(get: {
         guard !value.isInvalidated else { return lastValue }
-        lastValue = value[keyPath: keyPath]
+        lastValue = bindingValue(value, keyPath)
         return lastValue
     }, set: { newValue in
         guard !value.isInvalidated else { return }
-        guard value[keyPath: keyPath] != newValue else { return }
-        safeWrite(value) { value in
-            value[keyPath: keyPath] = newValue
-        }
+        guard bindingValue(value, keyPath) != newValue else { return }
+        bindingWrite(newValue, to: value, keyPath: keyPath)
     })
 }
 
@@ -117,10 +250,19 @@ private func createEquatableBinding<T: ThreadConfined, V: Equatable>(
     fileprivate static var observedObjects = [NSObject: SwiftUIKVO.Subscription]()
 
     @available(iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0, *)
-    struct Subscription: Combine.Subscription {
-        let observer: NSObject
+    final class Subscription: Combine.Subscription {
+        let observer: SwiftUIKVO
         let value: NSObject
         let keyPaths: [String]
+        /// The object notification used once the object has been added to a Realm.
+        private var token: NotificationToken?
+        private var isCancelled = false
+
+        init(observer: SwiftUIKVO, value: NSObject, keyPaths: [String]) {
+            self.observer = observer
+            self.value = value
+            self.keyPaths = keyPaths
+        }
 
         var combineIdentifier: CombineIdentifier {
             CombineIdentifier(value)
@@ -131,11 +273,14 @@ private func createEquatableBinding<T: ThreadConfined, V: Equatable>(
 
         func cancel() {
             removeObservers()
+            isCancelled = true
+            token?.invalidate()
+            token = nil
             SwiftUIKVO.observedObjects.removeValue(forKey: value)
         }
 
         fileprivate func removeObservers() {
-            guard SwiftUIKVO.observedObjects.keys.contains(value) else {
+            guard token == nil, SwiftUIKVO.observedObjects.keys.contains(value) else {
                 return
             }
             keyPaths.forEach {
@@ -144,15 +289,43 @@ private func createEquatableBinding<T: ThreadConfined, V: Equatable>(
         }
 
         fileprivate func addObservers() {
-            guard SwiftUIKVO.observedObjects.keys.contains(value) else {
+            guard token == nil, SwiftUIKVO.observedObjects.keys.contains(value) else {
+                return
+            }
+            // Once the object has been added to a Realm it's observed with an
+            // object notification rather than KVO, as KVO on a managed
+            // object makes every write transaction track changes to it
+            if let object = value as? ObjectBase, let realm = RLMObjectBaseRealm(object), Thread.isMainThread {
+                observeManaged(object, realm: realm)
                 return
             }
             keyPaths.forEach {
                 value.addObserver(observer, forKeyPath: $0, options: .init(), context: nil)
             }
         }
+
+        private func observeManaged(_ object: ObjectBase, realm: RLMRealm) {
+            guard !isCancelled, token == nil, !object.isInvalidated else {
+                return
+            }
+            // Notifications can't be registered inside the write transaction
+            // which added the object, so wait for it to finish
+            if realm.inWriteTransaction {
+                DispatchQueue.main.async { [weak self] in
+                    self?.observeManaged(object, realm: realm)
+                }
+                return
+            }
+            let observer = self.observer
+            token = observeManagedObject(object, realm: realm, keyPaths: nil) {
+                observer.receive()
+            }
+            // Changes made in the write transaction which added the object
+            // were committed before the notifier existed
+            observer.receive()
+        }
     }
-    private let receive: () -> Void
+    fileprivate let receive: () -> Void
 
     override func observeValue(forKeyPath keyPath: String?,
                                of object: Any?,
@@ -167,6 +340,122 @@ private func createEquatableBinding<T: ThreadConfined, V: Equatable>(
     }
 }
 
+// MARK: - SharedNotifier
+
+/// Observers of identical queries on the main thread share a single
+/// collection notifier, which forwards each change to all of them. Without
+/// this every `@ObservedResults` wrapper showing the same query would re-run
+/// that query in the background after every write.
+///
+/// The shared notifiers are only ever created, used and removed on the main
+/// thread, which is what synchronizes access to `notifiers`.
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0, *)
+private final class SharedNotifier {
+    private struct Key: Hashable {
+        let realm: ObjectIdentifier
+        let query: String
+        let keyPaths: [String]?
+    }
+    private static var notifiers = [Key: SharedNotifier]()
+
+    private let key: Key
+    private var token: NotificationToken?
+    private var subscribers = [Int: () -> Void]()
+    private var nextSubscriberId = 0
+
+    private init(_ key: Key) {
+        self.key = key
+    }
+
+    static func observe<T: RealmSubscribable & ThreadConfined>(_ value: T, query: String, keyPaths: [String]?,
+                                                               _ block: @escaping () -> Void) -> NotificationToken {
+        return observe(value, realm: value.realm!.rlmRealm, query: query, keyPaths: keyPaths, block)
+    }
+
+    static func observe<T: RealmSubscribable>(_ value: T, realm: RLMRealm, query: String, keyPaths: [String]?,
+                                              _ block: @escaping () -> Void) -> NotificationToken {
+        let key = Key(realm: ObjectIdentifier(realm), query: query, keyPaths: keyPaths)
+        let notifier: SharedNotifier
+        if let existing = notifiers[key] {
+            notifier = existing
+        } else {
+            notifier = SharedNotifier(key)
+            notifiers[key] = notifier
+            notifier.token = value._observe(keyPaths, AnySubscriber<Void, Never>(receiveValue: { [weak notifier] in
+                notifier?.send()
+                return .unlimited
+            }))
+        }
+
+        let id = notifier.nextSubscriberId
+        notifier.nextSubscriberId += 1
+        notifier.subscribers[id] = block
+        return SharedNotifierToken(notifier, id)
+    }
+
+    private func send() {
+        subscribers.values.forEach { $0() }
+    }
+
+    fileprivate func remove(_ id: Int) {
+        subscribers.removeValue(forKey: id)
+        if subscribers.isEmpty {
+            token?.invalidate()
+            token = nil
+            SharedNotifier.notifiers.removeValue(forKey: key)
+        }
+    }
+}
+
+/// Observe a managed object with an object notification. On the main thread
+/// all observers of the same object share a single notifier, so that a list
+/// of rows each observing an object doesn't register a notifier per row.
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0, *)
+private func observeManagedObject(_ object: ObjectBase, realm: RLMRealm, keyPaths: [String]?,
+                                  _ block: @escaping () -> Void) -> NotificationToken {
+    let subscriber = AnySubscriber<Void, Never>(receiveValue: {
+        block()
+        return .unlimited
+    })
+    guard Thread.isMainThread, let schema = RLMObjectBaseObjectSchema(object) else {
+        return object._observe(keyPaths, subscriber)
+    }
+    let query = "\(schema.className) OBJECT(\(RLMObjectBaseGetCombineId(object)))"
+    return SharedNotifier.observe(object, realm: realm, query: query, keyPaths: keyPaths, block)
+}
+
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0, *)
+private final class SharedNotifierToken: NotificationToken {
+    private var notifier: SharedNotifier?
+    private let id: Int
+
+    init(_ notifier: SharedNotifier, _ id: Int) {
+        self.notifier = notifier
+        self.id = id
+    }
+
+    override func invalidate() {
+        guard let notifier = notifier else {
+            return
+        }
+        self.notifier = nil
+        // Tokens can be released on any thread, but the notifiers are confined
+        // to the main thread
+        if Thread.isMainThread {
+            notifier.remove(id)
+        } else {
+            let id = self.id
+            DispatchQueue.main.async {
+                notifier.remove(id)
+            }
+        }
+    }
+
+    deinit {
+        invalidate()
+    }
+}
+
 // MARK: - ObservableStorage
 @available(iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0, *)
 private final class ObservableStoragePublisher<ObjectType>: Publisher where ObjectType: ThreadConfined & RealmSubscribable {
@@ -176,10 +465,12 @@ private final class ObservableStoragePublisher<ObjectType>: Publisher where Obje
     private var subscribers = [AnySubscriber<Void, Never>]()
     private let value: ObjectType
     private let keyPaths: [String]?
+    private let sharedQuery: String?
 
-    init(_ value: ObjectType, _ keyPaths: [String]? = nil) {
+    init(_ value: ObjectType, _ keyPaths: [String]? = nil, sharedQuery: String? = nil) {
         self.value = value
         self.keyPaths = keyPaths
+        self.sharedQuery = sharedQuery
     }
 
     func send() {
@@ -192,8 +483,20 @@ private final class ObservableStoragePublisher<ObjectType>: Publisher where Obje
         subscribers.append(AnySubscriber(subscriber))
         if value.realm != nil && !value.isInvalidated, let value = value.thaw() {
             // This path is for cases where the object is already managed. If an
-            // unmanaged object becomes managed it will continue to use KVO.
-            let token =  value._observe(keyPaths, subscriber)
+            // unmanaged object becomes managed it switches from KVO to an
+            // object notification when it's added to the Realm.
+            let token: NotificationToken
+            if let sharedQuery = sharedQuery, Thread.isMainThread {
+                token = SharedNotifier.observe(value, query: sharedQuery, keyPaths: keyPaths) {
+                    _ = subscriber.receive()
+                }
+            } else if let object = value as? ObjectBase, let realm = value.realm {
+                token = observeManagedObject(object, realm: realm.rlmRealm, keyPaths: keyPaths) {
+                    _ = subscriber.receive()
+                }
+            } else {
+                token = value._observe(keyPaths, subscriber)
+            }
             subscriber.receive(subscription: ObservationSubscription(token: token))
         } else if let value = value as? ObjectBase, !value.isInvalidated {
             // else if the value is unmanaged
@@ -217,7 +520,7 @@ private class ObservableStorage<ObservedType>: ObservableObject where ObservedTy
         willSet {
             if newValue != value {
                 objectWillChange.send()
-                self.objectWillChange = ObservableStoragePublisher(newValue, self.keyPaths)
+                self.objectWillChange = ObservableStoragePublisher(newValue, self.keyPaths, sharedQuery: sharedQuery)
             }
         }
     }
@@ -225,6 +528,12 @@ private class ObservableStorage<ObservedType>: ObservableObject where ObservedTy
     var objectWillChange: ObservableStoragePublisher<ObservedType>
     var keyPaths: [String]?
 
+    /// A description of the query which produced `value`, if other storages
+    /// observing an identical query can share its notifier.
+    var sharedQuery: String? {
+        return nil
+    }
+
     init(_ value: ObservedType, _ keyPaths: [String]? = nil) {
         self.value = value.realm != nil && !value.isInvalidated ? value.thaw() ?? value : value
         self.objectWillChange = ObservableStoragePublisher(value, keyPaths)
@@ -343,6 +652,55 @@ private class ObservableStorage<ObservedType>: ObservableObject where ObservedTy
 
 // MARK: ObservedResults
 
+/// A change to the objects observed by an `ObservedResults` property.
+///
+/// Both the changed indexes and the identifiers of the objects are computed on a
+/// background queue, so applying the change does not require diffing the
+/// collection on the main thread. The collection in `change` is frozen at the
+/// version the change was computed against, and `ids` contains the `id` of
+/// each object in that collection in order.
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0, *)
+public struct ObservedResultsChange<ResultType> where ResultType: Object & Identifiable {
+    /// The change to the results. The collection it holds is frozen.
+    public let change: RealmCollectionChange<Results<ResultType>>
+    /// The identifiers of the objects in the results after the change, in order.
+    public let ids: [ResultType.ID]
+}
+
+private let observedResultsQueue = DispatchQueue(label: "io.realm.ObservedResults")
+
+@available(iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0, *)
+private struct ObservedResultsChangePublisher<ResultType>: Publisher where ResultType: Object & Identifiable {
+    typealias Output = ObservedResultsChange<ResultType>
+    typealias Failure = Never
+
+    let results: Results<ResultType>
+    let keyPaths: [String]?
+
+    func receive<S>(subscriber: S) where S: Subscriber, S.Failure == Never, S.Input == Output {
+        let token = results.observe(keyPaths: keyPaths, on: observedResultsQueue) { change in
+            let frozenChange: RealmCollectionChange<Results<ResultType>>
+            var ids = [ResultType.ID]()
+            switch change {
+            case .initial(let results):
+                let frozen = results.freeze()
+                ids = frozen.map(\.id)
+                frozenChange = .initial(frozen)
+            case let .update(results, deletions, insertions, modifications):
+                let frozen = results.freeze()
+                ids = frozen.map(\.id)
+                frozenChange = .update(frozen, deletions: deletions, insertions: insertions, modifications: modifications)
+            case .error(let error):
+                frozenChange = .error(error)
+            }
+            DispatchQueue.main.async {
+                _ = subscriber.receive(ObservedResultsChange(change: frozenChange, ids: ids))
+            }
+        }
+        subscriber.receive(subscription: ObservationSubscription(token: token))
+    }
+}
+
 /// A property wrapper type that retrieves results from a Realm.
 ///
 /// The results use the realm configuration provided by
@@ -360,17 +718,62 @@ private class ObservableStorage<ObservedType>: ObservableObject where ObservedTy
 
         func setupValue() {
             /// A base value to reset the state of the query if a user reassigns the `filter` or `sortDescriptor`
-            value = try! Realm(configuration: configuration ?? Realm.Configuration.defaultConfiguration).objects(ResultType.self)
+            var results = try! Realm(configuration: configuration ?? Realm.Configuration.defaultConfiguration).objects(ResultType.self)
 
             if let sortDescriptor = sortDescriptor {
-                value = value.sorted(byKeyPath: sortDescriptor.keyPath, ascending: sortDescriptor.ascending)
+                results = results.sorted(byKeyPath: sortDescriptor.keyPath, ascending: sortDescriptor.ascending)
             }
             if let filter = filter {
-                value = value.filter(filter)
+                results = results.filter(filter)
             }
+            // Assign the value only once the query is complete so that the
+            // publisher is created for the final query
+            value = results
             setupHasRun = true
         }
 
+        override var sharedQuery: String? {
+            // Predicates comparing against objects or collections can't be
+            // identified by their format string, as two different objects may
+            // have the same description.
+            if let filter = filter, !isShareable(filter) {
+                return nil
+            }
+            var query = ResultType.className()
+            if let sortDescriptor = sortDescriptor {
+                query += " SORT(\(sortDescriptor.keyPath) \(sortDescriptor.ascending ? "ASC" : "DESC"))"
+            }
+            if let filter = filter {
+                query += " WHERE \(filter.predicateFormat)"
+            }
+            return query
+        }
+
+        private func isShareable(_ predicate: NSPredicate) -> Bool {
+            if let compound = predicate as? NSCompoundPredicate {
+                return compound.subpredicates.allSatisfy { isShareable($0 as! NSPredicate) }
+            }
+            if let comparison = predicate as? NSComparisonPredicate {
+                return isShareable(comparison.leftExpression) && isShareable(comparison.rightExpression)
+            }
+            return type(of: predicate) == NSPredicate.self
+        }
+
+        private func isShareable(_ expression: NSExpression) -> Bool {
+            switch expression.expressionType {
+            case .constantValue:
+                let value = expression.constantValue
+                return value == nil || value is NSString || value is NSNumber || value is NSDate
+                    || value is NSNull || value is ObjectId || value is Decimal128 || value is NSUUID
+            case .keyPath, .evaluatedObject:
+                return true
+            case .aggregate:
+                return (expression.collection as? [NSExpression])?.allSatisfy(isShareable) ?? false
+            default:
+                return false
+            }
+        }
+
         var sortDescriptor: SortDescriptor? {
             didSet {
                 didSet()
@@ -415,6 +818,20 @@ private class ObservableStorage<ObservedType>: ObservableObject where ObservedTy
     public var projectedValue: Self {
         return self
     }
+    /// A publisher which emits the fine-grained changes to the current query on
+    /// the main thread, along with the identifiers of the objects in the results.
+    ///
+    /// Unlike the view invalidation performed by the property wrapper itself,
+    /// this can be used to apply changes directly to a diffable data source
+    /// without recomputing the difference between the old and new results.
+    /// The publisher observes the query at the time it is obtained, so a new
+    /// publisher should be obtained after changing `filter` or `sortDescriptor`.
+    public var changes: AnyPublisher<ObservedResultsChange<ResultType>, Never> {
+        if !storage.setupHasRun {
+            storage.setupValue()
+        }
+        return ObservedResultsChangePublisher(results: storage.value, keyPaths: storage.keyPaths).eraseToAnyPublisher()
+    }
     /// :nodoc:
     public init(_ type: ResultType.Type,
                 configuration: Realm.Configuration? = nil,
@@ -793,6 +1210,7 @@ private class ObservableAsyncOpenStorage: ObservableObject {
     private var app: App
     var configuration: Realm.Configuration?
     var partitionValue: AnyBSON
+    let priority: Int
 
     // Tracks User State for App for Multi-User Support
     enum AppState {
@@ -840,9 +1258,15 @@ private class ObservableAsyncOpenStorage: ObservableObject {
         // Cancel any current subscriptions to asyncOpen if there is one
         cancelAsyncOpen()
         return Realm.asyncOpen(configuration: config)
+            .priority(priority)
             .onProgressNotification { asyncProgress in
-                let progress = Progress(totalUnitCount: Int64(asyncProgress.transferredBytes))
-                progress.completedUnitCount = Int64(asyncProgress.transferredBytes)
+                // Report the bytes downloaded so far out of the bytes known to
+                // be available, so that the fraction completed grows as the
+                // download progresses. Nothing left to transfer is reported
+                // as complete, as with `fractionTransferred`.
+                let total = max(asyncProgress.transferrableBytes, asyncProgress.transferredBytes)
+                let progress = Progress(totalUnitCount: Int64(max(total, 1)))
+                progress.completedUnitCount = total == 0 ? 1 : Int64(asyncProgress.transferredBytes)
                 self.asyncOpenState = .progress(progress)
             }
             .sink { completion in
@@ -876,11 +1300,12 @@ private class ObservableAsyncOpenStorage: ObservableObject {
         appCancellable = []
     }
 
-    init(asyncOpenKind: AsyncOpenKind, app: App, configuration: Realm.Configuration?, partitionValue: AnyBSON) {
+    init(asyncOpenKind: AsyncOpenKind, app: App, configuration: Realm.Configuration?, partitionValue: AnyBSON, priority: Int = 0) {
         self.asyncOpenKind = asyncOpenKind
         self.app = app
         self.configuration = configuration
         self.partitionValue = partitionValue
+        self.priority = priority
 
         if let user = app.currentUser {
             appState = .loggedIn(user)
@@ -1006,14 +1431,19 @@ private class ObservableAsyncOpenStorage: ObservableObject {
                  if empty the user configuration will be used.
      - parameter timeout: The maximum number of milliseconds to allow for a connection to
                  become fully established., if empty or `nil` no connection timeout is set.
+     - parameter priority: The priority of the async open relative to other async opens,
+                 which determines the order queued opens are started in when
+                 `Realm.AsyncOpenTask.maximumConcurrentOpens` is set.
      */
     public init(appId: String? = nil,
                 partitionValue: Partition,
                 configuration: Realm.Configuration? = nil,
-                timeout: UInt? = nil) {
+                timeout: UInt? = nil,
+                priority: Int = 0) {
         let app = ObservableAsyncOpenStorage.configureApp(appId: appId, withTimeout: timeout)
         // Store property wrapper values on the storage
-        storage = ObservableAsyncOpenStorage(asyncOpenKind: .asyncOpen, app: app, configuration: configuration, partitionValue: AnyBSON(partitionValue))
+        storage = ObservableAsyncOpenStorage(asyncOpenKind: .asyncOpen, app: app, configuration: configuration,
+                                             partitionValue: AnyBSON(partitionValue), priority: priority)
     }
 
     public mutating func update() {
@@ -1114,14 +1544,19 @@ private class ObservableAsyncOpenStorage: ObservableObject {
                  if empty the user configuration will be used.
      - parameter timeout: The maximum number of milliseconds to allow for a connection to
                  become fully established, if empty or `nil` no connection timeout is set.
+     - parameter priority: The priority of the async open relative to other async opens,
+                 which determines the order queued opens are started in when
+                 `Realm.AsyncOpenTask.maximumConcurrentOpens` is set.
      */
     public init(appId: String? = nil,
                 partitionValue: Partition,
                 configuration: Realm.Configuration? = nil,
-                timeout: UInt? = nil) {
+                timeout: UInt? = nil,
+                priority: Int = 0) {
         let app = ObservableAsyncOpenStorage.configureApp(appId: appId, withTimeout: timeout)
         // Store property wrapper values on the storage
-        storage = ObservableAsyncOpenStorage(asyncOpenKind: .autoOpen, app: app, configuration: configuration, partitionValue: AnyBSON(partitionValue))
+        storage = ObservableAsyncOpenStorage(asyncOpenKind: .autoOpen, app: app, configuration: configuration,
+                                             partitionValue: AnyBSON(partitionValue), priority: priority)
     }
 
     public mutating func update() {
@@ -236,11 +236,22 @@ public typealias Provider = RLMIdentityProvider
      */
     public let cancelAsyncOpenOnNonFatalErrors: Bool
 
+    /**
+     The directory to store the synchronized Realm file in, or `nil` to store it in
+     the user's directory within the app's sync metadata directory.
+
+     Large Realms can be placed on a faster volume, or in the caches directory if the
+     data can be downloaded again. The name of the file is the same as it would be in
+     the default location, and the directory is created if it does not exist.
+     */
+    public var directoryURL: URL?
+
     internal init(config: RLMSyncConfiguration) {
         self.user = config.user
         self.stopPolicy = config.stopPolicy
         self.partitionValue = ObjectiveCSupport.convert(object: config.partitionValue)
         self.cancelAsyncOpenOnNonFatalErrors = config.cancelAsyncOpenOnNonFatalErrors
+        self.directoryURL = config.directoryURL
     }
 
     func asConfig() -> RLMSyncConfiguration {
@@ -248,6 +259,7 @@ public typealias Provider = RLMIdentityProvider
                                      partitionValue: partitionValue.map(ObjectiveCSupport.convertBson),
                                      stopPolicy: stopPolicy)
         c.cancelAsyncOpenOnNonFatalErrors = cancelAsyncOpenOnNonFatalErrors
+        c.directoryURL = directoryURL
         return c
     }
 }
@@ -523,6 +535,13 @@ public extension SyncSession {
      */
     typealias ProgressNotificationToken = RLMProgressNotificationToken
 
+    /**
+     A snapshot of the network activity of one or more sessions over a period of time.
+
+     - see: `RLMSyncSessionStatistics`
+     */
+    typealias Statistics = RLMSyncSessionStatistics
+
     /**
      A struct encapsulating progress information, as well as useful helper methods.
      */
@@ -602,6 +621,39 @@ public extension SyncSession {
                                                 block(Progress(transferred: transferred, transferrable: transferrable))
         }
     }
+
+    /**
+     A change in the state of a session's connection.
+     */
+    struct ConnectionStateChange {
+        /// The state the connection was in before the change.
+        public let oldState: ConnectionState
+        /// The state the connection is in after the change.
+        public let newState: ConnectionState
+        /// The number of seconds the connection spent in `oldState`, measured
+        /// from when the block was registered if the connection was already in
+        /// that state at registration.
+        public let timeInPreviousState: TimeInterval
+    }
+
+    /**
+     Register a block which is called each time the session's connection state changes.
+
+     The block is invoked on a side queue devoted to progress notifications. The
+     time spent in the disconnected and connecting states before each change to
+     `.connected` can be used to measure how long reconnecting takes.
+
+     - parameter block: The block to invoke when the connection state changes.
+
+     - returns: A token which must be held for as long as you want notifications to be
+                delivered, or `nil` if the session is no longer valid.
+     */
+    func observeConnectionState(_ block: @escaping (ConnectionStateChange) -> Void) -> NotificationToken? {
+        return __addConnectionStateChangeNotificationBlock { oldState, newState, timeInPreviousState in
+            block(ConnectionStateChange(oldState: oldState, newState: newState,
+                                        timeInPreviousState: timeInPreviousState))
+        }
+    }
 }
 
 extension Realm {
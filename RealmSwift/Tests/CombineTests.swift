@@ -319,6 +319,35 @@ class CombineObjectPublisherTests: CombinePublisherTestCase {
         wait(for: [exp], timeout: 10)
     }
 
+    func testReceiveOnCoalescesValuesWhileSchedulerIsBusy() {
+        // Block the queue so that every value arrives while it is busy
+        let blocker = DispatchSemaphore(value: 0)
+        receiveOnQueue.async { blocker.wait() }
+
+        var values = [Int]()
+        let exp = XCTestExpectation()
+        cancellable = valuePublisher(obj)
+            .receive(on: receiveOnQueue)
+            .map { $0.intCol }
+            .sink { value in
+                values.append(value)
+                if value == 10 {
+                    exp.fulfill()
+                }
+            }
+
+        for _ in 0..<10 {
+            try! realm.write { obj.intCol += 1 }
+            RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.01))
+        }
+        blocker.signal()
+        wait(for: [exp], timeout: 10)
+        receiveOnQueue.sync {
+            XCTAssertLessThan(values.count, 10)
+            XCTAssertEqual(values.last, 10)
+        }
+    }
+
     func testChangeSetSubscribeOn() {
         let sema = DispatchSemaphore(value: 0)
 
@@ -1247,6 +1276,54 @@ private class CombineCollectionPublisherTests<Collection: RealmCollection>: Comb
         wait(for: [exp], timeout: 10)
     }
 
+    func testFrozenReceiveOn() {
+        let exp = XCTestExpectation()
+        cancellable = collection.collectionPublisher
+            .freeze()
+            .receive(on: receiveOnQueue)
+            .prefix(10)
+            .collect()
+            .assertNoFailure()
+            .sink { arr in
+                for (i, collection) in arr.enumerated() {
+                    XCTAssertTrue(collection.isFrozen)
+                    XCTAssertEqual(collection.count, i)
+                }
+                exp.fulfill()
+        }
+
+        for _ in 0..<10 {
+            try! realm.write { collection.appendObject() }
+        }
+        wait(for: [exp], timeout: 10)
+    }
+
+    func testFrozenCollectionsShareRealmForVersion() {
+        let exp = XCTestExpectation()
+        exp.expectedFulfillmentCount = 2
+        var frozenRealms = [Realm]()
+        cancellable = collection.changesetPublisher
+            .freeze()
+            .sink { change in
+                if case .initial(let collection) = change {
+                    frozenRealms.append(collection.realm!)
+                    exp.fulfill()
+                }
+            }
+        let valueCancellable = collection.collectionPublisher
+            .freeze()
+            .assertNoFailure()
+            .sink { collection in
+                frozenRealms.append(collection.realm!)
+                exp.fulfill()
+            }
+        wait(for: [exp], timeout: 10)
+        valueCancellable.cancel()
+
+        XCTAssertTrue(frozenRealms.allSatisfy(\.isFrozen))
+        XCTAssertTrue(frozenRealms[0].rlmRealm === frozenRealms[1].rlmRealm)
+    }
+
     func testFrozenChangeSetSubscribeOn() {
         let sema = DispatchSemaphore(value: 0)
         cancellable = collection.changesetPublisher
@@ -97,6 +97,53 @@ class ListTests: TestCase {
         XCTAssertEqual(obj.string[0], "str")
     }
 
+    func testWithContiguousValues() {
+        let obj = SwiftListObject()
+        obj.int.append(objectsIn: [1, 2, 3])
+        obj.int64.append(objectsIn: [4, 5] as [Int64])
+        obj.double.append(objectsIn: [1.5, 2.5])
+        obj.int8.append(objectsIn: [-1, 2] as [Int8])
+        obj.int16.append(objectsIn: [300] as [Int16])
+        obj.int32.append(objectsIn: [-70_000] as [Int32])
+
+        func check() {
+            XCTAssertEqual(obj.int.withContiguousValues(Array.init), [1, 2, 3])
+            XCTAssertEqual(obj.int64.withContiguousValues(Array.init), [4, 5])
+            XCTAssertEqual(obj.double.withContiguousValues { $0.reduce(0, +) }, 4.0)
+            XCTAssertEqual(obj.int8.withContiguousValues(Array.init), [-1, 2])
+            XCTAssertEqual(obj.int16.withContiguousValues(Array.init), [300])
+            XCTAssertEqual(obj.int32.withContiguousValues(Array.init), [-70_000])
+        }
+        check()
+
+        let realm = realmWithTestPath()
+        try! realm.write {
+            realm.add(obj)
+        }
+        check()
+    }
+
+    func testAllValuesOfAnyRealmValue() {
+        let obj = ModernAllTypesObject()
+        let date = Date(timeIntervalSince1970: 1_000_000.5)
+        let objectId = ObjectId.generate()
+        let values: [AnyRealmValue] = [.int(1), .bool(true), .float(2.5), .double(3.5),
+                                       .string("ä string"), .data(Data([1, 2, 3])), .data(Data()),
+                                       .date(date), .objectId(objectId), .none]
+        obj.arrayAny.append(objectsIn: values)
+        XCTAssertEqual(obj.arrayAny.allValues(), values)
+
+        let realm = realmWithTestPath()
+        try! realm.write {
+            realm.add(obj)
+            obj.arrayAny.append(.object(obj))
+        }
+        let allValues = obj.arrayAny.allValues()
+        XCTAssertEqual(Array(allValues.prefix(values.count)), values)
+        XCTAssertEqual(allValues.last?.object(ModernAllTypesObject.self), obj)
+        XCTAssertEqual(allValues, Array(obj.arrayAny))
+    }
+
     func testPrimitiveIterationAcrossNil() {
         let obj = SwiftListObject()
         XCTAssertFalse(obj.int.contains(5))
@@ -405,6 +452,29 @@ class ListTests: TestCase {
         assertThrows(array.swapAt(0, 1000))
     }
 
+    func testApplyPermutation() {
+        guard let array = array, let str1 = str1, let str2 = str2 else {
+            fatalError("Test precondition failure")
+        }
+
+        array.append(objectsIn: [str1, str2, str1])
+
+        array.applyPermutation([1, 0, 2])
+        assertEqual(str2, array[0])
+        assertEqual(str1, array[1])
+        assertEqual(str1, array[2])
+
+        array.applyPermutation([1, 2, 0])
+        assertEqual(str1, array[0])
+        assertEqual(str1, array[1])
+        assertEqual(str2, array[2])
+
+        assertThrows(array.applyPermutation([0, 1]))
+        assertThrows(array.applyPermutation([0, 0, 1]))
+        assertThrows(array.applyPermutation([0, 1, 3]))
+        assertThrows(array.applyPermutation([0, 1, -2]))
+    }
+
     func testChangesArePersisted() {
         guard let array = array, let str1 = str1, let str2 = str2 else {
             fatalError("Test precondition failure")
@@ -505,6 +575,26 @@ class ListTests: TestCase {
         testProperty("objectIdCol") { $0.objectIdCol }
     }
 
+    func testValueForKeyCreatesListsOnAccess() {
+        let realm = try! Realm()
+        try! realm.write {
+            for value in 0..<3 {
+                let listObject = SwiftListOfSwiftObject()
+                for _ in 0..<value {
+                    listObject.array.append(SwiftObject())
+                }
+                realm.add(listObject)
+            }
+        }
+
+        let listObjects = realm.objects(SwiftListOfSwiftObject.self)
+        let lists = listObjects.value(forKey: "array") as! NSArray
+        XCTAssertEqual(lists.count, 3)
+        XCTAssertTrue(lists[1] as AnyObject === lists[1] as AnyObject)
+        XCTAssertEqual((lists.lastObject as! List<SwiftObject>).count, 2)
+        XCTAssertEqual((lists as! [List<SwiftObject>]).map { $0.count }, [0, 1, 2])
+    }
+
     @available(*, deprecated) // Silence deprecation warnings for RealmOptional
     func testValueForKeyOptional() {
         let realm = try! Realm()
@@ -654,6 +744,22 @@ class ListStandaloneTests: ListTests {
     override func createEmbeddedArray() -> List<EmbeddedTreeObject1> {
         return List<EmbeddedTreeObject1>()
     }
+
+    func testAnyRealmCollectionOfListAddedToRealm() {
+        let object = SwiftArrayPropertyObject()
+        object.intArray.append(SwiftIntObject(value: [1]))
+        let collection = AnyRealmCollection(object.intArray)
+
+        let realm = realmWithTestPath()
+        try! realm.write {
+            realm.add(object)
+            object.intArray.append(SwiftIntObject(value: [2]))
+        }
+        XCTAssertEqual(collection.count, 2)
+        XCTAssertEqual(collection[1].intCol, 2)
+        XCTAssertEqual(collection.map { $0.intCol }, [1, 2])
+        XCTAssertEqual(collection.elements(in: 0..<2).map { $0.intCol }, [1, 2])
+    }
 }
 
 class ListNewlyAddedTests: ListTests {
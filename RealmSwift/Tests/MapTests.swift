@@ -90,6 +90,29 @@ class MapTests: TestCase {
         XCTAssertEqual(obj.string["key"], "str")
     }
 
+    func testAllEntriesOfAnyRealmValue() {
+        let obj = ModernAllTypesObject()
+        let entries: [String: AnyRealmValue] = [
+            "int": .int(1), "bool": .bool(false), "float": .float(2.5), "double": .double(3.5),
+            "string": .string("ä string"), "data": .data(Data([1, 2, 3])),
+            "date": .date(Date(timeIntervalSince1970: 1_000_000.5)),
+            "objectId": .objectId(ObjectId.generate()), "none": .none
+        ]
+        for (key, value) in entries {
+            obj.mapAny[key] = value
+        }
+        XCTAssertEqual(obj.mapAny.allEntries(), entries)
+
+        let realm = realmWithTestPath()
+        try! realm.write {
+            realm.add(obj)
+            obj.mapAny["object"] = .object(obj)
+        }
+        var allEntries = obj.mapAny.allEntries()
+        XCTAssertEqual(allEntries.removeValue(forKey: "object")?.object(ModernAllTypesObject.self), obj)
+        XCTAssertEqual(allEntries, entries)
+    }
+
     func testPrimitiveIterationAcrossNil() {
         let obj = SwiftMapObject()
 
@@ -810,6 +810,31 @@ class MigrationTests: TestCase {
         }
     }
 
+    func testTransformValues() {
+        autoreleasepool {
+            let prop = RLMProperty(name: "stringCol", type: .int, objectClassName: nil,
+                linkOriginPropertyName: nil, indexed: false, optional: false)
+            autoreleasepool {
+                let realm = realmWithSingleClassProperties(defaultRealmURL(), className: "SwiftStringObject",
+                    properties: [prop])
+                try! realm.transaction {
+                    realm.createObject("SwiftStringObject", withValue: [1])
+                    realm.createObject("SwiftStringObject", withValue: [2])
+                }
+            }
+
+            migrateAndTestDefaultRealm { migration, _ in
+                migration.transformValues(ofType: "SwiftStringObject", from: "stringCol", to: "stringCol") { value in
+                    return "value \((value as! NSNumber).intValue)"
+                }
+            }
+
+            let realm = dynamicRealm(defaultRealmURL())
+            let values = realm.allObjects("SwiftStringObject").value(forKey: "stringCol") as! [String]
+            XCTAssertEqual(values, ["value 1", "value 2"])
+        }
+    }
+
     // test getting/setting all property types
     func testMigrationObject() {
         autoreleasepool {
@@ -415,6 +415,107 @@ class ObjectCreationTests: TestCase {
         XCTAssertEqual(object.objects.first!, persistedObject)
     }
 
+    func testCreateWithValues() {
+        let realm = try! Realm()
+        let standalone = SwiftPrimaryStringObject(value: ["c", 3])
+        try! realm.write {
+            realm.create(SwiftPrimaryStringObject.self, values: [["a", 1], ["stringCol": "b", "intCol": 2], standalone])
+        }
+        let objects = realm.objects(SwiftPrimaryStringObject.self).sorted(byKeyPath: "stringCol")
+        XCTAssertEqual(Array(objects.map(\.stringCol)), ["a", "b", "c"])
+        XCTAssertEqual(Array(objects.map(\.intCol)), [1, 2, 3])
+        XCTAssertNil(standalone.realm)
+
+        try! realm.write {
+            let counts = realm.create(SwiftPrimaryStringObject.self, values: [["a", 10], ["b", 2], ["d", 4]],
+                                      update: .modified)
+            XCTAssertEqual(counts.inserted, 1)
+            XCTAssertEqual(counts.updated, 1)
+            XCTAssertEqual(counts.unchanged, 1)
+        }
+        XCTAssertEqual(objects.count, 4)
+        XCTAssertEqual(realm.object(ofType: SwiftPrimaryStringObject.self, forPrimaryKey: "a")!.intCol, 10)
+    }
+
+    func testCreateWithValuesSkipsUnchangedObjects() {
+        let realm = try! Realm()
+        try! realm.write {
+            realm.create(SwiftPrimaryStringObject.self, values: [["a", 1], ["b", 2]])
+        }
+
+        let exp = expectation(description: "no change")
+        exp.isInverted = true
+        let token = realm.object(ofType: SwiftPrimaryStringObject.self, forPrimaryKey: "a")!.observe { _ in
+            exp.fulfill()
+        }
+        try! realm.write {
+            let counts = realm.create(SwiftPrimaryStringObject.self,
+                                      values: [["stringCol": "a", "intCol": 1], ["b", 3]], update: .modified)
+            XCTAssertEqual(counts.inserted, 0)
+            XCTAssertEqual(counts.updated, 1)
+            XCTAssertEqual(counts.unchanged, 1)
+        }
+        waitForExpectations(timeout: 0.1)
+        token.invalidate()
+        XCTAssertEqual(realm.object(ofType: SwiftPrimaryStringObject.self, forPrimaryKey: "b")!.intCol, 3)
+    }
+
+    func testDecodeFromJSON() throws {
+        let realm = try! Realm()
+        let json = """
+        {
+            "boolCol": true,
+            "intCol": 5,
+            "doubleCol": 1.5,
+            "stringCol": "abc",
+            "binaryCol": "AQI=",
+            "dateCol": 10,
+            "decimalCol": "1.5",
+            "objectIdCol": "abcdef0123456789abcdef01",
+            "uuidCol": "137decc8-b300-4954-a233-f89909f4fd89",
+            "objectCol": {"boolCol": true},
+            "arrayCol": [{"boolCol": true}, {"boolCol": false}],
+            "mapCol": {"a": {"boolCol": true}, "b": null},
+            "unknownKey": 1
+        }
+        """
+        let object = try realm.write {
+            try realm.decode(SwiftObject.self, from: json.data(using: .utf8)!)
+        }
+        XCTAssertTrue(object.boolCol)
+        XCTAssertEqual(object.intCol, 5)
+        XCTAssertEqual(object.doubleCol, 1.5)
+        XCTAssertEqual(object.stringCol, "abc")
+        XCTAssertEqual(object.binaryCol, Data([1, 2]))
+        XCTAssertEqual(object.dateCol, Date(timeIntervalSinceReferenceDate: 10))
+        XCTAssertEqual(object.decimalCol, Decimal128("1.5"))
+        XCTAssertEqual(object.objectIdCol, ObjectId("abcdef0123456789abcdef01"))
+        XCTAssertEqual(object.objectCol?.boolCol, true)
+        XCTAssertEqual(Array(object.arrayCol.map(\.boolCol)), [true, false])
+        XCTAssertEqual(object.mapCol.count, 2)
+        XCTAssertNil(object.mapCol["b"]!)
+        XCTAssertEqual(object.int8Col, 123)
+
+        try realm.write {
+            try realm.decodeObjects(SwiftPrimaryStringObject.self,
+                                    from: #"[{"stringCol": "a", "intCol": 1}, {"stringCol": "b", "intCol": 2}]"#.data(using: .utf8)!)
+        }
+        XCTAssertEqual(realm.objects(SwiftPrimaryStringObject.self).count, 2)
+
+        realm.beginWrite()
+        XCTAssertThrowsError(try realm.decode(SwiftObject.self, from: #"{"intCol": "abc"}"#.data(using: .utf8)!)) { error in
+            guard case DecodingError.typeMismatch(_, let context) = error else {
+                return XCTFail("Unexpected error \(error)")
+            }
+            XCTAssertEqual(context.codingPath.map(\.stringValue), ["intCol"])
+        }
+        XCTAssertThrowsError(try realm.decode(SwiftObject.self, from: #"{"arrayCol": [{"boolCol": 1}]}"#.data(using: .utf8)!))
+        XCTAssertThrowsError(try realm.decode(SwiftObject.self, from: #"{"stringCol": null}"#.data(using: .utf8)!))
+        XCTAssertThrowsError(try realm.decodeObjects(SwiftObject.self, from: "{}".data(using: .utf8)!))
+        XCTAssertThrowsError(try realm.decode(SwiftObject.self, from: "not json".data(using: .utf8)!))
+        realm.cancelWrite()
+    }
+
     func testCreateWithObjectsFromAnotherRealm() {
         let values: [String: Any] = [
             "boolCol": true,
@@ -101,4 +101,17 @@ class ObjectIdTests: TestCase {
         XCTAssertTrue(objectId <= objectId2)
         XCTAssertTrue(objectId <= objectId3)
     }
+
+    func testGenerateCount() {
+        let objectIds = ObjectId.generate(count: 100)
+        XCTAssertEqual(Set(objectIds).count, 100)
+
+        let uuids = UUID.generate(count: 100)
+        XCTAssertEqual(Set(uuids).count, 100)
+        for uuid in uuids {
+            // Version 4, RFC 4122 variant
+            XCTAssertEqual(Array(uuid.uuidString)[14], "4")
+            XCTAssertTrue("89AB".contains(Array(uuid.uuidString)[19]))
+        }
+    }
 }
@@ -462,6 +462,23 @@ class ObjectTests: TestCase {
         }
     }
 
+    func testBacklinkCount() {
+        let realm = try! Realm()
+        let dog = SwiftDogObject()
+        XCTAssertEqual(dog.backlinkCount(for: \SwiftDogObject.owners), 0)
+        try! realm.write {
+            realm.add(SwiftOwnerObject(value: ["first", dog]))
+            realm.add(SwiftOwnerObject(value: ["second", dog]))
+        }
+        XCTAssertEqual(dog.backlinkCount(forProperty: "owners"), 2)
+        XCTAssertEqual(dog.backlinkCount(for: \SwiftDogObject.owners), dog.owners.count)
+        assertThrows(dog.backlinkCount(forProperty: "dogName"),
+                     reason: "Property 'dogName' is not a linking objects property")
+
+        XCTAssertEqual(realm.objects(SwiftDogObject.self).filter("@links.@count == 2").count, 1)
+        XCTAssertEqual(realm.objects(SwiftOwnerObject.self).filter("@links.@count > 0").count, 0)
+    }
+
     func testSettingUnmanagedObjectValuesWithSwiftDictionary() {
         let json: [String: Any] = ["name": "foo", "array": [["stringCol": "bar"]], "intArray": [["intCol": 50]]]
         let object = SwiftArrayPropertyObject()
@@ -1032,6 +1049,35 @@ class ObjectTests: TestCase {
         token.invalidate()
     }
 
+    func testObserveWithoutValues() {
+        let realm = try! Realm()
+        realm.beginWrite()
+        let object = realm.create(SwiftIntObject.self, value: [1])
+        try! realm.commitWrite()
+
+        let exp = expectation(description: "change")
+        let token = object.observe(includeValues: false) { (change: ObjectChange<ObjectBase>) in
+            guard case .change(_, let properties) = change else {
+                return XCTFail("expected .change, got \(change)")
+            }
+            XCTAssertEqual(properties.count, 1)
+            XCTAssertEqual(properties[0].name, "intCol")
+            XCTAssertNil(properties[0].oldValue)
+            XCTAssertNil(properties[0].newValue)
+            exp.fulfill()
+        }
+        dispatchSyncNewThread {
+            let realm = try! Realm()
+            try! realm.write {
+                realm.objects(SwiftIntObject.self).first!.intCol = 2
+            }
+        }
+
+        realm.refresh()
+        waitForExpectations(timeout: 0)
+        token.invalidate()
+    }
+
     func testModifyObservedKeyPathRemotely() {
         let realm = try! Realm()
         realm.beginWrite()
@@ -1914,4 +1960,25 @@ class ObjectTests: TestCase {
         XCTAssertFalse(frozen.thaw()!.boolCol)
         XCTAssertFalse(thawed.boolCol)
     }
+
+    @available(*, deprecated) // Silence deprecation warnings for RealmOptional
+    func testWithUnsafeBytes() {
+        let realm = try! Realm()
+        let obj = try! realm.write {
+            realm.create(SwiftOptionalObject.self, value: ["optStringCol": "string",
+                                                           "optBinaryCol": Data([1, 2, 3])])
+        }
+
+        XCTAssertEqual(obj.withUnsafeBytes(for: \SwiftOptionalObject.optBinaryCol) { Data($0) }, Data([1, 2, 3]))
+        XCTAssertEqual(obj.withUnsafeBytes(forProperty: "optStringCol") { String(decoding: $0, as: UTF8.self) },
+                       "string")
+        XCTAssertEqual(obj.withUnsafeBytes(forProperty: "optNSStringCol") { $0.count }, 0)
+        XCTAssertEqual(SwiftOptionalObject().withUnsafeBytes(forProperty: "optBinaryCol") { $0.count }, 0)
+
+        assertThrows(obj.withUnsafeBytes(forProperty: "optDateCol") { $0.count },
+                     reason: "must be a data or string property")
+
+        // The bytes are read from the live object without freezing it
+        XCTAssertFalse(Realm.versionPins().contains { $0.isFrozen })
+    }
 }
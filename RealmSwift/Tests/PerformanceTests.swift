@@ -17,8 +17,13 @@
 ////////////////////////////////////////////////////////////////////////////
 
 import XCTest
+import Realm.Private
 import RealmSwift
 
+#if canImport(RealmTestSupport)
+import RealmTestSupport
+#endif
+
 private func createStringObjects(_ factor: Int) -> Realm {
     let realm = inMemoryRealm(factor.description)
     try! realm.write {
@@ -69,7 +74,20 @@ class SwiftPerformanceTests: TestCase {
         // Do nothing, as we need to keep our in-memory realms around between tests
     }
 
+    // The benchmark currently being run in benchmark runner mode
+    private var benchmark: RLMBenchmark?
+
+    private func runBenchmark(automaticallyStartMeasuring: Bool, _ block: () -> Void) {
+        let benchmark = RLMBenchmark(testCase: self)
+        self.benchmark = benchmark
+        benchmark.measure(block, automaticallyStartMeasuring: automaticallyStartMeasuring)
+        self.benchmark = nil
+    }
+
     override func measure(_ block: (() -> Void)) {
+        if RLMBenchmark.isEnabled {
+            return runBenchmark(automaticallyStartMeasuring: true, block)
+        }
         super.measure {
             autoreleasepool {
                 block()
@@ -78,6 +96,9 @@ class SwiftPerformanceTests: TestCase {
     }
 
     override func measureMetrics(_ metrics: [XCTPerformanceMetric], automaticallyStartMeasuring: Bool, for block: () -> Void) {
+        if RLMBenchmark.isEnabled {
+            return runBenchmark(automaticallyStartMeasuring: automaticallyStartMeasuring, block)
+        }
         super.measureMetrics(metrics, automaticallyStartMeasuring: automaticallyStartMeasuring) {
             autoreleasepool {
                 block()
@@ -85,6 +106,22 @@ class SwiftPerformanceTests: TestCase {
         }
     }
 
+    override func startMeasuring() {
+        if let benchmark = benchmark {
+            benchmark.startMeasuring()
+        } else {
+            super.startMeasuring()
+        }
+    }
+
+    override func stopMeasuring() {
+        if let benchmark = benchmark {
+            benchmark.stopMeasuring()
+        } else {
+            super.stopMeasuring()
+        }
+    }
+
     func inMeasureBlock(block: () -> Void) {
         measureMetrics(type(of: self).defaultPerformanceMetrics, automaticallyStartMeasuring: false) {
             _ = block()
@@ -158,6 +195,16 @@ class SwiftPerformanceTests: TestCase {
         }
     }
 
+    func testCountWhereQueryBuilder() {
+        let realm = copyRealmToTestPath(largeRealm)
+        measure {
+            for _ in 0..<500 {
+                let results = realm.objects(SwiftStringObject.self).where { $0.stringCol == "a" }
+                _ = results.count
+            }
+        }
+    }
+
     func testCountWhereTableView() {
         let realm = copyRealmToTestPath(mediumRealm)
         measure {
@@ -207,6 +254,22 @@ class SwiftPerformanceTests: TestCase {
         }
     }
 
+    func testEnumerateAndAccessRealmProperty() {
+        let realm = realmWithTestPath()
+        try! realm.write {
+            for i in 0..<10_000 {
+                let obj = realm.create(SwiftOptionalObject.self)
+                obj.otherIntCol.value = i
+            }
+        }
+        let objects = Array(realm.objects(SwiftOptionalObject.self))
+        measure {
+            for obj in objects {
+                _ = obj.otherIntCol.value
+            }
+        }
+    }
+
     func testEnumerateAndAccessAllSlowInts() {
         let realm = copyRealmToTestPath(largeRealm)
         measure {
@@ -414,6 +477,34 @@ class SwiftPerformanceTests: TestCase {
         }
     }
 
+    // Every model class in the default schema, which includes both the Swift
+    // and obj-c test objects
+    private var allModelClasses: [ObjectBase.Type] {
+        return RLMSchema.shared().objectSchema.map { $0.objectClass as! ObjectBase.Type }
+    }
+
+    func testSwiftSchemaDiscovery() {
+        let classes = allModelClasses.filter { $0 is Object.Type }
+        measure {
+            for cls in classes {
+                _ = RLMObjectSchema(forObjectClass: cls)
+            }
+        }
+    }
+
+    func testFirstOpenWithAllModelClasses() {
+        let classes = allModelClasses
+        inMeasureBlock {
+            var config = Realm.Configuration(inMemoryIdentifier: UUID().uuidString)
+            config.objectTypes = classes
+            self.startMeasuring()
+            autoreleasepool {
+                _ = try! Realm(configuration: config)
+            }
+            self.stopMeasuring()
+        }
+    }
+
     func testCommitWriteTransaction() {
         inMeasureBlock {
             let realm = inMemoryRealm("test")
@@ -784,4 +875,209 @@ class SwiftPerformanceTests: TestCase {
             _ = objects.value(forKeyPath: "optStringCol") as! [String]
         }
     }
+
+    // MARK: - Modern vs. legacy accessors
+
+    // The objects are created in their own Realm, replacing any left over from
+    // a previous test, so that each test measures the same number of objects
+    func createIntAndStringObjects<T: Object>(_ type: T.Type, _ create: (T, Int) -> Void) -> Results<T> {
+        let realm = inMemoryRealm("accessors")
+        try! realm.write {
+            realm.delete(realm.objects(type))
+            for value in 0..<10000 {
+                let obj = T()
+                create(obj, value)
+                realm.add(obj)
+            }
+        }
+        return realm.objects(type)
+    }
+
+    func createLegacyIntAndStringObjects() -> Results<SwiftIntAndStringObject> {
+        return createIntAndStringObjects(SwiftIntAndStringObject.self) { (object, value) in
+            object.intCol = value
+            object.stringCol = String(value)
+            object.optIntCol.value = value
+            object.optStringCol = String(value)
+        }
+    }
+
+    func createModernIntAndStringObjects() -> Results<ModernIntAndStringObject> {
+        return createIntAndStringObjects(ModernIntAndStringObject.self) { (object, value) in
+            object.intCol = value
+            object.stringCol = String(value)
+            object.optIntCol = value
+            object.optStringCol = String(value)
+        }
+    }
+
+    func testLegacyPropertyGet() {
+        let object = createLegacyIntAndStringObjects().first!
+        measure {
+            for _ in 0..<10000 {
+                _ = object.intCol
+                _ = object.stringCol
+                _ = object.optIntCol.value
+                _ = object.optStringCol
+            }
+        }
+    }
+
+    func testModernPropertyGet() {
+        let object = createModernIntAndStringObjects().first!
+        measure {
+            for _ in 0..<10000 {
+                _ = object.intCol
+                _ = object.stringCol
+                _ = object.optIntCol
+                _ = object.optStringCol
+            }
+        }
+    }
+
+    func testLegacyPropertySet() {
+        let object = createLegacyIntAndStringObjects().first!
+        let realm = object.realm!
+        measure {
+            try! realm.write {
+                for i in 0..<10000 {
+                    object.intCol = i
+                    object.stringCol = "a"
+                    object.optIntCol.value = i
+                    object.optStringCol = nil
+                }
+            }
+        }
+    }
+
+    func testModernPropertySet() {
+        let object = createModernIntAndStringObjects().first!
+        let realm = object.realm!
+        measure {
+            try! realm.write {
+                for i in 0..<10000 {
+                    object.intCol = i
+                    object.stringCol = "a"
+                    object.optIntCol = i
+                    object.optStringCol = nil
+                }
+            }
+        }
+    }
+
+    func testLegacyEnumerateAndAccess() {
+        let objects = createLegacyIntAndStringObjects()
+        measure {
+            for object in objects {
+                _ = object.intCol
+                _ = object.optStringCol
+            }
+        }
+    }
+
+    func testModernEnumerateAndAccess() {
+        let objects = createModernIntAndStringObjects()
+        measure {
+            for object in objects {
+                _ = object.intCol
+                _ = object.optStringCol
+            }
+        }
+    }
+
+    func testLegacyObjectCreation() {
+        inMeasureBlock {
+            let realm = inMemoryRealm("accessors")
+            self.startMeasuring()
+            try! realm.write {
+                for i in 0..<10000 {
+                    realm.create(SwiftIntAndStringObject.self, value: [i, i, "a", "b"])
+                }
+            }
+            self.stopMeasuring()
+            try! realm.write { realm.deleteAll() }
+        }
+    }
+
+    func testModernObjectCreation() {
+        inMeasureBlock {
+            let realm = inMemoryRealm("accessors")
+            self.startMeasuring()
+            try! realm.write {
+                for i in 0..<10000 {
+                    realm.create(ModernIntAndStringObject.self, value: [i, i, "a", "b"])
+                }
+            }
+            self.stopMeasuring()
+            try! realm.write { realm.deleteAll() }
+        }
+    }
+
+    func testLegacyUnmanagedObjectCreation() {
+        measure {
+            for i in 0..<10000 {
+                let object = SwiftIntAndStringObject()
+                object.intCol = i
+                object.optStringCol = "a"
+            }
+        }
+    }
+
+    func testModernUnmanagedObjectCreation() {
+        measure {
+            for i in 0..<10000 {
+                let object = ModernIntAndStringObject()
+                object.intCol = i
+                object.optStringCol = "a"
+            }
+        }
+    }
+
+    func testLegacyCodableDecode() {
+        let data = try! JSONEncoder().encode(CodableObject())
+        let decoder = JSONDecoder()
+        measure {
+            for _ in 0..<100 {
+                _ = try! decoder.decode(CodableObject.self, from: data)
+            }
+        }
+    }
+
+    func testModernCodableDecode() {
+        let data = try! JSONEncoder().encode(ModernCodableObject())
+        let decoder = JSONDecoder()
+        measure {
+            for _ in 0..<100 {
+                _ = try! decoder.decode(ModernCodableObject.self, from: data)
+            }
+        }
+    }
+
+    func testLegacyObjectNotification() {
+        let object = createLegacyIntAndStringObjects().first!
+        let realm = object.realm!
+        inMeasureBlock {
+            let token = object.observe { _ in }
+            self.startMeasuring()
+            for i in 0..<500 {
+                try! realm.write { object.intCol = i }
+            }
+            self.stopMeasuring()
+            token.invalidate()
+        }
+    }
+
+    func testModernObjectNotification() {
+        let object = createModernIntAndStringObjects().first!
+        let realm = object.realm!
+        inMeasureBlock {
+            let token = object.observe { _ in }
+            self.startMeasuring()
+            for i in 0..<500 {
+                try! realm.write { object.intCol = i }
+            }
+            self.stopMeasuring()
+            token.invalidate()
+        }
+    }
 }
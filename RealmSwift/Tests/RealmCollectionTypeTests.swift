@@ -226,6 +226,17 @@ class RealmCollectionTypeTests: TestCase {
         assertEqual(str2, objs[1])
     }
 
+    func testElementsInRange() {
+        assertThrows(collection.elements(in: 0..<10))
+        assertThrows(collection.elements(in: -1..<1))
+        XCTAssertEqual(collection.elements(in: 0..<0).count, 0)
+        let objs = collection.elements(in: 0..<2)
+        XCTAssertEqual(objs.count, 2)
+        assertEqual(str1, objs[0])
+        assertEqual(str2, objs[1])
+        assertEqual(str2, collection.elements(in: 1..<2)[0])
+    }
+
     func testFirst() {
         assertEqual(str1, collection.first!)
         assertEqual(str2, collection.filter("stringCol = '2'").first!)
@@ -303,6 +314,23 @@ class RealmCollectionTypeTests: TestCase {
         XCTAssertEqual(0, collection.filter(pred3).count)
     }
 
+    func testWhere() {
+        XCTAssertEqual(1, collection.where { $0.stringCol == "1" }.count)
+        XCTAssertEqual(1, collection.where { $0.stringCol != "1" }.count)
+        XCTAssertEqual(0, collection.where { $0.stringCol == nil }.count)
+        XCTAssertEqual(2, collection.where { $0.stringCol == "1" || $0.stringCol == "2" }.count)
+        XCTAssertEqual(0, collection.where { $0.stringCol == "1" && $0.stringCol == "2" }.count)
+        XCTAssertEqual(1, collection.where { !($0.stringCol == "1") }.count)
+        XCTAssertEqual(2, collection.where { $0.stringCol.in(["1", "2", "3"]) }.count)
+        XCTAssertEqual(1, collection.where { $0.stringCol.ends(with: "2") }.count)
+        XCTAssertEqual(2, collection.where { $0.linkCol.id == 1 }.count)
+        XCTAssertEqual(2, collection.where { $0.linkCol.id >= 1 && $0.linkCol.id.contains(0...1) }.count)
+        XCTAssertEqual(0, collection.where { $0.linkCol.id > 1 }.count)
+
+        XCTAssertEqual(collection.where { $0.stringCol.starts(with: "1") }.count,
+                       collection.filter("stringCol BEGINSWITH '1'").count)
+    }
+
     func testSortWithProperty() {
         var sorted = collection.sorted(byKeyPath: "stringCol", ascending: true)
         XCTAssertEqual("1", sorted[0].stringCol)
@@ -1213,6 +1241,44 @@ class ResultsTests: RealmCollectionTypeTests {
         token.invalidate()
     }
 
+    func testNotificationBlockMinimumInterval() {
+        let collection = collectionBase()
+
+        var theExpectation = expectation(description: "")
+        var calls = 0
+        let token = collection.observe(minimumInterval: 0.5) { (change: RealmCollectionChange) in
+            switch change {
+            case .initial(let results):
+                XCTAssertEqual(calls, 0)
+                XCTAssertEqual(results.count, 2)
+            case .update(let results, let deletions, let insertions, let modifications):
+                XCTAssertEqual(calls, 1)
+                XCTAssertEqual(results.count, 5)
+                XCTAssertEqual(deletions, [])
+                XCTAssertEqual(insertions, [2, 3, 4])
+                XCTAssertEqual(modifications, [])
+            case .error(let error):
+                XCTFail(String(describing: error))
+            }
+
+            calls += 1
+            theExpectation.fulfill()
+        }
+        waitForExpectations(timeout: 1, handler: nil)
+
+        // All three writes happen within the interval and should be delivered
+        // as a single update
+        theExpectation = expectation(description: "")
+        for _ in 0..<3 {
+            addObjectToResults()
+            RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.05))
+        }
+        waitForExpectations(timeout: 2, handler: nil)
+        XCTAssertEqual(calls, 2)
+
+        token.invalidate()
+    }
+
     func testObserveDirectOnQueue() {
         observeOnQueue(collectionBase())
     }
@@ -1233,6 +1299,150 @@ class ResultsWithCustomInitializerTests: TestCase {
     }
 }
 
+class ResultsBulkReadTests: TestCase {
+    func testValuesForKeyPath() {
+        let realm = realmWithTestPath()
+        let objects = realm.objects(CTTAggregateObject.self)
+        XCTAssertEqual(objects.values(for: \.doubleCol), [])
+
+        try! realm.write {
+            realm.create(CTTAggregateObject.self, value: ["intCol": 1, "doubleCol": 1.5])
+            realm.create(CTTAggregateObject.self, value: ["intCol": 2, "doubleCol": 2.5])
+        }
+        XCTAssertEqual(objects.values(for: \.intCol), [1, 2])
+        XCTAssertEqual(objects.values(for: \.doubleCol), [1.5, 2.5])
+        XCTAssertEqual(objects.filter("intCol > 1").values(for: \.doubleCol), [2.5])
+    }
+
+    func testForEachTransient() {
+        let realm = realmWithTestPath()
+        try! realm.write {
+            for i in 0..<5 {
+                realm.create(CTTAggregateObject.self, value: ["intCol": i])
+            }
+        }
+
+        var sum = 0
+        var count = 0
+        realm.objects(CTTAggregateObject.self).filter("intCol > 1").forEachTransient { obj in
+            sum += obj.intCol
+            count += 1
+        }
+        XCTAssertEqual(sum, 2 + 3 + 4)
+        XCTAssertEqual(count, 3)
+    }
+
+    func testForEachTransientReadsCollectionsOfEachObject() {
+        let realm = realmWithTestPath()
+        try! realm.write {
+            for i in 0..<3 {
+                realm.create(ModernAllTypesObject.self, value: ["intCol": i, "arrayInt": Array(0..<i)])
+                realm.create(SwiftArrayPropertyObject.self, value: ["name": "\(i)", "array": Array(repeating: ["a"], count: i)])
+            }
+        }
+
+        var counts = [Int]()
+        realm.objects(ModernAllTypesObject.self).sorted(byKeyPath: "intCol").forEachTransient { obj in
+            counts.append(obj.intCol)
+            counts.append(obj.arrayInt.count)
+        }
+        XCTAssertEqual(counts, [0, 0, 1, 1, 2, 2])
+
+        counts = []
+        realm.objects(SwiftArrayPropertyObject.self).sorted(byKeyPath: "name").forEachTransient { obj in
+            counts.append(obj.array.count)
+        }
+        XCTAssertEqual(counts, [0, 1, 2])
+    }
+
+    func testConcurrentMap() {
+        let realm = realmWithTestPath()
+        try! realm.write {
+            for i in 0..<100 {
+                realm.create(CTTAggregateObject.self, value: ["intCol": i])
+            }
+        }
+
+        let results = realm.objects(CTTAggregateObject.self).sorted(byKeyPath: "intCol", ascending: false).freeze()
+        XCTAssertEqual(results.concurrentMap { $0.intCol * 2 }, (0..<100).reversed().map { $0 * 2 })
+
+        let lock = NSLock()
+        var sum = 0
+        results.concurrentForEach { obj in
+            lock.lock()
+            sum += obj.intCol
+            lock.unlock()
+        }
+        XCTAssertEqual(sum, 4950)
+
+        assertThrows(realm.objects(CTTAggregateObject.self).concurrentForEach { _ in },
+                     reason: "Concurrent enumeration is only supported on frozen Results.")
+    }
+
+    func testEvaluateConcurrently() {
+        let realm = realmWithTestPath()
+        try! realm.write {
+            for i in 0..<5000 {
+                realm.create(CTTAggregateObject.self, value: ["intCol": i])
+            }
+        }
+
+        let results = realm.objects(CTTAggregateObject.self).filter("intCol >= 1000 AND intCol < 4000")
+        XCTAssertEqual(results.freeze().evaluateConcurrently().map { $0.intCol }, results.map { $0.intCol })
+        assertThrows(results.evaluateConcurrently(),
+                     reason: "Concurrent query evaluation is only supported on frozen Results.")
+    }
+
+    func testProject() {
+        struct Row: Equatable {
+            let int: Int
+            let double: Double
+        }
+        let realm = realmWithTestPath()
+        try! realm.write {
+            realm.create(CTTAggregateObject.self, value: ["intCol": 1, "doubleCol": 1.5])
+            realm.create(CTTAggregateObject.self, value: ["intCol": 2, "doubleCol": 2.5])
+        }
+
+        let rows = realm.objects(CTTAggregateObject.self).sorted(byKeyPath: "intCol").project(into: Row.self) {
+            Row(int: $0.intCol, double: $0.doubleCol)
+        }
+        XCTAssertEqual(rows, [Row(int: 1, double: 1.5), Row(int: 2, double: 2.5)])
+        XCTAssertEqual(realm.objects(CTTAggregateObject.self).filter("intCol > 5").project { $0.intCol }, [])
+    }
+
+    func testGroupedAggregates() {
+        let realm = realmWithTestPath()
+        try! realm.write {
+            realm.create(CTTAggregateObject.self, value: ["intCol": 1, "doubleCol": 1.5, "boolCol": true])
+            realm.create(CTTAggregateObject.self, value: ["intCol": 2, "doubleCol": 2.5, "boolCol": false])
+            realm.create(CTTAggregateObject.self, value: ["intCol": 3, "doubleCol": 3.5, "boolCol": true])
+        }
+        let objects = realm.objects(CTTAggregateObject.self)
+
+        let groups = objects.grouped(by: \.boolCol, aggregating: \.doubleCol)
+        XCTAssertEqual(groups.keys, [true, false])
+        XCTAssertEqual(groups.counts, [2, 1])
+        XCTAssertEqual(groups.minimums, [1.5, 2.5])
+        XCTAssertEqual(groups.maximums, [3.5, 2.5])
+        XCTAssertEqual(groups.sums, [5.0, 2.5])
+        XCTAssertEqual(groups.averages, [2.5, 2.5])
+
+        // Integer averages are not truncated to the property's type
+        try! realm.write {
+            realm.create(CTTAggregateObject.self, value: ["intCol": 3, "doubleCol": 3.5, "boolCol": false])
+        }
+        let intGroups = objects.grouped(by: \.boolCol, aggregating: \.intCol)
+        XCTAssertEqual(intGroups.sums, [4, 5])
+        XCTAssertEqual(intGroups.averages, [2.0, 2.5])
+        XCTAssertEqual(intGroups.decimalAverages, [Decimal128(number: 2), Decimal128(number: 2.5)])
+
+        let counts: [(key: Bool, count: Int)] = objects.grouped(by: "boolCol")
+        XCTAssertEqual(counts.map { $0.key }, [true, false])
+        XCTAssertEqual(counts.map { $0.count }, [2, 2])
+    }
+}
+
 class ResultsDistinctTests: TestCase {
     func testDistinctResultsUsingKeyPaths() {
         let realm = realmWithTestPath()
@@ -1742,6 +1952,8 @@ class MutableSetRealmCollectionTypeTests: RealmCollectionTypeTests {
 
     override func testObjectsAtIndexes() { }
 
+    override func testElementsInRange() { }
+
     override func testFirst() { }
 
     override func testLast() { }
@@ -219,6 +219,28 @@ class RealmTests: TestCase {
         XCTAssertEqual(try! Realm().objects(SwiftStringObject.self).count, 1)
     }
 
+    func testWriteAsync() {
+        let realm = try! Realm()
+        let ex = expectation(description: "writes completed")
+        ex.expectedFulfillmentCount = 2
+        realm.writeAsync({ realm in
+            XCTAssertFalse(Thread.isMainThread)
+            realm.create(SwiftStringObject.self, value: ["1"])
+        }, onComplete: { error in
+            XCTAssertNil(error)
+            ex.fulfill()
+        })
+        realm.writeAsync({ realm in
+            realm.create(SwiftStringObject.self, value: ["2"])
+        }, onComplete: { error in
+            XCTAssertNil(error)
+            XCTAssertEqual(realm.objects(SwiftStringObject.self).count, 2)
+            ex.fulfill()
+        })
+        waitForExpectations(timeout: 2.0, handler: nil)
+        XCTAssertEqual(realm.objects(SwiftStringObject.self).map { $0.stringCol }, ["1", "2"])
+    }
+
     func testDynamicWrite() {
         try! Realm().write {
             self.assertThrows(try! Realm().beginWrite())
@@ -500,6 +522,29 @@ class RealmTests: TestCase {
         XCTAssertEqual(0, realm.objects(SwiftObject.self).count)
     }
 
+    func testTruncateAll() {
+        let realm = try! Realm()
+        try! realm.write {
+            realm.add(SwiftObject())
+            realm.create(SwiftIntObject.self, value: [1])
+        }
+        let object = realm.objects(SwiftIntObject.self).first!
+
+        var notifications = [Realm.Notification]()
+        let token = realm.observe { notification, _ in
+            notifications.append(notification)
+        }
+        try! realm.write {
+            realm.truncateAll()
+            XCTAssertEqual(notifications, [])
+            XCTAssertEqual(0, realm.objects(SwiftObject.self).count)
+            XCTAssertEqual(0, realm.objects(SwiftIntObject.self).count)
+            XCTAssertTrue(object.isInvalidated)
+        }
+        XCTAssertEqual(notifications, [.didChange])
+        token.invalidate()
+    }
+
     func testObjects() {
         try! Realm().write {
             try! Realm().create(SwiftIntObject.self, value: [100])
@@ -512,6 +557,21 @@ class RealmTests: TestCase {
         assertThrows(try! Realm().objects(Object.self))
     }
 
+    func testPreparedQuery() {
+        let realm = try! Realm()
+        try! realm.write {
+            realm.create(SwiftPrimaryStringObject.self, value: ["a", 1])
+            realm.create(SwiftPrimaryStringObject.self, value: ["b", 2])
+            realm.create(SwiftPrimaryStringObject.self, value: ["c", 3])
+        }
+
+        let query = PreparedQuery<SwiftPrimaryStringObject>("intCol > $0 AND stringCol != $1")
+        XCTAssertEqual(query.numberOfArguments, 2)
+        XCTAssertEqual(query.results(in: realm, 1, "c").map(\.stringCol), ["b"])
+        XCTAssertEqual(query.results(in: realm, 0, "z").count, 3)
+        assertThrows(query.results(in: realm, 1))
+    }
+
     func testDynamicObjects() {
         try! Realm().write {
             try! Realm().create(SwiftIntObject.self, value: [100])
@@ -720,6 +780,18 @@ class RealmTests: TestCase {
         XCTAssertNil(missingObject)
     }
 
+    func testObjectsForPrimaryKeys() {
+        let realm = try! Realm()
+        try! realm.write {
+            realm.create(SwiftPrimaryStringObject.self, value: ["a", 1])
+            realm.create(SwiftPrimaryStringObject.self, value: ["b", 2])
+        }
+
+        let objects = realm.objects(ofType: SwiftPrimaryStringObject.self, forPrimaryKeys: ["b", "z", "a"])
+        XCTAssertEqual(objects.map { $0?.intCol }, [2, nil, 1])
+        XCTAssertEqual(realm.objects(ofType: SwiftPrimaryStringObject.self, forPrimaryKeys: [String]()).count, 0)
+    }
+
     func testOptionalStringPrimaryKey() {
         let realm = try! Realm()
         try! realm.write {
@@ -980,3 +1052,111 @@ class RealmTests: TestCase {
         XCTAssertEqual(try! Realm().objects(SwiftBoolObject.self).count, 1)
     }
 }
+
+#if swift(>=5.5) && canImport(_Concurrency)
+@available(macOS 12.0, tvOS 15.0, iOS 15.0, watchOS 8.0, *)
+extension RealmTests {
+    func testRealmActor() async throws {
+        let actor = try await RealmActor(configuration: Realm.Configuration(fileURL: testRealmURL()))
+        try await actor.write { realm in
+            _ = realm.create(SwiftIntObject.self, value: [1])
+        }
+        let count = try await actor.read { $0.objects(SwiftIntObject.self).count }
+        XCTAssertEqual(count, 1)
+
+        var iterator = await actor.objects(SwiftIntObject.self).makeAsyncIterator()
+        let initial = await iterator.next()
+        XCTAssertEqual(initial?.count, 1)
+        XCTAssertEqual(initial?.isFrozen, true)
+
+        try await actor.write { realm in
+            _ = realm.create(SwiftIntObject.self, value: [2])
+        }
+        let updated = await iterator.next()
+        XCTAssertEqual(updated?.map { $0.intCol }, [1, 2])
+
+        // Writes made elsewhere are visible to reads immediately, as the
+        // actor's Realm is refreshed first, and are delivered to the stream
+        let realm = try Realm(configuration: actor.configuration)
+        try realm.write {
+            realm.create(SwiftIntObject.self, value: [3])
+        }
+        let sum = try await actor.read { $0.objects(SwiftIntObject.self).sum(ofProperty: "intCol") as Int }
+        XCTAssertEqual(sum, 6)
+        let external = await iterator.next()
+        XCTAssertEqual(external?.map { $0.intCol }, [1, 2, 3])
+    }
+
+    @MainActor
+    func testResultsChangesMergesUnconsumedChanges() async throws {
+        let realm = try Realm(configuration: Realm.Configuration(fileURL: testRealmURL()))
+        try realm.write {
+            for i in 0..<5 {
+                realm.create(SwiftIntObject.self, value: [i])
+            }
+        }
+        let results = realm.objects(SwiftIntObject.self).sorted(byKeyPath: "intCol")
+        var iterator = results.changes(buffering: .coalesced).makeAsyncIterator()
+        guard case .initial(let initial) = await iterator.next() else {
+            return XCTFail("Expected .initial")
+        }
+        XCTAssertTrue(initial.isFrozen)
+        var values = Array(initial.map { $0.intCol })
+
+        // Make several writes without consuming the changes, and check that
+        // the changes which are delivered still describe the final state
+        try realm.write {
+            realm.delete(results[1])
+            results[2].intCol = 3
+            realm.create(SwiftIntObject.self, value: [5])
+        }
+        try await Task.sleep(nanoseconds: 100_000_000)
+        try realm.write {
+            realm.delete(realm.objects(SwiftIntObject.self).filter("intCol = 3"))
+            realm.create(SwiftIntObject.self, value: [6])
+        }
+
+        while values != [0, 2, 4, 5, 6] {
+            guard case let .update(frozen, deletions, insertions, _) = await iterator.next() else {
+                return XCTFail("Expected .update")
+            }
+            for index in deletions.reversed() {
+                values.remove(at: index)
+            }
+            for index in insertions {
+                values.insert(frozen[index].intCol, at: index)
+            }
+            XCTAssertEqual(values, Array(frozen.map { $0.intCol }))
+        }
+    }
+
+    @MainActor
+    func testObjectChangesMergesUnconsumedChanges() async throws {
+        let realm = try Realm(configuration: Realm.Configuration(fileURL: testRealmURL()))
+        let object = try realm.write { realm.create(SwiftIntObject.self, value: [0]) }
+        var iterator = object.changes().makeAsyncIterator()
+
+        try realm.write { object.intCol = 1 }
+        try await Task.sleep(nanoseconds: 100_000_000)
+        try realm.write { object.intCol = 2 }
+
+        var intCol = 0
+        while intCol != 2 {
+            guard case let .change(frozen, properties) = await iterator.next() else {
+                return XCTFail("Expected .change")
+            }
+            XCTAssertTrue(frozen.isFrozen)
+            XCTAssertEqual(properties.map { $0.name }, ["intCol"])
+            intCol = properties[0].newValue as! Int
+            XCTAssertEqual(frozen.intCol, intCol)
+        }
+
+        try realm.write { realm.delete(object) }
+        guard case .deleted = await iterator.next() else {
+            return XCTFail("Expected .deleted")
+        }
+        let end = await iterator.next()
+        XCTAssertNil(end)
+    }
+}
+#endif // swift(>=5.5)
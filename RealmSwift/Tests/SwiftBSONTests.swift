@@ -18,7 +18,11 @@
 
 import XCTest
 import Realm
-import RealmSwift
+#if DEBUG
+    @testable import RealmSwift
+#else
+    import RealmSwift
+#endif
 
 class SwiftBSONTests: XCTestCase {
     private func testBSONRoundTrip<T>(_ value: T,
@@ -172,4 +176,61 @@ class SwiftBSONTests: XCTestCase {
         let bson: AnyBSON? = ObjectiveCSupport.convert(object: rlmBSON)
         XCTAssertEqual(bson?.value(), swiftArray)
     }
+
+    func testConvertObjectiveCValues() throws {
+        // Values created by the Objective-C API aren't instances of the Swift subclasses
+        let objectId = try RLMObjectId(string: "507f1f77bcf86cd799439011")
+        let decimal = RLMDecimal128(number: 12.5)
+        let dictionary: NSDictionary = ["oid": objectId, "decimal": decimal, "null": NSNull(),
+                                        "array": [objectId, NSNull()] as NSArray]
+
+        let bson: AnyBSON? = ObjectiveCSupport.convert(object: dictionary)
+        let expected: Document = [
+            "oid": .objectId(ObjectId("507f1f77bcf86cd799439011")),
+            "decimal": .decimal128(Decimal128(number: 12.5)),
+            "null": nil,
+            "array": [.objectId(ObjectId("507f1f77bcf86cd799439011")), nil]
+        ]
+        XCTAssertEqual(bson?.value(), expected)
+    }
+
+    #if DEBUG // BSONDecoder is internal
+    struct DecodedDog: Decodable, Equatable {
+        struct Owner: Decodable, Equatable {
+            var name: String
+            var age: Int32
+        }
+        var _id: ObjectId
+        var name: String
+        var weight: Double
+        var vaccinated: Bool
+        var birthday: Date
+        var owner: Owner?
+        var tags: [String]
+        var price: Decimal128?
+    }
+
+    func testDecodeDocument() throws {
+        let document: Document = [
+            "_id": .objectId(ObjectId("507f1f77bcf86cd799439011")),
+            "name": "fido",
+            "weight": 12.5,
+            "vaccinated": true,
+            "birthday": .datetime(Date(timeIntervalSince1970: 500)),
+            "owner": ["name": "alice", "age": .int32(30)],
+            "tags": ["good", "dog"],
+            "price": nil
+        ]
+        let rlmBSON = ObjectiveCSupport.convert(object: .document(document)) as! NSDictionary
+        let dog = try BSONDecoder().decode(DecodedDog.self, from: rlmBSON)
+        XCTAssertEqual(dog, DecodedDog(_id: ObjectId("507f1f77bcf86cd799439011"),
+                                       name: "fido", weight: 12.5, vaccinated: true,
+                                       birthday: Date(timeIntervalSince1970: 500),
+                                       owner: .init(name: "alice", age: 30),
+                                       tags: ["good", "dog"], price: nil))
+
+        let mismatched = ObjectiveCSupport.convert(object: .document(["name": 5])) as! NSDictionary
+        XCTAssertThrowsError(try BSONDecoder().decode(DecodedDog.self, from: mismatched))
+    }
+    #endif
 }
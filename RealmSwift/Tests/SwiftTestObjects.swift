@@ -104,6 +104,14 @@ class SwiftObject: Object {
     }
 }
 
+// The legacy equivalent of ModernIntAndStringObject
+class SwiftIntAndStringObject: Object {
+    @objc dynamic var intCol = 0
+    let optIntCol = RealmProperty<Int?>()
+    @objc dynamic var stringCol = ""
+    @objc dynamic var optStringCol: String?
+}
+
 @available(*, deprecated) // Silence deprecation warnings for RealmOptional
 class SwiftOptionalObject: Object {
     @objc dynamic var optNSStringCol: NSString?
@@ -286,6 +286,35 @@ class SwiftUITests: TestCase {
         state.projectedValue.remove(object)
         XCTAssertEqual(state.wrappedValue.count, 0)
     }
+    func testResultsChanges() throws {
+        let results = ObservedResults(SwiftUIObject.self,
+                                      configuration: inMemoryRealm(inMemoryIdentifier).configuration)
+        var ex = expectation(description: "initial")
+        let cancellable = results.changes.sink { change in
+            switch change.change {
+            case .initial(let collection):
+                XCTAssertTrue(collection.isFrozen)
+                XCTAssertEqual(change.ids, [])
+            case let .update(collection, deletions, insertions, modifications):
+                XCTAssertTrue(collection.isFrozen)
+                XCTAssertEqual(change.ids, collection.map(\.id))
+                XCTAssertEqual(change.ids.count, 1)
+                XCTAssertEqual(deletions, [])
+                XCTAssertEqual(insertions, [0])
+                XCTAssertEqual(modifications, [])
+            case .error(let error):
+                XCTFail("\(error)")
+            }
+            ex.fulfill()
+        }
+        waitForExpectations(timeout: 2.0)
+
+        ex = expectation(description: "update")
+        let realm = inMemoryRealm(inMemoryIdentifier)
+        try realm.write { realm.add(SwiftUIObject()) }
+        waitForExpectations(timeout: 2.0)
+        cancellable.cancel()
+    }
     // MARK: Object Operations
     func testUnmanagedObjectModification() throws {
         let state = StateRealmObject(wrappedValue: SwiftUIObject())
@@ -313,6 +342,46 @@ class SwiftUITests: TestCase {
         XCTAssertEqual(results.wrappedValue.count, 1)
         state.projectedValue.delete()
     }
+    func testCoalescedBindingWrites() throws {
+        let realm = inMemoryRealm(inMemoryIdentifier)
+        let object = SwiftUIObject()
+        try realm.write { realm.add(object) }
+        Realm.bindingWriteMode = .coalesced(interval: 60)
+        defer { Realm.bindingWriteMode = .immediate }
+
+        let state = ObservedRealmObject(wrappedValue: object)
+        state.projectedValue.str.wrappedValue = "a"
+        state.projectedValue.str.wrappedValue = "ab"
+        state.projectedValue.int.wrappedValue = 2
+        // Bindings read back the pending values before they're written
+        XCTAssertEqual(state.projectedValue.str.wrappedValue, "ab")
+        XCTAssertEqual(state.projectedValue.int.wrappedValue, 2)
+        XCTAssertEqual(object.str, "foo")
+        XCTAssertEqual(object.int, 0)
+
+        Realm.commitPendingBindingWrites()
+        XCTAssertEqual(object.str, "ab")
+        XCTAssertEqual(object.int, 2)
+        XCTAssertFalse(realm.isInWriteTransaction)
+    }
+    func testCoalescedBindingWritesAreCommittedAfterInterval() throws {
+        let realm = inMemoryRealm(inMemoryIdentifier)
+        let object = SwiftUIObject()
+        try realm.write { realm.add(object) }
+        Realm.bindingWriteMode = .coalesced(interval: 0.1)
+        defer { Realm.bindingWriteMode = .immediate }
+
+        let state = ObservedRealmObject(wrappedValue: object)
+        state.projectedValue.str.wrappedValue = "bar"
+        XCTAssertEqual(object.str, "foo")
+
+        let ex = expectation(description: "write committed")
+        DispatchQueue.main.asyncAfter(deadline: .now() + 0.5) {
+            ex.fulfill()
+        }
+        waitForExpectations(timeout: 2.0)
+        XCTAssertEqual(object.str, "bar")
+    }
     // MARK: Bind
     func testUnmanagedManagedObjectBind() {
         let object = SwiftUIObject()
@@ -333,6 +402,14 @@ class SwiftUITests: TestCase {
         XCTAssertEqual(binding.wrappedValue, "baz")
     }
 
+    private func waitForHits(_ expected: Int, _ hits: () -> Int) {
+        let deadline = Date(timeIntervalSinceNow: 2)
+        while hits() < expected && Date() < deadline {
+            RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.01))
+        }
+        XCTAssertEqual(hits(), expected)
+    }
+
 #if swift(>=5.5)
     func testStateRealmObjectKVO() throws {
         @StateRealmObject var object = SwiftUIObject()
@@ -353,12 +430,22 @@ class SwiftUITests: TestCase {
         }
         XCTAssertEqual(hit, 1)
         XCTAssertNil(object.observationInfo)
+        // Once managed the object is observed with an object notification
+        // rather than KVO, so changes are reported asynchronously
+        try realm.write {
+            object.thaw()!.int += 1
+        }
+        waitForHits(2, { hit })
         try realm.write {
             object.thaw()!.int += 1
         }
-        XCTAssertEqual(hit, 2)
+        waitForHits(3, { hit })
         cancellable.cancel()
-        XCTAssertEqual(hit, 2)
+        try realm.write {
+            object.thaw()!.int += 1
+        }
+        RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.1))
+        XCTAssertEqual(hit, 3)
     }
 #else
     func testStateRealmObjectKVO() throws {
@@ -380,12 +467,22 @@ class SwiftUITests: TestCase {
         }
         XCTAssertEqual(hit, 1)
         XCTAssertNil(object.wrappedValue.observationInfo)
+        // Once managed the object is observed with an object notification
+        // rather than KVO, so changes are reported asynchronously
         try realm.write {
             object.wrappedValue.thaw()!.int += 1
         }
-        XCTAssertEqual(hit, 2)
+        waitForHits(2, { hit })
+        try realm.write {
+            object.wrappedValue.thaw()!.int += 1
+        }
+        waitForHits(3, { hit })
         cancellable.cancel()
-        XCTAssertEqual(hit, 2)
+        try realm.write {
+            object.wrappedValue.thaw()!.int += 1
+        }
+        RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.1))
+        XCTAssertEqual(hit, 3)
     }
 #endif
 }
@@ -54,4 +54,21 @@ class SwiftUnicodeTests: TestCase {
         let obj2 = realm.objects(SwiftUTF8Object.self).filter("%K == %@", "柱колоéнǢкƱаم👍", utf8TestString).first!
         assertEqual(obj1, obj2)
     }
+
+    func testUTF8StringContentsOfPersistedProperty() {
+        let realm = realmWithTestPath()
+        let obj = try! realm.write {
+            realm.create(ModernAllTypesObject.self, value: ["stringCol": utf8TestString])
+        }
+        XCTAssertEqual(obj.stringCol, utf8TestString)
+        XCTAssertNil(obj.optStringCol)
+
+        try! realm.write {
+            obj.stringCol = ""
+            obj.optStringCol = utf8TestString
+        }
+        XCTAssertEqual(obj.stringCol, "")
+        XCTAssertEqual(obj.optStringCol, utf8TestString)
+        XCTAssertEqual(obj.freeze().optStringCol, utf8TestString)
+    }
 }
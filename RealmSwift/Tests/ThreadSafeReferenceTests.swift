@@ -119,6 +119,68 @@ class ThreadSafeReferenceTests: TestCase {
         XCTAssertEqual(42, intObject.intCol)
     }
 
+    func testPassThreadSafeReferenceBatch() {
+        let realm = try! Realm()
+        let objects = (0..<10).map { SwiftIntObject(value: [$0]) }
+        try! realm.write {
+            realm.add(objects)
+        }
+        let batch = ThreadSafeReferenceBatch(to: objects)
+        XCTAssertEqual(batch.count, 10)
+        try! realm.write {
+            realm.delete(objects[3])
+        }
+        dispatchSyncNewThread {
+            let realm = try! Realm()
+            let resolved = realm.resolve(batch)
+            XCTAssertEqual(resolved.map(\.intCol), [0, 1, 2, 4, 5, 6, 7, 8, 9])
+            // Batches do not pin a version and can be resolved repeatedly
+            XCTAssertEqual(realm.resolve(batch).count, 9)
+            realm.beginWrite()
+            self.assertThrows(realm.resolve(batch), reason: "Cannot resolve thread safe reference during a write transaction")
+            realm.cancelWrite()
+        }
+
+        assertThrows(ThreadSafeReferenceBatch(to: [SwiftIntObject()]),
+                     reason: "Cannot construct reference to unmanaged object")
+        XCTAssertEqual(realm.resolve(ThreadSafeReferenceBatch<SwiftIntObject>(to: [])), [])
+    }
+
+    func testPassObjectReference() {
+        let realm = try! Realm()
+        let (intObject, primaryKeyObject) = (SwiftIntObject(value: [5]), SwiftPrimaryStringObject(value: ["a", 1]))
+        let deletedObject = SwiftIntObject()
+        try! realm.write {
+            realm.add([intObject, deletedObject])
+            realm.add(primaryKeyObject)
+        }
+        let intRef = ObjectReference(to: intObject)
+        let primaryKeyRef = ObjectReference(to: primaryKeyObject)
+        let deletedRef = ObjectReference(to: deletedObject)
+        assertThrows(ObjectReference(to: SwiftIntObject()), reason: "Cannot construct reference to unmanaged object")
+        try! realm.write {
+            realm.delete(deletedObject)
+        }
+        dispatchSyncNewThread {
+            let realm = try! Realm()
+            XCTAssertEqual(realm.resolve(intRef)!.intCol, 5)
+            XCTAssertEqual(realm.resolve(primaryKeyRef)!.intCol, 1)
+            XCTAssertNil(realm.resolve(deletedRef))
+            // References do not pin a version and can be resolved repeatedly
+            XCTAssertEqual(realm.resolve(intRef)!.intCol, 5)
+
+            // Objects with a primary key can be looked up in other files
+            let otherRealm = self.realmWithTestPath()
+            XCTAssertNil(otherRealm.resolve(primaryKeyRef))
+            try! otherRealm.write {
+                otherRealm.create(SwiftPrimaryStringObject.self, value: ["a", 2])
+            }
+            XCTAssertEqual(otherRealm.resolve(primaryKeyRef)!.intCol, 2)
+            self.assertThrows(otherRealm.resolve(intRef),
+                              reason: "Cannot resolve thread safe reference in a different Realm file")
+        }
+    }
+
     func testPassThreadSafeReferenceToList() {
         let realm = try! Realm()
         let company = SwiftCompanyObject()
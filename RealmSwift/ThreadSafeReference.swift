@@ -122,6 +122,68 @@ public protocol ThreadConfined {
     }
 }
 
+/**
+ A thread-safe reference to a group of managed objects, intended for handing over many objects
+ at once.
+
+ Rather than wrapping each object individually, a batch records the key of each object along
+ with the version of the Realm they were read at. Resolving the batch with `Realm.resolve(_:)`
+ refreshes the target Realm at most once and then looks up each object in turn.
+
+ Unlike `ThreadSafeReference`, a batch does not pin the source version of the Realm and may be
+ resolved any number of times.
+
+ - see: `Realm.resolve(_:)`
+ */
+@frozen public struct ThreadSafeReferenceBatch<Element: ObjectBase> {
+    private let objectiveCReference: RLMThreadSafeReferenceBatch
+
+    /// The number of objects in the batch.
+    public var count: Int { return Int(objectiveCReference.count) }
+
+    /**
+     Create a thread-safe reference to each of the given managed objects.
+
+     - parameter objects: The objects to create a reference to. All of the objects must be managed
+                          by the same Realm.
+     */
+    public init<S: Sequence>(to objects: S) where S.Element == Element {
+        objectiveCReference = RLMThreadSafeReferenceBatch(objects: Array(objects) as NSArray)
+    }
+
+    internal func resolve(in realm: Realm) -> [Element] {
+        return realm.rlmRealm.__resolve(objectiveCReference).map { $0 as! Element }
+    }
+}
+
+/**
+ A lightweight reference to a managed object which can be passed between threads.
+
+ An `ObjectReference` stores only the type of the object and its primary key, or the object's
+ key if it has no primary key. It does not pin the source version of the Realm, which makes it
+ much cheaper than a `ThreadSafeReference` when handing over many objects in turn.
+
+ Resolving the reference with `Realm.resolve(_:)` looks the object up again in the target Realm,
+ and returns `nil` if it has been deleted. References to objects with a primary key can also be
+ resolved in other Realm files with a matching schema.
+ */
+@frozen public struct ObjectReference<Referenced: ObjectBase> {
+    private let objectiveCReference: RLMObjectReference
+
+    /**
+     Create a reference to a managed object.
+
+     - parameter object: The managed object to create a reference to.
+     */
+    public init(to object: Referenced) {
+        objectiveCReference = RLMObjectReference(object: object)
+    }
+
+    internal func resolve(in realm: Realm) -> Referenced? {
+        return realm.rlmRealm.__resolve(objectiveCReference).map { $0 as! Referenced }
+    }
+}
+
 // MARK: ThreadSafe propertyWrapper
 
 /**
@@ -220,4 +282,37 @@ extension Realm {
     public func resolve<Confined>(_ reference: ThreadSafeReference<Confined>) -> Confined? {
         return reference.resolve(in: self)
     }
+
+    /**
+     Returns the objects referenced by the batch, resolved for the current Realm for this thread.
+     Objects which were deleted after the batch was created are omitted.
+
+     - parameter batch: The thread-safe reference batch to resolve in this Realm.
+
+     - warning: Cannot call within a write transaction.
+
+     - note: Will refresh this Realm once if the source Realm was at a later version than this one.
+
+     - see: `ThreadSafeReferenceBatch(to:)`
+     */
+    public func resolve<Element>(_ batch: ThreadSafeReferenceBatch<Element>) -> [Element] {
+        return batch.resolve(in: self)
+    }
+
+    /**
+     Returns the object referenced by the object reference as it exists in this Realm, or `nil`
+     if it has since been deleted.
+
+     - parameter reference: The object reference to resolve in this Realm.
+
+     - warning: Cannot call within a write transaction.
+
+     - note: Will refresh this Realm if the reference was created from a later version of the same
+             Realm file than this one.
+
+     - see: `ObjectReference(to:)`
+     */
+    public func resolve<Referenced>(_ reference: ObjectReference<Referenced>) -> Referenced? {
+        return reference.resolve(in: self)
+    }
 }
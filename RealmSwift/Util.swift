@@ -90,10 +90,63 @@ internal func coerceToNil(_ value: Any) -> Any? {
 // MARK: CustomObjectiveCBridgeable
 
 /// :nodoc:
+@inlinable
 public func dynamicBridgeCast<T>(fromObjectiveC x: Any) -> T {
+    if let value = primitiveBridgeCast(fromObjectiveC: x, to: T.self) {
+        return value
+    }
     return failableDynamicBridgeCast(fromObjectiveC: x)!
 }
 
+// Fast paths for the most common collection element types, which otherwise
+// go through a fully dynamic cast for every element read. When the caller is
+// specialized the type checks fold away and this becomes a direct unboxing;
+// when it isn't they're just metadata pointer comparisons.
+@inlinable
+internal func primitiveBridgeCast<T>(fromObjectiveC x: Any, to type: T.Type) -> T? {
+    if T.self == Int.self, let number = x as? NSNumber {
+        return (number.intValue as! T)
+    }
+    if T.self == Double.self, let number = x as? NSNumber {
+        return (number.doubleValue as! T)
+    }
+    if T.self == String.self, let string = x as? NSString {
+        return (string as String as! T)
+    }
+    if T.self == Date.self, let date = x as? NSDate {
+        return (date as Date as! T)
+    }
+    if T.self == ObjectId.self, let objectId = x as? ObjectId {
+        return (objectId as! T)
+    }
+    if T.self == Int?.self || T.self == Double?.self || T.self == String?.self
+        || T.self == Date?.self || T.self == ObjectId?.self {
+        return optionalPrimitiveBridgeCast(fromObjectiveC: x, to: type)
+    }
+    return nil
+}
+
+@inlinable
+internal func optionalPrimitiveBridgeCast<T>(fromObjectiveC x: Any, to type: T.Type) -> T? {
+    let isNull = x is NSNull
+    if T.self == Int?.self {
+        return isNull ? (Int?.none as! T) : primitiveBridgeCast(fromObjectiveC: x, to: Int.self).map { $0 as! T }
+    }
+    if T.self == Double?.self {
+        return isNull ? (Double?.none as! T) : primitiveBridgeCast(fromObjectiveC: x, to: Double.self).map { $0 as! T }
+    }
+    if T.self == String?.self {
+        return isNull ? (String?.none as! T) : primitiveBridgeCast(fromObjectiveC: x, to: String.self).map { $0 as! T }
+    }
+    if T.self == Date?.self {
+        return isNull ? (Date?.none as! T) : primitiveBridgeCast(fromObjectiveC: x, to: Date.self).map { $0 as! T }
+    }
+    if T.self == ObjectId?.self {
+        return isNull ? (ObjectId?.none as! T) : primitiveBridgeCast(fromObjectiveC: x, to: ObjectId.self).map { $0 as! T }
+    }
+    return nil
+}
+
 /// :nodoc:
 @usableFromInline
 internal func failableDynamicBridgeCast<T>(fromObjectiveC x: Any) -> T? {